@@ -45,6 +45,7 @@ option(HYPERVISOR_BUILD_LOADER "Turns on/off building the loader" ON)
 option(HYPERVISOR_BUILD_VMMCTL "Turns on/off building the vmmctl" ${HYPERVISOR_DEFAULT_BUILD_VMMCTL})
 option(HYPERVISOR_BUILD_MICROKERNEL "Turns on/off building the microkernel" ON)
 option(HYPERVISOR_BUILD_EFI "Turns on/off building the EFI loader" ${HYPERVISOR_DEFAULT_BUILD_EFI})
+option(HYPERVISOR_BUILD_BENCH "Turns on/off building the host-side microbenchmarks" OFF)
 
 if(NOT DEFINED HYPERVISOR_TARGET_ARCH)
     if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
@@ -208,6 +209,22 @@ bf_add_config(
     SKIP_VALIDATION
 )
 
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_VMEXIT_STATS_SIZE
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "128"
+    DESCRIPTION "Defines the max # of unique exit reasons the vmexit stats track per PP"
+    SKIP_VALIDATION
+)
+
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_TRACE_SIZE
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "256"
+    DESCRIPTION "Defines the hypervisor's trace ring size in # of events per PP"
+    SKIP_VALIDATION
+)
+
 bf_add_config(
     CONFIG_NAME HYPERVISOR_MAX_ELF_FILE_SIZE
     CONFIG_TYPE STRING
@@ -248,6 +265,22 @@ bf_add_config(
     SKIP_VALIDATION
 )
 
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_MAX_NUMA_NODES
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "8"
+    DESCRIPTION "Defines the hypervisor's max number of NUMA nodes supported"
+    SKIP_VALIDATION
+)
+
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "32"
+    DESCRIPTION "Defines the max number of physically contiguous segments in the microkernel's huge pool"
+    SKIP_VALIDATION
+)
+
 bf_add_config(
     CONFIG_NAME HYPERVISOR_MAX_VPS
     CONFIG_TYPE STRING
@@ -328,6 +361,30 @@ bf_add_config(
     SKIP_VALIDATION
 )
 
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "0x400000"
+    DESCRIPTION "Defines the free bytes (per NUMA node) below which the microkernel asks the root OS for more pages"
+    SKIP_VALIDATION
+)
+
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "0x1000000"
+    DESCRIPTION "Defines the number of bytes the loader donates to the page pool when it is low"
+    SKIP_VALIDATION
+)
+
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_MAX_PAGE_POOL_DONATIONS
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "64"
+    DESCRIPTION "Defines the max number of physically contiguous ranges the loader can donate to the page pool"
+    SKIP_VALIDATION
+)
+
 bf_add_config(
     CONFIG_NAME HYPERVISOR_MK_HUGE_POOL_ADDR
     CONFIG_TYPE STRING
@@ -340,7 +397,7 @@ bf_add_config(
     CONFIG_NAME HYPERVISOR_MK_HUGE_POOL_SIZE
     CONFIG_TYPE STRING
     DEFAULT_VAL "0x10000"
-    DESCRIPTION "Defines the microkernel's default huge pool size in bytes"
+    DESCRIPTION "Defines the microkernel's default huge pool size in bytes (per NUMA node)"
     SKIP_VALIDATION
 )
 
@@ -360,6 +417,22 @@ bf_add_config(
     OPTIONS 0x0000200000000000
 )
 
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "0x1000"
+    DESCRIPTION "Defines the page size used when an extension faults on its direct map in bytes"
+    OPTIONS 0x1000 0x200000
+)
+
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "0x0"
+    DESCRIPTION "Defines how much physical memory is mapped into an extension's direct map using 2M pages up front in bytes"
+    SKIP_VALIDATION
+)
+
 bf_add_config(
     CONFIG_NAME HYPERVISOR_EXT_STACK_ADDR
     CONFIG_TYPE STRING
@@ -455,3 +528,18 @@ bf_add_config(
     DESCRIPTION "Defines an extension's default heap pool max size"
     OPTIONS HYPERVISOR_MK_PAGE_POOL_SIZE
 )
+
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_EXT_SIMD
+    CONFIG_TYPE BOOL
+    DEFAULT_VAL OFF
+    DESCRIPTION "Allows extensions to use x87/SSE/AVX (x64 only, the FPU state is switched lazily)"
+)
+
+bf_add_config(
+    CONFIG_NAME HYPERVISOR_BENCH_THRESHOLD
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "10"
+    DESCRIPTION "Defines the slowdown (in percent) that bench_compare allows before failing"
+    SKIP_VALIDATION
+)
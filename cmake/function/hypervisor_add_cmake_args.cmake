@@ -69,11 +69,15 @@ macro(hypervisor_add_cmake_args)
         -DHYPERVISOR_PAGE_SHIFT=${HYPERVISOR_PAGE_SHIFT}
         -DHYPERVISOR_DEBUG_RING_SIZE=${HYPERVISOR_DEBUG_RING_SIZE}
         -DHYPERVISOR_VMEXIT_LOG_SIZE=${HYPERVISOR_VMEXIT_LOG_SIZE}
+        -DHYPERVISOR_VMEXIT_STATS_SIZE=${HYPERVISOR_VMEXIT_STATS_SIZE}
+        -DHYPERVISOR_TRACE_SIZE=${HYPERVISOR_TRACE_SIZE}
         -DHYPERVISOR_MAX_ELF_FILE_SIZE=${HYPERVISOR_MAX_ELF_FILE_SIZE}
         -DHYPERVISOR_MAX_SEGMENTS=${HYPERVISOR_MAX_SEGMENTS}
         -DHYPERVISOR_MAX_EXTENSIONS=${HYPERVISOR_MAX_EXTENSIONS}
         -DHYPERVISOR_MAX_VMS=${HYPERVISOR_MAX_VMS}
         -DHYPERVISOR_MAX_PPS=${HYPERVISOR_MAX_PPS}
+        -DHYPERVISOR_MAX_NUMA_NODES=${HYPERVISOR_MAX_NUMA_NODES}
+        -DHYPERVISOR_MAX_HUGE_POOL_SEGMENTS=${HYPERVISOR_MAX_HUGE_POOL_SEGMENTS}
         -DHYPERVISOR_MAX_VPS=${HYPERVISOR_MAX_VPS}
         -DHYPERVISOR_MAX_VPSS=${HYPERVISOR_MAX_VPSS}
         -DHYPERVISOR_MK_DIRECT_MAP_ADDR=${HYPERVISOR_MK_DIRECT_MAP_ADDR}
@@ -84,10 +88,15 @@ macro(hypervisor_add_cmake_args)
         -DHYPERVISOR_MK_CODE_SIZE=${HYPERVISOR_MK_CODE_SIZE}
         -DHYPERVISOR_MK_PAGE_POOL_ADDR=${HYPERVISOR_MK_PAGE_POOL_ADDR}
         -DHYPERVISOR_MK_PAGE_POOL_SIZE=${HYPERVISOR_MK_PAGE_POOL_SIZE}
+        -DHYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK=${HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK}
+        -DHYPERVISOR_MK_PAGE_POOL_DONATION_SIZE=${HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE}
+        -DHYPERVISOR_MAX_PAGE_POOL_DONATIONS=${HYPERVISOR_MAX_PAGE_POOL_DONATIONS}
         -DHYPERVISOR_MK_HUGE_POOL_ADDR=${HYPERVISOR_MK_HUGE_POOL_ADDR}
         -DHYPERVISOR_MK_HUGE_POOL_SIZE=${HYPERVISOR_MK_HUGE_POOL_SIZE}
         -DHYPERVISOR_EXT_DIRECT_MAP_ADDR=${HYPERVISOR_EXT_DIRECT_MAP_ADDR}
         -DHYPERVISOR_EXT_DIRECT_MAP_SIZE=${HYPERVISOR_EXT_DIRECT_MAP_SIZE}
+        -DHYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE=${HYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE}
+        -DHYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE=${HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE}
         -DHYPERVISOR_EXT_STACK_ADDR=${HYPERVISOR_EXT_STACK_ADDR}
         -DHYPERVISOR_EXT_STACK_SIZE=${HYPERVISOR_EXT_STACK_SIZE}
         -DHYPERVISOR_EXT_CODE_ADDR=${HYPERVISOR_EXT_CODE_ADDR}
@@ -100,5 +109,6 @@ macro(hypervisor_add_cmake_args)
         -DHYPERVISOR_EXT_HUGE_POOL_SIZE=${HYPERVISOR_EXT_HUGE_POOL_SIZE}
         -DHYPERVISOR_EXT_HEAP_POOL_ADDR=${HYPERVISOR_EXT_HEAP_POOL_ADDR}
         -DHYPERVISOR_EXT_HEAP_POOL_SIZE=${HYPERVISOR_EXT_HEAP_POOL_SIZE}
+        -DHYPERVISOR_EXT_SIMD=${HYPERVISOR_EXT_SIMD}
     )
 endmacro(hypervisor_add_cmake_args)
@@ -78,6 +78,18 @@ macro(hypervisor_add_info)
         )
     endif()
 
+    if(HYPERVISOR_BUILD_BENCH)
+        add_custom_command(TARGET info
+            COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_BUILD_BENCH         ${BF_COLOR_GRN}enabled${BF_COLOR_RST}"
+            VERBATIM
+        )
+    else()
+        add_custom_command(TARGET info
+            COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_BUILD_BENCH         ${BF_COLOR_RED}disabled${BF_COLOR_RST}"
+            VERBATIM
+        )
+    endif()
+
     if(HYPERVISOR_BUILD_MICROKERNEL)
         add_custom_command(TARGET info
             COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_BUILD_MICROKERNEL   ${BF_COLOR_GRN}enabled${BF_COLOR_RST}"
@@ -102,6 +114,18 @@ macro(hypervisor_add_info)
         )
     endif()
 
+    if(HYPERVISOR_EXT_SIMD)
+        add_custom_command(TARGET info
+            COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_EXT_SIMD            ${BF_COLOR_GRN}enabled${BF_COLOR_RST}"
+            VERBATIM
+        )
+    else()
+        add_custom_command(TARGET info
+            COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_EXT_SIMD            ${BF_COLOR_RED}disabled${BF_COLOR_RST}"
+            VERBATIM
+        )
+    endif()
+
     add_custom_command(TARGET info
         COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_TARGET_ARCH         ${BF_COLOR_CYN}${HYPERVISOR_TARGET_ARCH}${BF_COLOR_RST}"
         VERBATIM
@@ -158,6 +182,16 @@ macro(hypervisor_add_info)
         VERBATIM
     )
 
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_VMEXIT_STATS_SIZE   ${BF_COLOR_CYN}${HYPERVISOR_VMEXIT_STATS_SIZE}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_TRACE_SIZE          ${BF_COLOR_CYN}${HYPERVISOR_TRACE_SIZE}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
     add_custom_command(TARGET info
         COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_MAX_ELF_FILE_SIZE   ${BF_COLOR_CYN}${HYPERVISOR_MAX_ELF_FILE_SIZE}${BF_COLOR_RST}"
         VERBATIM
@@ -183,6 +217,16 @@ macro(hypervisor_add_info)
         VERBATIM
     )
 
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_MAX_NUMA_NODES      ${BF_COLOR_CYN}${HYPERVISOR_MAX_NUMA_NODES}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_MAX_HUGE_POOL_SEGMENTS ${BF_COLOR_CYN}${HYPERVISOR_MAX_HUGE_POOL_SEGMENTS}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
     add_custom_command(TARGET info
         COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_MAX_VPS             ${BF_COLOR_CYN}${HYPERVISOR_MAX_VPS}${BF_COLOR_RST}"
         VERBATIM
@@ -233,6 +277,21 @@ macro(hypervisor_add_info)
         VERBATIM
     )
 
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK ${BF_COLOR_CYN}${HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE ${BF_COLOR_CYN}${HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_MAX_PAGE_POOL_DONATIONS ${BF_COLOR_CYN}${HYPERVISOR_MAX_PAGE_POOL_DONATIONS}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
     add_custom_command(TARGET info
         COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_MK_HUGE_POOL_ADDR   ${BF_COLOR_CYN}${HYPERVISOR_MK_HUGE_POOL_ADDR}${BF_COLOR_RST}"
         VERBATIM
@@ -253,6 +312,16 @@ macro(hypervisor_add_info)
         VERBATIM
     )
 
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE ${BF_COLOR_CYN}${HYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE ${BF_COLOR_CYN}${HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
     add_custom_command(TARGET info
         COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   HYPERVISOR_EXT_STACK_ADDR      ${BF_COLOR_CYN}${HYPERVISOR_EXT_STACK_ADDR}${BF_COLOR_RST}"
         VERBATIM
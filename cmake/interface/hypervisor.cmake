@@ -38,11 +38,15 @@ target_compile_definitions(hypervisor INTERFACE
     HYPERVISOR_SERIAL_PORT=${HYPERVISOR_SERIAL_PORT}
     HYPERVISOR_DEBUG_RING_SIZE=${HYPERVISOR_DEBUG_RING_SIZE}
     HYPERVISOR_VMEXIT_LOG_SIZE=${HYPERVISOR_VMEXIT_LOG_SIZE}
+    HYPERVISOR_VMEXIT_STATS_SIZE=${HYPERVISOR_VMEXIT_STATS_SIZE}
+    HYPERVISOR_TRACE_SIZE=${HYPERVISOR_TRACE_SIZE}
     HYPERVISOR_MAX_ELF_FILE_SIZE=${HYPERVISOR_MAX_ELF_FILE_SIZE}
     HYPERVISOR_MAX_SEGMENTS=${HYPERVISOR_MAX_SEGMENTS}
     HYPERVISOR_MAX_EXTENSIONS=${HYPERVISOR_MAX_EXTENSIONS}
     HYPERVISOR_MAX_VMS=${HYPERVISOR_MAX_VMS}
     HYPERVISOR_MAX_PPS=${HYPERVISOR_MAX_PPS}
+    HYPERVISOR_MAX_NUMA_NODES=${HYPERVISOR_MAX_NUMA_NODES}
+    HYPERVISOR_MAX_HUGE_POOL_SEGMENTS=${HYPERVISOR_MAX_HUGE_POOL_SEGMENTS}
     HYPERVISOR_MAX_VPS=${HYPERVISOR_MAX_VPS}
     HYPERVISOR_MAX_VPSS=${HYPERVISOR_MAX_VPSS}
     HYPERVISOR_MK_DIRECT_MAP_ADDR=${HYPERVISOR_MK_DIRECT_MAP_ADDR}
@@ -53,10 +57,15 @@ target_compile_definitions(hypervisor INTERFACE
     HYPERVISOR_MK_CODE_SIZE=${HYPERVISOR_MK_CODE_SIZE}
     HYPERVISOR_MK_PAGE_POOL_ADDR=${HYPERVISOR_MK_PAGE_POOL_ADDR}
     HYPERVISOR_MK_PAGE_POOL_SIZE=${HYPERVISOR_MK_PAGE_POOL_SIZE}
+    HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK=${HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK}
+    HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE=${HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE}
+    HYPERVISOR_MAX_PAGE_POOL_DONATIONS=${HYPERVISOR_MAX_PAGE_POOL_DONATIONS}
     HYPERVISOR_MK_HUGE_POOL_ADDR=${HYPERVISOR_MK_HUGE_POOL_ADDR}
     HYPERVISOR_MK_HUGE_POOL_SIZE=${HYPERVISOR_MK_HUGE_POOL_SIZE}
     HYPERVISOR_EXT_DIRECT_MAP_ADDR=${HYPERVISOR_EXT_DIRECT_MAP_ADDR}
     HYPERVISOR_EXT_DIRECT_MAP_SIZE=${HYPERVISOR_EXT_DIRECT_MAP_SIZE}
+    HYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE=${HYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE}
+    HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE=${HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE}
     HYPERVISOR_EXT_STACK_ADDR=${HYPERVISOR_EXT_STACK_ADDR}
     HYPERVISOR_EXT_STACK_SIZE=${HYPERVISOR_EXT_STACK_SIZE}
     HYPERVISOR_EXT_CODE_ADDR=${HYPERVISOR_EXT_CODE_ADDR}
@@ -71,6 +80,16 @@ target_compile_definitions(hypervisor INTERFACE
     HYPERVISOR_EXT_HEAP_POOL_SIZE=${HYPERVISOR_EXT_HEAP_POOL_SIZE}
 )
 
+if(HYPERVISOR_EXT_SIMD)
+    target_compile_definitions(hypervisor INTERFACE
+        HYPERVISOR_EXT_SIMD=1
+    )
+else()
+    target_compile_definitions(hypervisor INTERFACE
+        HYPERVISOR_EXT_SIMD=0
+    )
+endif()
+
 if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD")
     target_compile_definitions(hypervisor INTERFACE
         HYPERVISOR_X64=true
@@ -58,11 +58,15 @@ endif()
 
 hypervisor_silence(HYPERVISOR_DEBUG_RING_SIZE)
 hypervisor_silence(HYPERVISOR_VMEXIT_LOG_SIZE)
+hypervisor_silence(HYPERVISOR_VMEXIT_STATS_SIZE)
+hypervisor_silence(HYPERVISOR_TRACE_SIZE)
 hypervisor_silence(HYPERVISOR_MAX_ELF_FILE_SIZE)
 hypervisor_silence(HYPERVISOR_MAX_SEGMENTS)
 hypervisor_silence(HYPERVISOR_MAX_EXTENSIONS)
 hypervisor_silence(HYPERVISOR_MAX_VMS)
 hypervisor_silence(HYPERVISOR_MAX_PPS)
+hypervisor_silence(HYPERVISOR_MAX_NUMA_NODES)
+hypervisor_silence(HYPERVISOR_MAX_HUGE_POOL_SEGMENTS)
 hypervisor_silence(HYPERVISOR_MAX_VPS)
 hypervisor_silence(HYPERVISOR_MAX_VPSS)
 hypervisor_silence(HYPERVISOR_MK_DIRECT_MAP_ADDR)
@@ -73,10 +77,15 @@ hypervisor_silence(HYPERVISOR_MK_CODE_ADDR)
 hypervisor_silence(HYPERVISOR_MK_CODE_SIZE)
 hypervisor_silence(HYPERVISOR_MK_PAGE_POOL_ADDR)
 hypervisor_silence(HYPERVISOR_MK_PAGE_POOL_SIZE)
+hypervisor_silence(HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK)
+hypervisor_silence(HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE)
+hypervisor_silence(HYPERVISOR_MAX_PAGE_POOL_DONATIONS)
 hypervisor_silence(HYPERVISOR_MK_HUGE_POOL_ADDR)
 hypervisor_silence(HYPERVISOR_MK_HUGE_POOL_SIZE)
 hypervisor_silence(HYPERVISOR_EXT_DIRECT_MAP_ADDR)
 hypervisor_silence(HYPERVISOR_EXT_DIRECT_MAP_SIZE)
+hypervisor_silence(HYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE)
+hypervisor_silence(HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE)
 hypervisor_silence(HYPERVISOR_EXT_STACK_ADDR)
 hypervisor_silence(HYPERVISOR_EXT_STACK_SIZE)
 hypervisor_silence(HYPERVISOR_EXT_CODE_ADDR)
@@ -89,3 +98,4 @@ hypervisor_silence(HYPERVISOR_EXT_HUGE_POOL_ADDR)
 hypervisor_silence(HYPERVISOR_EXT_HUGE_POOL_SIZE)
 hypervisor_silence(HYPERVISOR_EXT_HEAP_POOL_ADDR)
 hypervisor_silence(HYPERVISOR_EXT_HEAP_POOL_SIZE)
+hypervisor_silence(HYPERVISOR_EXT_SIMD)
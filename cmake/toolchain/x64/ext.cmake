@@ -25,21 +25,32 @@ set(CMAKE_CXX_COMPILER_WORKS 1)
 string(CONCAT HYPERVISOR_EXT_CXX_FLAGS
     "--target=x86_64-elf "
     "-ffreestanding "
-    "-mno-mmx "
-    "-mno-sse "
-    "-mno-sse2 "
-    "-mno-sse3 "
-    "-mno-ssse3 "
-    "-mno-sse4.1 "
-    "-mno-sse4.2 "
-    "-mno-sse4 "
-    "-mno-avx "
-    "-mno-aes "
-    "-mno-sse4a "
     "-mcmodel=large "
     "-std=c++20 "
 )
 
+# NOTE:
+# - Extensions can only use the FPU if the microkernel switches its state
+#   lazily (see the #NM handler), which is what HYPERVISOR_EXT_SIMD turns on.
+#
+
+if(NOT HYPERVISOR_EXT_SIMD)
+    string(CONCAT HYPERVISOR_EXT_CXX_FLAGS
+        ${HYPERVISOR_EXT_CXX_FLAGS}
+        "-mno-mmx "
+        "-mno-sse "
+        "-mno-sse2 "
+        "-mno-sse3 "
+        "-mno-ssse3 "
+        "-mno-sse4.1 "
+        "-mno-sse4.2 "
+        "-mno-sse4 "
+        "-mno-avx "
+        "-mno-aes "
+        "-mno-sse4a "
+    )
+endif()
+
 if(CMAKE_BUILD_TYPE STREQUAL RELEASE OR CMAKE_BUILD_TYPE STREQUAL MINSIZEREL)
     string(CONCAT HYPERVISOR_EXT_CXX_FLAGS
         ${HYPERVISOR_EXT_CXX_FLAGS}
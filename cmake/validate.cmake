@@ -23,6 +23,10 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
     if(HYPERVISOR_BUILD_VMMCTL)
         message(FATAL_ERROR "HYPERVISOR_BUILD_VMMCTL is not supported on ARM")
     endif()
+
+    if(HYPERVISOR_BUILD_BENCH)
+        message(FATAL_ERROR "HYPERVISOR_BUILD_BENCH is not supported on ARM")
+    endif()
 endif()
 
 list(LENGTH HYPERVISOR_EXTENSIONS HYPERVISOR_EXTENSIONS_LENGTH)
@@ -46,6 +50,14 @@ if(HYPERVISOR_VMEXIT_LOG_SIZE LESS 1)
     message(FATAL_ERROR "HYPERVISOR_VMEXIT_LOG_SIZE must be at least 1")
 endif()
 
+if(HYPERVISOR_VMEXIT_STATS_SIZE LESS 1)
+    message(FATAL_ERROR "HYPERVISOR_VMEXIT_STATS_SIZE must be at least 1")
+endif()
+
+if(HYPERVISOR_TRACE_SIZE LESS 1)
+    message(FATAL_ERROR "HYPERVISOR_TRACE_SIZE must be at least 1")
+endif()
+
 if(HYPERVISOR_MAX_SEGMENTS LESS 2)
     message(FATAL_ERROR "HYPERVISOR_MAX_SEGMENTS must be at least 2")
 endif()
@@ -62,6 +74,14 @@ if(HYPERVISOR_MAX_PPS LESS 1)
     message(FATAL_ERROR "HYPERVISOR_MAX_PPS must be at least 1")
 endif()
 
+if(HYPERVISOR_MAX_NUMA_NODES LESS 1)
+    message(FATAL_ERROR "HYPERVISOR_MAX_NUMA_NODES must be at least 1")
+endif()
+
+if(HYPERVISOR_MAX_HUGE_POOL_SEGMENTS LESS HYPERVISOR_MAX_NUMA_NODES)
+    message(FATAL_ERROR "HYPERVISOR_MAX_HUGE_POOL_SEGMENTS must be the same or greater as HYPERVISOR_MAX_NUMA_NODES")
+endif()
+
 if(HYPERVISOR_MAX_VPS LESS HYPERVISOR_MAX_PPS)
     message(FATAL_ERROR "HYPERVISOR_MAX_VPS the same or greater as HYPERVISOR_MAX_PPS")
 endif()
@@ -78,6 +98,14 @@ if(HYPERVISOR_MK_PAGE_POOL_SIZE LESS 0x1000)
     message(FATAL_ERROR "HYPERVISOR_MK_PAGE_POOL_SIZE must be at least a page")
 endif()
 
+if(HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE LESS 0x1000)
+    message(FATAL_ERROR "HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE must be at least a page")
+endif()
+
+if(HYPERVISOR_MAX_PAGE_POOL_DONATIONS LESS 1)
+    message(FATAL_ERROR "HYPERVISOR_MAX_PAGE_POOL_DONATIONS must be at least 1")
+endif()
+
 if(HYPERVISOR_MK_HUGE_POOL_SIZE LESS 0x1000)
     message(FATAL_ERROR "HYPERVISOR_MK_HUGE_POOL_SIZE must be at least a page")
 endif()
@@ -85,3 +113,8 @@ endif()
 if(HYPERVISOR_EXT_STACK_SIZE LESS 0x1000)
     message(FATAL_ERROR "HYPERVISOR_EXT_STACK_SIZE must be at least a page")
 endif()
+
+math(EXPR HYPERVISOR_EXT_DIRECT_MAP_PREMAP_REM "${HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE} % 0x200000")
+if(NOT HYPERVISOR_EXT_DIRECT_MAP_PREMAP_REM EQUAL 0)
+    message(FATAL_ERROR "HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE must be a multiple of 2M")
+endif()
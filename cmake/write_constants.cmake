@@ -47,11 +47,15 @@ if (NOT EXISTS ${CMAKE_BINARY_DIR}/include/constants.h)
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_PAGE_SHIFT ((uint64_t)(${HYPERVISOR_PAGE_SHIFT}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_DEBUG_RING_SIZE ((uint64_t)(${HYPERVISOR_DEBUG_RING_SIZE}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_VMEXIT_LOG_SIZE ((uint64_t)(${HYPERVISOR_VMEXIT_LOG_SIZE}))\n")
+    file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_VMEXIT_STATS_SIZE ((uint64_t)(${HYPERVISOR_VMEXIT_STATS_SIZE}))\n")
+    file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_TRACE_SIZE ((uint64_t)(${HYPERVISOR_TRACE_SIZE}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_ELF_FILE_SIZE ((uint64_t)(${HYPERVISOR_MAX_ELF_FILE_SIZE}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_SEGMENTS ((uint64_t)(${HYPERVISOR_MAX_SEGMENTS}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_EXTENSIONS ((uint64_t)(${HYPERVISOR_MAX_EXTENSIONS}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_VMS ((uint64_t)(${HYPERVISOR_MAX_VMS}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_PPS ((uint64_t)(${HYPERVISOR_MAX_PPS}))\n")
+    file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_NUMA_NODES ((uint64_t)(${HYPERVISOR_MAX_NUMA_NODES}))\n")
+    file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_HUGE_POOL_SEGMENTS ((uint64_t)(${HYPERVISOR_MAX_HUGE_POOL_SEGMENTS}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_VPS ((uint64_t)(${HYPERVISOR_MAX_VPS}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_VPSS ((uint64_t)(${HYPERVISOR_MAX_VPSS}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MK_DIRECT_MAP_ADDR ((uint64_t)(${HYPERVISOR_MK_DIRECT_MAP_ADDR}))\n")
@@ -62,6 +66,9 @@ if (NOT EXISTS ${CMAKE_BINARY_DIR}/include/constants.h)
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MK_CODE_SIZE ((uint64_t)(${HYPERVISOR_MK_CODE_SIZE}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MK_PAGE_POOL_ADDR ((uint64_t)(${HYPERVISOR_MK_PAGE_POOL_ADDR}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MK_PAGE_POOL_SIZE ((uint64_t)(${HYPERVISOR_MK_PAGE_POOL_SIZE}))\n")
+    file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK ((uint64_t)(${HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK}))\n")
+    file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE ((uint64_t)(${HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE}))\n")
+    file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MAX_PAGE_POOL_DONATIONS ((uint64_t)(${HYPERVISOR_MAX_PAGE_POOL_DONATIONS}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MK_HUGE_POOL_ADDR ((uint64_t)(${HYPERVISOR_MK_HUGE_POOL_ADDR}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_MK_HUGE_POOL_SIZE ((uint64_t)(${HYPERVISOR_MK_HUGE_POOL_SIZE}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define HYPERVISOR_EXT_DIRECT_MAP_ADDR ((uint64_t)(${HYPERVISOR_EXT_DIRECT_MAP_ADDR}))\n")
@@ -140,6 +140,17 @@ namespace example
             return ret;
         }
 
+        /// NOTE:
+        /// - Let the microkernel handle CPUID without calling this
+        ///   extension.
+        ///
+
+        ret = init_exit_policy(handle, vpsid, bsl::safe_uintmax::zero(true));
+        if (bsl::unlikely_assert(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            return ret;
+        }
+
         return ret;
     }
 }
@@ -440,6 +440,20 @@ namespace example
             return ret;
         }
 
+        /// NOTE:
+        /// - Let the microkernel handle CPUID, and the few RDMSRs that the
+        ///   MSR bitmaps do not cover (which we only skip, see vmexit()),
+        ///   without calling this extension.
+        ///
+
+        constexpr bsl::safe_uintmax exit_reason_rdmsr{bsl::to_umax(0x1FU)};
+
+        ret = init_exit_policy(handle, vpsid, exit_reason_rdmsr);
+        if (bsl::unlikely_assert(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            return ret;
+        }
+
         return ret;
     }
 }
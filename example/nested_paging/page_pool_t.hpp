@@ -32,6 +32,7 @@
 #include <bsl/convert.hpp>
 #include <bsl/cstring.hpp>
 #include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
 #include <bsl/disjunction.hpp>
 #include <bsl/errc_type.hpp>
 #include <bsl/finally.hpp>
@@ -44,6 +45,9 @@
 
 namespace example
 {
+    /// @brief defines the number of pages requested from the kernel on a refill
+    constexpr auto PAGE_POOL_REFILL_COUNT{bsl::to_umax(64)};
+
     /// @class example::page_pool_t
     ///
     /// <!-- description -->
@@ -67,6 +71,15 @@ namespace example
     ///      for pages when it needs it, and it is able to reuse memory
     ///      when it is freed.
     ///
+    ///      When the pool runs dry, it asks the kernel for
+    ///      PAGE_POOL_REFILL_COUNT pages at once using
+    ///      bf_mem_op_alloc_pages instead of one page per syscall. The
+    ///      page array handed to the kernel must not cross a page boundary,
+    ///      so the pool allocates a single page the first time it is
+    ///      refilled and reuses it as the page array from then on. Nothing
+    ///      in this class is specific to nested paging, so it can be copied
+    ///      as is into any extension that needs a page allocator.
+    ///
     class page_pool_t final
     {
         /// @brief stores true if initialized() has been executed
@@ -75,11 +88,81 @@ namespace example
         syscall::bf_handle_t m_handle{};
         /// @brief stores the head of the page pool stack.
         void *m_head{};
+        /// @brief stores the page array used to refill the page pool.
+        syscall::bf_page_t *m_refill{};
         /// @brief stores the total number of bytes in the page pool.
         bsl::safe_uintmax m_size{};
         /// @brief safe guards operations on the pool.
         mutable spinlock m_pool_lock{};
 
+        /// <!-- description -->
+        ///   @brief Adds pages from the kernel to the page pool. The pages
+        ///     are requested in bulk using bf_mem_op_alloc_pages. If the
+        ///     kernel is only able to provide some of the requested pages,
+        ///     the pages that were provided are still added to the pool,
+        ///     and this function only fails if no pages could be added.
+        ///     The caller must hold m_pool_lock.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        refill() &noexcept -> bsl::errc_type
+        {
+            bsl::safe_uintmax phys{};
+            constexpr auto page_size{bsl::to_umax(HYPERVISOR_PAGE_SIZE)};
+
+            if (nullptr == m_refill) {
+                auto const ret{syscall::bf_mem_op_alloc_page(m_handle, m_refill, phys)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::span<syscall::bf_page_t> const pages{m_refill, PAGE_POOL_REFILL_COUNT};
+
+            /// NOTE:
+            /// - A failure here is not fatal. Any entry that the kernel was
+            ///   not able to allocate is left as 0, so whatever it did
+            ///   allocate is added to the pool below.
+            /// - The page array is cleared first so that a kernel that does
+            ///   not implement bf_mem_op_alloc_pages cannot leave behind
+            ///   entries from the previous refill, which are already in use.
+            ///
+
+            bsl::builtin_memset(m_refill, '\0', page_size.get());
+            bsl::discard(syscall::bf_mem_op_alloc_pages(m_handle, pages));
+            for (auto const elem : pages) {
+                if (nullptr == elem.data->virt) {
+                    break;
+                }
+
+                *static_cast<void **>(elem.data->virt) = m_head;
+                m_head = elem.data->virt;
+                m_size += page_size;
+            }
+
+            if (nullptr != m_head) {
+                return bsl::errc_success;
+            }
+
+            auto const ret{syscall::bf_mem_op_alloc_page(m_handle, m_head, phys)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            m_size += page_size;
+            return bsl::errc_success;
+        }
+
     public:
         /// <!-- description -->
         ///   @brief Default constructor
@@ -121,6 +204,7 @@ namespace example
         release() &noexcept
         {
             m_size = {};
+            m_refill = {};
             m_head = {};
 
             m_handle = {};
@@ -187,8 +271,7 @@ namespace example
             }
 
             if (bsl::unlikely(nullptr == m_head)) {
-                bsl::safe_uintmax phys{};
-                auto const ret{syscall::bf_mem_op_alloc_page(m_handle, m_head, phys)};
+                auto const ret{this->refill()};
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return nullptr;
@@ -26,6 +26,7 @@
 #define ARCH_SUPPORT_HPP
 
 #include <common_arch_support.hpp>
+#include <intrinsic_cpuid.hpp>
 #include <mk_interface.hpp>
 #include <nested_page_table_t.hpp>
 #include <page_pool_t.hpp>
@@ -228,8 +229,8 @@ namespace example
         ///   paging. You could also fill the entire physical address space
         ///   (up to the MAX value provided by CPUID), but how much memory
         ///   you need to allocate for the page tables to make that work is
-        ///   up to what granularity you use. In this example, we only
-        ///   provide 2M granularity, so this approach is likely a bad idea.
+        ///   up to what granularity you use. In this example, we use 1G
+        ///   pages when the CPU supports them, and 2M pages otherwise.
         /// - Also note that what we are creating here is what we call an
         ///   identify map. Basically, each guest physical address is mapped
         ///   to the same system physical address. This is needed (usually)
@@ -240,7 +241,10 @@ namespace example
         ///
 
         constexpr bsl::safe_uint64 page_size_2m{bsl::to_umax(0x200000U)};
+        constexpr bsl::safe_uint64 page_size_1g{bsl::to_umax(0x40000000U)};
         constexpr bsl::safe_uint64 max_physical_mem{bsl::to_umax(0x8000000000U)};
+        constexpr bsl::safe_uintmax cpuid_ext_feature_identifiers{bsl::to_umax(0x80000001U)};
+        constexpr bsl::safe_uintmax cpuid_ext_feature_identifiers_page1gb{bsl::to_umax(0x4000000U)};
 
         if (syscall::bf_tls_ppid() == bsl::ZERO_U16) {
             ret = g_npt.initialize(&g_page_pool);
@@ -249,8 +253,28 @@ namespace example
                 return ret;
             }
 
-            for (bsl::safe_uintmax gpa{}; gpa < max_physical_mem; gpa += page_size_2m) {
-                ret = g_npt.map_2m_page(gpa, gpa, MAP_PAGE_RWE, MEMORY_TYPE_WB);
+            bsl::safe_uintmax rax{cpuid_ext_feature_identifiers};
+            bsl::safe_uintmax rbx{};
+            bsl::safe_uintmax rcx{};
+            bsl::safe_uintmax rdx{};
+            intrinsic_cpuid(rax.data(), rbx.data(), rcx.data(), rdx.data());
+
+            bsl::safe_uintmax page_size{page_size_2m};
+            if (!(rdx & cpuid_ext_feature_identifiers_page1gb).is_zero()) {
+                page_size = page_size_1g;
+            }
+            else {
+                bsl::touch();
+            }
+
+            for (bsl::safe_uintmax gpa{}; gpa < max_physical_mem; gpa += page_size) {
+                if (page_size == page_size_1g) {
+                    ret = g_npt.map_1g_page(gpa, gpa, MAP_PAGE_RWE, MEMORY_TYPE_WB);
+                }
+                else {
+                    ret = g_npt.map_2m_page(gpa, gpa, MAP_PAGE_RWE, MEMORY_TYPE_WB);
+                }
+
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
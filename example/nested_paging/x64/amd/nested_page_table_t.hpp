@@ -126,12 +126,15 @@ namespace example
         remove_npdpt(npml4te_t *const npml4te) noexcept
         {
             for (auto const elem : get_npdpt(npml4te)->entries) {
-                if (elem.data->p != bsl::ZERO_UMAX) {
-                    this->remove_npdt(elem.data);
+                if (elem.data->p == bsl::ZERO_UMAX) {
+                    continue;
                 }
-                else {
-                    bsl::touch();
+
+                if (elem.data->ps != bsl::ZERO_UMAX) {
+                    continue;
                 }
+
+                this->remove_npdt(elem.data);
             }
 
             m_page_pool->deallocate(get_npdpt(npml4te));
@@ -228,12 +231,15 @@ namespace example
         remove_npdt(npdpte_t *const npdpte) noexcept
         {
             for (auto const elem : get_npdt(npdpte)->entries) {
-                if (elem.data->p != bsl::ZERO_UMAX) {
-                    this->remove_npt(elem.data);
+                if (elem.data->p == bsl::ZERO_UMAX) {
+                    continue;
                 }
-                else {
-                    bsl::touch();
+
+                if (elem.data->ps != bsl::ZERO_UMAX) {
+                    continue;
                 }
+
+                this->remove_npt(elem.data);
             }
 
             m_page_pool->deallocate(get_npdt(npdpte));
@@ -672,6 +678,16 @@ namespace example
                 bsl::touch();
             }
 
+            if (bsl::unlikely(npdpte->ps != bsl::ZERO_UMAX)) {
+                bsl::error() << "guest physical address "         // --
+                             << bsl::hex(page_gpa)                // --
+                             << " already mapped by a 1g page"    // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
+
+                return bsl::errc_failure;
+            }
+
             auto *const npdt{this->get_npdt(npdpte)};
             auto *const npdte{npdt->entries.at_if(this->npdto(page_gpa))};
             if (npdte->p == bsl::ZERO_UMAX) {
@@ -686,6 +702,16 @@ namespace example
                 bsl::touch();
             }
 
+            if (bsl::unlikely(npdte->ps != bsl::ZERO_UMAX)) {
+                bsl::error() << "guest physical address "         // --
+                             << bsl::hex(page_gpa)                // --
+                             << " already mapped by a 2m page"    // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
+
+                return bsl::errc_failure;
+            }
+
             auto *const npt{this->get_npt(npdte)};
             auto *const npte{npt->entries.at_if(this->npto(page_gpa))};
             if (bsl::unlikely(npte->p != bsl::ZERO_UMAX)) {
@@ -862,6 +888,16 @@ namespace example
                 bsl::touch();
             }
 
+            if (bsl::unlikely(npdpte->ps != bsl::ZERO_UMAX)) {
+                bsl::error() << "guest physical address "         // --
+                             << bsl::hex(page_gpa)                // --
+                             << " already mapped by a 1g page"    // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
+
+                return bsl::errc_failure;
+            }
+
             auto *const npdt{this->get_npdt(npdpte)};
             auto *const npdte{npdt->entries.at_if(this->npdto(page_gpa))};
             if (bsl::unlikely(npdte->p != bsl::ZERO_UMAX)) {
@@ -903,6 +939,169 @@ namespace example
 
             return bsl::errc_success;
         }
+
+        /// <!-- description -->
+        ///   @brief Maps a 1g page into the nested page tables being managed
+        ///     by this class.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param page_gpa the guest physical address to map the system
+        ///     physical address to
+        ///   @param page_spa the system physical address to map.
+        ///   @param page_flags defines how memory should be mapped
+        ///   @param page_type defines the memory type for the mapping
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        map_1g_page(
+            bsl::safe_uintmax const &page_gpa,
+            bsl::safe_uintmax const &page_spa,
+            bsl::safe_uintmax const &page_flags,
+            bsl::safe_uintmax const &page_type) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{m_npt_lock};
+
+            if (bsl::unlikely(!m_initialized)) {
+                bsl::error() << "nested_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!page_gpa)) {
+                bsl::error() << "guest physical address is invalid: "    // --
+                             << bsl::hex(page_gpa)                       // --
+                             << bsl::endl                                // --
+                             << bsl::here();                             // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!this->is_page_aligned(page_gpa))) {
+                bsl::error() << "guest physical address is not page aligned: "    // --
+                             << bsl::hex(page_gpa)                                // --
+                             << bsl::endl                                         // --
+                             << bsl::here();                                      // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!page_spa)) {
+                bsl::error() << "system physical address is invalid: "    // --
+                             << bsl::hex(page_spa)                        // --
+                             << bsl::endl                                 // --
+                             << bsl::here();                              // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!this->is_page_aligned(page_spa))) {
+                bsl::error() << "system physical address is not page aligned: "    // --
+                             << bsl::hex(page_spa)                                 // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!page_flags)) {
+                bsl::error() << "invalid flags: "       // --
+                             << bsl::hex(page_flags)    // --
+                             << bsl::endl               // --
+                             << bsl::here();            // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!page_type)) {
+                bsl::error() << "invalid flags: "      // --
+                             << bsl::hex(page_type)    // --
+                             << bsl::endl              // --
+                             << bsl::here();           // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(page_type == MEMORY_TYPE_WC)) {
+                bsl::error() << "invalid flags: "       // --
+                             << bsl::hex(page_flags)    // --
+                             << bsl::endl               // --
+                             << bsl::here();            // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(page_type == MEMORY_TYPE_WT)) {
+                bsl::error() << "invalid flags: "       // --
+                             << bsl::hex(page_flags)    // --
+                             << bsl::endl               // --
+                             << bsl::here();            // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(page_type == MEMORY_TYPE_WP)) {
+                bsl::error() << "invalid flags: "       // --
+                             << bsl::hex(page_flags)    // --
+                             << bsl::endl               // --
+                             << bsl::here();            // --
+
+                return bsl::errc_failure;
+            }
+
+            auto *const npml4te{m_npml4t->entries.at_if(this->npml4to(page_gpa))};
+            if (npml4te->p == bsl::ZERO_UMAX) {
+                if (bsl::unlikely(!this->add_npdpt(npml4te))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto *const npdpt{this->get_npdpt(npml4te)};
+            auto *const npdpte{npdpt->entries.at_if(this->npdpto(page_gpa))};
+            if (bsl::unlikely(npdpte->p != bsl::ZERO_UMAX)) {
+                bsl::error() << "guest physical address "    // --
+                             << bsl::hex(page_gpa)           // --
+                             << " already mapped"            // --
+                             << bsl::endl                    // --
+                             << bsl::here();                 // --
+
+                return bsl::errc_failure;
+            }
+
+            npdpte->phys = (page_spa >> bsl::to_umax(HYPERVISOR_PAGE_SHIFT)).get();
+            npdpte->p = bsl::ONE_UMAX.get();
+            npdpte->us = bsl::ONE_UMAX.get();
+            npdpte->ps = bsl::ONE_UMAX.get();
+
+            if (!(page_flags & MAP_PAGE_WRITE).is_zero()) {
+                npdpte->rw = bsl::ONE_UMAX.get();
+            }
+            else {
+                npdpte->rw = bsl::ZERO_UMAX.get();
+            }
+
+            if (!(page_flags & MAP_PAGE_EXECUTE).is_zero()) {
+                npdpte->nx = bsl::ZERO_UMAX.get();
+            }
+            else {
+                npdpte->nx = bsl::ONE_UMAX.get();
+            }
+
+            if (page_type == MEMORY_TYPE_UC) {
+                npdpte->pwt = bsl::ONE_UMAX.get();
+                npdpte->pcd = bsl::ONE_UMAX.get();
+            }
+            else {
+                bsl::touch();
+            }
+
+            return bsl::errc_success;
+        }
     };
 }
 
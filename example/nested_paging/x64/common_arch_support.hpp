@@ -36,6 +36,7 @@
 #include <bsl/errc_type.hpp>
 #include <bsl/safe_integral.hpp>
 #include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
 #include <bsl/unlikely_assert.hpp>
 
 namespace example
@@ -123,6 +124,114 @@ namespace example
                     return bsl::errc_success;
                 }
 
+                case loader::CPUID_COMMAND_ECX_DUMP_VMEXIT_STATS.get(): {
+                    for (bsl::safe_uint16 ppid{}; ppid < syscall::bf_tls_online_pps(); ++ppid) {
+                        syscall::bf_debug_op_dump_vmexit_stats(ppid);
+                    }
+
+                    return bsl::errc_success;
+                }
+
+                case loader::CPUID_COMMAND_ECX_TRACE_START.get(): {
+                    syscall::bf_control_op_trace(true);
+                    return bsl::errc_success;
+                }
+
+                case loader::CPUID_COMMAND_ECX_TRACE_STOP.get(): {
+
+                    /// NOTE:
+                    /// - Only the PP in EDX is dumped, as the trace of
+                    ///   every PP does not fit in the debug ring. The
+                    ///   loader asks for each PP in turn. A PP that is not
+                    ///   online dumps nothing, which tells the loader that
+                    ///   there are no more PPs.
+                    ///
+
+                    syscall::bf_control_op_trace(false);
+
+                    auto const ppid{bsl::to_u16_unsafe(rdx)};
+                    if (ppid < syscall::bf_tls_online_pps()) {
+                        syscall::bf_debug_op_dump_trace(ppid);
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    return bsl::errc_success;
+                }
+
+                case loader::CPUID_COMMAND_ECX_DONATE_PAGES.get(): {
+
+                    /// NOTE:
+                    /// - The physical address of the list of donated
+                    ///   pages is page aligned, so the loader stores the
+                    ///   NUMA node in the lower 12 bits of EDX. The rest of
+                    ///   EDX holds bits 31:12 of the list, and EBX holds
+                    ///   bits 63:32. The microkernel validates the list.
+                    /// - RAX is only set to 0 on success. On failure, the
+                    ///   loader sees the CPUID command in RAX and can try
+                    ///   again later, so there is no reason to fail this
+                    ///   VMExit.
+                    /// - Only the loader is allowed to donate pages, so the
+                    ///   command is only accepted from the root VM at CPL0
+                    ///   (i.e., SS.DPL is 0). From anywhere else, it is
+                    ///   handled like any other CPUID.
+                    ///
+
+                    bsl::safe_uint64 ss_attrib{};
+                    ret = syscall::bf_vps_op_read_reg(
+                        handle, vpsid, syscall::bf_reg_t::bf_reg_t_ss_attributes, ss_attrib);
+                    if (bsl::unlikely_assert(!ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return ret;
+                    }
+
+                    constexpr auto dpl_bits{bsl::to_u64(5)};
+                    constexpr auto dpl_mask{bsl::to_u64(0x3U)};
+
+                    auto const cpl{(ss_attrib >> dpl_bits) & dpl_mask};
+                    if (syscall::BF_ROOT_VMID != syscall::bf_tls_vmid() || !cpl.is_zero()) {
+                        break;
+                    }
+
+                    constexpr auto node_bits{bsl::to_umax(12)};
+                    constexpr auto half_bits{bsl::to_umax(32)};
+                    constexpr auto node_mask{bsl::to_umax(0xFFFU)};
+                    constexpr auto half_mask{bsl::to_umax(0xFFFFFFFFU)};
+
+                    auto const lo{((rdx & half_mask) >> node_bits) << node_bits};
+                    auto const list{((rbx & half_mask) << half_bits) | lo};
+                    auto const node{bsl::to_u16_unsafe(rdx & node_mask)};
+
+                    ret = syscall::bf_mem_op_donate_pages(handle, list, node);
+                    if (bsl::unlikely(!ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return bsl::errc_success;
+                    }
+
+                    syscall::bf_tls_set_rax(handle, bsl::ZERO_UMAX);
+                    return bsl::errc_success;
+                }
+
+                case loader::CPUID_COMMAND_ECX_PAGE_POOL_LOW.get(): {
+                    bsl::safe_uint16 node{};
+                    ret = syscall::bf_mem_op_page_pool_low(handle, node);
+                    if (bsl::unlikely(!ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return bsl::errc_success;
+                    }
+
+                    if (syscall::BF_INVALID_ID == node) {
+                        auto const not_low{bsl::to_umax(loader::CPUID_COMMAND_PAGE_POOL_NOT_LOW)};
+                        syscall::bf_tls_set_rax(handle, not_low);
+                    }
+                    else {
+                        syscall::bf_tls_set_rax(handle, bsl::to_umax(node));
+                    }
+
+                    return bsl::errc_success;
+                }
+
                 default: {
                     break;
                 }
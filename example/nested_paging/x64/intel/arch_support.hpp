@@ -533,8 +533,9 @@ namespace example
         ///   paging. You could also fill the entire physical address space
         ///   (up to the MAX value provided by CPUID), but how much memory
         ///   you need to allocate for the page tables to make that work is
-        ///   up to what granularity you use. In this example, we only
-        ///   provide 2M granularity, so this approach is likely a bad idea.
+        ///   up to what granularity you use. In this example, we use 1G
+        ///   pages when the CPU supports them (falling back to 2M/4K pages
+        ///   only where the memory type changes), and 2M pages otherwise.
         /// - Also note that what we are creating here is what we call an
         ///   identify map. Basically, each guest physical address is mapped
         ///   to the same system physical address. This is needed (usually)
@@ -547,8 +548,17 @@ namespace example
         ///
 
         constexpr bsl::safe_uint64 max_physical_mem{bsl::to_umax(0x8000000000U)};
+        constexpr bsl::safe_uint32 ia32_vmx_ept_vpid_cap{bsl::to_u32(0x48CU)};
+        constexpr bsl::safe_uintmax ia32_vmx_ept_vpid_cap_1g{bsl::to_umax(0x20000U)};
 
         if (syscall::bf_tls_ppid() == bsl::ZERO_U16) {
+            bsl::safe_uintmax ept_vpid_cap{};
+            ret = syscall::bf_intrinsic_op_rdmsr(handle, ia32_vmx_ept_vpid_cap, ept_vpid_cap);
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
             ret = g_ept.initialize(&g_page_pool);
             if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
@@ -561,8 +571,14 @@ namespace example
                 return ret;
             }
 
-            ret = g_mtrrs.identity_map_2m(
-                g_ept, bsl::ZERO_UMAX, g_mtrrs.max_phys().min(max_physical_mem), MAP_PAGE_RWE);
+            auto const size{g_mtrrs.max_phys().min(max_physical_mem)};
+            if (!(ept_vpid_cap & ia32_vmx_ept_vpid_cap_1g).is_zero()) {
+                ret = g_mtrrs.identity_map_1g(g_ept, bsl::ZERO_UMAX, size, MAP_PAGE_RWE);
+            }
+            else {
+                ret = g_mtrrs.identity_map_2m(g_ept, bsl::ZERO_UMAX, size, MAP_PAGE_RWE);
+            }
+
             if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
                 return ret;
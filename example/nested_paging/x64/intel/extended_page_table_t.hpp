@@ -126,12 +126,15 @@ namespace example
         remove_epdpt(epml4te_t *const epml4te) noexcept
         {
             for (auto const elem : get_epdpt(epml4te)->entries) {
-                if (elem.data->r != bsl::ZERO_UMAX) {
-                    this->remove_epdt(elem.data);
+                if (elem.data->r == bsl::ZERO_UMAX) {
+                    continue;
                 }
-                else {
-                    bsl::touch();
+
+                if (elem.data->ps != bsl::ZERO_UMAX) {
+                    continue;
                 }
+
+                this->remove_epdt(elem.data);
             }
 
             m_page_pool->deallocate(get_epdpt(epml4te));
@@ -228,12 +231,15 @@ namespace example
         remove_epdt(epdpte_t *const epdpte) noexcept
         {
             for (auto const elem : get_epdt(epdpte)->entries) {
-                if (elem.data->r != bsl::ZERO_UMAX) {
-                    this->remove_ept(elem.data);
+                if (elem.data->r == bsl::ZERO_UMAX) {
+                    continue;
                 }
-                else {
-                    bsl::touch();
+
+                if (elem.data->ps != bsl::ZERO_UMAX) {
+                    continue;
                 }
+
+                this->remove_ept(elem.data);
             }
 
             m_page_pool->deallocate(get_epdt(epdpte));
@@ -645,6 +651,16 @@ namespace example
                 bsl::touch();
             }
 
+            if (bsl::unlikely(epdpte->ps != bsl::ZERO_UMAX)) {
+                bsl::error() << "guest physical address "         // --
+                             << bsl::hex(page_gpa)                // --
+                             << " already mapped by a 1g page"    // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
+
+                return bsl::errc_failure;
+            }
+
             auto *const epdt{this->get_epdt(epdpte)};
             auto *const epdte{epdt->entries.at_if(this->epdto(page_gpa))};
             if (epdte->r == bsl::ZERO_UMAX) {
@@ -659,6 +675,16 @@ namespace example
                 bsl::touch();
             }
 
+            if (bsl::unlikely(epdte->ps != bsl::ZERO_UMAX)) {
+                bsl::error() << "guest physical address "         // --
+                             << bsl::hex(page_gpa)                // --
+                             << " already mapped by a 2m page"    // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
+
+                return bsl::errc_failure;
+            }
+
             auto *const ept{this->get_ept(epdte)};
             auto *const epte{ept->entries.at_if(this->epto(page_gpa))};
             if (bsl::unlikely(epte->r != bsl::ZERO_UMAX)) {
@@ -800,6 +826,16 @@ namespace example
                 bsl::touch();
             }
 
+            if (bsl::unlikely(epdpte->ps != bsl::ZERO_UMAX)) {
+                bsl::error() << "guest physical address "         // --
+                             << bsl::hex(page_gpa)                // --
+                             << " already mapped by a 1g page"    // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
+
+                return bsl::errc_failure;
+            }
+
             auto *const epdt{this->get_epdt(epdpte)};
             auto *const epdte{epdt->entries.at_if(this->epdto(page_gpa))};
             if (bsl::unlikely(epdte->r != bsl::ZERO_UMAX)) {
@@ -833,6 +869,134 @@ namespace example
 
             return bsl::errc_success;
         }
+
+        /// <!-- description -->
+        ///   @brief Maps a 1g page into the extended page tables being managed
+        ///     by this class.
+        ///
+        /// <!-- ieputs/outputs -->
+        ///   @param page_gpa the guest physical address to map the system
+        ///     physical address to
+        ///   @param page_spa the system physical address to map.
+        ///   @param page_flags defines how memory should be mapped
+        ///   @param page_type defines the memory type for the mapping
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        map_1g_page(
+            bsl::safe_uintmax const &page_gpa,
+            bsl::safe_uintmax const &page_spa,
+            bsl::safe_uintmax const &page_flags,
+            bsl::safe_uintmax const &page_type) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{m_ept_lock};
+
+            if (bsl::unlikely(!m_initialized)) {
+                bsl::error() << "extended_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!page_gpa)) {
+                bsl::error() << "guest physical address is invalid: "    // --
+                             << bsl::hex(page_gpa)                       // --
+                             << bsl::endl                                // --
+                             << bsl::here();                             // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!this->is_page_aligned(page_gpa))) {
+                bsl::error() << "guest physical address is not page aligned: "    // --
+                             << bsl::hex(page_gpa)                                // --
+                             << bsl::endl                                         // --
+                             << bsl::here();                                      // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!page_spa)) {
+                bsl::error() << "system physical address is invalid: "    // --
+                             << bsl::hex(page_spa)                        // --
+                             << bsl::endl                                 // --
+                             << bsl::here();                              // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!this->is_page_aligned(page_spa))) {
+                bsl::error() << "system physical address is not page aligned: "    // --
+                             << bsl::hex(page_spa)                                 // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!page_flags)) {
+                bsl::error() << "invalid flags: "       // --
+                             << bsl::hex(page_flags)    // --
+                             << bsl::endl               // --
+                             << bsl::here();            // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!page_type)) {
+                bsl::error() << "invalid type: "       // --
+                             << bsl::hex(page_type)    // --
+                             << bsl::endl              // --
+                             << bsl::here();           // --
+
+                return bsl::errc_failure;
+            }
+
+            auto *const epml4te{m_epml4t->entries.at_if(this->epml4to(page_gpa))};
+            if (epml4te->r == bsl::ZERO_UMAX) {
+                if (bsl::unlikely(!this->add_epdpt(epml4te))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto *const epdpt{this->get_epdpt(epml4te)};
+            auto *const epdpte{epdpt->entries.at_if(this->epdpto(page_gpa))};
+            if (bsl::unlikely(epdpte->r != bsl::ZERO_UMAX)) {
+                bsl::error() << "guest physical address "    // --
+                             << bsl::hex(page_gpa)           // --
+                             << " already mapped"            // --
+                             << bsl::endl                    // --
+                             << bsl::here();                 // --
+
+                return bsl::errc_failure;
+            }
+
+            epdpte->phys = (page_spa >> bsl::to_umax(HYPERVISOR_PAGE_SHIFT)).get();
+            epdpte->r = bsl::ONE_UMAX.get();
+            epdpte->type = page_type.get();
+            epdpte->ps = bsl::ONE_UMAX.get();
+
+            if (!(page_flags & MAP_PAGE_WRITE).is_zero()) {
+                epdpte->w = bsl::ONE_UMAX.get();
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (!(page_flags & MAP_PAGE_EXECUTE).is_zero()) {
+                epdpte->e = bsl::ONE_UMAX.get();
+            }
+            else {
+                bsl::touch();
+            }
+
+            return bsl::errc_success;
+        }
     };
 }
 
@@ -212,6 +212,20 @@ namespace example
             constexpr bsl::safe_uint64 mask_2m{bsl::to_umax(0x1FFFFFU)};
             return (addr & mask_2m) == bsl::ZERO_UMAX;
         }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided address is 1g page aligned
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param addr the address to query
+        ///   @return Returns true if the provided address is 1g page aligned
+        ///
+        [[nodiscard]] static constexpr auto
+        is_page_1g_aligned(bsl::safe_uintmax const &addr) noexcept -> bool
+        {
+            constexpr bsl::safe_uint64 mask_1g{bsl::to_umax(0x3FFFFFFFU)};
+            return (addr & mask_1g) == bsl::ZERO_UMAX;
+        }
         /// <!-- description -->
         ///   @brief Returns the combination of two memory type based on the
         ///     memory combining rules defined in the AMD/Intel manuals.
@@ -1630,6 +1644,158 @@ namespace example
             return bsl::errc_failure;
         }
 
+        /// <!-- description -->
+        ///   @brief Creates an identity map in the provided map using the
+        ///     memory types contained in the MTRRs. The resulting identity
+        ///     map will mimic the MTRRs given the range provided. Unlike
+        ///     identity_map_2m, 1g pages are used wherever a 1g aligned
+        ///     region is covered by a single MTRR range, and 2m/4k pages
+        ///     are only used near the boundaries of a range.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam MAP_T the type of map to use
+        ///   @param map the map to create the identity map in
+        ///   @param gpa the starting guest physical address
+        ///   @param size the number of bytes from the provided gpa to map
+        ///   @param flags the read/write/execute flags to use
+        ///   @return Returns bsl::errc_success on success and bsl::errc_failure
+        ///     on failure.
+        ///
+        template<typename MAP_T>
+        [[nodiscard]] constexpr auto
+        identity_map_1g(
+            MAP_T &map,
+            bsl::safe_uintmax const &gpa,
+            bsl::safe_uintmax const &size,
+            bsl::safe_uintmax const &flags) &noexcept -> bsl::errc_type
+        {
+            constexpr bsl::safe_uint64 page_size_4k{bsl::to_umax(0x001000U)};
+            constexpr bsl::safe_uint64 page_size_2m{bsl::to_umax(0x200000U)};
+            constexpr bsl::safe_uint64 page_size_1g{bsl::to_umax(0x40000000U)};
+
+            bsl::errc_type ret{};
+            bsl::safe_uintmax crsr{gpa};
+
+            if (bsl::unlikely(!gpa)) {
+                bsl::error() << "guest physical address is invalid: "    // --
+                             << bsl::hex(gpa)                            // --
+                             << bsl::endl                                // --
+                             << bsl::here();                             // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!this->is_page_2m_aligned(gpa))) {
+                bsl::error() << "guest physical address is not 2m page aligned: "    // --
+                             << bsl::hex(gpa)                                        // --
+                             << bsl::endl                                            // --
+                             << bsl::here();                                         // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!size)) {
+                bsl::error() << "size is invalid: "    // --
+                             << bsl::hex(size)         // --
+                             << bsl::endl              // --
+                             << bsl::here();           // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!this->is_page_2m_aligned(size))) {
+                bsl::error() << "size is not 2m page aligned: "    // --
+                             << bsl::hex(size)                     // --
+                             << bsl::endl                          // --
+                             << bsl::here();                       // --
+
+                return bsl::errc_failure;
+            }
+
+            for (bsl::safe_uintmax i{}; i < m_ranges_count; ++i) {
+                auto *const range{m_ranges.at_if(i)};
+
+                if (range->addr + range->size < crsr) {
+                    continue;
+                }
+
+                while (crsr < range->addr + range->size) {
+
+                    if (!(crsr < gpa + size)) {
+                        return bsl::errc_success;
+                    }
+
+                    /// NOTE:
+                    /// - A large page can only be used if it does not cross
+                    ///   the end of the range (as that would be a different
+                    ///   memory type), and it does not cross the end of the
+                    ///   region that we were asked to map.
+                    ///
+
+                    if (this->is_page_1g_aligned(crsr)) {
+                        if (!(crsr + page_size_1g > range->addr + range->size)) {
+                            if (!(crsr + page_size_1g > gpa + size)) {
+
+                                ret = map.map_1g_page(crsr, crsr, flags, range->type);
+                                if (bsl::unlikely(!ret)) {
+                                    bsl::print<bsl::V>() << bsl::here();
+                                    return ret;
+                                }
+
+                                crsr += page_size_1g;
+                                continue;
+                            }
+
+                            bsl::touch();
+                        }
+                        else {
+                            bsl::touch();
+                        }
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    if (this->is_page_2m_aligned(crsr)) {
+                        if (!(crsr + page_size_2m > range->addr + range->size)) {
+
+                            ret = map.map_2m_page(crsr, crsr, flags, range->type);
+                            if (bsl::unlikely(!ret)) {
+                                bsl::print<bsl::V>() << bsl::here();
+                                return ret;
+                            }
+
+                            crsr += page_size_2m;
+                            continue;
+                        }
+
+                        bsl::touch();
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    ret = map.map_4k_page(crsr, crsr, flags, range->type);
+                    if (bsl::unlikely(!ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return ret;
+                    }
+
+                    crsr += page_size_4k;
+                }
+            }
+
+            if (crsr == gpa + size) {
+                return bsl::errc_success;
+            }
+
+            bsl::error() << "identity map is out of bounds"    // --
+                         << bsl::endl                          // --
+                         << bsl::here();                       // --
+
+            return bsl::errc_failure;
+        }
+
         /// <!-- description -->
         ///   @brief Returns the max physical address in the MTRRs on success,
         ///     or bsl::safe_uintmax::zero(true) on failure.
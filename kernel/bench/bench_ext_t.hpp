@@ -0,0 +1,67 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef BENCH_EXT_T_HPP
+#define BENCH_EXT_T_HPP
+
+#include <bsl/discard.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @class mk::bench_ext_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stands in for an extension whose VMExit handler returns
+    ///     right away, so that a benchmark of the vmexit_loop only measures
+    ///     the microkernel's side of a VMExit.
+    ///
+    class bench_ext_t final
+    {
+    public:
+        /// <!-- description -->
+        ///   @brief Handles a VMExit by doing nothing
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param exit_reason the VMExit reason
+        ///   @return Always returns bsl::errc_success
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        vmexit(TLS_CONCEPT &tls, bsl::safe_uintmax const &exit_reason) &noexcept
+            -> bsl::errc_type
+        {
+            bsl::discard(tls);
+            bsl::discard(exit_reason);
+
+            return bsl::errc_success;
+        }
+    };
+}
+
+#endif
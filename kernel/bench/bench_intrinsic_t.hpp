@@ -0,0 +1,114 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef BENCH_INTRINSIC_T_HPP
+#define BENCH_INTRINSIC_T_HPP
+
+#include <bsl/discard.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @class mk::bench_intrinsic_t
+    ///
+    /// <!-- description -->
+    ///   @brief Provides the subset of intrinsic_t that the benchmarked
+    ///     code uses. The real intrinsic_t executes privileged instructions
+    ///     which cannot run on the host, so TLB maintenance is a no-op, CR4
+    ///     reports PCIDs as disabled and the TSC is read directly.
+    ///
+    class bench_intrinsic_t final
+    {
+    public:
+        /// <!-- description -->
+        ///   @brief Does nothing, as the host's TLB is not ours to manage
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param val the virtual address to invalidate
+        ///
+        static constexpr void
+        invlpg(bsl::safe_uint64 const &val) noexcept
+        {
+            bsl::discard(val);
+        }
+
+        /// <!-- description -->
+        ///   @brief Does nothing, as the host's TLB is not ours to manage
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param addr The address to invalidate
+        ///   @param pcid The PCID to invalidate
+        ///   @param type The INVPCID type (see the Intel SDM for details)
+        ///   @return Always returns bsl::errc_success
+        ///
+        [[nodiscard]] static constexpr auto
+        invpcid(
+            bsl::safe_uint64 const &addr,
+            bsl::safe_uint16 const &pcid,
+            bsl::safe_uint64 const &type) noexcept -> bsl::errc_type
+        {
+            bsl::discard(addr);
+            bsl::discard(pcid);
+            bsl::discard(type);
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Does nothing, as the host's TLB is not ours to manage
+        ///
+        static constexpr void
+        flush_tlb() noexcept
+        {}
+
+        /// <!-- description -->
+        ///   @brief Returns 0 so that the code being benchmarked takes the
+        ///     paths used when PCIDs are disabled.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Always returns 0
+        ///
+        [[nodiscard]] static constexpr auto
+        cr4() noexcept -> bsl::safe_uint64
+        {
+            return {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the TSC
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the value of the TSC
+        ///
+        [[nodiscard]] static auto
+        rdtsc() noexcept -> bsl::safe_uint64
+        {
+            return __builtin_ia32_rdtsc();
+        }
+    };
+}
+
+#endif
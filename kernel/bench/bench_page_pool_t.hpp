@@ -0,0 +1,192 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef BENCH_PAGE_POOL_T_HPP
+#define BENCH_PAGE_POOL_T_HPP
+
+#include "../src/page_pool_t.hpp"
+
+#include <bsl/array.hpp>
+#include <bsl/byte.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/string_view.hpp>
+#include <bsl/touch.hpp>
+
+namespace mk
+{
+    /// @brief defines the size of a page used by the benchmarks
+    constexpr bsl::safe_uintmax BENCH_PAGE_SIZE{bsl::to_umax(0x1000)};
+    /// @brief defines the number of bits in a page used by the benchmarks
+    constexpr bsl::safe_uintmax BENCH_PAGE_SHIFT{bsl::to_umax(12)};
+    /// @brief defines the number of pages given to the benchmark's page pool
+    constexpr bsl::safe_uintmax BENCH_PAGE_POOL_PAGES{bsl::to_umax(0x4000)};
+    /// @brief defines the max number of PPs used by the benchmarks
+    constexpr bsl::safe_uintmax BENCH_MAX_PPS{bsl::to_umax(1)};
+    /// @brief defines the max number of NUMA nodes used by the benchmarks
+    constexpr bsl::safe_uintmax BENCH_MAX_NUMA_NODES{bsl::to_umax(1)};
+    /// @brief defines the page pool's low watermark used by the benchmarks
+    constexpr bsl::safe_uintmax BENCH_PAGE_POOL_LOW_WATERMARK{bsl::to_umax(0)};
+
+    /// @class mk::bench_page_pool_t
+    ///
+    /// <!-- description -->
+    ///   @brief Wraps a real page_pool_t, backed by a buffer on the host,
+    ///     and counts the number of allocations that are made through it
+    ///     so that each benchmark can report allocations per operation.
+    ///     The page pool's base address is 0, which makes the host's
+    ///     virtual addresses double as physical addresses.
+    ///
+    class bench_page_pool_t final
+    {
+        /// @brief stores the page pool being benchmarked
+        page_pool_t<
+            BENCH_PAGE_SIZE.get(),
+            bsl::uintmax{},
+            bsl::safe_uintmax::max_value().get(),
+            BENCH_MAX_PPS.get(),
+            BENCH_MAX_NUMA_NODES.get(),
+            BENCH_PAGE_POOL_LOW_WATERMARK.get()>
+            m_pool{};
+        /// @brief stores the number of allocations made so far
+        bsl::safe_uintmax m_allocs{};
+
+        /// @brief stores the memory given to the page pool
+        alignas(BENCH_PAGE_SIZE.get())
+            bsl::array<bsl::byte, (BENCH_PAGE_SIZE * BENCH_PAGE_POOL_PAGES).get()> m_pages{};
+
+    public:
+        /// <!-- description -->
+        ///   @brief Links the pages together the same way the loader does
+        ///     and then initializes the page pool with them.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] auto
+        initialize() &noexcept -> bsl::errc_type
+        {
+            for (bsl::safe_uintmax i{}; i < BENCH_PAGE_POOL_PAGES; ++i) {
+                void *next{};
+                if ((i + bsl::ONE_UMAX) < BENCH_PAGE_POOL_PAGES) {
+                    next = m_pages.at_if((i + bsl::ONE_UMAX) * BENCH_PAGE_SIZE);
+                }
+                else {
+                    bsl::touch();
+                }
+
+                *static_cast<void **>(static_cast<void *>(m_pages.at_if(i * BENCH_PAGE_SIZE))) =
+                    next;
+            }
+
+            bsl::array<bsl::span<bsl::byte>, BENCH_MAX_NUMA_NODES.get()> pools{};
+            *pools.front_if() = {m_pages.data(), m_pages.size()};
+
+            return m_pool.initialize(pools);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the number of allocations made so far
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the number of allocations made so far
+        ///
+        [[nodiscard]] constexpr auto
+        allocs() const &noexcept -> bsl::safe_uintmax const &
+        {
+            return m_allocs;
+        }
+
+        /// <!-- description -->
+        ///   @brief Same as page_pool_t::allocate
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam T the type of pointer to return
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param tag the tag to mark the allocation with
+        ///   @return Returns a pointer to the newly allocated page
+        ///
+        template<typename T, typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        allocate(TLS_CONCEPT &tls, bsl::string_view const &tag) &noexcept -> T *
+        {
+            ++m_allocs;
+            return m_pool.template allocate<T>(tls, tag);
+        }
+
+        /// <!-- description -->
+        ///   @brief Same as page_pool_t::deallocate
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param ptr the pointer to the page to deallocate
+        ///   @param tag the tag the allocation was marked with
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        deallocate(TLS_CONCEPT &tls, void *const ptr, bsl::string_view const &tag) &noexcept
+        {
+            m_pool.deallocate(tls, ptr, tag);
+        }
+
+        /// <!-- description -->
+        ///   @brief Same as page_pool_t::virt_to_phys
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam T defines the type of virtual address being converted
+        ///   @param virt the virtual address to convert
+        ///   @return the resulting physical address
+        ///
+        template<typename T>
+        [[nodiscard]] constexpr auto
+        virt_to_phys(T const *const virt) const &noexcept -> bsl::safe_uintmax
+        {
+            return m_pool.virt_to_phys(virt);
+        }
+
+        /// <!-- description -->
+        ///   @brief Same as page_pool_t::phys_to_virt
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam T defines the type of virtual address to convert to
+        ///   @param phys the physical address to convert
+        ///   @return the resulting virtual address
+        ///
+        template<typename T>
+        [[nodiscard]] constexpr auto
+        phys_to_virt(bsl::safe_uintmax const &phys) const &noexcept -> T *
+        {
+            return m_pool.template phys_to_virt<T>(phys);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,436 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef BENCH_RESULTS_T_HPP
+#define BENCH_RESULTS_T_HPP
+
+#include <bsl/array.hpp>
+#include <bsl/byte.hpp>
+#include <bsl/char_type.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstr_type.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/fmt.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/string_view.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace mk
+{
+    /// @brief defines the max number of results that can be stored
+    constexpr bsl::safe_uintmax BENCH_MAX_RESULTS{bsl::to_umax(32)};
+    /// @brief defines the scale used to print fractions with 3 digits
+    constexpr bsl::safe_uintmax BENCH_MILLI{bsl::to_umax(1000)};
+    /// @brief defines the base used when parsing numbers
+    constexpr bsl::safe_uintmax BENCH_BASE10{bsl::to_umax(10)};
+
+    /// @struct mk::bench_result_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the result of a single benchmark
+    ///
+    struct bench_result_t final
+    {
+        /// @brief stores the name of the benchmark
+        bsl::string_view name;
+        /// @brief stores the number of operations that were timed
+        bsl::safe_uintmax iterations;
+        /// @brief stores the time it took to run all of the operations
+        bsl::safe_uintmax total_ns;
+        /// @brief stores the number of page allocations that were made
+        bsl::safe_uintmax allocs;
+    };
+
+    /// @class mk::bench_results_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the results of a benchmark run, and converts them to
+    ///     and from JSON. Each benchmark is written on its own line, which
+    ///     is what from_json() relies on, so from_json() only understands
+    ///     the JSON that to_json() outputs, and not JSON in general.
+    ///
+    class bench_results_t final
+    {
+        /// @brief stores the results
+        bsl::array<bench_result_t, BENCH_MAX_RESULTS.get()> m_results{};
+        /// @brief stores the number of results
+        bsl::safe_uintmax m_size{};
+
+        /// <!-- description -->
+        ///   @brief Outputs val / BENCH_MILLI with 3 digits after the
+        ///     decimal point. If pad is true, the output is right aligned
+        ///     to 14 characters so that it lines up with the table's
+        ///     headers.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param val the value to output, scaled by BENCH_MILLI
+        ///   @param pad if true, the output is right aligned
+        ///
+        static void
+        print_milli(bsl::safe_uintmax const &val, bool const pad) noexcept
+        {
+            constexpr auto tens{bsl::to_umax(10)};
+            constexpr auto hundreds{bsl::to_umax(100)};
+
+            auto const frac{val % BENCH_MILLI};
+            if (pad) {
+                bsl::print() << bsl::fmt{"10d", val / BENCH_MILLI} << '.';
+            }
+            else {
+                bsl::print() << val / BENCH_MILLI << '.';
+            }
+
+            if (frac < hundreds) {
+                bsl::print() << '0';
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (frac < tens) {
+                bsl::print() << '0';
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::print() << frac;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the position in the provided JSON that comes
+        ///     right after the first occurrence of the provided key, starting
+        ///     from pos and stopping at the end of the line.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param json the JSON to search
+        ///   @param pos the position to start searching from
+        ///   @param key the key to search for
+        ///   @return Returns the position right after the key, or
+        ///     bsl::safe_uintmax::zero(true) if the key was not found.
+        ///
+        [[nodiscard]] static auto
+        find_key(
+            bsl::span<bsl::byte const> const &json,
+            bsl::safe_uintmax const &pos,
+            bsl::string_view const &key) noexcept -> bsl::safe_uintmax
+        {
+            for (bsl::safe_uintmax i{pos}; i < json.size(); ++i) {
+                if (static_cast<bsl::char_type>(json.at_if(i)->to_integer()) == '\n') {
+                    break;
+                }
+
+                bsl::safe_uintmax j{};
+                while (j < key.size() && (i + j) < json.size()) {
+                    auto const c{static_cast<bsl::char_type>(json.at_if(i + j)->to_integer())};
+                    if (c != *key.at_if(j)) {
+                        break;
+                    }
+
+                    ++j;
+                }
+
+                if (j == key.size()) {
+                    return i + j;
+                }
+
+                bsl::touch();
+            }
+
+            return bsl::safe_uintmax::zero(true);
+        }
+
+        /// <!-- description -->
+        ///   @brief Parses the unsigned number that starts at pos, skipping
+        ///     any leading spaces.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param json the JSON to parse
+        ///   @param pos the position of the number
+        ///   @return Returns the parsed number, or
+        ///     bsl::safe_uintmax::zero(true) if there was no number at pos.
+        ///
+        [[nodiscard]] static auto
+        parse_number(bsl::span<bsl::byte const> const &json, bsl::safe_uintmax pos) noexcept
+            -> bsl::safe_uintmax
+        {
+            if (bsl::unlikely(!pos)) {
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            while (pos < json.size()) {
+                if (static_cast<bsl::char_type>(json.at_if(pos)->to_integer()) != ' ') {
+                    break;
+                }
+
+                ++pos;
+            }
+
+            bsl::safe_uintmax val{};
+            bool found{};
+            while (pos < json.size()) {
+                auto const c{static_cast<bsl::char_type>(json.at_if(pos)->to_integer())};
+                if (c < '0' || c > '9') {
+                    break;
+                }
+
+                val = (val * BENCH_BASE10) + bsl::to_umax(c - '0');
+                found = true;
+                ++pos;
+            }
+
+            if (bsl::unlikely(!found)) {
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            return val;
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Adds a result
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param result the result to add
+        ///
+        constexpr void
+        add(bench_result_t const &result) &noexcept
+        {
+            auto *const rcd{m_results.at_if(m_size)};
+            if (bsl::unlikely(nullptr == rcd)) {
+                bsl::error() << "too many benchmark results\n" << bsl::here();
+                return;
+            }
+
+            *rcd = result;
+            ++m_size;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the result with the provided name
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param name the name of the result to find
+        ///   @return Returns the result with the provided name, or a
+        ///     nullptr if there is no such result
+        ///
+        [[nodiscard]] constexpr auto
+        find(bsl::string_view const &name) const &noexcept -> bench_result_t const *
+        {
+            for (bsl::safe_uintmax i{}; i < m_size; ++i) {
+                auto const *const rcd{m_results.at_if(i)};
+                if (rcd->name == name) {
+                    return rcd;
+                }
+
+                bsl::touch();
+            }
+
+            return nullptr;
+        }
+
+        /// <!-- description -->
+        ///   @brief Fills in these results from JSON that was outputted by
+        ///     to_json(). The names of the results point into the provided
+        ///     JSON, so it must outlive these results.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param json the JSON to parse
+        ///   @return Returns true if at least one result was parsed
+        ///
+        [[nodiscard]] auto
+        from_json(bsl::span<bsl::byte const> const &json) &noexcept -> bool
+        {
+            bsl::safe_uintmax pos{};
+            while (pos < json.size()) {
+                auto const name{find_key(json, pos, "\"name\": \"")};
+                if (!name) {
+                    while (pos < json.size()) {
+                        if (static_cast<bsl::char_type>(json.at_if(pos)->to_integer()) == '\n') {
+                            break;
+                        }
+
+                        ++pos;
+                    }
+
+                    ++pos;
+                    continue;
+                }
+
+                auto end{name};
+                while (end < json.size()) {
+                    if (static_cast<bsl::char_type>(json.at_if(end)->to_integer()) == '"') {
+                        break;
+                    }
+
+                    ++end;
+                }
+
+                bench_result_t result{};
+                result.name = bsl::string_view{
+                    static_cast<bsl::cstr_type>(static_cast<void const *>(json.at_if(name))),
+                    end - name};
+
+                result.iterations = parse_number(json, find_key(json, end, "\"iterations\":"));
+                result.total_ns = parse_number(json, find_key(json, end, "\"total_ns\":"));
+                result.allocs = parse_number(json, find_key(json, end, "\"allocs\":"));
+
+                if (bsl::unlikely(!result.iterations || !result.total_ns || !result.allocs)) {
+                    bsl::error() << "malformed benchmark result: "    // --
+                                 << result.name                       // --
+                                 << bsl::endl                         // --
+                                 << bsl::here();                      // --
+
+                    return false;
+                }
+
+                this->add(result);
+                pos = end;
+            }
+
+            return !m_size.is_zero();
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs these results as JSON
+        ///
+        void
+        to_json() const &noexcept
+        {
+            bsl::print() << "{\n";
+            bsl::print() << "    \"benchmarks\": [\n";
+
+            for (bsl::safe_uintmax i{}; i < m_size; ++i) {
+                auto const *const rcd{m_results.at_if(i)};
+
+                bsl::print() << "        {\"name\": \"" << rcd->name << "\", ";
+                bsl::print() << "\"iterations\": " << rcd->iterations << ", ";
+                bsl::print() << "\"total_ns\": " << rcd->total_ns << ", ";
+                bsl::print() << "\"allocs\": " << rcd->allocs << ", ";
+                bsl::print() << "\"ns_per_op\": ";
+                print_milli((rcd->total_ns * BENCH_MILLI) / rcd->iterations, false);
+                bsl::print() << ", \"allocs_per_op\": ";
+                print_milli((rcd->allocs * BENCH_MILLI) / rcd->iterations, false);
+                bsl::print() << "}";
+
+                if ((i + bsl::ONE_UMAX) < m_size) {
+                    bsl::print() << ",";
+                }
+                else {
+                    bsl::touch();
+                }
+
+                bsl::print() << "\n";
+            }
+
+            bsl::print() << "    ]\n";
+            bsl::print() << "}\n";
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs these results as a table. If a baseline is
+        ///     provided, the change in ns/op from the baseline is outputted
+        ///     as well, and any benchmark that got slower by more than the
+        ///     provided threshold (in percent) is marked as a regression.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param baseline the results to compare against, or a nullptr
+        ///   @param threshold the allowed slowdown in percent
+        ///   @return Returns the number of regressions that were found
+        ///
+        [[nodiscard]] auto
+        to_table(bench_results_t const *const baseline, bsl::safe_uintmax const &threshold)
+            const &noexcept -> bsl::safe_uintmax
+        {
+            constexpr auto percent{bsl::to_umax(100)};
+            bsl::safe_uintmax regressions{};
+
+            bsl::print() << bsl::fmt{"<40s", "benchmark"};
+            bsl::print() << bsl::fmt{">14s", "ns/op"};
+            bsl::print() << bsl::fmt{">14s", "allocs/op"};
+            if (nullptr != baseline) {
+                bsl::print() << bsl::fmt{">14s", "base ns/op"};
+                bsl::print() << "    change";
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::print() << bsl::endl;
+
+            for (bsl::safe_uintmax i{}; i < m_size; ++i) {
+                auto const *const rcd{m_results.at_if(i)};
+                auto const ns{(rcd->total_ns * BENCH_MILLI) / rcd->iterations};
+
+                bsl::print() << bsl::fmt{"<40s", rcd->name};
+                print_milli(ns, true);
+                print_milli((rcd->allocs * BENCH_MILLI) / rcd->iterations, true);
+
+                if (nullptr == baseline) {
+                    bsl::print() << bsl::endl;
+                    continue;
+                }
+
+                auto const *const base{baseline->find(rcd->name)};
+                if (nullptr == base) {
+                    bsl::print() << bsl::ylw << bsl::fmt{">14s", "new"} << bsl::rst << bsl::endl;
+                    continue;
+                }
+
+                auto const base_ns{(base->total_ns * BENCH_MILLI) / base->iterations};
+                print_milli(base_ns, true);
+                bsl::print() << "    ";
+
+                if (base_ns.is_zero()) {
+                    bsl::print() << bsl::endl;
+                    continue;
+                }
+
+                if (ns > base_ns) {
+                    auto const change{((ns - base_ns) * percent) / base_ns};
+                    if (change > threshold) {
+                        bsl::print() << bsl::red << "+" << change << "%" << bsl::rst;
+                        ++regressions;
+                    }
+                    else {
+                        bsl::print() << "+" << change << "%";
+                    }
+                }
+                else {
+                    auto const change{((base_ns - ns) * percent) / base_ns};
+                    bsl::print() << bsl::grn << "-" << change << "%" << bsl::rst;
+                }
+
+                bsl::print() << bsl::endl;
+            }
+
+            return regressions;
+        }
+    };
+}
+
+#endif
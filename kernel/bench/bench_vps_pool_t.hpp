@@ -0,0 +1,106 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef BENCH_VPS_POOL_T_HPP
+#define BENCH_VPS_POOL_T_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @brief defines the exit reason returned by bench_vps_pool_t::run
+    constexpr bsl::safe_uintmax BENCH_EXIT_REASON{bsl::to_umax(0x0A)};
+
+    /// @class mk::bench_vps_pool_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stands in for a VPS pool whose VPSs VMExit as soon as they
+    ///     are run, always with the same exit reason (CPUID on Intel).
+    ///
+    class bench_vps_pool_t final
+    {
+    public:
+        /// <!-- description -->
+        ///   @brief "Runs" the requested VPS
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @tparam VMEXIT_LOG_CONCEPT defines the type of VMExit log to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param vpsid the ID of the VPS to run
+        ///   @param log the VMExit log to use
+        ///   @return Always returns BENCH_EXIT_REASON
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT, typename VMEXIT_LOG_CONCEPT>
+        [[nodiscard]] constexpr auto
+        run(TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uint16 const &vpsid,
+            VMEXIT_LOG_CONCEPT &log) &noexcept -> bsl::safe_uintmax
+        {
+            bsl::discard(tls);
+            bsl::discard(intrinsic);
+            bsl::discard(vpsid);
+            bsl::discard(log);
+
+            return BENCH_EXIT_REASON;
+        }
+
+        /// <!-- description -->
+        ///   @brief The VPSs of this pool have no exit policy, so every
+        ///     VMExit is given to the extension.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param vpsid the ID of the VPS that generated the VMExit
+        ///   @param exit_reason the VMExit reason returned by run()
+        ///   @return Always returns false
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        [[nodiscard]] constexpr auto
+        exit_policy(
+            TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uint16 const &vpsid,
+            bsl::safe_uintmax const &exit_reason) &noexcept -> bool
+        {
+            bsl::discard(tls);
+            bsl::discard(intrinsic);
+            bsl::discard(vpsid);
+            bsl::discard(exit_reason);
+
+            return false;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,59 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef BENCH_CLOCK_NS_LINUX_HPP
+#define BENCH_CLOCK_NS_LINUX_HPP
+
+#include <time.h>
+
+#include <bsl/convert.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// <!-- description -->
+    ///   @brief Returns the current value of the host's monotonic clock
+    ///     in nanoseconds. Only the difference between two calls is
+    ///     meaningful.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Returns the current value of the host's monotonic clock
+    ///     in nanoseconds.
+    ///
+    [[nodiscard]] inline auto
+    clock_ns() noexcept -> bsl::safe_uintmax
+    {
+        constexpr auto ns_per_s{bsl::to_umax(1000000000)};
+        using timespec_t = struct timespec;
+
+        timespec_t ts{};
+        bsl::discard(clock_gettime(CLOCK_MONOTONIC, &ts));
+
+        return (bsl::to_umax(ts.tv_sec) * ns_per_s) + bsl::to_umax(ts.tv_nsec);
+    }
+}
+
+#endif
@@ -0,0 +1,529 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#include "../src/dispatch_syscall.hpp"
+#include "../src/huge_pool_t.hpp"
+#include "../src/tlb_shootdown_t.hpp"
+#include "../src/trace_t.hpp"
+#include "../src/vm_pool_t.hpp"
+#include "../src/vmexit_loop.hpp"
+#include "../src/vmexit_stats_t.hpp"
+#include "../src/vp_pool_t.hpp"
+#include "../src/x64/root_page_table_t.hpp"
+#include "bench_ext_t.hpp"
+#include "bench_intrinsic_t.hpp"
+#include "bench_page_pool_t.hpp"
+#include "bench_results_t.hpp"
+#include "bench_vps_pool_t.hpp"
+
+#include <clock_ns.hpp>
+#include <ifmap.hpp>
+#include <map_page_flags.hpp>
+#include <mk_interface.hpp>
+#include <tls_t.hpp>
+#include <vm_t_success.hpp>
+#include <vp_t_success.hpp>
+
+#include <bsl/arguments.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/cstr_type.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/dontcare_t.hpp>
+#include <bsl/enable_color.hpp>
+#include <bsl/exit_code.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/string_view.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace
+{
+    /// @brief defines the number of operations each benchmark runs by default
+    constexpr bsl::safe_uintmax BENCH_DEFAULT_ITERATIONS{bsl::to_umax(1000000)};
+    /// @brief defines the slowdown (in percent) allowed by default when comparing
+    constexpr bsl::safe_uintmax BENCH_DEFAULT_THRESHOLD{bsl::to_umax(10)};
+    /// @brief defines the number of VMs/VPs in the benchmark's pools
+    constexpr bsl::safe_uintmax BENCH_MAX_VMS{bsl::to_umax(64)};
+    /// @brief defines the number of VMs/VPs that are allocated up front
+    constexpr bsl::safe_uintmax BENCH_PREALLOCATED{bsl::to_umax(48)};
+    /// @brief defines the size of the VMExit stats table
+    constexpr bsl::safe_uintmax BENCH_VMEXIT_STATS_SIZE{bsl::to_umax(64)};
+    /// @brief defines the number of records in each PP's trace ring
+    constexpr bsl::safe_uintmax BENCH_TRACE_SIZE{bsl::to_umax(256)};
+    /// @brief defines where root_page_table_t/map_page maps its pages
+    constexpr bsl::safe_uintmax BENCH_MAP_VIRT{bsl::to_umax(0x0000100000000000U)};
+    /// @brief defines the max number of segments in the benchmark's huge pool
+    constexpr bsl::safe_uintmax BENCH_MAX_HUGE_POOL_SEGMENTS{bsl::to_umax(1)};
+    /// @brief defines the tag used by the page pool benchmark
+    constexpr bsl::string_view BENCH_TAG{"bench"};
+
+    /// @brief defines the huge pool type used by the benchmarks
+    using bench_huge_pool_type = mk::huge_pool_t<
+        mk::BENCH_PAGE_SIZE.get(),
+        bsl::uintmax{},
+        BENCH_MAX_HUGE_POOL_SEGMENTS.get()>;
+
+    /// @brief stores the TLS block used by all of the benchmarks
+    constinit mk::tls_t g_tls{};
+    /// @brief stores the intrinsics used by all of the benchmarks
+    constinit mk::bench_intrinsic_t g_intrinsic{};
+    /// @brief stores the page pool used by all of the benchmarks
+    constinit mk::bench_page_pool_t g_page_pool{};
+    /// @brief stores the huge pool used by all of the benchmarks
+    constinit bench_huge_pool_type g_huge_pool{};
+    /// @brief stores the results of the benchmarks
+    constinit mk::bench_results_t g_results{};
+
+    /// <!-- description -->
+    ///   @brief Runs func the provided number of times, and records how
+    ///     long that took and how many pages were allocated.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam FUNC_CONCEPT the type of operation to benchmark
+    ///   @param name the name of the benchmark
+    ///   @param iterations the number of times to run func
+    ///   @param func the operation to benchmark. It is given the index of
+    ///     the current iteration, and returns false on failure.
+    ///   @return Returns true on success, false otherwise
+    ///
+    template<typename FUNC_CONCEPT>
+    [[nodiscard]] auto
+    bench(
+        bsl::string_view const &name, bsl::safe_uintmax const &iterations, FUNC_CONCEPT &&func)
+        noexcept -> bool
+    {
+        auto const allocs{g_page_pool.allocs()};
+        auto const start{mk::clock_ns()};
+
+        for (bsl::safe_uintmax i{}; i < iterations; ++i) {
+            if (bsl::unlikely(!func(i))) {
+                bsl::error() << "benchmark " << name << " failed\n" << bsl::here();
+                return false;
+            }
+
+            bsl::touch();
+        }
+
+        auto const end{mk::clock_ns()};
+        g_results.add({name, iterations, end - start, g_page_pool.allocs() - allocs});
+
+        return true;
+    }
+
+    /// <!-- description -->
+    ///   @brief Benchmarks a page_pool_t allocation and deallocation. The
+    ///     page pool's per-PP cache means this should never take the lock.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param iterations the number of operations to run
+    ///   @return Returns true on success, false otherwise
+    ///
+    [[nodiscard]] auto
+    bench_page_pool(bsl::safe_uintmax const &iterations) noexcept -> bool
+    {
+        return bench("page_pool_t/allocate+deallocate", iterations, [](auto const &) noexcept {
+            auto *const page{g_page_pool.allocate<void>(g_tls, BENCH_TAG)};
+            if (bsl::unlikely(nullptr == page)) {
+                return false;
+            }
+
+            g_page_pool.deallocate(g_tls, page, BENCH_TAG);
+            return true;
+        });
+    }
+
+    /// <!-- description -->
+    ///   @brief Benchmarks a vm_pool_t allocation and deallocation using
+    ///     the vm_t_success mock from the unit tests. Most of the pool is
+    ///     allocated first so that finding a free VM is not trivial.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param iterations the number of operations to run
+    ///   @return Returns true on success, false otherwise
+    ///
+    [[nodiscard]] auto
+    bench_vm_pool(bsl::safe_uintmax const &iterations) noexcept -> bool
+    {
+        static constinit mk::vm_pool_t<mk::vm_t_success, BENCH_MAX_VMS.get()> pool{};
+        if (bsl::unlikely(!pool.initialize(g_tls, bsl::dontcare, bsl::dontcare))) {
+            bsl::print<bsl::V>() << bsl::here();
+            return false;
+        }
+
+        for (bsl::safe_uintmax i{}; i < BENCH_PREALLOCATED; ++i) {
+            if (bsl::unlikely(!pool.allocate(g_tls, bsl::dontcare))) {
+                bsl::print<bsl::V>() << bsl::here();
+                return false;
+            }
+
+            bsl::touch();
+        }
+
+        return bench("vm_pool_t/allocate+deallocate", iterations, [](auto const &) noexcept {
+            auto const vmid{pool.allocate(g_tls, bsl::dontcare)};
+            if (bsl::unlikely(!vmid)) {
+                return false;
+            }
+
+            return bsl::errc_success == pool.deallocate(g_tls, bsl::dontcare, bsl::dontcare, vmid);
+        });
+    }
+
+    /// <!-- description -->
+    ///   @brief Benchmarks a vp_pool_t allocation and deallocation using
+    ///     the vp_t_success mock from the unit tests, as well as the check
+    ///     made when a VM is destroyed.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param iterations the number of operations to run
+    ///   @return Returns true on success, false otherwise
+    ///
+    [[nodiscard]] auto
+    bench_vp_pool(bsl::safe_uintmax const &iterations) noexcept -> bool
+    {
+        static constinit mk::vp_pool_t<mk::vp_t_success, BENCH_MAX_VMS.get(), BENCH_MAX_VMS.get()>
+            pool{};
+
+        if (bsl::unlikely(!pool.initialize(g_tls, bsl::dontcare))) {
+            bsl::print<bsl::V>() << bsl::here();
+            return false;
+        }
+
+        for (bsl::safe_uintmax i{}; i < BENCH_PREALLOCATED; ++i) {
+            auto const vpid{pool.allocate(g_tls, bsl::dontcare, bsl::ZERO_U16, bsl::ZERO_U16)};
+            if (bsl::unlikely(!vpid)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return false;
+            }
+
+            bsl::touch();
+        }
+
+        bool const ret{
+            bench("vp_pool_t/allocate+deallocate", iterations, [](auto const &) noexcept {
+                auto const vpid{
+                    pool.allocate(g_tls, bsl::dontcare, bsl::ZERO_U16, bsl::ZERO_U16)};
+                if (bsl::unlikely(!vpid)) {
+                    return false;
+                }
+
+                return bsl::errc_success == pool.deallocate(g_tls, bsl::dontcare, vpid);
+            })};
+
+        if (bsl::unlikely(!ret)) {
+            return false;
+        }
+
+        return bench("vp_pool_t/is_assigned_to_vm", iterations, [](auto const &) noexcept {
+            return !pool.is_assigned_to_vm(bsl::ONE_U16);
+        });
+    }
+
+    /// <!-- description -->
+    ///   @brief Benchmarks root_page_table_t::map_page by mapping a new 4k
+    ///     page each iteration. The allocations per operation are the page
+    ///     tables that had to be added along the way.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param iterations the number of operations to run
+    ///   @return Returns true on success, false otherwise
+    ///
+    [[nodiscard]] auto
+    bench_map_page(bsl::safe_uintmax const &iterations) noexcept -> bool
+    {
+        static constinit mk::root_page_table_t<
+            mk::bench_intrinsic_t,
+            mk::bench_page_pool_t,
+            bench_huge_pool_type,
+            mk::BENCH_PAGE_SIZE.get(),
+            mk::BENCH_PAGE_SHIFT.get()>
+            rpt{};
+
+        auto const ret{
+            rpt.initialize(g_tls, &g_intrinsic, &g_page_pool, &g_huge_pool, bsl::ONE_U16)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            return false;
+        }
+
+        auto const map{[](bsl::safe_uintmax const &i) noexcept {
+            auto const offset{(i + bsl::ONE_UMAX) * mk::BENCH_PAGE_SIZE};
+            return bsl::errc_success == rpt.map_page(
+                g_tls,
+                BENCH_MAP_VIRT + offset,
+                offset,
+                mk::MAP_PAGE_READ | mk::MAP_PAGE_WRITE,
+                mk::MAP_PAGE_NO_AUTO_RELEASE);
+        }};
+
+        bool const mapped{bench("root_page_table_t/map_page", iterations, map)};
+        rpt.release(g_tls);
+        return mapped;
+    }
+
+    /// <!-- description -->
+    ///   @brief Benchmarks dispatch_syscall using the syscall mocks from
+    ///     the unit tests, which means only the decoding and dispatching
+    ///     of the syscall is measured. bf_vps_op is the last case of the
+    ///     switch, and bf_callback_op is somewhere in the middle.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param iterations the number of operations to run
+    ///   @return Returns true on success, false otherwise
+    ///
+    [[nodiscard]] auto
+    bench_dispatch_syscall(bsl::safe_uintmax const &iterations) noexcept -> bool
+    {
+        auto const dispatch{[](auto const &) noexcept {
+            return bsl::exit_success == mk::dispatch_syscall(
+                                            g_tls,
+                                            bsl::dontcare,
+                                            bsl::dontcare,
+                                            g_intrinsic,
+                                            g_page_pool,
+                                            g_huge_pool,
+                                            bsl::dontcare,
+                                            bsl::dontcare,
+                                            bsl::dontcare,
+                                            bsl::dontcare,
+                                            bsl::dontcare,
+                                            bsl::dontcare);
+        }};
+
+        g_tls.ext_syscall = syscall::BF_CALLBACK_OP_VAL.get();
+        if (bsl::unlikely(!bench("dispatch_syscall/bf_callback_op", iterations, dispatch))) {
+            return false;
+        }
+
+        g_tls.ext_syscall = syscall::BF_VPS_OP_VAL.get();
+        return bench("dispatch_syscall/bf_vps_op", iterations, dispatch);
+    }
+
+    /// <!-- description -->
+    ///   @brief Benchmarks a single iteration of the vmexit_loop with the
+    ///     real VMExit stats, trace and TLB shootdown code, but with a VPS
+    ///     that VMExits right away and an extension that returns right
+    ///     away. The loop is measured with the trace disabled (which is
+    ///     the default) and then again with the trace enabled.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param iterations the number of operations to run
+    ///   @return Returns true on success, false otherwise
+    ///
+    [[nodiscard]] auto
+    bench_vmexit_loop(bsl::safe_uintmax const &iterations) noexcept -> bool
+    {
+        static constinit mk::bench_ext_t ext{};
+        static constinit mk::bench_vps_pool_t vps_pool{};
+        static constinit mk::vmexit_stats_t<BENCH_VMEXIT_STATS_SIZE.get(), mk::BENCH_MAX_PPS.get()>
+            stats{};
+        static constinit mk::tlb_shootdown_t<mk::BENCH_MAX_PPS.get()> tlb_shootdown{};
+        static constinit mk::trace_t<BENCH_TRACE_SIZE.get(), mk::BENCH_MAX_PPS.get()> trace{};
+
+        auto const iteration{[](auto const &) noexcept {
+            return bsl::exit_success == mk::vmexit_loop(
+                                            g_tls,
+                                            ext,
+                                            g_intrinsic,
+                                            vps_pool,
+                                            bsl::dontcare,
+                                            stats,
+                                            trace,
+                                            tlb_shootdown);
+        }};
+
+        if (bsl::unlikely(!bench("vmexit_loop/iteration", iterations, iteration))) {
+            return false;
+        }
+
+        trace.enable(true);
+        bool const traced{bench("vmexit_loop/iteration_traced", iterations, iteration)};
+        trace.enable(false);
+
+        return traced;
+    }
+
+    /// <!-- description -->
+    ///   @brief Runs all of the benchmarks
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param iterations the number of operations each benchmark runs
+    ///   @return Returns true on success, false otherwise
+    ///
+    [[nodiscard]] auto
+    run_all(bsl::safe_uintmax const &iterations) noexcept -> bool
+    {
+        g_tls.ppid = bsl::ZERO_U16.get();
+        g_tls.online_pps = bsl::to_u16(mk::BENCH_MAX_PPS).get();
+
+        if (bsl::unlikely(!g_page_pool.initialize())) {
+            bsl::print<bsl::V>() << bsl::here();
+            return false;
+        }
+
+        if (bsl::unlikely(!bench_page_pool(iterations))) {
+            return false;
+        }
+
+        if (bsl::unlikely(!bench_vm_pool(iterations))) {
+            return false;
+        }
+
+        if (bsl::unlikely(!bench_vp_pool(iterations))) {
+            return false;
+        }
+
+        if (bsl::unlikely(!bench_map_page(iterations))) {
+            return false;
+        }
+
+        if (bsl::unlikely(!bench_dispatch_syscall(iterations))) {
+            return false;
+        }
+
+        return bench_vmexit_loop(iterations);
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements "report", which outputs a JSON file created by
+    ///     --json as a table. If a baseline JSON file is also provided,
+    ///     each benchmark is compared against the baseline.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param args the remaining arguments
+    ///   @param threshold the allowed slowdown in percent
+    ///   @return Returns bsl::exit_success if no benchmark got slower by more
+    ///     than the provided threshold, bsl::exit_failure otherwise
+    ///
+    [[nodiscard]] auto
+    report(bsl::arguments &args, bsl::safe_uintmax const &threshold) noexcept -> bsl::exit_code
+    {
+        static constinit mk::bench_results_t baseline{};
+
+        vmmctl::ifmap const file{args.front<bsl::string_view>()};
+        if (bsl::unlikely(!file)) {
+            return bsl::exit_failure;
+        }
+
+        if (bsl::unlikely(!g_results.from_json(file.view()))) {
+            bsl::error() << "no benchmark results found\n" << bsl::here();
+            return bsl::exit_failure;
+        }
+
+        ++args;
+        if (args.remaining().is_zero()) {
+            bsl::discard(g_results.to_table(nullptr, threshold));
+            return bsl::exit_success;
+        }
+
+        vmmctl::ifmap const base{args.front<bsl::string_view>()};
+        if (bsl::unlikely(!base)) {
+            return bsl::exit_failure;
+        }
+
+        if (bsl::unlikely(!baseline.from_json(base.view()))) {
+            bsl::error() << "no baseline results found\n" << bsl::here();
+            return bsl::exit_failure;
+        }
+
+        auto const regressions{g_results.to_table(&baseline, threshold)};
+        if (regressions.is_zero()) {
+            return bsl::exit_success;
+        }
+
+        bsl::print() << bsl::endl
+                     << bsl::red << regressions << " benchmark(s) regressed by more than "
+                     << threshold << "%" << bsl::rst << bsl::endl;
+
+        return bsl::exit_failure;
+    }
+}
+
+/// <!-- description -->
+///   @brief Provides the main entry point for the benchmarks.
+///
+///   Usage: hypervisor_bench [--iterations=N] [--json]
+///     or:  hypervisor_bench report results.json [baseline.json] [--threshold=P]
+///
+/// <!-- inputs/outputs -->
+///   @param argc the total number of arguments provided to the application
+///   @param argv the arguments provided to the application
+///   @return bsl::exit_success on success, bsl::exit_failure otherwise.
+///
+[[nodiscard]] auto
+main(bsl::int32 const argc, bsl::cstr_type const argv[]) noexcept -> bsl::exit_code
+{
+    bsl::arguments args{bsl::to_umax(argc), argv};
+    ++args;
+
+    bool const json{args.get<bool>("--json")};
+    if (!json) {
+        bsl::enable_color();
+    }
+    else {
+        bsl::touch();
+    }
+
+    auto threshold{args.get<bsl::safe_uintmax>("--threshold")};
+    if (!threshold || threshold.is_zero()) {
+        threshold = BENCH_DEFAULT_THRESHOLD;
+    }
+    else {
+        bsl::touch();
+    }
+
+    if (!args.remaining().is_zero()) {
+        if (args.front<bsl::string_view>() == "report") {
+            ++args;
+            return report(args, threshold);
+        }
+
+        bsl::error() << "unknown command: " << args.front<bsl::string_view>() << bsl::endl;
+        return bsl::exit_failure;
+    }
+
+    auto iterations{args.get<bsl::safe_uintmax>("--iterations")};
+    if (!iterations || iterations.is_zero()) {
+        iterations = BENCH_DEFAULT_ITERATIONS;
+    }
+    else {
+        bsl::touch();
+    }
+
+    if (bsl::unlikely(!run_all(iterations))) {
+        return bsl::exit_failure;
+    }
+
+    if (json) {
+        g_results.to_json();
+    }
+    else {
+        bsl::discard(g_results.to_table(nullptr, threshold));
+    }
+
+    return bsl::exit_success;
+}
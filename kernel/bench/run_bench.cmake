@@ -0,0 +1,41 @@
+#
+# Copyright (C) 2020 Assured Information Security, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Runs the benchmarks, storing the results as JSON in BENCH_JSON, and then
+# outputs those results as a table. This is done with a script as
+# add_custom_target() cannot redirect the output of a command to a file.
+#
+
+execute_process(
+    COMMAND ${BENCH} --json
+    OUTPUT_FILE ${BENCH_JSON}
+    RESULT_VARIABLE BENCH_RESULT
+)
+
+if(NOT BENCH_RESULT EQUAL 0)
+    message(FATAL_ERROR "benchmarks failed: ${BENCH_RESULT}")
+endif()
+
+execute_process(
+    COMMAND ${BENCH} report ${BENCH_JSON}
+)
+
+message(STATUS "results written to ${BENCH_JSON}")
@@ -0,0 +1,79 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef BENCH_CLOCK_NS_WINDOWS_HPP
+#define BENCH_CLOCK_NS_WINDOWS_HPP
+
+// clang-format off
+
+/// NOTE:
+/// - When using CPP, we need to remove the max/min macros as they are
+///   used by the C++ standard.
+///
+
+#include <Windows.h>
+#undef max
+#undef min
+
+// clang-format on
+
+#include <bsl/convert.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// <!-- description -->
+    ///   @brief Returns the current value of the host's monotonic clock
+    ///     in nanoseconds. Only the difference between two calls is
+    ///     meaningful.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Returns the current value of the host's monotonic clock
+    ///     in nanoseconds.
+    ///
+    [[nodiscard]] inline auto
+    clock_ns() noexcept -> bsl::safe_uintmax
+    {
+        constexpr auto ns_per_s{bsl::to_umax(1000000000)};
+
+        LARGE_INTEGER freq{};
+        LARGE_INTEGER count{};
+        bsl::discard(QueryPerformanceFrequency(&freq));
+        bsl::discard(QueryPerformanceCounter(&count));
+
+        auto const ticks{bsl::to_umax(count.QuadPart)};
+        auto const hz{bsl::to_umax(freq.QuadPart)};
+
+        /// NOTE:
+        /// - The seconds and the remainder are converted separately so that
+        ///   the multiplication does not overflow after a long uptime.
+        ///
+
+        return ((ticks / hz) * ns_per_s) + (((ticks % hz) * ns_per_s) / hz);
+    }
+}
+
+#endif
@@ -55,6 +55,8 @@ namespace mk
     constexpr bsl::cstr_type ALLOCATE_TAG_HOST_VMCB{"host vmcb"};
     /// @brief Defines the "vmcs" tag
     constexpr bsl::cstr_type ALLOCATE_TAG_VMCS{"vmcs"};
+    /// @brief Defines the "xsave area" tag
+    constexpr bsl::cstr_type ALLOCATE_TAG_XSAVE_AREA{"xsave area"};
 }
 
 #endif
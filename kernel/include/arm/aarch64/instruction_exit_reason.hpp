@@ -0,0 +1,54 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#ifndef INSTRUCTION_EXIT_REASON_HPP
+#define INSTRUCTION_EXIT_REASON_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @brief defines the largest exit reason that is caused by an instruction
+    constexpr bsl::safe_uintmax INSTRUCTION_EXIT_REASON_MAX{bsl::to_umax(0)};
+
+    /// <!-- description -->
+    ///   @brief Returns true if the provided exit reason is caused by the
+    ///     guest executing an instruction that the IP can be advanced
+    ///     past. The exit policy is not run on aarch64 yet, so this always
+    ///     returns false, which rejects every advance_ip entry.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reason the exit reason to check
+    ///   @return Always returns false
+    ///
+    [[nodiscard]] constexpr auto
+    is_instruction_exit_reason(bsl::safe_uintmax const &reason) noexcept -> bool
+    {
+        bsl::discard(reason);
+        return false;
+    }
+}
+
+#endif
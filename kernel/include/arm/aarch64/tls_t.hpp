@@ -43,7 +43,7 @@ namespace mk
     /// @brief defines the size of the reserved2 field in the tls_t
     constexpr bsl::safe_uintmax TLS_T_RESERVED3_SIZE{bsl::to_umax(0x007)};
     /// @brief defines the size of the reserved2 field in the tls_t
-    constexpr bsl::safe_uintmax TLS_T_RESERVED4_SIZE{bsl::to_umax(0x048)};
+    constexpr bsl::safe_uintmax TLS_T_RESERVED4_SIZE{bsl::to_umax(0x030)};
 
     /// IMPORTANT:
     /// - If the size of the TLS is changed, the mk_main_entry will need to
@@ -291,8 +291,8 @@ namespace mk
         bsl::uint16 ppid;
         /// @brief stores the total number of online PPs (0x30A)
         bsl::uint16 online_pps;
-        /// @brief reserved (0x30C)
-        bsl::uint16 reserved_padding0;
+        /// @brief stores the NUMA node of this PP (0x30C)
+        bsl::uint16 node;
         /// @brief reserved (0x30E)
         bsl::uint16 reserved_padding1;
 
@@ -370,6 +370,23 @@ namespace mk
         /// @brief logs a vps for state reversal if needed (0x3B0)
         void *log_vps;
 
+        /// --------------------------------------------------------------------
+        /// Lazy FPU State
+        /// --------------------------------------------------------------------
+
+        /// NOTE:
+        /// - Lazy FPU switching is not implemented on AArch64 yet, so
+        ///   xsave_enabled is always 0. The fields are here so that the
+        ///   common code can be shared.
+        ///
+
+        /// @brief stores the XSAVE area whose state is loaded on the CPU (0x3B8)
+        void *active_xsave;
+        /// @brief stores the root OS's FPU state until a VPS claims it (0x3C0)
+        void *root_xsave;
+        /// @brief stores whether or not lazy FPU switching is enabled (0x3C8)
+        bsl::uintmax xsave_enabled;
+
         /// @brief reserve the rest of the TLS block for later use.
         bsl::details::carray<bsl::uint8, TLS_T_RESERVED4_SIZE.get()> reserved4;
     };
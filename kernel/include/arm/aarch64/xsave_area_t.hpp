@@ -0,0 +1,70 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef XSAVE_AREA_T_HPP
+#define XSAVE_AREA_T_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/details/carray.hpp>
+#include <bsl/safe_integral.hpp>
+
+#pragma pack(push, 1)
+
+namespace mk
+{
+    /// @brief defines the size of the reserved1 field in the xsave_area_t
+    constexpr bsl::safe_uintmax XSAVE_AREA_T_RESERVED1_SIZE{bsl::to_umax(0x018)};
+    /// @brief defines the size of the reserved2 field in the xsave_area_t
+    constexpr bsl::safe_uintmax XSAVE_AREA_T_RESERVED2_SIZE{bsl::to_umax(0xFE4)};
+
+    /// @brief defines the power-on value of MXCSR (all exceptions masked)
+    constexpr bsl::safe_uint32 XSAVE_AREA_T_DEFAULT_MXCSR{bsl::to_u32(0x1F80U)};
+
+    /// @struct mk::xsave_area_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a page used to hold the FPU/SSE/AVX state of a VPS
+    ///     or an extension while that state is not loaded on the CPU. The
+    ///     layout is the standard (non-compacted) XSAVE format. Only the
+    ///     fields the microkernel has to initialize are named. A zeroed
+    ///     XSAVE header tells XRSTOR to load every component in its init
+    ///     state, except for MXCSR which is always loaded from the area,
+    ///     so MXCSR has to start with its power-on value.
+    ///
+    struct xsave_area_t final
+    {
+        /// @brief reserved (x87 state that is left in its init state)
+        bsl::details::carray<bsl::uint8, XSAVE_AREA_T_RESERVED1_SIZE.get()> reserved1;
+        /// @brief stores the value of MXCSR (0x018)
+        bsl::uint32 mxcsr{XSAVE_AREA_T_DEFAULT_MXCSR.get()};
+        /// @brief reserved (the rest of the XSAVE area)
+        bsl::details::carray<bsl::uint8, XSAVE_AREA_T_RESERVED2_SIZE.get()> reserved2;
+    };
+}
+
+#pragma pack(pop)
+
+#endif
@@ -0,0 +1,64 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef CONSOLE_LINE_T_HPP
+#define CONSOLE_LINE_T_HPP
+
+#include <bsl/array.hpp>
+#include <bsl/char_type.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @brief defines the max number of characters a PP can buffer
+    constexpr bsl::safe_uintmax CONSOLE_LINE_SIZE{bsl::to_umax(0x100)};
+
+    /// @struct mk::console_line_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the line that a PP is currently writing to the
+    ///     console. The line is only written to the debug ring once it
+    ///     is complete, so that lines from different PPs do not
+    ///     interleave. Anything an ESR (e.g., an NMI) writes while the
+    ///     PP is committing a line is kept in esr_buf, and is committed
+    ///     by the interrupted PP before it releases the console lock.
+    ///
+    struct console_line_t final
+    {
+        /// @brief stores the characters that make up the line
+        bsl::array<bsl::char_type, CONSOLE_LINE_SIZE.get()> buf;
+        /// @brief stores the number of characters in buf
+        bsl::safe_uintmax len;
+        /// @brief stores whether or not this PP is committing a line
+        bool busy;
+        /// @brief stores the characters an ESR wrote while busy was set
+        bsl::array<bsl::char_type, CONSOLE_LINE_SIZE.get()> esr_buf;
+        /// @brief stores the number of characters in esr_buf
+        bsl::uint64 esr_len;
+    };
+}
+
+#endif
@@ -0,0 +1,61 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef HUGE_POOL_PAGE_T_HPP
+#define HUGE_POOL_PAGE_T_HPP
+
+#include <bsl/cstdint.hpp>
+
+namespace mk
+{
+    /// @struct mk::huge_pool_page_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the metadata that the huge pool stores for each
+    ///     page that it manages. The links and the order are only valid
+    ///     for the first page in a block, while the head and used fields
+    ///     are valid for every page in an allocated block.
+    ///
+    struct huge_pool_page_t final
+    {
+        /// @brief stores the index of the next free block of the same order
+        bsl::uint32 next;
+        /// @brief stores the index of the previous free block of the same order
+        bsl::uint32 prev;
+        /// @brief stores the index of the first page of this page's block
+        bsl::uint32 head;
+        /// @brief stores the number of pages requested by the allocation
+        bsl::uint32 size;
+        /// @brief stores the number of pages that have not been freed yet
+        bsl::uint32 live;
+        /// @brief stores the order of the block (i.e., 2^order pages)
+        bsl::uint8 order;
+        /// @brief stores true if this page is the first page of a free block
+        bool free;
+        /// @brief stores true if this page is allocated
+        bool used;
+    };
+}
+
+#endif
@@ -37,6 +37,11 @@ namespace mk
     /// @brief Map a page with execute permmissions
     constexpr bsl::safe_uintmax MAP_PAGE_EXECUTE{bsl::to_umax(0x0000000000000004U)};
 
+    /// @brief Defines the size of a 2M large page
+    constexpr bsl::safe_uintmax MAP_PAGE_2M_SIZE{bsl::to_umax(0x0000000000200000U)};
+    /// @brief Defines the size of a 1G large page
+    constexpr bsl::safe_uintmax MAP_PAGE_1G_SIZE{bsl::to_umax(0x0000000040000000U)};
+
     /// @brief Defines the auto release tag for no auto release
     constexpr bsl::safe_int32 MAP_PAGE_NO_AUTO_RELEASE{bsl::to_i32(0)};
     /// @brief Defines the auto release tag for alloc_page allocations
@@ -0,0 +1,69 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef PAGE_POOL_CACHE_T_HPP
+#define PAGE_POOL_CACHE_T_HPP
+
+#include <spinlock.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @struct mk::page_pool_cache_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the layout of a per-PP page pool cache. Each PP
+    ///     owns exactly one of these. The cache is a small free list of
+    ///     pages that is refilled from (and drained to) the page pool's
+    ///     global free list in batches. The free list is protected by the
+    ///     cache's own lock, which is only ever contended when another PP
+    ///     runs out of pages and flushes the caches of the other PPs. The
+    ///     remaining fields are only written by the PP that owns the cache.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam MAX_RECORDS the max number of records the page pool stores
+    ///
+    template<bsl::uintmax MAX_RECORDS>
+    struct page_pool_cache_t final
+    {
+        /// @brief safe guards head and count
+        spinlock lock;
+        /// @brief stores the head of the PP's local free list
+        void *head;
+        /// @brief stores the number of pages in the PP's local free list
+        bsl::safe_uintmax count;
+        /// @brief stores the number of allocations served from the cache
+        bsl::safe_uintmax hits;
+        /// @brief stores the number of allocations that required a refill
+        bsl::safe_uintmax misses;
+        /// @brief stores the number of bytes allocated by this PP per record
+        bsl::array<bsl::safe_uintmax, MAX_RECORDS> alc;
+        /// @brief stores the number of bytes freed by this PP per record
+        bsl::array<bsl::safe_uintmax, MAX_RECORDS> fre;
+    };
+}
+
+#endif
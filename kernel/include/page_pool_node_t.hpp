@@ -0,0 +1,64 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef PAGE_POOL_NODE_T_HPP
+#define PAGE_POOL_NODE_T_HPP
+
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @struct mk::page_pool_node_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the layout of a NUMA node's slice of the page pool.
+    ///     Each node has its own free list, which the PP caches are refilled
+    ///     from (preferring the PP's own node) and drained to. All of these
+    ///     fields are protected by the page pool's lock.
+    ///
+    struct page_pool_node_t final
+    {
+        /// @brief stores the head of the node's free list
+        void *head;
+        /// @brief stores the total number of bytes given to the node
+        bsl::safe_uintmax size;
+        /// @brief stores the number of pages in the node's free list
+        bsl::safe_uintmax free;
+        /// @brief stores the lowest physical address of the node's pages
+        bsl::safe_uintmax phys_min;
+        /// @brief stores the highest physical address of the node's pages
+        bsl::safe_uintmax phys_max;
+        /// @brief stores the number of pages given to PPs on this node
+        bsl::safe_uintmax local;
+        /// @brief stores the number of pages given to PPs on other nodes
+        bsl::safe_uintmax remote;
+        /// @brief stores the fewest pages the node's free list has held
+        bsl::safe_uintmax lowest;
+        /// @brief stores the total number of bytes donated by the root OS
+        bsl::safe_uintmax donated;
+    };
+}
+
+#endif
@@ -25,7 +25,6 @@
 #ifndef PAGE_POOL_RECORD_T_HPP
 #define PAGE_POOL_RECORD_T_HPP
 
-#include <bsl/safe_integral.hpp>
 #include <bsl/string_view.hpp>
 
 namespace mk
@@ -33,14 +32,14 @@ namespace mk
     /// @struct mk::page_pool_record_t
     ///
     /// <!-- description -->
-    ///   @brief Defines the layout of a page pool tag
+    ///   @brief Defines the layout of a page pool tag. Note that the
+    ///     number of bytes allocated with each tag is tracked per PP by
+    ///     the page_pool_cache_t so that allocations do not need a lock.
     ///
     struct page_pool_record_t final
     {
         /// @brief stores the tag associated with this record
         bsl::string_view tag;
-        /// @brief stores the number of bytes allocated with this record
-        bsl::safe_uintmax usd;
     };
 }
 
@@ -0,0 +1,181 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef POOL_BITMAP_T_HPP
+#define POOL_BITMAP_T_HPP
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/is_constant_evaluated.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace mk
+{
+    /// @brief defines the number of bits in a single pool_bitmap_t word
+    constexpr bsl::safe_uintmax POOL_BITMAP_WORD_BITS{bsl::to_umax(64)};
+
+    /// @class mk::pool_bitmap_t
+    ///
+    /// <!-- description -->
+    ///   @brief Tracks which entries of a VM, VP or VPS pool are in use, one
+    ///     bit per entry, so that a pool can find a free entry by looking at
+    ///     64 entries at a time instead of asking each entry for its status.
+    ///     A bit is set for any entry that is not deallocated, which
+    ///     includes zombies, so a zombie is never handed out again.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam MAX_ENTRIES the total number of entries in the pool
+    ///
+    template<bsl::uintmax MAX_ENTRIES>
+    class pool_bitmap_t final
+    {
+        /// @brief stores the total number of words in the bitmap
+        static constexpr bsl::safe_uintmax NUM_WORDS{
+            (bsl::to_umax(MAX_ENTRIES) + POOL_BITMAP_WORD_BITS - bsl::ONE_UMAX) /
+            POOL_BITMAP_WORD_BITS};
+
+        /// @brief stores the bitmap itself (set means in use)
+        bsl::array<bsl::uint64, NUM_WORDS.get()> m_words{};
+
+        /// <!-- description -->
+        ///   @brief Returns the word and mask of the bit for the provided
+        ///     entry, or a nullptr if the entry is out of range.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param i the index of the entry
+        ///   @param mask returns the mask of the entry's bit in the word
+        ///   @return Returns a pointer to the word holding the entry's bit,
+        ///     or a nullptr if the entry is out of range.
+        ///
+        [[nodiscard]] constexpr auto
+        word_of(bsl::safe_uintmax const &i, bsl::uint64 &mask) &noexcept -> bsl::uint64 *
+        {
+            if (bsl::unlikely(!(i < bsl::to_umax(MAX_ENTRIES)))) {
+                return nullptr;
+            }
+
+            mask = bsl::uint64{1} << (i % POOL_BITMAP_WORD_BITS).get();
+            return m_words.at_if(i / POOL_BITMAP_WORD_BITS);
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Returns the index of the first entry that is not in use,
+        ///     or bsl::safe_uintmax::zero(true) if all of them are.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the index of the first entry that is not in
+        ///     use, or bsl::safe_uintmax::zero(true) if all of them are.
+        ///
+        [[nodiscard]] constexpr auto
+        find_first_clear() const &noexcept -> bsl::safe_uintmax
+        {
+            for (auto const elem : m_words) {
+                bsl::uint64 word{};
+                if (bsl::is_constant_evaluated()) {
+                    word = *elem.data;
+                }
+                else {
+                    word = __atomic_load_n(elem.data, __ATOMIC_RELAXED);
+                }
+
+                if (~word == bsl::uint64{}) {
+                    continue;
+                }
+
+                auto const bit{bsl::to_umax(__builtin_ctzll(~word))};
+                auto const i{(bsl::to_umax(elem.index) * POOL_BITMAP_WORD_BITS) + bit};
+                if (bsl::unlikely(!(i < bsl::to_umax(MAX_ENTRIES)))) {
+                    break;
+                }
+
+                return i;
+            }
+
+            return bsl::safe_uintmax::zero(true);
+        }
+
+        /// <!-- description -->
+        ///   @brief Marks the provided entry as in use
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param i the index of the entry to mark
+        ///
+        constexpr void
+        set(bsl::safe_uintmax const &i) &noexcept
+        {
+            bsl::uint64 mask{};
+            auto *const word{this->word_of(i, mask)};
+            if (bsl::unlikely(nullptr == word)) {
+                return;
+            }
+
+            if (bsl::is_constant_evaluated()) {
+                *word |= mask;
+            }
+            else {
+                __atomic_fetch_or(word, mask, __ATOMIC_RELAXED);
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Marks the provided entry as no longer in use
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param i the index of the entry to mark
+        ///
+        constexpr void
+        clear(bsl::safe_uintmax const &i) &noexcept
+        {
+            bsl::uint64 mask{};
+            auto *const word{this->word_of(i, mask)};
+            if (bsl::unlikely(nullptr == word)) {
+                return;
+            }
+
+            if (bsl::is_constant_evaluated()) {
+                *word &= ~mask;
+            }
+            else {
+                __atomic_fetch_and(word, ~mask, __ATOMIC_RELAXED);
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Marks every entry as no longer in use
+        ///
+        constexpr void
+        clear_all() &noexcept
+        {
+            for (auto const elem : m_words) {
+                *elem.data = {};
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,138 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef POOL_COUNTS_T_HPP
+#define POOL_COUNTS_T_HPP
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/is_constant_evaluated.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace mk
+{
+    /// @class mk::pool_counts_t
+    ///
+    /// <!-- description -->
+    ///   @brief Counts how many entries of a pool are assigned to each
+    ///     parent (i.e., VPs per VM or VPSs per VP), so that the checks made
+    ///     when a parent is destroyed do not have to walk the whole pool.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam MAX_PARENTS the total number of parents
+    ///
+    template<bsl::uintmax MAX_PARENTS>
+    class pool_counts_t final
+    {
+        /// @brief stores the number of entries assigned to each parent
+        bsl::array<bsl::uint64, MAX_PARENTS> m_counts{};
+
+    public:
+        /// <!-- description -->
+        ///   @brief Records that an entry was assigned to the provided parent
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param id the ID of the parent
+        ///
+        constexpr void
+        inc(bsl::safe_uint16 const &id) &noexcept
+        {
+            auto *const count{m_counts.at_if(bsl::to_umax(id))};
+            if (bsl::unlikely(nullptr == count)) {
+                return;
+            }
+
+            if (bsl::is_constant_evaluated()) {
+                ++*count;
+            }
+            else {
+                __atomic_add_fetch(count, bsl::uint64{1}, __ATOMIC_RELAXED);
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Records that an entry is no longer assigned to the
+        ///     provided parent
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param id the ID of the parent
+        ///
+        constexpr void
+        dec(bsl::safe_uint16 const &id) &noexcept
+        {
+            auto *const count{m_counts.at_if(bsl::to_umax(id))};
+            if (bsl::unlikely(nullptr == count)) {
+                return;
+            }
+
+            if (bsl::is_constant_evaluated()) {
+                --*count;
+            }
+            else {
+                __atomic_sub_fetch(count, bsl::uint64{1}, __ATOMIC_RELAXED);
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if no entries are assigned to the provided
+        ///     parent. Invalid IDs always return false so that callers fall
+        ///     back to looking at the pool itself.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param id the ID of the parent
+        ///   @return Returns true if no entries are assigned to the provided
+        ///     parent, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_zero(bsl::safe_uint16 const &id) const &noexcept -> bool
+        {
+            auto const *const count{m_counts.at_if(bsl::to_umax(id))};
+            if (bsl::unlikely(nullptr == count)) {
+                return false;
+            }
+
+            if (bsl::is_constant_evaluated()) {
+                return bsl::uint64{} == *count;
+            }
+
+            return bsl::uint64{} == __atomic_load_n(count, __ATOMIC_RELAXED);
+        }
+
+        /// <!-- description -->
+        ///   @brief Resets all of the counts to 0
+        ///
+        constexpr void
+        clear_all() &noexcept
+        {
+            for (auto const elem : m_counts) {
+                *elem.data = {};
+            }
+        }
+    };
+}
+
+#endif
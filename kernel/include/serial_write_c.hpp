@@ -26,6 +26,7 @@
 #define SERIAL_WRITE_C_HPP
 
 #include <bsl/char_type.hpp>
+#include <bsl/cstdint.hpp>
 
 namespace mk
 {
@@ -36,6 +37,28 @@ namespace mk
     ///   @param c the character to write
     ///
     extern "C" void serial_write_c(bsl::char_type const c) noexcept;
+
+    /// <!-- description -->
+    ///   @brief Returns the number of characters that can be written to
+    ///     the serial device using serial_write_c_nowait without having
+    ///     to wait for the serial device's transmit FIFO to drain. If
+    ///     this returns 0, the serial device is busy.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Returns the number of characters that can be written to
+    ///     the serial device without waiting.
+    ///
+    extern "C" [[nodiscard]] auto serial_write_room() noexcept -> bsl::uintmax;
+
+    /// <!-- description -->
+    ///   @brief Writes a character "c" to the serial device without
+    ///     waiting for room in the serial device's transmit FIFO. Only
+    ///     use this after serial_write_room says there is room.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param c the character to write
+    ///
+    extern "C" void serial_write_c_nowait(bsl::char_type const c) noexcept;
 }
 
 #endif
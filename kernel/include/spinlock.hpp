@@ -25,11 +25,14 @@
 #ifndef SPINLOCK_HPP
 #define SPINLOCK_HPP
 
+#include <cpu_relax.hpp>
 #include <mk_interface.hpp>
 
+#include <bsl/cstdint.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/is_constant_evaluated.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
 
 #pragma clang diagnostic ignored "-Watomic-implicit-seq-cst"
 
@@ -38,7 +41,10 @@ namespace mk
     /// @class mk::spinlock
     ///
     /// <!-- description -->
-    ///   @brief Implements a spinlock
+    ///   @brief Implements a ticket spinlock. Each PP that attempts to
+    ///     acquire the lock takes a ticket, and the lock is handed to the
+    ///     PPs in the order in which they took their tickets, meaning the
+    ///     lock is fair, and no PP can be starved by the others.
     ///
     /// <!-- notes -->
     ///   @note This spinlock is designed to detect and prevent deadlock
@@ -54,8 +60,17 @@ namespace mk
         bsl::safe_uint16 m_std_ppid;
         /// @brief stores the ppid that currently owns the lock (ESR)
         bsl::safe_uint16 m_esr_ppid;
-        /// @brief stores whether or not the lock is acquired
-        _Atomic bool m_flag;
+        /// @brief stores the next ticket to hand out
+        _Atomic bsl::uint32 m_next;
+        /// @brief stores the ticket that currently owns the lock
+        _Atomic bsl::uint32 m_serving;
+
+        /// @brief stores the number of times the lock was acquired
+        bsl::safe_uintmax m_acquisitions;
+        /// @brief stores the number of acquisitions that had to wait
+        bsl::safe_uintmax m_contentions;
+        /// @brief stores the total number of times a PP spun on the lock
+        bsl::safe_uintmax m_spins;
 
     public:
         /// <!-- description -->
@@ -64,11 +79,18 @@ namespace mk
         // We cannot member initialize atomics so this is not possible
         // NOLINTNEXTLINE(bsl-class-member-init)
         constexpr spinlock() noexcept    // --
-            : m_std_ppid{syscall::BF_INVALID_ID}, m_esr_ppid{syscall::BF_INVALID_ID}
+            : m_std_ppid{syscall::BF_INVALID_ID}
+            , m_esr_ppid{syscall::BF_INVALID_ID}
+            , m_acquisitions{}
+            , m_contentions{}
+            , m_spins{}
         {
             // This is the only way to initialize this
             // NOLINTNEXTLINE(bsl-implicit-conversions-forbidden)
-            m_flag = false;
+            m_next = 0U;
+            // This is the only way to initialize this
+            // NOLINTNEXTLINE(bsl-implicit-conversions-forbidden)
+            m_serving = 0U;
         }
 
         /// <!-- description -->
@@ -158,34 +180,43 @@ namespace mk
             }
 
             /// NOTE:
-            /// - The __c11_atomic_exchange here attempts to set the lock to
-            ///   true. If it is already true, __c11_atomic_exchange will
-            ///   return true, which means that the lock was already taken
-            ///   by another PP. If this occurs, we need to wait until the
-            ///   value that __c11_atomic_exchange returns is false, meaning
-            ///   the lock was released. If __c11_atomic_exchange returns
-            ///   false right off the bat, it means that the lock was never
-            ///   taken at all, and there is nothing else to do.
-            /// - The call to __c11_atomic_load reads the value of the lock,
-            ///   and will continue to loop while the lock is true, meaning
-            ///   it is held by another PP. The reason that __c11_atomic_load
-            ///   is called instead of just looping using __c11_atomic_exchange
-            ///   all the time is __c11_atomic_exchange uses a fence to ensure
-            ///   proper ordering which is expensive. __c11_atomic_load in
-            ///   this case, since we used __ATOMIC_RELAXED does not include
-            ///   the fence, and so it can loop without killing the pipeline.
-            /// - The only issue with this implementation is that once the
-            ///   call to __c11_atomic_load returns, we still have not acquired
-            ///   the lock as this is what __c11_atomic_exchange does. It is
-            ///   possible that between when __c11_atomic_load returns and
-            ///   __c11_atomic_exchange executes, another PP will have grabbed
-            ///   the lock. Research has shown however that even with this
-            ///   issue, this implemenation is the best for a spinlock WRT
-            ///   overall performance.
+            /// - The __c11_atomic_fetch_add here takes a ticket. Tickets
+            ///   are handed out in order, and the lock is owned by the PP
+            ///   whose ticket matches m_serving, so the PPs acquire the
+            ///   lock in the same order that they asked for it.
+            /// - While waiting, each PP only reads m_serving using
+            ///   __ATOMIC_ACQUIRE, which unlike the exchange in a
+            ///   test-and-set lock, does not require the cache line to be
+            ///   owned exclusively. The only write to m_serving is made by
+            ///   the PP that is releasing the lock, so the waiting PPs do
+            ///   not fight over the cache line while the lock is held.
+            /// - cpu_relax() tells the CPU that this is a spin loop, which
+            ///   frees up resources for a sibling hyperthread, and prevents
+            ///   the pipeline flush that would otherwise occur when the
+            ///   loop exits.
+            /// - The ticket counters are allowed to wrap. The only thing
+            ///   that matters is whether or not the tickets are equal.
             ///
 
-            while (__c11_atomic_exchange(&m_flag, true, __ATOMIC_ACQUIRE)) {
-                while (__c11_atomic_load(&m_flag, __ATOMIC_RELAXED)) {
+            bsl::uint32 const ticket{__c11_atomic_fetch_add(&m_next, 1U, __ATOMIC_RELAXED)};
+
+            bsl::safe_uintmax spins{};
+            while (__c11_atomic_load(&m_serving, __ATOMIC_ACQUIRE) != ticket) {
+                cpu_relax();
+
+                if constexpr (!(BSL_DEBUG_LEVEL < bsl::V)) {
+                    ++spins;
+                }
+            }
+
+            if constexpr (!(BSL_DEBUG_LEVEL < bsl::V)) {
+                ++m_acquisitions;
+                if (spins.is_pos()) {
+                    ++m_contentions;
+                    m_spins += spins;
+                }
+                else {
+                    bsl::touch();
                 }
             }
 
@@ -235,12 +266,57 @@ namespace mk
             }
 
             /// NOTE:
-            /// - Here, we simply need to set the lock flag to false,
-            ///   indicating that we no longer are holding the lock. We
-            ///   use __ATOMIC_RELEASE to ensure proper memory ordering.
+            /// - Here, we simply need to hand the lock to the next ticket.
+            ///   Only the owner of the lock ever writes to m_serving, so
+            ///   there is no need for a read-modify-write. We use
+            ///   __ATOMIC_RELEASE to ensure proper memory ordering.
             ///
 
-            __c11_atomic_store(&m_flag, false, __ATOMIC_RELEASE);
+            bsl::uint32 const next{__c11_atomic_load(&m_serving, __ATOMIC_RELAXED) + 1U};
+            __c11_atomic_store(&m_serving, next, __ATOMIC_RELEASE);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the number of times the lock was acquired. This
+        ///     is only tracked if BSL_DEBUG_LEVEL is at least bsl::V. The
+        ///     page and huge pool locks are shown by bf_debug_op_dump_page_pool
+        ///     and bf_debug_op_dump_huge_pool.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the number of times the lock was acquired
+        ///
+        [[nodiscard]] constexpr auto
+        acquisitions() const noexcept -> bsl::safe_uintmax const &
+        {
+            return m_acquisitions;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the number of times the lock was acquired while
+        ///     it was held by another PP. This is only tracked if
+        ///     BSL_DEBUG_LEVEL is at least bsl::V.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the number of contended acquisitions
+        ///
+        [[nodiscard]] constexpr auto
+        contentions() const noexcept -> bsl::safe_uintmax const &
+        {
+            return m_contentions;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the total number of times a PP had to spin
+        ///     while waiting for the lock. This is only tracked if
+        ///     BSL_DEBUG_LEVEL is at least bsl::V.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the total number of spins
+        ///
+        [[nodiscard]] constexpr auto
+        spins() const noexcept -> bsl::safe_uintmax const &
+        {
+            return m_spins;
         }
     };
 }
@@ -0,0 +1,48 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef TLB_SHOOTDOWN_NODE_T_HPP
+#define TLB_SHOOTDOWN_NODE_T_HPP
+
+#include <bsl/cstdint.hpp>
+
+namespace mk
+{
+    /// @struct mk::tlb_shootdown_node_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the layout of a page that is waiting for a TLB
+    ///     shootdown to complete before it can be given back to the pool
+    ///     that it came from. The node is stored in the freed page itself.
+    ///
+    struct tlb_shootdown_node_t final
+    {
+        /// @brief stores the next page waiting on a TLB shootdown
+        tlb_shootdown_node_t *next;
+        /// @brief stores the generation every PP must flush before reuse
+        bsl::uint64 gen;
+    };
+}
+
+#endif
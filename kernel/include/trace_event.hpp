@@ -0,0 +1,93 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef TRACE_EVENT_HPP
+#define TRACE_EVENT_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/string_view.hpp>
+
+namespace mk
+{
+    /// @brief defines the trace event for a VMEntry (arg is unused)
+    constexpr bsl::safe_uint16 TRACE_EVENT_VMENTRY{bsl::to_u16(0)};
+    /// @brief defines the trace event for a VMExit (arg is the exit reason)
+    constexpr bsl::safe_uint16 TRACE_EVENT_VMEXIT{bsl::to_u16(1)};
+    /// @brief defines the trace event for a call into an extension (arg is the IP)
+    constexpr bsl::safe_uint16 TRACE_EVENT_EXT{bsl::to_u16(2)};
+    /// @brief defines the trace event for a syscall (arg is the syscall)
+    constexpr bsl::safe_uint16 TRACE_EVENT_SYSCALL{bsl::to_u16(3)};
+    /// @brief defines the trace event for a completed syscall (arg is the status)
+    constexpr bsl::safe_uint16 TRACE_EVENT_SYSCALL_DONE{bsl::to_u16(4)};
+    /// @brief defines the trace event for an ESR (arg is the vector)
+    constexpr bsl::safe_uint16 TRACE_EVENT_ESR{bsl::to_u16(5)};
+
+    /// <!-- description -->
+    ///   @brief Returns the name of a trace event given its ID. This is
+    ///     the name that the trace is dumped with.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param event the ID of the trace event to get the name for
+    ///   @return Returns the name of a trace event given its ID
+    ///
+    [[nodiscard]] constexpr auto
+    trace_event_to_name(bsl::safe_uint16 const &event) noexcept -> bsl::string_view
+    {
+        switch (event.get()) {
+            case TRACE_EVENT_VMENTRY.get(): {
+                return "vmentry";
+            }
+
+            case TRACE_EVENT_VMEXIT.get(): {
+                return "vmexit";
+            }
+
+            case TRACE_EVENT_EXT.get(): {
+                return "ext";
+            }
+
+            case TRACE_EVENT_SYSCALL.get(): {
+                return "syscall";
+            }
+
+            case TRACE_EVENT_SYSCALL_DONE.get(): {
+                return "syscall_done";
+            }
+
+            case TRACE_EVENT_ESR.get(): {
+                return "esr";
+            }
+
+            default: {
+                break;
+            }
+        }
+
+        return "unknown";
+    }
+}
+
+#endif
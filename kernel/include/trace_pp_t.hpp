@@ -0,0 +1,56 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef TRACE_PP_T_HPP
+#define TRACE_PP_T_HPP
+
+#include <trace_record_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/cstdint.hpp>
+
+namespace mk
+{
+    /// @struct mk::trace_pp_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the trace ring for a single PP. Each PP owns exactly
+    ///     one of these, and only that PP ever writes to it, which is why
+    ///     none of these fields need a lock.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam TRACE_SIZE defines the number of records in the ring
+    ///
+    template<bsl::uintmax TRACE_SIZE>
+    struct trace_pp_t final
+    {
+        /// @brief stores the trace ring
+        bsl::array<trace_record_t, TRACE_SIZE> rcds;
+        /// @brief stores the total number of records ever written
+        bsl::uint64 count;
+    };
+}
+
+#endif
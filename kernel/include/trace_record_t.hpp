@@ -0,0 +1,57 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef TRACE_RECORD_T_HPP
+#define TRACE_RECORD_T_HPP
+
+#include <bsl/cstdint.hpp>
+
+namespace mk
+{
+    /// @struct mk::trace_record_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores a single trace event. Records are kept as small as
+    ///     possible (i.e., no safe integrals) so that a PP's trace ring
+    ///     covers as much time as possible for a given amount of memory.
+    ///
+    struct trace_record_t final
+    {
+        /// @brief stores the value of the TSC when the event occurred
+        bsl::uint64 tsc;
+        /// @brief stores the event specific argument (e.g., exit reason)
+        bsl::uint64 arg;
+        /// @brief stores the ID of the event (see trace_event_t)
+        bsl::uint16 event;
+        /// @brief stores the ID of the VM that was active
+        bsl::uint16 vmid;
+        /// @brief stores the ID of the VP that was active
+        bsl::uint16 vpid;
+        /// @brief stores the ID of the VPS that was active
+        bsl::uint16 vpsid;
+    };
+}
+
+#endif
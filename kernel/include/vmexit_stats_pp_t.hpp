@@ -0,0 +1,65 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef VMEXIT_STATS_PP_T_HPP
+#define VMEXIT_STATS_PP_T_HPP
+
+#include <vmexit_stats_record_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @struct mk::vmexit_stats_pp_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the VMExit statistics for a single PP. Each PP owns
+    ///     exactly one of these, and only that PP ever updates it, which is
+    ///     why none of these fields need a lock.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam VMEXIT_STATS_SIZE defines the max number of exit reasons
+    ///
+    template<bsl::uintmax VMEXIT_STATS_SIZE>
+    struct vmexit_stats_pp_t final
+    {
+        /// @brief stores one record per exit reason (hashed by exit reason)
+        bsl::array<vmexit_stats_record_t, VMEXIT_STATS_SIZE> rcds;
+        /// @brief stores the number of VMExits that did not fit in rcds
+        bsl::safe_uintmax dropped;
+        /// @brief stores the total TSC cycles spent in the microkernel
+        bsl::safe_uintmax mk_cycles;
+        /// @brief stores the total TSC cycles spent in the extension
+        bsl::safe_uintmax ext_cycles;
+        /// @brief stores the TSC of the VMExit currently being handled
+        bsl::safe_uintmax exit_tsc;
+        /// @brief stores the TSC of when the extension was last called
+        bsl::safe_uintmax ext_tsc;
+        /// @brief stores the record of the VMExit currently being handled
+        vmexit_stats_record_t *pending;
+    };
+}
+
+#endif
@@ -0,0 +1,48 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef VMEXIT_STATS_RECORD_T_HPP
+#define VMEXIT_STATS_RECORD_T_HPP
+
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @struct mk::vmexit_stats_record_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the statistics for a single exit reason
+    ///
+    struct vmexit_stats_record_t final
+    {
+        /// @brief stores the exit reason this record belongs to
+        bsl::safe_uintmax exit_reason;
+        /// @brief stores the number of VMExits with this exit reason
+        bsl::safe_uintmax count;
+        /// @brief stores the total TSC cycles spent handling this exit reason
+        bsl::safe_uintmax cycles;
+    };
+}
+
+#endif
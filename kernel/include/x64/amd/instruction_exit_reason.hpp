@@ -0,0 +1,97 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#ifndef INSTRUCTION_EXIT_REASON_HPP
+#define INSTRUCTION_EXIT_REASON_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @brief defines the largest exit code that is caused by an instruction
+    constexpr bsl::safe_uintmax INSTRUCTION_EXIT_REASON_MAX{bsl::to_umax(0xA4)};
+
+    /// <!-- description -->
+    ///   @brief Returns true if the provided exit code is an instruction
+    ///     intercept (e.g., CPUID, RDMSR/WRMSR, XSETBV or INVD), in which
+    ///     case the next RIP is saved in the VMCB and the IP can be advanced
+    ///     past the instruction. Exit codes that are caused by an event
+    ///     (e.g., an external interrupt, an NMI, an exception or a nested
+    ///     page fault) return false.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reason the exit code to check
+    ///   @return Returns true if the provided exit code is an instruction
+    ///     intercept.
+    ///
+    [[nodiscard]] constexpr auto
+    is_instruction_exit_reason(bsl::safe_uintmax const &reason) noexcept -> bool
+    {
+        constexpr bsl::safe_uintmax EXIT_REASON_CR0_READ{bsl::to_umax(0x00)};
+        constexpr bsl::safe_uintmax EXIT_REASON_DR15_WRITE{bsl::to_umax(0x3F)};
+        constexpr bsl::safe_uintmax EXIT_REASON_CR0_SEL_WRITE{bsl::to_umax(0x65)};
+        constexpr bsl::safe_uintmax EXIT_REASON_RSM{bsl::to_umax(0x73)};
+        constexpr bsl::safe_uintmax EXIT_REASON_INVD{bsl::to_umax(0x76)};
+        constexpr bsl::safe_uintmax EXIT_REASON_MSR{bsl::to_umax(0x7C)};
+        constexpr bsl::safe_uintmax EXIT_REASON_VMRUN{bsl::to_umax(0x80)};
+        constexpr bsl::safe_uintmax EXIT_REASON_RDTSCP{bsl::to_umax(0x87)};
+        constexpr bsl::safe_uintmax EXIT_REASON_WBINVD{bsl::to_umax(0x89)};
+        constexpr bsl::safe_uintmax EXIT_REASON_RDPRU{bsl::to_umax(0x8E)};
+        constexpr bsl::safe_uintmax EXIT_REASON_INVLPGB{bsl::to_umax(0xA0)};
+        constexpr bsl::safe_uintmax EXIT_REASON_TLBSYNC{bsl::to_umax(0xA4)};
+
+        auto in_range{[&reason](auto const &first, auto const &last) noexcept {
+            return (reason >= first) && (reason <= last);
+        }};
+
+        /// NOTE:
+        /// - IRET, INTn and ICEBP are left out. They are intercepted as
+        ///   part of delivering an event, and skipping them would lose it.
+        ///
+
+        if (in_range(EXIT_REASON_CR0_READ, EXIT_REASON_DR15_WRITE)) {
+            return true;
+        }
+
+        if (in_range(EXIT_REASON_CR0_SEL_WRITE, EXIT_REASON_RSM)) {
+            return true;
+        }
+
+        if (in_range(EXIT_REASON_INVD, EXIT_REASON_MSR)) {
+            return true;
+        }
+
+        if (in_range(EXIT_REASON_VMRUN, EXIT_REASON_RDTSCP)) {
+            return true;
+        }
+
+        if (in_range(EXIT_REASON_WBINVD, EXIT_REASON_RDPRU)) {
+            return true;
+        }
+
+        return in_range(EXIT_REASON_INVLPGB, EXIT_REASON_TLBSYNC);
+    }
+}
+
+#endif
@@ -63,6 +63,33 @@ namespace mk
     /// @brief defines the size of the reserved13 field in the VMCB
     constexpr bsl::safe_uintmax VMCB_GIB_SIZE{bsl::to_umax(0xF)};
 
+    /// @brief defines the intercepts, TSC offset and pause filter clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_I{bsl::to_u32(0x00000001U)};
+    /// @brief defines the IOPM/MSRPM base address clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_IOPM{bsl::to_u32(0x00000002U)};
+    /// @brief defines the ASID clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_ASID{bsl::to_u32(0x00000004U)};
+    /// @brief defines the virtual TPR/interrupt control clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_TPR{bsl::to_u32(0x00000008U)};
+    /// @brief defines the nested paging (NP enable, nCR3, gPAT) clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_NP{bsl::to_u32(0x00000010U)};
+    /// @brief defines the CR0, CR3, CR4 and EFER clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_CRX{bsl::to_u32(0x00000020U)};
+    /// @brief defines the DR6 and DR7 clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_DRX{bsl::to_u32(0x00000040U)};
+    /// @brief defines the GDTR and IDTR clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_DT{bsl::to_u32(0x00000080U)};
+    /// @brief defines the CS, DS, SS, ES and CPL clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_SEG{bsl::to_u32(0x00000100U)};
+    /// @brief defines the CR2 clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_CR2{bsl::to_u32(0x00000200U)};
+    /// @brief defines the DbgCtl and last branch record clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_LBR{bsl::to_u32(0x00000400U)};
+    /// @brief defines the AVIC clean bit
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_AVIC{bsl::to_u32(0x00000800U)};
+    /// @brief defines all of the clean bits that are tracked
+    constexpr bsl::safe_uint32 VMCB_CLEAN_BITS_ALL{bsl::to_u32(0x00000FFFU)};
+
     /// @struct mk::vmcb_t
     ///
     /// <!-- description -->
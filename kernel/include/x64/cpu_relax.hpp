@@ -0,0 +1,50 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef CPU_RELAX_HPP
+#define CPU_RELAX_HPP
+
+#include <bsl/is_constant_evaluated.hpp>
+
+namespace mk
+{
+    /// <!-- description -->
+    ///   @brief Tells the CPU that it is executing a spin-wait loop (i.e.,
+    ///     PAUSE). This reduces the power consumed while spinning, gives
+    ///     the sibling hyperthread more of the core, and avoids the memory
+    ///     order violation (and the pipeline flush that comes with it)
+    ///     when the spin loop finally exits.
+    ///
+    constexpr void
+    cpu_relax() noexcept
+    {
+        if (bsl::is_constant_evaluated()) {
+            return;
+        }
+
+        __builtin_ia32_pause();
+    }
+}
+
+#endif
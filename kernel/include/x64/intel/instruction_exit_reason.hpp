@@ -0,0 +1,115 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#ifndef INSTRUCTION_EXIT_REASON_HPP
+#define INSTRUCTION_EXIT_REASON_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @brief defines the largest exit reason that is caused by an instruction
+    constexpr bsl::safe_uintmax INSTRUCTION_EXIT_REASON_MAX{bsl::to_umax(0x44)};
+
+    /// <!-- description -->
+    ///   @brief Returns true if the provided basic exit reason is caused by
+    ///     the guest executing an instruction (e.g., CPUID, RDMSR, WRMSR,
+    ///     XSETBV or INVD), in which case the VM-exit instruction length
+    ///     is valid and the IP can be advanced past it. Exit reasons that
+    ///     are caused by an event (e.g., an external interrupt, an NMI or
+    ///     an EPT violation) return false.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reason the basic exit reason to check
+    ///   @return Returns true if the provided basic exit reason is caused
+    ///     by the guest executing an instruction.
+    ///
+    [[nodiscard]] constexpr auto
+    is_instruction_exit_reason(bsl::safe_uintmax const &reason) noexcept -> bool
+    {
+        constexpr bsl::safe_uintmax EXIT_REASON_CPUID{bsl::to_umax(0x0A)};
+        constexpr bsl::safe_uintmax EXIT_REASON_WRMSR{bsl::to_umax(0x20)};
+        constexpr bsl::safe_uintmax EXIT_REASON_MWAIT{bsl::to_umax(0x24)};
+        constexpr bsl::safe_uintmax EXIT_REASON_MONITOR{bsl::to_umax(0x27)};
+        constexpr bsl::safe_uintmax EXIT_REASON_PAUSE{bsl::to_umax(0x28)};
+        constexpr bsl::safe_uintmax EXIT_REASON_GDTR_IDTR{bsl::to_umax(0x2E)};
+        constexpr bsl::safe_uintmax EXIT_REASON_LDTR_TR{bsl::to_umax(0x2F)};
+        constexpr bsl::safe_uintmax EXIT_REASON_INVEPT{bsl::to_umax(0x32)};
+        constexpr bsl::safe_uintmax EXIT_REASON_RDTSCP{bsl::to_umax(0x33)};
+        constexpr bsl::safe_uintmax EXIT_REASON_INVVPID{bsl::to_umax(0x35)};
+        constexpr bsl::safe_uintmax EXIT_REASON_WBINVD{bsl::to_umax(0x36)};
+        constexpr bsl::safe_uintmax EXIT_REASON_XSETBV{bsl::to_umax(0x37)};
+        constexpr bsl::safe_uintmax EXIT_REASON_RDRAND{bsl::to_umax(0x39)};
+        constexpr bsl::safe_uintmax EXIT_REASON_INVPCID{bsl::to_umax(0x3A)};
+        constexpr bsl::safe_uintmax EXIT_REASON_VMFUNC{bsl::to_umax(0x3B)};
+        constexpr bsl::safe_uintmax EXIT_REASON_ENCLS{bsl::to_umax(0x3C)};
+        constexpr bsl::safe_uintmax EXIT_REASON_RDSEED{bsl::to_umax(0x3D)};
+        constexpr bsl::safe_uintmax EXIT_REASON_XSAVES{bsl::to_umax(0x3F)};
+        constexpr bsl::safe_uintmax EXIT_REASON_XRSTORS{bsl::to_umax(0x40)};
+        constexpr bsl::safe_uintmax EXIT_REASON_UMWAIT{bsl::to_umax(0x43)};
+        constexpr bsl::safe_uintmax EXIT_REASON_TPAUSE{bsl::to_umax(0x44)};
+
+        /// NOTE:
+        /// - Every exit reason from CPUID through WRMSR is caused by an
+        ///   instruction (this includes HLT, INVD, INVLPG, RDTSC, VMCALL,
+        ///   the VMX instructions, MOV CR/DR, I/O and RDMSR).
+        ///
+
+        if ((reason >= EXIT_REASON_CPUID) && (reason <= EXIT_REASON_WRMSR)) {
+            return true;
+        }
+
+        switch (reason.get()) {
+            case EXIT_REASON_MWAIT.get():
+            case EXIT_REASON_MONITOR.get():
+            case EXIT_REASON_PAUSE.get():
+            case EXIT_REASON_GDTR_IDTR.get():
+            case EXIT_REASON_LDTR_TR.get():
+            case EXIT_REASON_INVEPT.get():
+            case EXIT_REASON_RDTSCP.get():
+            case EXIT_REASON_INVVPID.get():
+            case EXIT_REASON_WBINVD.get():
+            case EXIT_REASON_XSETBV.get():
+            case EXIT_REASON_RDRAND.get():
+            case EXIT_REASON_INVPCID.get():
+            case EXIT_REASON_VMFUNC.get():
+            case EXIT_REASON_ENCLS.get():
+            case EXIT_REASON_RDSEED.get():
+            case EXIT_REASON_XSAVES.get():
+            case EXIT_REASON_XRSTORS.get():
+            case EXIT_REASON_UMWAIT.get():
+            case EXIT_REASON_TPAUSE.get(): {
+                return true;
+            }
+
+            default: {
+                break;
+            }
+        }
+
+        return false;
+    }
+}
+
+#endif
@@ -69,6 +69,10 @@ namespace mk
 
         /// @brief stores the launch status of the hypervisor (0x060)
         bsl::uintmax launched;
+        /// @brief stores whether writes to the syscall MSRs always VMExit (0x068)
+        bsl::uintmax syscall_msrs_intercepted;
+        /// @brief stores the address of the MSR bitmap's syscall MSR write bits (0x070)
+        bsl::uintmax syscall_msrs_bitmap;
     };
 }
 
@@ -0,0 +1,51 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef PCID_FLAGS_HPP
+#define PCID_FLAGS_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace mk
+{
+    /// @brief Defines the CR4 bit that enables process-context identifiers
+    constexpr bsl::safe_uint64 CR4_PCIDE{bsl::to_u64(0x0000000000020000U)};
+    /// @brief Defines the CR3 bit that prevents a CR3 write from flushing
+    constexpr bsl::safe_uint64 CR3_NOFLUSH{bsl::to_u64(0x8000000000000000U)};
+    /// @brief Defines the largest PCID that can be stored in CR3
+    constexpr bsl::safe_uint16 PCID_MAX{bsl::to_u16(0x0FFFU)};
+
+    /// @brief Defines the INVPCID type for a single address in one PCID
+    constexpr bsl::safe_uint64 INVPCID_TYPE_INDIVIDUAL_ADDRESS{bsl::to_u64(0x0U)};
+    /// @brief Defines the INVPCID type for all addresses in one PCID
+    constexpr bsl::safe_uint64 INVPCID_TYPE_SINGLE_CONTEXT{bsl::to_u64(0x1U)};
+    /// @brief Defines the INVPCID type for all PCIDs, including globals
+    constexpr bsl::safe_uint64 INVPCID_TYPE_ALL_CONTEXTS_GLOBAL{bsl::to_u64(0x2U)};
+    /// @brief Defines the INVPCID type for all PCIDs, excluding globals
+    constexpr bsl::safe_uint64 INVPCID_TYPE_ALL_CONTEXTS{bsl::to_u64(0x3U)};
+}
+
+#endif
@@ -43,7 +43,7 @@ namespace mk
     /// @brief defines the size of the reserved2 field in the tls_t
     constexpr bsl::safe_uintmax TLS_T_RESERVED3_SIZE{bsl::to_umax(0x007)};
     /// @brief defines the size of the reserved2 field in the tls_t
-    constexpr bsl::safe_uintmax TLS_T_RESERVED4_SIZE{bsl::to_umax(0x048)};
+    constexpr bsl::safe_uintmax TLS_T_RESERVED4_SIZE{bsl::to_umax(0x020)};
 
     /// IMPORTANT:
     /// - If the size of the TLS is changed, the mk_main_entry will need to
@@ -225,8 +225,8 @@ namespace mk
         bsl::uint16 online_pps;
         /// @brief stores the VPSID whose VMCS is loaded on Intel (0x20C)
         bsl::uint16 loaded_vpsid;
-        /// @brief reserved (0x20E)
-        bsl::uint16 reserved_padding;
+        /// @brief stores the NUMA node of this PP (0x20E)
+        bsl::uint16 node;
 
         /// @brief stores the currently active extension (0x210)
         void *ext;
@@ -302,6 +302,33 @@ namespace mk
         /// @brief logs a vps for state reversal if needed (0x2B0)
         void *log_vps;
 
+        /// --------------------------------------------------------------------
+        /// Lazy FPU State
+        /// --------------------------------------------------------------------
+
+        /// @brief stores the XSAVE area whose state is loaded on the CPU (0x2B8)
+        void *active_xsave;
+        /// @brief stores the root OS's FPU state until a VPS claims it (0x2C0)
+        void *root_xsave;
+        /// @brief stores whether or not lazy FPU switching is enabled (0x2C8)
+        bsl::uintmax xsave_enabled;
+
+        /// --------------------------------------------------------------------
+        /// Syscall MSR State
+        /// --------------------------------------------------------------------
+
+        /// NOTE:
+        /// - The microkernel never uses ia32_cstar or ia32_kernel_gs_base,
+        ///   so on Intel, they are not restored on a VMExit. Instead, the
+        ///   values loaded on this PP are tracked here, and a VMEntry only
+        ///   writes them if the VPS being run needs something different.
+        ///
+
+        /// @brief stores the value of ia32_cstar loaded on this PP (0x2D0)
+        bsl::uintmax loaded_ia32_cstar;
+        /// @brief stores the value of ia32_kernel_gs_base loaded on this PP (0x2D8)
+        bsl::uintmax loaded_ia32_kernel_gs_base;
+
         /// @brief reserve the rest of the TLS block for later use.
         bsl::details::carray<bsl::uint8, TLS_T_RESERVED4_SIZE.get()> reserved4;
     };
@@ -26,6 +26,7 @@
 #define DISPATCH_ESR_HPP
 
 #include <dispatch_esr_page_fault.hpp>
+#include <trace_event.hpp>
 
 #include <bsl/debug.hpp>
 #include <bsl/exit_code.hpp>
@@ -44,20 +45,29 @@ namespace mk
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
     ///   @tparam EXT_CONCEPT defines the type of ext_t to use
     ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
     ///   @param tls the current TLS block
     ///   @param ext the extension that made the syscall
     ///   @param intrinsic the intrinsics to use
+    ///   @param trace the trace to use
     ///   @return Returns bsl::exit_success if the exception was handled,
     ///     bsl::exit_failure otherwise
     ///
-    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename INTRINSIC_CONCEPT>
+    template<
+        typename TLS_CONCEPT,
+        typename EXT_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename TRACE_CONCEPT>
     [[nodiscard]] constexpr auto
-    dispatch_esr(TLS_CONCEPT &tls, EXT_CONCEPT *const ext, INTRINSIC_CONCEPT &intrinsic) noexcept
-        -> bsl::exit_code
+    dispatch_esr(
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT *const ext,
+        INTRINSIC_CONCEPT &intrinsic,
+        TRACE_CONCEPT &trace) noexcept -> bsl::exit_code
     {
-        bsl::discard(tls);
+        trace.record(tls, intrinsic, TRACE_EVENT_ESR, bsl::to_umax(tls.esr_vector));
+
         bsl::discard(ext);
-        bsl::discard(intrinsic);
 
         return bsl::exit_failure;
     }
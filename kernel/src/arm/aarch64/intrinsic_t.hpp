@@ -82,6 +82,93 @@ namespace mk
                 return;
             }
         }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of a requested TLS register
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param reg the TLS register to get
+        ///   @return Returns the value of a requested TLS register
+        ///
+        [[nodiscard]] static constexpr auto
+        tls_reg(bsl::safe_uint64 const &reg) noexcept -> bsl::safe_uint64
+        {
+            if (bsl::is_constant_evaluated()) {
+                return {};
+            }
+
+            if (bsl::unlikely(!reg)) {
+                bsl::error() << "invalid reg: "    // --
+                             << bsl::hex(reg)      // --
+                             << bsl::endl          // --
+                             << bsl::here();       // --
+
+                return {};
+            }
+
+            return {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of a requested TLS register
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param reg the TLS register to set
+        ///   @param val the value to set the TLS register to
+        ///
+        static constexpr void
+        set_tls_reg(bsl::safe_uint64 const &reg, bsl::safe_uint64 const &val) noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            if (bsl::unlikely(!reg)) {
+                bsl::error() << "invalid reg: "    // --
+                             << bsl::hex(reg)      // --
+                             << bsl::endl          // --
+                             << bsl::here();       // --
+
+                return;
+            }
+
+            if (bsl::unlikely(!val)) {
+                bsl::error() << "invalid val: "    // --
+                             << bsl::hex(val)      // --
+                             << bsl::endl          // --
+                             << bsl::here();       // --
+
+                return;
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the TSC
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the value of the TSC
+        ///
+        [[nodiscard]] static constexpr auto
+        rdtsc() noexcept -> bsl::safe_uint64
+        {
+            if (bsl::is_constant_evaluated()) {
+                return {};
+            }
+
+            return {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Flushes all of the non-global TLB entries on the PP
+        ///     this is called from.
+        ///
+        static constexpr void
+        flush_tlb() noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+        }
     };
 }
 
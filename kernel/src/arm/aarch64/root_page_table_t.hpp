@@ -40,10 +40,12 @@
 
 #include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
 #include <bsl/finally.hpp>
 #include <bsl/fmt.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
 #include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 #include <bsl/unlikely_assert.hpp>
@@ -1018,6 +1020,8 @@ namespace mk
         ///   @param intrinsic the intrinsics to use
         ///   @param page_pool the page pool to use
         ///   @param huge_pool the huge pool to use
+        ///   @param pcid the ASID to tag this RPT's TLB entries with
+        ///     (currently unused)
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
@@ -1027,7 +1031,8 @@ namespace mk
             TLS_CONCEPT &tls,
             INTRINSIC_CONCEPT *const intrinsic,
             PAGE_POOL_CONCEPT *const page_pool,
-            HUGE_POOL_CONCEPT *const huge_pool) &noexcept -> bsl::errc_type
+            HUGE_POOL_CONCEPT *const huge_pool,
+            bsl::safe_uint16 const &pcid) &noexcept -> bsl::errc_type
         {
             if (bsl::unlikely_assert(m_initialized)) {
                 bsl::error() << "root_page_table_t already initialized\n" << bsl::here();
@@ -1056,6 +1061,8 @@ namespace mk
                 return bsl::errc_failure;
             }
 
+            bsl::discard(pcid);
+
             // m_l0t = m_page_pool->template allocate<l0t_t>(tls, ALLOCATE_TAG_PML4TS);
             // if (bsl::unlikely(nullptr == m_l0t)) {
             //     bsl::print<bsl::V>() << bsl::here();
@@ -1392,6 +1399,52 @@ namespace mk
             return bsl::errc_success;
         }
 
+        /// <!-- description -->
+        ///   @brief Maps each of the provided pages into the root page table
+        ///     being managed by this class. This is the same as calling
+        ///     map_page() for each page. Pages are mapped in order, and
+        ///     mapping stops at the first page that fails to map.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam PAGE_CONCEPT defines the type of page to map, which
+        ///     must provide a virt and phys field.
+        ///   @param tls the current TLS block
+        ///   @param pages the pages to map
+        ///   @param page_flags defines how memory should be mapped
+        ///   @param auto_release defines what auto release tag to use
+        ///   @return Returns the number of pages that were mapped. If this
+        ///     is less than pages.size(), the page at the returned index
+        ///     failed to map, and the pages after it were not mapped.
+        ///
+        template<typename TLS_CONCEPT, typename PAGE_CONCEPT>
+        [[nodiscard]] constexpr auto
+        map_pages(
+            TLS_CONCEPT &tls,
+            bsl::span<PAGE_CONCEPT> const &pages,
+            bsl::safe_uintmax const &page_flags,
+            bsl::safe_int32 const &auto_release) &noexcept -> bsl::safe_uintmax
+        {
+            bsl::safe_uintmax mapped{};
+            for (auto const elem : pages) {
+                auto const ret{this->map_page(
+                    tls,
+                    bsl::to_umax(elem.data->virt),
+                    bsl::to_umax(elem.data->phys),
+                    page_flags,
+                    auto_release)};
+
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    break;
+                }
+
+                ++mapped;
+            }
+
+            return mapped;
+        }
+
         /// <!-- descril3tion -->
         ///   @brief Maps a page into the root page table being managed
         ///     by this class. This version allows for unaligned virtual and
@@ -1430,6 +1483,219 @@ namespace mk
                 auto_release);
         }
 
+        /// <!-- description -->
+        ///   @brief Maps a 2M page into the root page table being managed
+        ///     by this class.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the 2M aligned virtual address to map the
+        ///     physical address too.
+        ///   @param page_phys the 2M aligned physical address to map.
+        ///   @param page_flags defines how memory should be mapped
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        map_2m_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_uintmax const &page_flags) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            bsl::discard(page_virt);
+            bsl::discard(page_phys);
+            bsl::discard(page_flags);
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Maps a 1G page into the root page table being managed
+        ///     by this class.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the 1G aligned virtual address to map the
+        ///     physical address too.
+        ///   @param page_phys the 1G aligned physical address to map.
+        ///   @param page_flags defines how memory should be mapped
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        map_1g_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_uintmax const &page_flags) &noexcept -> bsl::errc_type
+        {
+            return this->map_2m_page(tls, page_virt, page_phys, page_flags);
+        }
+
+        /// <!-- description -->
+        ///   @brief Copies memory from an extension into the microkernel.
+        ///     The source must be mapped into this RPT as user memory.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param dst the microkernel memory to copy to
+        ///   @param src_virt the extension's virtual address to copy from
+        ///   @param bytes the number of bytes to copy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        copy_from_user(
+            TLS_CONCEPT &tls,
+            void *const dst,
+            bsl::safe_uintmax const &src_virt,
+            bsl::safe_uintmax const &bytes) const &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            /// NOTE:
+            /// - Nothing is mapped as user memory until map_page() is
+            ///   implemented, so there is nothing to copy from yet.
+            ///
+
+            bsl::discard(dst);
+            bsl::discard(src_virt);
+            bsl::discard(bytes);
+            return bsl::errc_failure;
+        }
+
+        /// <!-- description -->
+        ///   @brief Copies memory from the microkernel into an extension.
+        ///     The destination must be mapped into this RPT as writable user
+        ///     memory.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param dst_virt the extension's virtual address to copy to
+        ///   @param src the microkernel memory to copy from
+        ///   @param bytes the number of bytes to copy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        copy_to_user(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &dst_virt,
+            void const *const src,
+            bsl::safe_uintmax const &bytes) const &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            /// NOTE:
+            /// - Nothing is mapped as user memory until map_page() is
+            ///   implemented, so there is nothing to copy to yet.
+            ///
+
+            bsl::discard(dst_virt);
+            bsl::discard(src);
+            bsl::discard(bytes);
+            return bsl::errc_failure;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided virtual address is mapped
+        ///     to the provided physical address as a 4k page using the
+        ///     provided auto release tag. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the virtual address to look up
+        ///   @param page_phys the physical address page_virt must map to
+        ///   @param auto_release the auto release tag the page must have
+        ///   @return Returns true if the provided virtual address is mapped
+        ///     to the provided physical address as a 4k page using the
+        ///     provided auto release tag. Returns false otherwise.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        is_mapped(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_int32 const &auto_release) &noexcept -> bool
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return false;
+            }
+
+            /// NOTE:
+            /// - Nothing is mapped as user memory until map_page() is
+            ///   implemented, so nothing can be mapped yet.
+            ///
+
+            bsl::discard(page_virt);
+            bsl::discard(page_phys);
+            bsl::discard(auto_release);
+            return false;
+        }
+
+        /// <!-- description -->
+        ///   @brief Unmaps a page from the root page table being managed
+        ///     by this class. The page is only unmapped if it was mapped
+        ///     using the provided auto release tag. The page itself is not
+        ///     released as that is up to the caller.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the virtual address to unmap
+        ///   @param auto_release the auto release tag the page was mapped with
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        unmap_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_int32 const &auto_release) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            bsl::discard(page_virt);
+            bsl::discard(auto_release);
+            return bsl::errc_success;
+        }
+
         /// <!-- descril3tion -->
         ///   @brief Allocates a page from the provided page pool and maps it
         ///     into the root page table being managed by this class The page
@@ -25,6 +25,7 @@
 #ifndef VPS_T_HPP
 #define VPS_T_HPP
 
+#include <exit_policy_t.hpp>
 #include <general_purpose_regs_t.hpp>
 #include <mk_interface.hpp>
 #include <vmcb_t.hpp>
@@ -35,6 +36,7 @@
 #include <bsl/errc_type.hpp>
 #include <bsl/finally.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
 #include <bsl/string_view.hpp>
 #include <bsl/unlikely.hpp>
 #include <bsl/unlikely_assert.hpp>
@@ -61,6 +63,8 @@ namespace mk
 
         /// @brief stores the general purpose registers
         general_purpose_regs_t m_gprs{};
+        /// @brief stores the exit policy of this VPS
+        exit_policy_t m_exit_policy{};
 
         /// <!-- description -->
         ///   @brief Dumps the contents of a field
@@ -190,6 +194,7 @@ namespace mk
             }
 
             m_gprs = {};
+            m_exit_policy.clear();
 
             m_assigned_ppid = syscall::BF_INVALID_ID;
             m_assigned_vpid = syscall::BF_INVALID_ID;
@@ -404,6 +409,7 @@ namespace mk
             }
 
             m_gprs = {};
+            m_exit_policy.clear();
 
             m_assigned_ppid = syscall::BF_INVALID_ID;
             m_assigned_vpid = syscall::BF_INVALID_ID;
@@ -1049,23 +1055,31 @@ namespace mk
         ///   @tparam FIELD_TYPE the type (i.e., size) of field to write
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @tparam EXT_CONCEPT defines the type of ext_t to use
         ///   @param tls the current TLS block
         ///   @param intrinsic the intrinsics to use
+        ///   @param ext the extension that made the syscall
         ///   @param index the index of the field to write to the VPS
         ///   @param val the value to write to the VPS
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
-        template<typename FIELD_TYPE, typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        template<
+            typename FIELD_TYPE,
+            typename TLS_CONCEPT,
+            typename INTRINSIC_CONCEPT,
+            typename EXT_CONCEPT>
         [[nodiscard]] constexpr auto
         write(
             TLS_CONCEPT const &tls,
             INTRINSIC_CONCEPT &intrinsic,
+            EXT_CONCEPT &ext,
             bsl::safe_uintmax const &index,
             bsl::safe_integral<FIELD_TYPE> const &val) &noexcept -> bsl::errc_type
         {
             bsl::discard(tls);
             bsl::discard(intrinsic);
+            bsl::discard(ext);
             bsl::discard(index);
             bsl::discard(val);
 
@@ -1073,6 +1087,19 @@ namespace mk
             return bsl::errc_failure;
         }
 
+        /// <!-- description -->
+        ///   @brief Tells this VPS that the extension freed the provided
+        ///     page.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param page the microkernel's virtual address of the page
+        ///
+        constexpr void
+        page_freed(void const *const page) &noexcept
+        {
+            bsl::discard(page);
+        }
+
         /// <!-- description -->
         ///   @brief Reads a field from the VPS given a bf_reg_t
         ///     defining the field to read.
@@ -1606,6 +1633,82 @@ namespace mk
             return bsl::errc_success;
         }
 
+        /// <!-- description -->
+        ///   @brief Replaces the exit policy of this VPS with the provided
+        ///     entries. See exit_policy_t for more information.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param entries the entries defining the new exit policy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        set_exit_policy(
+            TLS_CONCEPT const &tls,
+            bsl::span<syscall::bf_exit_policy_t const> const &entries) &noexcept -> bsl::errc_type
+        {
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "vps_t not initialized\n" << bsl::here();
+                return bsl::errc_precondition;
+            }
+
+            if (bsl::unlikely(m_allocated != allocated_status_t::allocated)) {
+                bsl::error() << "vps "                                             // --
+                             << bsl::hex(m_id)                                     // --
+                             << "'s status is not allocated and cannot be used"    // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::errc_precondition;
+            }
+
+            if (bsl::unlikely(tls.ppid != m_assigned_ppid)) {
+                bsl::error() << "vp "                                  // --
+                             << bsl::hex(m_id)                         // --
+                             << " is assigned to pp "                  // --
+                             << bsl::hex(m_assigned_ppid)              // --
+                             << " and cannot be operated on by pp "    // --
+                             << bsl::hex(tls.ppid)                     // --
+                             << bsl::endl                              // --
+                             << bsl::here();                           // --
+
+                return bsl::errc_precondition;
+            }
+
+            return m_exit_policy.set(entries);
+        }
+
+        /// <!-- description -->
+        ///   @brief Handles the VMExit that was just returned by run() using
+        ///     the exit policy of this VPS. VMExits are not decoded on this
+        ///     architecture yet, so the entries are stored and dumped, but
+        ///     every VMExit is given to the extension.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param exit_reason the VMExit reason returned by run()
+        ///   @return Returns true if the VMExit was handled, false otherwise
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        [[nodiscard]] constexpr auto
+        run_exit_policy(
+            TLS_CONCEPT const &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uintmax const &exit_reason) &noexcept -> bool
+        {
+            bsl::discard(tls);
+            bsl::discard(intrinsic);
+            bsl::discard(exit_reason);
+
+            return false;
+        }
+
         /// <!-- description -->
         ///   @brief Clears the VPS's internal cache. Note that this is a
         ///     hardware specific function and doesn't change the actual
@@ -1765,6 +1868,8 @@ namespace mk
             bsl::print() << bsl::ylw << "+----------------------------------------------------+";
             bsl::print() << bsl::rst << bsl::endl;
 
+            m_exit_policy.dump();
+
             // clang-format on
         }
     };
@@ -25,10 +25,7 @@
 #ifndef BSL_CSTDIO_HPP
 #define BSL_CSTDIO_HPP
 
-#include <debug_ring_write.hpp>
-#include <serial_write.hpp>
-#include <serial_write_c.hpp>
-#include <serial_write_hex.hpp>
+#include <console_write.hpp>
 
 #include <bsl/char_type.hpp>
 #include <bsl/cstr_type.hpp>
@@ -49,8 +46,7 @@ namespace bsl
             return;
         }
 
-        mk::debug_ring_write(c);
-        mk::serial_write_c(c);
+        mk::console_write(c);
     }
 
     /// <!-- description -->
@@ -66,8 +62,7 @@ namespace bsl
             return;
         }
 
-        mk::debug_ring_write(str);
-        mk::serial_write(str);
+        mk::console_write(str);
     }
 }
 
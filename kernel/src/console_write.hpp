@@ -0,0 +1,389 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef CONSOLE_WRITE_HPP
+#define CONSOLE_WRITE_HPP
+
+#include <console_line_t.hpp>
+#include <cpu_relax.hpp>
+#include <debug_ring_write.hpp>
+#include <get_current_tls.hpp>
+#include <serial_write_c.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/char_type.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/cstr_type.hpp>
+#include <bsl/is_constant_evaluated.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+#pragma clang diagnostic ignored "-Watomic-implicit-seq-cst"
+
+/// NOTE:
+/// - The console is what the microkernel uses for bsl::fputc and
+///   bsl::fputs. Instead of writing each character to the debug ring and
+///   the serial device as it is produced, each PP writes into its own
+///   line buffer, and whole lines are committed to the debug ring while
+///   holding the console lock, meaning lines from different PPs never
+///   interleave.
+/// - The serial device is drained from the debug ring without ever
+///   waiting on it. Once a PP has released the console lock, it tries
+///   to take it again, and if nobody else holds or is waiting for it,
+///   writes only as many pending characters as the serial device's
+///   transmit FIFO has room for. The VMExit loop does the same before
+///   each VM entry, so output keeps draining while no lines are being
+///   committed. Logging therefore never waits on the serial device. If
+///   the serial device falls behind, the number of characters that are
+///   pending is capped at the size of the debug ring, so the oldest
+///   characters are the ones that are lost (they are still in the debug
+///   ring). Only console_flush(), which is used right before a PP
+///   halts, waits for the serial device to catch up.
+/// - This code cannot use mk::spinlock, as mk::spinlock outputs using
+///   bsl::alert, which is implemented using this code.
+///
+
+namespace mk
+{
+    /// @brief stores the line each PP is currently writing
+    constinit inline bsl::array<console_line_t, bsl::to_umax(HYPERVISOR_MAX_PPS).get()>
+        g_console_lines{};
+
+    /// @brief stores the number of characters not yet written to the serial device
+    constinit inline bsl::safe_uintmax g_console_serial_pending{};
+
+    /// @brief stores the next ticket for the console lock
+    // We cannot initialize atomics so this is not possible
+    // NOLINTNEXTLINE(bsl-var-braced-init)
+    inline _Atomic bsl::uint32 g_console_next;
+
+    /// @brief stores the ticket that currently owns the console lock
+    // We cannot initialize atomics so this is not possible
+    // NOLINTNEXTLINE(bsl-var-braced-init)
+    inline _Atomic bsl::uint32 g_console_serving;
+
+    /// <!-- description -->
+    ///   @brief Writes a character to the debug ring and marks it as
+    ///     pending for the serial device. The number of pending characters
+    ///     is capped at what the debug ring can hold. The console lock
+    ///     must be held before calling this function.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param c the character to write
+    ///
+    constexpr void
+    console_ring_write(bsl::char_type const c) noexcept
+    {
+        debug_ring_write(c);
+
+        if (g_console_serial_pending < (g_debug_ring->buf.size() - bsl::ONE_UMAX)) {
+            ++g_console_serial_pending;
+        }
+        else {
+            bsl::touch();
+        }
+    }
+
+    /// <!-- description -->
+    ///   @brief Writes as many of the characters in the debug ring that
+    ///     have not been written to the serial device yet as the serial
+    ///     device's transmit FIFO has room for, without waiting. The
+    ///     console lock must be held before calling this function.
+    ///
+    constexpr void
+    console_drain() noexcept
+    {
+        if (bsl::is_constant_evaluated()) {
+            return;
+        }
+
+        /// NOTE:
+        /// - The characters that have not been written to the serial
+        ///   device are always the last g_console_serial_pending
+        ///   characters in the debug ring.
+        ///
+
+        auto const size{g_debug_ring->buf.size()};
+        bsl::safe_uintmax const epos{g_debug_ring->epos};
+        bsl::safe_uintmax pos{((epos + size) - g_console_serial_pending) % size};
+
+        bsl::safe_uintmax room{serial_write_room()};
+        while (g_console_serial_pending.is_pos() && room.is_pos()) {
+            serial_write_c_nowait(*g_debug_ring->buf.at_if(pos));
+            --g_console_serial_pending;
+            --room;
+
+            ++pos;
+            if (!(size > pos)) {
+                pos = {};
+            }
+            else {
+                bsl::touch();
+            }
+        }
+    }
+
+    /// <!-- description -->
+    ///   @brief Commits the characters an ESR wrote while the provided
+    ///     line was being committed. The console lock must be held before
+    ///     calling this function.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param line the line whose ESR characters should be committed
+    ///
+    constexpr void
+    console_commit_esr(console_line_t &line) noexcept
+    {
+        /// NOTE:
+        /// - esr_buf is only ever written by an ESR on the same PP, which
+        ///   can fire at any time while this loop runs. The length is only
+        ///   reset if it did not change since it was last read, otherwise
+        ///   the new characters are committed as well.
+        ///
+
+        bsl::uint64 done{};
+        while (true) {
+            bsl::uint64 len{__atomic_load_n(&line.esr_len, __ATOMIC_ACQUIRE)};
+            for (; done < len; ++done) {
+                console_ring_write(*line.esr_buf.at_if(bsl::to_umax(done)));
+            }
+
+            if (__atomic_compare_exchange_n(
+                    &line.esr_len, &len, 0U, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+
+            bsl::touch();
+        }
+    }
+
+    /// <!-- description -->
+    ///   @brief Writes the partial line of every PP and everything in the
+    ///     debug ring that has not been written to the serial device yet,
+    ///     waiting on the serial device as needed. This does not take the
+    ///     console lock (the PP that holds it might be the one that is
+    ///     halting), and should only be used right before a PP halts.
+    ///
+    constexpr void
+    console_flush() noexcept
+    {
+        if (bsl::is_constant_evaluated()) {
+            return;
+        }
+
+        for (auto const elem : g_console_lines) {
+            for (bsl::safe_uintmax i{}; i < elem.data->len; ++i) {
+                console_ring_write(*elem.data->buf.at_if(i));
+            }
+
+            elem.data->len = {};
+            console_commit_esr(*elem.data);
+        }
+
+        while (g_console_serial_pending.is_pos()) {
+            console_drain();
+            cpu_relax();
+        }
+    }
+
+    /// <!-- description -->
+    ///   @brief Commits a line to the debug ring.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param line the line to commit
+    ///
+    constexpr void
+    console_commit(console_line_t &line) noexcept
+    {
+        if (bsl::is_constant_evaluated()) {
+            return;
+        }
+
+        bsl::uint32 const ticket{__c11_atomic_fetch_add(&g_console_next, 1U, __ATOMIC_RELAXED)};
+        while (__c11_atomic_load(&g_console_serving, __ATOMIC_ACQUIRE) != ticket) {
+            cpu_relax();
+        }
+
+        for (bsl::safe_uintmax i{}; i < line.len; ++i) {
+            console_ring_write(*line.buf.at_if(i));
+        }
+
+        line.len = {};
+        console_commit_esr(line);
+
+        bsl::uint32 const next{__c11_atomic_load(&g_console_serving, __ATOMIC_RELAXED) + 1U};
+        __c11_atomic_store(&g_console_serving, next, __ATOMIC_RELEASE);
+    }
+
+    /// <!-- description -->
+    ///   @brief Takes the console lock if nobody else holds or is waiting
+    ///     for it, drains what the serial device has room for, and then
+    ///     releases the console lock. The provided line must already be
+    ///     marked as busy.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param line the line of the current PP
+    ///
+    constexpr void
+    console_try_drain(console_line_t &line) noexcept
+    {
+        if (bsl::is_constant_evaluated()) {
+            return;
+        }
+
+        /// NOTE:
+        /// - If another PP holds or is waiting for the console lock,
+        ///   g_console_next is ahead of g_console_serving and the lock
+        ///   is not taken. That PP will try to drain once it is done.
+        ///
+
+        bsl::uint32 ticket{__c11_atomic_load(&g_console_serving, __ATOMIC_RELAXED)};
+        if (!__c11_atomic_compare_exchange_strong(
+                &g_console_next, &ticket, ticket + 1U, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return;
+        }
+
+        console_drain();
+        console_commit_esr(line);
+
+        __c11_atomic_store(&g_console_serving, ticket + 1U, __ATOMIC_RELEASE);
+    }
+
+    /// <!-- description -->
+    ///   @brief Drains what the serial device has room for without
+    ///     waiting. This is called by the VMExit loop so that output
+    ///     that is still pending is written out even if no new lines
+    ///     are committed.
+    ///
+    constexpr void
+    console_poll() noexcept
+    {
+        if (bsl::is_constant_evaluated()) {
+            return;
+        }
+
+        /// NOTE:
+        /// - g_console_serial_pending is read without the console lock.
+        ///   This is only a hint that keeps PPs from bouncing the lock
+        ///   between them when there is nothing to drain. Missing a
+        ///   character here only means it is drained on the next call.
+        ///
+
+        if (g_console_serial_pending.is_zero()) {
+            return;
+        }
+
+        auto *const line{g_console_lines.at_if(bsl::to_umax(get_current_tls()->ppid))};
+        if (bsl::unlikely(nullptr == line)) {
+            return;
+        }
+
+        if (line->busy) {
+            return;
+        }
+
+        line->busy = true;
+        console_try_drain(*line);
+        line->busy = false;
+    }
+
+    /// <!-- description -->
+    ///   @brief Outputs a character to the console.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param c the character to output
+    ///
+    constexpr void
+    console_write(bsl::char_type const c) noexcept
+    {
+        if (bsl::is_constant_evaluated()) {
+            return;
+        }
+
+        auto *const line{g_console_lines.at_if(bsl::to_umax(get_current_tls()->ppid))};
+        if (bsl::unlikely(nullptr == line)) {
+            debug_ring_write(c);
+            return;
+        }
+
+        /// NOTE:
+        /// - If this PP is already committing a line, we are in an ESR
+        ///   (e.g., an NMI) that fired while this PP was waiting for, or
+        ///   holding, the console lock. Taking the lock again would
+        ///   deadlock, and the line buffer is in use, so the character
+        ///   is stored in esr_buf, which the interrupted commit writes to
+        ///   the debug ring before it releases the lock. If esr_buf is
+        ///   full, the character is dropped.
+        ///
+
+        if (bsl::unlikely(line->busy)) {
+            bsl::uint64 const len{__atomic_load_n(&line->esr_len, __ATOMIC_RELAXED)};
+            auto *const esr_c{line->esr_buf.at_if(bsl::to_umax(len))};
+            if (nullptr != esr_c) {
+                *esr_c = c;
+                __atomic_store_n(&line->esr_len, len + 1U, __ATOMIC_RELEASE);
+            }
+            else {
+                bsl::touch();
+            }
+
+            return;
+        }
+
+        *line->buf.at_if(line->len) = c;
+        ++line->len;
+
+        if (('\n' == c) || !(line->buf.size() > line->len)) {
+            line->busy = true;
+            console_commit(*line);
+            console_try_drain(*line);
+            line->busy = false;
+        }
+        else {
+            bsl::touch();
+        }
+    }
+
+    /// <!-- description -->
+    ///   @brief Outputs a string to the console.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param str the string to output
+    ///
+    constexpr void
+    console_write(bsl::cstr_type const str) noexcept
+    {
+        if (bsl::is_constant_evaluated()) {
+            return;
+        }
+
+        for (bsl::safe_uintmax i{}; str[i.get()] != '\0'; ++i) {
+            console_write(str[i.get()]);
+        }
+    }
+}
+
+#endif
@@ -55,6 +55,7 @@ namespace mk
 
         bsl::safe_uintmax epos{g_debug_ring->epos};
         bsl::safe_uintmax spos{g_debug_ring->spos};
+        bsl::safe_uintmax seq{g_debug_ring->seq};
 
         if (!(g_debug_ring->buf.size() > epos)) {
             epos = {};
@@ -87,8 +88,18 @@ namespace mk
             bsl::touch();
         }
 
+        ++seq;
+
         g_debug_ring->epos = epos.get();
         g_debug_ring->spos = spos.get();
+
+        /// NOTE:
+        /// - seq is published with release semantics so that a reader that
+        ///   has the debug ring mapped into userspace (e.g., vmmctl dump
+        ///   --follow) is guaranteed to see the characters that it covers.
+        ///
+
+        __atomic_store_n(&g_debug_ring->seq, seq.get(), __ATOMIC_RELEASE);
     }
 
     /// <!-- description -->
@@ -57,6 +57,8 @@ namespace mk
     ///   @tparam VP_POOL_CONCEPT defines the type of VP pool to use
     ///   @tparam VM_POOL_CONCEPT defines the type of VM pool to use
     ///   @tparam VMEXIT_LOG_CONCEPT defines the type of VMExit log to use
+    ///   @tparam VMEXIT_STATS_CONCEPT defines the type of VMExit stats to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
     ///   @param tls the current TLS block
     ///   @param ext_pool the extension pool to use
     ///   @param ext the extension that made the syscall
@@ -67,6 +69,8 @@ namespace mk
     ///   @param vp_pool the VP pool to use
     ///   @param vm_pool the VM pool to use
     ///   @param log the VMExit log to use
+    ///   @param stats the VMExit stats to use
+    ///   @param trace the trace to use
     ///   @return Returns bsl::exit_success on success, bsl::exit_failure
     ///     otherwise
     ///
@@ -80,7 +84,9 @@ namespace mk
         typename VPS_POOL_CONCEPT,
         typename VP_POOL_CONCEPT,
         typename VM_POOL_CONCEPT,
-        typename VMEXIT_LOG_CONCEPT>
+        typename VMEXIT_LOG_CONCEPT,
+        typename VMEXIT_STATS_CONCEPT,
+        typename TRACE_CONCEPT>
     [[nodiscard]] constexpr auto
     dispatch_syscall(
         TLS_CONCEPT &tls,
@@ -92,13 +98,15 @@ namespace mk
         VPS_POOL_CONCEPT &vps_pool,
         VP_POOL_CONCEPT &vp_pool,
         VM_POOL_CONCEPT &vm_pool,
-        VMEXIT_LOG_CONCEPT &log) noexcept -> bsl::exit_code
+        VMEXIT_LOG_CONCEPT &log,
+        VMEXIT_STATS_CONCEPT &stats,
+        TRACE_CONCEPT &trace) noexcept -> bsl::exit_code
     {
         bsl::errc_type ret{};
 
         switch (syscall::bf_syscall_opcode(tls.ext_syscall).get()) {
             case syscall::BF_CONTROL_OP_VAL.get(): {
-                ret = dispatch_syscall_control_op(tls, ext);
+                ret = dispatch_syscall_control_op(tls, ext, trace);
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return bsl::exit_failure;
@@ -127,7 +135,9 @@ namespace mk
                     vps_pool,
                     vp_pool,
                     vm_pool,
-                    log);
+                    log,
+                    stats,
+                    trace);
 
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
@@ -189,7 +199,7 @@ namespace mk
             }
 
             case syscall::BF_MEM_OP_VAL.get(): {
-                ret = dispatch_syscall_mem_op(tls, ext);
+                ret = dispatch_syscall_mem_op(tls, ext, vps_pool);
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return bsl::exit_failure;
@@ -39,14 +39,17 @@ namespace mk
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
     ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
     ///   @param tls the current TLS block
     ///   @param ext the extension that made the syscall
+    ///   @param trace the trace to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     otherwise
     ///
-    template<typename TLS_CONCEPT, typename EXT_CONCEPT>
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename TRACE_CONCEPT>
     [[nodiscard]] constexpr auto
-    dispatch_syscall_control_op(TLS_CONCEPT &tls, EXT_CONCEPT &ext) noexcept -> bsl::errc_type
+    dispatch_syscall_control_op(TLS_CONCEPT &tls, EXT_CONCEPT &ext, TRACE_CONCEPT &trace) noexcept
+        -> bsl::errc_type
     {
         switch (syscall::bf_syscall_index(tls.ext_syscall).get()) {
             case syscall::BF_CONTROL_OP_EXIT_IDX_VAL.get(): {
@@ -68,6 +71,13 @@ namespace mk
                 return bsl::errc_success;
             }
 
+            case syscall::BF_CONTROL_OP_TRACE_IDX_VAL.get(): {
+                trace.enable(!bsl::to_umax(tls.ext_reg0).is_zero());
+
+                tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+                return bsl::errc_success;
+            }
+
             default: {
                 break;
             }
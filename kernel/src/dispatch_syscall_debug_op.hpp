@@ -28,8 +28,11 @@
 #include <mk_interface.hpp>
 
 #include <bsl/char_type.hpp>
+#include <bsl/convert.hpp>
 #include <bsl/cstr_type.hpp>
 #include <bsl/debug.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 
 namespace mk
@@ -47,6 +50,8 @@ namespace mk
     ///   @tparam VP_POOL_CONCEPT defines the type of VP pool to use
     ///   @tparam VM_POOL_CONCEPT defines the type of VM pool to use
     ///   @tparam VMEXIT_LOG_CONCEPT defines the type of VMExit log to use
+    ///   @tparam VMEXIT_STATS_CONCEPT defines the type of VMExit stats to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
     ///   @param tls the current TLS block
     ///   @param ext_pool the extension pool to use
     ///   @param intrinsic the intrinsics to use
@@ -56,6 +61,8 @@ namespace mk
     ///   @param vp_pool the VP pool to use
     ///   @param vm_pool the VM pool to use
     ///   @param log the VMExit log to use
+    ///   @param stats the VMExit stats to use
+    ///   @param trace the trace to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     otherwise
     ///
@@ -68,7 +75,9 @@ namespace mk
         typename VPS_POOL_CONCEPT,
         typename VP_POOL_CONCEPT,
         typename VM_POOL_CONCEPT,
-        typename VMEXIT_LOG_CONCEPT>
+        typename VMEXIT_LOG_CONCEPT,
+        typename VMEXIT_STATS_CONCEPT,
+        typename TRACE_CONCEPT>
     [[nodiscard]] constexpr auto
     dispatch_syscall_debug_op(
         TLS_CONCEPT &tls,
@@ -79,7 +88,9 @@ namespace mk
         VPS_POOL_CONCEPT &vps_pool,
         VP_POOL_CONCEPT &vp_pool,
         VM_POOL_CONCEPT &vm_pool,
-        VMEXIT_LOG_CONCEPT &log) noexcept -> bsl::errc_type
+        VMEXIT_LOG_CONCEPT &log,
+        VMEXIT_STATS_CONCEPT &stats,
+        TRACE_CONCEPT &trace) noexcept -> bsl::errc_type
     {
         switch (syscall::bf_syscall_index(tls.ext_syscall).get()) {
             case syscall::BF_DEBUG_OP_OUT_IDX_VAL.get(): {
@@ -166,6 +177,64 @@ namespace mk
                 return bsl::errc_success;
             }
 
+            case syscall::BF_DEBUG_OP_DUMP_VMEXIT_STATS_IDX_VAL.get(): {
+                stats.dump(bsl::to_u16_unsafe(tls.ext_reg0));
+
+                tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+                return bsl::errc_success;
+            }
+
+            case syscall::BF_DEBUG_OP_DUMP_TRACE_IDX_VAL.get(): {
+                trace.dump(bsl::to_u16_unsafe(tls.ext_reg0));
+
+                tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+                return bsl::errc_success;
+            }
+
+            case syscall::BF_DEBUG_OP_FLUSH_LOG_IDX_VAL.get(): {
+                constexpr auto bytes_per_reg{bsl::to_umax(sizeof(bsl::uint64))};
+                constexpr auto bits_per_char{bsl::to_u64(8U)};
+                constexpr auto char_mask{bsl::to_u64(0xFFU)};
+
+                /// NOTE:
+                /// - The log buffer lives in the extension's TLS block for
+                ///   this PP, which the extension fills in without making
+                ///   a syscall.
+                /// - The buffer is only ever read using tls_reg(), which
+                ///   reads relative to the extension's TLS block, at
+                ///   offsets that are bounded by the compile-time size of
+                ///   the buffer. The length is provided by the extension,
+                ///   so it is clamped to that size before it is used. The
+                ///   address of the TLS block stored in the TLS block
+                ///   itself is never used, as the extension can change it.
+                ///
+
+                bsl::safe_uintmax len{intrinsic.tls_reg(syscall::TLS_OFFSET_LOG_LEN)};
+                if (bsl::unlikely(len > syscall::TLS_LOG_BUF_SIZE)) {
+                    len = syscall::TLS_LOG_BUF_SIZE;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                for (bsl::safe_uintmax i{}; i < len; i += bytes_per_reg) {
+                    auto word{intrinsic.tls_reg(syscall::TLS_OFFSET_LOG_BUF + i)};
+                    for (bsl::safe_uintmax j{}; j < bytes_per_reg; ++j) {
+                        if (i + j >= len) {
+                            break;
+                        }
+
+                        bsl::print() << static_cast<bsl::char_type>((word & char_mask).get());
+                        word >>= bits_per_char;
+                    }
+                }
+
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_LOG_LEN, bsl::ZERO_U64);
+
+                tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+                return bsl::errc_success;
+            }
+
             default: {
                 break;
             }
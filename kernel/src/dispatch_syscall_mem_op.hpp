@@ -27,9 +27,13 @@
 
 #include <mk_interface.hpp>
 
+#include <bsl/array.hpp>
 #include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 
 namespace mk
@@ -76,16 +80,19 @@ namespace mk
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
     ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @param tls the current TLS block
     ///   @param ext the extension that made the syscall
+    ///   @param vps_pool the VPS pool to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     otherwise
     ///
-    template<typename TLS_CONCEPT, typename EXT_CONCEPT>
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename VPS_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
-    syscall_mem_op_free_page(TLS_CONCEPT &tls, EXT_CONCEPT &ext) noexcept -> bsl::errc_type
+    syscall_mem_op_free_page(
+        TLS_CONCEPT &tls, EXT_CONCEPT &ext, VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
-        auto const ret{ext.free_page(bsl::to_umax(tls.ext_reg1))};
+        auto const ret{ext.free_page(tls, vps_pool, bsl::to_umax(tls.ext_reg1))};
         if (bsl::unlikely(!ret)) {
             bsl::print<bsl::V>() << bsl::here();
             return ret;
@@ -138,7 +145,7 @@ namespace mk
     [[nodiscard]] constexpr auto
     syscall_mem_op_free_huge(TLS_CONCEPT &tls, EXT_CONCEPT &ext) noexcept -> bsl::errc_type
     {
-        auto const ret{ext.free_huge(bsl::to_umax(tls.ext_reg1))};
+        auto const ret{ext.free_huge(tls, bsl::to_umax(tls.ext_reg1))};
         if (bsl::unlikely(!ret)) {
             bsl::print<bsl::V>() << bsl::here();
             return ret;
@@ -176,7 +183,135 @@ namespace mk
     }
 
     /// <!-- description -->
-    ///   @brief Dispatches the bf_mem_op syscalls
+    ///   @brief Implements the bf_mem_op_alloc_pages syscall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
+    ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
+    ///   @param vps_pool the VPS pool to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename VPS_POOL_CONCEPT>
+    [[nodiscard]] constexpr auto
+    syscall_mem_op_alloc_pages(
+        TLS_CONCEPT &tls, EXT_CONCEPT &ext, VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
+    {
+        constexpr auto page_size{bsl::to_umax(HYPERVISOR_PAGE_SIZE)};
+
+        bsl::safe_uintmax const addr{tls.ext_reg1};
+        bsl::safe_uintmax const num{tls.ext_reg2};
+
+        if (bsl::unlikely(addr.is_zero())) {
+            bsl::error() << "the page array cannot be a nullptr\n" << bsl::here();
+            return bsl::errc_failure;
+        }
+
+        if (bsl::unlikely(num.is_zero())) {
+            bsl::error() << "the number of pages cannot be 0\n" << bsl::here();
+            return bsl::errc_failure;
+        }
+
+        if (bsl::unlikely(num > syscall::BF_MEM_OP_ALLOC_PAGES_MAX)) {
+            bsl::error() << "the number of pages "                          // --
+                         << bsl::hex(num)                                   // --
+                         << " is larger than the max "                      // --
+                         << bsl::hex(syscall::BF_MEM_OP_ALLOC_PAGES_MAX)    // --
+                         << bsl::endl                                       // --
+                         << bsl::here();                                    // --
+
+            return bsl::errc_failure;
+        }
+
+        auto const bytes_into_page{addr & (page_size - bsl::ONE_UMAX)};
+        auto const bytes{num * bsl::to_umax(sizeof(syscall::bf_page_t))};
+        if (bsl::unlikely(bytes_into_page + bytes > page_size)) {
+            bsl::error() << "the page array at "          // --
+                         << bsl::hex(addr)                // --
+                         << " crosses a page boundary"    // --
+                         << bsl::endl                     // --
+                         << bsl::here();                  // --
+
+            return bsl::errc_failure;
+        }
+
+        /// NOTE:
+        /// - The extension's array is never accessed in place, as another
+        ///   PP in the same extension could change it while the pages are
+        ///   being mapped. The pages are allocated into a small microkernel
+        ///   array, one batch at a time, and each batch is copied out as
+        ///   soon as it is filled. This keeps the syscall's stack usage
+        ///   small no matter how many pages are requested.
+        /// - The whole array is zeroed first. This checks that the
+        ///   extension's array is writable before anything is allocated,
+        ///   and sets the entries that end up not being allocated to 0.
+        /// - If copying a batch out fails anyway (e.g., another PP freed
+        ///   the page the array is in), that batch's pages are freed
+        ///   again, as the extension has no way of knowing about them.
+        ///
+
+        constexpr auto batch_size{bsl::to_umax(32U)};
+        constexpr auto desc_size{bsl::to_umax(sizeof(syscall::bf_page_t))};
+        bsl::array<syscall::bf_page_t, batch_size.get()> batch{};
+
+        for (bsl::safe_uintmax i{}; i < num; i += batch_size) {
+            auto count{num - i};
+            if (count > batch_size) {
+                count = batch_size;
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::span<syscall::bf_page_t> const descs{batch.data(), count};
+
+            if (bsl::unlikely(!ext.copy_to_user(tls, addr + (i * desc_size), descs))) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+        }
+
+        for (bsl::safe_uintmax i{}; i < num; i += batch_size) {
+            auto count{num - i};
+            if (count > batch_size) {
+                count = batch_size;
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::span<syscall::bf_page_t> const descs{batch.data(), count};
+
+            auto const ret{ext.alloc_pages(tls, descs)};
+            if (bsl::unlikely(!ext.copy_to_user(tls, addr + (i * desc_size), descs))) {
+                bsl::print<bsl::V>() << bsl::here();
+
+                for (auto const elem : descs) {
+                    if (bsl::to_umax(elem.data->phys).is_zero()) {
+                        break;
+                    }
+
+                    bsl::discard(ext.free_page(tls, vps_pool, bsl::to_umax(elem.data->virt)));
+                }
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+        }
+
+        tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+        return bsl::errc_success;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the bf_mem_op_donate_pages syscall
     ///
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
@@ -188,7 +323,64 @@ namespace mk
     ///
     template<typename TLS_CONCEPT, typename EXT_CONCEPT>
     [[nodiscard]] constexpr auto
-    dispatch_syscall_mem_op(TLS_CONCEPT &tls, EXT_CONCEPT &ext) noexcept -> bsl::errc_type
+    syscall_mem_op_donate_pages(TLS_CONCEPT &tls, EXT_CONCEPT &ext) noexcept -> bsl::errc_type
+    {
+        bsl::safe_uintmax const list_phys{tls.ext_reg1};
+        auto const node{bsl::to_u16_unsafe(tls.ext_reg2)};
+
+        if (bsl::unlikely(list_phys.is_zero())) {
+            bsl::error() << "the list of donated pages cannot be a nullptr\n" << bsl::here();
+            return bsl::errc_failure;
+        }
+
+        auto const ret{ext.donate_pages(tls, list_phys, node)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            return ret;
+        }
+
+        tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+        return bsl::errc_success;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the bf_mem_op_page_pool_low syscall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT>
+    [[nodiscard]] constexpr auto
+    syscall_mem_op_page_pool_low(TLS_CONCEPT &tls, EXT_CONCEPT &ext) noexcept -> bsl::errc_type
+    {
+        tls.ext_reg0 = bsl::to_umax(ext.page_pool_low(tls)).get();
+
+        tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+        return bsl::errc_success;
+    }
+
+    /// <!-- description -->
+    ///   @brief Dispatches the bf_mem_op syscalls
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
+    ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
+    ///   @param vps_pool the VPS pool to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename VPS_POOL_CONCEPT>
+    [[nodiscard]] constexpr auto
+    dispatch_syscall_mem_op(
+        TLS_CONCEPT &tls, EXT_CONCEPT &ext, VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
         bsl::errc_type ret{};
 
@@ -214,7 +406,7 @@ namespace mk
             }
 
             case syscall::BF_MEM_OP_FREE_PAGE_IDX_VAL.get(): {
-                ret = syscall_mem_op_free_page(tls, ext);
+                ret = syscall_mem_op_free_page(tls, ext, vps_pool);
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -253,6 +445,36 @@ namespace mk
                 return ret;
             }
 
+            case syscall::BF_MEM_OP_ALLOC_PAGES_IDX_VAL.get(): {
+                ret = syscall_mem_op_alloc_pages(tls, ext, vps_pool);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case syscall::BF_MEM_OP_DONATE_PAGES_IDX_VAL.get(): {
+                ret = syscall_mem_op_donate_pages(tls, ext);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case syscall::BF_MEM_OP_PAGE_POOL_LOW_IDX_VAL.get(): {
+                ret = syscall_mem_op_page_pool_low(tls, ext);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
             default: {
                 break;
             }
@@ -26,6 +26,7 @@
 #include <global_resources.hpp>
 #include <mk_interface.hpp>
 #include <tls_t.hpp>
+#include <trace_event.hpp>
 
 #include <bsl/exit_code.hpp>
 
@@ -51,7 +52,9 @@ namespace mk
     {
         auto *const ext{static_cast<mk_ext_type *>(tls->ext)};
 
-        return dispatch_syscall(
+        g_trace.record(*tls, g_intrinsic, TRACE_EVENT_SYSCALL, bsl::to_umax(tls->ext_syscall));
+
+        auto const ret{dispatch_syscall(
             *tls,
             g_ext_pool,
             *ext,
@@ -61,6 +64,13 @@ namespace mk
             g_vps_pool,
             g_vp_pool,
             g_vm_pool,
-            g_vmexit_log);
+            g_vmexit_log,
+            g_vmexit_stats,
+            g_trace)};
+
+        g_trace.record(
+            *tls, g_intrinsic, TRACE_EVENT_SYSCALL_DONE, bsl::to_umax(tls->syscall_ret_status));
+
+        return ret;
     }
 }
@@ -29,10 +29,13 @@
 #include <promote.hpp>
 #include <return_to_mk.hpp>
 
+#include <bsl/array.hpp>
 #include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/finally.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 
 namespace mk
@@ -288,23 +291,32 @@ namespace mk
     ///
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
     ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
     ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
     ///   @param intrinsic the intrinsics to use
     ///   @param vps_pool the VPS pool to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     otherwise
     ///
-    template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT, typename VPS_POOL_CONCEPT>
+    template<
+        typename TLS_CONCEPT,
+        typename EXT_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename VPS_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
     syscall_vps_op_write8(
-        TLS_CONCEPT &tls, INTRINSIC_CONCEPT &intrinsic, VPS_POOL_CONCEPT &vps_pool) noexcept
-        -> bsl::errc_type
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT &ext,
+        INTRINSIC_CONCEPT &intrinsic,
+        VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
         auto const ret{vps_pool.template write<bsl::uint8>(
             tls,
             intrinsic,
+            ext,
             bsl::to_u16_unsafe(tls.ext_reg1),
             tls.ext_reg2,
             bsl::to_u8_unsafe(tls.ext_reg3))};
@@ -323,23 +335,32 @@ namespace mk
     ///
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
     ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
     ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
     ///   @param intrinsic the intrinsics to use
     ///   @param vps_pool the VPS pool to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     otherwise
     ///
-    template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT, typename VPS_POOL_CONCEPT>
+    template<
+        typename TLS_CONCEPT,
+        typename EXT_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename VPS_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
     syscall_vps_op_write16(
-        TLS_CONCEPT &tls, INTRINSIC_CONCEPT &intrinsic, VPS_POOL_CONCEPT &vps_pool) noexcept
-        -> bsl::errc_type
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT &ext,
+        INTRINSIC_CONCEPT &intrinsic,
+        VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
         auto const ret{vps_pool.template write<bsl::uint16>(
             tls,
             intrinsic,
+            ext,
             bsl::to_u16_unsafe(tls.ext_reg1),
             tls.ext_reg2,
             bsl::to_u16_unsafe(tls.ext_reg3))};
@@ -358,23 +379,32 @@ namespace mk
     ///
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
     ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
     ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
     ///   @param intrinsic the intrinsics to use
     ///   @param vps_pool the VPS pool to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     otherwise
     ///
-    template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT, typename VPS_POOL_CONCEPT>
+    template<
+        typename TLS_CONCEPT,
+        typename EXT_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename VPS_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
     syscall_vps_op_write32(
-        TLS_CONCEPT &tls, INTRINSIC_CONCEPT &intrinsic, VPS_POOL_CONCEPT &vps_pool) noexcept
-        -> bsl::errc_type
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT &ext,
+        INTRINSIC_CONCEPT &intrinsic,
+        VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
         auto const ret{vps_pool.template write<bsl::uint32>(
             tls,
             intrinsic,
+            ext,
             bsl::to_u16_unsafe(tls.ext_reg1),
             tls.ext_reg2,
             bsl::to_u32_unsafe(tls.ext_reg3))};
@@ -393,22 +423,30 @@ namespace mk
     ///
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
     ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
     ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
     ///   @param intrinsic the intrinsics to use
     ///   @param vps_pool the VPS pool to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     otherwise
     ///
-    template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT, typename VPS_POOL_CONCEPT>
+    template<
+        typename TLS_CONCEPT,
+        typename EXT_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename VPS_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
     syscall_vps_op_write64(
-        TLS_CONCEPT &tls, INTRINSIC_CONCEPT &intrinsic, VPS_POOL_CONCEPT &vps_pool) noexcept
-        -> bsl::errc_type
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT &ext,
+        INTRINSIC_CONCEPT &intrinsic,
+        VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
         auto const ret{vps_pool.template write<bsl::uint64>(
-            tls, intrinsic, bsl::to_u16_unsafe(tls.ext_reg1), tls.ext_reg2, tls.ext_reg3)};
+            tls, intrinsic, ext, bsl::to_u16_unsafe(tls.ext_reg1), tls.ext_reg2, tls.ext_reg3)};
 
         if (bsl::unlikely(!ret)) {
             bsl::print<bsl::V>() << bsl::here();
@@ -490,6 +528,369 @@ namespace mk
         return bsl::errc_success;
     }
 
+    /// @brief defines the number of VPS batch descriptors handled at a time
+    constexpr auto VPS_BATCH_SIZE{bsl::to_umax(32U)};
+    /// @brief defines the microkernel copy of part of a VPS batch
+    using vps_batch_t = bsl::array<syscall::bf_vps_batch_t, VPS_BATCH_SIZE.get()>;
+
+    /// <!-- description -->
+    ///   @brief Returns true if the descriptor array provided to
+    ///     bf_vps_op_read_batch or bf_vps_op_write_batch is valid.
+    ///     Returns false otherwise.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @param tls the current TLS block
+    ///   @return Returns true if the descriptor array provided to
+    ///     bf_vps_op_read_batch or bf_vps_op_write_batch is valid.
+    ///     Returns false otherwise.
+    ///
+    template<typename TLS_CONCEPT>
+    [[nodiscard]] constexpr auto
+    is_vps_batch_valid(TLS_CONCEPT const &tls) noexcept -> bool
+    {
+        constexpr auto page_size{bsl::to_umax(HYPERVISOR_PAGE_SIZE)};
+
+        bsl::safe_uintmax const addr{tls.ext_reg2};
+        bsl::safe_uintmax const num{tls.ext_reg3};
+
+        if (bsl::unlikely(addr.is_zero())) {
+            bsl::error() << "the batch descriptors cannot be a nullptr\n" << bsl::here();
+            return false;
+        }
+
+        if (bsl::unlikely(num.is_zero())) {
+            bsl::error() << "the number of batch descriptors cannot be 0\n" << bsl::here();
+            return false;
+        }
+
+        if (bsl::unlikely(num > syscall::BF_VPS_BATCH_MAX)) {
+            bsl::error() << "the number of batch descriptors "     // --
+                         << bsl::hex(num)                          // --
+                         << " is larger than the max "             // --
+                         << bsl::hex(syscall::BF_VPS_BATCH_MAX)    // --
+                         << bsl::endl                              // --
+                         << bsl::here();                           // --
+
+            return false;
+        }
+
+        auto const bytes_into_page{addr & (page_size - bsl::ONE_UMAX)};
+        auto const bytes{num * bsl::to_umax(sizeof(syscall::bf_vps_batch_t))};
+        if (bsl::unlikely(bytes_into_page + bytes > page_size)) {
+            bsl::error() << "the batch descriptors at "    // --
+                         << bsl::hex(addr)                 // --
+                         << " cross a page boundary"       // --
+                         << bsl::endl                      // --
+                         << bsl::here();                   // --
+
+            return false;
+        }
+
+        return true;
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the address of the descriptor at the provided
+    ///     index in the array provided to bf_vps_op_read_batch or
+    ///     bf_vps_op_write_batch. The array must have already been
+    ///     validated using is_vps_batch_valid.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @param tls the current TLS block
+    ///   @param first the index of the descriptor to get the address of
+    ///   @return Returns the address of the descriptor at the provided
+    ///     index in the array provided to bf_vps_op_read_batch or
+    ///     bf_vps_op_write_batch.
+    ///
+    template<typename TLS_CONCEPT>
+    [[nodiscard]] constexpr auto
+    vps_batch_addr(TLS_CONCEPT const &tls, bsl::safe_uintmax const &first) noexcept
+        -> bsl::safe_uintmax
+    {
+        constexpr auto desc_size{bsl::to_umax(sizeof(syscall::bf_vps_batch_t))};
+        return bsl::to_umax(tls.ext_reg2) + (first * desc_size);
+    }
+
+    /// <!-- description -->
+    ///   @brief Copies the next VPS_BATCH_SIZE (or fewer) descriptors,
+    ///     starting at the provided index, from the array provided to
+    ///     bf_vps_op_read_batch or bf_vps_op_write_batch into the
+    ///     provided microkernel array. The array must have already been
+    ///     validated using is_vps_batch_valid. If the copy fails, an empty
+    ///     span is returned.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
+    ///   @param first the index of the first descriptor to copy
+    ///   @param batch the microkernel array to copy the descriptors to
+    ///   @return Returns the descriptors that were copied into batch, or
+    ///     an empty span if the copy failed.
+    ///
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT>
+    [[nodiscard]] constexpr auto
+    get_vps_batch(
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT const &ext,
+        bsl::safe_uintmax const &first,
+        vps_batch_t &batch) noexcept -> bsl::span<syscall::bf_vps_batch_t>
+    {
+        auto count{bsl::to_umax(tls.ext_reg3) - first};
+        if (count > VPS_BATCH_SIZE) {
+            count = VPS_BATCH_SIZE;
+        }
+        else {
+            bsl::touch();
+        }
+
+        /// NOTE:
+        /// - The address comes from the extension, so the descriptors are
+        ///   never accessed in place. They are copied into the microkernel
+        ///   (which also checks that the address is the extension's own
+        ///   memory), processed there, and copied back by the caller if
+        ///   needed.
+        /// - Only VPS_BATCH_SIZE descriptors are copied at a time so that
+        ///   the microkernel's copy stays small enough for the stack.
+        ///
+
+        bsl::span<syscall::bf_vps_batch_t> const descs{batch.data(), count};
+        if (bsl::unlikely(!ext.copy_from_user(tls, descs, vps_batch_addr(tls, first)))) {
+            bsl::print<bsl::V>() << bsl::here();
+            return {};
+        }
+
+        return descs;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the bf_vps_op_read_batch syscall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+    ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
+    ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
+    ///   @param intrinsic the intrinsics to use
+    ///   @param vps_pool the VPS pool to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    template<
+        typename TLS_CONCEPT,
+        typename EXT_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename VPS_POOL_CONCEPT>
+    [[nodiscard]] constexpr auto
+    syscall_vps_op_read_batch(
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT const &ext,
+        INTRINSIC_CONCEPT &intrinsic,
+        VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
+    {
+        if (bsl::unlikely(!is_vps_batch_valid(tls))) {
+            bsl::print<bsl::V>() << bsl::here();
+            tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS2.get();
+            return bsl::errc_failure;
+        }
+
+        vps_batch_t batch{};
+        bsl::safe_uintmax const num{tls.ext_reg3};
+
+        for (bsl::safe_uintmax i{}; i < num; i += VPS_BATCH_SIZE) {
+            auto const descs{get_vps_batch(tls, ext, i, batch)};
+            if (bsl::unlikely(descs.empty())) {
+                bsl::print<bsl::V>() << bsl::here();
+                tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS2.get();
+                return bsl::errc_failure;
+            }
+
+            auto const ret{
+                vps_pool.read_batch(tls, intrinsic, bsl::to_u16_unsafe(tls.ext_reg1), descs)};
+
+            /// NOTE:
+            /// - The results are copied back even if an entry failed, as
+            ///   the ABI states that the entries before it have already
+            ///   been read.
+            ///
+
+            if (bsl::unlikely(!ext.copy_to_user(tls, vps_batch_addr(tls, i), descs))) {
+                bsl::print<bsl::V>() << bsl::here();
+                tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS2.get();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << "batch entry " << i << bsl::endl << bsl::here();
+                return ret;
+            }
+        }
+
+        tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+        return bsl::errc_success;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the bf_vps_op_write_batch syscall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+    ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
+    ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
+    ///   @param intrinsic the intrinsics to use
+    ///   @param vps_pool the VPS pool to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    template<
+        typename TLS_CONCEPT,
+        typename EXT_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename VPS_POOL_CONCEPT>
+    [[nodiscard]] constexpr auto
+    syscall_vps_op_write_batch(
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT &ext,
+        INTRINSIC_CONCEPT &intrinsic,
+        VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
+    {
+        if (bsl::unlikely(!is_vps_batch_valid(tls))) {
+            bsl::print<bsl::V>() << bsl::here();
+            tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS2.get();
+            return bsl::errc_failure;
+        }
+
+        vps_batch_t batch{};
+        bsl::safe_uintmax const num{tls.ext_reg3};
+
+        for (bsl::safe_uintmax i{}; i < num; i += VPS_BATCH_SIZE) {
+            auto const descs{get_vps_batch(tls, ext, i, batch)};
+            if (bsl::unlikely(descs.empty())) {
+                bsl::print<bsl::V>() << bsl::here();
+                tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS2.get();
+                return bsl::errc_failure;
+            }
+
+            bsl::span<syscall::bf_vps_batch_t const> const const_descs{
+                descs.data(), descs.size()};
+            auto const ret{vps_pool.write_batch(
+                tls, intrinsic, ext, bsl::to_u16_unsafe(tls.ext_reg1), const_descs)};
+
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << "batch entry " << i << bsl::endl << bsl::here();
+                return ret;
+            }
+        }
+
+        tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+        return bsl::errc_success;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the bf_vps_op_set_exit_policy syscall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
+    ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
+    ///   @param vps_pool the VPS pool to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename VPS_POOL_CONCEPT>
+    [[nodiscard]] constexpr auto
+    syscall_vps_op_set_exit_policy(
+        TLS_CONCEPT &tls, EXT_CONCEPT const &ext, VPS_POOL_CONCEPT &vps_pool) noexcept
+        -> bsl::errc_type
+    {
+        constexpr auto page_size{bsl::to_umax(HYPERVISOR_PAGE_SIZE)};
+        constexpr auto entry_size{bsl::to_umax(sizeof(syscall::bf_exit_policy_t))};
+
+        bsl::safe_uintmax const addr{tls.ext_reg2};
+        bsl::safe_uintmax const num{tls.ext_reg3};
+
+        /// NOTE:
+        /// - An empty exit policy is allowed, as this is how the extension
+        ///   removes the exit policy of a VPS. Otherwise, the entries are
+        ///   validated the same way as the batch descriptors.
+        ///
+
+        bsl::array<syscall::bf_exit_policy_t, syscall::BF_EXIT_POLICY_MAX.get()> policy{};
+        bsl::span<syscall::bf_exit_policy_t const> entries{};
+
+        if (!num.is_zero()) {
+            if (bsl::unlikely(addr.is_zero())) {
+                bsl::error() << "the exit policy entries cannot be a nullptr\n" << bsl::here();
+                tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS2.get();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(num > syscall::BF_EXIT_POLICY_MAX)) {
+                bsl::error() << "the number of exit policy entries "     // --
+                             << bsl::hex(num)                            // --
+                             << " is larger than the max "               // --
+                             << bsl::hex(syscall::BF_EXIT_POLICY_MAX)    // --
+                             << bsl::endl                                // --
+                             << bsl::here();                             // --
+
+                tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS3.get();
+                return bsl::errc_failure;
+            }
+
+            auto const bytes_into_page{addr & (page_size - bsl::ONE_UMAX)};
+            if (bsl::unlikely(bytes_into_page + (num * entry_size) > page_size)) {
+                bsl::error() << "the exit policy entries at "    // --
+                             << bsl::hex(addr)                   // --
+                             << " cross a page boundary"         // --
+                             << bsl::endl                        // --
+                             << bsl::here();                     // --
+
+                tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS2.get();
+                return bsl::errc_failure;
+            }
+
+            /// NOTE:
+            /// - Like the batch descriptors, the entries are never
+            ///   accessed in place. They are copied into the microkernel,
+            ///   which also checks that the address is the extension's
+            ///   own memory, and validated from the copy.
+            ///
+
+            bsl::span<syscall::bf_exit_policy_t> const copy{policy.data(), num};
+            if (bsl::unlikely(!ext.copy_from_user(tls, copy, addr))) {
+                bsl::print<bsl::V>() << bsl::here();
+                tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS2.get();
+                return bsl::errc_failure;
+            }
+
+            entries = {copy.data(), copy.size()};
+        }
+        else {
+            bsl::touch();
+        }
+
+        auto const ret{
+            vps_pool.set_exit_policy(tls, bsl::to_u16_unsafe(tls.ext_reg1), entries)};
+
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            return ret;
+        }
+
+        tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
+        return bsl::errc_success;
+    }
+
     /// <!-- description -->
     ///   @brief Implements the bf_vps_op_run syscall
     ///
@@ -952,7 +1353,7 @@ namespace mk
             }
 
             case syscall::BF_VPS_OP_WRITE8_IDX_VAL.get(): {
-                ret = syscall_vps_op_write8(tls, intrinsic, vps_pool);
+                ret = syscall_vps_op_write8(tls, ext, intrinsic, vps_pool);
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -962,7 +1363,7 @@ namespace mk
             }
 
             case syscall::BF_VPS_OP_WRITE16_IDX_VAL.get(): {
-                ret = syscall_vps_op_write16(tls, intrinsic, vps_pool);
+                ret = syscall_vps_op_write16(tls, ext, intrinsic, vps_pool);
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -972,7 +1373,7 @@ namespace mk
             }
 
             case syscall::BF_VPS_OP_WRITE32_IDX_VAL.get(): {
-                ret = syscall_vps_op_write32(tls, intrinsic, vps_pool);
+                ret = syscall_vps_op_write32(tls, ext, intrinsic, vps_pool);
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -982,7 +1383,7 @@ namespace mk
             }
 
             case syscall::BF_VPS_OP_WRITE64_IDX_VAL.get(): {
-                ret = syscall_vps_op_write64(tls, intrinsic, vps_pool);
+                ret = syscall_vps_op_write64(tls, ext, intrinsic, vps_pool);
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -1071,6 +1472,36 @@ namespace mk
                 return ret;
             }
 
+            case syscall::BF_VPS_OP_READ_BATCH_IDX_VAL.get(): {
+                ret = syscall_vps_op_read_batch(tls, ext, intrinsic, vps_pool);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case syscall::BF_VPS_OP_WRITE_BATCH_IDX_VAL.get(): {
+                ret = syscall_vps_op_write_batch(tls, ext, intrinsic, vps_pool);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case syscall::BF_VPS_OP_SET_EXIT_POLICY_IDX_VAL.get(): {
+                ret = syscall_vps_op_set_exit_policy(tls, ext, vps_pool);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
             default: {
                 break;
             }
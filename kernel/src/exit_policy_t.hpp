@@ -0,0 +1,448 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef EXIT_POLICY_T_HPP
+#define EXIT_POLICY_T_HPP
+
+#include <instruction_exit_reason.hpp>
+#include <mk_interface.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/string_view.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace mk
+{
+    /// @class mk::exit_policy_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the exit policy of a single VPS. An exit policy is a
+    ///     small table of entries registered by the extension using
+    ///     bf_vps_op_set_exit_policy. Each entry describes a trivial VMExit
+    ///     (e.g., CPUID passthrough) that the microkernel can handle on its
+    ///     own, without the round trip to the extension. The VPS decodes
+    ///     the VMExit and asks the exit policy for a match, and the exit
+    ///     policy counts how many VMExits each entry has handled. A VPS
+    ///     only runs on the PP it is assigned to, which is why no lock is
+    ///     needed.
+    ///
+    class exit_policy_t final
+    {
+        /// @brief stores the exit policy's entries
+        bsl::array<syscall::bf_exit_policy_t, syscall::BF_EXIT_POLICY_MAX.get()> m_entries{};
+        /// @brief stores the number of VMExits each entry has handled
+        bsl::array<bsl::safe_uintmax, syscall::BF_EXIT_POLICY_MAX.get()> m_hits{};
+        /// @brief stores the number of valid entries
+        bsl::safe_uintmax m_num{};
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided MSR range overlaps an MSR
+        ///     that is loaded with the VPS's own value while the VPS runs.
+        ///     The native value of such an MSR is the microkernel's value,
+        ///     not the guest's, so it cannot be passed through.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param first the first MSR in the range
+        ///   @param last the last MSR in the range
+        ///   @return Returns true if the provided MSR range overlaps an MSR
+        ///     that is owned by the VPS.
+        ///
+        [[nodiscard]] static constexpr auto
+        overlaps_vps_msrs(bsl::safe_uintmax const &first, bsl::safe_uintmax const &last) noexcept
+            -> bool
+        {
+            constexpr auto sysenter_first{bsl::to_umax(0x174U)};
+            constexpr auto sysenter_last{bsl::to_umax(0x176U)};
+            constexpr auto debugctl{bsl::to_umax(0x1D9U)};
+            constexpr auto pat{bsl::to_umax(0x277U)};
+            constexpr auto efer_first{bsl::to_umax(0xC0000080U)};
+            constexpr auto fmask_last{bsl::to_umax(0xC0000084U)};
+            constexpr auto fs_base_first{bsl::to_umax(0xC0000100U)};
+            constexpr auto kernel_gs_base_last{bsl::to_umax(0xC0000102U)};
+
+            auto overlaps{[&first, &last](auto const &msr_first, auto const &msr_last) noexcept {
+                return !((last < msr_first) || (msr_last < first));
+            }};
+
+            if (overlaps(sysenter_first, sysenter_last)) {
+                return true;
+            }
+
+            if (overlaps(debugctl, debugctl)) {
+                return true;
+            }
+
+            if (overlaps(pat, pat)) {
+                return true;
+            }
+
+            if (overlaps(efer_first, fmask_last)) {
+                return true;
+            }
+
+            return overlaps(fs_base_first, kernel_gs_base_last);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if every exit reason in the provided range
+        ///     is caused by the guest executing an instruction. Advancing
+        ///     the IP for any other VMExit (e.g., an external interrupt,
+        ///     an NMI or an EPT violation) would skip a guest instruction
+        ///     that never ran.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param first the first exit reason in the range
+        ///   @param last the last exit reason in the range
+        ///   @return Returns true if every exit reason in the provided range
+        ///     is caused by the guest executing an instruction.
+        ///
+        [[nodiscard]] static constexpr auto
+        is_instruction_exit_range(
+            bsl::safe_uintmax const &first, bsl::safe_uintmax const &last) noexcept -> bool
+        {
+            if (last > INSTRUCTION_EXIT_REASON_MAX) {
+                return false;
+            }
+
+            for (bsl::safe_uintmax reason{first}; reason <= last; ++reason) {
+                if (!is_instruction_exit_reason(reason)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided entry is valid
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param entry the entry to validate
+        ///   @param idx the index of the entry (used for logging)
+        ///   @return Returns true if the provided entry is valid
+        ///
+        [[nodiscard]] static constexpr auto
+        is_valid(syscall::bf_exit_policy_t const &entry, bsl::safe_uintmax const &idx) noexcept
+            -> bool
+        {
+            bsl::safe_uintmax const first{entry.first};
+            bsl::safe_uintmax const last{entry.last};
+
+            if (bsl::unlikely(last < first)) {
+                bsl::error() << "exit policy entry "    // --
+                             << idx                     // --
+                             << " has a first of "      // --
+                             << bsl::hex(first)         // --
+                             << " and a last of "       // --
+                             << bsl::hex(last)          // --
+                             << bsl::endl               // --
+                             << bsl::here();            // --
+
+                return false;
+            }
+
+            switch (entry.type) {
+                case syscall::bf_exit_policy_type_t::cpuid: {
+                    return true;
+                }
+
+                case syscall::bf_exit_policy_type_t::rdmsr: {
+                    if (bsl::unlikely(overlaps_vps_msrs(first, last))) {
+                        bsl::error() << "exit policy entry "                     // --
+                                     << idx                                      // --
+                                     << " passes through an MSR owned by the "   // --
+                                     << "VPS between "                           // --
+                                     << bsl::hex(first)                          // --
+                                     << " and "                                  // --
+                                     << bsl::hex(last)                           // --
+                                     << bsl::endl                                // --
+                                     << bsl::here();                             // --
+
+                        return false;
+                    }
+
+                    return true;
+                }
+
+                case syscall::bf_exit_policy_type_t::advance_ip: {
+                    if (bsl::unlikely(!is_instruction_exit_range(first, last))) {
+                        bsl::error() << "exit policy entry "                       // --
+                                     << idx                                        // --
+                                     << " advances the IP of an exit reason "      // --
+                                     << "that is not caused by an instruction "    // --
+                                     << "between "                                 // --
+                                     << bsl::hex(first)                            // --
+                                     << " and "                                    // --
+                                     << bsl::hex(last)                             // --
+                                     << bsl::endl                                  // --
+                                     << bsl::here();                               // --
+
+                        return false;
+                    }
+
+                    return true;
+                }
+
+                default: {
+                    break;
+                }
+            }
+
+            bsl::error() << "exit policy entry "                               // --
+                         << idx                                                // --
+                         << " has an unknown type "                            // --
+                         << bsl::hex(static_cast<bsl::uint64>(entry.type))     // --
+                         << bsl::endl                                          // --
+                         << bsl::here();                                       // --
+
+            return false;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the name of the provided exit policy type
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param type the type to get the name of
+        ///   @return Returns the name of the provided exit policy type
+        ///
+        [[nodiscard]] static constexpr auto
+        type_name(syscall::bf_exit_policy_type_t const type) noexcept -> bsl::string_view
+        {
+            switch (type) {
+                case syscall::bf_exit_policy_type_t::cpuid: {
+                    return "cpuid ";
+                }
+
+                case syscall::bf_exit_policy_type_t::rdmsr: {
+                    return "rdmsr ";
+                }
+
+                case syscall::bf_exit_policy_type_t::advance_ip: {
+                    return "advance ip ";
+                }
+
+                default: {
+                    break;
+                }
+            }
+
+            return "unknown ";
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Replaces the exit policy with the provided entries and
+        ///     resets the hit counters. If any of the entries are invalid,
+        ///     the current exit policy is left as is.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param entries the entries defining the new exit policy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        set(bsl::span<syscall::bf_exit_policy_t const> const &entries) &noexcept
+            -> bsl::errc_type
+        {
+            if (bsl::unlikely(entries.size() > m_entries.size())) {
+                bsl::error() << "the number of exit policy entries "    // --
+                             << bsl::hex(entries.size())                // --
+                             << " is larger than the max "              // --
+                             << bsl::hex(m_entries.size())              // --
+                             << bsl::endl                               // --
+                             << bsl::here();                            // --
+
+                return bsl::errc_failure;
+            }
+
+            for (auto const elem : entries) {
+                if (bsl::unlikely(!is_valid(*elem.data, elem.index))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+            }
+
+            this->clear();
+            for (auto const elem : entries) {
+                *m_entries.at_if(elem.index) = *elem.data;
+            }
+
+            m_num = entries.size();
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Removes all of the entries and resets the hit counters
+        ///
+        constexpr void
+        clear() &noexcept
+        {
+            m_entries = {};
+            m_hits = {};
+            m_num = {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the exit policy has no entries. This is
+        ///     checked on every VMExit, so that a VPS without an exit
+        ///     policy pays nothing more than this check.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns true if the exit policy has no entries
+        ///
+        [[nodiscard]] constexpr auto
+        empty() const &noexcept -> bool
+        {
+            return m_num.is_zero();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the first entry of the provided type whose
+        ///     [first, last] range contains the provided key (i.e., the
+        ///     CPUID leaf, MSR or exit reason of the VMExit). If no entry
+        ///     matches, a nullptr is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param type the type of entry to look for
+        ///   @param key the CPUID leaf, MSR or exit reason to look for
+        ///   @param idx returns the index of the matching entry
+        ///   @return Returns the matching entry, or a nullptr if no entry
+        ///     matches.
+        ///
+        [[nodiscard]] constexpr auto
+        match(
+            syscall::bf_exit_policy_type_t const type,
+            bsl::safe_uintmax const &key,
+            bsl::safe_uintmax &idx) const &noexcept -> syscall::bf_exit_policy_t const *
+        {
+            for (bsl::safe_uintmax i{}; i < m_num; ++i) {
+                auto const *const entry{m_entries.at_if(i)};
+                if (entry->type != type) {
+                    continue;
+                }
+
+                if ((key < bsl::make_safe(entry->first)) || (key > bsl::make_safe(entry->last))) {
+                    continue;
+                }
+
+                idx = i;
+                return entry;
+            }
+
+            return nullptr;
+        }
+
+        /// <!-- description -->
+        ///   @brief Records that the entry at the provided index handled a
+        ///     VMExit.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param idx the index of the entry that handled the VMExit
+        ///
+        constexpr void
+        hit(bsl::safe_uintmax const &idx) &noexcept
+        {
+            auto *const hits{m_hits.at_if(idx)};
+            if (bsl::unlikely(nullptr == hits)) {
+                bsl::error() << "invalid exit policy index: "    // --
+                             << bsl::hex(idx)                    // --
+                             << bsl::endl                        // --
+                             << bsl::here();                     // --
+
+                return;
+            }
+
+            ++*hits;
+        }
+
+        /// <!-- description -->
+        ///   @brief Dumps the exit policy, including the number of VMExits
+        ///     each entry has handled.
+        ///
+        constexpr void
+        dump() const &noexcept
+        {
+            if constexpr (BSL_DEBUG_LEVEL == bsl::CRITICAL_ONLY) {
+                return;
+            }
+
+            if (this->empty()) {
+                return;
+            }
+
+            bsl::print() << bsl::mag << "exit policy:";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            /// Header
+            ///
+
+            bsl::print() << bsl::ylw << "+-----------------------------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^12s", "type "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^11s", "first "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^11s", "last "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^12s", "hits "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "+-----------------------------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            /// Entries
+            ///
+
+            for (bsl::safe_uintmax i{}; i < m_num; ++i) {
+                auto const *const entry{m_entries.at_if(i)};
+
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"<12s", type_name(entry->type)};
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"#010x", bsl::make_safe(entry->first)};
+                bsl::print() << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"#010x", bsl::make_safe(entry->last)};
+                bsl::print() << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"11d", *m_hits.at_if(i)} << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::endl;
+            }
+
+            bsl::print() << bsl::ylw << "+-----------------------------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+        }
+    };
+}
+
+#endif
@@ -47,6 +47,8 @@ namespace mk
     ///   @tparam PAGE_POOL_CONCEPT defines the type of page pool to use
     ///   @tparam HUGE_POOL_CONCEPT defines the type of huge pool to use
     ///   @tparam ROOT_PAGE_TABLE_CONCEPT defines the type of RPT pool to use
+    ///   @tparam TLB_SHOOTDOWN_CONCEPT defines the type of TLB shootdown to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
     ///   @tparam MAX_EXTENSIONS the max number of extensions supported
     ///
     template<
@@ -55,6 +57,8 @@ namespace mk
         typename PAGE_POOL_CONCEPT,
         typename HUGE_POOL_CONCEPT,
         typename ROOT_PAGE_TABLE_CONCEPT,
+        typename TLB_SHOOTDOWN_CONCEPT,
+        typename TRACE_CONCEPT,
         bsl::uintmax MAX_EXTENSIONS>
     class ext_pool_t final
     {
@@ -66,6 +70,10 @@ namespace mk
         HUGE_POOL_CONCEPT &m_huge_pool;
         /// @brief stores system RPT provided by the loader
         ROOT_PAGE_TABLE_CONCEPT &m_system_rpt;
+        /// @brief stores a reference to the TLB shootdown to use
+        TLB_SHOOTDOWN_CONCEPT &m_tlb_shootdown;
+        /// @brief stores a reference to the trace to use
+        TRACE_CONCEPT &m_trace;
         /// @brief stores all of the extensions.
         bsl::array<EXT_CONCEPT, MAX_EXTENSIONS> m_pool;
 
@@ -80,6 +88,10 @@ namespace mk
         using huge_pool_type = HUGE_POOL_CONCEPT;
         /// @brief an alias for ROOT_PAGE_TABLE_CONCEPT
         using root_page_table_type = ROOT_PAGE_TABLE_CONCEPT;
+        /// @brief an alias for TLB_SHOOTDOWN_CONCEPT
+        using tlb_shootdown_type = TLB_SHOOTDOWN_CONCEPT;
+        /// @brief an alias for TRACE_CONCEPT
+        using trace_type = TRACE_CONCEPT;
 
         /// <!-- description -->
         ///   @brief Creates a ext_pool_t
@@ -89,16 +101,22 @@ namespace mk
         ///   @param page_pool the page pool to use
         ///   @param huge_pool the huge pool to use
         ///   @param system_rpt the system RPT provided by the loader
+        ///   @param tlb_shootdown the TLB shootdown to use
+        ///   @param trace the trace to use
         ///
         explicit constexpr ext_pool_t(
             INTRINSIC_CONCEPT &intrinsic,
             PAGE_POOL_CONCEPT &page_pool,
             HUGE_POOL_CONCEPT &huge_pool,
-            ROOT_PAGE_TABLE_CONCEPT &system_rpt) noexcept
+            ROOT_PAGE_TABLE_CONCEPT &system_rpt,
+            TLB_SHOOTDOWN_CONCEPT &tlb_shootdown,
+            TRACE_CONCEPT &trace) noexcept
             : m_intrinsic{intrinsic}
             , m_page_pool{page_pool}
             , m_huge_pool{huge_pool}
             , m_system_rpt{system_rpt}
+            , m_tlb_shootdown{tlb_shootdown}
+            , m_trace{trace}
             , m_pool{}
         {}
 
@@ -140,6 +158,8 @@ namespace mk
                     &m_intrinsic,
                     &m_page_pool,
                     &m_huge_pool,
+                    &m_tlb_shootdown,
+                    &m_trace,
                     bsl::to_u16(ext.index),
                     *ext_elf_files.at_if(ext.index),
                     &m_system_rpt);
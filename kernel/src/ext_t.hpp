@@ -34,11 +34,14 @@
 #include <elf64_phdr_t.hpp>
 #include <map_page_flags.hpp>
 #include <mk_interface.hpp>
+#include <trace_event.hpp>
+#include <xsave_area_t.hpp>
 
 #include <bsl/array.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/finally.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
 #include <bsl/unlikely.hpp>
 #include <bsl/unlikely_assert.hpp>
 
@@ -99,11 +102,18 @@ namespace mk
     ///   @tparam PAGE_POOL_CONCEPT defines the type of page pool to use
     ///   @tparam HUGE_POOL_CONCEPT defines the type of huge pool to use
     ///   @tparam ROOT_PAGE_TABLE_CONCEPT defines the type of RPT pool to use
+    ///   @tparam TLB_SHOOTDOWN_CONCEPT defines the type of TLB shootdown to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
     ///   @tparam PAGE_SIZE defines the size of a page
     ///   @tparam MAX_PPS the max number of PPs supported
     ///   @tparam MAX_VMS the max number of VMs supported
     ///   @tparam EXT_DIRECT_MAP_ADDR the address of the extension's direct map
     ///   @tparam EXT_DIRECT_MAP_SIZE the size of the extension's direct map
+    ///   @tparam EXT_DIRECT_MAP_FAULT_SIZE the size of the page that is mapped
+    ///     when the extension faults on the direct map (4k or 2M)
+    ///   @tparam EXT_DIRECT_MAP_PREMAP_SIZE the number of bytes of physical
+    ///     memory to map into each direct map using 2M pages when it is
+    ///     created (0 disables premapping)
     ///   @tparam EXT_STACK_ADDR the address of the extension's stack
     ///   @tparam EXT_STACK_SIZE the size of the extension's stack
     ///   @tparam EXT_CODE_ADDR the address of the extension's code
@@ -122,11 +132,15 @@ namespace mk
         typename PAGE_POOL_CONCEPT,
         typename HUGE_POOL_CONCEPT,
         typename ROOT_PAGE_TABLE_CONCEPT,
+        typename TLB_SHOOTDOWN_CONCEPT,
+        typename TRACE_CONCEPT,
         bsl::uintmax PAGE_SIZE,
         bsl::uintmax MAX_PPS,
         bsl::uintmax MAX_VMS,
         bsl::uintmax EXT_DIRECT_MAP_ADDR,
         bsl::uintmax EXT_DIRECT_MAP_SIZE,
+        bsl::uintmax EXT_DIRECT_MAP_FAULT_SIZE,
+        bsl::uintmax EXT_DIRECT_MAP_PREMAP_SIZE,
         bsl::uintmax EXT_STACK_ADDR,
         bsl::uintmax EXT_STACK_SIZE,
         bsl::uintmax EXT_CODE_ADDR,
@@ -147,6 +161,10 @@ namespace mk
         PAGE_POOL_CONCEPT *m_page_pool{};
         /// @brief stores a reference to the huge pool to use
         HUGE_POOL_CONCEPT *m_huge_pool{};
+        /// @brief stores a reference to the TLB shootdown to use
+        TLB_SHOOTDOWN_CONCEPT *m_tlb_shootdown{};
+        /// @brief stores a reference to the trace to use
+        TRACE_CONCEPT *m_trace{};
         /// @brief stores true if start() has been executed
         bool m_started{};
         /// @brief stores the ID associated with this ext_t
@@ -156,6 +174,8 @@ namespace mk
         ROOT_PAGE_TABLE_CONCEPT m_main_rpt{};
         /// @brief stores the direct map rpts
         bsl::array<ROOT_PAGE_TABLE_CONCEPT, MAX_VMS> m_direct_map_rpts{};
+        /// @brief stores the number of direct map faults for each VM
+        bsl::array<bsl::uint64, MAX_VMS> m_direct_map_faults{};
         /// @brief stores the main IP registered by the extension
         bsl::safe_uintmax m_entry_ip{bsl::safe_uintmax::zero(true)};
         /// @brief stores the bootstrap IP registered by the extension
@@ -169,6 +189,105 @@ namespace mk
         /// @brief stores the extension's heap cursor
         bsl::safe_uintmax m_heap_crsr{};
 
+        /// @brief stores this extension's FPU state for each PP
+        bsl::array<xsave_area_t *, MAX_PPS> m_xsave_areas{};
+        /// @brief stores the root OS's FPU state set aside for each PP
+        bsl::array<xsave_area_t *, MAX_PPS> m_root_xsave_areas{};
+
+        /// <!-- description -->
+        ///   @brief Returns the XSAVE area in the provided list for the
+        ///     current PP, allocating it the first time it is asked for.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param areas the list of XSAVE areas to get the area from
+        ///   @return Returns the XSAVE area for the current PP, or a
+        ///     nullptr on failure.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        get_xsave_area(
+            TLS_CONCEPT &tls, bsl::array<xsave_area_t *, MAX_PPS> &areas) &noexcept
+            -> xsave_area_t *
+        {
+            auto *const area{areas.at_if(bsl::to_umax(tls.ppid))};
+            if (bsl::unlikely_assert(nullptr == area)) {
+                bsl::error() << "invalid ppid "       // --
+                             << bsl::hex(tls.ppid)    // --
+                             << bsl::endl             // --
+                             << bsl::here();          // --
+
+                return nullptr;
+            }
+
+            if (nullptr != *area) {
+                return *area;
+            }
+
+            *area = m_page_pool->template allocate<xsave_area_t>(tls, ALLOCATE_TAG_XSAVE_AREA);
+            if (bsl::unlikely(nullptr == *area)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return nullptr;
+            }
+
+            return *area;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the XSAVE areas in the provided list to the
+        ///     page pool. Only the current PP's area is freed. The areas
+        ///     of other PPs might still be loaded there, so they are leaked
+        ///     and reported instead.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param areas the list of XSAVE areas to release
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        release_xsave_areas(
+            TLS_CONCEPT &tls, bsl::array<xsave_area_t *, MAX_PPS> &areas) &noexcept
+        {
+            for (auto const elem : areas) {
+                if (nullptr == *elem.data) {
+                    continue;
+                }
+
+                if (bsl::unlikely(bsl::to_umax(tls.ppid) != elem.index)) {
+                    bsl::error() << "ext "                                  // --
+                                 << bsl::hex(m_id)                          // --
+                                 << " cannot free the xsave area of pp "    // --
+                                 << bsl::hex(elem.index)                    // --
+                                 << " from pp "                             // --
+                                 << bsl::hex(tls.ppid)                      // --
+                                 << " and it will be leaked"                // --
+                                 << bsl::endl                               // --
+                                 << bsl::here();                            // --
+
+                    continue;
+                }
+
+                if (*elem.data == tls.active_xsave) {
+                    tls.active_xsave = {};
+                }
+                else {
+                    bsl::touch();
+                }
+
+                if (*elem.data == tls.root_xsave) {
+                    tls.root_xsave = {};
+                }
+                else {
+                    bsl::touch();
+                }
+
+                m_page_pool->deallocate(tls, *elem.data, ALLOCATE_TAG_XSAVE_AREA);
+                *elem.data = {};
+            }
+        }
+
         /// <!-- description -->
         ///   @brief Validates the provided pt_load segment.
         ///
@@ -683,7 +802,10 @@ namespace mk
             ROOT_PAGE_TABLE_CONCEPT const &system_rpt,
             bsl::span<bsl::byte const> const &elf_file) &noexcept -> bsl::errc_type
         {
-            if (bsl::unlikely(!rpt.initialize(tls, m_intrinsic, m_page_pool, m_huge_pool))) {
+            auto const ret{
+                rpt.initialize(tls, m_intrinsic, m_page_pool, m_huge_pool, bsl::ZERO_U16)};
+
+            if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::errc_failure;
             }
@@ -725,15 +847,18 @@ namespace mk
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @param tls the current TLS block
         ///   @param rpt the root page table to initialize
+        ///   @param pcid the PCID to tag the root page table with
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
         template<typename TLS_CONCEPT>
         [[nodiscard]] constexpr auto
-        initialize_direct_map_rpt(TLS_CONCEPT &tls, ROOT_PAGE_TABLE_CONCEPT &rpt) &noexcept
-            -> bsl::errc_type
+        initialize_direct_map_rpt(
+            TLS_CONCEPT &tls,
+            ROOT_PAGE_TABLE_CONCEPT &rpt,
+            bsl::safe_uint16 const &pcid) &noexcept -> bsl::errc_type
         {
-            if (bsl::unlikely(!rpt.initialize(tls, m_intrinsic, m_page_pool, m_huge_pool))) {
+            if (bsl::unlikely(!rpt.initialize(tls, m_intrinsic, m_page_pool, m_huge_pool, pcid))) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::errc_failure;
             }
@@ -747,6 +872,28 @@ namespace mk
                 return bsl::errc_failure;
             }
 
+            /// NOTE:
+            /// - The start of physical memory is premapped using 2M pages
+            ///   so that the extension does not have to fault its way
+            ///   through it one page at a time. Anything above this is
+            ///   still mapped on demand by map_page_direct().
+            ///
+
+            constexpr auto dm_addr{bsl::to_umax(EXT_DIRECT_MAP_ADDR)};
+            constexpr auto premap_size{bsl::to_umax(EXT_DIRECT_MAP_PREMAP_SIZE)};
+
+            for (bsl::safe_uintmax phys{}; phys < premap_size; phys += MAP_PAGE_2M_SIZE) {
+                auto const ret{
+                    rpt.map_2m_page(tls, dm_addr + phys, phys, MAP_PAGE_READ | MAP_PAGE_WRITE)};
+
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+
             release_on_error.ignore();
             return bsl::errc_success;
         }
@@ -838,6 +985,79 @@ namespace mk
             return bsl::errc_success;
         }
 
+        /// <!-- description -->
+        ///   @brief Removes a page that was allocated using the page/huge
+        ///     pools from the direct maps. The page must be mapped into the
+        ///     direct map of VM 0 (as that is where alloc_page/alloc_huge
+        ///     put it) using the provided auto release tag, but it is only
+        ///     mapped into the direct maps of other VMs if the extension
+        ///     touched it while those VMs were active, so it is fine if the
+        ///     page is not mapped there. If it is mapped there (including as
+        ///     part of a large page), it must be unmapped, otherwise the page
+        ///     would stay mapped after it is freed, so any other failure is
+        ///     an error. Note that only the TLB of the PP that calls this
+        ///     function is invalidated. The caller is responsible for
+        ///     the TLBs of the remaining PPs.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the virtual address of the page to unmap
+        ///   @param auto_release the auto release tag VM 0 mapped the page with
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        unmap_direct_map_rpts(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_int32 const &auto_release) &noexcept -> bsl::errc_type
+        {
+            bsl::errc_type ret{};
+
+            auto &vm0_rpt{m_direct_map_rpts.front()};
+            if (bsl::unlikely(!vm0_rpt.unmap_page(tls, page_virt, auto_release))) {
+                bsl::error() << "virtual address "                   // --
+                             << bsl::hex(page_virt)                  // --
+                             << " was not allocated by this ext"    // --
+                             << bsl::endl                            // --
+                             << bsl::here();                         // --
+
+                return bsl::errc_failure;
+            }
+
+            for (auto const rpt : m_direct_map_rpts) {
+                if (rpt.index.is_zero()) {
+                    continue;
+                }
+
+                if (!rpt.data->is_initialized()) {
+                    continue;
+                }
+
+                ret = rpt.data->unmap_page(tls, page_virt, MAP_PAGE_NO_AUTO_RELEASE);
+                if (ret == bsl::errc_precondition) {
+                    continue;
+                }
+
+                if (bsl::unlikely(!ret)) {
+                    bsl::error() << "failed to unmap "               // --
+                                 << bsl::hex(page_virt)              // --
+                                 << " from the direct map of vm "    // --
+                                 << bsl::hex(rpt.index)              // --
+                                 << bsl::endl                        // --
+                                 << bsl::here();                     // --
+
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+
+            return bsl::errc_success;
+        }
+
         /// <!-- description -->
         ///   @brief Executes the extension given an instruction pointer to
         ///     execute the extension at, a stack pointer to execute the
@@ -902,6 +1122,8 @@ namespace mk
                 bsl::touch();
             }
 
+            m_trace->record(tls, *m_intrinsic, TRACE_EVENT_EXT, ip);
+
             bsl::exit_code const ret{call_ext(ip.get(), tls.sp, arg0.get(), arg1.get())};
             if (bsl::unlikely(ret != bsl::exit_success)) {
                 bsl::print<bsl::V>() << bsl::here();
@@ -920,6 +1142,10 @@ namespace mk
         using huge_pool_type = HUGE_POOL_CONCEPT;
         /// @brief an alias for ROOT_PAGE_TABLE_CONCEPT
         using root_page_table_type = ROOT_PAGE_TABLE_CONCEPT;
+        /// @brief an alias for TLB_SHOOTDOWN_CONCEPT
+        using tlb_shootdown_type = TLB_SHOOTDOWN_CONCEPT;
+        /// @brief an alias for TRACE_CONCEPT
+        using trace_type = TRACE_CONCEPT;
 
         /// <!-- description -->
         ///   @brief Default constructor
@@ -935,6 +1161,8 @@ namespace mk
         ///   @param intrinsic the intrinsics to use
         ///   @param page_pool the page pool to use
         ///   @param huge_pool the huge pool to use
+        ///   @param tlb_shootdown the TLB shootdown to use
+        ///   @param trace the trace to use
         ///   @param i the ID for this ext_t
         ///   @param ext_elf_file the ELF file for this ext_t
         ///   @param system_rpt the system RPT provided by the loader
@@ -948,6 +1176,8 @@ namespace mk
             INTRINSIC_CONCEPT *const intrinsic,
             PAGE_POOL_CONCEPT *const page_pool,
             HUGE_POOL_CONCEPT *const huge_pool,
+            TLB_SHOOTDOWN_CONCEPT *const tlb_shootdown,
+            TRACE_CONCEPT *const trace,
             bsl::safe_uint16 const &i,
             bsl::span<bsl::byte const> const &ext_elf_file,
             ROOT_PAGE_TABLE_CONCEPT const *const system_rpt) &noexcept -> bsl::errc_type
@@ -981,6 +1211,18 @@ namespace mk
                 return bsl::errc_failure;
             }
 
+            m_tlb_shootdown = tlb_shootdown;
+            if (bsl::unlikely_assert(nullptr == tlb_shootdown)) {
+                bsl::error() << "invalid tlb_shootdown\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_trace = trace;
+            if (bsl::unlikely_assert(nullptr == trace)) {
+                bsl::error() << "invalid trace\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
             if (bsl::unlikely_assert(!i)) {
                 bsl::error() << "invalid id\n" << bsl::here();
                 return bsl::errc_failure;
@@ -1032,6 +1274,9 @@ namespace mk
             m_bootstrap_ip = bsl::safe_uintmax::zero(true);
             m_entry_ip = bsl::safe_uintmax::zero(true);
 
+            this->release_xsave_areas(tls, m_root_xsave_areas);
+            this->release_xsave_areas(tls, m_xsave_areas);
+
             for (auto const rpt : m_direct_map_rpts) {
                 rpt.data->release(tls);
             }
@@ -1040,6 +1285,8 @@ namespace mk
 
             m_id = bsl::safe_uint16::zero(true);
             m_started = {};
+            m_trace = {};
+            m_tlb_shootdown = {};
             m_huge_pool = {};
             m_page_pool = {};
             m_intrinsic = {};
@@ -1243,6 +1490,80 @@ namespace mk
             return m_started;
         }
 
+        /// <!-- description -->
+        ///   @brief Copies an array from the extension's memory into the
+        ///     provided microkernel array. The extension's array must be
+        ///     mapped as user memory in the direct map that is currently
+        ///     active, which means it cannot point at microkernel memory.
+        ///     Syscalls that take an array from the extension must use this
+        ///     (and copy_to_user) instead of accessing the array directly.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam T the type of array to copy
+        ///   @param tls the current TLS block
+        ///   @param dst the microkernel array to copy to
+        ///   @param src_virt the virtual address of the extension's array
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT, typename T>
+        [[nodiscard]] constexpr auto
+        copy_from_user(
+            TLS_CONCEPT &tls,
+            bsl::span<T> const &dst,
+            bsl::safe_uintmax const &src_virt) const &noexcept -> bsl::errc_type
+        {
+            auto const *const rpt{m_direct_map_rpts.at_if(bsl::to_umax(tls.active_vmid))};
+            if (bsl::unlikely_assert(nullptr == rpt)) {
+                bsl::error() << "invalid active_vmid: "      // --
+                             << bsl::hex(tls.active_vmid)    // --
+                             << bsl::endl                    // --
+                             << bsl::here();                 // --
+
+                return bsl::errc_failure;
+            }
+
+            return rpt->copy_from_user(
+                tls, dst.data(), src_virt, dst.size() * bsl::to_umax(sizeof(T)));
+        }
+
+        /// <!-- description -->
+        ///   @brief Copies the provided microkernel array into the
+        ///     extension's memory. The extension's array must be mapped as
+        ///     writable user memory in the direct map that is currently
+        ///     active, which means it cannot point at microkernel memory.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam T the type of array to copy
+        ///   @param tls the current TLS block
+        ///   @param dst_virt the virtual address of the extension's array
+        ///   @param src the microkernel array to copy from
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT, typename T>
+        [[nodiscard]] constexpr auto
+        copy_to_user(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &dst_virt,
+            bsl::span<T> const &src) const &noexcept -> bsl::errc_type
+        {
+            auto const *const rpt{m_direct_map_rpts.at_if(bsl::to_umax(tls.active_vmid))};
+            if (bsl::unlikely_assert(nullptr == rpt)) {
+                bsl::error() << "invalid active_vmid: "      // --
+                             << bsl::hex(tls.active_vmid)    // --
+                             << bsl::endl                    // --
+                             << bsl::here();                 // --
+
+                return bsl::errc_failure;
+            }
+
+            return rpt->copy_to_user(
+                tls, dst_virt, src.data(), src.size() * bsl::to_umax(sizeof(T)));
+        }
+
         /// <!-- description -->
         ///   @brief Allocates a page and maps it into the extension's
         ///     address space.
@@ -1265,6 +1586,8 @@ namespace mk
                 return {bsl::safe_uintmax::zero(true), bsl::safe_uintmax::zero(true)};
             }
 
+            m_tlb_shootdown->reclaim(tls, *m_page_pool, *m_huge_pool);
+
             auto const *const page{
                 m_page_pool->template allocate<void>(tls, ALLOCATE_TAG_BF_MEM_OP_ALLOC_PAGE)};
             if (bsl::unlikely(nullptr == page)) {
@@ -1312,22 +1635,260 @@ namespace mk
             return {page_virt, page_phys};
         }
 
+        /// <!-- description -->
+        ///   @brief Allocates a page for each entry in the provided array
+        ///     and maps them into the extension's address space. This is
+        ///     the same as calling alloc_page() once for each entry, but the
+        ///     direct map's lock is only taken once. Pages are allocated in
+        ///     order, and if an error occurs, the entries that were not
+        ///     allocated are set to 0.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param pages the array to store the resulting pages in. This
+        ///     must be microkernel memory, as the pages are mapped (and
+        ///     on failure, freed) using the addresses stored in it. Use
+        ///     copy_to_user to give the result to the extension.
+        ///   @return Returns bsl::errc_success if every page was allocated,
+        ///     bsl::errc_failure and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        alloc_pages(TLS_CONCEPT &tls, bsl::span<syscall::bf_page_t> const &pages) &noexcept
+            -> bsl::errc_type
+        {
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "ext_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_tlb_shootdown->reclaim(tls, *m_page_pool, *m_huge_pool);
+
+            for (auto const elem : pages) {
+                *elem.data = {};
+            }
+
+            bsl::safe_uintmax allocated{};
+            for (auto const elem : pages) {
+                auto const *const page{
+                    m_page_pool->template allocate<void>(tls, ALLOCATE_TAG_BF_MEM_OP_ALLOC_PAGE)};
+                if (bsl::unlikely(nullptr == page)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    break;
+                }
+
+                auto const page_phys{m_page_pool->virt_to_phys(page)};
+                elem.data->virt = bsl::to_ptr<syscall::bf_ptr_t>(EXT_PAGE_POOL_ADDR + page_phys);
+                elem.data->phys = page_phys.get();
+
+                ++allocated;
+            }
+
+            /// NOTE:
+            /// - See alloc_page for more details. The only difference here
+            ///   is that all of the pages are mapped while holding the
+            ///   lock to VM 0's direct map once.
+            /// - If a page fails to map, that page and every page after it
+            ///   is given back to the page pool so that the extension only
+            ///   ever sees pages that are actually usable.
+            ///
+
+            auto const mapped{m_direct_map_rpts.front().map_pages(
+                tls,
+                bsl::span<syscall::bf_page_t>{pages.data(), allocated},
+                MAP_PAGE_READ | MAP_PAGE_WRITE,
+                MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE)};
+
+            for (bsl::safe_uintmax i{mapped}; i < allocated; ++i) {
+                auto *const elem{pages.at_if(i)};
+
+                m_page_pool->deallocate(
+                    tls,
+                    m_page_pool->template phys_to_virt<void>(bsl::to_umax(elem->phys)),
+                    ALLOCATE_TAG_BF_MEM_OP_ALLOC_PAGE);
+
+                *elem = {};
+            }
+
+            if (bsl::unlikely(mapped != pages.size())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds the pages that the root OS donated to the
+        ///     microkernel's page pool. The extension only forwards the
+        ///     physical address of the list that the loader created, so
+        ///     none of these pages are mapped into the extension's address
+        ///     space.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param list_phys the physical address of the list of donated
+        ///     pages
+        ///   @param node the NUMA node the donated pages belong to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        donate_pages(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &list_phys,
+            bsl::safe_uint16 const &node) &noexcept -> bsl::errc_type
+        {
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "ext_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto const ret{m_page_pool->donate(tls, list_phys, bsl::to_umax(node))};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the ID of a NUMA node whose slice of the
+        ///     microkernel's page pool is below the low watermark, or
+        ///     syscall::BF_INVALID_ID if no node is low on pages.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @return Returns the ID of a NUMA node whose slice of the
+        ///     microkernel's page pool is below the low watermark, or
+        ///     syscall::BF_INVALID_ID if no node is low on pages.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        page_pool_low(TLS_CONCEPT &tls) &noexcept -> bsl::safe_uint16
+        {
+            auto const node{m_page_pool->low_node(tls)};
+            if (!node) {
+                return syscall::BF_INVALID_ID;
+            }
+
+            return bsl::to_u16(node);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the microkernel's virtual address of a page
+        ///     given its physical address, but only if this extension
+        ///     allocated the page using alloc_page (or alloc_pages) and has
+        ///     not freed it yet. Otherwise, this function returns a nullptr.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam T defines the type of virtual address to convert to
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_phys the physical address of the page
+        ///   @return Returns the microkernel's virtual address of the page
+        ///     if it is owned by this extension, or a nullptr otherwise.
+        ///
+        template<typename T, typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        alloc_page_to_virt(TLS_CONCEPT &tls, bsl::safe_uintmax const &page_phys) &noexcept
+            -> T *
+        {
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "ext_t not initialized\n" << bsl::here();
+                return nullptr;
+            }
+
+            if (bsl::unlikely(!page_phys || (page_phys >= EXT_PAGE_POOL_SIZE))) {
+                return nullptr;
+            }
+
+            /// NOTE:
+            /// - alloc_page maps each page into VM 0's direct map using
+            ///   MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE, and free_page removes it,
+            ///   so this is a real ownership check. A physical address that
+            ///   is only inside the range of the page pool (e.g., a hole or
+            ///   a page owned by someone else) is not mapped this way.
+            ///
+
+            auto const page_virt{EXT_PAGE_POOL_ADDR + page_phys};
+            auto &vm0_rpt{m_direct_map_rpts.front()};
+            if (!vm0_rpt.is_mapped(tls, page_virt, page_phys, MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE)) {
+                return nullptr;
+            }
+
+            return m_page_pool->template phys_to_virt<T>(page_phys);
+        }
+
         /// <!-- description -->
         ///   @brief Frees a page that was mapped it into the extension's
-        ///     address space.
+        ///     address space. The page is removed from the extension's
+        ///     direct maps right away, but it is only given back to the
+        ///     page pool once every PP has flushed its TLB. Before that,
+        ///     every VPS is told that the page is gone, so that none of
+        ///     them keep using it.
         ///
         /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
+        ///   @param tls the current TLS block
+        ///   @param vps_pool the VPS pool to use
         ///   @param page_virt the virtual address to free
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
+        template<typename TLS_CONCEPT, typename VPS_POOL_CONCEPT>
         [[nodiscard]] constexpr auto
-        free_page(bsl::safe_uintmax const &page_virt) &noexcept -> bsl::errc_type
+        free_page(
+            TLS_CONCEPT &tls,
+            VPS_POOL_CONCEPT &vps_pool,
+            bsl::safe_uintmax const &page_virt) &noexcept -> bsl::errc_type
         {
-            bsl::discard(page_virt);
+            bsl::errc_type ret{};
+
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "ext_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(page_virt < EXT_PAGE_POOL_ADDR)) {
+                bsl::error() << "invalid virtual address: "    // --
+                             << bsl::hex(page_virt)            // --
+                             << bsl::endl                      // --
+                             << bsl::here();                   // --
+
+                return bsl::errc_failure;
+            }
+
+            ret = this->unmap_direct_map_rpts(tls, page_virt, MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE);
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto const page_phys{page_virt - EXT_PAGE_POOL_ADDR};
+            auto *const page{m_page_pool->template phys_to_virt<void>(page_phys)};
+
+            /// NOTE:
+            /// - This has to happen after the page is unmapped from VM 0's
+            ///   direct map. A VPS stores the page before it checks that it
+            ///   still owns it with alloc_page_to_virt, so either the VPS
+            ///   sees that the page was unmapped and drops it, or its store
+            ///   is visible here, and page_freed drops it.
+            ///
+
+            vps_pool.page_freed(page);
 
-            bsl::error() << "free_page is currently unsupported\n" << bsl::here();
-            return bsl::errc_failure;
+            auto const gen{m_tlb_shootdown->request(tls, *m_intrinsic)};
+            m_tlb_shootdown->park_page(tls, page, gen);
+
+            m_tlb_shootdown->reclaim(tls, *m_page_pool, *m_huge_pool);
+            return bsl::errc_success;
         }
 
         /// <!-- description -->
@@ -1362,6 +1923,8 @@ namespace mk
                 return {bsl::safe_uintmax::zero(true), bsl::safe_uintmax::zero(true)};
             }
 
+            m_tlb_shootdown->reclaim(tls, *m_page_pool, *m_huge_pool);
+
             auto const *const huge{m_huge_pool->template allocate<void>(tls, size)};
             if (bsl::unlikely(nullptr == huge)) {
                 bsl::print<bsl::V>() << bsl::here();
@@ -1417,17 +1980,70 @@ namespace mk
         ///     mapped it into the extension's address space.
         ///
         /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
         ///   @param huge_virt the virtual address to free
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
+        template<typename TLS_CONCEPT>
         [[nodiscard]] constexpr auto
-        free_huge(bsl::safe_uintmax const &huge_virt) &noexcept -> bsl::errc_type
+        free_huge(TLS_CONCEPT &tls, bsl::safe_uintmax const &huge_virt) &noexcept
+            -> bsl::errc_type
         {
-            bsl::discard(huge_virt);
+            bsl::errc_type ret{};
 
-            bsl::error() << "free_huge is currently unsupported\n" << bsl::here();
-            return bsl::errc_failure;
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "ext_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(huge_virt < EXT_PAGE_POOL_ADDR)) {
+                bsl::error() << "invalid virtual address: "    // --
+                             << bsl::hex(huge_virt)            // --
+                             << bsl::endl                      // --
+                             << bsl::here();                   // --
+
+                return bsl::errc_failure;
+            }
+
+            auto const huge_phys{huge_virt - EXT_PAGE_POOL_ADDR};
+            auto const size{
+                m_huge_pool->size(tls, m_huge_pool->template phys_to_virt<void>(huge_phys))};
+            if (bsl::unlikely(!size)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            /// NOTE:
+            /// - Each page is removed from the direct maps before it is
+            ///   given back to the huge pool. If the first page is not
+            ///   mapped into VM 0's direct map, the memory does not belong
+            ///   to this extension and nothing is freed.
+            /// - A single TLB shootdown covers the entire block, and the
+            ///   pages are only given back to the huge pool once every PP
+            ///   has flushed its TLB.
+            ///
+
+            for (bsl::safe_uintmax i{}; i < size; i += PAGE_SIZE) {
+                ret = this->unmap_direct_map_rpts(
+                    tls, huge_virt + i, MAP_PAGE_AUTO_RELEASE_ALLOC_HUGE);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+
+            auto const gen{m_tlb_shootdown->request(tls, *m_intrinsic)};
+            for (bsl::safe_uintmax i{}; i < size; i += PAGE_SIZE) {
+                m_tlb_shootdown->park_huge(
+                    tls, m_huge_pool->template phys_to_virt<void>(huge_phys + i), gen);
+            }
+
+            m_tlb_shootdown->reclaim(tls, *m_page_pool, *m_huge_pool);
+            return bsl::errc_success;
         }
 
         /// <!-- description -->
@@ -1534,7 +2150,9 @@ namespace mk
 
         /// <!-- description -->
         ///   @brief Maps a page into the direct map portion of the current
-        ///     direct map root page table that is active.
+        ///     direct map root page table that is active. Depending on
+        ///     EXT_DIRECT_MAP_FAULT_SIZE, this maps either the 4k page or
+        ///     the entire 2M page that contains the provided address.
         ///
         /// <!-- inputs/outputs -->
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
@@ -1574,6 +2192,37 @@ namespace mk
                 return bsl::errc_failure;
             }
 
+            auto *const faults{m_direct_map_faults.at_if(bsl::to_umax(tls.active_vmid))};
+            __atomic_add_fetch(faults, bsl::uint64{1}, __ATOMIC_RELAXED);
+
+            if constexpr (EXT_DIRECT_MAP_FAULT_SIZE == MAP_PAGE_2M_SIZE.get()) {
+                auto const large_virt{page_virt & ~(MAP_PAGE_2M_SIZE - bsl::ONE_UMAX)};
+
+                /// NOTE:
+                /// - If 4k pages are already mapped into this 2M range (e.g.,
+                ///   alloc_page memory in VM 0's direct map), the 2M page is
+                ///   not allowed, and we fall back to a 4k page.
+                ///
+
+                ret = direct_map_rpt->map_2m_page(
+                    tls, large_virt, large_virt - min_dm_addr, MAP_PAGE_READ | MAP_PAGE_WRITE);
+
+                if (ret == bsl::errc_success) {
+                    return ret;
+                }
+
+                if (ret == bsl::errc_already_exists) {
+                    return bsl::errc_success;
+                }
+
+                if (bsl::unlikely(ret != bsl::errc_precondition)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                bsl::touch();
+            }
+
             ret = direct_map_rpt->map_page_unaligned(
                 tls,
                 page_virt,
@@ -1593,6 +2242,55 @@ namespace mk
             return ret;
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the XSAVE area that holds this extension's FPU
+        ///     state on the current PP while the extension is not using the
+        ///     FPU. The area is allocated the first time the extension
+        ///     touches the FPU on a PP, so an extension that never uses the
+        ///     FPU never pays for it.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @return Returns the XSAVE area for the current PP, or a
+        ///     nullptr on failure.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        xsave_area(TLS_CONCEPT &tls) &noexcept -> xsave_area_t *
+        {
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "ext_t not initialized\n" << bsl::here();
+                return nullptr;
+            }
+
+            return this->get_xsave_area(tls, m_xsave_areas);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns an XSAVE area that can be used to set aside the
+        ///     root OS's FPU state on the current PP. This is only needed
+        ///     when this extension uses the FPU before a VPS has been
+        ///     initialized from the root OS's state on this PP.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @return Returns the XSAVE area for the current PP, or a
+        ///     nullptr on failure.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        root_xsave_area(TLS_CONCEPT &tls) &noexcept -> xsave_area_t *
+        {
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "ext_t not initialized\n" << bsl::here();
+                return nullptr;
+            }
+
+            return this->get_xsave_area(tls, m_root_xsave_areas);
+        }
+
         /// <!-- description -->
         ///   @brief Tells the extension that a VM was created so that it
         ///     can initialize it's VM specific resources.
@@ -1626,11 +2324,21 @@ namespace mk
                 return bsl::errc_failure;
             }
 
-            if (bsl::unlikely(!this->initialize_direct_map_rpt(tls, *rpt))) {
+            /// NOTE:
+            /// - Each direct map gets its own PCID so that switching
+            ///   between VMs does not flush the TLB. PCID 0 is left for
+            ///   the RPTs that are not tagged (e.g., the system RPT).
+            ///
+
+            auto const pcid{bsl::to_u16(
+                (bsl::to_umax(m_id) * MAX_VMS) + bsl::to_umax(vmid) + bsl::ONE_UMAX)};
+
+            if (bsl::unlikely(!this->initialize_direct_map_rpt(tls, *rpt, pcid))) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::errc_failure;
             }
 
+            *m_direct_map_faults.at_if(bsl::to_umax(vmid)) = {};
             return bsl::errc_success;
         }
 
@@ -1668,6 +2376,14 @@ namespace mk
             }
 
             rpt->release(tls);
+
+            /// NOTE:
+            /// - The PCID of this VM's direct map will be reused the next
+            ///   time this VMID is created, so any TLB entries that the
+            ///   PPs still have for it must be flushed before then.
+            ///
+
+            bsl::discard(m_tlb_shootdown->request(tls, *m_intrinsic));
             return bsl::errc_success;
         }
 
@@ -1937,6 +2653,23 @@ namespace mk
             bsl::print() << bsl::ylw << "| ";
             bsl::print() << bsl::rst << bsl::endl;
 
+            /// Direct Map Faults
+            ///
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"<14s", "dm faults "};
+            bsl::print() << bsl::ylw << "| ";
+            auto const *const faults{m_direct_map_faults.at_if(bsl::to_umax(tls.active_vmid))};
+            if (nullptr != faults) {
+                auto const count{__atomic_load_n(faults, __ATOMIC_RELAXED)};
+                bsl::print() << bsl::rst << bsl::fmt{"18d", count} << ' ';
+            }
+            else {
+                bsl::print() << bsl::red << bsl::fmt{"^19s", "invalid vm "};
+            }
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
             /// Footer
             ///
 
@@ -32,10 +32,13 @@
 #include <mk_main.hpp>
 #include <page_pool_t.hpp>
 #include <root_page_table_t.hpp>
+#include <tlb_shootdown_t.hpp>
 #include <tls_t.hpp>
+#include <trace_t.hpp>
 #include <vm_pool_t.hpp>
 #include <vm_t.hpp>
 #include <vmexit_log_t.hpp>
+#include <vmexit_stats_t.hpp>
 #include <vp_pool_t.hpp>
 #include <vp_t.hpp>
 #include <vps_pool_t.hpp>
@@ -65,18 +68,33 @@ namespace mk
         bsl::to_umax(HYPERVISOR_VMEXIT_LOG_SIZE).get(),    // --
         bsl::to_umax(HYPERVISOR_MAX_PPS).get()>;           // --
 
+    /// @brief defines the VMExit stats type to use
+    using mk_vmexit_stats_type = vmexit_stats_t<             // --
+        bsl::to_umax(HYPERVISOR_VMEXIT_STATS_SIZE).get(),    // --
+        bsl::to_umax(HYPERVISOR_MAX_PPS).get()>;             // --
+
+    /// @brief defines the trace type to use
+    using mk_trace_type = trace_t<                    // --
+        bsl::to_umax(HYPERVISOR_TRACE_SIZE).get(),    // --
+        bsl::to_umax(HYPERVISOR_MAX_PPS).get()>;      // --
+
     /// @brief defines the intrinsic type
     using mk_intrinsic_type = intrinsic_t;
 
     /// @brief defines the page pool type
-    using mk_page_pool_type = page_pool_t<                    // --
-        bsl::to_umax(HYPERVISOR_PAGE_SIZE).get(),             // --
-        bsl::to_umax(HYPERVISOR_MK_PAGE_POOL_ADDR).get()>;    // --
+    using mk_page_pool_type = page_pool_t<                              // --
+        bsl::to_umax(HYPERVISOR_PAGE_SIZE).get(),                       // --
+        bsl::to_umax(HYPERVISOR_MK_PAGE_POOL_ADDR).get(),               // --
+        bsl::to_umax(HYPERVISOR_MK_DIRECT_MAP_SIZE).get(),              // --
+        bsl::to_umax(HYPERVISOR_MAX_PPS).get(),                         // --
+        bsl::to_umax(HYPERVISOR_MAX_NUMA_NODES).get(),                  // --
+        bsl::to_umax(HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK).get()>;    // --
 
     /// @brief defines the huge pool type
-    using mk_huge_pool_type = huge_pool_t<                    // --
-        bsl::to_umax(HYPERVISOR_PAGE_SIZE).get(),             // --
-        bsl::to_umax(HYPERVISOR_MK_HUGE_POOL_ADDR).get()>;    // --
+    using mk_huge_pool_type = huge_pool_t<                         // --
+        bsl::to_umax(HYPERVISOR_PAGE_SIZE).get(),                  // --
+        bsl::to_umax(HYPERVISOR_MK_HUGE_POOL_ADDR).get(),          // --
+        bsl::to_umax(HYPERVISOR_MAX_HUGE_POOL_SEGMENTS).get()>;    // --
 
     /// @brief defines the VPS type to use
     using mk_vps_type = vps_t;    // --
@@ -84,7 +102,8 @@ namespace mk
     /// @brief defines the VPS pool type to use
     using mk_vps_pool_type = vps_pool_t<             // --
         mk_vps_type,                                 // --
-        bsl::to_umax(HYPERVISOR_MAX_VPSS).get()>;    // --
+        bsl::to_umax(HYPERVISOR_MAX_VPSS).get(),     // --
+        bsl::to_umax(HYPERVISOR_MAX_VPS).get()>;     // --
 
     /// @brief defines the VP type to use
     using mk_vp_type = vp_t;    // --
@@ -92,7 +111,8 @@ namespace mk
     /// @brief defines the VP pool type to use
     using mk_vp_pool_type = vp_pool_t<              // --
         mk_vp_type,                                 // --
-        bsl::to_umax(HYPERVISOR_MAX_VPS).get()>;    // --
+        bsl::to_umax(HYPERVISOR_MAX_VPS).get(),     // --
+        bsl::to_umax(HYPERVISOR_MAX_VMS).get()>;    // --
 
     /// @brief defines the VM type to use
     using mk_vm_type = vm_t<                        // --
@@ -111,29 +131,37 @@ namespace mk
         bsl::to_umax(HYPERVISOR_PAGE_SIZE).get(),         // --
         bsl::to_umax(HYPERVISOR_PAGE_SHIFT).get()>;       // --
 
+    /// @brief defines the TLB shootdown type to use
+    using mk_tlb_shootdown_type = tlb_shootdown_t<    // --
+        bsl::to_umax(HYPERVISOR_MAX_PPS).get()>;      // --
+
     /// @brief defines the extension type to use
-    using mk_ext_type = ext_t<                                 // --
-        mk_intrinsic_type,                                     // --
-        mk_page_pool_type,                                     // --
-        mk_huge_pool_type,                                     // --
-        mk_root_page_table_type,                               // --
-        bsl::to_umax(HYPERVISOR_PAGE_SIZE).get(),              // --
-        bsl::to_umax(HYPERVISOR_MAX_PPS).get(),                // --
-        bsl::to_umax(HYPERVISOR_MAX_VMS).get(),                // --
-        bsl::to_umax(HYPERVISOR_EXT_DIRECT_MAP_ADDR).get(),    // --
-        bsl::to_umax(HYPERVISOR_EXT_DIRECT_MAP_SIZE).get(),    // --
-        bsl::to_umax(HYPERVISOR_EXT_STACK_ADDR).get(),         // --
-        bsl::to_umax(HYPERVISOR_EXT_STACK_SIZE).get(),         // --
-        bsl::to_umax(HYPERVISOR_EXT_CODE_ADDR).get(),          // --
-        bsl::to_umax(HYPERVISOR_EXT_CODE_SIZE).get(),          // --
-        bsl::to_umax(HYPERVISOR_EXT_TLS_ADDR).get(),           // --
-        bsl::to_umax(HYPERVISOR_EXT_TLS_SIZE).get(),           // --
-        bsl::to_umax(HYPERVISOR_EXT_PAGE_POOL_ADDR).get(),     // --
-        bsl::to_umax(HYPERVISOR_EXT_PAGE_POOL_SIZE).get(),     // --
-        bsl::to_umax(HYPERVISOR_EXT_HUGE_POOL_ADDR).get(),     // --
-        bsl::to_umax(HYPERVISOR_EXT_HUGE_POOL_SIZE).get(),     // --
-        bsl::to_umax(HYPERVISOR_EXT_HEAP_POOL_ADDR).get(),     // --
-        bsl::to_umax(HYPERVISOR_EXT_HEAP_POOL_SIZE).get()>;    // --
+    using mk_ext_type = ext_t<                                        // --
+        mk_intrinsic_type,                                            // --
+        mk_page_pool_type,                                            // --
+        mk_huge_pool_type,                                            // --
+        mk_root_page_table_type,                                      // --
+        mk_tlb_shootdown_type,                                        // --
+        mk_trace_type,                                                // --
+        bsl::to_umax(HYPERVISOR_PAGE_SIZE).get(),                     // --
+        bsl::to_umax(HYPERVISOR_MAX_PPS).get(),                       // --
+        bsl::to_umax(HYPERVISOR_MAX_VMS).get(),                       // --
+        bsl::to_umax(HYPERVISOR_EXT_DIRECT_MAP_ADDR).get(),           // --
+        bsl::to_umax(HYPERVISOR_EXT_DIRECT_MAP_SIZE).get(),           // --
+        bsl::to_umax(HYPERVISOR_EXT_DIRECT_MAP_FAULT_SIZE).get(),     // --
+        bsl::to_umax(HYPERVISOR_EXT_DIRECT_MAP_PREMAP_SIZE).get(),    // --
+        bsl::to_umax(HYPERVISOR_EXT_STACK_ADDR).get(),                // --
+        bsl::to_umax(HYPERVISOR_EXT_STACK_SIZE).get(),                // --
+        bsl::to_umax(HYPERVISOR_EXT_CODE_ADDR).get(),                 // --
+        bsl::to_umax(HYPERVISOR_EXT_CODE_SIZE).get(),                 // --
+        bsl::to_umax(HYPERVISOR_EXT_TLS_ADDR).get(),                  // --
+        bsl::to_umax(HYPERVISOR_EXT_TLS_SIZE).get(),                  // --
+        bsl::to_umax(HYPERVISOR_EXT_PAGE_POOL_ADDR).get(),            // --
+        bsl::to_umax(HYPERVISOR_EXT_PAGE_POOL_SIZE).get(),            // --
+        bsl::to_umax(HYPERVISOR_EXT_HUGE_POOL_ADDR).get(),            // --
+        bsl::to_umax(HYPERVISOR_EXT_HUGE_POOL_SIZE).get(),            // --
+        bsl::to_umax(HYPERVISOR_EXT_HEAP_POOL_ADDR).get(),            // --
+        bsl::to_umax(HYPERVISOR_EXT_HEAP_POOL_SIZE).get()>;           // --
 
     /// @brief defines the extension pool type to use
     using mk_ext_pool_type = ext_pool_t<                   // --
@@ -142,6 +170,8 @@ namespace mk
         mk_page_pool_type,                                 // --
         mk_huge_pool_type,                                 // --
         mk_root_page_table_type,                           // --
+        mk_tlb_shootdown_type,                             // --
+        mk_trace_type,                                     // --
         bsl::to_umax(HYPERVISOR_MAX_EXTENSIONS).get()>;    // --
 
     /// @brief defines the extension pool type to use
@@ -166,6 +196,12 @@ namespace mk
     /// @brief stores the vmexit log used by the microkernel
     constinit inline mk_vmexit_log_type g_vmexit_log{};
 
+    /// @brief stores the vmexit stats used by the microkernel
+    constinit inline mk_vmexit_stats_type g_vmexit_stats{};
+
+    /// @brief stores the trace used by the microkernel
+    constinit inline mk_trace_type g_trace{};
+
     /// @brief stores the intrinsics used by the microkernel
     constinit inline mk_intrinsic_type g_intrinsic{};
 
@@ -187,9 +223,12 @@ namespace mk
     /// @brief stores the system RPT provided by the loader
     constinit inline mk_root_page_table_type g_system_rpt{};
 
+    /// @brief stores the TLB shootdown used by the microkernel
+    constinit inline mk_tlb_shootdown_type g_tlb_shootdown{};
+
     /// @brief stores the ext_t pool used by the microkernel
     constinit inline mk_ext_pool_type g_ext_pool{
-        g_intrinsic, g_page_pool, g_huge_pool, g_system_rpt};
+        g_intrinsic, g_page_pool, g_huge_pool, g_system_rpt, g_tlb_shootdown, g_trace};
 
     /// @brief stores the microkernel's main class
     constinit inline mk_main_type g_mk_main{
@@ -0,0 +1,603 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef HUGE_POOL_SEGMENT_T_HPP
+#define HUGE_POOL_SEGMENT_T_HPP
+
+#include <huge_pool_page_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/byte.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstring.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace mk
+{
+    /// @brief stores the max number of block orders the huge pool supports
+    constexpr bsl::safe_uintmax HUGE_POOL_MAX_ORDERS{bsl::to_umax(32)};
+    /// @brief defines an invalid page index (i.e., the end of a free list)
+    constexpr bsl::safe_uint32 HUGE_POOL_INVALID_IDX{bsl::to_u32(0xFFFFFFFFU)};
+
+    /// @class mk::huge_pool_segment_t
+    ///
+    /// <!-- description -->
+    ///   @brief Manages a single physically contiguous segment of the huge
+    ///     pool (which belongs to a single NUMA node) using a binary buddy
+    ///     allocator. Memory is handed out in blocks of 2^order pages, and
+    ///     each order has its own free list. An allocation takes the
+    ///     smallest free block that fits, splitting larger blocks as
+    ///     needed, and when a block is freed, it is merged with its buddy
+    ///     for as long as the buddy is also free, which keeps physically
+    ///     contiguous runs available over time.
+    ///
+    ///     The metadata for each page (see huge_pool_page_t) is stored at
+    ///     the end of the segment itself, which means the free lists never
+    ///     have to touch the memory that they are managing. Memory that is
+    ///     mapped into an extension is released by the page tables one page
+    ///     at a time, so each allocated block keeps track of how many of its
+    ///     pages are still in use, and the block is only returned to the
+    ///     free lists once all of them have been freed.
+    ///
+    ///     A segment does not have a lock of its own. The huge pool holds
+    ///     its lock while calling into any of its segments.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam PAGE_SIZE defines the size of a page
+    ///
+    template<bsl::uintmax PAGE_SIZE>
+    class huge_pool_segment_t final
+    {
+        /// @brief stores the range of memory used by this segment
+        bsl::span<bsl::byte> m_pool{};
+        /// @brief stores the metadata for each page in m_pool
+        bsl::span<huge_pool_page_t> m_pages{};
+        /// @brief stores the head of the free list for each order
+        bsl::array<bsl::uint32, HUGE_POOL_MAX_ORDERS.get()> m_free{};
+        /// @brief stores the number of bytes in allocated blocks
+        bsl::safe_uintmax m_usd{};
+        /// @brief stores the number of bytes that were actually requested
+        bsl::safe_uintmax m_req{};
+        /// @brief stores the NUMA node that this segment was allocated from
+        bsl::safe_uint16 m_node{};
+
+        /// <!-- description -->
+        ///   @brief Returns the number of pages in a block of the provided
+        ///     order.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param order the order of the block
+        ///   @return Returns the number of pages in a block of the provided
+        ///     order.
+        ///
+        [[nodiscard]] static constexpr auto
+        pages_in_order(bsl::safe_uintmax const &order) noexcept -> bsl::safe_uintmax
+        {
+            return bsl::ONE_UMAX << order;
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds the block starting at the provided page index to
+        ///     the free list of the provided order.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param idx the index of the first page in the block
+        ///   @param order the order of the block
+        ///
+        constexpr void
+        push_block(bsl::safe_uintmax const &idx, bsl::safe_uintmax const &order) &noexcept
+        {
+            auto *const page{m_pages.at_if(idx)};
+            auto *const head{m_free.at_if(order)};
+
+            page->next = *head;
+            page->prev = HUGE_POOL_INVALID_IDX.get();
+            page->order = bsl::to_u8(order).get();
+            page->free = true;
+
+            if (HUGE_POOL_INVALID_IDX.get() != page->next) {
+                m_pages.at_if(bsl::to_umax(page->next))->prev = bsl::to_u32(idx).get();
+            }
+            else {
+                bsl::touch();
+            }
+
+            *head = bsl::to_u32(idx).get();
+        }
+
+        /// <!-- description -->
+        ///   @brief Removes the free block starting at the provided page
+        ///     index from its free list.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param idx the index of the first page in the block
+        ///
+        constexpr void
+        remove_block(bsl::safe_uintmax const &idx) &noexcept
+        {
+            auto *const page{m_pages.at_if(idx)};
+
+            if (HUGE_POOL_INVALID_IDX.get() != page->prev) {
+                m_pages.at_if(bsl::to_umax(page->prev))->next = page->next;
+            }
+            else {
+                *m_free.at_if(bsl::to_umax(page->order)) = page->next;
+            }
+
+            if (HUGE_POOL_INVALID_IDX.get() != page->next) {
+                m_pages.at_if(bsl::to_umax(page->next))->prev = page->prev;
+            }
+            else {
+                bsl::touch();
+            }
+
+            page->next = HUGE_POOL_INVALID_IDX.get();
+            page->prev = HUGE_POOL_INVALID_IDX.get();
+            page->free = false;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns a block to the free lists, merging it with its
+        ///     buddy for as long as the buddy is also free.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param idx the index of the first page in the block
+        ///   @param order the order of the block
+        ///
+        constexpr void
+        free_block(bsl::safe_uintmax const &idx, bsl::safe_uintmax const &order) &noexcept
+        {
+            auto blk{idx};
+            auto ord{order};
+
+            while ((ord + bsl::ONE_UMAX) < HUGE_POOL_MAX_ORDERS) {
+                auto const bdy{blk ^ pages_in_order(ord)};
+                auto const *const buddy{m_pages.at_if(bdy)};
+
+                /// NOTE:
+                /// - The pool is not required to be a power of two in size,
+                ///   so the buddy might not exist. If it does exist, it can
+                ///   only be merged if it is the head of a free block of the
+                ///   same order (i.e., it has not been split).
+                ///
+
+                if (nullptr == buddy) {
+                    break;
+                }
+
+                if (!buddy->free) {
+                    break;
+                }
+
+                if (bsl::to_umax(buddy->order) != ord) {
+                    break;
+                }
+
+                this->remove_block(bdy);
+                if (bdy < blk) {
+                    blk = bdy;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                ++ord;
+            }
+
+            this->push_block(blk, ord);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the index of the page that the provided pointer
+        ///     points to, or bsl::safe_uintmax::zero(true) if the pointer
+        ///     is not a page in this pool.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ptr the pointer to convert
+        ///   @return Returns the index of the page that the provided pointer
+        ///     points to, or bsl::safe_uintmax::zero(true) on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        ptr_to_idx(void const *const ptr) const &noexcept -> bsl::safe_uintmax
+        {
+            auto const addr{bsl::to_umax(ptr)};
+            auto const base{bsl::to_umax(m_pool.data())};
+
+            if (bsl::unlikely(addr < base)) {
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            auto const offs{addr - base};
+            if (bsl::unlikely(offs >= m_pool.size())) {
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            if (bsl::unlikely((offs % PAGE_SIZE) != bsl::ZERO_UMAX)) {
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            return offs / PAGE_SIZE;
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Initializes the segment given a mutable_buffer_t to
+        ///     the memory that it manages.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param pool the mutable_buffer_t of the segment
+        ///   @param node the NUMA node the segment was allocated from
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        initialize(bsl::span<bsl::byte> const &pool, bsl::safe_uint16 const &node) &noexcept
+            -> bsl::errc_type
+        {
+            /// NOTE:
+            /// - The metadata is carved off of the end of the segment so
+            ///   that the remaining memory starts at the (aligned) start of
+            ///   the segment, which is what the buddy math is relative to.
+            ///
+
+            auto const total{pool.size() / PAGE_SIZE};
+            auto meta{(total * sizeof(huge_pool_page_t)) / PAGE_SIZE};
+            if (((total * sizeof(huge_pool_page_t)) % PAGE_SIZE) != bsl::ZERO_UMAX) {
+                ++meta;
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (bsl::unlikely(meta >= total)) {
+                bsl::error() << "pool is too small: "    // --
+                             << bsl::hex(pool.size())    // --
+                             << bsl::endl                // --
+                             << bsl::here();             // --
+
+                return bsl::errc_failure;
+            }
+
+            auto const usable{total - meta};
+            auto *const meta_ptr{pool.at_if(usable * PAGE_SIZE)};
+
+            bsl::builtin_memset(meta_ptr, '\0', meta * PAGE_SIZE);
+
+            m_pool = {pool.data(), usable * PAGE_SIZE};
+            m_pages = {static_cast<huge_pool_page_t *>(static_cast<void *>(meta_ptr)), usable};
+            m_node = node;
+
+            for (auto const elem : m_free) {
+                *elem.data = HUGE_POOL_INVALID_IDX.get();
+            }
+
+            /// NOTE:
+            /// - Hand the segment to the free lists using the largest
+            ///   aligned block that fits at each offset.
+            ///
+
+            bsl::safe_uintmax idx{};
+            while (idx < usable) {
+                auto ord{HUGE_POOL_MAX_ORDERS - bsl::ONE_UMAX};
+                while (!ord.is_zero()) {
+                    auto const pgs{pages_in_order(ord)};
+                    if ((idx % pgs).is_zero() && ((idx + pgs) <= usable)) {
+                        break;
+                    }
+
+                    --ord;
+                }
+
+                this->push_block(idx, ord);
+                idx += pages_in_order(ord);
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Release the huge_pool_segment_t
+        ///
+        constexpr void
+        release() &noexcept
+        {
+            for (auto const elem : m_free) {
+                *elem.data = {};
+            }
+
+            m_req = {};
+            m_usd = {};
+            m_pages = {};
+            m_pool = {};
+            m_node = {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the segment was not given any memory
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns true if the segment was not given any memory
+        ///
+        [[nodiscard]] constexpr auto
+        empty() const &noexcept -> bool
+        {
+            return m_pool.empty();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the NUMA node this segment was allocated from
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the NUMA node this segment was allocated from
+        ///
+        [[nodiscard]] constexpr auto
+        node() const &noexcept -> bsl::safe_uint16 const &
+        {
+            return m_node;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided pointer points to a page
+        ///     in this segment.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ptr the pointer to check
+        ///   @return Returns true if the provided pointer points to a page
+        ///     in this segment.
+        ///
+        [[nodiscard]] constexpr auto
+        contains(void const *const ptr) const &noexcept -> bool
+        {
+            return !!this->ptr_to_idx(ptr);
+        }
+
+        /// <!-- description -->
+        ///   @brief Allocates the provided number of physically contiguous
+        ///     pages from the segment. Unlike the huge pool, running out of
+        ///     memory is not reported as an error as the huge pool might be
+        ///     able to use another segment instead.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param pages the total number of pages to allocate.
+        ///   @return Returns a pointer to the newly allocated memory, or
+        ///     a nullptr if the segment does not have a free block that
+        ///     is large enough.
+        ///
+        [[nodiscard]] constexpr auto
+        allocate(bsl::safe_uintmax const &pages) &noexcept -> void *
+        {
+            if (pages > m_pages.size()) {
+                return nullptr;
+            }
+
+            bsl::safe_uintmax order{};
+            while (pages_in_order(order) < pages) {
+                ++order;
+            }
+
+            auto ord{order};
+            while (ord < HUGE_POOL_MAX_ORDERS) {
+                if (HUGE_POOL_INVALID_IDX.get() != *m_free.at_if(ord)) {
+                    break;
+                }
+
+                ++ord;
+            }
+
+            if (ord >= HUGE_POOL_MAX_ORDERS) {
+                return nullptr;
+            }
+
+            auto const blk{bsl::to_umax(*m_free.at_if(ord))};
+            this->remove_block(blk);
+
+            while (ord > order) {
+                --ord;
+                this->push_block(blk + pages_in_order(ord), ord);
+            }
+
+            for (bsl::safe_uintmax i{}; i < pages_in_order(order); ++i) {
+                auto *const page{m_pages.at_if(blk + i)};
+                page->head = bsl::to_u32(blk).get();
+                page->used = (i < pages);
+            }
+
+            auto *const head{m_pages.at_if(blk)};
+            head->order = bsl::to_u8(order).get();
+            head->size = bsl::to_u32(pages).get();
+            head->live = bsl::to_u32(pages).get();
+
+            m_usd += pages_in_order(order) * PAGE_SIZE;
+            m_req += pages * PAGE_SIZE;
+
+            return m_pool.at_if(blk * PAGE_SIZE);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns a page of memory previously allocated using the
+        ///     allocate function to the segment. Once all of the pages of
+        ///     an allocation are freed, the block is merged back into the
+        ///     segment.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ptr the pointer to the page to deallocate
+        ///
+        constexpr void
+        deallocate(void const *const ptr) &noexcept
+        {
+            auto const idx{this->ptr_to_idx(ptr)};
+            if (bsl::unlikely(!idx)) {
+                bsl::error() << "invalid ptr "    // --
+                             << ptr               // --
+                             << bsl::endl         // --
+                             << bsl::here();      // --
+
+                return;
+            }
+
+            auto *const page{m_pages.at_if(idx)};
+            if (bsl::unlikely(!page->used)) {
+                bsl::error() << "ptr "                  // --
+                             << ptr                     // --
+                             << " was not allocated"    // --
+                             << bsl::endl               // --
+                             << bsl::here();            // --
+
+                return;
+            }
+
+            page->used = false;
+            m_req -= PAGE_SIZE;
+
+            auto const blk{bsl::to_umax(page->head)};
+            auto *const head{m_pages.at_if(blk)};
+
+            --head->live;
+            if (bsl::to_umax(head->live).is_pos()) {
+                return;
+            }
+
+            auto const order{bsl::to_umax(head->order)};
+            m_usd -= pages_in_order(order) * PAGE_SIZE;
+
+            this->free_block(blk, order);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the number of bytes that were requested when
+        ///     the provided memory was allocated. The provided pointer must
+        ///     be the pointer that was returned by allocate.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ptr the pointer returned by allocate
+        ///   @return Returns the number of bytes that were requested when
+        ///     the provided memory was allocated, or
+        ///     bsl::safe_uintmax::zero(true) on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        size(void const *const ptr) const &noexcept -> bsl::safe_uintmax
+        {
+            auto const idx{this->ptr_to_idx(ptr)};
+            if (bsl::unlikely(!idx)) {
+                bsl::error() << "invalid ptr "    // --
+                             << ptr               // --
+                             << bsl::endl         // --
+                             << bsl::here();      // --
+
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            auto const *const page{m_pages.at_if(idx)};
+            if (bsl::unlikely(!page->used || (bsl::to_umax(page->head) != idx))) {
+                bsl::error() << "ptr "                                  // --
+                             << ptr                                     // --
+                             << " is not the start of an allocation"    // --
+                             << bsl::endl                               // --
+                             << bsl::here();                            // --
+
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            return bsl::to_umax(page->size) * PAGE_SIZE;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the total number of bytes the segment manages
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the total number of bytes the segment manages
+        ///
+        [[nodiscard]] constexpr auto
+        total() const &noexcept -> bsl::safe_uintmax
+        {
+            return m_pool.size();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the number of bytes in allocated blocks
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the number of bytes in allocated blocks
+        ///
+        [[nodiscard]] constexpr auto
+        used() const &noexcept -> bsl::safe_uintmax const &
+        {
+            return m_usd;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the number of bytes that were actually requested
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the number of bytes that were actually requested
+        ///
+        [[nodiscard]] constexpr auto
+        requested() const &noexcept -> bsl::safe_uintmax const &
+        {
+            return m_req;
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds the number of free blocks of each order in this
+        ///     segment to the provided array, and returns the size of the
+        ///     largest free block in bytes.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param blks the array to add the number of free blocks to
+        ///   @return Returns the size of the largest free block in bytes
+        ///
+        [[nodiscard]] constexpr auto
+        free_blocks(bsl::array<bsl::safe_uintmax, HUGE_POOL_MAX_ORDERS.get()> &blks)
+            const &noexcept -> bsl::safe_uintmax
+        {
+            bsl::safe_uintmax largest{};
+
+            for (bsl::safe_uintmax ord{}; ord < HUGE_POOL_MAX_ORDERS; ++ord) {
+                bsl::safe_uintmax num{};
+
+                auto idx{*m_free.at_if(ord)};
+                while (HUGE_POOL_INVALID_IDX.get() != idx) {
+                    ++num;
+                    idx = m_pages.at_if(bsl::to_umax(idx))->next;
+                }
+
+                if (num.is_zero()) {
+                    continue;
+                }
+
+                *blks.at_if(ord) += num;
+                largest = pages_in_order(ord) * PAGE_SIZE;
+            }
+
+            return largest;
+        }
+    };
+}
+
+#endif
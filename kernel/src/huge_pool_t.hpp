@@ -25,19 +25,24 @@
 #ifndef HUGE_POOL_T_HPP
 #define HUGE_POOL_T_HPP
 
+#include <huge_pool_segment_t.hpp>
 #include <lock_guard.hpp>
 #include <spinlock.hpp>
 
+#include <bsl/array.hpp>
 #include <bsl/byte.hpp>
 #include <bsl/construct_at.hpp>
 #include <bsl/convert.hpp>
-#include <bsl/discard.hpp>
+#include <bsl/cstring.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/disjunction.hpp>
 #include <bsl/errc_type.hpp>
 #include <bsl/finally.hpp>
 #include <bsl/is_standard_layout.hpp>
 #include <bsl/is_void.hpp>
 #include <bsl/safe_integral.hpp>
 #include <bsl/span.hpp>
+#include <bsl/string_view.hpp>
 #include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 
@@ -50,27 +55,103 @@ namespace mk
     ///     memory. The amount of memory that is available is really, really
     ///     small (likely no more than 1 MB), but some is needed for different
     ///     architectures that require it like AMD. This memory is only needed
-    ///     by the extensions, and we currently do not support the ability
-    ///     to free memory, so there is no need to over complicate how this
-    ///     allocator works. We simply use a cursor that is always increasing.
-    ///     Once you allocate all of the memory, that is it.
+    ///     by the extensions.
+    ///
+    ///     The loader hands the huge pool to the microkernel as one or more
+    ///     physically contiguous segments per NUMA node (e.g., when the
+    ///     root OS is too fragmented to allocate a node's huge pool all at
+    ///     once), and each segment is managed by its own binary buddy
+    ///     allocator (see huge_pool_segment_t). Allocations are served from
+    ///     the segments of the calling PP's node and only fall back to the
+    ///     other nodes when none of those segments can satisfy the
+    ///     allocation. Since every allocation comes from a single segment,
+    ///     memory is always freed back to the segment (and therefore the
+    ///     node) that it came from.
     ///
     /// <!-- template parameters -->
     ///   @tparam PAGE_SIZE defines the size of a page
     ///   @tparam MK_HUGE_POOL_ADDR defines the base address of the huge pool
+    ///   @tparam MAX_SEGMENTS the max number of segments in the huge pool
     ///
-    template<bsl::uintmax PAGE_SIZE, bsl::uintmax MK_HUGE_POOL_ADDR>
+    template<bsl::uintmax PAGE_SIZE, bsl::uintmax MK_HUGE_POOL_ADDR, bsl::uintmax MAX_SEGMENTS>
     class huge_pool_t final
     {
         /// @brief stores true if initialized() has been executed
         bool m_initialized{};
-        /// @brief stores the range of memory used by this allocator
-        bsl::span<bsl::byte> m_pool{};
-        /// @brief stores the huge pool's cursor
-        bsl::safe_uintmax m_crsr{};
+        /// @brief stores the physically contiguous segments of the huge pool
+        bsl::array<huge_pool_segment_t<PAGE_SIZE>, MAX_SEGMENTS> m_segments{};
         /// @brief safe guards operations on the pool.
         mutable spinlock m_lock{};
 
+        /// <!-- description -->
+        ///   @brief Returns the segment that the provided pointer points
+        ///     into, or a nullptr if the pointer is not a page in any of
+        ///     the segments.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ptr the pointer to look up
+        ///   @return Returns the segment that the provided pointer points
+        ///     into, or a nullptr on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        ptr_to_segment(void const *const ptr) const &noexcept
+            -> huge_pool_segment_t<PAGE_SIZE> const *
+        {
+            for (auto const elem : m_segments) {
+                if (elem.data->contains(ptr)) {
+                    return elem.data;
+                }
+
+                bsl::touch();
+            }
+
+            return nullptr;
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs a single row of the dump
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param str the description of the row
+        ///   @param bytes the number of bytes to output
+        ///
+        static constexpr void
+        dump_bytes(bsl::string_view const &str, bsl::safe_uintmax const &bytes) noexcept
+        {
+            constexpr auto kb{bsl::to_umax(1024)};
+            constexpr auto mb{bsl::to_umax(1024) * bsl::to_umax(1024)};
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"<12s", str};
+            bsl::print() << bsl::ylw << "| ";
+            if ((bytes / mb).is_zero()) {
+                bsl::print() << bsl::rst << bsl::fmt{"4d", bytes / kb} << " KB ";
+            }
+            else {
+                bsl::print() << bsl::rst << bsl::fmt{"4d", bytes / mb} << " MB ";
+            }
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs a single row of the dump
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param str the description of the row
+        ///   @param count the count to output
+        ///
+        static constexpr void
+        dump_count(bsl::string_view const &str, bsl::safe_uintmax const &count) noexcept
+        {
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"<12s", str};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"7d", count} << " ";
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+        }
+
     public:
         /// <!-- description -->
         ///   @brief Default constructor
@@ -79,16 +160,20 @@ namespace mk
 
         /// <!-- description -->
         ///   @brief Creates the huge pool given a mutable_buffer_t to
-        ///     the huge pool as well as the virtual address base of the
-        ///     huge pool which is used for virt to phys translations.
+        ///     each of the huge pool's segments, and the NUMA node that
+        ///     each segment was allocated from. Unused segments are given
+        ///     an empty mutable_buffer_t.
         ///
         /// <!-- inputs/outputs -->
-        ///   @param pool the mutable_buffer_t of the huge pool
+        ///   @param pools the mutable_buffer_t of each segment
+        ///   @param nodes the NUMA node of each segment
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
         [[nodiscard]] constexpr auto
-        initialize(bsl::span<bsl::byte> &pool) &noexcept -> bsl::errc_type
+        initialize(
+            bsl::array<bsl::span<bsl::byte>, MAX_SEGMENTS> &pools,
+            bsl::array<bsl::uint16, MAX_SEGMENTS> const &nodes) &noexcept -> bsl::errc_type
         {
             if (bsl::unlikely(m_initialized)) {
                 bsl::error() << "huge_pool_t already initialized\n" << bsl::here();
@@ -99,13 +184,27 @@ namespace mk
                 this->release();
             }};
 
-            if (bsl::unlikely(pool.empty())) {
+            bool empty{true};
+            for (bsl::safe_uintmax i{}; i < pools.size(); ++i) {
+                auto const *const pool{pools.at_if(i)};
+                if (pool->empty()) {
+                    continue;
+                }
+
+                auto const node{bsl::to_u16(*nodes.at_if(i))};
+                if (bsl::unlikely(!m_segments.at_if(i)->initialize(*pool, node))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                empty = false;
+            }
+
+            if (bsl::unlikely(empty)) {
                 bsl::error() << "pool is empty\n" << bsl::here();
                 return bsl::errc_failure;
             }
 
-            m_pool = pool;
-
             release_on_error.ignore();
             m_initialized = true;
 
@@ -118,8 +217,9 @@ namespace mk
         constexpr void
         release() &noexcept
         {
-            m_crsr = bsl::safe_uintmax::zero(true);
-            m_pool = {};
+            for (auto const elem : m_segments) {
+                elem.data->release();
+            }
 
             m_initialized = {};
         }
@@ -166,7 +266,8 @@ namespace mk
             -> huge_pool_t & = default;
 
         /// <!-- description -->
-        ///   @brief Allocates memory from the huge pool.
+        ///   @brief Allocates memory from the huge pool, preferring the
+        ///     segments of the calling PP's NUMA node.
         ///
         /// <!-- inputs/outputs -->
         ///   @tparam T the type of pointer to return
@@ -203,7 +304,45 @@ namespace mk
                 bsl::touch();
             }
 
-            if (bsl::unlikely(m_pool.at_if(m_crsr + (pages * PAGE_SIZE)) == nullptr)) {
+            /// NOTE:
+            /// - The first pass only looks at the segments that belong to
+            ///   the calling PP's node. The second pass looks at the rest.
+            ///
+
+            void *ptr{};
+            auto const local{bsl::to_u16(tls.node)};
+            for (auto const elem : m_segments) {
+                if (elem.data->empty() || elem.data->node() != local) {
+                    continue;
+                }
+
+                ptr = elem.data->allocate(pages);
+                if (nullptr != ptr) {
+                    break;
+                }
+
+                bsl::touch();
+            }
+
+            if (nullptr == ptr) {
+                for (auto const elem : m_segments) {
+                    if (elem.data->empty() || elem.data->node() == local) {
+                        continue;
+                    }
+
+                    ptr = elem.data->allocate(pages);
+                    if (nullptr != ptr) {
+                        break;
+                    }
+
+                    bsl::touch();
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (bsl::unlikely(nullptr == ptr)) {
                 bsl::error() << "huge pool out of memory: "    // --
                              << bsl::hex(size)                 // --
                              << bsl::endl                      // --
@@ -212,9 +351,6 @@ namespace mk
                 return nullptr;
             }
 
-            void *const ptr{m_pool.at_if(m_crsr)};
-            m_crsr += (pages * PAGE_SIZE);
-
             bsl::builtin_memset(ptr, '\0', size);
 
             if constexpr (!bsl::is_void<T>::value) {
@@ -226,37 +362,83 @@ namespace mk
         }
 
         /// <!-- description -->
-        ///   @brief Not supported
+        ///   @brief Returns a page of memory previously allocated using the
+        ///     allocate function to the huge pool. Memory is freed one page
+        ///     at a time, meaning that to free an allocation of N pages, this
+        ///     function must be called once for each page (which is how the
+        ///     page tables release this memory). Once all of the pages of an
+        ///     allocation are freed, the block is merged back into the pool.
         ///
         /// <!-- inputs/outputs -->
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @param tls the current TLS block
-        ///   @param ptr the pointer to the memory to deallocate
+        ///   @param ptr the pointer to the page to deallocate
         ///
         template<typename TLS_CONCEPT>
         constexpr void
         deallocate(TLS_CONCEPT &tls, void *const ptr) &noexcept
         {
             lock_guard lock{tls, m_lock};
-            bsl::discard(ptr);
 
-            /// NOTE:
-            /// - If this function is implemented, we will have to deal with
-            ///   deallocations being a page in size. Specifically, right now
-            ///   a huge page is allocated and mapped into the page tables
-            ///   one page at a time. When is is time to deallocate, this
-            ///   memory is released one page at a time. If the page tables
-            ///   are deallocating one page of a larger physically contiguous
-            ///   memory region, it should be assumed that the entire region
-            ///   will be freed, it will just happen in page increments.
-            /// - What this means is this function could see a free for the
-            ///   same physically contiguous block of memory (one for each
-            ///   page in the block). We could ignore the extras, or we
-            ///   could set up the allocator so that it frees one page at a
-            ///   time. Just depends on how we want to do this... but in
-            ///   general, I would suggest using the later as a buddy allocator
-            ///   can support this without any added overhead.
-            ///
+            if (bsl::unlikely(!m_initialized)) {
+                bsl::error() << "huge_pool_t not initialized\n" << bsl::here();
+                return;
+            }
+
+            if (bsl::unlikely(nullptr == ptr)) {
+                return;
+            }
+
+            for (auto const elem : m_segments) {
+                if (elem.data->contains(ptr)) {
+                    elem.data->deallocate(ptr);
+                    return;
+                }
+
+                bsl::touch();
+            }
+
+            bsl::error() << "invalid ptr "    // --
+                         << ptr               // --
+                         << bsl::endl         // --
+                         << bsl::here();      // --
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the number of bytes that were requested when
+        ///     the provided memory was allocated. The provided pointer must
+        ///     be the pointer that was returned by allocate.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param ptr the pointer returned by allocate
+        ///   @return Returns the number of bytes that were requested when
+        ///     the provided memory was allocated, or
+        ///     bsl::safe_uintmax::zero(true) on failure.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        size(TLS_CONCEPT &tls, void const *const ptr) &noexcept -> bsl::safe_uintmax
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely(!m_initialized)) {
+                bsl::error() << "huge_pool_t not initialized\n" << bsl::here();
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            auto const *const seg{this->ptr_to_segment(ptr)};
+            if (bsl::unlikely(nullptr == seg)) {
+                bsl::error() << "invalid ptr "    // --
+                             << ptr               // --
+                             << bsl::endl         // --
+                             << bsl::here();      // --
+
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            return seg->size(ptr);
         }
 
         /// <!-- description -->
@@ -304,19 +486,41 @@ namespace mk
         }
 
         /// <!-- description -->
-        ///   @brief Dumps the page_pool_t
+        ///   @brief Dumps the huge_pool_t
         ///
         constexpr void
         dump() const &noexcept
         {
-            constexpr auto kb{bsl::to_umax(1024)};
-            constexpr auto mb{bsl::to_umax(1024) * bsl::to_umax(1024)};
-
             if (bsl::unlikely(!m_initialized)) {
                 bsl::print() << "[error]" << bsl::endl;
                 return;
             }
 
+            bsl::array<bsl::safe_uintmax, HUGE_POOL_MAX_ORDERS.get()> blks{};
+            bsl::safe_uintmax num{};
+            bsl::safe_uintmax largest{};
+            bsl::safe_uintmax total{};
+            bsl::safe_uintmax usd{};
+            bsl::safe_uintmax req{};
+
+            for (auto const elem : m_segments) {
+                auto const seg_largest{elem.data->free_blocks(blks)};
+                if (seg_largest > largest) {
+                    largest = seg_largest;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                total += elem.data->total();
+                usd += elem.data->used();
+                req += elem.data->requested();
+            }
+
+            for (auto const elem : blks) {
+                num += *elem.data;
+            }
+
             bsl::print() << bsl::mag << "huge pool dump: ";
             bsl::print() << bsl::rst << bsl::endl;
 
@@ -336,50 +540,72 @@ namespace mk
             bsl::print() << bsl::ylw << "+-----------------------+";
             bsl::print() << bsl::rst << bsl::endl;
 
-            /// Total
+            /// Usage
             ///
 
-            bsl::print() << bsl::ylw << "| ";
-            bsl::print() << bsl::rst << bsl::fmt{"<12s", "total "};
-            bsl::print() << bsl::ylw << "| ";
-            if ((m_pool.size() / mb).is_zero()) {
-                bsl::print() << bsl::rst << bsl::fmt{"4d", m_pool.size() / kb} << " KB ";
-            }
-            else {
-                bsl::print() << bsl::rst << bsl::fmt{"4d", m_pool.size() / mb} << " MB ";
-            }
-            bsl::print() << bsl::ylw << "| ";
-            bsl::print() << bsl::rst << bsl::endl;
+            dump_bytes("total ", total);
+            dump_bytes("used ", usd);
+            dump_bytes("remaining ", total - usd);
 
-            /// Used
+            /// Fragmentation
             ///
 
-            bsl::print() << bsl::ylw << "| ";
-            bsl::print() << bsl::rst << bsl::fmt{"<12s", "used "};
-            bsl::print() << bsl::ylw << "| ";
-            if ((m_crsr / mb).is_zero()) {
-                bsl::print() << bsl::rst << bsl::fmt{"4d", m_crsr / kb} << " KB ";
-            }
-            else {
-                bsl::print() << bsl::rst << bsl::fmt{"4d", m_crsr / mb} << " MB ";
-            }
-            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::ylw << "+-----------------------+";
             bsl::print() << bsl::rst << bsl::endl;
 
-            /// Remaining
+            dump_bytes("requested ", req);
+            dump_bytes("wasted ", usd - req);
+            dump_bytes("largest ", largest);
+            dump_count("free blocks ", num);
+
+            for (bsl::safe_uintmax ord{}; ord < HUGE_POOL_MAX_ORDERS; ++ord) {
+                if (blks.at_if(ord)->is_zero()) {
+                    continue;
+                }
+
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << " - order " << bsl::fmt{"<3d", ord};
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"7d", *blks.at_if(ord)} << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::endl;
+            }
+
+            /// Segments
             ///
 
-            bsl::print() << bsl::ylw << "| ";
-            bsl::print() << bsl::rst << bsl::fmt{"<12s", "remaining "};
-            bsl::print() << bsl::ylw << "| ";
-            if (((m_pool.size() - m_crsr) / mb).is_zero()) {
-                bsl::print() << bsl::rst << bsl::fmt{"4d", (m_pool.size() - m_crsr) / kb} << " KB ";
+            for (bsl::safe_uintmax i{}; i < m_segments.size(); ++i) {
+                auto const *const seg{m_segments.at_if(i)};
+                if (seg->empty()) {
+                    continue;
+                }
+
+                bsl::print() << bsl::ylw << "+-----------------------+";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::blu << "seg " << bsl::fmt{"04x", bsl::to_u16(i)};
+                bsl::print() << bsl::rst << " node " << bsl::fmt{"04x", seg->node()};
+                bsl::print() << bsl::rst << bsl::fmt{"<4s", " "};
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                dump_bytes(" - total ", seg->total());
+                dump_bytes(" - used ", seg->used());
+                dump_bytes(" - remaining ", seg->total() - seg->used());
             }
-            else {
-                bsl::print() << bsl::rst << bsl::fmt{"4d", (m_pool.size() - m_crsr) / mb} << " MB ";
+
+            /// Lock
+            ///
+
+            if constexpr (!(BSL_DEBUG_LEVEL < bsl::V)) {
+                bsl::print() << bsl::ylw << "+-----------------------+";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                dump_count("lock acq ", m_lock.acquisitions());
+                dump_count("lock cont ", m_lock.contentions());
+                dump_count("lock spins ", m_lock.spins());
             }
-            bsl::print() << bsl::ylw << "| ";
-            bsl::print() << bsl::rst << bsl::endl;
 
             /// Footer
             ///
@@ -307,50 +307,89 @@ namespace mk
                 return bsl::errc_failure;
             }
 
-            if (bsl::unlikely_assert(args->page_pool.empty())) {
-                bsl::error() << "args->page_pool is empty"    // --
-                             << bsl::endl                     // --
-                             << bsl::here();                  // --
-
-                return bsl::errc_failure;
-            }
-
-            if (bsl::unlikely_assert(args->page_pool.size().is_zero())) {
-                bsl::error() << "args->page_pool's size is zero"    // --
+            if (bsl::unlikely_assert(!(bsl::to_umax(args->node) < args->page_pool.size()))) {
+                bsl::error() << "the args->node ["                  // --
+                             << bsl::hex(args->node)                // --
+                             << "] is not less than the max ["      // --
+                             << bsl::hex(args->page_pool.size())    // --
+                             << "]"                                 // --
                              << bsl::endl                           // --
                              << bsl::here();                        // --
 
                 return bsl::errc_failure;
             }
 
-            if (bsl::unlikely_assert(args->page_pool.size() < PAGE_SIZE)) {
-                bsl::error() << "args->page_pool's size is too small"    // --
-                             << bsl::endl                                // --
-                             << bsl::here();                             // --
+            bool page_pool_empty{true};
+            for (auto const elem : args->page_pool) {
+                if (elem.data->empty()) {
+                    continue;
+                }
 
-                return bsl::errc_failure;
+                if (bsl::unlikely_assert(elem.data->size() < PAGE_SIZE)) {
+                    bsl::error() << "args->page_pool["         // --
+                                 << elem.index                 // --
+                                 << "]'s size is too small"    // --
+                                 << bsl::endl                  // --
+                                 << bsl::here();               // --
+
+                    return bsl::errc_failure;
+                }
+
+                page_pool_empty = false;
             }
 
-            if (bsl::unlikely_assert(args->huge_pool.empty())) {
-                bsl::error() << "args->huge_pool is empty"    // --
+            if (bsl::unlikely_assert(page_pool_empty)) {
+                bsl::error() << "args->page_pool is empty"    // --
                              << bsl::endl                     // --
                              << bsl::here();                  // --
 
                 return bsl::errc_failure;
             }
 
-            if (bsl::unlikely_assert(args->huge_pool.size().is_zero())) {
-                bsl::error() << "args->huge_pool's size is zero"    // --
-                             << bsl::endl                           // --
-                             << bsl::here();                        // --
+            bool huge_pool_empty{true};
+            for (auto const elem : args->huge_pool) {
+                if (elem.data->empty()) {
+                    continue;
+                }
+
+                if (bsl::unlikely_assert(elem.data->size() < PAGE_SIZE)) {
+                    bsl::error() << "args->huge_pool["         // --
+                                 << elem.index                 // --
+                                 << "]'s size is too small"    // --
+                                 << bsl::endl                  // --
+                                 << bsl::here();               // --
+
+                    return bsl::errc_failure;
+                }
+
+                auto const node{bsl::to_umax(*args->huge_pool_node.at_if(elem.index))};
+                if (bsl::unlikely_assert(!(node < args->page_pool.size()))) {
+                    bsl::error() << "args->huge_pool_node["             // --
+                                 << elem.index                          // --
+                                 << "] is not less than the max ["      // --
+                                 << bsl::hex(args->page_pool.size())    // --
+                                 << "]"                                 // --
+                                 << bsl::endl                           // --
+                                 << bsl::here();                        // --
+
+                    return bsl::errc_failure;
+                }
+
+                huge_pool_empty = false;
+            }
+
+            if (bsl::unlikely_assert(huge_pool_empty)) {
+                bsl::error() << "args->huge_pool is empty"    // --
+                             << bsl::endl                     // --
+                             << bsl::here();                  // --
 
                 return bsl::errc_failure;
             }
 
-            if (bsl::unlikely_assert(args->huge_pool.size() < PAGE_SIZE)) {
-                bsl::error() << "args->huge_pool's size is too small"    // --
-                             << bsl::endl                                // --
-                             << bsl::here();                             // --
+            if (bsl::unlikely_assert(nullptr == args->page_pool_donations)) {
+                bsl::error() << "args->page_pool_donations is null"    // --
+                             << bsl::endl                              // --
+                             << bsl::here();                           // --
 
                 return bsl::errc_failure;
             }
@@ -435,7 +474,13 @@ namespace mk
                 return bsl::errc_failure;
             }
 
-            ret = m_huge_pool.initialize(args->huge_pool);
+            ret = m_page_pool.initialize_donations(args->page_pool_donations);
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            ret = m_huge_pool.initialize(args->huge_pool, args->huge_pool_node);
             if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::errc_failure;
@@ -452,7 +497,8 @@ namespace mk
                 return bsl::errc_failure;
             }
 
-            ret = m_system_rpt.initialize(tls, &m_intrinsic, &m_page_pool, &m_huge_pool);
+            ret = m_system_rpt.initialize(
+                tls, &m_intrinsic, &m_page_pool, &m_huge_pool, bsl::ZERO_U16);
             if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::errc_failure;
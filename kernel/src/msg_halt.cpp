@@ -22,6 +22,8 @@
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
 
+#include <console_write.hpp>
+
 #include <bsl/debug.hpp>
 
 namespace mk
@@ -36,5 +38,7 @@ namespace mk
         bsl::print() << bsl::rst << "  --> ";
         bsl::print() << bsl::red << "Halting!!!";
         bsl::print() << bsl::rst << bsl::endl;
+
+        console_flush();
     }
 }
@@ -25,13 +25,17 @@
 #ifndef PAGE_POOL_T_HPP
 #define PAGE_POOL_T_HPP
 
+#include <donate_pages_t.hpp>
 #include <lock_guard.hpp>
+#include <page_pool_cache_t.hpp>
+#include <page_pool_node_t.hpp>
 #include <page_pool_record_t.hpp>
 #include <spinlock.hpp>
 
 #include <bsl/array.hpp>
 #include <bsl/construct_at.hpp>
 #include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
 #include <bsl/cstring.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/disjunction.hpp>
@@ -49,6 +53,10 @@ namespace mk
 {
     /// @brief stores the max number of records the page pool can store
     constexpr bsl::safe_uintmax PAGE_POOL_MAX_RECORDS{bsl::to_umax(10)};
+    /// @brief stores the max number of pages a PP's cache can hold
+    constexpr bsl::safe_uintmax PAGE_POOL_CACHE_SIZE{bsl::to_umax(64)};
+    /// @brief stores the number of pages moved on a cache refill/drain
+    constexpr bsl::safe_uintmax PAGE_POOL_CACHE_BATCH{bsl::to_umax(32)};
 
     /// @class mk::page_pool_t
     ///
@@ -87,24 +95,568 @@ namespace mk
     ///      can all be done with simple arithmetic (i.e., no lookups are
     ///      needed). This is what is typically called a direct map.
     ///
+    ///      To keep the global lock off of the hot path, each PP has its
+    ///      own cache of pages (i.e., a magazine). Allocations and
+    ///      deallocations are served from the PP's cache, which has its own
+    ///      lock that no other PP takes unless the page pool runs out of
+    ///      pages, and the global stack above is only locked when a cache
+    ///      needs to be refilled or drained, in which case
+    ///      PAGE_POOL_CACHE_BATCH pages are moved at once. If the global
+    ///      stacks are empty, the caches of the other PPs are flushed
+    ///      before the page pool reports that it is out of pages.
+    ///
+    ///      On NUMA systems, the loader gives each node its own slice of
+    ///      the page pool (allocated from that node), and each slice is
+    ///      kept on its own global stack. A PP's cache is refilled from
+    ///      the PP's own node, and only falls back to the other nodes
+    ///      once its node is out of pages. Pages are always returned to
+    ///      the node that they came from, which is found using the
+    ///      physical address range of each node.
+    ///
+    ///      The page pool can also grow while the hypervisor is running.
+    ///      Once a node has fewer than LOW_WATERMARK bytes left on its
+    ///      stack, low_node() reports it, and the root OS can donate more
+    ///      pages. The loader maps the donated pages into the page pool's
+    ///      direct map, registers their physical address ranges (see
+    ///      initialize_donations()) and gives donate() a bounded list of
+    ///      their physical addresses, which donate() checks against the
+    ///      registered ranges before it splices the pages onto the node's
+    ///      stack.
+    ///
     /// <!-- template parameters -->
     ///   @tparam PAGE_SIZE defines the size of a page
     ///   @tparam MK_PAGE_POOL_ADDR defines the base address of the page pool
+    ///   @tparam MK_DIRECT_MAP_SIZE defines the size of the direct map that
+    ///     the page pool lives in
+    ///   @tparam MAX_PPS the max number of PPs supported
+    ///   @tparam MAX_NUMA_NODES the max number of NUMA nodes supported
+    ///   @tparam LOW_WATERMARK the number of free bytes (per node) below
+    ///     which a node is reported as low on pages
     ///
-    template<bsl::uintmax PAGE_SIZE, bsl::uintmax MK_PAGE_POOL_ADDR>
+    template<
+        bsl::uintmax PAGE_SIZE,
+        bsl::uintmax MK_PAGE_POOL_ADDR,
+        bsl::uintmax MK_DIRECT_MAP_SIZE,
+        bsl::uintmax MAX_PPS,
+        bsl::uintmax MAX_NUMA_NODES,
+        bsl::uintmax LOW_WATERMARK>
     class page_pool_t final
     {
         /// @brief stores true if initialized() has been executed
         bool m_initialized{};
-        /// @brief stores the head of the page pool stack.
-        void *m_head{};
+        /// @brief stores each NUMA node's page pool stack.
+        bsl::array<page_pool_node_t, MAX_NUMA_NODES> m_nodes{};
         /// @brief stores the total number of bytes given to the page pool.
         bsl::safe_uintmax m_size{};
         /// @brief stores information about how memory is allocated
         bsl::array<page_pool_record_t, PAGE_POOL_MAX_RECORDS.get()> m_rcds{};
+        /// @brief stores the number of records that have been published
+        bsl::uint64 m_num_rcds{};
+        /// @brief stores each PP's page cache
+        bsl::array<page_pool_cache_t<PAGE_POOL_MAX_RECORDS.get()>, MAX_PPS> m_caches{};
+        /// @brief stores the ranges the loader donates to the page pool
+        loader::donated_ranges_t const *m_donated_ranges{};
         /// @brief safe guards operations on the pool.
         mutable spinlock m_lock{};
 
+        /// <!-- description -->
+        ///   @brief Returns the index of the record associated with the
+        ///     provided tag. If the tag does not have a record yet and
+        ///     "add" is true, a new record is created for the tag.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param tag the tag to look up
+        ///   @param add if true, a record is created if one does not exist
+        ///   @return Returns the index of the record associated with the
+        ///     provided tag, or bsl::safe_uintmax::zero(true) on failure.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        tag_to_idx(TLS_CONCEPT &tls, bsl::string_view const &tag, bool const add) &noexcept
+            -> bsl::safe_uintmax
+        {
+            /// NOTE:
+            /// - Records are only ever added (under the lock), in order, and
+            ///   are never removed until the page pool is released, which
+            ///   is why the common case can search the records without the
+            ///   lock. A record is published by storing the new number of
+            ///   records with __ATOMIC_RELEASE once its tag is written, and
+            ///   only the records that were published (loaded using
+            ///   __ATOMIC_ACQUIRE) are searched without the lock, so a tag
+            ///   is never read while another PP is writing it.
+            ///
+
+            auto const num{bsl::to_umax(__atomic_load_n(&m_num_rcds, __ATOMIC_ACQUIRE))};
+            for (bsl::safe_uintmax i{}; i < num; ++i) {
+                if (m_rcds.at_if(i)->tag.data() == tag.data()) {
+                    return i;
+                }
+
+                bsl::touch();
+            }
+
+            if (!add) {
+                bsl::error() << "invalid tag: "    // --
+                             << tag                // --
+                             << bsl::endl          // --
+                             << bsl::here();       // --
+
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            lock_guard lock{tls, m_lock};
+
+            for (bsl::safe_uintmax i{}; i < m_rcds.size(); ++i) {
+                auto *const rcd{m_rcds.at_if(i)};
+                if (rcd->tag.data() == tag.data()) {
+                    return i;
+                }
+
+                if (rcd->tag.empty()) {
+                    rcd->tag = tag;
+                    __atomic_store_n(&m_num_rcds, (i + bsl::ONE_UMAX).get(), __ATOMIC_RELEASE);
+                    return i;
+                }
+
+                bsl::touch();
+            }
+
+            bsl::error() << "page pool out of space for tags\n" << bsl::here();
+            return bsl::safe_uintmax::zero(true);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the number of bytes currently allocated using
+        ///     the record at the provided index, summed over all PPs.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param idx the index of the record to query
+        ///   @return Returns the number of bytes currently allocated using
+        ///     the record at the provided index
+        ///
+        [[nodiscard]] constexpr auto
+        record_usd(bsl::safe_uintmax const &idx) const &noexcept -> bsl::safe_uintmax
+        {
+            bsl::safe_uintmax alc{};
+            bsl::safe_uintmax fre{};
+
+            /// NOTE:
+            /// - A page can be allocated on one PP and freed on another,
+            ///   so only the sum over all of the PPs is meaningful.
+            ///
+
+            for (auto const elem : m_caches) {
+                alc += *elem.data->alc.at_if(idx);
+                fre += *elem.data->fre.at_if(idx);
+            }
+
+            return alc - fre;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the node that the provided PP belongs to. If
+        ///     the PP's node is not valid, node 0 is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @return Returns the node that the provided PP belongs to
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        local_node(TLS_CONCEPT const &tls) &noexcept -> page_pool_node_t *
+        {
+            auto *const node{m_nodes.at_if(bsl::to_umax(tls.node))};
+            if (bsl::unlikely(nullptr == node)) {
+                return m_nodes.at_if(bsl::ZERO_UMAX);
+            }
+
+            return node;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided physical address is in
+        ///     the physical address range of the provided node.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param node the node to check
+        ///   @param phys the physical address to check
+        ///   @return Returns true if the provided physical address is in
+        ///     the physical address range of the provided node.
+        ///
+        [[nodiscard]] static constexpr auto
+        node_owns(page_pool_node_t const *const node, bsl::safe_uintmax const &phys) noexcept
+            -> bool
+        {
+            if (node->size.is_zero()) {
+                return false;
+            }
+
+            return !(phys < node->phys_min) && !(phys > node->phys_max);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the node that the provided page belongs to.
+        ///     The provided fallback is checked first, and it is also
+        ///     returned if no node's range contains the page.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ptr the page to look up
+        ///   @param fallback the node to check first
+        ///   @return Returns the node that the provided page belongs to
+        ///
+        [[nodiscard]] constexpr auto
+        page_to_node(void const *const ptr, page_pool_node_t *const fallback) &noexcept
+            -> page_pool_node_t *
+        {
+            auto const phys{this->virt_to_phys(ptr)};
+            if (node_owns(fallback, phys)) {
+                return fallback;
+            }
+
+            for (auto const elem : m_nodes) {
+                if (node_owns(elem.data, phys)) {
+                    return elem.data;
+                }
+
+                bsl::touch();
+            }
+
+            return fallback;
+        }
+
+        /// <!-- description -->
+        ///   @brief Pushes the provided page onto the provided node's
+        ///     stack. The page pool's lock must be held.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param node the node to return the page to
+        ///   @param ptr the page to return
+        ///
+        static constexpr void
+        push_page(page_pool_node_t *const node, void *const ptr) noexcept
+        {
+            *static_cast<void **>(ptr) = node->head;
+            node->head = ptr;
+            ++node->free;
+        }
+
+        /// <!-- description -->
+        ///   @brief Moves up to PAGE_POOL_CACHE_BATCH pages from the global
+        ///     stacks to the provided PP cache, preferring the PP's node.
+        ///     The cache's lock must be held.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param cache the PP cache to refill
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        refill(TLS_CONCEPT &tls, page_pool_cache_t<PAGE_POOL_MAX_RECORDS.get()> &cache) &noexcept
+            -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            /// NOTE:
+            /// - The PP's own node is tried first, and the other nodes are
+            ///   only used once the PP's node is out of pages. The i == 0
+            ///   iteration is always the PP's node, which is how local and
+            ///   remote refills are told apart for the dump.
+            ///
+
+            auto const local{bsl::to_umax(tls.node)};
+            for (bsl::safe_uintmax i{}; i < m_nodes.size(); ++i) {
+                auto *const node{m_nodes.at_if((local + i) % m_nodes.size())};
+                while (cache.count < PAGE_POOL_CACHE_BATCH) {
+                    if (nullptr == node->head) {
+                        break;
+                    }
+
+                    void *const ptr{node->head};
+                    node->head = *static_cast<void **>(node->head);
+                    --node->free;
+
+                    *static_cast<void **>(ptr) = cache.head;
+                    cache.head = ptr;
+                    ++cache.count;
+
+                    if (i.is_zero()) {
+                        ++node->local;
+                    }
+                    else {
+                        ++node->remote;
+                    }
+                }
+
+                if (node->free < node->lowest) {
+                    node->lowest = node->free;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                if (!(cache.count < PAGE_POOL_CACHE_BATCH)) {
+                    break;
+                }
+
+                bsl::touch();
+            }
+
+            if (bsl::unlikely(nullptr == cache.head)) {
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Moves PAGE_POOL_CACHE_BATCH pages from the provided PP
+        ///     cache back to the global stacks of the nodes that they came
+        ///     from. The cache's lock must be held.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param cache the PP cache to drain
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        drain(TLS_CONCEPT &tls, page_pool_cache_t<PAGE_POOL_MAX_RECORDS.get()> &cache) &noexcept
+        {
+            lock_guard lock{tls, m_lock};
+
+            auto *const local{this->local_node(tls)};
+            for (bsl::safe_uintmax i{}; i < PAGE_POOL_CACHE_BATCH; ++i) {
+                if (nullptr == cache.head) {
+                    break;
+                }
+
+                void *const ptr{cache.head};
+                cache.head = *static_cast<void **>(cache.head);
+                --cache.count;
+
+                push_page(this->page_to_node(ptr, local), ptr);
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Pops a page from the provided PP cache, refilling the
+        ///     cache from the global stacks if it is empty.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param cache the PP cache to pop the page from
+        ///   @param idx the index of the record to mark the allocation with
+        ///   @return Returns the page that was popped, or a nullptr if the
+        ///     cache is empty and could not be refilled
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        pop(TLS_CONCEPT &tls,
+            page_pool_cache_t<PAGE_POOL_MAX_RECORDS.get()> &cache,
+            bsl::safe_uintmax const &idx) &noexcept -> void *
+        {
+            lock_guard lock{tls, cache.lock};
+
+            if (nullptr == cache.head) {
+                ++cache.misses;
+                if (bsl::unlikely(!this->refill(tls, cache))) {
+                    return nullptr;
+                }
+
+                bsl::touch();
+            }
+            else {
+                ++cache.hits;
+            }
+
+            void *const ptr{cache.head};
+            cache.head = *static_cast<void **>(cache.head);
+            --cache.count;
+            *cache.alc.at_if(idx) += PAGE_SIZE;
+
+            return ptr;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns every page that is sitting in a PP's cache to
+        ///     the global stacks of the nodes that they came from. This is
+        ///     only done once the global stacks are out of pages, so that
+        ///     the pages cached by other (possibly idle) PPs can still be
+        ///     allocated. The caller must not hold any cache's lock.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        flush_caches(TLS_CONCEPT &tls) &noexcept
+        {
+            auto *const local{this->local_node(tls)};
+            for (auto const elem : m_caches) {
+                lock_guard cache_lock{tls, elem.data->lock};
+                if (nullptr == elem.data->head) {
+                    continue;
+                }
+
+                lock_guard lock{tls, m_lock};
+                while (nullptr != elem.data->head) {
+                    void *const ptr{elem.data->head};
+                    elem.data->head = *static_cast<void **>(elem.data->head);
+                    --elem.data->count;
+
+                    push_page(this->page_to_node(ptr, local), ptr);
+                }
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs a single row of the NUMA node section of the
+        ///     dump.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param node the index of the node the row belongs to
+        ///   @param str the description of the row
+        ///   @param bytes the number of bytes to output
+        ///
+        static constexpr void
+        dump_node_bytes(
+            bsl::safe_uintmax const &node,
+            bsl::string_view const &str,
+            bsl::safe_uintmax const &bytes) noexcept
+        {
+            constexpr auto kb{bsl::to_umax(1024)};
+            constexpr auto mb{bsl::to_umax(1024) * bsl::to_umax(1024)};
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << "node " << bsl::fmt{"04x", bsl::to_u16(node)} << " ";
+            bsl::print() << bsl::rst << bsl::fmt{"<13s", str};
+            bsl::print() << bsl::ylw << "| ";
+            if ((bytes / mb).is_zero()) {
+                bsl::print() << bsl::rst << bsl::fmt{"4d", bytes / kb} << " KB ";
+            }
+            else {
+                bsl::print() << bsl::rst << bsl::fmt{"4d", bytes / mb} << " MB ";
+            }
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs the counters of the provided lock as the
+        ///     remaining columns of a row of the lock section of the dump.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param lock the lock to output the counters of
+        ///
+        static constexpr void
+        dump_lock(spinlock const &lock) noexcept
+        {
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"6d", lock.acquisitions()} << " ";
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"7d", lock.contentions()} << " ";
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"6d", lock.spins()} << " ";
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided physical address is inside
+        ///     one of the ranges that the loader registered using
+        ///     initialize_donations(), and that range is inside of the
+        ///     direct map. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param phys the physical address to check
+        ///   @return Returns true if the provided physical address is inside
+        ///     one of the ranges that the loader registered, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_donated(bsl::safe_uintmax const &phys) const &noexcept -> bool
+        {
+            constexpr auto direct_map_size{bsl::to_umax(MK_DIRECT_MAP_SIZE)};
+
+            if (bsl::unlikely(nullptr == m_donated_ranges)) {
+                return false;
+            }
+
+            for (bsl::safe_uintmax i{}; i < loader::DONATED_RANGES_MAX; ++i) {
+                bsl::safe_uintmax const base{
+                    __atomic_load_n(m_donated_ranges->phys.at_if(i), __ATOMIC_ACQUIRE)};
+                bsl::safe_uintmax const size{
+                    __atomic_load_n(m_donated_ranges->size.at_if(i), __ATOMIC_ACQUIRE)};
+
+                if (base.is_zero() || size.is_zero() || size > direct_map_size) {
+                    continue;
+                }
+
+                if (base > direct_map_size - size) {
+                    continue;
+                }
+
+                if (phys < base) {
+                    continue;
+                }
+
+                if (phys - base < size) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns a pointer to the page the loader donated at the
+        ///     provided physical address, or a nullptr if the address is not
+        ///     page aligned, is not inside one of the ranges the loader
+        ///     registered (see is_donated()), or the page does not start
+        ///     with a loader::DONATE_PAGES_TAG followed by its own physical
+        ///     address (i.e., the page was not tagged by the loader, or was
+        ///     already added to the page pool).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam T defines the type of page to return
+        ///   @param phys the physical address of the donated page
+        ///   @return Returns a pointer to the page the loader donated at the
+        ///     provided physical address, or a nullptr on failure.
+        ///
+        template<typename T>
+        [[nodiscard]] constexpr auto
+        donated_page(bsl::safe_uintmax const &phys) const &noexcept -> T *
+        {
+            constexpr auto mask{bsl::to_umax(PAGE_SIZE) - bsl::ONE_UMAX};
+
+            if (bsl::unlikely(phys.is_zero() || !(phys & mask).is_zero())) {
+                return nullptr;
+            }
+
+            if (bsl::unlikely(!this->is_donated(phys))) {
+                return nullptr;
+            }
+
+            auto *const page{this->template phys_to_virt<T>(phys)};
+            bsl::safe_uint64 const tag{__atomic_load_n(&page->tag, __ATOMIC_ACQUIRE)};
+            if (bsl::unlikely(loader::DONATE_PAGES_TAG != tag)) {
+                return nullptr;
+            }
+
+            if (bsl::unlikely(phys != bsl::to_umax(page->phys))) {
+                return nullptr;
+            }
+
+            return page;
+        }
+
     public:
         /// <!-- description -->
         ///   @brief Default constructor
@@ -113,16 +665,17 @@ namespace mk
 
         /// <!-- description -->
         ///   @brief Creates the page pool given a mutable_buffer_t to
-        ///     the page pool as well as the virtual address base of the
-        ///     page pool which is used for virt to phys translations.
+        ///     each NUMA node's slice of the page pool. Nodes without a
+        ///     slice are given an empty mutable_buffer_t.
         ///
         /// <!-- inputs/outputs -->
-        ///   @param pool the mutable_buffer_t of the page pool
+        ///   @param pools the mutable_buffer_t of each node's page pool
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
         [[nodiscard]] constexpr auto
-        initialize(bsl::span<bsl::byte> &pool) &noexcept -> bsl::errc_type
+        initialize(bsl::array<bsl::span<bsl::byte>, MAX_NUMA_NODES> &pools) &noexcept
+            -> bsl::errc_type
         {
             if (bsl::unlikely(m_initialized)) {
                 bsl::error() << "page_pool_t already initialized\n" << bsl::here();
@@ -133,14 +686,56 @@ namespace mk
                 this->release();
             }};
 
-            if (bsl::unlikely(pool.empty())) {
+            for (bsl::safe_uintmax i{}; i < pools.size(); ++i) {
+                auto const *const pool{pools.at_if(i)};
+                if (pool->empty()) {
+                    continue;
+                }
+
+                auto *const node{m_nodes.at_if(i)};
+                node->head = pool->data();
+                node->size = pool->size();
+
+                /// NOTE:
+                /// - The list is walked once to find the node's physical
+                ///   address range. This is what allows a page that is
+                ///   freed on another node to be returned to the node
+                ///   that it came from.
+                ///
+
+                node->phys_min = this->virt_to_phys(node->head);
+                node->phys_max = node->phys_min;
+
+                void const *page{node->head};
+                while (nullptr != page) {
+                    auto const phys{this->virt_to_phys(page)};
+                    if (phys < node->phys_min) {
+                        node->phys_min = phys;
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    if (phys > node->phys_max) {
+                        node->phys_max = phys;
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    ++node->free;
+                    page = *static_cast<void const *const *>(page);
+                }
+
+                node->lowest = node->free;
+                m_size += node->size;
+            }
+
+            if (bsl::unlikely(m_size.is_zero())) {
                 bsl::error() << "pool is empty\n" << bsl::here();
                 return bsl::errc_failure;
             }
 
-            m_head = pool.data();
-            m_size = pool.size();
-
             release_on_error.ignore();
             m_initialized = true;
 
@@ -157,12 +752,50 @@ namespace mk
                 *elem.data = {};
             }
 
+            m_num_rcds = {};
+
+            for (auto const elem : m_caches) {
+                *elem.data = {};
+            }
+
+            for (auto const elem : m_nodes) {
+                *elem.data = {};
+            }
+
             m_size = {};
-            m_head = {};
+            m_donated_ranges = {};
 
             m_initialized = {};
         }
 
+        /// <!-- description -->
+        ///   @brief Gives the page pool the ranges of physical memory that
+        ///     the loader donates to it (see donate()). Until this is
+        ///     called, every donation is rejected.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ranges the ranges the loader donates to the page pool
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        initialize_donations(loader::donated_ranges_t const *const ranges) &noexcept
+            -> bsl::errc_type
+        {
+            if (bsl::unlikely(!m_initialized)) {
+                bsl::error() << "page_pool_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(nullptr == ranges)) {
+                bsl::error() << "invalid donated ranges\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_donated_ranges = ranges;
+            return bsl::errc_success;
+        }
+
         /// <!-- description -->
         ///   @brief Destroyes a previously created page_pool_t
         ///
@@ -218,8 +851,6 @@ namespace mk
         [[nodiscard]] constexpr auto
         allocate(TLS_CONCEPT &tls, bsl::string_view const &tag) &noexcept -> T *
         {
-            lock_guard lock{tls, m_lock};
-
             if (bsl::unlikely(!m_initialized)) {
                 bsl::error() << "page_pool_t not initialized\n" << bsl::here();
                 return nullptr;
@@ -233,45 +864,44 @@ namespace mk
                 return nullptr;
             }
 
-            if (bsl::unlikely(nullptr == m_head)) {
-                bsl::error() << "page pool out of pages\n" << bsl::here();
+            auto *const cache{m_caches.at_if(bsl::to_umax(tls.ppid))};
+            if (bsl::unlikely(nullptr == cache)) {
+                bsl::error() << "invalid ppid: "       // --
+                             << bsl::hex(tls.ppid)    // --
+                             << bsl::endl             // --
+                             << bsl::here();          // --
+
                 return nullptr;
             }
 
-            page_pool_record_t *record{};
-            for (auto const elem : m_rcds) {
-                if (elem.data->tag.data() == tag.data()) {
-                    record = elem.data;
-                    break;
-                }
-
-                bsl::touch();
+            auto const idx{this->tag_to_idx(tls, tag, true)};
+            if (bsl::unlikely(!idx)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return nullptr;
             }
 
-            if (nullptr == record) {
-                for (auto const elem : m_rcds) {
-                    if (elem.data->tag.empty()) {
-                        record = elem.data;
-                        record->tag = tag;
-                        break;
-                    }
+            /// NOTE:
+            /// - Up to PAGE_POOL_CACHE_SIZE - 1 pages can be sitting in the
+            ///   cache of each of the other PPs. If the global stacks are
+            ///   empty, these pages are returned to the global stacks and
+            ///   the allocation is tried one more time before we report
+            ///   that the page pool is out of pages.
+            ///
 
-                    bsl::touch();
-                }
+            void *ptr{this->pop(tls, *cache, idx)};
+            if (bsl::unlikely(nullptr == ptr)) {
+                this->flush_caches(tls);
+                ptr = this->pop(tls, *cache, idx);
             }
             else {
                 bsl::touch();
             }
 
-            if (nullptr == record) {
-                bsl::error() << "page pool out of space for tags\n" << bsl::here();
+            if (bsl::unlikely(nullptr == ptr)) {
+                bsl::error() << "page pool out of pages\n" << bsl::here();
                 return nullptr;
             }
 
-            void *const ptr{m_head};
-            m_head = *static_cast<void **>(m_head);
-            record->usd += PAGE_SIZE;
-
             bsl::builtin_memset(ptr, '\0', PAGE_SIZE);
 
             if constexpr (!bsl::is_void<T>::value) {
@@ -296,8 +926,6 @@ namespace mk
         constexpr void
         deallocate(TLS_CONCEPT &tls, void *const ptr, bsl::string_view const &tag) &noexcept
         {
-            lock_guard lock{tls, m_lock};
-
             if (bsl::unlikely(!m_initialized)) {
                 bsl::error() << "page_pool_t not initialized\n" << bsl::here();
                 return;
@@ -324,28 +952,306 @@ namespace mk
                 return;
             }
 
-            page_pool_record_t *record{};
-            for (auto const elem : m_rcds) {
-                if (elem.data->tag.data() == tag.data()) {
-                    record = elem.data;
-                    break;
-                }
+            auto *const cache{m_caches.at_if(bsl::to_umax(tls.ppid))};
+            if (bsl::unlikely(nullptr == cache)) {
+                bsl::error() << "invalid ppid: "       // --
+                             << bsl::hex(tls.ppid)    // --
+                             << bsl::endl             // --
+                             << bsl::here();          // --
 
-                bsl::touch();
+                return;
             }
 
-            if (nullptr == record) {
-                bsl::error() << "invalid tag: "    // --
-                             << tag                // --
-                             << bsl::endl          // --
-                             << bsl::here();       // --
+            auto const idx{this->tag_to_idx(tls, tag, false)};
+            if (bsl::unlikely(!idx)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return;
+            }
 
+            /// NOTE:
+            /// - A page that belongs to another node is returned to that
+            ///   node right away. If it was cached instead, this PP would
+            ///   hand it out again, which is exactly the remote access
+            ///   that the per-node stacks are meant to prevent.
+            ///
+
+            auto *const local{this->local_node(tls)};
+            auto *const node{this->page_to_node(ptr, local)};
+            if (bsl::unlikely(node != local)) {
+                lock_guard lock{tls, m_lock};
+
+                push_page(node, ptr);
+                *cache->fre.at_if(idx) += PAGE_SIZE;
+
+                return;
+            }
+
+            lock_guard cache_lock{tls, cache->lock};
+
+            *static_cast<void **>(ptr) = cache->head;
+            cache->head = ptr;
+            ++cache->count;
+            *cache->fre.at_if(idx) += PAGE_SIZE;
+
+            if (cache->count < PAGE_POOL_CACHE_SIZE) {
                 return;
             }
 
-            *static_cast<void **>(ptr) = m_head;
-            m_head = ptr;
-            record->usd -= PAGE_SIZE;
+            this->drain(tls, *cache);
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds pages that the root OS donated to the provided
+        ///     node's stack. The loader maps each page into the page pool's
+        ///     direct map, tags it with a loader::donated_page_t and lists
+        ///     its physical address in a loader::donate_pages_t. Each page
+        ///     in the list is checked (see donated_page()) and claimed by
+        ///     clearing its tag before it is linked into the stack, so an
+        ///     invalid, duplicated or already added page is rejected
+        ///     instead of corrupting the stack. The remaining pages are
+        ///     still added, but bsl::errc_failure is returned so that the
+        ///     root OS knows that some of its pages were rejected.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param list_phys the physical address of the
+        ///     loader::donate_pages_t listing the donated pages
+        ///   @param node the index of the node to give the pages to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        donate(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &list_phys,
+            bsl::safe_uintmax const &node) &noexcept -> bsl::errc_type
+        {
+            if (bsl::unlikely(!m_initialized)) {
+                bsl::error() << "page_pool_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto *const dst{m_nodes.at_if(node)};
+            if (bsl::unlikely(nullptr == dst)) {
+                bsl::error() << "invalid node: "    // --
+                             << bsl::hex(node)      // --
+                             << bsl::endl           // --
+                             << bsl::here();        // --
+
+                return bsl::errc_failure;
+            }
+
+            auto const *const list{
+                this->template donated_page<loader::donate_pages_t const>(list_phys)};
+            if (bsl::unlikely(nullptr == list)) {
+                bsl::error() << "invalid donation list "    // --
+                             << bsl::hex(list_phys)         // --
+                             << bsl::endl                   // --
+                             << bsl::here();                // --
+
+                return bsl::errc_failure;
+            }
+
+            bsl::safe_uintmax const num{list->num};
+            if (bsl::unlikely(num.is_zero() || num > loader::DONATE_PAGES_MAX)) {
+                bsl::error() << "invalid number of donated pages "    // --
+                             << bsl::hex(num)                         // --
+                             << bsl::endl                             // --
+                             << bsl::here();                          // --
+
+                return bsl::errc_failure;
+            }
+
+            /// NOTE:
+            /// - Nothing else can see the donated pages until they are
+            ///   spliced onto the node's stack, so the list is validated
+            ///   without the lock. Only the splice itself, which is O(1),
+            ///   is done while holding the lock, which is why the other
+            ///   PPs (and their guests) never have to be paused.
+            /// - The root OS gives us physical addresses, and the list is
+            ///   bounded by loader::DONATE_PAGES_MAX, so nothing here
+            ///   follows a pointer that the root OS provided. A page is
+            ///   only used once its tag and physical address show that
+            ///   the direct map really maps it to the page the loader
+            ///   tagged, and the tag is cleared with a compare and
+            ///   exchange, so two PPs donating the same page (or the
+            ///   same list twice) can only ever add it once.
+            /// - The loader builds the page tables below the direct map's
+            ///   top level entries, and they are not in the direct map, so
+            ///   they cannot be walked here. Instead, the list and each page
+            ///   must be inside one of the ranges that the loader mapped and
+            ///   then registered (see is_donated()) before anything is read
+            ///   from them, so an address in the direct map that the loader
+            ///   never mapped is rejected instead of faulting.
+            ///
+
+            bsl::safe_uintmax pages{};
+            bsl::safe_uintmax rejected{};
+            auto phys_min{bsl::safe_uintmax::max_value()};
+            bsl::safe_uintmax phys_max{};
+
+            void *head{};
+            void *tail{};
+            for (bsl::safe_uintmax i{}; i < num; ++i) {
+                bsl::safe_uintmax const phys{*list->pages.at_if(i)};
+
+                auto *const page{this->template donated_page<loader::donated_page_t>(phys)};
+                if (bsl::unlikely(nullptr == page || list_phys == phys)) {
+                    bsl::error() << "invalid donated page "    // --
+                                 << bsl::hex(phys)             // --
+                                 << bsl::endl                  // --
+                                 << bsl::here();               // --
+
+                    ++rejected;
+                    continue;
+                }
+
+                auto expected{loader::DONATE_PAGES_TAG.get()};
+                if (bsl::unlikely(!__atomic_compare_exchange_n(
+                        &page->tag,
+                        &expected,
+                        bsl::uint64{},
+                        false,
+                        __ATOMIC_ACQ_REL,
+                        __ATOMIC_RELAXED))) {
+                    bsl::error() << "donated page already added "    // --
+                                 << bsl::hex(phys)                   // --
+                                 << bsl::endl                        // --
+                                 << bsl::here();                     // --
+
+                    ++rejected;
+                    continue;
+                }
+
+                page->phys = {};
+
+                void *const virt{page};
+                *static_cast<void **>(virt) = head;
+                head = virt;
+
+                if (nullptr == tail) {
+                    tail = virt;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                if (phys < phys_min) {
+                    phys_min = phys;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                if (phys > phys_max) {
+                    phys_max = phys;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                ++pages;
+            }
+
+            if (bsl::unlikely(pages.is_zero())) {
+                bsl::error() << "all of the donated pages were rejected\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            /// NOTE:
+            /// - The donated pages can come from anywhere in physical
+            ///   memory, so the node's range might now overlap with the
+            ///   range of another node. page_to_node() checks the PP's own
+            ///   node first, so the worst that can happen is that a page
+            ///   is returned to the wrong node, which only costs locality.
+            ///
+
+            auto const bytes{pages * PAGE_SIZE};
+            lock_guard lock{tls, m_lock};
+
+            *static_cast<void **>(tail) = dst->head;
+            dst->head = head;
+            dst->free += pages;
+
+            if (dst->size.is_zero()) {
+                dst->phys_min = phys_min;
+                dst->phys_max = phys_max;
+                dst->lowest = dst->free;
+            }
+            else {
+                if (phys_min < dst->phys_min) {
+                    dst->phys_min = phys_min;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                if (phys_max > dst->phys_max) {
+                    dst->phys_max = phys_max;
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            dst->size += bytes;
+            dst->donated += bytes;
+            m_size += bytes;
+
+            if (bsl::unlikely(!rejected.is_zero())) {
+                bsl::error() << "rejected "                // --
+                             << rejected                   // --
+                             << " of the donated pages"    // --
+                             << bsl::endl                  // --
+                             << bsl::here();               // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the index of the first node that has fewer than
+        ///     LOW_WATERMARK bytes left on its stack, or
+        ///     bsl::safe_uintmax::zero(true) if no node is low on pages.
+        ///     Nodes that were never given any pages are ignored. Note that
+        ///     pages sitting in a PP's cache are not counted as free.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @return Returns the index of the first node that has fewer
+        ///     than LOW_WATERMARK bytes left on its stack, or
+        ///     bsl::safe_uintmax::zero(true) if no node is low on pages.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        low_node(TLS_CONCEPT &tls) &noexcept -> bsl::safe_uintmax
+        {
+            if (bsl::unlikely(!m_initialized)) {
+                bsl::error() << "page_pool_t not initialized\n" << bsl::here();
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            lock_guard lock{tls, m_lock};
+
+            for (bsl::safe_uintmax i{}; i < m_nodes.size(); ++i) {
+                auto const *const node{m_nodes.at_if(i)};
+                if (node->size.is_zero()) {
+                    continue;
+                }
+
+                if (node->free * PAGE_SIZE < LOW_WATERMARK) {
+                    return i;
+                }
+
+                bsl::touch();
+            }
+
+            return bsl::safe_uintmax::zero(true);
         }
 
         /// <!-- description -->
@@ -434,8 +1340,8 @@ namespace mk
             bsl::print() << bsl::rst << bsl::endl;
 
             bsl::safe_uintmax usd{};
-            for (auto const elem : m_rcds) {
-                usd += elem.data->usd;
+            for (bsl::safe_uintmax i{}; i < m_rcds.size(); ++i) {
+                usd += this->record_usd(i);
             }
 
             /// Total
@@ -511,22 +1417,185 @@ namespace mk
             bsl::print() << bsl::ylw << "+----------------------------------+";
             bsl::print() << bsl::rst << bsl::endl;
 
-            for (auto const elem : m_rcds) {
-                if (elem.data->tag.empty()) {
+            for (bsl::safe_uintmax i{}; i < m_rcds.size(); ++i) {
+                auto const *const rcd{m_rcds.at_if(i)};
+                if (rcd->tag.empty()) {
                     continue;
                 }
 
+                auto const rcd_usd{this->record_usd(i)};
+
                 bsl::print() << bsl::ylw << "| ";
-                bsl::print() << bsl::rst << bsl::fmt{"<23s", elem.data->tag};
+                bsl::print() << bsl::rst << bsl::fmt{"<23s", rcd->tag};
                 bsl::print() << bsl::ylw << "| ";
-                if ((elem.data->usd / mb).is_zero()) {
-                    bsl::print() << bsl::rst << bsl::fmt{"4d", elem.data->usd / kb} << " KB ";
+                if ((rcd_usd / mb).is_zero()) {
+                    bsl::print() << bsl::rst << bsl::fmt{"4d", rcd_usd / kb} << " KB ";
                 }
                 else {
-                    bsl::print() << bsl::rst << bsl::fmt{"4d", elem.data->usd / mb} << " MB ";
+                    bsl::print() << bsl::rst << bsl::fmt{"4d", rcd_usd / mb} << " MB ";
+                }
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::endl;
+            }
+
+            /// Caches
+            ///
+
+            bsl::print() << bsl::ylw << "+----------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::rst << bsl::endl;
+            bsl::print() << bsl::ylw << "+----------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::blu << bsl::fmt{"^33s", "pp caches "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "+----------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^5s", "pp "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^7s", "pages "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^8s", "hits "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^7s", "misses "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "+----------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            for (bsl::safe_uintmax i{}; i < m_caches.size(); ++i) {
+                auto const *const cache{m_caches.at_if(i)};
+                if (cache->hits.is_zero() && cache->misses.is_zero()) {
+                    continue;
+                }
+
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"04x", bsl::to_u16(i)} << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"6d", cache->count} << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"7d", cache->hits} << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"6d", cache->misses} << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::endl;
+            }
+
+            /// NUMA Nodes
+            ///
+
+            bsl::print() << bsl::ylw << "+----------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::rst << bsl::endl;
+            bsl::print() << bsl::ylw << "+----------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::blu << bsl::fmt{"^33s", "numa nodes "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "+----------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^23s", "description "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^8s", "value "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            /// NOTE:
+            /// - "used" includes the pages that are sitting in a PP's cache
+            ///   as those pages are no longer on the node's stack. "remote"
+            ///   is the total amount of memory that the node has handed to
+            ///   the PPs of other nodes because their own node was empty.
+            /// - "lowest" is the least amount of memory that the node's
+            ///   stack has held, and "donated" is the amount of memory that
+            ///   the root OS has added to the node since it was started.
+            ///
+
+            for (bsl::safe_uintmax i{}; i < m_nodes.size(); ++i) {
+                auto const *const node{m_nodes.at_if(i)};
+                if (node->size.is_zero()) {
+                    continue;
                 }
+
+                bsl::print() << bsl::ylw << "+----------------------------------+";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                auto const fre{node->free * PAGE_SIZE};
+                dump_node_bytes(i, "total ", node->size);
+                dump_node_bytes(i, "used ", node->size - fre);
+                dump_node_bytes(i, "remaining ", fre);
+                dump_node_bytes(i, "remote ", node->remote * PAGE_SIZE);
+                dump_node_bytes(i, "lowest ", node->lowest * PAGE_SIZE);
+                dump_node_bytes(i, "donated ", node->donated);
+            }
+
+            /// Locks
+            ///
+
+            /// NOTE:
+            /// - The lock counters are only tracked if BSL_DEBUG_LEVEL is
+            ///   at least bsl::V, so this section is only shown then. "acq"
+            ///   is the number of times the lock was acquired, "cont" is how
+            ///   many of those had to wait, and "spins" is the total number
+            ///   of times a PP spun while waiting.
+            ///
+
+            if constexpr (!(BSL_DEBUG_LEVEL < bsl::V)) {
+                bsl::print() << bsl::ylw << "+----------------------------------+";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                bsl::print() << bsl::rst << bsl::endl;
+                bsl::print() << bsl::ylw << "+----------------------------------+";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::blu << bsl::fmt{"^33s", "locks "};
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                bsl::print() << bsl::ylw << "+----------------------------------+";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::cyn << bsl::fmt{"^5s", "pp "};
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::cyn << bsl::fmt{"^7s", "acq "};
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::cyn << bsl::fmt{"^8s", "cont "};
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::cyn << bsl::fmt{"^7s", "spins "};
                 bsl::print() << bsl::ylw << "| ";
                 bsl::print() << bsl::rst << bsl::endl;
+
+                bsl::print() << bsl::ylw << "+----------------------------------+";
+                bsl::print() << bsl::rst << bsl::endl;
+
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"<5s", "all "};
+                dump_lock(m_lock);
+
+                for (bsl::safe_uintmax i{}; i < m_caches.size(); ++i) {
+                    auto const *const cache{m_caches.at_if(i)};
+                    if (cache->lock.acquisitions().is_zero()) {
+                        continue;
+                    }
+
+                    bsl::print() << bsl::ylw << "| ";
+                    bsl::print() << bsl::rst << bsl::fmt{"04x", bsl::to_u16(i)} << " ";
+                    dump_lock(cache->lock);
+                }
             }
 
             /// Footer
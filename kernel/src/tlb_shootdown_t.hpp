@@ -0,0 +1,425 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef TLB_SHOOTDOWN_T_HPP
+#define TLB_SHOOTDOWN_T_HPP
+
+#include <allocate_tags.hpp>
+#include <lock_guard.hpp>
+#include <spinlock.hpp>
+#include <tlb_shootdown_node_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/is_constant_evaluated.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely_assert.hpp>
+
+namespace mk
+{
+    /// @class mk::tlb_shootdown_t
+    ///
+    /// <!-- description -->
+    ///   @brief Implements TLB shootdowns for memory that is unmapped
+    ///     from an extension. When a page is unmapped, other PPs might
+    ///     still have the old translation in their TLB, so the page cannot
+    ///     be given back to its pool until every PP has flushed its TLB.
+    ///
+    ///     The microkernel has no way to IPI itself today (see the IPI
+    ///     Design Doc for all of the details), so instead of sending an
+    ///     IPI and waiting for each PP to respond, which could deadlock if
+    ///     a PP never exits, shootdowns are deferred. Each unmap bumps a
+    ///     global generation, and each PP flushes its TLB and records the
+    ///     generation it has seen the next time it enters the microkernel
+    ///     on a VMExit, which is before the extension can execute again
+    ///     on that PP. Freed pages are parked (in the pages themselves) until
+    ///     every online PP has flushed a generation that is at least as
+    ///     new as the one the page was freed with, at which point they are
+    ///     returned to their pool. Any number of frees are completed by a
+    ///     single flush on each PP, so shootdowns are naturally batched.
+    ///
+    ///     A PP that is executing a VM cannot use the extension's mappings
+    ///     until it takes a VMExit, and flush() is called before the
+    ///     extension executes again, so a PP is not waited on while it is
+    ///     executing a VM. Otherwise, a PP that rarely (or never) exits
+    ///     would hold back the reclaim of every parked page. This bounds
+    ///     the wait to the time a PP spends in the microkernel or the
+    ///     extension, which always ends with either a VMEntry or a flush.
+    ///
+    ///     If an IPI mechanism is added (e.g., INIT/SX), all it has to do
+    ///     is force the remote PPs to exit so that they call flush().
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam MAX_PPS the max number of PPs supported
+    ///
+    template<bsl::uintmax MAX_PPS>
+    class tlb_shootdown_t final
+    {
+        /// @brief stores the current TLB generation
+        bsl::uint64 m_gen{};
+        /// @brief stores the last TLB generation flushed by each PP
+        bsl::array<bsl::uint64, MAX_PPS> m_flushed{};
+        /// @brief stores whether or not each PP is executing a VM
+        bsl::array<bsl::uint64, MAX_PPS> m_in_vm{};
+        /// @brief stores the first page pool page waiting on a shootdown
+        tlb_shootdown_node_t *m_page_head{};
+        /// @brief stores the last page pool page waiting on a shootdown
+        tlb_shootdown_node_t *m_page_tail{};
+        /// @brief stores the first huge pool page waiting on a shootdown
+        tlb_shootdown_node_t *m_huge_head{};
+        /// @brief stores the last huge pool page waiting on a shootdown
+        tlb_shootdown_node_t *m_huge_tail{};
+        /// @brief safe guards the lists of pages waiting on a shootdown
+        mutable spinlock m_lock{};
+
+        /// <!-- description -->
+        ///   @brief Returns the newest generation that every online PP has
+        ///     flushed. A PP that is executing a VM is treated as having
+        ///     flushed the current generation.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @return Returns the newest generation that every online PP
+        ///     has flushed.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        completed(TLS_CONCEPT const &tls) const &noexcept -> bsl::uint64
+        {
+            /// NOTE:
+            /// - The fence pairs with the fence in vmexit(). Either this PP
+            ///   sees that a PP is no longer executing its VM, or that PP
+            ///   sees the new generation when it calls flush().
+            ///
+
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            auto done{__atomic_load_n(&m_gen, __ATOMIC_ACQUIRE)};
+
+            for (bsl::safe_uintmax pp{}; pp < bsl::to_umax(tls.online_pps); ++pp) {
+                auto const *const flushed{m_flushed.at_if(pp)};
+                if (bsl::unlikely_assert(nullptr == flushed)) {
+                    return {};
+                }
+
+                auto const *const in_vm{m_in_vm.at_if(pp)};
+                if (bsl::unlikely_assert(nullptr == in_vm)) {
+                    return {};
+                }
+
+                if (bsl::uint64{} != __atomic_load_n(in_vm, __ATOMIC_ACQUIRE)) {
+                    continue;
+                }
+
+                auto const gen{__atomic_load_n(flushed, __ATOMIC_ACQUIRE)};
+                if (gen < done) {
+                    done = gen;
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            return done;
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds a page to the provided list of pages waiting on a
+        ///     shootdown.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param head the head of the list to add the page to
+        ///   @param tail the tail of the list to add the page to
+        ///   @param page the page to add
+        ///   @param gen the generation every PP must flush before reuse
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        park(
+            TLS_CONCEPT &tls,
+            tlb_shootdown_node_t *&head,
+            tlb_shootdown_node_t *&tail,
+            void *const page,
+            bsl::safe_uintmax const &gen) &noexcept
+        {
+            auto *const node{static_cast<tlb_shootdown_node_t *>(page)};
+            node->next = nullptr;
+            node->gen = gen.get();
+
+            lock_guard lock{tls, m_lock};
+
+            /// NOTE:
+            /// - Generations only ever increase, so appending to the tail
+            ///   keeps each list sorted, which means reclaim() can stop
+            ///   at the first page that is not ready yet.
+            ///
+
+            if (nullptr == tail) {
+                head = node;
+            }
+            else {
+                tail->next = node;
+            }
+
+            __atomic_store_n(&tail, node, __ATOMIC_RELEASE);
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Marks the PP that calls this function as executing a
+        ///     VM. This must be called right before the VM is executed,
+        ///     after the microkernel and the extension are done with the
+        ///     extension's memory.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        vmentry(TLS_CONCEPT const &tls) &noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            auto *const in_vm{m_in_vm.at_if(bsl::to_umax(tls.ppid))};
+            if (bsl::unlikely_assert(nullptr == in_vm)) {
+                return;
+            }
+
+            __atomic_store_n(in_vm, bsl::uint64{1}, __ATOMIC_RELEASE);
+        }
+
+        /// <!-- description -->
+        ///   @brief Marks the PP that calls this function as no longer
+        ///     executing a VM. This must be called on every VMExit, before
+        ///     flush() is called.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        vmexit(TLS_CONCEPT const &tls) &noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            auto *const in_vm{m_in_vm.at_if(bsl::to_umax(tls.ppid))};
+            if (bsl::unlikely_assert(nullptr == in_vm)) {
+                return;
+            }
+
+            __atomic_store_n(in_vm, bsl::uint64{}, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        }
+
+        /// <!-- description -->
+        ///   @brief Flushes the TLB of the PP that calls this function if
+        ///     a shootdown was requested since the last time this PP
+        ///     flushed its TLB. This must be called each time the microkernel
+        ///     is entered from a VMExit, before the extension is executed.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        constexpr void
+        flush(TLS_CONCEPT const &tls, INTRINSIC_CONCEPT &intrinsic) &noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            auto *const flushed{m_flushed.at_if(bsl::to_umax(tls.ppid))};
+            if (bsl::unlikely_assert(nullptr == flushed)) {
+                bsl::error() << "invalid ppid: "       // --
+                             << bsl::hex(tls.ppid)    // --
+                             << bsl::endl             // --
+                             << bsl::here();          // --
+
+                return;
+            }
+
+            auto const gen{__atomic_load_n(&m_gen, __ATOMIC_ACQUIRE)};
+            if (gen == *flushed) {
+                return;
+            }
+
+            /// NOTE:
+            /// - Only the non-global TLB entries need to be flushed, as that
+            ///   is all an extension is allowed to have. Since the direct
+            ///   maps are tagged with PCIDs, a stale entry can belong to
+            ///   any of them, so every PCID is flushed, not just the one
+            ///   that is currently active.
+            ///
+
+            intrinsic.flush_tlb();
+            __atomic_store_n(flushed, gen, __ATOMIC_RELEASE);
+        }
+
+        /// <!-- description -->
+        ///   @brief Requests a TLB shootdown on all PPs. This should be
+        ///     called after memory has been unmapped. The TLB of the PP
+        ///     that calls this function is flushed right away.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @return Returns the generation that every PP must flush before
+        ///     the unmapped memory can be reused.
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        [[nodiscard]] constexpr auto
+        request(TLS_CONCEPT const &tls, INTRINSIC_CONCEPT &intrinsic) &noexcept
+            -> bsl::safe_uintmax
+        {
+            if (bsl::is_constant_evaluated()) {
+                return {};
+            }
+
+            auto const gen{
+                bsl::to_umax(__atomic_add_fetch(&m_gen, bsl::uint64{1}, __ATOMIC_ACQ_REL))};
+
+            this->flush(tls, intrinsic);
+            return gen;
+        }
+
+        /// <!-- description -->
+        ///   @brief Parks a page that came from the page pool until the
+        ///     provided generation has been flushed by every PP.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page the page pool page (in the microkernel's direct map)
+        ///   @param gen the generation returned by request()
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        park_page(TLS_CONCEPT &tls, void *const page, bsl::safe_uintmax const &gen) &noexcept
+        {
+            this->park(tls, m_page_head, m_page_tail, page, gen);
+        }
+
+        /// <!-- description -->
+        ///   @brief Parks a page that came from the huge pool until the
+        ///     provided generation has been flushed by every PP.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page the huge pool page (in the microkernel's direct map)
+        ///   @param gen the generation returned by request()
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        park_huge(TLS_CONCEPT &tls, void *const page, bsl::safe_uintmax const &gen) &noexcept
+        {
+            this->park(tls, m_huge_head, m_huge_tail, page, gen);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns every parked page whose shootdown has completed
+        ///     back to the pool that it came from.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam PAGE_POOL_CONCEPT defines the type of page pool to use
+        ///   @tparam HUGE_POOL_CONCEPT defines the type of huge pool to use
+        ///   @param tls the current TLS block
+        ///   @param page_pool the page pool to return pages to
+        ///   @param huge_pool the huge pool to return pages to
+        ///
+        template<typename TLS_CONCEPT, typename PAGE_POOL_CONCEPT, typename HUGE_POOL_CONCEPT>
+        constexpr void
+        reclaim(
+            TLS_CONCEPT &tls,
+            PAGE_POOL_CONCEPT &page_pool,
+            HUGE_POOL_CONCEPT &huge_pool) &noexcept
+        {
+            /// NOTE:
+            /// - This is called on every allocation, so the common case of
+            ///   nothing being parked has to stay off of the lock.
+            ///
+
+            if (nullptr == __atomic_load_n(&m_page_tail, __ATOMIC_ACQUIRE)) {
+                if (nullptr == __atomic_load_n(&m_huge_tail, __ATOMIC_ACQUIRE)) {
+                    return;
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
+            lock_guard lock{tls, m_lock};
+            auto const done{this->completed(tls)};
+
+            while ((nullptr != m_page_head) && (m_page_head->gen <= done)) {
+                auto *const node{m_page_head};
+                m_page_head = node->next;
+
+                page_pool.deallocate(tls, node, ALLOCATE_TAG_BF_MEM_OP_ALLOC_PAGE);
+            }
+
+            if (nullptr == m_page_head) {
+                __atomic_store_n(&m_page_tail, nullptr, __ATOMIC_RELEASE);
+            }
+            else {
+                bsl::touch();
+            }
+
+            while ((nullptr != m_huge_head) && (m_huge_head->gen <= done)) {
+                auto *const node{m_huge_head};
+                m_huge_head = node->next;
+
+                huge_pool.deallocate(tls, node);
+            }
+
+            if (nullptr == m_huge_head) {
+                __atomic_store_n(&m_huge_tail, nullptr, __ATOMIC_RELEASE);
+            }
+            else {
+                bsl::touch();
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,201 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef TRACE_T_HPP
+#define TRACE_T_HPP
+
+#include <trace_event.hpp>
+#include <trace_pp_t.hpp>
+#include <trace_record_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/likely.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/string_view.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace mk
+{
+    /// @class mk::trace_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores a TSC stamped timeline of events (VMExits, VMEntries,
+    ///     syscalls, calls into an extension and ESRs) for each PP in a
+    ///     fixed size ring. Unlike the VMExit log, which is only compiled in
+    ///     for debug builds, the trace is always compiled in, but it is
+    ///     disabled by default and only records anything once it has been
+    ///     enabled using bf_control_op_trace, so that the cost of a
+    ///     disabled trace is a single load. Only the PP that owns a ring
+    ///     ever writes to it, which is why no lock is needed.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam TRACE_SIZE defines the number of records per PP
+    ///   @tparam MAX_PPS the max number of PPs supported
+    ///
+    template<bsl::uintmax TRACE_SIZE, bsl::uintmax MAX_PPS>
+    class trace_t final
+    {
+        /// @brief stores the trace rings
+        bsl::array<trace_pp_t<TRACE_SIZE>, MAX_PPS> m_trace{};
+        /// @brief stores true if the trace is enabled
+        bool m_enabled{};
+
+    public:
+        /// <!-- description -->
+        ///   @brief Enables or disables the trace on all PPs
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param enabled true to enable the trace, false to disable it
+        ///
+        constexpr void
+        enable(bool const enabled) &noexcept
+        {
+            __atomic_store_n(&m_enabled, enabled, __ATOMIC_RELAXED);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the trace is enabled
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns true if the trace is enabled
+        ///
+        [[nodiscard]] constexpr auto
+        is_enabled() const &noexcept -> bool
+        {
+            return __atomic_load_n(&m_enabled, __ATOMIC_RELAXED);
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds an event to the current PP's trace ring, stamped
+        ///     with the current TSC and the active VM, VP and VPS. Once the
+        ///     ring is full, the oldest record is overwritten. Nothing is
+        ///     recorded (and the TSC is not read) if the trace is disabled.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param event the ID of the event to record
+        ///   @param arg the event specific argument to record
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        constexpr void
+        record(
+            TLS_CONCEPT const &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uint16 const &event,
+            bsl::safe_uintmax const &arg) &noexcept
+        {
+            if (bsl::likely(!this->is_enabled())) {
+                return;
+            }
+
+            auto *const pp_trace{m_trace.at_if(bsl::to_umax(tls.ppid))};
+            if (bsl::unlikely(nullptr == pp_trace)) {
+                return;
+            }
+
+            /// NOTE:
+            /// - The slot is claimed with a single atomic add before it is
+            ///   filled in. An NMI that records an event while we are in
+            ///   the middle of filling in a record claims the next slot
+            ///   instead of overwriting ours.
+            ///
+
+            auto const raw{__atomic_fetch_add(&pp_trace->count, bsl::uint64{1}, __ATOMIC_RELAXED)};
+            bsl::safe_uintmax const count{bsl::to_umax(raw)};
+
+            auto *const rcd{pp_trace->rcds.at_if(count % pp_trace->rcds.size())};
+            rcd->tsc = intrinsic.rdtsc().get();
+            rcd->arg = arg.get();
+            rcd->event = event.get();
+            rcd->vmid = tls.active_vmid;
+            rcd->vpid = tls.active_vpid;
+            rcd->vpsid = tls.active_vpsid;
+        }
+
+        /// <!-- description -->
+        ///   @brief Dumps the trace ring for the requested PP, oldest record
+        ///     first. Each record is output on its own line in the following
+        ///     form (all numbers in hex), which is what vmmctl trace parses:
+        ///
+        ///     trace <ppid> <tsc> <event> <vmid> <vpid> <vpsid> <arg>
+        ///
+        ///     The trace should be disabled before it is dumped. Otherwise
+        ///     the PP being dumped might overwrite records as they are
+        ///     being output.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ppid the ID of the PP whose trace should be dumped
+        ///
+        constexpr void
+        dump(bsl::safe_uint16 const &ppid) const &noexcept
+        {
+            auto const *const pp_trace{m_trace.at_if(bsl::to_umax(ppid))};
+            if (bsl::unlikely(nullptr == pp_trace)) {
+                bsl::error() << "invalid ppid: "    // --
+                             << bsl::hex(ppid)      // --
+                             << bsl::endl           // --
+                             << bsl::here();        // --
+
+                return;
+            }
+
+            bsl::safe_uintmax const count{bsl::to_umax(pp_trace->count)};
+
+            bsl::safe_uintmax first{};
+            if (count > pp_trace->rcds.size()) {
+                first = count - pp_trace->rcds.size();
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::print() << "trace pp " << bsl::fmt{"x", ppid};
+            bsl::print() << ' ' << bsl::fmt{"x", count - first};
+            bsl::print() << ' ' << bsl::fmt{"x", first} << bsl::endl;
+
+            for (bsl::safe_uintmax i{first}; i < count; ++i) {
+                auto const *const rcd{pp_trace->rcds.at_if(i % pp_trace->rcds.size())};
+
+                bsl::print() << "trace " << bsl::fmt{"x", ppid};
+                bsl::print() << ' ' << bsl::fmt{"x", bsl::to_umax(rcd->tsc)};
+                bsl::print() << ' ' << trace_event_to_name(bsl::to_u16(rcd->event));
+                bsl::print() << ' ' << bsl::fmt{"x", bsl::to_u16(rcd->vmid)};
+                bsl::print() << ' ' << bsl::fmt{"x", bsl::to_u16(rcd->vpid)};
+                bsl::print() << ' ' << bsl::fmt{"x", bsl::to_u16(rcd->vpsid)};
+                bsl::print() << ' ' << bsl::fmt{"x", bsl::to_umax(rcd->arg)};
+                bsl::print() << bsl::endl;
+            }
+        }
+    };
+}
+
+#endif
@@ -27,6 +27,7 @@
 
 #include <lock_guard.hpp>
 #include <mk_interface.hpp>
+#include <pool_bitmap_t.hpp>
 #include <spinlock.hpp>
 
 #include <bsl/array.hpp>
@@ -52,6 +53,8 @@ namespace mk
     {
         /// @brief stores the VM_CONCEPTs in the VM_CONCEPT linked list
         bsl::array<VM_CONCEPT, MAX_VMS> m_pool{};
+        /// @brief stores which VMs in the pool are not deallocated
+        pool_bitmap_t<MAX_VMS> m_used{};
         /// @brief safe guards operations on the pool.
         mutable spinlock m_lock{};
 
@@ -130,6 +133,7 @@ namespace mk
                 bsl::touch();
             }
 
+            m_used.clear_all();
             return bsl::errc_success;
         }
 
@@ -149,22 +153,26 @@ namespace mk
         {
             lock_guard lock{tls, m_lock};
 
-            VM_CONCEPT *vm{};
-            for (auto const elem : m_pool) {
-                if (elem.data->is_deallocated()) {
-                    vm = elem.data;
-                    break;
-                }
+            auto const i{m_used.find_first_clear()};
+            if (bsl::unlikely(!i)) {
+                bsl::error() << "vm pool out of vms\n" << bsl::here();
+                return bsl::safe_uint16::zero(true);
+            }
 
-                bsl::touch();
+            auto *const vm{m_pool.at_if(i)};
+            if (bsl::unlikely_assert(nullptr == vm)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::safe_uint16::zero(true);
             }
 
-            if (bsl::unlikely(nullptr == vm)) {
-                bsl::error() << "vm pool out of vms\n" << bsl::here();
+            auto const vmid{vm->allocate(tls, ext_pool)};
+            if (bsl::unlikely(!vmid)) {
+                bsl::print<bsl::V>() << bsl::here();
                 return bsl::safe_uint16::zero(true);
             }
 
-            return vm->allocate(tls, ext_pool);
+            m_used.set(i);
+            return vmid;
         }
 
         /// <!-- description -->
@@ -202,7 +210,14 @@ namespace mk
                 return bsl::errc_index_out_of_bounds;
             }
 
-            return vm->deallocate(tls, ext_pool, vp_pool);
+            auto const ret{vm->deallocate(tls, ext_pool, vp_pool)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            m_used.clear(bsl::to_umax(vmid));
+            return ret;
         }
 
         /// <!-- description -->
@@ -229,7 +244,14 @@ namespace mk
                 return bsl::errc_index_out_of_bounds;
             }
 
+            /// NOTE:
+            /// - A zombie is never deallocated, so it must stay marked as
+            ///   in use, even if it was deallocated when it was zombified.
+            ///
+
             vm->zombify();
+            m_used.set(bsl::to_umax(vmid));
+
             return bsl::errc_success;
         }
 
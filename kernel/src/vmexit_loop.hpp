@@ -25,6 +25,8 @@
 #ifndef VMEXIT_LOOP_HPP
 #define VMEXIT_LOOP_HPP
 
+#include <trace_event.hpp>
+
 #include <bsl/debug.hpp>
 #include <bsl/exit_code.hpp>
 #include <bsl/unlikely.hpp>
@@ -41,11 +43,17 @@ namespace mk
     ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
     ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @tparam VMEXIT_LOG_CONCEPT defines the type of VMExit log to use
+    ///   @tparam VMEXIT_STATS_CONCEPT defines the type of VMExit stats to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
+    ///   @tparam TLB_SHOOTDOWN_CONCEPT defines the type of TLB shootdown to use
     ///   @param tls the current TLS block
     ///   @param ext the ext_t to handle the VMExit
     ///   @param intrinsic the intrinsics to use
     ///   @param vps_pool the VPS pool to use
     ///   @param log the VMExit log to use
+    ///   @param stats the VMExit stats to use
+    ///   @param trace the trace to use
+    ///   @param tlb_shootdown the TLB shootdown to use
     ///   @return Returns bsl::exit_success on success, bsl::exit_failure
     ///     otherwise
     ///
@@ -54,21 +62,60 @@ namespace mk
         typename EXT_CONCEPT,
         typename INTRINSIC_CONCEPT,
         typename VPS_POOL_CONCEPT,
-        typename VMEXIT_LOG_CONCEPT>
+        typename VMEXIT_LOG_CONCEPT,
+        typename VMEXIT_STATS_CONCEPT,
+        typename TRACE_CONCEPT,
+        typename TLB_SHOOTDOWN_CONCEPT>
     [[nodiscard]] constexpr auto
     vmexit_loop(
         TLS_CONCEPT &tls,
         EXT_CONCEPT &ext,
         INTRINSIC_CONCEPT &intrinsic,
         VPS_POOL_CONCEPT &vps_pool,
-        VMEXIT_LOG_CONCEPT &log) noexcept -> bsl::exit_code
+        VMEXIT_LOG_CONCEPT &log,
+        VMEXIT_STATS_CONCEPT &stats,
+        TRACE_CONCEPT &trace,
+        TLB_SHOOTDOWN_CONCEPT &tlb_shootdown) noexcept -> bsl::exit_code
     {
+        stats.vmentry(tls.ppid, intrinsic.rdtsc());
+        trace.record(tls, intrinsic, TRACE_EVENT_VMENTRY, {});
+
+        tlb_shootdown.vmentry(tls);
         auto const exit_reason{vps_pool.run(tls, intrinsic, tls.active_vpsid, log)};
+        tlb_shootdown.vmexit(tls);
+
         if (bsl::unlikely(!exit_reason)) {
             bsl::print<bsl::V>() << bsl::here();
             return bsl::exit_failure;
         }
 
+        stats.vmexit(tls.ppid, exit_reason, intrinsic.rdtsc());
+        trace.record(tls, intrinsic, TRACE_EVENT_VMEXIT, exit_reason);
+
+        /// NOTE:
+        /// - If memory was unmapped from the extension while this PP was
+        ///   executing the VM, the TLB has to be flushed before the
+        ///   extension executes again. See tlb_shootdown_t for more info.
+        /// - This is also done for VMExits that are handled by an exit
+        ///   policy. Otherwise, a PP that only takes those VMExits would
+        ///   never record a newer generation, and the pages parked on a
+        ///   shootdown could not be reclaimed until it entered the
+        ///   extension. When nothing was unmapped, this is a single load.
+        ///
+
+        tlb_shootdown.flush(tls, intrinsic);
+
+        /// NOTE:
+        /// - Trivial VMExits that the extension registered an exit policy
+        ///   for are handled here, and the VPS is run again without
+        ///   entering the extension. See exit_policy_t for more info.
+        ///
+
+        if (vps_pool.exit_policy(tls, intrinsic, tls.active_vpsid, exit_reason)) {
+            return bsl::exit_success;
+        }
+
+        stats.ext_entry(tls.ppid, intrinsic.rdtsc());
         auto const ret{ext.vmexit(tls, exit_reason)};
         if (bsl::unlikely(!ret)) {
             bsl::print<bsl::V>() << bsl::here();
@@ -22,6 +22,7 @@
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
 
+#include <console_write.hpp>
 #include <global_resources.hpp>
 #include <tls_t.hpp>
 #include <vmexit_loop.hpp>
@@ -48,11 +49,15 @@ namespace mk
     extern "C" [[nodiscard]] auto
     vmexit_loop_trampoline(tls_t *const tls) noexcept -> bsl::exit_code
     {
+        console_poll();
         return vmexit_loop(
             *tls,
             *static_cast<mk_ext_type *>(tls->ext_vmexit),
             g_intrinsic,
             g_vps_pool,
-            g_vmexit_log);
+            g_vmexit_log,
+            g_vmexit_stats,
+            g_trace,
+            g_tlb_shootdown);
     }
 }
@@ -0,0 +1,322 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef VMEXIT_STATS_T_HPP
+#define VMEXIT_STATS_T_HPP
+
+#include <vmexit_stats_pp_t.hpp>
+#include <vmexit_stats_record_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace mk
+{
+    /// @class mk::vmexit_stats_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores a compact set of VMExit statistics for each PP. Unlike
+    ///     the VMExit log, which records every register of every VMExit and
+    ///     is only compiled in for debug builds, the stats are always
+    ///     enabled. For each exit reason, a PP counts the number of VMExits
+    ///     and the number of TSC cycles it took to handle them, and it also
+    ///     keeps track of how many of those cycles were spent in the
+    ///     microkernel vs. the extension. Only the PP that owns a set of
+    ///     stats ever updates them, which is why no lock is needed.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam VMEXIT_STATS_SIZE defines the max number of exit reasons
+    ///   @tparam MAX_PPS the max number of PPs supported
+    ///
+    template<bsl::uintmax VMEXIT_STATS_SIZE, bsl::uintmax MAX_PPS>
+    class vmexit_stats_t final
+    {
+        /// @brief stores the VMExit stats
+        bsl::array<vmexit_stats_pp_t<VMEXIT_STATS_SIZE>, MAX_PPS> m_vmexit_stats{};
+
+        /// <!-- description -->
+        ///   @brief Returns the number of cycles between two TSC values, or
+        ///     0 if the start is not set or the TSC went backwards.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param start the TSC at the start of the interval
+        ///   @param end the TSC at the end of the interval
+        ///   @return Returns the number of cycles between start and end
+        ///
+        [[nodiscard]] static constexpr auto
+        elapsed(bsl::safe_uintmax const &start, bsl::safe_uintmax const &end) noexcept
+            -> bsl::safe_uintmax
+        {
+            if (bsl::unlikely(start.is_zero())) {
+                return {};
+            }
+
+            if (bsl::unlikely(!(end > start))) {
+                return {};
+            }
+
+            return end - start;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the record associated with the provided exit
+        ///     reason, adding it if needed. Records are stored in an open
+        ///     addressed hash table keyed by exit reason so that sparse exit
+        ///     reasons (e.g., AMD's NPF exit) do not require a large table.
+        ///     If the table is full, a nullptr is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param pp_stats the PP stats to search
+        ///   @param exit_reason the exit reason to search for
+        ///   @return Returns the record associated with the provided exit
+        ///     reason, or a nullptr if the table is full.
+        ///
+        [[nodiscard]] static constexpr auto
+        find_or_add(
+            vmexit_stats_pp_t<VMEXIT_STATS_SIZE> *const pp_stats,
+            bsl::safe_uintmax const &exit_reason) noexcept -> vmexit_stats_record_t *
+        {
+            auto idx{exit_reason % pp_stats->rcds.size()};
+            for (bsl::safe_uintmax i{}; i < pp_stats->rcds.size(); ++i) {
+                auto *const rcd{pp_stats->rcds.at_if(idx)};
+
+                if (rcd->count.is_zero()) {
+                    rcd->exit_reason = exit_reason;
+                    return rcd;
+                }
+
+                if (exit_reason == rcd->exit_reason) {
+                    return rcd;
+                }
+
+                ++idx;
+                if (idx < pp_stats->rcds.size()) {
+                    bsl::touch();
+                }
+                else {
+                    idx = {};
+                }
+            }
+
+            return nullptr;
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Tells the VMExit stats that the provided PP is about to
+        ///     run a VPS. If a VMExit was being handled, the cycles it took
+        ///     are added to its exit reason and the time the extension spent
+        ///     handling it is added to the extension's total.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ppid the ID of the PP that is about to run a VPS
+        ///   @param tsc the current value of the TSC
+        ///
+        constexpr void
+        vmentry(bsl::safe_uint16 const &ppid, bsl::safe_uintmax const &tsc) &noexcept
+        {
+            auto *const pp_stats{m_vmexit_stats.at_if(bsl::to_umax(ppid))};
+            if (bsl::unlikely(nullptr == pp_stats)) {
+                return;
+            }
+
+            pp_stats->ext_cycles += this->elapsed(pp_stats->ext_tsc, tsc);
+            if (nullptr != pp_stats->pending) {
+                pp_stats->pending->cycles += this->elapsed(pp_stats->exit_tsc, tsc);
+            }
+            else {
+                bsl::touch();
+            }
+
+            pp_stats->exit_tsc = {};
+            pp_stats->ext_tsc = {};
+            pp_stats->pending = nullptr;
+        }
+
+        /// <!-- description -->
+        ///   @brief Tells the VMExit stats that a VMExit occurred on the
+        ///     provided PP.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ppid the ID of the PP the VMExit occurred on
+        ///   @param exit_reason the exit reason of the VMExit
+        ///   @param tsc the current value of the TSC
+        ///
+        constexpr void
+        vmexit(
+            bsl::safe_uint16 const &ppid,
+            bsl::safe_uintmax const &exit_reason,
+            bsl::safe_uintmax const &tsc) &noexcept
+        {
+            auto *const pp_stats{m_vmexit_stats.at_if(bsl::to_umax(ppid))};
+            if (bsl::unlikely(nullptr == pp_stats)) {
+                return;
+            }
+
+            auto *const rcd{this->find_or_add(pp_stats, exit_reason)};
+            if (bsl::unlikely(nullptr == rcd)) {
+                ++pp_stats->dropped;
+            }
+            else {
+                ++rcd->count;
+            }
+
+            pp_stats->exit_tsc = tsc;
+            pp_stats->pending = rcd;
+        }
+
+        /// <!-- description -->
+        ///   @brief Tells the VMExit stats that the microkernel is about to
+        ///     hand the current VMExit to the extension on the provided PP.
+        ///     Everything between the VMExit and this call is counted as
+        ///     time spent in the microkernel.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ppid the ID of the PP that is calling the extension
+        ///   @param tsc the current value of the TSC
+        ///
+        constexpr void
+        ext_entry(bsl::safe_uint16 const &ppid, bsl::safe_uintmax const &tsc) &noexcept
+        {
+            auto *const pp_stats{m_vmexit_stats.at_if(bsl::to_umax(ppid))};
+            if (bsl::unlikely(nullptr == pp_stats)) {
+                return;
+            }
+
+            pp_stats->mk_cycles += this->elapsed(pp_stats->exit_tsc, tsc);
+            pp_stats->ext_tsc = tsc;
+        }
+
+        /// <!-- description -->
+        ///   @brief Dumps the VMExit stats for the requested PP
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ppid the ID of the PP whose stats should be dumped
+        ///
+        constexpr void
+        dump(bsl::safe_uint16 const &ppid) const &noexcept
+        {
+            auto const *const pp_stats{m_vmexit_stats.at_if(bsl::to_umax(ppid))};
+            if (bsl::unlikely(nullptr == pp_stats)) {
+                bsl::error() << "invalid ppid: "    // --
+                             << bsl::hex(ppid)      // --
+                             << bsl::endl           // --
+                             << bsl::here();        // --
+
+                return;
+            }
+
+            bsl::print() << bsl::mag << "vmexit stats for pp [";
+            bsl::print() << bsl::rst << bsl::hex(ppid);
+            bsl::print() << bsl::mag << "]: ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            /// Header
+            ///
+
+            bsl::print() << bsl::ylw << "+---------------------------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^10s", "reason "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^12s", "count "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^14s", "cycles "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::cyn << bsl::fmt{"^8s", "avg "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "+---------------------------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            /// Exit Reasons
+            ///
+
+            bsl::safe_uintmax total{};
+            for (auto const &rcd : pp_stats->rcds) {
+                if (rcd.data->count.is_zero()) {
+                    continue;
+                }
+
+                total += rcd.data->count;
+
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"#010x", rcd.data->exit_reason};
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"11d", rcd.data->count} << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"13d", rcd.data->cycles} << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::fmt{"7d", rcd.data->cycles / rcd.data->count};
+                bsl::print() << " ";
+                bsl::print() << bsl::ylw << "| ";
+                bsl::print() << bsl::rst << bsl::endl;
+            }
+
+            bsl::print() << bsl::ylw << "+---------------------------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            /// Totals
+            ///
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"<22s", "total exits "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"25d", total} << " ";
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"<22s", "dropped exits "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"25d", pp_stats->dropped} << " ";
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"<22s", "microkernel cycles "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"25d", pp_stats->mk_cycles} << " ";
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"<22s", "extension cycles "};
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::fmt{"25d", pp_stats->ext_cycles} << " ";
+            bsl::print() << bsl::ylw << "| ";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            bsl::print() << bsl::ylw << "+---------------------------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+        }
+    };
+}
+
+#endif
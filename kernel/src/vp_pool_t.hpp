@@ -27,6 +27,8 @@
 
 #include <lock_guard.hpp>
 #include <mk_interface.hpp>
+#include <pool_bitmap_t.hpp>
+#include <pool_counts_t.hpp>
 #include <spinlock.hpp>
 
 #include <bsl/array.hpp>
@@ -46,12 +48,17 @@ namespace mk
     /// <!-- template parameters -->
     ///   @tparam VP_CONCEPT the type of vp_t that this class manages.
     ///   @tparam MAX_VPS the max number of VPs supported
+    ///   @tparam MAX_VMS the max number of VMs supported
     ///
-    template<typename VP_CONCEPT, bsl::uintmax MAX_VPS>
+    template<typename VP_CONCEPT, bsl::uintmax MAX_VPS, bsl::uintmax MAX_VMS>
     class vp_pool_t final
     {
         /// @brief stores the VP_CONCEPTs in the VP_CONCEPT linked list
         bsl::array<VP_CONCEPT, MAX_VPS> m_pool{};
+        /// @brief stores which VPs in the pool are not deallocated
+        pool_bitmap_t<MAX_VPS> m_used{};
+        /// @brief stores the number of VPs assigned to each VM
+        pool_counts_t<MAX_VMS> m_vps_per_vm{};
         /// @brief safe guards operations on the pool.
         mutable spinlock m_lock{};
 
@@ -125,6 +132,9 @@ namespace mk
                 bsl::touch();
             }
 
+            m_used.clear_all();
+            m_vps_per_vm.clear_all();
+
             return bsl::errc_success;
         }
 
@@ -150,22 +160,28 @@ namespace mk
         {
             lock_guard lock{tls, m_lock};
 
-            VP_CONCEPT *vp{};
-            for (auto const elem : m_pool) {
-                if (elem.data->is_deallocated()) {
-                    vp = elem.data;
-                    break;
-                }
+            auto const i{m_used.find_first_clear()};
+            if (bsl::unlikely(!i)) {
+                bsl::error() << "vp pool out of vps\n" << bsl::here();
+                return bsl::safe_uint16::zero(true);
+            }
 
-                bsl::touch();
+            auto *const vp{m_pool.at_if(i)};
+            if (bsl::unlikely_assert(nullptr == vp)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::safe_uint16::zero(true);
             }
 
-            if (bsl::unlikely(nullptr == vp)) {
-                bsl::error() << "vp pool out of vps\n" << bsl::here();
+            auto const vpid{vp->allocate(tls, vm_pool, vmid, ppid)};
+            if (bsl::unlikely(!vpid)) {
+                bsl::print<bsl::V>() << bsl::here();
                 return bsl::safe_uint16::zero(true);
             }
 
-            return vp->allocate(tls, vm_pool, vmid, ppid);
+            m_used.set(i);
+            m_vps_per_vm.inc(vmid);
+
+            return vpid;
         }
 
         /// <!-- description -->
@@ -199,7 +215,17 @@ namespace mk
                 return bsl::errc_index_out_of_bounds;
             }
 
-            return vp->deallocate(tls, vps_pool);
+            auto const vmid{vp->assigned_vm()};
+            auto const ret{vp->deallocate(tls, vps_pool)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            m_used.clear(bsl::to_umax(vpid));
+            m_vps_per_vm.dec(vmid);
+
+            return ret;
         }
 
         /// <!-- description -->
@@ -226,7 +252,15 @@ namespace mk
                 return bsl::errc_index_out_of_bounds;
             }
 
+            /// NOTE:
+            /// - A zombie is never deallocated, so it must stay marked as
+            ///   in use, even if it was deallocated when it was zombified.
+            ///   It also stays assigned to its VM, so the count is left as is.
+            ///
+
             vp->zombify();
+            m_used.set(bsl::to_umax(vpid));
+
             return bsl::errc_success;
         }
 
@@ -341,6 +375,16 @@ namespace mk
                 return bsl::safe_uint16::zero(true);
             }
 
+            /// NOTE:
+            /// - The common case is that nothing is assigned to the VM, which
+            ///   the count answers without looking at the pool. The pool is
+            ///   only walked to report which VP is still assigned.
+            ///
+
+            if (m_vps_per_vm.is_zero(vmid)) {
+                return bsl::safe_uint16::zero(true);
+            }
+
             for (auto const elem : m_pool) {
                 if (elem.data->assigned_vm() == vmid) {
                     return elem.data->id();
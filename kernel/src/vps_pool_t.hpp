@@ -27,12 +27,15 @@
 
 #include <lock_guard.hpp>
 #include <mk_interface.hpp>
+#include <pool_bitmap_t.hpp>
+#include <pool_counts_t.hpp>
 #include <spinlock.hpp>
 
 #include <bsl/array.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/errc_type.hpp>
 #include <bsl/finally_assert.hpp>
+#include <bsl/span.hpp>
 #include <bsl/unlikely.hpp>
 #include <bsl/unlikely_assert.hpp>
 
@@ -46,12 +49,17 @@ namespace mk
     /// <!-- template parameters -->
     ///   @tparam VPS_CONCEPT the type of vps_t that this class manages.
     ///   @tparam MAX_VPSS the max number of VPSs supported
+    ///   @tparam MAX_VPS the max number of VPs supported
     ///
-    template<typename VPS_CONCEPT, bsl::uintmax MAX_VPSS>
+    template<typename VPS_CONCEPT, bsl::uintmax MAX_VPSS, bsl::uintmax MAX_VPS>
     class vps_pool_t final
     {
         /// @brief stores the VPS_CONCEPTs in the VPS_CONCEPT linked list
         bsl::array<VPS_CONCEPT, MAX_VPSS> m_pool{};
+        /// @brief stores which VPSs in the pool are not deallocated
+        pool_bitmap_t<MAX_VPSS> m_used{};
+        /// @brief stores the number of VPSs assigned to each VP
+        pool_counts_t<MAX_VPS> m_vpss_per_vp{};
         /// @brief safe guards operations on the pool.
         mutable spinlock m_lock{};
 
@@ -125,6 +133,9 @@ namespace mk
                 bsl::touch();
             }
 
+            m_used.clear_all();
+            m_vpss_per_vp.clear_all();
+
             return bsl::errc_success;
         }
 
@@ -160,22 +171,28 @@ namespace mk
         {
             lock_guard lock{tls, m_lock};
 
-            VPS_CONCEPT *vps{};
-            for (auto const elem : m_pool) {
-                if (elem.data->is_deallocated()) {
-                    vps = elem.data;
-                    break;
-                }
+            auto const i{m_used.find_first_clear()};
+            if (bsl::unlikely(!i)) {
+                bsl::error() << "vps pool out of vpss\n" << bsl::here();
+                return bsl::safe_uint16::zero(true);
+            }
 
-                bsl::touch();
+            auto *const vps{m_pool.at_if(i)};
+            if (bsl::unlikely_assert(nullptr == vps)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::safe_uint16::zero(true);
             }
 
-            if (bsl::unlikely(nullptr == vps)) {
-                bsl::error() << "vps pool out of vpss\n" << bsl::here();
+            auto const vpsid{vps->allocate(tls, intrinsic, page_pool, vp_pool, vpid, ppid)};
+            if (bsl::unlikely(!vpsid)) {
+                bsl::print<bsl::V>() << bsl::here();
                 return bsl::safe_uint16::zero(true);
             }
 
-            return vps->allocate(tls, intrinsic, page_pool, vp_pool, vpid, ppid);
+            m_used.set(i);
+            m_vpss_per_vp.inc(vpid);
+
+            return vpsid;
         }
 
         /// <!-- description -->
@@ -209,7 +226,34 @@ namespace mk
                 return bsl::errc_index_out_of_bounds;
             }
 
-            return vps->deallocate(tls, page_pool);
+            auto const vpid{vps->assigned_vp()};
+            auto const ret{vps->deallocate(tls, page_pool)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            m_used.clear(bsl::to_umax(vpsid));
+            m_vpss_per_vp.dec(vpid);
+
+            return ret;
+        }
+
+        /// <!-- description -->
+        ///   @brief Tells every VPS that the provided page was freed by the
+        ///     extension, so that none of them keep a pointer to it. This
+        ///     must be called after the page is unmapped from the extension
+        ///     and before it can be given back to the page pool.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param page the microkernel's virtual address of the page
+        ///
+        constexpr void
+        page_freed(void const *const page) &noexcept
+        {
+            for (auto const vps : m_pool) {
+                vps.data->page_freed(page);
+            }
         }
 
         /// <!-- description -->
@@ -236,7 +280,15 @@ namespace mk
                 return bsl::errc_index_out_of_bounds;
             }
 
+            /// NOTE:
+            /// - A zombie is never deallocated, so it must stay marked as
+            ///   in use, even if it was deallocated when it was zombified.
+            ///   It also stays assigned to its VP, so the count is left as is.
+            ///
+
             vps->zombify();
+            m_used.set(bsl::to_umax(vpsid));
+
             return bsl::errc_success;
         }
 
@@ -351,6 +403,16 @@ namespace mk
                 return bsl::safe_uint16::zero(true);
             }
 
+            /// NOTE:
+            /// - The common case is that nothing is assigned to the VP, which
+            ///   the count answers without looking at the pool. The pool is
+            ///   only walked to report which VPS is still assigned.
+            ///
+
+            if (m_vpss_per_vp.is_zero(vpid)) {
+                return bsl::safe_uint16::zero(true);
+            }
+
             for (auto const elem : m_pool) {
                 if (elem.data->assigned_vp() == vpid) {
                     return elem.data->id();
@@ -692,19 +754,26 @@ namespace mk
         ///   @tparam FIELD_TYPE the type (i.e., size) of field to write
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @tparam EXT_CONCEPT defines the type of ext_t to use
         ///   @param tls the current TLS block
         ///   @param intrinsic the intrinsics to use
+        ///   @param ext the extension that made the syscall
         ///   @param vpsid the ID of the VPS to write to
         ///   @param index the index of the field to write to the VPS
         ///   @param value the value to write to the VPS
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
-        template<typename FIELD_TYPE, typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        template<
+            typename FIELD_TYPE,
+            typename TLS_CONCEPT,
+            typename INTRINSIC_CONCEPT,
+            typename EXT_CONCEPT>
         [[nodiscard]] constexpr auto
         write(
             TLS_CONCEPT &tls,
             INTRINSIC_CONCEPT &intrinsic,
+            EXT_CONCEPT &ext,
             bsl::safe_uint16 const &vpsid,
             bsl::safe_uintmax const &index,
             bsl::safe_integral<FIELD_TYPE> const &value) &noexcept -> bsl::errc_type
@@ -721,7 +790,7 @@ namespace mk
                 return bsl::errc_failure;
             }
 
-            return vps->template write<FIELD_TYPE>(tls, intrinsic, index, value);
+            return vps->template write<FIELD_TYPE>(tls, intrinsic, ext, index, value);
         }
 
         /// <!-- description -->
@@ -800,6 +869,197 @@ namespace mk
             return vps->write_reg(tls, intrinsic, reg, value);
         }
 
+        /// <!-- description -->
+        ///   @brief Reads each register or field described by the provided
+        ///     descriptors from the requested VPS, storing the results in
+        ///     each descriptor's value. The VPS is only looked up once.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param vpsid the ID of the VPS to read from
+        ///   @param descs the descriptors defining what to read
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        [[nodiscard]] constexpr auto
+        read_batch(
+            TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uint16 const &vpsid,
+            bsl::span<syscall::bf_vps_batch_t> const &descs) &noexcept -> bsl::errc_type
+        {
+            auto *const vps{m_pool.at_if(bsl::to_umax(vpsid))};
+            if (bsl::unlikely(nullptr == vps)) {
+                bsl::error() << "vpsid "                                                   // --
+                             << bsl::hex(vpsid)                                            // --
+                             << " is invalid or greater than or equal to the MAX_VPSS "    // --
+                             << bsl::hex(bsl::to_u16(MAX_VPSS))                            // --
+                             << bsl::endl                                                  // --
+                             << bsl::here();                                               // --
+
+                return bsl::errc_failure;
+            }
+
+            for (auto const elem : descs) {
+                auto *const desc{elem.data};
+                bsl::safe_uintmax val{};
+
+                switch (desc->type) {
+                    case syscall::bf_vps_batch_type_t::reg: {
+                        val = vps->read_reg(
+                            tls, intrinsic, static_cast<syscall::bf_reg_t>(desc->index));
+                        break;
+                    }
+
+                    case syscall::bf_vps_batch_type_t::field8: {
+                        val = bsl::to_umax(
+                            vps->template read<bsl::uint8>(tls, intrinsic, desc->index));
+                        break;
+                    }
+
+                    case syscall::bf_vps_batch_type_t::field16: {
+                        val = bsl::to_umax(
+                            vps->template read<bsl::uint16>(tls, intrinsic, desc->index));
+                        break;
+                    }
+
+                    case syscall::bf_vps_batch_type_t::field32: {
+                        val = bsl::to_umax(
+                            vps->template read<bsl::uint32>(tls, intrinsic, desc->index));
+                        break;
+                    }
+
+                    case syscall::bf_vps_batch_type_t::field64: {
+                        val = bsl::to_umax(
+                            vps->template read<bsl::uint64>(tls, intrinsic, desc->index));
+                        break;
+                    }
+
+                    default: {
+                        bsl::error() << "unknown batch type "                             // --
+                                     << bsl::hex(static_cast<bsl::uint64>(desc->type))    // --
+                                     << " for entry "                                     // --
+                                     << elem.index                                        // --
+                                     << bsl::endl                                         // --
+                                     << bsl::here();                                      // --
+
+                        return bsl::errc_failure;
+                    }
+                }
+
+                if (bsl::unlikely(!val)) {
+                    bsl::print<bsl::V>() << "entry " << elem.index << bsl::endl << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                desc->value = val.get();
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Writes the value of each of the provided descriptors to
+        ///     the register or field it describes in the requested VPS. The
+        ///     VPS is only looked up once.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param ext the extension that made the syscall
+        ///   @param vpsid the ID of the VPS to write to
+        ///   @param descs the descriptors defining what to write
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT, typename EXT_CONCEPT>
+        [[nodiscard]] constexpr auto
+        write_batch(
+            TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            EXT_CONCEPT &ext,
+            bsl::safe_uint16 const &vpsid,
+            bsl::span<syscall::bf_vps_batch_t const> const &descs) &noexcept -> bsl::errc_type
+        {
+            bsl::errc_type ret{};
+
+            auto *const vps{m_pool.at_if(bsl::to_umax(vpsid))};
+            if (bsl::unlikely(nullptr == vps)) {
+                bsl::error() << "vpsid "                                                   // --
+                             << bsl::hex(vpsid)                                            // --
+                             << " is invalid or greater than or equal to the MAX_VPSS "    // --
+                             << bsl::hex(bsl::to_u16(MAX_VPSS))                            // --
+                             << bsl::endl                                                  // --
+                             << bsl::here();                                               // --
+
+                return bsl::errc_failure;
+            }
+
+            for (auto const elem : descs) {
+                auto const *const desc{elem.data};
+
+                switch (desc->type) {
+                    case syscall::bf_vps_batch_type_t::reg: {
+                        ret = vps->write_reg(
+                            tls,
+                            intrinsic,
+                            static_cast<syscall::bf_reg_t>(desc->index),
+                            bsl::to_umax(desc->value));
+                        break;
+                    }
+
+                    case syscall::bf_vps_batch_type_t::field8: {
+                        ret = vps->template write<bsl::uint8>(
+                            tls, intrinsic, ext, desc->index, bsl::to_u8_unsafe(desc->value));
+                        break;
+                    }
+
+                    case syscall::bf_vps_batch_type_t::field16: {
+                        ret = vps->template write<bsl::uint16>(
+                            tls, intrinsic, ext, desc->index, bsl::to_u16_unsafe(desc->value));
+                        break;
+                    }
+
+                    case syscall::bf_vps_batch_type_t::field32: {
+                        ret = vps->template write<bsl::uint32>(
+                            tls, intrinsic, ext, desc->index, bsl::to_u32_unsafe(desc->value));
+                        break;
+                    }
+
+                    case syscall::bf_vps_batch_type_t::field64: {
+                        ret = vps->template write<bsl::uint64>(
+                            tls, intrinsic, ext, desc->index, bsl::to_u64(desc->value));
+                        break;
+                    }
+
+                    default: {
+                        bsl::error() << "unknown batch type "                             // --
+                                     << bsl::hex(static_cast<bsl::uint64>(desc->type))    // --
+                                     << " for entry "                                     // --
+                                     << elem.index                                        // --
+                                     << bsl::endl                                         // --
+                                     << bsl::here();                                      // --
+
+                        return bsl::errc_failure;
+                    }
+                }
+
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << "entry " << elem.index << bsl::endl << bsl::here();
+                    return ret;
+                }
+            }
+
+            return bsl::errc_success;
+        }
+
         /// <!-- description -->
         ///   @brief Runs the requested VPS. Note that this function does not
         ///     return until a VMExit occurs. Once complete, this function
@@ -871,6 +1131,78 @@ namespace mk
             return vps->advance_ip(tls, intrinsic);
         }
 
+        /// <!-- description -->
+        ///   @brief Replaces the exit policy of the requested VPS with the
+        ///     provided entries.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param vpsid the ID of the VPS to set the exit policy for
+        ///   @param entries the entries defining the new exit policy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        set_exit_policy(
+            TLS_CONCEPT &tls,
+            bsl::safe_uint16 const &vpsid,
+            bsl::span<syscall::bf_exit_policy_t const> const &entries) &noexcept -> bsl::errc_type
+        {
+            auto *const vps{m_pool.at_if(bsl::to_umax(vpsid))};
+            if (bsl::unlikely(nullptr == vps)) {
+                bsl::error() << "vpsid "                                                   // --
+                             << bsl::hex(vpsid)                                            // --
+                             << " is invalid or greater than or equal to the MAX_VPSS "    // --
+                             << bsl::hex(bsl::to_u16(MAX_VPSS))                            // --
+                             << bsl::endl                                                  // --
+                             << bsl::here();                                               // --
+
+                return bsl::errc_failure;
+            }
+
+            return vps->set_exit_policy(tls, entries);
+        }
+
+        /// <!-- description -->
+        ///   @brief Handles the VMExit that was just returned by run() using
+        ///     the exit policy of the requested VPS. Returns true if the
+        ///     VMExit was handled, in which case the extension does not need
+        ///     to be called.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param vpsid the ID of the VPS that generated the VMExit
+        ///   @param exit_reason the VMExit reason returned by run()
+        ///   @return Returns true if the VMExit was handled, false otherwise
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        [[nodiscard]] constexpr auto
+        exit_policy(
+            TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uint16 const &vpsid,
+            bsl::safe_uintmax const &exit_reason) &noexcept -> bool
+        {
+            auto *const vps{m_pool.at_if(bsl::to_umax(vpsid))};
+            if (bsl::unlikely(nullptr == vps)) {
+                bsl::error() << "vpsid "                                                   // --
+                             << bsl::hex(vpsid)                                            // --
+                             << " is invalid or greater than or equal to the MAX_VPSS "    // --
+                             << bsl::hex(bsl::to_u16(MAX_VPSS))                            // --
+                             << bsl::endl                                                  // --
+                             << bsl::here();                                               // --
+
+                return false;
+            }
+
+            return vps->run_exit_policy(tls, intrinsic, exit_reason);
+        }
+
         /// <!-- description -->
         ///   @brief Clears the requested VPS's internal cache. Note that this
         ///     is a hardware specific function and doesn't change the actual
@@ -25,6 +25,9 @@
 #ifndef INTRINSIC_HPP
 #define INTRINSIC_HPP
 
+#include <invpcid_descriptor_t.hpp>
+#include <pcid_flags.hpp>
+
 #include <bsl/cstdint.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/errc_type.hpp>
@@ -42,6 +45,15 @@ namespace mk
     ///
     extern "C" void intrinsic_invlpg(bsl::uint64 const val) noexcept;
 
+    /// <!-- description -->
+    ///   @brief Implements intrinsic_t::invpcid
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param desc n/a
+    ///   @param type n/a
+    ///
+    extern "C" void intrinsic_invpcid(void *const desc, bsl::uint64 const type) noexcept;
+
     /// <!-- description -->
     ///   @brief Implements intrinsic_t::cr3
     ///
@@ -58,6 +70,14 @@ namespace mk
     ///
     extern "C" void intrinsic_set_cr3(bsl::uint64 const val) noexcept;
 
+    /// <!-- description -->
+    ///   @brief Implements intrinsic_t::cr4
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto intrinsic_cr4() noexcept -> bsl::uint64;
+
     /// <!-- description -->
     ///   @brief Implements intrinsic_t::tp
     ///
@@ -97,6 +117,55 @@ namespace mk
     ///
     extern "C" void intrinsic_halt() noexcept;
 
+    /// <!-- description -->
+    ///   @brief Implements intrinsic_t::rdtsc
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto intrinsic_rdtsc() noexcept -> bsl::uint64;
+
+    /// <!-- description -->
+    ///   @brief Implements intrinsic_t::cpuid
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param rax n/a
+    ///   @param rbx n/a
+    ///   @param rcx n/a
+    ///   @param rdx n/a
+    ///
+    extern "C" void intrinsic_cpuid(
+        bsl::uint64 *const rax,
+        bsl::uint64 *const rbx,
+        bsl::uint64 *const rcx,
+        bsl::uint64 *const rdx) noexcept;
+
+    /// <!-- description -->
+    ///   @brief Implements intrinsic_t::xsave
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param area n/a
+    ///
+    extern "C" void intrinsic_xsave(void *const area) noexcept;
+
+    /// <!-- description -->
+    ///   @brief Implements intrinsic_t::xrstor
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param area n/a
+    ///
+    extern "C" void intrinsic_xrstor(void const *const area) noexcept;
+
+    /// <!-- description -->
+    ///   @brief Implements intrinsic_t::clts
+    ///
+    extern "C" void intrinsic_clts() noexcept;
+
+    /// <!-- description -->
+    ///   @brief Implements intrinsic_t::stts
+    ///
+    extern "C" void intrinsic_stts() noexcept;
+
     /// <!-- description -->
     ///   @brief Implements intrinsic_t::rdmsr
     ///
@@ -180,6 +249,87 @@ namespace mk
             intrinsic_invlpg(val.get());
         }
 
+        /// <!-- description -->
+        ///   @brief Invalidates mappings in the translation lookaside buffers
+        ///     (TLBs) and paging-structure caches that were derived from
+        ///     the provided process-context identifier (PCID).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param addr The address to invalidate
+        ///   @param pcid The PCID to invalidate
+        ///   @param type The INVPCID type (see the Intel SDM for details)
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] static constexpr auto
+        invpcid(
+            bsl::safe_uint64 const &addr,
+            bsl::safe_uint16 const &pcid,
+            bsl::safe_uint64 const &type) noexcept -> bsl::errc_type
+        {
+            if (bsl::is_constant_evaluated()) {
+                return bsl::errc_success;
+            }
+
+            if (bsl::unlikely(!addr)) {
+                bsl::error() << "invalid addr: "    // --
+                             << bsl::hex(addr)      // --
+                             << bsl::endl           // --
+                             << bsl::here();        // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!pcid)) {
+                bsl::error() << "invalid pcid: "    // --
+                             << bsl::hex(pcid)      // --
+                             << bsl::endl           // --
+                             << bsl::here();        // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!type)) {
+                bsl::error() << "invalid type: "    // --
+                             << bsl::hex(type)      // --
+                             << bsl::endl           // --
+                             << bsl::here();        // --
+
+                return bsl::errc_failure;
+            }
+
+            invpcid_descriptor_t desc{
+                pcid.get(),
+                bsl::ZERO_U16.get(),
+                bsl::ZERO_U16.get(),
+                bsl::ZERO_U16.get(),
+                addr.get()};
+
+            intrinsic_invpcid(&desc, type.get());
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Flushes all of the non-global TLB entries on the PP
+        ///     this is called from. If PCIDs are enabled, the entries of
+        ///     every PCID are flushed (and not just the current one).
+        ///
+        static constexpr void
+        flush_tlb() noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            if ((intrinsic_cr4() & CR4_PCIDE.get()) == bsl::ZERO_U64.get()) {
+                intrinsic_set_cr3(intrinsic_cr3());
+                return;
+            }
+
+            invpcid_descriptor_t desc{};
+            intrinsic_invpcid(&desc, INVPCID_TYPE_ALL_CONTEXTS.get());
+        }
+
         /// <!-- description -->
         ///   @brief Returns the value of CR3
         ///
@@ -221,6 +371,22 @@ namespace mk
             intrinsic_set_cr3(val.get());
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the value of CR4
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the value of CR4
+        ///
+        [[nodiscard]] static constexpr auto
+        cr4() noexcept -> bsl::safe_uint64
+        {
+            if (bsl::is_constant_evaluated()) {
+                return {};
+            }
+
+            return intrinsic_cr4();
+        }
+
         /// <!-- description -->
         ///   @brief Returns the value of tp (TLS pointer)
         ///
@@ -336,6 +502,108 @@ namespace mk
             intrinsic_halt();
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the value of the TSC
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the value of the TSC
+        ///
+        [[nodiscard]] static constexpr auto
+        rdtsc() noexcept -> bsl::safe_uint64
+        {
+            if (bsl::is_constant_evaluated()) {
+                return {};
+            }
+
+            return intrinsic_rdtsc();
+        }
+
+        /// <!-- description -->
+        ///   @brief Executes the CPUID instruction given the provided EAX
+        ///     and ECX and returns the results
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param rax the leaf used by CPUID, returns the resulting rax
+        ///   @param rbx returns the resulting rbx
+        ///   @param rcx the subleaf used by CPUID, returns the resulting rcx
+        ///   @param rdx returns the resulting rdx
+        ///
+        static constexpr void
+        cpuid(
+            bsl::safe_uint64 &rax,
+            bsl::safe_uint64 &rbx,
+            bsl::safe_uint64 &rcx,
+            bsl::safe_uint64 &rdx) noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            intrinsic_cpuid(rax.data(), rbx.data(), rcx.data(), rdx.data());
+        }
+
+        /// <!-- description -->
+        ///   @brief Saves the current FPU/SSE/AVX state to the provided
+        ///     XSAVE area. CR0.TS must be clear.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param area the XSAVE area to save the FPU state to
+        ///
+        static constexpr void
+        xsave(void *const area) noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            intrinsic_xsave(area);
+        }
+
+        /// <!-- description -->
+        ///   @brief Loads the FPU/SSE/AVX state from the provided XSAVE
+        ///     area. CR0.TS must be clear.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param area the XSAVE area to load the FPU state from
+        ///
+        static constexpr void
+        xrstor(void const *const area) noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            intrinsic_xrstor(area);
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears CR0.TS, allowing the FPU to be used without
+        ///     generating a #NM.
+        ///
+        static constexpr void
+        clts() noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            intrinsic_clts();
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets CR0.TS, causing the next use of the FPU to
+        ///     generate a #NM.
+        ///
+        static constexpr void
+        stts() noexcept
+        {
+            if (bsl::is_constant_evaluated()) {
+                return;
+            }
+
+            intrinsic_stts();
+        }
+
         /// <!-- description -->
         ///   @brief Returns the value of requested MSR
         ///
@@ -27,17 +27,25 @@
 
 #include <allocate_tags.hpp>
 #include <allocated_status_t.hpp>
+#include <exit_policy_t.hpp>
 #include <general_purpose_regs_t.hpp>
 #include <mk_interface.hpp>
 #include <vmcb_t.hpp>
+#include <xsave_area_t.hpp>
 
+#include <bsl/array.hpp>
 #include <bsl/cstr_type.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstring.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
 #include <bsl/finally.hpp>
+#include <bsl/likely.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
 #include <bsl/string_view.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 #include <bsl/unlikely_assert.hpp>
 
@@ -79,6 +87,89 @@ namespace mk
         return (attrib & mask1) | ((attrib & mask2) << shift);
     }
 
+    /// <!-- description -->
+    ///   @brief Returns true if the VMCB bytes [offset, offset + size)
+    ///     overlap the VMCB bytes [begin, end).
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param offset the offset of the bytes being written
+    ///   @param size the number of bytes being written
+    ///   @param begin the first offset of the VMCB range to check
+    ///   @param end one past the last offset of the VMCB range to check
+    ///   @return Returns true if the two ranges overlap
+    ///
+    [[nodiscard]] constexpr auto
+    vmcb_range_overlaps(
+        bsl::safe_uintmax const &offset,
+        bsl::safe_uintmax const &size,
+        bsl::safe_uintmax const &begin,
+        bsl::safe_uintmax const &end) noexcept -> bool
+    {
+        return (offset < end) && (begin < (offset + size));
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the VMCB clean bits that must be cleared when the
+    ///     VMCB bytes [offset, offset + size) are written. Fields that are
+    ///     not cached by hardware do not belong to any clean bit, in which
+    ///     case 0 is returned.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param offset the offset of the bytes being written
+    ///   @param size the number of bytes being written
+    ///   @return Returns the VMCB clean bits that must be cleared
+    ///
+    [[nodiscard]] constexpr auto
+    vmcb_clean_bits_for(bsl::safe_uintmax const &offset, bsl::safe_uintmax const &size) noexcept
+        -> bsl::safe_uint32
+    {
+        // clang-format off
+
+        struct range_t final
+        {
+            bsl::uintmax begin;
+            bsl::uintmax end;
+            bsl::uint32 bits;
+        };
+
+        constexpr bsl::array<range_t, 21> ranges{{
+            {0x0000U, 0x0018U, VMCB_CLEAN_BITS_I.get()},       // intercepts
+            {0x003CU, 0x0040U, VMCB_CLEAN_BITS_I.get()},       // pause filter
+            {0x0040U, 0x0050U, VMCB_CLEAN_BITS_IOPM.get()},    // iopm/msrpm
+            {0x0050U, 0x0058U, VMCB_CLEAN_BITS_I.get()},       // tsc_offset
+            {0x0058U, 0x005CU, VMCB_CLEAN_BITS_ASID.get()},    // guest_asid
+            {0x0060U, 0x0068U, VMCB_CLEAN_BITS_TPR.get()},     // virtual_interrupt_a
+            {0x0090U, 0x0098U, VMCB_CLEAN_BITS_NP.get()},      // ctls1
+            {0x0098U, 0x00A0U, VMCB_CLEAN_BITS_AVIC.get()},    // avic_apic_bar
+            {0x00B0U, 0x00B8U, VMCB_CLEAN_BITS_NP.get()},      // n_cr3
+            {0x00E0U, 0x00E8U, VMCB_CLEAN_BITS_AVIC.get()},    // avic_apic_backing_page_ptr
+            {0x00F0U, 0x0100U, VMCB_CLEAN_BITS_AVIC.get()},    // avic_logical/physical_table_ptr
+            {0x0400U, 0x0440U, VMCB_CLEAN_BITS_SEG.get()},     // es, cs, ss, ds
+            {0x0460U, 0x0470U, VMCB_CLEAN_BITS_DT.get()},      // gdtr
+            {0x0480U, 0x0490U, VMCB_CLEAN_BITS_DT.get()},      // idtr
+            {0x04CBU, 0x04CCU, VMCB_CLEAN_BITS_SEG.get()},     // cpl
+            {0x04D0U, 0x04D8U, VMCB_CLEAN_BITS_CRX.get()},     // efer
+            {0x0548U, 0x0560U, VMCB_CLEAN_BITS_CRX.get()},     // cr4, cr3, cr0
+            {0x0560U, 0x0570U, VMCB_CLEAN_BITS_DRX.get()},     // dr7, dr6
+            {0x0640U, 0x0648U, VMCB_CLEAN_BITS_CR2.get()},     // cr2
+            {0x0668U, 0x0670U, VMCB_CLEAN_BITS_NP.get()},      // g_pat
+            {0x0670U, 0x0698U, VMCB_CLEAN_BITS_LBR.get()}}};   // dbgctl, br_*, lastexcp*
+
+        // clang-format on
+
+        bsl::safe_uint32 bits{};
+        for (auto const range : ranges) {
+            if (vmcb_range_overlaps(offset, size, range.data->begin, range.data->end)) {
+                bits |= range.data->bits;
+            }
+            else {
+                bsl::touch();
+            }
+        }
+
+        return bits;
+    }
+
     /// @class mk::vps_t
     ///
     /// <!-- description -->
@@ -107,6 +198,111 @@ namespace mk
         bsl::safe_uintmax m_host_vmcb_phys{bsl::safe_uintmax::zero(true)};
         /// @brief stores the general purpose registers
         general_purpose_regs_t m_gprs{};
+        /// @brief stores the FPU state of this VPS while it is not loaded
+        xsave_area_t *m_xsave{};
+        /// @brief stores the exit policy of this VPS
+        exit_policy_t m_exit_policy{};
+
+        /// <!-- description -->
+        ///   @brief Ensures that the FPU holds this VPS's state. The state
+        ///     that is currently loaded (if any) is saved to the XSAVE area
+        ///     of its owner first. CR0.TS is set again before returning so
+        ///     that the extension gets a #NM if it uses the FPU before the
+        ///     state is switched back.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        constexpr void
+        ensure_this_xsave_is_loaded(TLS_CONCEPT &tls, INTRINSIC_CONCEPT &intrinsic) &noexcept
+        {
+            if (bsl::ZERO_UMAX == tls.xsave_enabled) {
+                return;
+            }
+
+            if (bsl::likely(m_xsave == tls.active_xsave)) {
+                return;
+            }
+
+            /// NOTE:
+            /// - A nullptr means the FPU still holds the root OS's state
+            ///   from when the microkernel was started, which has already
+            ///   been given to a VPS by state_save_to_vps(), or was never
+            ///   given to one, in which case it must not leak into this VPS.
+            ///   Either way it is overwritten and not saved.
+            ///
+
+            intrinsic.clts();
+            if (nullptr != tls.active_xsave) {
+                intrinsic.xsave(tls.active_xsave);
+            }
+            else {
+                bsl::touch();
+            }
+
+            intrinsic.xrstor(m_xsave);
+            intrinsic.stts();
+
+            tls.active_xsave = m_xsave;
+        }
+
+        /// <!-- description -->
+        ///   @brief Gives this VPS the root OS's FPU state. If an extension
+        ///     has used the FPU already, the root OS's state was set aside
+        ///     by the #NM handler, otherwise the FPU still holds it.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        constexpr void
+        claim_root_xsave(TLS_CONCEPT &tls, INTRINSIC_CONCEPT &intrinsic) &noexcept
+        {
+            if (bsl::ZERO_UMAX == tls.xsave_enabled) {
+                return;
+            }
+
+            if (nullptr != tls.root_xsave) {
+                bsl::builtin_memcpy(m_xsave, tls.root_xsave, sizeof(xsave_area_t));
+                tls.root_xsave = {};
+                return;
+            }
+
+            if (nullptr == tls.active_xsave) {
+                intrinsic.clts();
+                intrinsic.xsave(m_xsave);
+                intrinsic.stts();
+                return;
+            }
+
+            bsl::touch();
+        }
+
+        /// @brief stores the total number of clean bit groups reloaded by VMRUN
+        bsl::safe_uintmax m_dirtied_groups{};
+        /// @brief stores the total number of times VMRUN was executed
+        bsl::safe_uintmax m_vmruns{};
+
+        /// <!-- description -->
+        ///   @brief Clears the provided VMCB clean bits, telling the CPU
+        ///     that the fields that belong to these groups were modified
+        ///     and must be reloaded on the next VMRUN.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param bits the VMCB clean bits to clear
+        ///
+        constexpr void
+        dirty(bsl::safe_uint32 const &bits) &noexcept
+        {
+            m_guest_vmcb->vmcb_clean_bits &= ~bits.get();
+        }
 
         /// <!-- description -->
         ///   @brief Dumps the contents of a field
@@ -233,7 +429,28 @@ namespace mk
                 return bsl::errc_failure;
             }
 
+            /// NOTE:
+            /// - Only the assigned PP can have this VPS's FPU state loaded, so
+            ///   any other PP leaks the XSAVE area by turning this VPS into a
+            ///   zombie instead of freeing memory that might still be in use.
+            ///
+
+            if (bsl::unlikely((nullptr != m_xsave) && (tls.ppid != m_assigned_ppid))) {
+                bsl::error() << "vps "                               // --
+                             << bsl::hex(m_id)                       // --
+                             << " is assigned to pp "                // --
+                             << bsl::hex(m_assigned_ppid)            // --
+                             << " and cannot be destroyed by pp "    // --
+                             << bsl::hex(tls.ppid)                   // --
+                             << bsl::endl                            // --
+                             << bsl::here();                         // --
+
+                return bsl::errc_failure;
+            }
+
             m_gprs = {};
+            m_dirtied_groups = {};
+            m_vmruns = {};
 
             m_host_vmcb_phys = bsl::safe_uintmax::zero(true);
             page_pool.deallocate(tls, m_host_vmcb, ALLOCATE_TAG_HOST_VMCB);
@@ -243,6 +460,24 @@ namespace mk
             page_pool.deallocate(tls, m_guest_vmcb, ALLOCATE_TAG_GUEST_VMCB);
             m_guest_vmcb = {};
 
+            /// NOTE:
+            /// - An inactive VPS's FPU state can only still be loaded on the
+            ///   PP it was assigned to (i.e., this PP) if no other VPS has run
+            ///   there since, in which case the FPU is simply treated as
+            ///   unowned.
+            ///
+
+            if (m_xsave == tls.active_xsave) {
+                tls.active_xsave = {};
+            }
+            else {
+                bsl::touch();
+            }
+
+            page_pool.deallocate(tls, m_xsave, ALLOCATE_TAG_XSAVE_AREA);
+            m_xsave = {};
+
+            m_exit_policy.clear();
             m_assigned_ppid = syscall::BF_INVALID_ID;
             m_assigned_vpid = syscall::BF_INVALID_ID;
             m_allocated = allocated_status_t::deallocated;
@@ -387,6 +622,9 @@ namespace mk
             tls.log_vpsid = m_id.get();
 
             bsl::finally cleanup_on_error{[this, &tls, &page_pool]() noexcept -> void {
+                page_pool.deallocate(tls, m_xsave, ALLOCATE_TAG_XSAVE_AREA);
+                m_xsave = {};
+
                 m_host_vmcb_phys = bsl::safe_uintmax::zero(true);
                 page_pool.deallocate(tls, m_host_vmcb, ALLOCATE_TAG_HOST_VMCB);
                 m_host_vmcb = {};
@@ -420,6 +658,18 @@ namespace mk
                 return bsl::safe_uint16::zero(true);
             }
 
+            if (bsl::ZERO_UMAX != tls.xsave_enabled) {
+                m_xsave =
+                    page_pool.template allocate<xsave_area_t>(tls, ALLOCATE_TAG_XSAVE_AREA);
+                if (bsl::unlikely(nullptr == m_xsave)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::safe_uint16::zero(true);
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
             m_assigned_vpid = vpid;
             m_assigned_ppid = ppid;
             m_allocated = allocated_status_t::allocated;
@@ -468,6 +718,26 @@ namespace mk
                 return bsl::errc_precondition;
             }
 
+            /// NOTE:
+            /// - This VPS's FPU state can only be loaded on the PP that it
+            ///   is assigned to, and only that PP's TLS block points to it,
+            ///   so any other PP would free the XSAVE area while it might
+            ///   still be in use.
+            ///
+
+            if (bsl::unlikely(tls.ppid != m_assigned_ppid)) {
+                bsl::error() << "vps "                               // --
+                             << bsl::hex(m_id)                       // --
+                             << " is assigned to pp "                // --
+                             << bsl::hex(m_assigned_ppid)            // --
+                             << " and cannot be destroyed by pp "    // --
+                             << bsl::hex(tls.ppid)                   // --
+                             << bsl::endl                            // --
+                             << bsl::here();                         // --
+
+                return bsl::errc_precondition;
+            }
+
             tls.state_reversal_required = true;
             bsl::finally zombify_on_error{[this]() noexcept -> void {
                 this->zombify();
@@ -488,6 +758,8 @@ namespace mk
             }
 
             m_gprs = {};
+            m_dirtied_groups = {};
+            m_vmruns = {};
 
             m_host_vmcb_phys = bsl::safe_uintmax::zero(true);
             page_pool.deallocate(tls, m_host_vmcb, ALLOCATE_TAG_HOST_VMCB);
@@ -497,6 +769,24 @@ namespace mk
             page_pool.deallocate(tls, m_guest_vmcb, ALLOCATE_TAG_GUEST_VMCB);
             m_guest_vmcb = {};
 
+            /// NOTE:
+            /// - An inactive VPS's FPU state can only still be loaded on the
+            ///   PP it was assigned to (i.e., this PP) if no other VPS has run
+            ///   there since, in which case the FPU is simply treated as
+            ///   unowned.
+            ///
+
+            if (m_xsave == tls.active_xsave) {
+                tls.active_xsave = {};
+            }
+            else {
+                bsl::touch();
+            }
+
+            page_pool.deallocate(tls, m_xsave, ALLOCATE_TAG_XSAVE_AREA);
+            m_xsave = {};
+
+            m_exit_policy.clear();
             m_assigned_ppid = syscall::BF_INVALID_ID;
             m_assigned_vpid = syscall::BF_INVALID_ID;
             m_allocated = allocated_status_t::deallocated;
@@ -1078,6 +1368,13 @@ namespace mk
             m_guest_vmcb->g_pat = state.ia32_pat;
             m_guest_vmcb->dbgctl = state.ia32_debugctl;
 
+            this->dirty(
+                VMCB_CLEAN_BITS_NP | VMCB_CLEAN_BITS_CRX | VMCB_CLEAN_BITS_DRX |
+                VMCB_CLEAN_BITS_DT | VMCB_CLEAN_BITS_SEG | VMCB_CLEAN_BITS_CR2 |
+                VMCB_CLEAN_BITS_LBR);
+
+            this->claim_root_xsave(tls, intrinsic);
+
             return bsl::errc_success;
         }
 
@@ -1233,6 +1530,15 @@ namespace mk
             state.ia32_pat = m_guest_vmcb->g_pat;
             state.ia32_debugctl = m_guest_vmcb->dbgctl;
 
+            /// NOTE:
+            /// - The root OS continues with whatever the FPU holds once it is
+            ///   promoted, so this VPS's state has to be loaded, and it
+            ///   replaces any state set aside from when we were started.
+            ///
+
+            this->ensure_this_xsave_is_loaded(tls, intrinsic);
+            tls.root_xsave = {};
+
             return bsl::errc_success;
         }
 
@@ -1311,22 +1617,30 @@ namespace mk
         ///   @tparam FIELD_TYPE the type (i.e., size) of field to write
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @tparam EXT_CONCEPT defines the type of ext_t to use
         ///   @param tls the current TLS block
         ///   @param intrinsic the intrinsics to use
+        ///   @param ext the extension that made the syscall
         ///   @param index the index of the field to write to the VPS
         ///   @param val the value to write to the VPS
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
-        template<typename FIELD_TYPE, typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        template<
+            typename FIELD_TYPE,
+            typename TLS_CONCEPT,
+            typename INTRINSIC_CONCEPT,
+            typename EXT_CONCEPT>
         [[nodiscard]] constexpr auto
         write(
             TLS_CONCEPT &tls,
             INTRINSIC_CONCEPT &intrinsic,
+            EXT_CONCEPT &ext,
             bsl::safe_uintmax const &index,
             bsl::safe_integral<FIELD_TYPE> const &val) &noexcept -> bsl::errc_type
         {
             bsl::discard(intrinsic);
+            bsl::discard(ext);
 
             if (bsl::unlikely_assert(!m_id)) {
                 bsl::error() << "vps_t not initialized\n" << bsl::here();
@@ -1376,9 +1690,29 @@ namespace mk
             }
 
             *ptr = val.get();
+            this->dirty(vmcb_clean_bits_for(view_index * sizeof(FIELD_TYPE), sizeof(FIELD_TYPE)));
+
             return bsl::errc_success;
         }
 
+        /// <!-- description -->
+        ///   @brief Tells this VPS that the extension freed the provided
+        ///     page.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param page the microkernel's virtual address of the page
+        ///
+        constexpr void
+        page_freed(void const *const page) &noexcept
+        {
+            /// NOTE:
+            /// - The VPS never reads memory that belongs to the extension,
+            ///   so there is nothing to drop.
+            ///
+
+            bsl::discard(page);
+        }
+
         /// <!-- description -->
         ///   @brief Reads a field from the VPS given a bf_reg_t
         ///     defining the field to read.
@@ -2011,101 +2345,121 @@ namespace mk
 
                 case syscall::bf_reg_t::bf_reg_t_gdtr_base_addr: {
                     m_guest_vmcb->gdtr_base = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_DT);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_gdtr_limit: {
                     m_guest_vmcb->gdtr_limit = bsl::to_u32(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_DT);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_idtr_base_addr: {
                     m_guest_vmcb->idtr_base = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_DT);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_idtr_limit: {
                     m_guest_vmcb->idtr_limit = bsl::to_u32(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_DT);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_es: {
                     m_guest_vmcb->es_selector = bsl::to_u16(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_es_base_addr: {
                     m_guest_vmcb->es_base = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_es_limit: {
                     m_guest_vmcb->es_limit = bsl::to_u32(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_es_attributes: {
                     m_guest_vmcb->es_attrib = bsl::to_u16(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_cs: {
                     m_guest_vmcb->cs_selector = bsl::to_u16(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_cs_base_addr: {
                     m_guest_vmcb->cs_base = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_cs_limit: {
                     m_guest_vmcb->cs_limit = bsl::to_u32(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_cs_attributes: {
                     m_guest_vmcb->cs_attrib = bsl::to_u16(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ss: {
                     m_guest_vmcb->ss_selector = bsl::to_u16(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ss_base_addr: {
                     m_guest_vmcb->ss_base = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ss_limit: {
                     m_guest_vmcb->ss_limit = bsl::to_u32(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ss_attributes: {
                     m_guest_vmcb->ss_attrib = bsl::to_u16(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ds: {
                     m_guest_vmcb->ds_selector = bsl::to_u16(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ds_base_addr: {
                     m_guest_vmcb->ds_base = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ds_limit: {
                     m_guest_vmcb->ds_limit = bsl::to_u32(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ds_attributes: {
                     m_guest_vmcb->ds_attrib = bsl::to_u16(val).get();
+                    this->dirty(VMCB_CLEAN_BITS_SEG);
                     return bsl::errc_success;
                 }
 
@@ -2191,36 +2545,43 @@ namespace mk
 
                 case syscall::bf_reg_t::bf_reg_t_cr0: {
                     m_guest_vmcb->cr0 = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_CRX);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_cr2: {
                     m_guest_vmcb->cr2 = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_CR2);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_cr3: {
                     m_guest_vmcb->cr3 = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_CRX);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_cr4: {
                     m_guest_vmcb->cr4 = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_CRX);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_dr6: {
                     m_guest_vmcb->dr6 = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_DRX);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_dr7: {
                     m_guest_vmcb->dr7 = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_DRX);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ia32_efer: {
                     m_guest_vmcb->efer = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_CRX);
                     return bsl::errc_success;
                 }
 
@@ -2276,11 +2637,13 @@ namespace mk
 
                 case syscall::bf_reg_t::bf_reg_t_ia32_pat: {
                     m_guest_vmcb->g_pat = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_NP);
                     return bsl::errc_success;
                 }
 
                 case syscall::bf_reg_t::bf_reg_t_ia32_debugctl: {
                     m_guest_vmcb->dbgctl = val.get();
+                    this->dirty(VMCB_CLEAN_BITS_LBR);
                     return bsl::errc_success;
                 }
 
@@ -2341,9 +2704,61 @@ namespace mk
                 return bsl::safe_uintmax::zero(true);
             }
 
+            constexpr auto vmexit_invalid{bsl::to_umax(0xFFFFFFFFFFFFFFFFU)};
+
+            /// NOTE:
+            /// - VMRUN saves the current CR0 as the host's CR0, so CR0.TS
+            ///   has to be set at this point for the extension to get a #NM
+            ///   after the VMExit, which ensure_this_xsave_is_loaded() does.
+            ///
+
+            this->ensure_this_xsave_is_loaded(tls, intrinsic);
+
+            if constexpr (!(BSL_DEBUG_LEVEL < bsl::V)) {
+                auto const dirty{~m_guest_vmcb->vmcb_clean_bits & VMCB_CLEAN_BITS_ALL.get()};
+                m_dirtied_groups += bsl::to_umax(__builtin_popcount(dirty));
+                ++m_vmruns;
+            }
+
             bsl::safe_uintmax const exit_reason{intrinsic_vmrun(
                 m_guest_vmcb, m_guest_vmcb_phys.get(), m_host_vmcb, m_host_vmcb_phys.get())};
 
+            /// NOTE:
+            /// - Once VMRUN succeeds, the CPU has cached everything that
+            ///   the clean bits cover, so all of them can be set until
+            ///   the next write to one of these fields clears them.
+            ///
+
+            if (bsl::likely(vmexit_invalid != exit_reason)) {
+                m_guest_vmcb->vmcb_clean_bits = VMCB_CLEAN_BITS_ALL.get();
+            }
+            else {
+                bsl::touch();
+            }
+
+            /// NOTE:
+            /// - Most VMExit handlers need at least one of the following
+            ///   fields. They are placed in the extension's TLS block so
+            ///   that the extension can read them without a syscall.
+            /// - The instruction length is only known when the CPU saved
+            ///   the next RIP (i.e., NRIP save), otherwise it is 0.
+            ///
+
+            bsl::safe_uintmax const rip{m_guest_vmcb->rip};
+            bsl::safe_uintmax const nrip{m_guest_vmcb->nrip};
+
+            intrinsic.set_tls_reg(syscall::TLS_OFFSET_EXIT_RIP, rip);
+            if (bsl::likely(nrip > rip)) {
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_EXIT_INSTRUCTION_LENGTH, nrip - rip);
+            }
+            else {
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_EXIT_INSTRUCTION_LENGTH, bsl::ZERO_UMAX);
+            }
+
+            intrinsic.set_tls_reg(syscall::TLS_OFFSET_EXIT_INFO1, m_guest_vmcb->exitinfo1);
+            intrinsic.set_tls_reg(syscall::TLS_OFFSET_EXIT_INFO2, m_guest_vmcb->exitinfo2);
+            intrinsic.set_tls_reg(syscall::TLS_OFFSET_EXIT_INT_INFO, m_guest_vmcb->exitininfo);
+
             if constexpr (!(BSL_DEBUG_LEVEL < bsl::VV)) {
                 log.add(
                     tls.ppid,
@@ -2430,6 +2845,156 @@ namespace mk
             return bsl::errc_success;
         }
 
+        /// <!-- description -->
+        ///   @brief Replaces the exit policy of this VPS with the provided
+        ///     entries. See exit_policy_t for more information.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param entries the entries defining the new exit policy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        set_exit_policy(
+            TLS_CONCEPT &tls, bsl::span<syscall::bf_exit_policy_t const> const &entries) &noexcept
+            -> bsl::errc_type
+        {
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "vps_t not initialized\n" << bsl::here();
+                return bsl::errc_precondition;
+            }
+
+            if (bsl::unlikely(m_allocated != allocated_status_t::allocated)) {
+                bsl::error() << "vps "                                             // --
+                             << bsl::hex(m_id)                                     // --
+                             << "'s status is not allocated and cannot be used"    // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::errc_precondition;
+            }
+
+            if (bsl::unlikely(tls.ppid != m_assigned_ppid)) {
+                bsl::error() << "vp "                                  // --
+                             << bsl::hex(m_id)                         // --
+                             << " is assigned to pp "                  // --
+                             << bsl::hex(m_assigned_ppid)              // --
+                             << " and cannot be operated on by pp "    // --
+                             << bsl::hex(tls.ppid)                     // --
+                             << bsl::endl                              // --
+                             << bsl::here();                           // --
+
+                return bsl::errc_precondition;
+            }
+
+            return m_exit_policy.set(entries);
+        }
+
+        /// <!-- description -->
+        ///   @brief Handles the VMExit that was just returned by run() using
+        ///     the exit policy of this VPS, if the exit policy has an entry
+        ///     for it. If the VMExit is handled, the guest's registers are
+        ///     updated, the IP is advanced and true is returned, in which
+        ///     case the VPS can be run again without calling the extension.
+        ///     Otherwise, false is returned and nothing is changed.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param exit_reason the VMExit reason returned by run()
+        ///   @return Returns true if the VMExit was handled, false otherwise
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        [[nodiscard]] constexpr auto
+        run_exit_policy(
+            TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uintmax const &exit_reason) &noexcept -> bool
+        {
+            constexpr auto exit_reason_cpuid{bsl::to_umax(0x72U)};
+            constexpr auto exit_reason_msr{bsl::to_umax(0x7CU)};
+            constexpr auto mask32{bsl::to_umax(0xFFFFFFFFU)};
+            constexpr auto shift32{bsl::to_umax(32)};
+
+            if (m_exit_policy.empty()) {
+                return false;
+            }
+
+            bsl::safe_uintmax idx{};
+            syscall::bf_exit_policy_t const *entry{};
+
+            if (exit_reason == exit_reason_cpuid) {
+                auto const leaf{intrinsic.tls_reg(syscall::TLS_OFFSET_RAX) & mask32};
+                entry = m_exit_policy.match(syscall::bf_exit_policy_type_t::cpuid, leaf, idx);
+            }
+            else if ((exit_reason == exit_reason_msr) && (m_guest_vmcb->exitinfo1 == 0U)) {
+                auto const msr{intrinsic.tls_reg(syscall::TLS_OFFSET_RCX) & mask32};
+                entry = m_exit_policy.match(syscall::bf_exit_policy_type_t::rdmsr, msr, idx);
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (nullptr == entry) {
+                entry = m_exit_policy.match(
+                    syscall::bf_exit_policy_type_t::advance_ip, exit_reason, idx);
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (nullptr == entry) {
+                return false;
+            }
+
+            if (syscall::bf_exit_policy_type_t::cpuid == entry->type) {
+                bsl::safe_uint64 rax{intrinsic.tls_reg(syscall::TLS_OFFSET_RAX) & mask32};
+                bsl::safe_uint64 rbx{};
+                bsl::safe_uint64 rcx{intrinsic.tls_reg(syscall::TLS_OFFSET_RCX) & mask32};
+                bsl::safe_uint64 rdx{};
+
+                intrinsic.cpuid(rax, rbx, rcx, rdx);
+
+                rax = (rax & bsl::to_u64(~entry->eax_clear)) | bsl::to_u64(entry->eax_set);
+                rbx = (rbx & bsl::to_u64(~entry->ebx_clear)) | bsl::to_u64(entry->ebx_set);
+                rcx = (rcx & bsl::to_u64(~entry->ecx_clear)) | bsl::to_u64(entry->ecx_set);
+                rdx = (rdx & bsl::to_u64(~entry->edx_clear)) | bsl::to_u64(entry->edx_set);
+
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RAX, rax & mask32);
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RBX, rbx & mask32);
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RCX, rcx & mask32);
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RDX, rdx & mask32);
+            }
+            else if (syscall::bf_exit_policy_type_t::rdmsr == entry->type) {
+                auto const msr{intrinsic.tls_reg(syscall::TLS_OFFSET_RCX) & mask32};
+                auto const val{intrinsic.rdmsr(bsl::to_u32_unsafe(msr))};
+                if (bsl::unlikely(!val)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return false;
+                }
+
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RAX, val & mask32);
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RDX, val >> shift32);
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto const ret{this->advance_ip(tls, intrinsic)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return false;
+            }
+
+            m_exit_policy.hit(idx);
+            return true;
+        }
+
         /// <!-- description -->
         ///   @brief Clears the VPS's internal cache. Note that this is a
         ///     hardware specific function and doesn't change the actual
@@ -2765,12 +3330,23 @@ namespace mk
             this->dump_field("lastexcpfrom ", bsl::make_safe(m_guest_vmcb->lastexcpfrom));
             this->dump_field("lastexcpto ", bsl::make_safe(m_guest_vmcb->lastexcpto));
 
+            /// Clean Bits
+            ///
+
+            bsl::print() << bsl::ylw << "+----------------------------------------------------+";
+            bsl::print() << bsl::rst << bsl::endl;
+
+            this->dump_field("vmruns ", m_vmruns);
+            this->dump_field("dirtied groups ", m_dirtied_groups);
+
             /// Footer
             ///
 
             bsl::print() << bsl::ylw << "+----------------------------------------------------+";
             bsl::print() << bsl::rst << bsl::endl;
 
+            m_exit_policy.dump();
+
             // clang-format on
         }
     };
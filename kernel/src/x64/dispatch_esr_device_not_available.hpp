@@ -0,0 +1,124 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef DISPATCH_ESR_DEVICE_NOT_AVAILABLE_HPP
+#define DISPATCH_ESR_DEVICE_NOT_AVAILABLE_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace mk
+{
+    /// @brief defines the bits in CS that hold the privilege level
+    constexpr bsl::safe_uintmax DNA_CS_RPL_MASK{bsl::to_umax(0x3U)};
+
+    /// <!-- description -->
+    ///   @brief Provides the ESR handler for device not available (#NM)
+    ///     exceptions, which is how the FPU state is switched lazily.
+    ///     CR0.TS is set whenever the FPU holds state that does not belong
+    ///     to the extension that is executing, so the first x87/SSE/AVX
+    ///     instruction an extension executes ends up here. The state that
+    ///     is currently loaded is saved to the XSAVE area of its owner, the
+    ///     extension's state is loaded, and the extension continues with
+    ///     CR0.TS clear. Switching back to a VPS is done right before the
+    ///     VPS is run (see vps_t::run).
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+    ///   @param tls the current TLS block
+    ///   @param ext the extension that generated the #NM
+    ///   @param intrinsic the intrinsics to use
+    ///   @return Returns bsl::errc_success if the exception was handled,
+    ///     bsl::errc_failure otherwise
+    ///
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename INTRINSIC_CONCEPT>
+    [[nodiscard]] constexpr auto
+    dispatch_esr_device_not_available(
+        TLS_CONCEPT &tls, EXT_CONCEPT *const ext, INTRINSIC_CONCEPT &intrinsic) noexcept
+        -> bsl::errc_type
+    {
+        if (bsl::unlikely(bsl::ZERO_UMAX == tls.xsave_enabled)) {
+            return bsl::errc_failure;
+        }
+
+        /// NOTE:
+        /// - The microkernel is compiled without FPU support, so a #NM
+        ///   from ring 0 is a bug and is reported like any other exception.
+        ///
+
+        if (bsl::unlikely((bsl::to_umax(tls.esr_cs) & DNA_CS_RPL_MASK).is_zero())) {
+            return bsl::errc_failure;
+        }
+
+        if (bsl::unlikely(nullptr == ext)) {
+            return bsl::errc_failure;
+        }
+
+        auto *const area{ext->xsave_area(tls)};
+        if (bsl::unlikely(nullptr == area)) {
+            bsl::print<bsl::V>() << bsl::here();
+            return bsl::errc_failure;
+        }
+
+        if (area == tls.active_xsave) {
+            intrinsic.clts();
+            return bsl::errc_success;
+        }
+
+        /// NOTE:
+        /// - If nothing owns the FPU yet, it still holds the root OS's state
+        ///   from when the microkernel was started. That state is set aside
+        ///   until the VPS that is initialized from the root OS's state
+        ///   claims it (see bf_vps_op_init_as_root).
+        ///
+
+        if (nullptr == tls.active_xsave) {
+            auto *const root{ext->root_xsave_area(tls)};
+            if (bsl::unlikely(nullptr == root)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            intrinsic.clts();
+            intrinsic.xsave(root);
+            tls.root_xsave = root;
+        }
+        else {
+            intrinsic.clts();
+            intrinsic.xsave(tls.active_xsave);
+        }
+
+        intrinsic.xrstor(area);
+        tls.active_xsave = area;
+
+        return bsl::errc_success;
+    }
+}
+
+#endif
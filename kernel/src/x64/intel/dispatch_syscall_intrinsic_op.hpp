@@ -94,12 +94,54 @@ namespace mk
         ///   trying to read/write MSRs that the microkernel is using.
         ///
 
-        auto const ret{intrinsic.wrmsr(bsl::to_u32_unsafe(tls.ext_reg1), tls.ext_reg2)};
+        constexpr auto ia32_star{bsl::to_u32(0xC0000081U)};
+        constexpr auto ia32_lstar{bsl::to_u32(0xC0000082U)};
+        constexpr auto ia32_cstar{bsl::to_u32(0xC0000083U)};
+        constexpr auto ia32_fmask{bsl::to_u32(0xC0000084U)};
+        constexpr auto ia32_kernel_gs_base{bsl::to_u32(0xC0000102U)};
+
+        auto const msr{bsl::to_u32_unsafe(tls.ext_reg1)};
+
+        /// NOTE:
+        /// - The microkernel's own syscall entry uses these MSRs, and
+        ///   intrinsic_vmrun/intrinsic_vmexit assume they always hold the
+        ///   host values while the microkernel is running. The guest's
+        ///   values are set using bf_vps_op_write_reg instead.
+        ///
+
+        if (bsl::unlikely((msr == ia32_star) || (msr == ia32_lstar) || (msr == ia32_fmask))) {
+            bsl::error() << "the microkernel owns msr "    // --
+                         << bsl::hex(msr)                  // --
+                         << " and it cannot be written"    // --
+                         << bsl::endl                      // --
+                         << bsl::here();                   // --
+
+            tls.syscall_ret_status = syscall::BF_STATUS_INVALID_PARAMS1.get();
+            return bsl::errc_failure;
+        }
+
+        auto const ret{intrinsic.wrmsr(msr, tls.ext_reg2)};
         if (bsl::unlikely(!ret)) {
             bsl::print<bsl::V>() << bsl::here();
             return bsl::errc_failure;
         }
 
+        /// NOTE:
+        /// - intrinsic_vmrun only writes these MSRs when the TLS block says
+        ///   that the value loaded on this PP is different from what the
+        ///   VPS needs, so the TLS block has to see this write as well.
+        ///
+
+        if (msr == ia32_cstar) {
+            tls.loaded_ia32_cstar = tls.ext_reg2;
+        }
+        else if (msr == ia32_kernel_gs_base) {
+            tls.loaded_ia32_kernel_gs_base = tls.ext_reg2;
+        }
+        else {
+            bsl::touch();
+        }
+
         tls.syscall_ret_status = syscall::BF_STATUS_SUCCESS.get();
         return bsl::errc_success;
     }
@@ -27,18 +27,26 @@
 
 #include <allocate_tags.hpp>
 #include <allocated_status_t.hpp>
+#include <exit_policy_t.hpp>
 #include <general_purpose_regs_t.hpp>
 #include <mk_interface.hpp>
 #include <vmcs_missing_registers_t.hpp>
 #include <vmcs_t.hpp>
+#include <xsave_area_t.hpp>
 
 #include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstring.hpp>
 #include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
 #include <bsl/finally.hpp>
 #include <bsl/is_same.hpp>
+#include <bsl/likely.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
 #include <bsl/string_view.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 #include <bsl/unlikely_assert.hpp>
 
@@ -74,6 +82,14 @@ namespace mk
     /// @brief defines the IA32_KERNEL_GS_BASE MSR
     constexpr bsl::safe_uint32 IA32_KERNEL_GS_BASE{bsl::to_u32(0xC0000102U)};
 
+    /// @brief defines the byte of the MSR bitmap that holds the write bits of IA32_STAR-IA32_FMASK
+    constexpr bsl::safe_uintmax MSR_BITMAP_SYSCALL_MSRS_OFFSET{bsl::to_umax(0xC10U)};
+    /// @brief defines the write bits of IA32_STAR, IA32_LSTAR, IA32_CSTAR and IA32_FMASK
+    constexpr bsl::safe_uint8 MSR_BITMAP_SYSCALL_MSRS_BITS{bsl::to_u8(0x1EU)};
+
+    /// @brief defines the CR0 task switched bit used for lazy FPU switching
+    constexpr bsl::safe_uintmax CR0_TS{bsl::to_umax(0x0000000000000008U)};
+
     /// @class mk::vps_t
     ///
     /// <!-- description -->
@@ -100,6 +116,113 @@ namespace mk
         vmcs_missing_registers_t m_vmcs_missing_registers{};
         /// @brief stores the general purpose registers
         general_purpose_regs_t m_gprs{};
+        /// @brief stores the FPU state of this VPS while it is not loaded
+        xsave_area_t *m_xsave{};
+        /// @brief stores the exit policy of this VPS
+        exit_policy_t m_exit_policy{};
+        /// @brief stores whether or not the extension enabled MSR bitmaps
+        bool m_msr_bitmaps_enabled{};
+        /// @brief stores the byte of the MSR bitmap that intercepts the syscall MSRs
+        bsl::uint8 const *m_syscall_msrs_bitmap{};
+
+        /// <!-- description -->
+        ///   @brief Returns a pointer to the byte of the MSR bitmap that
+        ///     holds the write bits of the syscall MSRs given a pointer to
+        ///     the MSR bitmap itself.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param bitmap the microkernel's virtual address of the MSR bitmap
+        ///   @return Returns a pointer to the byte of the MSR bitmap that
+        ///     holds the write bits of the syscall MSRs
+        ///
+        [[nodiscard]] static constexpr auto
+        syscall_msrs_bitmap(void const *const bitmap) noexcept -> bsl::uint8 const *
+        {
+            return bsl::to_ptr<bsl::uint8 const *>(
+                bsl::to_umax(bitmap) + MSR_BITMAP_SYSCALL_MSRS_OFFSET);
+        }
+
+        /// <!-- description -->
+        ///   @brief Ensures that the FPU holds this VPS's state. The state
+        ///     that is currently loaded (if any) is saved to the XSAVE area
+        ///     of its owner first. CR0.TS is set again before returning so
+        ///     that the extension gets a #NM if it uses the FPU before the
+        ///     state is switched back.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        constexpr void
+        ensure_this_xsave_is_loaded(TLS_CONCEPT &tls, INTRINSIC_CONCEPT &intrinsic) &noexcept
+        {
+            if (bsl::ZERO_UMAX == tls.xsave_enabled) {
+                return;
+            }
+
+            if (bsl::likely(m_xsave == tls.active_xsave)) {
+                return;
+            }
+
+            /// NOTE:
+            /// - A nullptr means the FPU still holds the root OS's state
+            ///   from when the microkernel was started, which has already
+            ///   been given to a VPS by state_save_to_vps(), or was never
+            ///   given to one, in which case it must not leak into this VPS.
+            ///   Either way it is overwritten and not saved.
+            ///
+
+            intrinsic.clts();
+            if (nullptr != tls.active_xsave) {
+                intrinsic.xsave(tls.active_xsave);
+            }
+            else {
+                bsl::touch();
+            }
+
+            intrinsic.xrstor(m_xsave);
+            intrinsic.stts();
+
+            tls.active_xsave = m_xsave;
+        }
+
+        /// <!-- description -->
+        ///   @brief Gives this VPS the root OS's FPU state. If an extension
+        ///     has used the FPU already, the root OS's state was set aside
+        ///     by the #NM handler, otherwise the FPU still holds it.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        constexpr void
+        claim_root_xsave(TLS_CONCEPT &tls, INTRINSIC_CONCEPT &intrinsic) &noexcept
+        {
+            if (bsl::ZERO_UMAX == tls.xsave_enabled) {
+                return;
+            }
+
+            if (nullptr != tls.root_xsave) {
+                bsl::builtin_memcpy(m_xsave, tls.root_xsave, sizeof(xsave_area_t));
+                tls.root_xsave = {};
+                return;
+            }
+
+            if (nullptr == tls.active_xsave) {
+                intrinsic.clts();
+                intrinsic.xsave(m_xsave);
+                intrinsic.stts();
+                return;
+            }
+
+            bsl::touch();
+        }
 
         /// <!-- description -->
         ///   @brief Stores the provided ES segment state info in the VPS.
@@ -1358,7 +1481,19 @@ namespace mk
                 return ret;
             }
 
-            ret = intrinsic.vmwrite64(VMCS_HOST_CR0, intrinsic.cr0());
+            /// NOTE:
+            /// - When lazy FPU switching is enabled, every VMExit has to
+            ///   return to the extension with CR0.TS set, as the FPU holds
+            ///   the guest's state and not the extension's.
+            ///
+
+            if (bsl::ZERO_UMAX != tls.xsave_enabled) {
+                ret = intrinsic.vmwrite64(VMCS_HOST_CR0, intrinsic.cr0() | CR0_TS);
+            }
+            else {
+                ret = intrinsic.vmwrite64(VMCS_HOST_CR0, intrinsic.cr0());
+            }
+
             if (bsl::unlikely_assert(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
                 return ret;
@@ -1490,6 +1625,235 @@ namespace mk
             bsl::print() << bsl::rst << bsl::endl;
         }
 
+        /// <!-- description -->
+        ///   @brief Tells intrinsic_vmexit whether or not it can skip
+        ///     reading back the syscall MSRs. This is only the case when
+        ///     every guest WRMSR VMExits (MSR bitmaps are disabled), or when
+        ///     the extension's MSR bitmap already intercepts writes to all
+        ///     of the syscall MSRs. The MSR bitmap belongs to the extension,
+        ///     so it is only ever read, never written.
+        ///
+        constexpr void
+        update_syscall_msrs_intercepted() &noexcept
+        {
+            m_vmcs_missing_registers.syscall_msrs_bitmap = {};
+
+            if (!m_msr_bitmaps_enabled) {
+                m_vmcs_missing_registers.syscall_msrs_intercepted = bsl::ONE_UMAX.get();
+                return;
+            }
+
+            m_vmcs_missing_registers.syscall_msrs_intercepted = {};
+
+            /// NOTE:
+            /// - page_freed can drop the pointer from another PP. The page
+            ///   is not given back to the page pool until this PP takes its
+            ///   next VMExit (see tlb_shootdown_t), and it always stays in
+            ///   the microkernel's direct map, so it is safe to read here.
+            ///
+
+            auto const *const bitmap{__atomic_load_n(&m_syscall_msrs_bitmap, __ATOMIC_ACQUIRE)};
+            if (nullptr == bitmap) {
+                return;
+            }
+
+            bsl::safe_uint8 const bits{__atomic_load_n(bitmap, __ATOMIC_RELAXED)};
+            if ((bits & MSR_BITMAP_SYSCALL_MSRS_BITS) != MSR_BITMAP_SYSCALL_MSRS_BITS) {
+                return;
+            }
+
+            m_vmcs_missing_registers.syscall_msrs_intercepted = bsl::ONE_UMAX.get();
+            m_vmcs_missing_registers.syscall_msrs_bitmap = bsl::to_umax(bitmap).get();
+        }
+
+        /// <!-- description -->
+        ///   @brief Writes a field to the VPS given the index of
+        ///     the field and the value to write. This does not keep track
+        ///     of the MSR bitmap. Use write() for fields that the extension
+        ///     provides.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam FIELD_TYPE the type (i.e., size) of field to write
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param index the index of the field to write to the VPS
+        ///   @param val the value to write to the VPS
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename FIELD_TYPE, typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        [[nodiscard]] constexpr auto
+        write_field(
+            TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uintmax const &index,
+            bsl::safe_integral<FIELD_TYPE> const &val) &noexcept -> bsl::errc_type
+        {
+            /// TODO:
+            /// - Implement a field type checker to make sure the user is
+            ///   using the proper field type here. Make sure that this field
+            ///   type checker is only turned on with debug builds.
+            ///
+
+            bsl::errc_type ret{};
+
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "vps_t not initialized\n" << bsl::here();
+                return bsl::errc_precondition;
+            }
+
+            if (bsl::unlikely(m_allocated != allocated_status_t::allocated)) {
+                bsl::error() << "vps "                                             // --
+                             << bsl::hex(m_id)                                     // --
+                             << "'s status is not allocated and cannot be used"    // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::errc_precondition;
+            }
+
+            if (bsl::unlikely_assert(!val)) {
+                bsl::error() << "invalid value\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(tls.ppid != m_assigned_ppid)) {
+                bsl::error() << "vp "                                  // --
+                             << bsl::hex(m_id)                         // --
+                             << " is assigned to pp "                  // --
+                             << bsl::hex(m_assigned_ppid)              // --
+                             << " and cannot be operated on by pp "    // --
+                             << bsl::hex(tls.ppid)                     // --
+                             << bsl::endl                              // --
+                             << bsl::here();                           // --
+
+                return bsl::errc_precondition;
+            }
+
+            ret = this->ensure_this_vps_is_loaded(tls, intrinsic);
+            if (bsl::unlikely_assert(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            constexpr auto vmcs_pinbased_ctls_idx{bsl::to_umax(0x4000U)};
+            constexpr auto vmcs_procbased_ctls_idx{bsl::to_umax(0x4002U)};
+            constexpr auto vmcs_exit_ctls_idx{bsl::to_umax(0x400CU)};
+            constexpr auto vmcs_entry_ctls_idx{bsl::to_umax(0x4012U)};
+
+            bsl::safe_integral<FIELD_TYPE> sanitized{val};
+
+            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint32>::value) {
+                switch (index.get()) {
+                    case vmcs_pinbased_ctls_idx.get(): {
+                        constexpr auto vmcs_pinbased_ctls_mask{bsl::to_u32(0x28U)};
+                        sanitized |= vmcs_pinbased_ctls_mask;
+                        break;
+                    }
+
+                    case vmcs_procbased_ctls_idx.get(): {
+                        constexpr auto vmcs_use_msr_bitmaps{bsl::to_u32(0x10000000U)};
+                        m_msr_bitmaps_enabled = !(sanitized & vmcs_use_msr_bitmaps).is_zero();
+                        break;
+                    }
+
+                    case vmcs_exit_ctls_idx.get(): {
+                        constexpr auto vmcs_exit_ctls_mask{bsl::to_u32(0x3C0204U)};
+                        sanitized |= vmcs_exit_ctls_mask;
+                        break;
+                    }
+
+                    case vmcs_entry_ctls_idx.get(): {
+                        constexpr auto vmcs_entry_ctls_mask{bsl::to_u32(0xC204U)};
+                        sanitized |= vmcs_entry_ctls_mask;
+                        break;
+                    }
+
+                    default: {
+                        break;
+                    }
+                }
+            }
+            else {
+                switch (index.get()) {
+                    case vmcs_pinbased_ctls_idx.get(): {
+                        bsl::error() << "invalid integer type for field: "    // --
+                                     << bsl::hex(index)                       // --
+                                     << bsl::endl                             // --
+                                     << bsl::here();                          // --
+
+                        return bsl::errc_failure;
+                    }
+
+                    case vmcs_procbased_ctls_idx.get(): {
+                        bsl::error() << "invalid integer type for field: "    // --
+                                     << bsl::hex(index)                       // --
+                                     << bsl::endl                             // --
+                                     << bsl::here();                          // --
+
+                        return bsl::errc_failure;
+                    }
+
+                    case vmcs_exit_ctls_idx.get(): {
+                        bsl::error() << "invalid integer type for field: "    // --
+                                     << bsl::hex(index)                       // --
+                                     << bsl::endl                             // --
+                                     << bsl::here();                          // --
+
+                        return bsl::errc_failure;
+                    }
+
+                    case vmcs_entry_ctls_idx.get(): {
+                        bsl::error() << "invalid integer type for field: "    // --
+                                     << bsl::hex(index)                       // --
+                                     << bsl::endl                             // --
+                                     << bsl::here();                          // --
+
+                        return bsl::errc_failure;
+                    }
+
+                    default: {
+                        break;
+                    }
+                }
+            }
+
+            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint16>::value) {
+                ret = intrinsic.vmwrite16(index, sanitized);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint32>::value) {
+                ret = intrinsic.vmwrite32(index, sanitized);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint64>::value) {
+                ret = intrinsic.vmwrite64(index, sanitized);
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            bsl::error() << "unsupported field type\n" << bsl::here();
+            return bsl::errc_failure;
+        }
+
     public:
         /// <!-- description -->
         ///   @brief Initializes this vps_t
@@ -1566,13 +1930,52 @@ namespace mk
                 return bsl::errc_failure;
             }
 
+            /// NOTE:
+            /// - Only the assigned PP can have this VPS's FPU state loaded, so
+            ///   any other PP leaks the XSAVE area by turning this VPS into a
+            ///   zombie instead of freeing memory that might still be in use.
+            ///
+
+            if (bsl::unlikely((nullptr != m_xsave) && (tls.ppid != m_assigned_ppid))) {
+                bsl::error() << "vps "                               // --
+                             << bsl::hex(m_id)                       // --
+                             << " is assigned to pp "                // --
+                             << bsl::hex(m_assigned_ppid)            // --
+                             << " and cannot be destroyed by pp "    // --
+                             << bsl::hex(tls.ppid)                   // --
+                             << bsl::endl                            // --
+                             << bsl::here();                         // --
+
+                return bsl::errc_failure;
+            }
+
             m_gprs = {};
             m_vmcs_missing_registers = {};
+            m_msr_bitmaps_enabled = {};
+            __atomic_store_n(&m_syscall_msrs_bitmap, nullptr, __ATOMIC_RELEASE);
 
             m_vmcs_phys = bsl::safe_uintmax::zero(true);
             page_pool.deallocate(tls, m_vmcs, ALLOCATE_TAG_VMCS);
             m_vmcs = {};
 
+            /// NOTE:
+            /// - An inactive VPS's FPU state can only still be loaded on the
+            ///   PP it was assigned to (i.e., this PP) if no other VPS has run
+            ///   there since, in which case the FPU is simply treated as
+            ///   unowned.
+            ///
+
+            if (m_xsave == tls.active_xsave) {
+                tls.active_xsave = {};
+            }
+            else {
+                bsl::touch();
+            }
+
+            page_pool.deallocate(tls, m_xsave, ALLOCATE_TAG_XSAVE_AREA);
+            m_xsave = {};
+
+            m_exit_policy.clear();
             m_assigned_ppid = syscall::BF_INVALID_ID;
             m_assigned_vpid = syscall::BF_INVALID_ID;
             m_allocated = allocated_status_t::deallocated;
@@ -1717,6 +2120,9 @@ namespace mk
             tls.log_vpsid = m_id.get();
 
             bsl::finally cleanup_on_error{[this, &tls, &page_pool]() noexcept -> void {
+                page_pool.deallocate(tls, m_xsave, ALLOCATE_TAG_XSAVE_AREA);
+                m_xsave = {};
+
                 m_vmcs_phys = bsl::safe_uintmax::zero(true);
                 page_pool.deallocate(tls, m_vmcs, ALLOCATE_TAG_VMCS);
                 m_vmcs = {};
@@ -1734,6 +2140,18 @@ namespace mk
                 return bsl::safe_uint16::zero(true);
             }
 
+            if (bsl::ZERO_UMAX != tls.xsave_enabled) {
+                m_xsave =
+                    page_pool.template allocate<xsave_area_t>(tls, ALLOCATE_TAG_XSAVE_AREA);
+                if (bsl::unlikely(nullptr == m_xsave)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::safe_uint16::zero(true);
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
             ret = this->init_vmcs(tls, intrinsic);
             if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
@@ -1788,6 +2206,26 @@ namespace mk
                 return bsl::errc_precondition;
             }
 
+            /// NOTE:
+            /// - This VPS's FPU state can only be loaded on the PP that it
+            ///   is assigned to, and only that PP's TLS block points to it,
+            ///   so any other PP would free the XSAVE area while it might
+            ///   still be in use.
+            ///
+
+            if (bsl::unlikely(tls.ppid != m_assigned_ppid)) {
+                bsl::error() << "vps "                               // --
+                             << bsl::hex(m_id)                       // --
+                             << " is assigned to pp "                // --
+                             << bsl::hex(m_assigned_ppid)            // --
+                             << " and cannot be destroyed by pp "    // --
+                             << bsl::hex(tls.ppid)                   // --
+                             << bsl::endl                            // --
+                             << bsl::here();                         // --
+
+                return bsl::errc_precondition;
+            }
+
             tls.state_reversal_required = true;
             bsl::finally zombify_on_error{[this]() noexcept -> void {
                 this->zombify();
@@ -1809,11 +2247,31 @@ namespace mk
 
             m_gprs = {};
             m_vmcs_missing_registers = {};
+            m_msr_bitmaps_enabled = {};
+            __atomic_store_n(&m_syscall_msrs_bitmap, nullptr, __ATOMIC_RELEASE);
 
             m_vmcs_phys = bsl::safe_uintmax::zero(true);
             page_pool.deallocate(tls, m_vmcs, ALLOCATE_TAG_VMCS);
             m_vmcs = {};
 
+            /// NOTE:
+            /// - An inactive VPS's FPU state can only still be loaded on the
+            ///   PP it was assigned to (i.e., this PP) if no other VPS has run
+            ///   there since, in which case the FPU is simply treated as
+            ///   unowned.
+            ///
+
+            if (m_xsave == tls.active_xsave) {
+                tls.active_xsave = {};
+            }
+            else {
+                bsl::touch();
+            }
+
+            page_pool.deallocate(tls, m_xsave, ALLOCATE_TAG_XSAVE_AREA);
+            m_xsave = {};
+
+            m_exit_policy.clear();
             m_assigned_ppid = syscall::BF_INVALID_ID;
             m_assigned_vpid = syscall::BF_INVALID_ID;
             m_allocated = allocated_status_t::deallocated;
@@ -2510,6 +2968,8 @@ namespace mk
                 return ret;
             }
 
+            this->claim_root_xsave(tls, intrinsic);
+
             return bsl::errc_success;
         }
 
@@ -2782,6 +3242,15 @@ namespace mk
                 return ret;
             }
 
+            /// NOTE:
+            /// - The root OS continues with whatever the FPU holds once it is
+            ///   promoted, so this VPS's state has to be loaded, and it
+            ///   replaces any state set aside from when we were started.
+            ///
+
+            this->ensure_this_xsave_is_loaded(tls, intrinsic);
+            tls.root_xsave = {};
+
             return bsl::errc_success;
         }
 
@@ -2890,166 +3359,108 @@ namespace mk
         ///   @tparam FIELD_TYPE the type (i.e., size) of field to write
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @tparam EXT_CONCEPT defines the type of ext_t to use
         ///   @param tls the current TLS block
         ///   @param intrinsic the intrinsics to use
+        ///   @param ext the extension that made the syscall
         ///   @param index the index of the field to write to the VPS
         ///   @param val the value to write to the VPS
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
-        template<typename FIELD_TYPE, typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        template<
+            typename FIELD_TYPE,
+            typename TLS_CONCEPT,
+            typename INTRINSIC_CONCEPT,
+            typename EXT_CONCEPT>
         [[nodiscard]] constexpr auto
         write(
             TLS_CONCEPT &tls,
             INTRINSIC_CONCEPT &intrinsic,
+            EXT_CONCEPT &ext,
             bsl::safe_uintmax const &index,
             bsl::safe_integral<FIELD_TYPE> const &val) &noexcept -> bsl::errc_type
         {
-            /// TODO:
-            /// - Implement a field type checker to make sure the user is
-            ///   using the proper field type here. Make sure that this field
-            ///   type checker is only turned on with debug builds.
-            ///
-
-            bsl::errc_type ret{};
-
-            if (bsl::unlikely_assert(!m_id)) {
-                bsl::error() << "vps_t not initialized\n" << bsl::here();
-                return bsl::errc_precondition;
-            }
-
-            if (bsl::unlikely(m_allocated != allocated_status_t::allocated)) {
-                bsl::error() << "vps "                                             // --
-                             << bsl::hex(m_id)                                     // --
-                             << "'s status is not allocated and cannot be used"    // --
-                             << bsl::endl                                          // --
-                             << bsl::here();                                       // --
-
-                return bsl::errc_precondition;
-            }
-
-            if (bsl::unlikely_assert(!val)) {
-                bsl::error() << "invalid value\n" << bsl::here();
-                return bsl::errc_failure;
-            }
-
-            if (bsl::unlikely(tls.ppid != m_assigned_ppid)) {
-                bsl::error() << "vp "                                  // --
-                             << bsl::hex(m_id)                         // --
-                             << " is assigned to pp "                  // --
-                             << bsl::hex(m_assigned_ppid)              // --
-                             << " and cannot be operated on by pp "    // --
-                             << bsl::hex(tls.ppid)                     // --
-                             << bsl::endl                              // --
-                             << bsl::here();                           // --
+            constexpr auto vmcs_msr_bitmaps_idx{bsl::to_umax(0x2004U)};
+            constexpr auto vmcs_msr_bitmaps_high_idx{bsl::to_umax(0x2005U)};
 
-                return bsl::errc_precondition;
-            }
-
-            ret = this->ensure_this_vps_is_loaded(tls, intrinsic);
-            if (bsl::unlikely_assert(!ret)) {
+            auto const ret{this->template write_field<FIELD_TYPE>(tls, intrinsic, index, val)};
+            if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
                 return ret;
             }
 
-            constexpr auto vmcs_pinbased_ctls_idx{bsl::to_umax(0x4000U)};
-            constexpr auto vmcs_exit_ctls_idx{bsl::to_umax(0x400CU)};
-            constexpr auto vmcs_entry_ctls_idx{bsl::to_umax(0x4012U)};
-
-            bsl::safe_integral<FIELD_TYPE> sanitized{val};
-
-            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint32>::value) {
-                switch (index.get()) {
-                    case vmcs_pinbased_ctls_idx.get(): {
-                        constexpr auto vmcs_pinbased_ctls_mask{bsl::to_u32(0x28U)};
-                        sanitized |= vmcs_pinbased_ctls_mask;
-                        break;
-                    }
-
-                    case vmcs_exit_ctls_idx.get(): {
-                        constexpr auto vmcs_exit_ctls_mask{bsl::to_u32(0x3C0204U)};
-                        sanitized |= vmcs_exit_ctls_mask;
-                        break;
-                    }
-
-                    case vmcs_entry_ctls_idx.get(): {
-                        constexpr auto vmcs_entry_ctls_mask{bsl::to_u32(0xC204U)};
-                        sanitized |= vmcs_entry_ctls_mask;
-                        break;
-                    }
-
-                    default: {
-                        break;
-                    }
-                }
+            if ((vmcs_msr_bitmaps_idx != index) && (vmcs_msr_bitmaps_high_idx != index)) {
+                return ret;
             }
-            else {
-                switch (index.get()) {
-                    case vmcs_pinbased_ctls_idx.get(): {
-                        bsl::error() << "invalid integer type for field: "    // --
-                                     << bsl::hex(index)                       // --
-                                     << bsl::endl                             // --
-                                     << bsl::here();                          // --
-
-                        return bsl::errc_failure;
-                    }
-
-                    case vmcs_exit_ctls_idx.get(): {
-                        bsl::error() << "invalid integer type for field: "    // --
-                                     << bsl::hex(index)                       // --
-                                     << bsl::endl                             // --
-                                     << bsl::here();                          // --
-
-                        return bsl::errc_failure;
-                    }
 
-                    case vmcs_entry_ctls_idx.get(): {
-                        bsl::error() << "invalid integer type for field: "    // --
-                                     << bsl::hex(index)                       // --
-                                     << bsl::endl                             // --
-                                     << bsl::here();                          // --
+            /// NOTE:
+            /// - The MSR bitmap is only read if it is a page that the
+            ///   extension allocated using bf_mem_op_alloc_page and has not
+            ///   freed. Any other MSR bitmap (or a partial write of the
+            ///   address) means the syscall MSRs are always read back.
+            /// - The page is stored before ownership is checked a second
+            ///   time. If the extension frees the page on another PP in the
+            ///   meantime, either the second check fails and the page is
+            ///   dropped here, or page_freed sees the page and drops it.
+            ///
 
-                        return bsl::errc_failure;
-                    }
+            __atomic_store_n(&m_syscall_msrs_bitmap, nullptr, __ATOMIC_SEQ_CST);
 
-                    default: {
-                        break;
-                    }
+            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint64>::value) {
+                if (vmcs_msr_bitmaps_idx != index) {
+                    return ret;
                 }
-            }
 
-            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint16>::value) {
-                ret = intrinsic.vmwrite16(index, sanitized);
-                if (bsl::unlikely(!ret)) {
-                    bsl::print<bsl::V>() << bsl::here();
+                bsl::safe_uintmax const phys{bsl::to_umax(val)};
+                auto const *const bitmap{ext.template alloc_page_to_virt<void const>(tls, phys)};
+                if (nullptr == bitmap) {
                     return ret;
                 }
 
-                return ret;
-            }
+                auto const *expected{syscall_msrs_bitmap(bitmap)};
+                __atomic_store_n(&m_syscall_msrs_bitmap, expected, __ATOMIC_SEQ_CST);
 
-            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint32>::value) {
-                ret = intrinsic.vmwrite32(index, sanitized);
-                if (bsl::unlikely(!ret)) {
-                    bsl::print<bsl::V>() << bsl::here();
-                    return ret;
+                if (nullptr == ext.template alloc_page_to_virt<void const>(tls, phys)) {
+                    bsl::discard(__atomic_compare_exchange_n(
+                        &m_syscall_msrs_bitmap,
+                        &expected,
+                        nullptr,
+                        false,
+                        __ATOMIC_SEQ_CST,
+                        __ATOMIC_SEQ_CST));
+                }
+                else {
+                    bsl::touch();
                 }
-
-                return ret;
             }
 
-            if constexpr (bsl::is_same<FIELD_TYPE, bsl::uint64>::value) {
-                ret = intrinsic.vmwrite64(index, sanitized);
-                if (bsl::unlikely(!ret)) {
-                    bsl::print<bsl::V>() << bsl::here();
-                    return ret;
-                }
+            return ret;
+        }
 
-                return ret;
+        /// <!-- description -->
+        ///   @brief Tells this VPS that the extension freed the provided
+        ///     page. If it is the MSR bitmap, the VPS stops reading it, and
+        ///     the syscall MSRs are read back on each VMExit from then on.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param page the microkernel's virtual address of the page
+        ///
+        constexpr void
+        page_freed(void const *const page) &noexcept
+        {
+            auto const *expected{syscall_msrs_bitmap(page)};
+            if (__atomic_load_n(&m_syscall_msrs_bitmap, __ATOMIC_SEQ_CST) != expected) {
+                return;
             }
 
-            bsl::error() << "unsupported field type\n" << bsl::here();
-            return bsl::errc_failure;
+            bsl::discard(__atomic_compare_exchange_n(
+                &m_syscall_msrs_bitmap,
+                &expected,
+                nullptr,
+                false,
+                __ATOMIC_SEQ_CST,
+                __ATOMIC_SEQ_CST));
         }
 
         /// <!-- description -->
@@ -4024,7 +4435,7 @@ namespace mk
                 }
             }
 
-            auto const ret{this->write<bsl::uint64>(tls, intrinsic, index, val)};
+            auto const ret{this->write_field<bsl::uint64>(tls, intrinsic, index, val)};
             if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
                 return ret;
@@ -4090,6 +4501,17 @@ namespace mk
                 return bsl::safe_uintmax::zero(true);
             }
 
+            this->ensure_this_xsave_is_loaded(tls, intrinsic);
+
+            /// NOTE:
+            /// - The extension can change its MSR bitmap at any time, so
+            ///   whether the syscall MSRs are intercepted is checked before
+            ///   each VMEntry, and intrinsic_vmexit checks the bits again
+            ///   on the way out. This is a single load of the MSR bitmap.
+            ///
+
+            this->update_syscall_msrs_intercepted();
+
             bsl::safe_uintmax const exit_reason{intrinsic_vmrun(&m_vmcs_missing_registers)};
             if (bsl::unlikely(exit_reason > invalid_exit_reason)) {
                 bsl::error() << "vmlaunch/vmresume failed with error code "    // --
@@ -4100,6 +4522,26 @@ namespace mk
                 return bsl::safe_uintmax::zero(true);
             }
 
+            /// NOTE:
+            /// - Most VMExit handlers need at least one of the following
+            ///   fields. They are placed in the extension's TLS block so
+            ///   that the extension can read them without a syscall.
+            ///
+
+            intrinsic.set_tls_reg(
+                syscall::TLS_OFFSET_EXIT_RIP, intrinsic.vmread64_quiet(VMCS_GUEST_RIP));
+            intrinsic.set_tls_reg(
+                syscall::TLS_OFFSET_EXIT_INSTRUCTION_LENGTH,
+                intrinsic.vmread64_quiet(VMCS_VMEXIT_INSTRUCTION_LENGTH));
+            intrinsic.set_tls_reg(
+                syscall::TLS_OFFSET_EXIT_INFO1, intrinsic.vmread64_quiet(VMCS_EXIT_QUALIFICATION));
+            intrinsic.set_tls_reg(
+                syscall::TLS_OFFSET_EXIT_INFO2,
+                intrinsic.vmread64_quiet(VMCS_GUEST_PHYSICAL_ADDRESS));
+            intrinsic.set_tls_reg(
+                syscall::TLS_OFFSET_EXIT_INT_INFO,
+                intrinsic.vmread64_quiet(VMCS_VMEXIT_INTERRUPTION_INFORMATION));
+
             if constexpr (!(BSL_DEBUG_LEVEL < bsl::VV)) {
                 log.add(
                     tls.ppid,
@@ -4211,6 +4653,156 @@ namespace mk
             return ret;
         }
 
+        /// <!-- description -->
+        ///   @brief Replaces the exit policy of this VPS with the provided
+        ///     entries. See exit_policy_t for more information.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param entries the entries defining the new exit policy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        set_exit_policy(
+            TLS_CONCEPT &tls, bsl::span<syscall::bf_exit_policy_t const> const &entries) &noexcept
+            -> bsl::errc_type
+        {
+            if (bsl::unlikely_assert(!m_id)) {
+                bsl::error() << "vps_t not initialized\n" << bsl::here();
+                return bsl::errc_precondition;
+            }
+
+            if (bsl::unlikely(m_allocated != allocated_status_t::allocated)) {
+                bsl::error() << "vps "                                             // --
+                             << bsl::hex(m_id)                                     // --
+                             << "'s status is not allocated and cannot be used"    // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::errc_precondition;
+            }
+
+            if (bsl::unlikely(tls.ppid != m_assigned_ppid)) {
+                bsl::error() << "vp "                                  // --
+                             << bsl::hex(m_id)                         // --
+                             << " is assigned to pp "                  // --
+                             << bsl::hex(m_assigned_ppid)              // --
+                             << " and cannot be operated on by pp "    // --
+                             << bsl::hex(tls.ppid)                     // --
+                             << bsl::endl                              // --
+                             << bsl::here();                           // --
+
+                return bsl::errc_precondition;
+            }
+
+            return m_exit_policy.set(entries);
+        }
+
+        /// <!-- description -->
+        ///   @brief Handles the VMExit that was just returned by run() using
+        ///     the exit policy of this VPS, if the exit policy has an entry
+        ///     for it. If the VMExit is handled, the guest's registers are
+        ///     updated, the IP is advanced and true is returned, in which
+        ///     case the VPS can be run again without calling the extension.
+        ///     Otherwise, false is returned and nothing is changed.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param exit_reason the VMExit reason returned by run()
+        ///   @return Returns true if the VMExit was handled, false otherwise
+        ///
+        template<typename TLS_CONCEPT, typename INTRINSIC_CONCEPT>
+        [[nodiscard]] constexpr auto
+        run_exit_policy(
+            TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT &intrinsic,
+            bsl::safe_uintmax const &exit_reason) &noexcept -> bool
+        {
+            constexpr auto exit_reason_cpuid{bsl::to_umax(0x0AU)};
+            constexpr auto exit_reason_rdmsr{bsl::to_umax(0x1FU)};
+            constexpr auto mask32{bsl::to_umax(0xFFFFFFFFU)};
+            constexpr auto shift32{bsl::to_umax(32)};
+
+            if (m_exit_policy.empty()) {
+                return false;
+            }
+
+            bsl::safe_uintmax idx{};
+            syscall::bf_exit_policy_t const *entry{};
+
+            if (exit_reason == exit_reason_cpuid) {
+                auto const leaf{intrinsic.tls_reg(syscall::TLS_OFFSET_RAX) & mask32};
+                entry = m_exit_policy.match(syscall::bf_exit_policy_type_t::cpuid, leaf, idx);
+            }
+            else if (exit_reason == exit_reason_rdmsr) {
+                auto const msr{intrinsic.tls_reg(syscall::TLS_OFFSET_RCX) & mask32};
+                entry = m_exit_policy.match(syscall::bf_exit_policy_type_t::rdmsr, msr, idx);
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (nullptr == entry) {
+                entry = m_exit_policy.match(
+                    syscall::bf_exit_policy_type_t::advance_ip, exit_reason, idx);
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (nullptr == entry) {
+                return false;
+            }
+
+            if (syscall::bf_exit_policy_type_t::cpuid == entry->type) {
+                bsl::safe_uint64 rax{intrinsic.tls_reg(syscall::TLS_OFFSET_RAX) & mask32};
+                bsl::safe_uint64 rbx{};
+                bsl::safe_uint64 rcx{intrinsic.tls_reg(syscall::TLS_OFFSET_RCX) & mask32};
+                bsl::safe_uint64 rdx{};
+
+                intrinsic.cpuid(rax, rbx, rcx, rdx);
+
+                rax = (rax & bsl::to_u64(~entry->eax_clear)) | bsl::to_u64(entry->eax_set);
+                rbx = (rbx & bsl::to_u64(~entry->ebx_clear)) | bsl::to_u64(entry->ebx_set);
+                rcx = (rcx & bsl::to_u64(~entry->ecx_clear)) | bsl::to_u64(entry->ecx_set);
+                rdx = (rdx & bsl::to_u64(~entry->edx_clear)) | bsl::to_u64(entry->edx_set);
+
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RAX, rax & mask32);
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RBX, rbx & mask32);
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RCX, rcx & mask32);
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RDX, rdx & mask32);
+            }
+            else if (syscall::bf_exit_policy_type_t::rdmsr == entry->type) {
+                auto const msr{intrinsic.tls_reg(syscall::TLS_OFFSET_RCX) & mask32};
+                auto const val{intrinsic.rdmsr(bsl::to_u32_unsafe(msr))};
+                if (bsl::unlikely(!val)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return false;
+                }
+
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RAX, val & mask32);
+                intrinsic.set_tls_reg(syscall::TLS_OFFSET_RDX, val >> shift32);
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto const ret{this->advance_ip(tls, intrinsic)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return false;
+            }
+
+            m_exit_policy.hit(idx);
+            return true;
+        }
+
         /// <!-- description -->
         ///   @brief Clears the VPS's internal cache. Note that this is a
         ///     hardware specific function and doesn't change the actual
@@ -4642,6 +5234,8 @@ namespace mk
             bsl::print() << bsl::ylw << "+--------------------------------------------------------------+";
             bsl::print() << bsl::rst << bsl::endl;
 
+            m_exit_policy.dump();
+
             // clang-format on
         }
     };
@@ -28,6 +28,7 @@
 #include <allocate_tags.hpp>
 #include <lock_guard.hpp>
 #include <map_page_flags.hpp>
+#include <pcid_flags.hpp>
 #include <pdpt_t.hpp>
 #include <pdpte_t.hpp>
 #include <pdt_t.hpp>
@@ -40,10 +41,12 @@
 
 #include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
 #include <bsl/finally.hpp>
 #include <bsl/fmt.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
 #include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 #include <bsl/unlikely_assert.hpp>
@@ -83,6 +86,10 @@ namespace mk
         pml4t_t *m_pml4t{};
         /// @brief stores the physical address of the pml4t
         bsl::safe_uintmax m_pml4t_phys{bsl::safe_uintmax::zero(true)};
+        /// @brief stores the PCID used to tag this RPT's TLB entries
+        bsl::safe_uint16 m_pcid{};
+        /// @brief stores the value written to CR3 when activated
+        bsl::safe_uintmax m_cr3{bsl::safe_uintmax::zero(true)};
         /// @brief safe guards operations on the RPT.
         mutable spinlock m_lock{};
 
@@ -233,6 +240,40 @@ namespace mk
                 }
             }
 
+            if constexpr (bsl::is_same<ENTRY_CONCEPT, loader::pdpte_t>::value) {
+                if (bsl::ZERO_UMAX != entry->ps) {
+                    if (add_comma) {
+                        bsl::print() << bsl::rst << ", ";
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    bsl::print() << bsl::grn << "1G";
+                    add_comma = true;
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            if constexpr (bsl::is_same<ENTRY_CONCEPT, loader::pdte_t>::value) {
+                if (bsl::ZERO_UMAX != entry->ps) {
+                    if (add_comma) {
+                        bsl::print() << bsl::rst << ", ";
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    bsl::print() << bsl::grn << "2M";
+                    add_comma = true;
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
             if constexpr (bsl::is_same<ENTRY_CONCEPT, loader::pte_t>::value) {
                 if (add_comma) {
                     bsl::print() << bsl::rst << ", ";
@@ -387,12 +428,20 @@ namespace mk
         remove_pdpt(TLS_CONCEPT &tls, loader::pml4te_t *const pml4te) noexcept
         {
             for (auto const elem : get_pdpt(pml4te)->entries) {
-                if (elem.data->p != bsl::ZERO_UMAX) {
-                    this->remove_pdt(tls, elem.data);
+                if (elem.data->p == bsl::ZERO_UMAX) {
+                    continue;
                 }
-                else {
-                    bsl::touch();
+
+                /// NOTE:
+                /// - 1G pages are not tables, and they are never auto
+                ///   released, so there is nothing to remove.
+                ///
+
+                if (elem.data->ps != bsl::ZERO_UMAX) {
+                    continue;
                 }
+
+                this->remove_pdt(tls, elem.data);
             }
 
             m_page_pool->deallocate(tls, get_pdpt(pml4te), ALLOCATE_TAG_PDPTS);
@@ -472,6 +521,10 @@ namespace mk
                 bsl::print() << bsl::blu;
                 this->output_entry_and_flags(elem.data);
 
+                if (bsl::ZERO_UMAX != elem.data->ps) {
+                    continue;
+                }
+
                 this->dump_pdt(
                     this->get_pdt(elem.data), is_pml4te_last_index, elem.index == last_index);
             }
@@ -524,12 +577,20 @@ namespace mk
         remove_pdt(TLS_CONCEPT &tls, loader::pdpte_t *const pdpte) noexcept
         {
             for (auto const elem : get_pdt(pdpte)->entries) {
-                if (elem.data->p != bsl::ZERO_UMAX) {
-                    this->remove_pt(tls, elem.data);
+                if (elem.data->p == bsl::ZERO_UMAX) {
+                    continue;
                 }
-                else {
-                    bsl::touch();
+
+                /// NOTE:
+                /// - 2M pages are not tables, and they are never auto
+                ///   released, so there is nothing to remove.
+                ///
+
+                if (elem.data->ps != bsl::ZERO_UMAX) {
+                    continue;
                 }
+
+                this->remove_pt(tls, elem.data);
             }
 
             m_page_pool->deallocate(tls, get_pdt(pdpte), ALLOCATE_TAG_PDTS);
@@ -613,6 +674,10 @@ namespace mk
                 bsl::print() << bsl::blu;
                 this->output_entry_and_flags(elem.data);
 
+                if (bsl::ZERO_UMAX != elem.data->ps) {
+                    continue;
+                }
+
                 this->dump_pt(
                     this->get_pt(elem.data),
                     is_pml4te_last_index,
@@ -882,317 +947,553 @@ namespace mk
         }
 
         /// <!-- description -->
-        ///   @brief Allocates a page from the provided page pool and maps it
-        ///     into the root page table being managed by this class The page
-        ///     is marked as "auto release", meaning when this root page table
-        ///     is released, the pages allocated by this function will
-        ///     automatically be deallocated and put back into the provided
-        ///     page pool.
+        ///   @brief Returns true if the provided address is aligned to the
+        ///     provided large page size
         ///
         /// <!-- inputs/outputs -->
-        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
-        ///   @param tls the current TLS block
-        ///   @param page_virt the virtual address to map the allocated
-        ///     page to
-        ///   @param page_flags defines how memory should be mapped
-        ///   @param auto_release defines what auto release tag to use
-        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
-        ///     and friends otherwise
+        ///   @param addr the address to query
+        ///   @param size the size of the large page to check against
+        ///   @return Returns true if the provided address is aligned to the
+        ///     provided large page size
         ///
-        template<typename TLS_CONCEPT>
-        [[nodiscard]] constexpr auto
-        allocate_page(
-            TLS_CONCEPT &tls,
-            bsl::safe_uintmax const &page_virt,
-            bsl::safe_uintmax const &page_flags,
-            bsl::safe_int32 const &auto_release) &noexcept -> void *
+        [[nodiscard]] static constexpr auto
+        is_large_page_aligned(bsl::safe_uintmax const &addr, bsl::safe_uintmax const &size) noexcept
+            -> bool
         {
-            bsl::errc_type ret{};
-
-            void *page{};
-            switch (auto_release.get()) {
-                case MAP_PAGE_AUTO_RELEASE_STACK.get(): {
-                    page = m_page_pool->template allocate<void>(tls, ALLOCATE_TAG_EXT_STACK);
-                    break;
-                }
-
-                case MAP_PAGE_AUTO_RELEASE_TLS.get(): {
-                    page = m_page_pool->template allocate<void>(tls, ALLOCATE_TAG_EXT_TLS);
-                    break;
-                }
+            return (addr & (size - bsl::ONE_UMAX)) == bsl::ZERO_UMAX;
+        }
 
-                case MAP_PAGE_AUTO_RELEASE_ELF.get(): {
-                    page = m_page_pool->template allocate<void>(tls, ALLOCATE_TAG_EXT_ELF);
-                    break;
-                }
+        /// <!-- description -->
+        ///   @brief Turns the provided pdpte_t or pdte_t into a 1G or 2M
+        ///     page. Large pages are never auto released, so they should
+        ///     only be used to map memory that is not owned by this RPT
+        ///     (e.g., the direct map).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam ENTRY_CONCEPT the type of page table entry to set
+        ///   @param entry the pdpte_t or pdte_t to set
+        ///   @param page_phys the physical address to map
+        ///   @param page_flags defines how memory should be mapped
+        ///
+        template<typename ENTRY_CONCEPT>
+        constexpr void
+        set_large_page(
+            ENTRY_CONCEPT *const entry,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_uintmax const &page_flags) noexcept
+        {
+            entry->phys = (page_phys >> PAGE_SHIFT).get();
+            entry->p = bsl::ONE_UMAX.get();
+            entry->us = bsl::ONE_UMAX.get();
+            entry->ps = bsl::ONE_UMAX.get();
 
-                default: {
-                    bsl::error() << "unknown tag\n" << bsl::here();
-                    break;
-                }
+            if (!(page_flags & MAP_PAGE_WRITE).is_zero()) {
+                entry->rw = bsl::ONE_UMAX.get();
             }
-
-            if (bsl::unlikely(nullptr == page)) {
-                bsl::print<bsl::V>() << bsl::here();
-                return nullptr;
+            else {
+                entry->rw = bsl::ZERO_UMAX.get();
             }
 
-            auto const page_phys{m_page_pool->virt_to_phys(page)};
-            if (bsl::unlikely_assert(!page_phys)) {
-                bsl::error() << "physical address is invalid: "    // --
-                             << bsl::hex(page_phys)                // --
-                             << bsl::endl                          // --
-                             << bsl::here();                       // --
-
-                return nullptr;
+            if (!(page_flags & MAP_PAGE_EXECUTE).is_zero()) {
+                entry->nx = bsl::ZERO_UMAX.get();
             }
-
-            ret = this->map_page(tls, page_virt, page_phys, page_flags, auto_release);
-            if (bsl::unlikely(!ret)) {
-                bsl::print<bsl::V>() << bsl::here();
-                return nullptr;
+            else {
+                entry->nx = bsl::ONE_UMAX.get();
             }
-
-            return page;
         }
 
         /// <!-- description -->
-        ///   @brief Releases the memory allocated for tables
+        ///   @brief Invalidates the TLB entry (of any size) that maps the
+        ///     provided virtual address on the PP that calls this function.
         ///
         /// <!-- inputs/outputs -->
-        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
-        ///   @param tls the current TLS block
+        ///   @param page_virt the virtual address to invalidate
         ///
-        template<typename TLS_CONCEPT>
         constexpr void
-        release_tables(TLS_CONCEPT &tls) &noexcept
+        invalidate(bsl::safe_uintmax const &page_virt) &noexcept
         {
-            if (bsl::unlikely(nullptr == m_pml4t)) {
-                return;
+            /// NOTE:
+            /// - INVLPG only invalidates the current PCID, and this RPT
+            ///   might not be the active one, so if this RPT has a PCID,
+            ///   the address is invalidated using that PCID instead.
+            ///
+
+            if (m_pcid.is_zero()) {
+                m_intrinsic->invlpg(page_virt);
+            }
+            else {
+                bsl::discard(m_intrinsic->invpcid(
+                    page_virt, m_pcid, INVPCID_TYPE_INDIVIDUAL_ADDRESS));
             }
+        }
 
-            if (bsl::unlikely(nullptr == m_page_pool)) {
-                return;
+        /// <!-- description -->
+        ///   @brief Returns true if every page in the provided range is
+        ///     mapped into this RPT as user memory (i.e., memory that
+        ///     belongs to the extension and not the microkernel). If write
+        ///     is true, every page must also be writable. Entries aliased
+        ///     from the extension's main RPT (e.g., its stack, TLS block and
+        ///     heap) are walked as well, as those are never unmapped while
+        ///     the extension is running. The caller must hold m_lock.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param virt the virtual address of the range to check
+        ///   @param bytes the number of bytes in the range to check
+        ///   @param write if true, the range must also be writable
+        ///   @return Returns true if the range is mapped as user memory
+        ///
+        [[nodiscard]] constexpr auto
+        is_user_range(
+            bsl::safe_uintmax const &virt,
+            bsl::safe_uintmax const &bytes,
+            bool const write) const &noexcept -> bool
+        {
+            constexpr auto max_user_virt{bsl::to_umax(0x0000800000000000U)};
+
+            auto const end{virt + bytes};
+            if (bsl::unlikely(!end)) {
+                return false;
             }
 
-            if (bsl::unlikely(nullptr == m_huge_pool)) {
-                return;
+            if (bsl::unlikely(virt.is_zero() || bytes.is_zero() || end > max_user_virt)) {
+                return false;
             }
 
-            for (auto const elem : m_pml4t->entries) {
-                if (elem.data->p == bsl::ZERO_UMAX) {
+            for (auto page{this->page_aligned(virt)}; page < end; page += PAGE_SIZE) {
+                auto const *const pml4te{m_pml4t->entries.at_if(this->pml4to(page))};
+                if (pml4te->p == bsl::ZERO_UMAX || pml4te->us == bsl::ZERO_UMAX) {
+                    return false;
+                }
+
+                auto const *const pdpt{this->get_pdpt(pml4te)};
+                auto const *const pdpte{pdpt->entries.at_if(this->pdpto(page))};
+                if (pdpte->p == bsl::ZERO_UMAX || pdpte->us == bsl::ZERO_UMAX) {
+                    return false;
+                }
+
+                if (pdpte->ps != bsl::ZERO_UMAX) {
+                    if (write && pdpte->rw == bsl::ZERO_UMAX) {
+                        return false;
+                    }
+
                     continue;
                 }
 
-                if (elem.data->alias != bsl::ZERO_UMAX) {
+                auto const *const pdt{this->get_pdt(pdpte)};
+                auto const *const pdte{pdt->entries.at_if(this->pdto(page))};
+                if (pdte->p == bsl::ZERO_UMAX || pdte->us == bsl::ZERO_UMAX) {
+                    return false;
+                }
+
+                if (pdte->ps != bsl::ZERO_UMAX) {
+                    if (write && pdte->rw == bsl::ZERO_UMAX) {
+                        return false;
+                    }
+
                     continue;
                 }
 
-                this->remove_pdpt(tls, elem.data);
+                auto const *const pt{this->get_pt(pdte)};
+                auto const *const pte{pt->entries.at_if(this->pto(page))};
+                if (pte->p == bsl::ZERO_UMAX || pte->us == bsl::ZERO_UMAX) {
+                    return false;
+                }
+
+                if (write && pte->rw == bsl::ZERO_UMAX) {
+                    return false;
+                }
+
+                bsl::touch();
             }
 
-            m_page_pool->deallocate(tls, m_pml4t, ALLOCATE_TAG_PML4TS);
-            m_pml4t = {};
-            m_pml4t_phys = bsl::safe_uintmax::zero(true);
+            return true;
         }
 
-    public:
-        /// @brief an alias for INTRINSIC_CONCEPT
-        using intrinsic_type = INTRINSIC_CONCEPT;
-        /// @brief an alias for PAGE_POOL_CONCEPT
-        using page_pool_type = PAGE_POOL_CONCEPT;
-        /// @brief an alias for HUGE_POOL_CONCEPT
-        using huge_pool_type = HUGE_POOL_CONCEPT;
-
         /// <!-- description -->
-        ///   @brief Initializes this root_page_table_t
+        ///   @brief Replaces a 1G page with a pdt_t full of 2M pages that
+        ///     map the exact same memory using the exact same permissions.
+        ///     This is needed when a smaller page has to be mapped into
+        ///     memory that is already covered by a 1G page. The new pdt_t
+        ///     is filled in before it is swapped in, so a PP that walks
+        ///     this RPT at the same time never sees a non-present entry.
+        ///     Once swapped in, the old 1G translation is invalidated on
+        ///     this PP. Other PPs might still use the stale 1G entry, but
+        ///     it maps the same memory, and any page that is later unmapped
+        ///     from the new table goes through a TLB shootdown before it is
+        ///     given back to a pool.
         ///
         /// <!-- inputs/outputs -->
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @param tls the current TLS block
-        ///   @param intrinsic the intrinsics to use
-        ///   @param page_pool the page pool to use
-        ///   @param huge_pool the huge pool to use
+        ///   @param page_virt any virtual address covered by the 1G page
+        ///   @param pdpte the 1G pdpte_t to split
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
         template<typename TLS_CONCEPT>
         [[nodiscard]] constexpr auto
-        initialize(
+        split_pdpte(
             TLS_CONCEPT &tls,
-            INTRINSIC_CONCEPT *const intrinsic,
-            PAGE_POOL_CONCEPT *const page_pool,
-            HUGE_POOL_CONCEPT *const huge_pool) &noexcept -> bsl::errc_type
+            bsl::safe_uintmax const &page_virt,
+            loader::pdpte_t *const pdpte) &noexcept -> bsl::errc_type
         {
-            if (bsl::unlikely_assert(m_initialized)) {
-                bsl::error() << "root_page_table_t already initialized\n" << bsl::here();
+            loader::pdpte_t table{};
+            if (bsl::unlikely(!this->add_pdt(tls, &table))) {
+                bsl::print<bsl::V>() << bsl::here();
                 return bsl::errc_failure;
             }
 
-            bsl::finally release_on_error{[this, &tls]() noexcept -> void {
-                this->release(tls);
-            }};
+            bsl::safe_uintmax phys{pdpte->phys};
+            for (auto const elem : this->get_pdt(&table)->entries) {
+                elem.data->phys = phys.get();
+                elem.data->p = bsl::ONE_UMAX.get();
+                elem.data->rw = pdpte->rw;
+                elem.data->us = pdpte->us;
+                elem.data->ps = bsl::ONE_UMAX.get();
+                elem.data->nx = pdpte->nx;
 
-            m_intrinsic = intrinsic;
-            if (bsl::unlikely_assert(nullptr == intrinsic)) {
-                bsl::error() << "invalid intrinsic\n" << bsl::here();
-                return bsl::errc_failure;
+                phys += (MAP_PAGE_2M_SIZE >> PAGE_SHIFT);
             }
 
-            m_page_pool = page_pool;
-            if (bsl::unlikely_assert(nullptr == page_pool)) {
-                bsl::error() << "invalid page_pool\n" << bsl::here();
-                return bsl::errc_failure;
-            }
+            *pdpte = table;
+            this->invalidate(page_virt);
 
-            m_huge_pool = huge_pool;
-            if (bsl::unlikely_assert(nullptr == huge_pool)) {
-                bsl::error() << "invalid huge_pool\n" << bsl::here();
-                return bsl::errc_failure;
-            }
+            return bsl::errc_success;
+        }
 
-            m_pml4t = m_page_pool->template allocate<pml4t_t>(tls, ALLOCATE_TAG_PML4TS);
-            if (bsl::unlikely(nullptr == m_pml4t)) {
+        /// <!-- description -->
+        ///   @brief Replaces a 2M page with a pt_t full of 4k pages that
+        ///     map the exact same memory using the exact same permissions.
+        ///     This is needed when a smaller page has to be mapped into
+        ///     memory that is already covered by a 2M page. The new pt_t
+        ///     is filled in before it is swapped in, so a PP that walks
+        ///     this RPT at the same time never sees a non-present entry.
+        ///     Once swapped in, the old 2M translation is invalidated on
+        ///     this PP. Other PPs might still use the stale 2M entry, but
+        ///     it maps the same memory, and any page that is later unmapped
+        ///     from the new table goes through a TLB shootdown before it is
+        ///     given back to a pool.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt any virtual address covered by the 2M page
+        ///   @param pdte the 2M pdte_t to split
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        split_pdte(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            loader::pdte_t *const pdte) &noexcept -> bsl::errc_type
+        {
+            loader::pdte_t table{};
+            if (bsl::unlikely(!this->add_pt(tls, &table))) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::errc_failure;
             }
 
-            m_pml4t_phys = m_page_pool->virt_to_phys(m_pml4t);
-            if (bsl::unlikely_assert(!m_pml4t_phys)) {
-                bsl::print<bsl::V>() << bsl::here();
-                return bsl::errc_failure;
+            bsl::safe_uintmax phys{pdte->phys};
+            for (auto const elem : this->get_pt(&table)->entries) {
+                elem.data->phys = phys.get();
+                elem.data->p = bsl::ONE_UMAX.get();
+                elem.data->rw = pdte->rw;
+                elem.data->us = pdte->us;
+                elem.data->auto_release = MAP_PAGE_NO_AUTO_RELEASE.get();
+                elem.data->nx = pdte->nx;
+
+                ++phys;
             }
 
-            release_on_error.ignore();
-            m_initialized = true;
+            *pdte = table;
+            this->invalidate(page_virt);
 
             return bsl::errc_success;
         }
 
         /// <!-- description -->
-        ///   @brief Releases all of the resources used by the RPT.
+        ///   @brief Maps a 2M or 1G page into the root page table being
+        ///     managed by this class. The caller must hold m_lock.
         ///
         /// <!-- inputs/outputs -->
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @param tls the current TLS block
+        ///   @param page_virt the virtual address to map the physical address
+        ///     too.
+        ///   @param page_phys the physical address to map.
+        ///   @param page_flags defines how memory should be mapped
+        ///   @param page_size either MAP_PAGE_2M_SIZE or MAP_PAGE_1G_SIZE
+        ///   @return Returns bsl::errc_success on success. If the address is
+        ///     already covered by a large page, bsl::errc_already_exists is
+        ///     returned. If smaller pages have already been mapped into the
+        ///     address range, bsl::errc_precondition is returned, in which
+        ///     case the caller should fall back to map_page(). In both of
+        ///     these cases, no error is outputted. Returns bsl::errc_failure
+        ///     and friends otherwise.
         ///
         template<typename TLS_CONCEPT>
-        constexpr void
-        release(TLS_CONCEPT &tls) &noexcept
+        [[nodiscard]] constexpr auto
+        map_large_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_uintmax const &page_flags,
+            bsl::safe_uintmax const &page_size) &noexcept -> bsl::errc_type
         {
-            lock_guard lock{tls, m_lock};
-
-            this->release_tables(tls);
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
 
-            m_huge_pool = {};
-            m_page_pool = {};
-            m_intrinsic = {};
-            m_initialized = false;
-        }
+            if (bsl::unlikely_assert(page_virt.is_zero())) {
+                bsl::error() << "virtual address is invalid: "    // --
+                             << bsl::hex(page_virt)               // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
 
-        /// <!-- description -->
-        ///   @brief Returns true if this RPT is initialized.
-        ///
-        /// <!-- inputs/outputs -->
-        ///   @return Returns true if this RPT is initialized.
-        ///
-        [[nodiscard]] constexpr auto
-        is_initialized() const &noexcept -> bool
-        {
-            return m_initialized;
-        }
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely_assert(!this->is_large_page_aligned(page_virt, page_size))) {
+                bsl::error() << "virtual address is not large page aligned: "    // --
+                             << bsl::hex(page_virt)                              // --
+                             << bsl::endl                                        // --
+                             << bsl::here();                                     // --
 
-        /// <!-- description -->
-        ///   @brief Sets the current root page table to this root page table.
-        ///
-        /// <!-- inputs/outputs -->
-        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
-        ///     and friends otherwise
-        ///
-        [[nodiscard]] constexpr auto
-        activate() const &noexcept -> bsl::errc_type
-        {
-            if (bsl::unlikely_assert(!m_initialized)) {
-                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
                 return bsl::errc_failure;
             }
 
-            m_intrinsic->set_cr3(m_pml4t_phys);
-            return bsl::errc_success;
+            if (bsl::unlikely_assert(!page_phys)) {
+                bsl::error() << "physical address is invalid: "    // --
+                             << bsl::hex(page_phys)                // --
+                             << bsl::endl                          // --
+                             << bsl::here();                       // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely_assert(!this->is_large_page_aligned(page_phys, page_size))) {
+                bsl::error() << "physical address is not large page aligned: "    // --
+                             << bsl::hex(page_phys)                               // --
+                             << bsl::endl                                         // --
+                             << bsl::here();                                      // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely_assert(!page_flags)) {
+                bsl::error() << "invalid flags: "       // --
+                             << bsl::hex(page_flags)    // --
+                             << bsl::endl               // --
+                             << bsl::here();            // --
+
+                return bsl::errc_failure;
+            }
+
+            if ((page_flags & MAP_PAGE_WRITE).is_pos()) {
+                if ((page_flags & MAP_PAGE_EXECUTE).is_pos()) {
+                    bsl::error() << "invalid page_flags: "    // --
+                                 << bsl::hex(page_flags)      // --
+                                 << bsl::endl                 // --
+                                 << bsl::here();              // --
+
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto *const pml4te{m_pml4t->entries.at_if(this->pml4to(page_virt))};
+            if (pml4te->p == bsl::ZERO_UMAX) {
+                if (bsl::unlikely(!this->add_pdpt(tls, pml4te))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+            else {
+                if (pml4te->us == bsl::ZERO_UMAX) {
+                    bsl::error() << "attempt to map the userspace address "              // --
+                                 << bsl::hex(page_virt)                                  // --
+                                 << " in an address range owned by the kernel failed"    // --
+                                 << bsl::endl                                            // --
+                                 << bsl::here();                                         // --
+
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+
+            auto *const pdpt{this->get_pdpt(pml4te)};
+            auto *const pdpte{pdpt->entries.at_if(this->pdpto(page_virt))};
+            if (page_size == MAP_PAGE_1G_SIZE) {
+                if (pdpte->p == bsl::ZERO_UMAX) {
+                    this->set_large_page(pdpte, page_phys, page_flags);
+                    return bsl::errc_success;
+                }
+
+                if (pdpte->ps != bsl::ZERO_UMAX) {
+                    return bsl::errc_already_exists;
+                }
+
+                return bsl::errc_precondition;
+            }
+
+            if (pdpte->p == bsl::ZERO_UMAX) {
+                if (bsl::unlikely(!this->add_pdt(tls, pdpte))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+            else {
+                if (pdpte->ps != bsl::ZERO_UMAX) {
+                    return bsl::errc_already_exists;
+                }
+
+                bsl::touch();
+            }
+
+            auto *const pdt{this->get_pdt(pdpte)};
+            auto *const pdte{pdt->entries.at_if(this->pdto(page_virt))};
+            if (pdte->p == bsl::ZERO_UMAX) {
+                this->set_large_page(pdte, page_phys, page_flags);
+                return bsl::errc_success;
+            }
+
+            if (pdte->ps != bsl::ZERO_UMAX) {
+                return bsl::errc_already_exists;
+            }
+
+            return bsl::errc_precondition;
         }
 
         /// <!-- description -->
-        ///   @brief Given a root page table, the pml4te_t enties are aliased
-        ///     into this page table, allowing software using this root page
-        ///     table to access the memory mapped into the provided root page
-        ///     table. The additions are aliases only, meaning when this root
-        ///     page table loses scope, aliased entries added by this function
-        ///     are not returned back to the page pool.
+        ///   @brief Allocates a page from the provided page pool and maps it
+        ///     into the root page table being managed by this class The page
+        ///     is marked as "auto release", meaning when this root page table
+        ///     is released, the pages allocated by this function will
+        ///     automatically be deallocated and put back into the provided
+        ///     page pool.
         ///
         /// <!-- inputs/outputs -->
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @param tls the current TLS block
-        ///   @param rpt the root page table to add aliases to
+        ///   @param page_virt the virtual address to map the allocated
+        ///     page to
+        ///   @param page_flags defines how memory should be mapped
+        ///   @param auto_release defines what auto release tag to use
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
         ///
         template<typename TLS_CONCEPT>
         [[nodiscard]] constexpr auto
-        add_tables(TLS_CONCEPT &tls, void const *const rpt) &noexcept -> bsl::errc_type
+        allocate_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_flags,
+            bsl::safe_int32 const &auto_release) &noexcept -> void *
         {
-            lock_guard lock{tls, m_lock};
+            bsl::errc_type ret{};
 
-            if (bsl::unlikely_assert(!m_initialized)) {
-                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
-                return bsl::errc_failure;
+            void *page{};
+            switch (auto_release.get()) {
+                case MAP_PAGE_AUTO_RELEASE_STACK.get(): {
+                    page = m_page_pool->template allocate<void>(tls, ALLOCATE_TAG_EXT_STACK);
+                    break;
+                }
+
+                case MAP_PAGE_AUTO_RELEASE_TLS.get(): {
+                    page = m_page_pool->template allocate<void>(tls, ALLOCATE_TAG_EXT_TLS);
+                    break;
+                }
+
+                case MAP_PAGE_AUTO_RELEASE_ELF.get(): {
+                    page = m_page_pool->template allocate<void>(tls, ALLOCATE_TAG_EXT_ELF);
+                    break;
+                }
+
+                default: {
+                    bsl::error() << "unknown tag\n" << bsl::here();
+                    break;
+                }
             }
 
-            auto const *const pml4t{static_cast<pml4t_t const *>(rpt)};
-            if (bsl::unlikely_assert(nullptr == pml4t)) {
-                bsl::error() << "invalid rpt\n" << bsl::here();
-                return bsl::errc_failure;
+            if (bsl::unlikely(nullptr == page)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return nullptr;
             }
 
-            for (auto const elem : pml4t->entries) {
-                if (elem.data->p != bsl::ZERO_UMAX) {
-                    auto *const pml4e_dst{m_pml4t->entries.at_if(elem.index)};
+            auto const page_phys{m_page_pool->virt_to_phys(page)};
+            if (bsl::unlikely_assert(!page_phys)) {
+                bsl::error() << "physical address is invalid: "    // --
+                             << bsl::hex(page_phys)                // --
+                             << bsl::endl                          // --
+                             << bsl::here();                       // --
 
-                    *pml4e_dst = *elem.data;
-                    pml4e_dst->alias = bsl::ONE_UMAX.get();
-                }
-                else {
-                    bsl::touch();
-                }
+                return nullptr;
             }
 
-            return bsl::errc_success;
+            ret = this->map_page(tls, page_virt, page_phys, page_flags, auto_release);
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return nullptr;
+            }
+
+            return page;
         }
 
         /// <!-- description -->
-        ///   @brief Given a root page table, the pml4te_t enties are aliased
-        ///     into this page table, allowing software using this root page
-        ///     table to access the memory mapped into the provided root page
-        ///     table. The additions are aliases only, meaning when this root
-        ///     page table loses scope, aliased entries added by this function
-        ///     are not returned back to the page pool.
+        ///   @brief Releases the memory allocated for tables
         ///
         /// <!-- inputs/outputs -->
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
         ///   @param tls the current TLS block
-        ///   @param rpt the root page table to add aliases to
-        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
-        ///     and friends otherwise
         ///
         template<typename TLS_CONCEPT>
-        [[nodiscard]] constexpr auto
-        add_tables(TLS_CONCEPT &tls, root_page_table_t const &rpt) &noexcept -> bsl::errc_type
+        constexpr void
+        release_tables(TLS_CONCEPT &tls) &noexcept
         {
-            return this->add_tables(tls, rpt.m_pml4t);
+            if (bsl::unlikely(nullptr == m_pml4t)) {
+                return;
+            }
+
+            if (bsl::unlikely(nullptr == m_page_pool)) {
+                return;
+            }
+
+            if (bsl::unlikely(nullptr == m_huge_pool)) {
+                return;
+            }
+
+            for (auto const elem : m_pml4t->entries) {
+                if (elem.data->p == bsl::ZERO_UMAX) {
+                    continue;
+                }
+
+                if (elem.data->alias != bsl::ZERO_UMAX) {
+                    continue;
+                }
+
+                this->remove_pdpt(tls, elem.data);
+            }
+
+            m_page_pool->deallocate(tls, m_pml4t, ALLOCATE_TAG_PML4TS);
+            m_pml4t = {};
+            m_pml4t_phys = bsl::safe_uintmax::zero(true);
         }
 
         /// <!-- description -->
         ///   @brief Maps a page into the root page table being managed
-        ///     by this class.
+        ///     by this class. The caller must hold m_lock.
         ///
         /// <!-- inputs/outputs -->
         ///   @tparam TLS_CONCEPT defines the type of TLS block to use
@@ -1207,15 +1508,13 @@ namespace mk
         ///
         template<typename TLS_CONCEPT>
         [[nodiscard]] constexpr auto
-        map_page(
+        map_page_unlocked(
             TLS_CONCEPT &tls,
             bsl::safe_uintmax const &page_virt,
             bsl::safe_uintmax const &page_phys,
             bsl::safe_uintmax const &page_flags,
             bsl::safe_int32 const &auto_release) &noexcept -> bsl::errc_type
         {
-            lock_guard lock{tls, m_lock};
-
             if (bsl::unlikely_assert(!m_initialized)) {
                 bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
                 return bsl::errc_failure;
@@ -1335,8 +1634,18 @@ namespace mk
                 bsl::touch();
             }
             else {
-                bsl::touch();
-            }
+                if (pdpte->ps != bsl::ZERO_UMAX) {
+                    if (bsl::unlikely(!this->split_pdpte(tls, page_virt, pdpte))) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return bsl::errc_failure;
+                    }
+
+                    bsl::touch();
+                }
+                else {
+                    bsl::touch();
+                }
+            }
 
             auto *const pdt{this->get_pdt(pdpte)};
             auto *const pdte{pdt->entries.at_if(this->pdto(page_virt))};
@@ -1349,11 +1658,48 @@ namespace mk
                 bsl::touch();
             }
             else {
-                bsl::touch();
+                if (pdte->ps != bsl::ZERO_UMAX) {
+                    if (bsl::unlikely(!this->split_pdte(tls, page_virt, pdte))) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return bsl::errc_failure;
+                    }
+
+                    bsl::touch();
+                }
+                else {
+                    bsl::touch();
+                }
             }
 
             auto *const pt{this->get_pt(pdte)};
             auto *const pte{pt->entries.at_if(this->pto(page_virt))};
+
+            /// NOTE:
+            /// - The pte might already be present and map the exact same
+            ///   memory that is being asked for. This happens when a large
+            ///   page of the direct map was split, either just now or by
+            ///   an earlier call (e.g., two alloc_page calls that land in
+            ///   the same 2M page of the direct map), or when the page was
+            ///   direct mapped on demand. In this case, the pte is replaced
+            ///   so that the requested permissions and auto release tag are
+            ///   used. Anything else is a real conflict.
+            ///
+
+            if (pte->p != bsl::ZERO_UMAX) {
+                bool const no_auto_release{pte->auto_release == MAP_PAGE_NO_AUTO_RELEASE.get()};
+
+                if (no_auto_release && (pte->phys == (page_phys >> PAGE_SHIFT).get())) {
+                    *pte = {};
+                    this->invalidate(page_virt);
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
             if (bsl::unlikely(pte->p != bsl::ZERO_UMAX)) {
                 bsl::error() << "virtual address "     // --
                              << bsl::hex(page_virt)    // --
@@ -1386,6 +1732,313 @@ namespace mk
             return bsl::errc_success;
         }
 
+    public:
+        /// @brief an alias for INTRINSIC_CONCEPT
+        using intrinsic_type = INTRINSIC_CONCEPT;
+        /// @brief an alias for PAGE_POOL_CONCEPT
+        using page_pool_type = PAGE_POOL_CONCEPT;
+        /// @brief an alias for HUGE_POOL_CONCEPT
+        using huge_pool_type = HUGE_POOL_CONCEPT;
+
+        /// <!-- description -->
+        ///   @brief Initializes this root_page_table_t
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param intrinsic the intrinsics to use
+        ///   @param page_pool the page pool to use
+        ///   @param huge_pool the huge pool to use
+        ///   @param pcid the PCID to tag this RPT's TLB entries with. If
+        ///     this is 0, or PCIDs are not enabled, CR3 is flushed each
+        ///     time this RPT is activated.
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        initialize(
+            TLS_CONCEPT &tls,
+            INTRINSIC_CONCEPT *const intrinsic,
+            PAGE_POOL_CONCEPT *const page_pool,
+            HUGE_POOL_CONCEPT *const huge_pool,
+            bsl::safe_uint16 const &pcid) &noexcept -> bsl::errc_type
+        {
+            if (bsl::unlikely_assert(m_initialized)) {
+                bsl::error() << "root_page_table_t already initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            bsl::finally release_on_error{[this, &tls]() noexcept -> void {
+                this->release(tls);
+            }};
+
+            m_intrinsic = intrinsic;
+            if (bsl::unlikely_assert(nullptr == intrinsic)) {
+                bsl::error() << "invalid intrinsic\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_page_pool = page_pool;
+            if (bsl::unlikely_assert(nullptr == page_pool)) {
+                bsl::error() << "invalid page_pool\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_huge_pool = huge_pool;
+            if (bsl::unlikely_assert(nullptr == huge_pool)) {
+                bsl::error() << "invalid huge_pool\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely_assert(!pcid)) {
+                bsl::error() << "invalid pcid\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_pml4t = m_page_pool->template allocate<pml4t_t>(tls, ALLOCATE_TAG_PML4TS);
+            if (bsl::unlikely(nullptr == m_pml4t)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_pml4t_phys = m_page_pool->virt_to_phys(m_pml4t);
+            if (bsl::unlikely_assert(!m_pml4t_phys)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            /// NOTE:
+            /// - When PCIDs are enabled, an RPT with a PCID of its own is
+            ///   activated using the no-flush bit, so that its TLB entries
+            ///   survive switching between RPTs. The loader only turns on
+            ///   CR4.PCIDE when INVPCID is supported, which is what is
+            ///   used to invalidate these entries when they change.
+            /// - PCIDs that do not fit in CR3 fall back to PCID 0, which
+            ///   is flushed on every switch just like without PCIDs.
+            ///
+
+            m_cr3 = m_pml4t_phys;
+            if ((m_intrinsic->cr4() & CR4_PCIDE).is_zero()) {
+                bsl::touch();
+            }
+            else {
+                if (pcid.is_zero() || pcid > PCID_MAX) {
+                    bsl::touch();
+                }
+                else {
+                    m_pcid = pcid;
+                    m_cr3 |= bsl::to_umax(m_pcid) | CR3_NOFLUSH;
+                }
+            }
+
+            release_on_error.ignore();
+            m_initialized = true;
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Releases all of the resources used by the RPT.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///
+        template<typename TLS_CONCEPT>
+        constexpr void
+        release(TLS_CONCEPT &tls) &noexcept
+        {
+            lock_guard lock{tls, m_lock};
+
+            this->release_tables(tls);
+
+            m_cr3 = bsl::safe_uintmax::zero(true);
+            m_pcid = {};
+            m_huge_pool = {};
+            m_page_pool = {};
+            m_intrinsic = {};
+            m_initialized = false;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if this RPT is initialized.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns true if this RPT is initialized.
+        ///
+        [[nodiscard]] constexpr auto
+        is_initialized() const &noexcept -> bool
+        {
+            return m_initialized;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the current root page table to this root page table.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        activate() const &noexcept -> bsl::errc_type
+        {
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_intrinsic->set_cr3(m_cr3);
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Given a root page table, the pml4te_t enties are aliased
+        ///     into this page table, allowing software using this root page
+        ///     table to access the memory mapped into the provided root page
+        ///     table. The additions are aliases only, meaning when this root
+        ///     page table loses scope, aliased entries added by this function
+        ///     are not returned back to the page pool.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param rpt the root page table to add aliases to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        add_tables(TLS_CONCEPT &tls, void const *const rpt) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto const *const pml4t{static_cast<pml4t_t const *>(rpt)};
+            if (bsl::unlikely_assert(nullptr == pml4t)) {
+                bsl::error() << "invalid rpt\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            for (auto const elem : pml4t->entries) {
+                if (elem.data->p != bsl::ZERO_UMAX) {
+                    auto *const pml4e_dst{m_pml4t->entries.at_if(elem.index)};
+
+                    *pml4e_dst = *elem.data;
+                    pml4e_dst->alias = bsl::ONE_UMAX.get();
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Given a root page table, the pml4te_t enties are aliased
+        ///     into this page table, allowing software using this root page
+        ///     table to access the memory mapped into the provided root page
+        ///     table. The additions are aliases only, meaning when this root
+        ///     page table loses scope, aliased entries added by this function
+        ///     are not returned back to the page pool.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param rpt the root page table to add aliases to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        add_tables(TLS_CONCEPT &tls, root_page_table_t const &rpt) &noexcept -> bsl::errc_type
+        {
+            return this->add_tables(tls, rpt.m_pml4t);
+        }
+
+        /// <!-- description -->
+        ///   @brief Maps a page into the root page table being managed
+        ///     by this class.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the virtual address to map the physical address
+        ///     too.
+        ///   @param page_phys the physical address to map.
+        ///   @param page_flags defines how memory should be mapped
+        ///   @param auto_release defines what auto release tag to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        map_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_uintmax const &page_flags,
+            bsl::safe_int32 const &auto_release) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            return this->map_page_unlocked(tls, page_virt, page_phys, page_flags, auto_release);
+        }
+
+        /// <!-- description -->
+        ///   @brief Maps each of the provided pages into the root page table
+        ///     being managed by this class. This is the same as calling
+        ///     map_page() for each page, but the lock is only taken once.
+        ///     Pages are mapped in order, and mapping stops at the first
+        ///     page that fails to map.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @tparam PAGE_CONCEPT defines the type of page to map, which
+        ///     must provide a virt and phys field.
+        ///   @param tls the current TLS block
+        ///   @param pages the pages to map
+        ///   @param page_flags defines how memory should be mapped
+        ///   @param auto_release defines what auto release tag to use
+        ///   @return Returns the number of pages that were mapped. If this
+        ///     is less than pages.size(), the page at the returned index
+        ///     failed to map, and the pages after it were not mapped.
+        ///
+        template<typename TLS_CONCEPT, typename PAGE_CONCEPT>
+        [[nodiscard]] constexpr auto
+        map_pages(
+            TLS_CONCEPT &tls,
+            bsl::span<PAGE_CONCEPT> const &pages,
+            bsl::safe_uintmax const &page_flags,
+            bsl::safe_int32 const &auto_release) &noexcept -> bsl::safe_uintmax
+        {
+            lock_guard lock{tls, m_lock};
+
+            bsl::safe_uintmax mapped{};
+            for (auto const elem : pages) {
+                auto const ret{this->map_page_unlocked(
+                    tls,
+                    bsl::to_umax(elem.data->virt),
+                    bsl::to_umax(elem.data->phys),
+                    page_flags,
+                    auto_release)};
+
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    break;
+                }
+
+                ++mapped;
+            }
+
+            return mapped;
+        }
+
         /// <!-- description -->
         ///   @brief Maps a page into the root page table being managed
         ///     by this class. This version allows for unaligned virtual and
@@ -1424,6 +2077,383 @@ namespace mk
                 auto_release);
         }
 
+        /// <!-- description -->
+        ///   @brief Maps a 2M page into the root page table being managed
+        ///     by this class. Large pages are never auto released, so this
+        ///     should only be used to map memory that is not owned by this
+        ///     RPT (e.g., the direct map). If a smaller page is later mapped
+        ///     into the same range using map_page(), the 2M page is split
+        ///     into 4k pages.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the 2M aligned virtual address to map the
+        ///     physical address too.
+        ///   @param page_phys the 2M aligned physical address to map.
+        ///   @param page_flags defines how memory should be mapped
+        ///   @return Returns bsl::errc_success on success. If the address is
+        ///     already covered by a large page, bsl::errc_already_exists is
+        ///     returned. If 4k pages have already been mapped into the
+        ///     address range, bsl::errc_precondition is returned, in which
+        ///     case the caller should fall back to map_page(). Returns
+        ///     bsl::errc_failure and friends otherwise.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        map_2m_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_uintmax const &page_flags) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+            return this->map_large_page(tls, page_virt, page_phys, page_flags, MAP_PAGE_2M_SIZE);
+        }
+
+        /// <!-- description -->
+        ///   @brief Maps a 1G page into the root page table being managed
+        ///     by this class. Large pages are never auto released, so this
+        ///     should only be used to map memory that is not owned by this
+        ///     RPT (e.g., the direct map). If a smaller page is later mapped
+        ///     into the same range, the 1G page is split into 2M pages.
+        ///     Note that not all CPUs support 1G pages, so it is up to the
+        ///     caller to make sure they are supported before calling this.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the 1G aligned virtual address to map the
+        ///     physical address too.
+        ///   @param page_phys the 1G aligned physical address to map.
+        ///   @param page_flags defines how memory should be mapped
+        ///   @return Returns bsl::errc_success on success. If the address is
+        ///     already covered by a 1G page, bsl::errc_already_exists is
+        ///     returned. If smaller pages have already been mapped into the
+        ///     address range, bsl::errc_precondition is returned, in which
+        ///     case the caller should fall back to map_2m_page(). Returns
+        ///     bsl::errc_failure and friends otherwise.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        map_1g_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_uintmax const &page_flags) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+            return this->map_large_page(tls, page_virt, page_phys, page_flags, MAP_PAGE_1G_SIZE);
+        }
+
+        /// <!-- description -->
+        ///   @brief Copies memory from an extension into the microkernel.
+        ///     The source must be mapped into this RPT as user memory, and
+        ///     this RPT must be the active RPT. m_lock is held during the
+        ///     copy so that the source cannot be unmapped by another PP
+        ///     while it is being read.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param dst the microkernel memory to copy to
+        ///   @param src_virt the extension's virtual address to copy from
+        ///   @param bytes the number of bytes to copy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        copy_from_user(
+            TLS_CONCEPT &tls,
+            void *const dst,
+            bsl::safe_uintmax const &src_virt,
+            bsl::safe_uintmax const &bytes) const &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!this->is_user_range(src_virt, bytes, false))) {
+                bsl::error() << "virtual address "                 // --
+                             << bsl::hex(src_virt)                 // --
+                             << " is not mapped as user memory"    // --
+                             << bsl::endl                          // --
+                             << bsl::here();                       // --
+
+                return bsl::errc_failure;
+            }
+
+            bsl::builtin_memcpy(dst, bsl::to_ptr<void const *>(src_virt), bytes);
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Copies memory from the microkernel into an extension.
+        ///     The destination must be mapped into this RPT as writable user
+        ///     memory, and this RPT must be the active RPT. m_lock is held
+        ///     during the copy so that the destination cannot be unmapped by
+        ///     another PP while it is being written.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param dst_virt the extension's virtual address to copy to
+        ///   @param src the microkernel memory to copy from
+        ///   @param bytes the number of bytes to copy
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        copy_to_user(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &dst_virt,
+            void const *const src,
+            bsl::safe_uintmax const &bytes) const &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(!this->is_user_range(dst_virt, bytes, true))) {
+                bsl::error() << "virtual address "                          // --
+                             << bsl::hex(dst_virt)                          // --
+                             << " is not mapped as writable user memory"    // --
+                             << bsl::endl                                   // --
+                             << bsl::here();                                // --
+
+                return bsl::errc_failure;
+            }
+
+            bsl::builtin_memcpy(bsl::to_ptr<void *>(dst_virt), src, bytes);
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided virtual address is mapped
+        ///     to the provided physical address as a 4k page using the
+        ///     provided auto release tag. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the virtual address to look up
+        ///   @param page_phys the physical address page_virt must map to
+        ///   @param auto_release the auto release tag the page must have
+        ///   @return Returns true if the provided virtual address is mapped
+        ///     to the provided physical address as a 4k page using the
+        ///     provided auto release tag. Returns false otherwise.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        is_mapped(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_uintmax const &page_phys,
+            bsl::safe_int32 const &auto_release) &noexcept -> bool
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return false;
+            }
+
+            if (bsl::unlikely(!page_virt || page_virt.is_zero())) {
+                return false;
+            }
+
+            if (bsl::unlikely(!page_phys || !this->is_page_aligned(page_phys))) {
+                return false;
+            }
+
+            if (bsl::unlikely(!this->is_page_aligned(page_virt))) {
+                return false;
+            }
+
+            auto const *const pml4te{m_pml4t->entries.at_if(this->pml4to(page_virt))};
+            if (pml4te->p == bsl::ZERO_UMAX) {
+                return false;
+            }
+
+            auto const *const pdpt{this->get_pdpt(pml4te)};
+            auto const *const pdpte{pdpt->entries.at_if(this->pdpto(page_virt))};
+            if ((pdpte->p == bsl::ZERO_UMAX) || (pdpte->ps != bsl::ZERO_UMAX)) {
+                return false;
+            }
+
+            auto const *const pdt{this->get_pdt(pdpte)};
+            auto const *const pdte{pdt->entries.at_if(this->pdto(page_virt))};
+            if ((pdte->p == bsl::ZERO_UMAX) || (pdte->ps != bsl::ZERO_UMAX)) {
+                return false;
+            }
+
+            auto const *const pt{this->get_pt(pdte)};
+            auto const *const pte{pt->entries.at_if(this->pto(page_virt))};
+            if (pte->p == bsl::ZERO_UMAX) {
+                return false;
+            }
+
+            if (pte->auto_release != auto_release.get()) {
+                return false;
+            }
+
+            return pte->phys == (page_phys >> PAGE_SHIFT).get();
+        }
+
+        /// <!-- description -->
+        ///   @brief Unmaps a page from the root page table being managed
+        ///     by this class. The page is only unmapped if it was mapped
+        ///     using the provided auto release tag. The page itself is not
+        ///     released as that is up to the caller, and only the TLB of
+        ///     the PP that calls this function is invalidated.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+        ///   @param tls the current TLS block
+        ///   @param page_virt the virtual address to unmap
+        ///   @param auto_release the auto release tag the page was mapped with
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise. If the page is not mapped,
+        ///     bsl::errc_precondition is returned without outputting an
+        ///     error. If the page was mapped with a different auto release
+        ///     tag, bsl::errc_failure is returned without outputting an
+        ///     error. If the page is part of a large page and
+        ///     MAP_PAGE_NO_AUTO_RELEASE is provided, the large page is split
+        ///     so that only the requested page is unmapped.
+        ///
+        template<typename TLS_CONCEPT>
+        [[nodiscard]] constexpr auto
+        unmap_page(
+            TLS_CONCEPT &tls,
+            bsl::safe_uintmax const &page_virt,
+            bsl::safe_int32 const &auto_release) &noexcept -> bsl::errc_type
+        {
+            lock_guard lock{tls, m_lock};
+
+            if (bsl::unlikely_assert(!m_initialized)) {
+                bsl::error() << "root_page_table_t not initialized\n" << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely_assert(page_virt.is_zero())) {
+                bsl::error() << "virtual address is invalid: "    // --
+                             << bsl::hex(page_virt)               // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely_assert(!this->is_page_aligned(page_virt))) {
+                bsl::error() << "virtual address is not page aligned: "    // --
+                             << bsl::hex(page_virt)                        // --
+                             << bsl::endl                                  // --
+                             << bsl::here();                               // --
+
+                return bsl::errc_failure;
+            }
+
+            auto *const pml4te{m_pml4t->entries.at_if(this->pml4to(page_virt))};
+            if (pml4te->p == bsl::ZERO_UMAX) {
+                return bsl::errc_precondition;
+            }
+
+            /// NOTE:
+            /// - Aliased entries are owned by another root page table, so
+            ///   they have to be unmapped using that root page table. The
+            ///   same is true for any memory owned by the microkernel.
+            ///
+
+            if (pml4te->alias != bsl::ZERO_UMAX) {
+                bsl::error() << "attempt to unmap the aliased address "    // --
+                             << bsl::hex(page_virt)                        // --
+                             << " failed"                                  // --
+                             << bsl::endl                                  // --
+                             << bsl::here();                               // --
+
+                return bsl::errc_failure;
+            }
+
+            if (pml4te->us == bsl::ZERO_UMAX) {
+                bsl::error() << "attempt to unmap the userspace address "            // --
+                             << bsl::hex(page_virt)                                  // --
+                             << " in an address range owned by the kernel failed"    // --
+                             << bsl::endl                                            // --
+                             << bsl::here();                                         // --
+
+                return bsl::errc_failure;
+            }
+
+            auto *const pdpt{this->get_pdpt(pml4te)};
+            auto *const pdpte{pdpt->entries.at_if(this->pdpto(page_virt))};
+            if (pdpte->p == bsl::ZERO_UMAX) {
+                return bsl::errc_precondition;
+            }
+
+            /// NOTE:
+            /// - Large pages are only ever mapped without an auto release
+            ///   tag (e.g., the direct map of a VM other than VM 0), so
+            ///   they are only split if that is what the caller asked for.
+            ///   Otherwise, the page cannot have been mapped with the
+            ///   provided tag.
+            ///
+
+            if (pdpte->ps != bsl::ZERO_UMAX) {
+                if (auto_release != MAP_PAGE_NO_AUTO_RELEASE) {
+                    return bsl::errc_failure;
+                }
+
+                if (bsl::unlikely(!this->split_pdpte(tls, page_virt, pdpte))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+
+            auto *const pdt{this->get_pdt(pdpte)};
+            auto *const pdte{pdt->entries.at_if(this->pdto(page_virt))};
+            if (pdte->p == bsl::ZERO_UMAX) {
+                return bsl::errc_precondition;
+            }
+
+            if (pdte->ps != bsl::ZERO_UMAX) {
+                if (auto_release != MAP_PAGE_NO_AUTO_RELEASE) {
+                    return bsl::errc_failure;
+                }
+
+                if (bsl::unlikely(!this->split_pdte(tls, page_virt, pdte))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+
+            auto *const pt{this->get_pt(pdte)};
+            auto *const pte{pt->entries.at_if(this->pto(page_virt))};
+            if (pte->p == bsl::ZERO_UMAX) {
+                return bsl::errc_precondition;
+            }
+
+            if (pte->auto_release != auto_release.get()) {
+                return bsl::errc_failure;
+            }
+
+            *pte = {};
+            this->invalidate(page_virt);
+
+            return bsl::errc_success;
+        }
+
         /// <!-- description -->
         ///   @brief Allocates a page from the provided page pool and maps it
         ///     into the root page table being managed by this class The page
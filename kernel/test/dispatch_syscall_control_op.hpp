@@ -33,19 +33,27 @@
 namespace mk
 {
     /// <!-- description -->
-    ///   @brief Dispatches the bf_callback_op syscalls
+    ///   @brief Dispatches the bf_control_op syscalls
     ///
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
+    ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
     ///   @param tls the current TLS block
+    ///   @param ext the extension that made the syscall
+    ///   @param trace the trace to use
     ///   @return Returns syscall::BF_STATUS_SUCCESS on success or an error
     ///     code on failure.
     ///
-    template<typename TLS_CONCEPT>
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename TRACE_CONCEPT>
     [[nodiscard]] constexpr auto
-    dispatch_syscall_control_op(TLS_CONCEPT &tls) noexcept -> bsl::errc_type
+    dispatch_syscall_control_op(TLS_CONCEPT &tls, EXT_CONCEPT &ext, TRACE_CONCEPT &trace) noexcept
+        -> bsl::errc_type
     {
         bsl::discard(tls);
+        bsl::discard(ext);
+        bsl::discard(trace);
+
         return bsl::errc_success;
     }
 }
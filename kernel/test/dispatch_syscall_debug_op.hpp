@@ -37,32 +37,67 @@ namespace mk
     ///
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
-    ///   @tparam VM_POOL_CONCEPT defines the type of VM pool to use
-    ///   @tparam VP_POOL_CONCEPT defines the type of VP pool to use
+    ///   @tparam EXT_POOL_CONCEPT defines the type of ext_pool_t to use
+    ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+    ///   @tparam PAGE_POOL_CONCEPT defines the type of page pool to use
+    ///   @tparam HUGE_POOL_CONCEPT defines the type of huge pool to use
     ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
+    ///   @tparam VP_POOL_CONCEPT defines the type of VP pool to use
+    ///   @tparam VM_POOL_CONCEPT defines the type of VM pool to use
+    ///   @tparam VMEXIT_LOG_CONCEPT defines the type of VMExit log to use
+    ///   @tparam VMEXIT_STATS_CONCEPT defines the type of VMExit stats to use
+    ///   @tparam TRACE_CONCEPT defines the type of trace to use
     ///   @param tls the current TLS block
-    ///   @param vm_pool the VM pool to use
-    ///   @param vp_pool the VP pool to use
+    ///   @param ext_pool the extension pool to use
+    ///   @param intrinsic the intrinsics to use
+    ///   @param page_pool the page pool to use
+    ///   @param huge_pool the huge pool to use
     ///   @param vps_pool the VPS pool to use
+    ///   @param vp_pool the VP pool to use
+    ///   @param vm_pool the VM pool to use
+    ///   @param log the VMExit log to use
+    ///   @param stats the VMExit stats to use
+    ///   @param trace the trace to use
     ///   @return Returns syscall::BF_STATUS_SUCCESS on success or an error
     ///     code on failure.
     ///
     template<
         typename TLS_CONCEPT,
-        typename VM_POOL_CONCEPT,
+        typename EXT_POOL_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename PAGE_POOL_CONCEPT,
+        typename HUGE_POOL_CONCEPT,
+        typename VPS_POOL_CONCEPT,
         typename VP_POOL_CONCEPT,
-        typename VPS_POOL_CONCEPT>
+        typename VM_POOL_CONCEPT,
+        typename VMEXIT_LOG_CONCEPT,
+        typename VMEXIT_STATS_CONCEPT,
+        typename TRACE_CONCEPT>
     [[nodiscard]] constexpr auto
     dispatch_syscall_debug_op(
         TLS_CONCEPT &tls,
-        VM_POOL_CONCEPT &vm_pool,
+        EXT_POOL_CONCEPT &ext_pool,
+        INTRINSIC_CONCEPT &intrinsic,
+        PAGE_POOL_CONCEPT &page_pool,
+        HUGE_POOL_CONCEPT &huge_pool,
+        VPS_POOL_CONCEPT &vps_pool,
         VP_POOL_CONCEPT &vp_pool,
-        VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
+        VM_POOL_CONCEPT &vm_pool,
+        VMEXIT_LOG_CONCEPT &log,
+        VMEXIT_STATS_CONCEPT &stats,
+        TRACE_CONCEPT &trace) noexcept -> bsl::errc_type
     {
         bsl::discard(tls);
-        bsl::discard(vm_pool);
-        bsl::discard(vp_pool);
+        bsl::discard(ext_pool);
+        bsl::discard(intrinsic);
+        bsl::discard(page_pool);
+        bsl::discard(huge_pool);
         bsl::discard(vps_pool);
+        bsl::discard(vp_pool);
+        bsl::discard(vm_pool);
+        bsl::discard(log);
+        bsl::discard(stats);
+        bsl::discard(trace);
 
         return bsl::errc_success;
     }
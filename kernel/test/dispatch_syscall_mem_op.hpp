@@ -38,17 +38,21 @@ namespace mk
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
     ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @param tls the current TLS block
     ///   @param ext the extension that made the syscall
+    ///   @param vps_pool the VPS pool to use
     ///   @return Returns syscall::BF_STATUS_SUCCESS on success or an error
     ///     code on failure.
     ///
-    template<typename TLS_CONCEPT, typename EXT_CONCEPT>
+    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename VPS_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
-    dispatch_syscall_mem_op(TLS_CONCEPT &tls, EXT_CONCEPT &ext) noexcept -> bsl::errc_type
+    dispatch_syscall_mem_op(
+        TLS_CONCEPT &tls, EXT_CONCEPT &ext, VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
         bsl::discard(tls);
         bsl::discard(ext);
+        bsl::discard(vps_pool);
 
         return bsl::errc_success;
     }
@@ -40,10 +40,12 @@ namespace mk
     ///   @tparam EXT_POOL_CONCEPT defines the type of ext_pool_t to use
     ///   @tparam EXT_CONCEPT defines the type of ext_t to use
     ///   @tparam VM_POOL_CONCEPT defines the type of VM pool to use
+    ///   @tparam VP_POOL_CONCEPT defines the type of VP pool to use
     ///   @param tls the current TLS block
     ///   @param ext_pool the extension pool to use
     ///   @param ext the extension that made the syscall
     ///   @param vm_pool the VM pool to use
+    ///   @param vp_pool the VP pool to use
     ///   @return Returns syscall::BF_STATUS_SUCCESS on success or an error
     ///     code on failure.
     ///
@@ -51,18 +53,21 @@ namespace mk
         typename TLS_CONCEPT,
         typename EXT_POOL_CONCEPT,
         typename EXT_CONCEPT,
-        typename VM_POOL_CONCEPT>
+        typename VM_POOL_CONCEPT,
+        typename VP_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
     dispatch_syscall_vm_op(
         TLS_CONCEPT &tls,
         EXT_POOL_CONCEPT &ext_pool,
         EXT_CONCEPT const &ext,
-        VM_POOL_CONCEPT &vm_pool) noexcept -> bsl::errc_type
+        VM_POOL_CONCEPT &vm_pool,
+        VP_POOL_CONCEPT &vp_pool) noexcept -> bsl::errc_type
     {
         bsl::discard(tls);
         bsl::discard(ext_pool);
         bsl::discard(ext);
         bsl::discard(vm_pool);
+        bsl::discard(vp_pool);
 
         return bsl::errc_success;
     }
@@ -38,22 +38,36 @@ namespace mk
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
     ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam VM_POOL_CONCEPT defines the type of VM pool to use
     ///   @tparam VP_POOL_CONCEPT defines the type of VP pool to use
+    ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @param tls the current TLS block
     ///   @param ext the extension that made the syscall
+    ///   @param vm_pool the VM pool to use
     ///   @param vp_pool the VP pool to use
+    ///   @param vps_pool the VPS pool to use
     ///   @return Returns syscall::BF_STATUS_SUCCESS on success or an error
     ///     code on failure.
     ///
-    template<typename TLS_CONCEPT, typename EXT_CONCEPT, typename VP_POOL_CONCEPT>
+    template<
+        typename TLS_CONCEPT,
+        typename EXT_CONCEPT,
+        typename VM_POOL_CONCEPT,
+        typename VP_POOL_CONCEPT,
+        typename VPS_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
     dispatch_syscall_vp_op(
-        TLS_CONCEPT &tls, EXT_CONCEPT const &ext, VP_POOL_CONCEPT &vp_pool) noexcept
-        -> bsl::errc_type
+        TLS_CONCEPT &tls,
+        EXT_CONCEPT const &ext,
+        VM_POOL_CONCEPT &vm_pool,
+        VP_POOL_CONCEPT &vp_pool,
+        VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
         bsl::discard(tls);
         bsl::discard(ext);
+        bsl::discard(vm_pool);
         bsl::discard(vp_pool);
+        bsl::discard(vps_pool);
 
         return bsl::errc_success;
     }
@@ -37,14 +37,16 @@ namespace mk
     ///
     /// <!-- inputs/outputs -->
     ///   @tparam TLS_CONCEPT defines the type of TLS block to use
-    ///   @tparam EXT_POOL_CONCEPT defines the type of ext_pool_t to use
     ///   @tparam EXT_CONCEPT defines the type of ext_t to use
+    ///   @tparam INTRINSIC_CONCEPT defines the type of intrinsics to use
+    ///   @tparam PAGE_POOL_CONCEPT defines the type of page pool to use
     ///   @tparam VM_POOL_CONCEPT defines the type of VM pool to use
     ///   @tparam VP_POOL_CONCEPT defines the type of VP pool to use
     ///   @tparam VPS_POOL_CONCEPT defines the type of VPS pool to use
     ///   @param tls the current TLS block
-    ///   @param ext_pool the extension pool to use
     ///   @param ext the extension that made the syscall
+    ///   @param intrinsic the intrinsics to use
+    ///   @param page_pool the page pool to use
     ///   @param vm_pool the VM pool to use
     ///   @param vp_pool the VP pool to use
     ///   @param vps_pool the VPS pool to use
@@ -53,23 +55,26 @@ namespace mk
     ///
     template<
         typename TLS_CONCEPT,
-        typename EXT_POOL_CONCEPT,
         typename EXT_CONCEPT,
+        typename INTRINSIC_CONCEPT,
+        typename PAGE_POOL_CONCEPT,
         typename VM_POOL_CONCEPT,
         typename VP_POOL_CONCEPT,
         typename VPS_POOL_CONCEPT>
     [[nodiscard]] constexpr auto
     dispatch_syscall_vps_op(
         TLS_CONCEPT &tls,
-        EXT_POOL_CONCEPT &ext_pool,
         EXT_CONCEPT &ext,
+        INTRINSIC_CONCEPT &intrinsic,
+        PAGE_POOL_CONCEPT &page_pool,
         VM_POOL_CONCEPT &vm_pool,
         VP_POOL_CONCEPT &vp_pool,
         VPS_POOL_CONCEPT &vps_pool) noexcept -> bsl::errc_type
     {
         bsl::discard(tls);
-        bsl::discard(ext_pool);
         bsl::discard(ext);
+        bsl::discard(intrinsic);
+        bsl::discard(page_pool);
         bsl::discard(vm_pool);
         bsl::discard(vp_pool);
         bsl::discard(vps_pool);
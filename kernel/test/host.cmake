@@ -0,0 +1,103 @@
+#
+# Copyright (C) 2020 Assured Information Security, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Defines the includes and definitions needed to compile the microkernel's
+# code on the host against the mocks in this directory. This is shared by the
+# unit tests and the benchmarks in kernel/bench.
+#
+
+# ------------------------------------------------------------------------------
+# Includes
+# ------------------------------------------------------------------------------
+
+list(APPEND INCLUDES
+    ${CMAKE_CURRENT_LIST_DIR}/.
+    ${CMAKE_CURRENT_LIST_DIR}/../include
+    ${CMAKE_CURRENT_LIST_DIR}/../../syscall/include/cpp
+)
+
+list(APPEND SYSTEM_INCLUDES
+    ${CMAKE_CURRENT_LIST_DIR}/../../loader/include/interface/cpp
+    ${CMAKE_CURRENT_LIST_DIR}/../../loader/include/interface/cpp/bfelf
+)
+
+if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STREQUAL "GenuineIntel")
+    list(APPEND INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../include/x64)
+    list(APPEND SYSTEM_INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../../loader/include/interface/cpp/x64)
+
+    if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD")
+        list(APPEND INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../include/x64/amd)
+        list(APPEND SYSTEM_INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../../loader/include/interface/cpp/x64/amd)
+    endif()
+
+    if(HYPERVISOR_TARGET_ARCH STREQUAL "GenuineIntel")
+        list(APPEND INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../include/x64/intel)
+        list(APPEND SYSTEM_INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../../loader/include/interface/cpp/x64/intel)
+    endif()
+endif()
+
+if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
+    list(APPEND INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../include/arm)
+    list(APPEND SYSTEM_INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../../loader/include/interface/cpp/arm)
+
+    if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
+        list(APPEND INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../include/arm/aarch64)
+        list(APPEND SYSTEM_INCLUDES ${CMAKE_CURRENT_LIST_DIR}/../../loader/include/interface/cpp/arm/aarch64)
+    endif()
+endif()
+
+# ------------------------------------------------------------------------------
+# Default Definitions
+# ------------------------------------------------------------------------------
+
+list(APPEND DEFINES
+    HYPERVISOR_DEBUG_RING_SIZE=0x7FF0
+)
+
+if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD")
+    list(APPEND DEFINES
+        HYPERVISOR_X64=true
+        HYPERVISOR_AMD=true
+        HYPERVISOR_INTEL=false
+        HYPERVISOR_ARM=false
+        HYPERVISOR_AARCH64=false
+    )
+endif()
+
+if(HYPERVISOR_TARGET_ARCH STREQUAL "GenuineIntel")
+    list(APPEND DEFINES
+        HYPERVISOR_X64=true
+        HYPERVISOR_AMD=false
+        HYPERVISOR_INTEL=true
+        HYPERVISOR_ARM=false
+        HYPERVISOR_AARCH64=false
+    )
+endif()
+
+if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
+    list(APPEND DEFINES
+        HYPERVISOR_X64=false
+        HYPERVISOR_AMD=false
+        HYPERVISOR_INTEL=false
+        HYPERVISOR_ARM=true
+        HYPERVISOR_AARCH64=true
+    )
+endif()
@@ -22,24 +22,356 @@
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
 
+#include "../../src/huge_pool_segment_t.hpp"
 #include "../../src/huge_pool_t.hpp"
 
+#include <bsl/array.hpp>
+#include <bsl/byte.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
 #include <bsl/ut.hpp>
 
-namespace
+namespace mk
 {
+    /// @brief defines the size of a page used in testing
+    constexpr bsl::safe_uintmax TEST_PAGE_SIZE{bsl::to_umax(0x1000)};
+    /// @brief defines the number of pages the segment hands out in testing
+    constexpr bsl::safe_uintmax TEST_USABLE_PAGES{bsl::to_umax(16)};
+    /// @brief defines the number of pages given to the segment in testing
+    ///   (the last page holds the metadata for the other 16)
+    constexpr bsl::safe_uintmax TEST_TOTAL_PAGES{bsl::to_umax(17)};
+    /// @brief defines the largest order the segment has in testing
+    constexpr bsl::safe_uintmax TEST_MAX_ORDER{bsl::to_umax(4)};
+    /// @brief defines the NUMA node used in testing
+    constexpr bsl::safe_uint16 TEST_NODE{bsl::to_u16(0)};
+
+    /// @brief defines the huge_pool_segment_t used in testing
+    using test_segment_t = huge_pool_segment_t<TEST_PAGE_SIZE.get()>;
+
+    /// @brief stores the memory given to the segment in testing
+    alignas(TEST_PAGE_SIZE.get())
+        bsl::array<bsl::byte, (TEST_PAGE_SIZE * TEST_TOTAL_PAGES).get()> g_pool{};
+
     /// <!-- description -->
-    ///   @brief Used to execute the actual checks. We put the checks in this
-    ///     function so that we can validate the tests both at compile-time
-    ///     and at run-time. If a bsl::ut_check fails, the tests will either
-    ///     fail fast at run-time, or will produce a compile-time error.
+    ///   @brief Returns a pointer to the provided page in g_pool
     ///
     /// <!-- inputs/outputs -->
-    ///   @return Always returns bsl::exit_success.
+    ///   @param idx the index of the page to return
+    ///   @return Returns a pointer to the provided page in g_pool
+    ///
+    [[nodiscard]] auto
+    page(bsl::safe_uintmax const &idx) noexcept -> void *
+    {
+        return g_pool.at_if(idx * TEST_PAGE_SIZE);
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the number of bytes in the provided number of
+    ///     pages.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pages the number of pages
+    ///   @return Returns the number of bytes in the provided number of
+    ///     pages.
     ///
     [[nodiscard]] constexpr auto
+    bytes(bsl::safe_uintmax const &pages) noexcept -> bsl::safe_uintmax
+    {
+        return pages * TEST_PAGE_SIZE;
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the number of free blocks of the provided order
+    ///     in the provided segment.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param seg the segment to query
+    ///   @param order the order of the blocks to count
+    ///   @return Returns the number of free blocks of the provided order
+    ///     in the provided segment.
+    ///
+    [[nodiscard]] auto
+    free_blocks(test_segment_t const &seg, bsl::safe_uintmax const &order) noexcept
+        -> bsl::safe_uintmax
+    {
+        bsl::array<bsl::safe_uintmax, HUGE_POOL_MAX_ORDERS.get()> blks{};
+        bsl::discard(seg.free_blocks(blks));
+
+        return *blks.at_if(order);
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the size of the largest free block in the
+    ///     provided segment in bytes.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param seg the segment to query
+    ///   @return Returns the size of the largest free block in the
+    ///     provided segment in bytes.
+    ///
+    [[nodiscard]] auto
+    largest_free(test_segment_t const &seg) noexcept -> bsl::safe_uintmax
+    {
+        bsl::array<bsl::safe_uintmax, HUGE_POOL_MAX_ORDERS.get()> blks{};
+        return seg.free_blocks(blks);
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns true if the provided segment is back to a single
+    ///     free block of the max order (i.e., nothing is allocated and
+    ///     every block has been merged back together).
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param seg the segment to query
+    ///   @return Returns true if the provided segment is back to a single
+    ///     free block of the max order.
+    ///
+    [[nodiscard]] auto
+    fully_merged(test_segment_t const &seg) noexcept -> bool
+    {
+        for (bsl::safe_uintmax ord{}; ord < TEST_MAX_ORDER; ++ord) {
+            if (!free_blocks(seg, ord).is_zero()) {
+                return false;
+            }
+        }
+
+        if (free_blocks(seg, TEST_MAX_ORDER) != bsl::ONE_UMAX) {
+            return false;
+        }
+
+        return seg.used().is_zero() && seg.requested().is_zero();
+    }
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. Unlike most of the
+    ///     tests, these checks cannot be validated at compile-time as the
+    ///     segment stores its metadata inside of the memory that it is
+    ///     given, which requires casts that are not allowed in a constant
+    ///     expression.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] auto
     tests() noexcept -> bsl::exit_code
     {
+        bsl::span<bsl::byte> const pool{g_pool.data(), g_pool.size()};
+
+        bsl::ut_scenario{"initialize with a pool that is too small"} = []() {
+            bsl::ut_given{} = []() {
+                test_segment_t seg{};
+                bsl::span<bsl::byte> const small{g_pool.data(), TEST_PAGE_SIZE};
+                bsl::ut_then{} = [&seg, &small]() {
+                    bsl::ut_check(!seg.initialize(small, TEST_NODE));
+                    bsl::ut_check(seg.empty());
+                };
+            };
+        };
+
+        bsl::ut_scenario{"initialize creates a single max order block"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_when{} = [&seg, &pool]() {
+                    bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+                    bsl::ut_then{} = [&seg]() {
+                        bsl::ut_check(seg.total() == bytes(TEST_USABLE_PAGES));
+                        bsl::ut_check(largest_free(seg) == bytes(TEST_USABLE_PAGES));
+                        bsl::ut_check(fully_merged(seg));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"allocate at each order"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_then{} = [&seg, &pool]() {
+                    for (bsl::safe_uintmax ord{}; ord <= TEST_MAX_ORDER; ++ord) {
+                        auto const pgs{bsl::ONE_UMAX << ord};
+                        bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+
+                        auto *const ptr{seg.allocate(pgs)};
+                        bsl::ut_check(page(bsl::ZERO_UMAX) == ptr);
+                        bsl::ut_check(seg.used() == bytes(pgs));
+                        bsl::ut_check(seg.requested() == bytes(pgs));
+                        bsl::ut_check(seg.size(ptr) == bytes(pgs));
+
+                        for (bsl::safe_uintmax o{ord}; o < TEST_MAX_ORDER; ++o) {
+                            bsl::ut_check(free_blocks(seg, o) == bsl::ONE_UMAX);
+                        }
+
+                        seg.release();
+                    }
+                };
+            };
+        };
+
+        bsl::ut_scenario{"allocate rounds up to the next order"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_when{} = [&seg, &pool]() {
+                    bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+                    bsl::ut_then{} = [&seg]() {
+                        auto *const ptr{seg.allocate(bsl::to_umax(3))};
+                        bsl::ut_check(page(bsl::ZERO_UMAX) == ptr);
+                        bsl::ut_check(seg.used() == bytes(bsl::to_umax(4)));
+                        bsl::ut_check(seg.requested() == bytes(bsl::to_umax(3)));
+                        bsl::ut_check(seg.size(ptr) == bytes(bsl::to_umax(3)));
+
+                        bsl::ut_check(page(bsl::to_umax(4)) == seg.allocate(bsl::ONE_UMAX));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"freed buddies are merged"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_when{} = [&seg, &pool]() {
+                    bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+                    bsl::ut_then{} = [&seg]() {
+                        auto *const pg0{seg.allocate(bsl::ONE_UMAX)};
+                        auto *const pg1{seg.allocate(bsl::ONE_UMAX)};
+                        bsl::ut_check(page(bsl::ZERO_UMAX) == pg0);
+                        bsl::ut_check(page(bsl::ONE_UMAX) == pg1);
+                        bsl::ut_check(free_blocks(seg, bsl::ZERO_UMAX).is_zero());
+
+                        seg.deallocate(pg0);
+                        bsl::ut_check(free_blocks(seg, bsl::ZERO_UMAX) == bsl::ONE_UMAX);
+                        bsl::ut_check(largest_free(seg) == bytes(bsl::to_umax(8)));
+
+                        seg.deallocate(pg1);
+                        bsl::ut_check(largest_free(seg) == bytes(TEST_USABLE_PAGES));
+                        bsl::ut_check(fully_merged(seg));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"a block is merged once all of its pages are freed"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_when{} = [&seg, &pool]() {
+                    bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+                    bsl::ut_then{} = [&seg]() {
+                        bsl::ut_check(page(bsl::ZERO_UMAX) == seg.allocate(bsl::to_umax(2)));
+
+                        seg.deallocate(page(bsl::ONE_UMAX));
+                        bsl::ut_check(seg.used() == bytes(bsl::to_umax(2)));
+                        bsl::ut_check(seg.requested() == bytes(bsl::ONE_UMAX));
+                        bsl::ut_check(!fully_merged(seg));
+
+                        seg.deallocate(page(bsl::ZERO_UMAX));
+                        bsl::ut_check(fully_merged(seg));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"fragmentation recovers to a max order block"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_when{} = [&seg, &pool]() {
+                    bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+                    bsl::ut_then{} = [&seg]() {
+                        for (bsl::safe_uintmax i{}; i < TEST_USABLE_PAGES; ++i) {
+                            bsl::ut_check(page(i) == seg.allocate(bsl::ONE_UMAX));
+                        }
+
+                        bsl::ut_check(largest_free(seg).is_zero());
+
+                        for (bsl::safe_uintmax i{}; i < TEST_USABLE_PAGES; i += bsl::to_umax(2)) {
+                            seg.deallocate(page(i));
+                        }
+
+                        bsl::ut_check(free_blocks(seg, bsl::ZERO_UMAX) == bsl::to_umax(8));
+                        bsl::ut_check(largest_free(seg) == bytes(bsl::ONE_UMAX));
+                        bsl::ut_check(nullptr == seg.allocate(bsl::to_umax(2)));
+
+                        for (bsl::safe_uintmax i{bsl::ONE_UMAX}; i < TEST_USABLE_PAGES;
+                             i += bsl::to_umax(2)) {
+                            seg.deallocate(page(i));
+                        }
+
+                        bsl::ut_check(fully_merged(seg));
+                        bsl::ut_check(page(bsl::ZERO_UMAX) == seg.allocate(TEST_USABLE_PAGES));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"a misaligned free is rejected"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_when{} = [&seg, &pool]() {
+                    bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+                    bsl::ut_then{} = [&seg]() {
+                        bsl::ut_check(page(bsl::ZERO_UMAX) == seg.allocate(bsl::ONE_UMAX));
+
+                        seg.deallocate(g_pool.at_if(bsl::ONE_UMAX));
+                        bsl::ut_check(seg.used() == bytes(bsl::ONE_UMAX));
+                        bsl::ut_check(seg.requested() == bytes(bsl::ONE_UMAX));
+
+                        seg.deallocate(page(TEST_USABLE_PAGES));
+                        bsl::ut_check(seg.used() == bytes(bsl::ONE_UMAX));
+                        bsl::ut_check(seg.requested() == bytes(bsl::ONE_UMAX));
+
+                        seg.deallocate(page(bsl::ZERO_UMAX));
+                        bsl::ut_check(fully_merged(seg));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"a double free is rejected"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_when{} = [&seg, &pool]() {
+                    bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+                    bsl::ut_then{} = [&seg]() {
+                        auto *const pg0{seg.allocate(bsl::ONE_UMAX)};
+                        auto *const pg1{seg.allocate(bsl::ONE_UMAX)};
+
+                        seg.deallocate(pg0);
+                        seg.deallocate(pg0);
+                        bsl::ut_check(seg.used() == bytes(bsl::ONE_UMAX));
+                        bsl::ut_check(seg.requested() == bytes(bsl::ONE_UMAX));
+                        bsl::ut_check(free_blocks(seg, bsl::ZERO_UMAX) == bsl::ONE_UMAX);
+
+                        seg.deallocate(pg1);
+                        bsl::ut_check(fully_merged(seg));
+
+                        seg.deallocate(pg1);
+                        bsl::ut_check(fully_merged(seg));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"out of memory at the requested order"} = [&pool]() {
+            bsl::ut_given{} = [&pool]() {
+                test_segment_t seg{};
+                bsl::ut_when{} = [&seg, &pool]() {
+                    bsl::ut_required_step(seg.initialize(pool, TEST_NODE));
+                    bsl::ut_then{} = [&seg]() {
+                        bsl::ut_check(nullptr == seg.allocate(TEST_TOTAL_PAGES));
+
+                        bsl::ut_check(page(bsl::ZERO_UMAX) == seg.allocate(bsl::to_umax(4)));
+                        bsl::ut_check(nullptr == seg.allocate(TEST_USABLE_PAGES));
+
+                        bsl::ut_check(page(bsl::to_umax(8)) == seg.allocate(bsl::to_umax(8)));
+                        bsl::ut_check(nullptr == seg.allocate(bsl::to_umax(8)));
+                        bsl::ut_check(nullptr == seg.allocate(bsl::to_umax(5)));
+
+                        bsl::ut_check(page(bsl::to_umax(4)) == seg.allocate(bsl::to_umax(4)));
+                        bsl::ut_check(nullptr == seg.allocate(bsl::ONE_UMAX));
+                    };
+                };
+            };
+        };
+
         return bsl::ut_success();
     }
 }
@@ -56,7 +388,5 @@ namespace
 main() noexcept -> bsl::exit_code
 {
     bsl::enable_color();
-
-    static_assert(tests() == bsl::ut_success());
-    return tests();
+    return mk::tests();
 }
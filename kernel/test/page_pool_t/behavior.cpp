@@ -24,22 +24,389 @@
 
 #include "../../src/page_pool_t.hpp"
 
+#include <donate_pages_t.hpp>
+#include <tls_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/byte.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/string_view.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/ut.hpp>
 
-namespace
+namespace mk
 {
+    /// @brief defines the size of a page used in testing
+    constexpr bsl::safe_uintmax TEST_PAGE_SIZE{bsl::to_umax(0x1000)};
+    /// @brief defines the max number of pages given to the page pool in testing
+    constexpr bsl::safe_uintmax TEST_MAX_PAGES{bsl::to_umax(128)};
+    /// @brief defines the max number of PPs used in testing
+    constexpr bsl::safe_uintmax TEST_MAX_PPS{bsl::to_umax(2)};
+    /// @brief defines the max number of NUMA nodes used in testing
+    constexpr bsl::safe_uintmax TEST_MAX_NUMA_NODES{bsl::to_umax(1)};
+
+    /// @brief defines PPID0
+    constexpr bsl::safe_uint16 PPID0{bsl::to_u16(0)};
+    /// @brief defines PPID1
+    constexpr bsl::safe_uint16 PPID1{bsl::to_u16(1)};
+    /// @brief defines an invalid PPID
+    constexpr bsl::safe_uint16 PPID_INVALID{bsl::to_u16(2)};
+
+    /// @brief defines the tag used in testing
+    constexpr bsl::string_view TEST_TAG{"test"};
+
+    /// @brief defines the page_pool_t used in testing (with a base of 0,
+    ///   the host's virtual addresses double as physical addresses)
+    using test_page_pool_t = page_pool_t<
+        TEST_PAGE_SIZE.get(),
+        bsl::uintmax{},
+        bsl::safe_uintmax::max_value().get(),
+        TEST_MAX_PPS.get(),
+        TEST_MAX_NUMA_NODES.get(),
+        bsl::uintmax{}>;
+
+    /// @brief stores the memory given to the page pool in testing
+    alignas(TEST_PAGE_SIZE.get())
+        bsl::array<bsl::byte, (TEST_PAGE_SIZE * TEST_MAX_PAGES).get()> g_pages{};
+
+    /// @brief defines the number of pages used for donations in testing
+    constexpr bsl::safe_uintmax TEST_DONATED_PAGES{bsl::to_umax(3)};
+
+    /// @brief stores the memory donated to the page pool in testing
+    alignas(TEST_PAGE_SIZE.get())
+        bsl::array<bsl::byte, (TEST_PAGE_SIZE * TEST_DONATED_PAGES).get()> g_donated{};
+
     /// <!-- description -->
-    ///   @brief Used to execute the actual checks. We put the checks in this
-    ///     function so that we can validate the tests both at compile-time
-    ///     and at run-time. If a bsl::ut_check fails, the tests will either
-    ///     fail fast at run-time, or will produce a compile-time error.
+    ///   @brief Tags the donated page at the provided physical address
+    ///     the same way the loader does.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param phys the physical address of the page to tag
+    ///
+    void
+    tag_donated_page(bsl::safe_uintmax const &phys) noexcept
+    {
+        auto *const page{bsl::to_ptr<loader::donated_page_t *>(phys)};
+        page->tag = loader::DONATE_PAGES_TAG.get();
+        page->phys = phys.get();
+    }
+
+    /// <!-- description -->
+    ///   @brief Links the first "pages" pages of g_pages together the
+    ///     same way the loader does, and returns the resulting page pool
+    ///     for node 0.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pages the number of pages to give to the page pool
+    ///   @return Returns the resulting page pool for each node
+    ///
+    [[nodiscard]] auto
+    make_pools(bsl::safe_uintmax const &pages) noexcept
+        -> bsl::array<bsl::span<bsl::byte>, TEST_MAX_NUMA_NODES.get()>
+    {
+        for (bsl::safe_uintmax i{}; i < pages; ++i) {
+            void *next{};
+            if ((i + bsl::ONE_UMAX) < pages) {
+                next = g_pages.at_if((i + bsl::ONE_UMAX) * TEST_PAGE_SIZE);
+            }
+            else {
+                bsl::touch();
+            }
+
+            *static_cast<void **>(static_cast<void *>(g_pages.at_if(i * TEST_PAGE_SIZE))) = next;
+        }
+
+        return {bsl::span<bsl::byte>{g_pages.data(), (pages * TEST_PAGE_SIZE).get()}};
+    }
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. Unlike most of the
+    ///     tests, these checks cannot be validated at compile-time as the
+    ///     page pool stores its free list inside of the pages themselves,
+    ///     which requires casts that are not allowed in a constant
+    ///     expression.
     ///
     /// <!-- inputs/outputs -->
     ///   @return Always returns bsl::exit_success.
     ///
-    [[nodiscard]] constexpr auto
+    [[nodiscard]] auto
     tests() noexcept -> bsl::exit_code
     {
+        bsl::ut_scenario{"initialize with an empty pool"} = []() {
+            bsl::ut_given{} = []() {
+                test_page_pool_t pool{};
+                bsl::array<bsl::span<bsl::byte>, TEST_MAX_NUMA_NODES.get()> pools{};
+                bsl::ut_then{} = [&pool, &pools]() {
+                    bsl::ut_check(!pool.initialize(pools));
+                };
+            };
+        };
+
+        bsl::ut_scenario{"initialize twice"} = []() {
+            bsl::ut_given{} = []() {
+                test_page_pool_t pool{};
+                auto pools{make_pools(TEST_MAX_PAGES)};
+                bsl::ut_when{} = [&pool, &pools]() {
+                    bsl::ut_required_step(pool.initialize(pools));
+                    bsl::ut_then{} = [&pool, &pools]() {
+                        bsl::ut_check(!pool.initialize(pools));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"allocate without initialize"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                bsl::ut_then{} = [&tls, &pool]() {
+                    bsl::ut_check(nullptr == pool.allocate<void>(tls, TEST_TAG));
+                };
+            };
+        };
+
+        bsl::ut_scenario{"allocate with an empty tag"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(TEST_MAX_PAGES)};
+                bsl::ut_when{} = [&tls, &pool, &pools]() {
+                    bsl::ut_required_step(pool.initialize(pools));
+                    bsl::ut_then{} = [&tls, &pool]() {
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"allocate with an invalid ppid"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(TEST_MAX_PAGES)};
+                bsl::ut_when{} = [&tls, &pool, &pools]() {
+                    tls.ppid = PPID_INVALID.get();
+                    bsl::ut_required_step(pool.initialize(pools));
+                    bsl::ut_then{} = [&tls, &pool]() {
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls, TEST_TAG));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"a freed page is reused by the same pp"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(TEST_MAX_PAGES)};
+                bsl::ut_when{} = [&tls, &pool, &pools]() {
+                    bsl::ut_required_step(pool.initialize(pools));
+                    auto *const page{pool.allocate<void>(tls, TEST_TAG)};
+                    bsl::ut_required_step(nullptr != page);
+                    pool.deallocate(tls, page, TEST_TAG);
+                    bsl::ut_then{} = [&tls, &pool, page]() {
+                        bsl::ut_check(page == pool.allocate<void>(tls, TEST_TAG));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"allocate every page"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(TEST_MAX_PAGES)};
+                bsl::ut_when{} = [&tls, &pool, &pools]() {
+                    bsl::ut_required_step(pool.initialize(pools));
+                    bsl::ut_then{} = [&tls, &pool]() {
+                        for (bsl::safe_uintmax i{}; i < TEST_MAX_PAGES; ++i) {
+                            bsl::ut_check(nullptr != pool.allocate<void>(tls, TEST_TAG));
+                        }
+
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls, TEST_TAG));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"pages cached by another pp are flushed before failing"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls0{};
+                tls_t tls1{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(PAGE_POOL_CACHE_BATCH)};
+                bsl::ut_when{} = [&tls0, &tls1, &pool, &pools]() {
+                    tls0.ppid = PPID0.get();
+                    tls1.ppid = PPID1.get();
+                    bsl::ut_required_step(pool.initialize(pools));
+
+                    /// NOTE:
+                    /// - The first allocation on PP0 moves every page in
+                    ///   the pool into PP0's cache, so every allocation
+                    ///   made by PP1 has to come from PP0's cache.
+                    ///
+
+                    bsl::ut_required_step(nullptr != pool.allocate<void>(tls0, TEST_TAG));
+                    bsl::ut_then{} = [&tls1, &pool]() {
+                        for (bsl::safe_uintmax i{bsl::ONE_UMAX}; i < PAGE_POOL_CACHE_BATCH; ++i) {
+                            bsl::ut_check(nullptr != pool.allocate<void>(tls1, TEST_TAG));
+                        }
+
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls1, TEST_TAG));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"pages freed on one pp can be allocated by another"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls0{};
+                tls_t tls1{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(TEST_MAX_PAGES)};
+                bsl::ut_when{} = [&tls0, &tls1, &pool, &pools]() {
+                    tls0.ppid = PPID0.get();
+                    tls1.ppid = PPID1.get();
+                    bsl::ut_required_step(pool.initialize(pools));
+
+                    for (bsl::safe_uintmax i{}; i < TEST_MAX_PAGES; ++i) {
+                        bsl::ut_required_step(nullptr != pool.allocate<void>(tls1, TEST_TAG));
+                    }
+
+                    /// NOTE:
+                    /// - Freeing every page on PP0 fills PP0's cache, which
+                    ///   is drained to the global stack in batches, and
+                    ///   whatever is left in the cache is flushed once PP1
+                    ///   runs out of pages.
+                    ///
+
+                    for (bsl::safe_uintmax i{}; i < TEST_MAX_PAGES; ++i) {
+                        pool.deallocate(tls0, g_pages.at_if(i * TEST_PAGE_SIZE), TEST_TAG);
+                    }
+
+                    bsl::ut_then{} = [&tls1, &pool]() {
+                        for (bsl::safe_uintmax i{}; i < TEST_MAX_PAGES; ++i) {
+                            bsl::ut_check(nullptr != pool.allocate<void>(tls1, TEST_TAG));
+                        }
+
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls1, TEST_TAG));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"deallocate with a tag that was never used"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(bsl::ONE_UMAX)};
+                bsl::ut_when{} = [&tls, &pool, &pools]() {
+                    bsl::ut_required_step(pool.initialize(pools));
+                    auto *const page{pool.allocate<void>(tls, TEST_TAG)};
+                    bsl::ut_required_step(nullptr != page);
+                    pool.deallocate(tls, page, "unknown");
+                    bsl::ut_then{} = [&tls, &pool]() {
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls, TEST_TAG));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"allocate with more tags than there are records"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(TEST_MAX_PAGES)};
+                bsl::array<bsl::string_view, (PAGE_POOL_MAX_RECORDS + bsl::ONE_UMAX).get()> tags{
+                    "tag0",
+                    "tag1",
+                    "tag2",
+                    "tag3",
+                    "tag4",
+                    "tag5",
+                    "tag6",
+                    "tag7",
+                    "tag8",
+                    "tag9",
+                    "tag10"};
+                bsl::ut_when{} = [&tls, &pool, &pools, &tags]() {
+                    bsl::ut_required_step(pool.initialize(pools));
+                    bsl::ut_then{} = [&tls, &pool, &tags]() {
+                        for (bsl::safe_uintmax i{}; i < PAGE_POOL_MAX_RECORDS; ++i) {
+                            bsl::ut_check(nullptr != pool.allocate<void>(tls, *tags.at_if(i)));
+                        }
+
+                        auto const *const known{tags.at_if(bsl::ZERO_UMAX)};
+                        auto const *const unknown{tags.at_if(PAGE_POOL_MAX_RECORDS)};
+                        bsl::ut_check(nullptr != pool.allocate<void>(tls, *known));
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls, *unknown));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"release resets the tags"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                auto pools{make_pools(TEST_MAX_PAGES)};
+                bsl::ut_when{} = [&tls, &pool, &pools]() {
+                    bsl::ut_required_step(pool.initialize(pools));
+                    bsl::ut_required_step(nullptr != pool.allocate<void>(tls, TEST_TAG));
+                    pool.release();
+                    pools = make_pools(bsl::ONE_UMAX);
+                    bsl::ut_required_step(pool.initialize(pools));
+                    bsl::ut_then{} = [&tls, &pool]() {
+                        auto *const page{pool.allocate<void>(tls, "other")};
+                        bsl::ut_check(nullptr != page);
+                        pool.deallocate(tls, page, TEST_TAG);
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls, TEST_TAG));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"donate only reads pages inside of the donated ranges"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_page_pool_t pool{};
+                loader::donated_ranges_t ranges{};
+                auto pools{make_pools(bsl::ONE_UMAX)};
+                bsl::ut_when{} = [&tls, &pool, &ranges, &pools]() {
+                    bsl::ut_required_step(pool.initialize(pools));
+                    bsl::ut_required_step(pool.initialize_donations(&ranges));
+
+                    auto const list_phys{bsl::to_umax(g_donated.data())};
+                    auto const page_phys{list_phys + TEST_PAGE_SIZE};
+                    auto const outside_phys{bsl::to_umax(g_pages.data()) + TEST_PAGE_SIZE};
+
+                    tag_donated_page(list_phys);
+                    tag_donated_page(page_phys);
+                    tag_donated_page(outside_phys);
+
+                    auto *const list{bsl::to_ptr<loader::donate_pages_t *>(list_phys)};
+                    list->num = bsl::to_umax(2).get();
+                    *list->pages.at_if(bsl::ZERO_UMAX) = page_phys.get();
+                    *list->pages.at_if(bsl::ONE_UMAX) = outside_phys.get();
+
+                    bsl::ut_then{} = [&tls, &pool, &ranges, &list_phys]() {
+                        bsl::ut_check(!pool.donate(tls, list_phys, bsl::ZERO_UMAX));
+
+                        *ranges.phys.at_if(bsl::ZERO_UMAX) = list_phys.get();
+                        *ranges.size.at_if(bsl::ZERO_UMAX) =
+                            (TEST_PAGE_SIZE * TEST_DONATED_PAGES).get();
+
+                        bsl::ut_check(!pool.donate(tls, list_phys, bsl::ZERO_UMAX));
+                        bsl::ut_check(nullptr != pool.allocate<void>(tls, TEST_TAG));
+                        bsl::ut_check(nullptr != pool.allocate<void>(tls, TEST_TAG));
+                        bsl::ut_check(nullptr == pool.allocate<void>(tls, TEST_TAG));
+                    };
+                };
+            };
+        };
+
         return bsl::ut_success();
     }
 }
@@ -56,7 +423,5 @@ namespace
 main() noexcept -> bsl::exit_code
 {
     bsl::enable_color();
-
-    static_assert(tests() == bsl::ut_success());
-    return tests();
+    return mk::tests();
 }
@@ -0,0 +1,206 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include <pool_bitmap_t.hpp>
+
+#include <bsl/ut.hpp>
+
+namespace mk
+{
+    /// @brief defines a pool that fits in a single word with bits to spare
+    constexpr bsl::uintmax SMALL_MAX_ENTRIES{3};
+    /// @brief defines a pool that exactly fills a single word
+    constexpr bsl::uintmax WORD_MAX_ENTRIES{64};
+    /// @brief defines a pool whose last word is only partially used
+    constexpr bsl::uintmax SPLIT_MAX_ENTRIES{70};
+
+    /// <!-- description -->
+    ///   @brief Marks the first num entries of the provided bitmap as in use
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam MAX_ENTRIES the total number of entries in the pool
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param bitmap the bitmap to mark
+    ///   @param num the number of entries to mark
+    ///
+    template<bsl::uintmax MAX_ENTRIES>
+    constexpr void
+    set_first(pool_bitmap_t<MAX_ENTRIES> &bitmap, bsl::safe_uintmax const &num) noexcept
+    {
+        for (bsl::safe_uintmax i{}; i < num; ++i) {
+            bitmap.set(i);
+        }
+    }
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. We put the checks in this
+    ///     function so that we can validate the tests both at compile-time
+    ///     and at run-time. If a bsl::ut_check fails, the tests will either
+    ///     fail fast at run-time, or will produce a compile-time error.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        bsl::ut_scenario{"find_first_clear on an empty pool"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SPLIT_MAX_ENTRIES> bitmap{};
+                bsl::ut_then{} = [&bitmap]() {
+                    bsl::ut_check(bitmap.find_first_clear() == bsl::ZERO_UMAX);
+                };
+            };
+        };
+
+        bsl::ut_scenario{"find_first_clear skips entries that are set"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SMALL_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    bitmap.set(bsl::to_umax(0));
+                    bitmap.set(bsl::to_umax(2));
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(bitmap.find_first_clear() == bsl::to_umax(1));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"find_first_clear returns an entry once it is cleared"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SMALL_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    set_first(bitmap, bsl::to_umax(SMALL_MAX_ENTRIES));
+                    bitmap.clear(bsl::to_umax(1));
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(bitmap.find_first_clear() == bsl::to_umax(1));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"find_first_clear on a full pool with unused bits"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SMALL_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    set_first(bitmap, bsl::to_umax(SMALL_MAX_ENTRIES));
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(!bitmap.find_first_clear());
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"find_first_clear on a full pool that fills a word"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<WORD_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    set_first(bitmap, bsl::to_umax(WORD_MAX_ENTRIES));
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(!bitmap.find_first_clear());
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"find_first_clear moves into the last word"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SPLIT_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    set_first(bitmap, POOL_BITMAP_WORD_BITS);
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(bitmap.find_first_clear() == POOL_BITMAP_WORD_BITS);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"find_first_clear masks the unused bits of the last word"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SPLIT_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    set_first(bitmap, bsl::to_umax(SPLIT_MAX_ENTRIES));
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(!bitmap.find_first_clear());
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"set and clear ignore out of range entries"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SPLIT_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    set_first(bitmap, bsl::to_umax(SPLIT_MAX_ENTRIES));
+                    bitmap.clear(bsl::to_umax(SPLIT_MAX_ENTRIES));
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(!bitmap.find_first_clear());
+                    };
+                };
+            };
+
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SPLIT_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    bitmap.set(bsl::to_umax(SPLIT_MAX_ENTRIES));
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(bitmap.find_first_clear() == bsl::ZERO_UMAX);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"clear_all"} = []() {
+            bsl::ut_given{} = []() {
+                pool_bitmap_t<SPLIT_MAX_ENTRIES> bitmap{};
+                bsl::ut_when{} = [&bitmap]() {
+                    set_first(bitmap, bsl::to_umax(SPLIT_MAX_ENTRIES));
+                    bitmap.clear_all();
+                    bsl::ut_then{} = [&bitmap]() {
+                        bsl::ut_check(bitmap.find_first_clear() == bsl::ZERO_UMAX);
+                    };
+                };
+            };
+        };
+
+        return bsl::ut_success();
+    }
+}
+/// <!-- description -->
+///   @brief Main function for this unit test. If a call to bsl::ut_check() fails
+///     the application will fast fail. If all calls to bsl::ut_check() pass, this
+///     function will successfully return with bsl::exit_success.
+///
+/// <!-- inputs/outputs -->
+///   @return Always returns bsl::exit_success.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+
+    static_assert(mk::tests() == bsl::ut_success());
+    return mk::tests();
+}
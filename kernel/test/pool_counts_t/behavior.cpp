@@ -0,0 +1,167 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include <mk_interface.hpp>
+#include <pool_counts_t.hpp>
+
+#include <bsl/ut.hpp>
+
+namespace mk
+{
+    /// @brief defines the max number of parents used in testing
+    constexpr bsl::uintmax INTEGRATION_MAX_PARENTS{2};
+
+    /// @brief defines parent ID 0
+    constexpr bsl::safe_uint16 ID0{bsl::to_u16(0)};
+    /// @brief defines parent ID 1
+    constexpr bsl::safe_uint16 ID1{bsl::to_u16(1)};
+    /// @brief defines a parent ID that is out of range
+    constexpr bsl::safe_uint16 ID_OOR{bsl::to_u16(2)};
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. We put the checks in this
+    ///     function so that we can validate the tests both at compile-time
+    ///     and at run-time. If a bsl::ut_check fails, the tests will either
+    ///     fail fast at run-time, or will produce a compile-time error.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        bsl::ut_scenario{"is_zero on a new set of counts"} = []() {
+            bsl::ut_given{} = []() {
+                pool_counts_t<INTEGRATION_MAX_PARENTS> counts{};
+                bsl::ut_then{} = [&counts]() {
+                    bsl::ut_check(counts.is_zero(ID0));
+                    bsl::ut_check(counts.is_zero(ID1));
+                };
+            };
+        };
+
+        bsl::ut_scenario{"is_zero with an invalid or out of range id"} = []() {
+            bsl::ut_given{} = []() {
+                pool_counts_t<INTEGRATION_MAX_PARENTS> counts{};
+                bsl::ut_then{} = [&counts]() {
+                    bsl::ut_check(!counts.is_zero(ID_OOR));
+                    bsl::ut_check(!counts.is_zero(syscall::BF_INVALID_ID));
+                };
+            };
+        };
+
+        bsl::ut_scenario{"inc and dec only touch their own parent"} = []() {
+            bsl::ut_given{} = []() {
+                pool_counts_t<INTEGRATION_MAX_PARENTS> counts{};
+                bsl::ut_when{} = [&counts]() {
+                    counts.inc(ID1);
+                    bsl::ut_then{} = [&counts]() {
+                        bsl::ut_check(counts.is_zero(ID0));
+                        bsl::ut_check(!counts.is_zero(ID1));
+                    };
+
+                    counts.dec(ID1);
+                    bsl::ut_then{} = [&counts]() {
+                        bsl::ut_check(counts.is_zero(ID0));
+                        bsl::ut_check(counts.is_zero(ID1));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"inc and dec ignore out of range ids"} = []() {
+            bsl::ut_given{} = []() {
+                pool_counts_t<INTEGRATION_MAX_PARENTS> counts{};
+                bsl::ut_when{} = [&counts]() {
+                    counts.inc(ID_OOR);
+                    counts.inc(syscall::BF_INVALID_ID);
+                    counts.dec(ID_OOR);
+                    counts.dec(syscall::BF_INVALID_ID);
+                    bsl::ut_then{} = [&counts]() {
+                        bsl::ut_check(counts.is_zero(ID0));
+                        bsl::ut_check(counts.is_zero(ID1));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"count around zombify"} = []() {
+            bsl::ut_given{} = []() {
+                pool_counts_t<INTEGRATION_MAX_PARENTS> counts{};
+                bsl::ut_when{} = [&counts]() {
+                    counts.inc(ID0);
+                    counts.inc(ID0);
+                    bsl::ut_then{} = [&counts]() {
+                        bsl::ut_check(!counts.is_zero(ID0));
+                    };
+
+                    /// NOTE:
+                    /// - A zombie stays assigned to its parent, so the
+                    ///   pools do not dec() when zombifying. Only the
+                    ///   entry that is deallocated is dec()'d, which
+                    ///   must not hide the zombie.
+                    ///
+
+                    counts.dec(ID0);
+                    bsl::ut_then{} = [&counts]() {
+                        bsl::ut_check(!counts.is_zero(ID0));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"clear_all"} = []() {
+            bsl::ut_given{} = []() {
+                pool_counts_t<INTEGRATION_MAX_PARENTS> counts{};
+                bsl::ut_when{} = [&counts]() {
+                    counts.inc(ID0);
+                    counts.inc(ID1);
+                    counts.clear_all();
+                    bsl::ut_then{} = [&counts]() {
+                        bsl::ut_check(counts.is_zero(ID0));
+                        bsl::ut_check(counts.is_zero(ID1));
+                    };
+                };
+            };
+        };
+
+        return bsl::ut_success();
+    }
+}
+/// <!-- description -->
+///   @brief Main function for this unit test. If a call to bsl::ut_check() fails
+///     the application will fast fail. If all calls to bsl::ut_check() pass, this
+///     function will successfully return with bsl::exit_success.
+///
+/// <!-- inputs/outputs -->
+///   @return Always returns bsl::exit_success.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+
+    static_assert(mk::tests() == bsl::ut_success());
+    return mk::tests();
+}
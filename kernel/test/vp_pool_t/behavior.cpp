@@ -39,8 +39,10 @@
 
 namespace mk
 {
-    /// @brief defines the max number of VMs used in testing
+    /// @brief defines the max number of VPs used in testing
     constexpr bsl::safe_uintmax INTEGRATION_MAX_VPS{bsl::to_umax(3)};
+    /// @brief defines the max number of VMs the pool keeps VP counts for
+    constexpr bsl::safe_uintmax INTEGRATION_MAX_VMS{bsl::to_umax(2)};
 
     /// @brief defines VMID0
     constexpr bsl::safe_uint16 VMID0{bsl::to_u16(0)};
@@ -71,7 +73,8 @@ namespace mk
     {
         bsl::ut_scenario{"initialize vp_t reports success"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_then{} = [&pool]() {
                     bsl::ut_check(pool.initialize(bsl::dontcare, bsl::dontcare));
                 };
@@ -80,7 +83,11 @@ namespace mk
 
         bsl::ut_scenario{"initialize vp_t reports failure"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_initialize_failure, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<
+                    vp_t_initialize_failure,
+                    INTEGRATION_MAX_VPS.get(),
+                    INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_then{} = [&pool]() {
                     bsl::ut_check(!pool.initialize(bsl::dontcare, bsl::dontcare));
                 };
@@ -89,7 +96,11 @@ namespace mk
 
         bsl::ut_scenario{"initialize vp_t and release report failure"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_initialize_and_release_failure, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<
+                    vp_t_initialize_and_release_failure,
+                    INTEGRATION_MAX_VPS.get(),
+                    INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_then{} = [&pool]() {
                     bsl::ut_check(!pool.initialize(bsl::dontcare, bsl::dontcare));
                 };
@@ -98,7 +109,8 @@ namespace mk
 
         bsl::ut_scenario{"release without initialize"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_then{} = [&pool]() {
                     bsl::ut_check(pool.release(bsl::dontcare, bsl::dontcare));
                 };
@@ -107,7 +119,8 @@ namespace mk
 
         bsl::ut_scenario{"release with initialize"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -119,7 +132,11 @@ namespace mk
 
         bsl::ut_scenario{"release with initialize and vp_t reports failure"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_release_failure, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<
+                    vp_t_release_failure,
+                    INTEGRATION_MAX_VPS.get(),
+                    INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -132,7 +149,8 @@ namespace mk
         bsl::ut_scenario{"allocate all vps"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&tls, &pool]() {
@@ -148,7 +166,11 @@ namespace mk
         bsl::ut_scenario{"allocate vp_t reports failure"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_allocate_failure, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<
+                    vp_t_allocate_failure,
+                    INTEGRATION_MAX_VPS.get(),
+                    INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&tls, &pool]() {
@@ -161,7 +183,8 @@ namespace mk
         bsl::ut_scenario{"deallocate invalid id"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&tls, &pool]() {
@@ -174,7 +197,11 @@ namespace mk
         bsl::ut_scenario{"deallocate vp_t reports failure"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_deallocate_failure, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<
+                    vp_t_deallocate_failure,
+                    INTEGRATION_MAX_VPS.get(),
+                    INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     auto const vpid{pool.allocate(tls, bsl::dontcare, VMID0, PPID0)};
@@ -188,7 +215,8 @@ namespace mk
         bsl::ut_scenario{"deallocate success"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     auto const vpid{pool.allocate(tls, bsl::dontcare, VMID0, PPID0)};
@@ -201,7 +229,8 @@ namespace mk
 
         bsl::ut_scenario{"zombify invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_then{} = [&pool]() {
                     bsl::ut_check(!pool.zombify(syscall::BF_INVALID_ID));
                 };
@@ -210,7 +239,8 @@ namespace mk
 
         bsl::ut_scenario{"zombify success"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_then{} = [&pool]() {
                     bsl::ut_check(pool.zombify(VPID1));
                 };
@@ -219,7 +249,8 @@ namespace mk
 
         bsl::ut_scenario{"status invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -233,7 +264,8 @@ namespace mk
 
         bsl::ut_scenario{"status after initialize"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -248,7 +280,8 @@ namespace mk
         bsl::ut_scenario{"status after allocate"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     auto const vpid{pool.allocate(tls, bsl::dontcare, VMID0, PPID0)};
@@ -264,7 +297,8 @@ namespace mk
         bsl::ut_scenario{"status after deallocate"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     auto const vpid{pool.allocate(tls, bsl::dontcare, VMID0, PPID0)};
@@ -280,7 +314,8 @@ namespace mk
 
         bsl::ut_scenario{"status after zombify"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_required_step(pool.zombify(VPID1));
@@ -295,7 +330,8 @@ namespace mk
 
         bsl::ut_scenario{"is_assigned_to_ vm invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.is_assigned_to_vm(syscall::BF_INVALID_ID));
@@ -306,7 +342,8 @@ namespace mk
 
         bsl::ut_scenario{"is_assigned_to_vm id with error code"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.is_assigned_to_vm(bsl::safe_uint16::zero(true)));
@@ -317,7 +354,8 @@ namespace mk
 
         bsl::ut_scenario{"is_assigned_to_vm without initialize"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.is_assigned_to_vm(VMID0));
@@ -328,7 +366,8 @@ namespace mk
 
         bsl::ut_scenario{"is_assigned_to_vm nothing assigned"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -341,7 +380,8 @@ namespace mk
         bsl::ut_scenario{"is_assigned_to_vm assigned"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_required_step(pool.allocate(tls, bsl::dontcare, VMID0, PPID0));
@@ -357,7 +397,8 @@ namespace mk
         bsl::ut_scenario{"is_assigned_to_vm assigned but wrong query"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_required_step(pool.allocate(tls, bsl::dontcare, VMID0, PPID0));
@@ -372,7 +413,8 @@ namespace mk
 
         bsl::ut_scenario{"set_active invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.set_active(bsl::dontcare, syscall::BF_INVALID_ID));
@@ -383,7 +425,11 @@ namespace mk
 
         bsl::ut_scenario{"set_active vp_t reports failure"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_set_active_failure, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<
+                    vp_t_set_active_failure,
+                    INTEGRATION_MAX_VPS.get(),
+                    INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.set_active(bsl::dontcare, VPID0));
@@ -394,7 +440,8 @@ namespace mk
 
         bsl::ut_scenario{"set_active success"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(pool.set_active(bsl::dontcare, VPID0));
@@ -405,7 +452,8 @@ namespace mk
 
         bsl::ut_scenario{"set_inactive invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.set_inactive(bsl::dontcare, syscall::BF_INVALID_ID));
@@ -416,7 +464,11 @@ namespace mk
 
         bsl::ut_scenario{"set_inactive vp_t reports failure"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_set_inactive_failure, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<
+                    vp_t_set_inactive_failure,
+                    INTEGRATION_MAX_VPS.get(),
+                    INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.set_inactive(bsl::dontcare, VPID0));
@@ -427,7 +479,8 @@ namespace mk
 
         bsl::ut_scenario{"set_inactive success"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(pool.set_inactive(bsl::dontcare, VPID0));
@@ -438,7 +491,8 @@ namespace mk
 
         bsl::ut_scenario{"is_active invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.is_active(bsl::dontcare, syscall::BF_INVALID_ID));
@@ -449,7 +503,8 @@ namespace mk
 
         bsl::ut_scenario{"is_active success"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.is_active(bsl::dontcare, VPID0));
@@ -464,7 +519,8 @@ namespace mk
 
         bsl::ut_scenario{"is_active_on_current_pp invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(
@@ -476,7 +532,8 @@ namespace mk
 
         bsl::ut_scenario{"is_active_on_current_pp success"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.is_active_on_current_pp(bsl::dontcare, VPID0));
@@ -491,7 +548,8 @@ namespace mk
 
         bsl::ut_scenario{"migrate invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.migrate(bsl::dontcare, PPID0, syscall::BF_INVALID_ID));
@@ -502,7 +560,11 @@ namespace mk
 
         bsl::ut_scenario{"migrate vp_t reports failure"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_migrate_failure, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<
+                    vp_t_migrate_failure,
+                    INTEGRATION_MAX_VPS.get(),
+                    INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(!pool.migrate(bsl::dontcare, PPID0, VPID0));
@@ -513,7 +575,8 @@ namespace mk
 
         bsl::ut_scenario{"migrate success"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         bsl::ut_check(pool.migrate(bsl::dontcare, PPID0, VPID0));
@@ -524,7 +587,8 @@ namespace mk
 
         bsl::ut_scenario{"assigned_vm invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -536,7 +600,8 @@ namespace mk
 
         bsl::ut_scenario{"assigned_vm unassigned"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -549,7 +614,8 @@ namespace mk
         bsl::ut_scenario{"assigned_vm success"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_required_step(pool.allocate(tls, bsl::dontcare, VMID0, PPID0));
@@ -562,7 +628,8 @@ namespace mk
 
         bsl::ut_scenario{"assigned_pp invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -574,7 +641,8 @@ namespace mk
 
         bsl::ut_scenario{"assigned_pp unassigned"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_then{} = [&pool]() {
@@ -587,7 +655,8 @@ namespace mk
         bsl::ut_scenario{"assigned_pp success"} = []() {
             bsl::ut_given{} = []() {
                 tls_t tls{};
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&tls, &pool]() {
                     bsl::ut_required_step(pool.initialize(bsl::dontcare, bsl::dontcare));
                     bsl::ut_required_step(pool.allocate(tls, bsl::dontcare, VMID0, PPID0));
@@ -600,7 +669,8 @@ namespace mk
 
         bsl::ut_scenario{"dump invalid id"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         pool.dump(bsl::dontcare, syscall::BF_INVALID_ID);
@@ -611,7 +681,8 @@ namespace mk
 
         bsl::ut_scenario{"dump success"} = []() {
             bsl::ut_given{} = []() {
-                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get()> pool{};
+                vp_pool_t<vp_t_success, INTEGRATION_MAX_VPS.get(), INTEGRATION_MAX_VMS.get()>
+                    pool{};
                 bsl::ut_when{} = [&pool]() {
                     bsl::ut_then{} = [&pool]() {
                         pool.dump(bsl::dontcare, VPID0);
@@ -22,24 +22,353 @@
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
 
+#include "../../../src/huge_pool_t.hpp"
+#include "../../../src/page_pool_t.hpp"
 #include "../../../src/x64/root_page_table_t.hpp"
 
+#include <allocate_tags.hpp>
+#include <map_page_flags.hpp>
+#include <tls_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/byte.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/ut.hpp>
 
-namespace
+namespace mk
 {
+    /// @brief defines the size of a page used in testing
+    constexpr bsl::safe_uintmax TEST_PAGE_SIZE{bsl::to_umax(0x1000)};
+    /// @brief defines the number of bits in a page used in testing
+    constexpr bsl::safe_uintmax TEST_PAGE_SHIFT{bsl::to_umax(12)};
+    /// @brief defines the size of a 2M page used in testing
+    constexpr bsl::safe_uintmax TEST_2M_SIZE{bsl::to_umax(0x200000)};
+    /// @brief defines the max number of pages given to the page pool in testing
+    constexpr bsl::safe_uintmax TEST_MAX_PAGES{bsl::to_umax(128)};
+    /// @brief defines the max number of PPs used in testing
+    constexpr bsl::safe_uintmax TEST_MAX_PPS{bsl::to_umax(1)};
+    /// @brief defines the max number of NUMA nodes used in testing
+    constexpr bsl::safe_uintmax TEST_MAX_NUMA_NODES{bsl::to_umax(1)};
+    /// @brief defines the max number of huge pool segments used in testing
+    constexpr bsl::safe_uintmax TEST_MAX_SEGMENTS{bsl::to_umax(1)};
+    /// @brief defines where the direct map starts in testing
+    constexpr bsl::safe_uintmax TEST_DIRECT_MAP_ADDR{bsl::to_umax(0x0000100000000000U)};
+
+    /// @class mk::test_intrinsic_t
+    ///
+    /// <!-- description -->
+    ///   @brief Provides the subset of intrinsic_t that root_page_table_t
+    ///     uses. TLB maintenance is a no-op, and CR4 reports PCIDs as
+    ///     disabled.
+    ///
+    class test_intrinsic_t final
+    {
+    public:
+        /// <!-- description -->
+        ///   @brief Does nothing
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param val the virtual address to invalidate
+        ///
+        static constexpr void
+        invlpg(bsl::safe_uint64 const &val) noexcept
+        {
+            bsl::discard(val);
+        }
+
+        /// <!-- description -->
+        ///   @brief Does nothing
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param addr The address to invalidate
+        ///   @param pcid The PCID to invalidate
+        ///   @param type The INVPCID type (see the Intel SDM for details)
+        ///   @return Always returns bsl::errc_success
+        ///
+        [[nodiscard]] static constexpr auto
+        invpcid(
+            bsl::safe_uint64 const &addr,
+            bsl::safe_uint16 const &pcid,
+            bsl::safe_uint64 const &type) noexcept -> bsl::errc_type
+        {
+            bsl::discard(addr);
+            bsl::discard(pcid);
+            bsl::discard(type);
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns 0, meaning PCIDs are disabled
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Always returns 0
+        ///
+        [[nodiscard]] static constexpr auto
+        cr4() noexcept -> bsl::safe_uint64
+        {
+            return {};
+        }
+    };
+
+    /// @brief defines the page_pool_t used in testing (with a base of 0,
+    ///   the host's virtual addresses double as physical addresses)
+    using test_page_pool_t = page_pool_t<
+        TEST_PAGE_SIZE.get(),
+        bsl::uintmax{},
+        bsl::safe_uintmax::max_value().get(),
+        TEST_MAX_PPS.get(),
+        TEST_MAX_NUMA_NODES.get(),
+        bsl::uintmax{}>;
+
+    /// @brief defines the huge_pool_t used in testing
+    using test_huge_pool_t =
+        huge_pool_t<TEST_PAGE_SIZE.get(), bsl::uintmax{}, TEST_MAX_SEGMENTS.get()>;
+
+    /// @brief defines the root_page_table_t used in testing
+    using test_root_page_table_t = root_page_table_t<
+        test_intrinsic_t,
+        test_page_pool_t,
+        test_huge_pool_t,
+        TEST_PAGE_SIZE.get(),
+        TEST_PAGE_SHIFT.get()>;
+
+    /// @brief stores the memory given to the page pool in testing. This
+    ///   is 2M aligned so that every page in it is covered by one 2M page.
+    alignas(TEST_2M_SIZE.get())
+        bsl::array<bsl::byte, (TEST_PAGE_SIZE * TEST_MAX_PAGES).get()> g_pages{};
+
+    /// <!-- description -->
+    ///   @brief Links the pages of g_pages together the same way the
+    ///     loader does, and returns the resulting page pool for node 0.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Returns the resulting page pool for each node
+    ///
+    [[nodiscard]] auto
+    make_pools() noexcept -> bsl::array<bsl::span<bsl::byte>, TEST_MAX_NUMA_NODES.get()>
+    {
+        for (bsl::safe_uintmax i{}; i < TEST_MAX_PAGES; ++i) {
+            void *next{};
+            if ((i + bsl::ONE_UMAX) < TEST_MAX_PAGES) {
+                next = g_pages.at_if((i + bsl::ONE_UMAX) * TEST_PAGE_SIZE);
+            }
+            else {
+                bsl::touch();
+            }
+
+            *static_cast<void **>(static_cast<void *>(g_pages.at_if(i * TEST_PAGE_SIZE))) = next;
+        }
+
+        return {bsl::span<bsl::byte>{g_pages.data(), g_pages.size()}};
+    }
+
     /// <!-- description -->
-    ///   @brief Used to execute the actual checks. We put the checks in this
-    ///     function so that we can validate the tests both at compile-time
-    ///     and at run-time. If a bsl::ut_check fails, the tests will either
-    ///     fail fast at run-time, or will produce a compile-time error.
+    ///   @brief Used to execute the actual checks. Unlike most of the
+    ///     tests, these checks cannot be validated at compile-time as the
+    ///     page pool stores its free list inside of the pages themselves,
+    ///     which requires casts that are not allowed in a constant
+    ///     expression.
     ///
     /// <!-- inputs/outputs -->
     ///   @return Always returns bsl::exit_success.
     ///
-    [[nodiscard]] constexpr auto
+    [[nodiscard]] auto
     tests() noexcept -> bsl::exit_code
     {
+        bsl::ut_scenario{"two alloc_page calls into one 2M page of the direct map"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_intrinsic_t intrinsic{};
+                test_page_pool_t page_pool{};
+                test_huge_pool_t huge_pool{};
+                test_root_page_table_t rpt{};
+                auto pools{make_pools()};
+                bsl::ut_when{} = [&tls, &intrinsic, &page_pool, &huge_pool, &rpt, &pools]() {
+                    bsl::ut_required_step(page_pool.initialize(pools));
+                    bsl::ut_required_step(
+                        rpt.initialize(tls, &intrinsic, &page_pool, &huge_pool, bsl::ONE_U16));
+
+                    auto const base_phys{page_pool.virt_to_phys(g_pages.data())};
+                    bsl::ut_required_step(rpt.map_2m_page(
+                        tls,
+                        TEST_DIRECT_MAP_ADDR + base_phys,
+                        base_phys,
+                        MAP_PAGE_READ | MAP_PAGE_WRITE));
+
+                    auto *const page1{
+                        page_pool.allocate<void>(tls, ALLOCATE_TAG_BF_MEM_OP_ALLOC_PAGE)};
+                    auto *const page2{
+                        page_pool.allocate<void>(tls, ALLOCATE_TAG_BF_MEM_OP_ALLOC_PAGE)};
+                    bsl::ut_required_step(nullptr != page1);
+                    bsl::ut_required_step(nullptr != page2);
+
+                    auto const phys1{page_pool.virt_to_phys(page1)};
+                    auto const phys2{page_pool.virt_to_phys(page2)};
+                    bsl::ut_then{} = [&tls, &rpt, &phys1, &phys2]() {
+                        bsl::ut_check(
+                            bsl::errc_success ==
+                            rpt.map_page(
+                                tls,
+                                TEST_DIRECT_MAP_ADDR + phys1,
+                                phys1,
+                                MAP_PAGE_READ | MAP_PAGE_WRITE,
+                                MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE));
+                        bsl::ut_check(
+                            bsl::errc_success ==
+                            rpt.map_page(
+                                tls,
+                                TEST_DIRECT_MAP_ADDR + phys2,
+                                phys2,
+                                MAP_PAGE_READ | MAP_PAGE_WRITE,
+                                MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE));
+                    };
+
+                    rpt.release(tls);
+                };
+            };
+        };
+
+        bsl::ut_scenario{"map_page over a split 2M page with a different phys"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_intrinsic_t intrinsic{};
+                test_page_pool_t page_pool{};
+                test_huge_pool_t huge_pool{};
+                test_root_page_table_t rpt{};
+                auto pools{make_pools()};
+                bsl::ut_when{} = [&tls, &intrinsic, &page_pool, &huge_pool, &rpt, &pools]() {
+                    bsl::ut_required_step(page_pool.initialize(pools));
+                    bsl::ut_required_step(
+                        rpt.initialize(tls, &intrinsic, &page_pool, &huge_pool, bsl::ONE_U16));
+
+                    auto const base_phys{page_pool.virt_to_phys(g_pages.data())};
+                    bsl::ut_required_step(rpt.map_2m_page(
+                        tls,
+                        TEST_DIRECT_MAP_ADDR + base_phys,
+                        base_phys,
+                        MAP_PAGE_READ | MAP_PAGE_WRITE));
+
+                    bsl::ut_required_step(rpt.map_page(
+                        tls,
+                        TEST_DIRECT_MAP_ADDR + base_phys,
+                        base_phys,
+                        MAP_PAGE_READ | MAP_PAGE_WRITE,
+                        MAP_PAGE_NO_AUTO_RELEASE));
+
+                    bsl::ut_then{} = [&tls, &rpt, &base_phys]() {
+                        bsl::ut_check(
+                            bsl::errc_already_exists ==
+                            rpt.map_page(
+                                tls,
+                                TEST_DIRECT_MAP_ADDR + base_phys + TEST_PAGE_SIZE,
+                                base_phys,
+                                MAP_PAGE_READ | MAP_PAGE_WRITE,
+                                MAP_PAGE_NO_AUTO_RELEASE));
+                    };
+
+                    rpt.release(tls);
+                };
+            };
+        };
+
+        bsl::ut_scenario{"map_page over an alloc_page page of the direct map"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_intrinsic_t intrinsic{};
+                test_page_pool_t page_pool{};
+                test_huge_pool_t huge_pool{};
+                test_root_page_table_t rpt{};
+                auto pools{make_pools()};
+                bsl::ut_when{} = [&tls, &intrinsic, &page_pool, &huge_pool, &rpt, &pools]() {
+                    bsl::ut_required_step(page_pool.initialize(pools));
+                    bsl::ut_required_step(
+                        rpt.initialize(tls, &intrinsic, &page_pool, &huge_pool, bsl::ONE_U16));
+
+                    auto const base_phys{page_pool.virt_to_phys(g_pages.data())};
+                    bsl::ut_required_step(rpt.map_2m_page(
+                        tls,
+                        TEST_DIRECT_MAP_ADDR + base_phys,
+                        base_phys,
+                        MAP_PAGE_READ | MAP_PAGE_WRITE));
+
+                    auto *const page{
+                        page_pool.allocate<void>(tls, ALLOCATE_TAG_BF_MEM_OP_ALLOC_PAGE)};
+                    bsl::ut_required_step(nullptr != page);
+
+                    auto const phys{page_pool.virt_to_phys(page)};
+                    bsl::ut_required_step(rpt.map_page(
+                        tls,
+                        TEST_DIRECT_MAP_ADDR + phys,
+                        phys,
+                        MAP_PAGE_READ | MAP_PAGE_WRITE,
+                        MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE));
+
+                    bsl::ut_then{} = [&tls, &rpt, &phys]() {
+                        bsl::ut_check(
+                            bsl::errc_already_exists ==
+                            rpt.map_page(
+                                tls,
+                                TEST_DIRECT_MAP_ADDR + phys,
+                                phys,
+                                MAP_PAGE_READ | MAP_PAGE_WRITE,
+                                MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE));
+                    };
+
+                    rpt.release(tls);
+                };
+            };
+        };
+
+        bsl::ut_scenario{"is_mapped checks the phys and the auto release tag"} = []() {
+            bsl::ut_given{} = []() {
+                tls_t tls{};
+                test_intrinsic_t intrinsic{};
+                test_page_pool_t page_pool{};
+                test_huge_pool_t huge_pool{};
+                test_root_page_table_t rpt{};
+                auto pools{make_pools()};
+                bsl::ut_when{} = [&tls, &intrinsic, &page_pool, &huge_pool, &rpt, &pools]() {
+                    bsl::ut_required_step(page_pool.initialize(pools));
+                    bsl::ut_required_step(
+                        rpt.initialize(tls, &intrinsic, &page_pool, &huge_pool, bsl::ONE_U16));
+
+                    auto *const page{
+                        page_pool.allocate<void>(tls, ALLOCATE_TAG_BF_MEM_OP_ALLOC_PAGE)};
+                    bsl::ut_required_step(nullptr != page);
+
+                    auto const phys{page_pool.virt_to_phys(page)};
+                    auto const virt{TEST_DIRECT_MAP_ADDR + phys};
+                    bsl::ut_required_step(rpt.map_page(
+                        tls,
+                        virt,
+                        phys,
+                        MAP_PAGE_READ | MAP_PAGE_WRITE,
+                        MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE));
+
+                    bsl::ut_then{} = [&tls, &rpt, &phys, &virt]() {
+                        bsl::ut_check(
+                            rpt.is_mapped(tls, virt, phys, MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE));
+                        bsl::ut_check(!rpt.is_mapped(tls, virt, phys, MAP_PAGE_NO_AUTO_RELEASE));
+                        bsl::ut_check(!rpt.is_mapped(
+                            tls, virt, phys + TEST_PAGE_SIZE, MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE));
+                        bsl::ut_check(!rpt.is_mapped(
+                            tls,
+                            virt + TEST_PAGE_SIZE,
+                            phys + TEST_PAGE_SIZE,
+                            MAP_PAGE_AUTO_RELEASE_ALLOC_PAGE));
+                    };
+
+                    rpt.release(tls);
+                };
+            };
+        };
+
         return bsl::ut_success();
     }
 }
@@ -56,7 +385,5 @@ namespace
 main() noexcept -> bsl::exit_code
 {
     bsl::enable_color();
-
-    static_assert(tests() == bsl::ut_success());
-    return tests();
+    return mk::tests();
 }
@@ -99,6 +99,94 @@ platform_alloc_contiguous(uint64_t const size)
     return platform_alloc(size);
 }
 
+/**
+ * <!-- description -->
+ *   @brief Same as platform_alloc(), but the memory is allocated from the
+ *     provided NUMA node when the platform supports it. Use
+ *     platform_free() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *
+platform_alloc_node(uint64_t const size, uint32_t const node)
+{
+    (void)node;
+    return platform_alloc(size);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Same as platform_alloc_contiguous(), but the memory is allocated
+ *     from the provided NUMA node when the platform supports it. Use
+ *     platform_free_contiguous() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *
+platform_alloc_contiguous_node(uint64_t const size, uint32_t const node)
+{
+    (void)node;
+    return platform_alloc_contiguous(size);
+}
+
+/**
+ * <!-- description -->
+ *   @brief This function allocates read/write, physically contiguous
+ *     memory for the microkernel's huge pool from the provided NUMA node
+ *     when the platform supports it. Unlike platform_alloc_contiguous(),
+ *     this function is allowed to return less memory than was asked for,
+ *     in which case the caller is expected to call this function again to
+ *     get the rest as another physically contiguous segment. The number
+ *     of bytes that were actually allocated is always a multiple of
+ *     HYPERVISOR_PAGE_SIZE, is never more than the provided size rounded
+ *     up to HYPERVISOR_PAGE_SIZE, and is returned using the "allocated"
+ *     param. Use platform_free_huge() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @param allocated where to return the number of bytes allocated
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *
+platform_alloc_huge_node(uint64_t const size, uint32_t const node, uint64_t *const allocated)
+{
+    void *ret;
+
+    /**
+     * NOTE:
+     * - The huge pool is allocated as a single segment on this platform,
+     *   which means that the memory returned by this function is never
+     *   merged with another segment by the loader.
+     */
+
+    *allocated = ((uint64_t)0);
+
+    ret = platform_alloc_contiguous_node(size, node);
+    if (((void *)0) == ret) {
+        bferror("platform_alloc_contiguous_node failed");
+        return ((void *)0);
+    }
+
+    *allocated = size;
+    return ret;
+}
+
 /**
  * <!-- description -->
  *   @brief This function frees memory previously allocated using the
@@ -142,6 +230,23 @@ platform_free_contiguous(void const *const ptr, uint64_t const size)
     platform_free(ptr, size);
 }
 
+/**
+ * <!-- description -->
+ *   @brief This function frees memory previously allocated using the
+ *     platform_alloc_huge_node() function.
+ *
+ * <!-- inputs/outputs -->
+ *   @param ptr the pointer returned by platform_alloc_huge_node(). If ptr is
+ *     passed a nullptr, it will be ignored. Attempting to free memory
+ *     more than once results in UB.
+ *   @param size the number of bytes that were allocated.
+ */
+void
+platform_free_huge(void const *const ptr, uint64_t const size)
+{
+    platform_free_contiguous(ptr, size);
+}
+
 /**
  * <!-- description -->
  *   @brief Given a virtual address, this function returns the virtual
@@ -285,6 +390,23 @@ platform_num_online_cpus(void)
     return arch_num_online_cpus();
 }
 
+/**
+ * <!-- description -->
+ *   @brief Returns the NUMA node that the provided CPU belongs to. If the
+ *     platform does not support NUMA, or the node is not less than
+ *     HYPERVISOR_MAX_NUMA_NODES, 0 is returned.
+ *
+ * <!-- inputs/outputs -->
+ *   @param cpu the CPU to query
+ *   @return Returns the NUMA node that the provided CPU belongs to
+ */
+uint32_t
+platform_cpu_to_node(uint32_t const cpu)
+{
+    (void)cpu;
+    return ((uint32_t)0);
+}
+
 /**
  * <!-- description -->
  *   @brief Executes a callback on a specific core.
@@ -352,7 +474,13 @@ platform_on_each_cpu(platform_per_cpu_func const func, uint32_t const order)
 {
     int64_t ret;
 
-    if (PLATFORM_FORWARD == order) {
+    /**
+     * NOTE:
+     * - The APs are not executed at the same time on UEFI, so the
+     *   parallel orders simply fall back to their sequential versions.
+     */
+
+    if ((PLATFORM_FORWARD == order) || (PLATFORM_PARALLEL_FORWARD == order)) {
         ret = platform_on_each_cpu_forward(func);
     }
     else {
@@ -37,11 +37,29 @@
  *     not in bytes. Finally, if the provided size is 0, this function
  *     will allocate a default number of pages.
  *
+ *   @note Each NUMA node with at least one online CPU gets its own
+ *     huge pool of the provided size, allocated from that node. Unlike
+ *     the page pool, the huge pool is not split between the nodes as that
+ *     would reduce the largest physically contiguous allocation the
+ *     microkernel can make.
+ *
+ *   @note The platform is allowed to hand out each node's huge pool as
+ *     more than one physically contiguous segment (e.g., when the host is
+ *     too fragmented to allocate all of it at once). Segments that happen
+ *     to be both virtually and physically contiguous are merged, and the
+ *     NUMA node of each segment is stored in the huge_pool_node array.
+ *
  * <!-- inputs/outputs -->
- *   @param size the total number of pages (not bytes) to allocate
- *   @param page_pool the mutable_span_t to store the huge pool addr/size.
+ *   @param size the total number of pages (not bytes) to allocate per node
+ *   @param huge_pool an array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     mutable_span_t to store the addr/size of each segment.
+ *   @param huge_pool_node an array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     uint32_t to store the NUMA node of each segment.
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
-int64_t alloc_mk_huge_pool(uint32_t const size, struct mutable_span_t *const page_pool);
+int64_t alloc_mk_huge_pool(
+    uint32_t const size,
+    struct mutable_span_t *const huge_pool,
+    uint32_t *const huge_pool_node);
 
 #endif
@@ -37,9 +37,16 @@
  *     not in bytes. Finally, if the provided size is 0, this function
  *     will allocate a default number of pages.
  *
+ *   @note The page pool is split into one slice per NUMA node, and each
+ *     slice is allocated from the node that it belongs to. The size of
+ *     each slice is proportional to the number of online CPUs on the
+ *     node, and any remainder is given to the BSP's node. Nodes without
+ *     any online CPUs do not get a slice.
+ *
  * <!-- inputs/outputs -->
  *   @param size the total number of pages (not bytes) to allocate
- *   @param page_pool the mutable_span_t to store the page pool addr/size.
+ *   @param page_pool an array of HYPERVISOR_MAX_NUMA_NODES mutable_span_t
+ *     to store the addr/size of each node's slice of the page pool.
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
 int64_t alloc_mk_page_pool(uint32_t const size, struct mutable_span_t *const page_pool);
@@ -0,0 +1,46 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DONATE_MK_PAGE_POOL_H
+#define DONATE_MK_PAGE_POOL_H
+
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Donates more memory to the microkernel's page pool while the
+ *     VMM is running. The memory is allocated from the provided NUMA
+ *     node and stays with the microkernel until the VMM is stopped.
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to donate. If 0,
+ *     HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE bytes are donated.
+ *   @param node the NUMA node to allocate the donated memory from
+ *   @return 0 on success, LOADER_FAILURE on failure.
+ */
+int64_t donate_mk_page_pool(uint64_t const size, uint32_t const node);
+
+#endif
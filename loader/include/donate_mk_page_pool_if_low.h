@@ -0,0 +1,45 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DONATE_MK_PAGE_POOL_IF_LOW_H
+#define DONATE_MK_PAGE_POOL_IF_LOW_H
+
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Asks the microkernel if any NUMA node's slice of its page
+ *     pool is below the low watermark, and if so, donates
+ *     HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE bytes to that node. This is
+ *     meant to be called periodically while the VMM is running.
+ *
+ * <!-- inputs/outputs -->
+ *   @return 0 on success (including when nothing had to be donated),
+ *     LOADER_FAILURE on failure.
+ */
+int64_t donate_mk_page_pool_if_low(void);
+
+#endif
@@ -35,9 +35,12 @@
  *   @brief Outputs the contents of a provided mk huge pool.
  *
  * <!-- inputs/outputs -->
- *   @param huge_pool the mk huge pool to output
+ *   @param huge_pool the array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     segments of the mk huge pool to output
+ *   @param huge_pool_node the NUMA node of each segment
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
-void dump_mk_huge_pool(struct mutable_span_t *const huge_pool);
+void dump_mk_huge_pool(
+    struct mutable_span_t *const huge_pool, uint32_t const *const huge_pool_node);
 
 #endif
@@ -35,7 +35,8 @@
  *   @brief Outputs the contents of a provided mk page pool.
  *
  * <!-- inputs/outputs -->
- *   @param page_pool the mk page pool to output
+ *   @param page_pool the array of HYPERVISOR_MAX_NUMA_NODES mk page pools
+ *     to output
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
 void dump_mk_page_pool(struct mutable_span_t *const page_pool);
@@ -35,7 +35,8 @@
  *     using the alloc_mk_huge_pool function.
  *
  * <!-- inputs/outputs -->
- *   @param huge_pool the mutable_span_t to free.
+ *   @param huge_pool the array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     mutable_span_t to free.
  */
 void free_mk_huge_pool(struct mutable_span_t *const huge_pool);
 
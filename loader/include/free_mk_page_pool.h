@@ -35,7 +35,8 @@
  *     using the alloc_mk_page_pool function.
  *
  * <!-- inputs/outputs -->
- *   @param page_pool the mutable_span_t to free.
+ *   @param page_pool the array of HYPERVISOR_MAX_NUMA_NODES mutable_span_t
+ *     to free.
  */
 void free_mk_page_pool(struct mutable_span_t *const page_pool);
 
@@ -36,6 +36,8 @@
 #define CPU_STATUS_RUNNING 1U
 /** @brief defines when the CPU is corrupt */
 #define CPU_STATUS_CORRUPT 2U
+/** @brief defines when the CPU is prepared, but not yet running */
+#define CPU_STATUS_PREPARED 3U
 
 /** @brief stores the current state of each CPU */
 extern uint32_t g_cpu_status[HYPERVISOR_MAX_PPS];
@@ -27,10 +27,13 @@
 #ifndef G_MK_HUGE_POOL_H
 #define G_MK_HUGE_POOL_H
 
+#include <constants.h>
 #include <mutable_span_t.h>
 #include <types.h>
 
-/** @brief stores the huge pool used by the microkernel */
-extern struct mutable_span_t g_mk_huge_pool;
+/** @brief stores the physically contiguous segments of the MK's huge pool */
+extern struct mutable_span_t g_mk_huge_pool[HYPERVISOR_MAX_HUGE_POOL_SEGMENTS];
+/** @brief stores the NUMA node of each of the huge pool's segments */
+extern uint32_t g_mk_huge_pool_node[HYPERVISOR_MAX_HUGE_POOL_SEGMENTS];
 
 #endif
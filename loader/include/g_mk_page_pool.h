@@ -27,10 +27,11 @@
 #ifndef G_MK_PAGE_POOL_H
 #define G_MK_PAGE_POOL_H
 
+#include <constants.h>
 #include <mutable_span_t.h>
 #include <types.h>
 
-/** @brief stores the page pool used by the microkernel */
-extern struct mutable_span_t g_mk_page_pool;
+/** @brief stores the page pool used by the microkernel (one per NUMA node) */
+extern struct mutable_span_t g_mk_page_pool[HYPERVISOR_MAX_NUMA_NODES];
 
 #endif
@@ -38,5 +38,17 @@
 #define CPUID_COMMAND_ECX_REPORT_ON ((uint32_t)0xBF000001U)
 /** @brief defines the value of ECX for the CPUID report off command */
 #define CPUID_COMMAND_ECX_REPORT_OFF ((uint32_t)0xBF000002U)
+/** @brief defines the value of ECX for the CPUID dump VMExit stats command */
+#define CPUID_COMMAND_ECX_DUMP_VMEXIT_STATS ((uint32_t)0xBF000003U)
+/** @brief defines the value of ECX for the CPUID trace start command */
+#define CPUID_COMMAND_ECX_TRACE_START ((uint32_t)0xBF000004U)
+/** @brief defines the value of ECX for the CPUID trace stop command */
+#define CPUID_COMMAND_ECX_TRACE_STOP ((uint32_t)0xBF000005U)
+/** @brief defines the value of ECX for the CPUID donate pages command */
+#define CPUID_COMMAND_ECX_DONATE_PAGES ((uint32_t)0xBF000006U)
+/** @brief defines the value of ECX for the CPUID page pool low command */
+#define CPUID_COMMAND_ECX_PAGE_POOL_LOW ((uint32_t)0xBF000007U)
+/** @brief returned by the CPUID page pool low command if no node is low */
+#define CPUID_COMMAND_PAGE_POOL_NOT_LOW ((uint32_t)0xFFFFU)
 
 #endif
@@ -44,6 +44,13 @@ struct debug_ring_t
     uint64_t epos;
     /** @brief stores the start position of the debug ring */
     uint64_t spos;
+    /**
+     * @brief stores the total number of characters that have been written
+     *   to the debug ring, which never wraps. epos is always equal to
+     *   seq % HYPERVISOR_DEBUG_RING_SIZE, which allows a reader to keep
+     *   its own cursor, and to detect when it has been overrun.
+     */
+    uint64_t seq;
 
     /** @brief stores the characters in the debug ring */
     char buf[HYPERVISOR_DEBUG_RING_SIZE];
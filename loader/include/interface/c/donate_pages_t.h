@@ -0,0 +1,101 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DONATE_PAGES_T_H
+#define DONATE_PAGES_T_H
+
+#include <constants.h>
+#include <stdint.h>
+
+#pragma pack(push, 1)
+
+/** @brief defines the tag the loader stores at the start of each donated page */
+#define DONATE_PAGES_TAG ((uint64_t)0x4246445041474553)
+/** @brief defines the max number of pages a single donate_pages_t can list */
+#define DONATE_PAGES_MAX ((uint64_t)509)
+
+/**
+ * @struct donated_page_t
+ *
+ * <!-- description -->
+ *   @brief Defines the header the loader stores at the start of each page
+ *     it donates to the microkernel's page pool. The microkernel reads it
+ *     through its own direct map, so a page that is not mapped where the
+ *     loader says it is cannot name itself. The microkernel clears the tag
+ *     once it has added the page to its page pool, so a page can only be
+ *     added once.
+ */
+struct donated_page_t
+{
+    /** @brief stores DONATE_PAGES_TAG until the page is added */
+    uint64_t tag;
+    /** @brief stores the physical address of this page */
+    uint64_t phys;
+};
+
+/**
+ * @struct donate_pages_t
+ *
+ * <!-- description -->
+ *   @brief Defines the page the loader gives to the microkernel when it
+ *     donates pages to the page pool. It starts with the same header as
+ *     a donated page, but it is not donated itself. Instead, it lists the
+ *     physical address of each donated page.
+ */
+struct donate_pages_t
+{
+    /** @brief stores DONATE_PAGES_TAG */
+    uint64_t tag;
+    /** @brief stores the physical address of this page */
+    uint64_t phys;
+    /** @brief stores the number of entries in pages */
+    uint64_t num;
+    /** @brief stores the physical address of each donated page */
+    uint64_t pages[DONATE_PAGES_MAX];
+};
+
+/**
+ * @struct donated_ranges_t
+ *
+ * <!-- description -->
+ *   @brief Defines the physical address ranges that the loader donated to
+ *     the microkernel's page pool. The loader maps every page in a range
+ *     into the microkernel's direct map before it adds the range, and it
+ *     adds the range before it gives any of its pages to the microkernel.
+ *     The microkernel does not read a donate_pages_t or a donated page
+ *     unless it is inside one of these ranges. Unused entries are 0.
+ */
+struct donated_ranges_t
+{
+    /** @brief stores the physical address of each range */
+    uint64_t phys[HYPERVISOR_MAX_PAGE_POOL_DONATIONS];
+    /** @brief stores the number of bytes in each range */
+    uint64_t size[HYPERVISOR_MAX_PAGE_POOL_DONATIONS];
+};
+
+#pragma pack(pop)
+
+#endif
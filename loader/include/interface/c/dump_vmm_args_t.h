@@ -36,6 +36,11 @@
 /** @brief defines the IOCTL index for dumping a VMs debug ring */
 #define LOADER_DUMP_VMM_CMD ((uint32_t)0xBF03)
 
+/** @brief tells dump_vmm to enable the trace before the debug ring is copied */
+#define DUMP_VMM_TRACE_START ((uint64_t)1)
+/** @brief tells dump_vmm to disable the trace and dump trace_ppid's trace */
+#define DUMP_VMM_TRACE_STOP ((uint64_t)2)
+
 /**
  * @struct dump_vmm_args_t
  *
@@ -48,6 +53,21 @@ struct dump_vmm_args_t
     /** @brief set to HYPERVISOR_VERSION */
     uint64_t ver;
 
+    /** @brief if non-zero, the VMExit stats are added to the debug ring first */
+    uint64_t vmexit_stats;
+
+    /** @brief if non-zero, DUMP_VMM_TRACE_START or DUMP_VMM_TRACE_STOP */
+    uint64_t trace;
+
+    /** @brief the PP whose trace is dumped by DUMP_VMM_TRACE_STOP */
+    uint64_t trace_ppid;
+
+    /** @brief if non-zero, the number of bytes to donate to the MK's page pool */
+    uint64_t donate;
+
+    /** @brief the NUMA node the donated memory is allocated from */
+    uint64_t donate_node;
+
     /** @brief stores the contents of the debug ring upon request */
     struct debug_ring_t debug_ring;
 };
@@ -28,6 +28,7 @@
 #define MK_ARGS_T_H
 
 #include "debug_ring_t.h"
+#include "donate_pages_t.h"
 #include "mutable_span_t.h"
 #include "span_t.h"
 
@@ -52,8 +53,10 @@ struct mk_args_t
     uint16_t ppid;
     /** @brief stores the number of online pps (0x002) */
     uint16_t online_pps;
-    /** @brief reserved (0x004) */
-    uint32_t reserved;
+    /** @brief stores the NUMA node of the current pp (0x004) */
+    uint16_t node;
+    /** @brief reserved (0x006) */
+    uint16_t reserved;
     /** @brief stores the location of the microkernel's state (0x008) */
     struct state_save_t *mk_state;
     /** @brief stores the location of the root vp state (0x010) */
@@ -68,10 +71,14 @@ struct mk_args_t
     void *rpt;
     /** @brief stores the physical address of the MK's RPT for this CPU */
     uint64_t rpt_phys;
-    /** @brief stores the location of the microkernel's page pool */
-    struct mutable_span_t page_pool;
-    /** @brief stores the location of the microkernel's huge pool */
-    struct mutable_span_t huge_pool;
+    /** @brief stores the location of the microkernel's page pool per node */
+    struct mutable_span_t page_pool[HYPERVISOR_MAX_NUMA_NODES];
+    /** @brief stores the segments of the microkernel's huge pool */
+    struct mutable_span_t huge_pool[HYPERVISOR_MAX_HUGE_POOL_SEGMENTS];
+    /** @brief stores the NUMA node of each of the huge pool's segments */
+    uint16_t huge_pool_node[HYPERVISOR_MAX_HUGE_POOL_SEGMENTS];
+    /** @brief stores the ranges the loader donated to the page pool */
+    struct donated_ranges_t *page_pool_donations;
 };
 
 #pragma pack(pop)
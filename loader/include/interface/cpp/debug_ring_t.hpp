@@ -46,6 +46,12 @@ namespace loader
         bsl::uint64 epos;
         /// @brief stores the start position of the debug ring
         bsl::uint64 spos;
+        /// @brief stores the total number of characters that have been
+        ///   written to the debug ring, which never wraps. epos is always
+        ///   equal to seq % HYPERVISOR_DEBUG_RING_SIZE, which allows a
+        ///   reader to keep its own cursor, and to detect when it has
+        ///   been overrun.
+        bsl::uint64 seq;
 
         /// @brief stores the characters in the debug ring
         bsl::details::carray<bsl::char_type, bsl::to_umax(HYPERVISOR_DEBUG_RING_SIZE).get()> buf;
@@ -38,6 +38,11 @@ namespace loader
     /// @brief defines the IOCTL index for dumping a VMs debug ring
     constexpr bsl::safe_uint32 DUMP_VMM_CMD{bsl::to_u32(0xBF03)};
 
+    /// @brief tells dump_vmm to enable the trace before the debug ring is copied
+    constexpr bsl::safe_uint64 DUMP_VMM_TRACE_START{bsl::to_u64(1)};
+    /// @brief tells dump_vmm to disable the trace and dump trace_ppid's trace
+    constexpr bsl::safe_uint64 DUMP_VMM_TRACE_STOP{bsl::to_u64(2)};
+
     /// @struct loader::dump_vmm_args_t
     ///
     /// <!-- description -->
@@ -49,6 +54,21 @@ namespace loader
         /// @brief set to loader::version
         bsl::uint64 ver;
 
+        /// @brief if non-zero, the VMExit stats are added to the debug ring first
+        bsl::uint64 vmexit_stats;
+
+        /// @brief if non-zero, DUMP_VMM_TRACE_START or DUMP_VMM_TRACE_STOP
+        bsl::uint64 trace;
+
+        /// @brief the PP whose trace is dumped by DUMP_VMM_TRACE_STOP
+        bsl::uint64 trace_ppid;
+
+        /// @brief if non-zero, the number of bytes to donate to the MK's page pool
+        bsl::uint64 donate;
+
+        /// @brief the NUMA node the donated memory is allocated from
+        bsl::uint64 donate_node;
+
         /// @brief stores the contents of the debug ring upon request
         debug_ring_t debug_ring;
     };
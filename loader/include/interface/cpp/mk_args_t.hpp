@@ -25,6 +25,7 @@
 #ifndef MK_ARGS_T_HPP
 #define MK_ARGS_T_HPP
 
+#include <donate_pages_t.hpp>
 #include <state_save_t.hpp>
 
 #include <bsl/array.hpp>
@@ -52,8 +53,10 @@ namespace loader
         bsl::uint16 ppid;
         /// @brief stores the number of online pps (0x002)
         bsl::uint16 online_pps;
-        /// @brief reserved (0x004)
-        bsl::uint32 reserved;
+        /// @brief stores the NUMA node of the current pp (0x004)
+        bsl::uint16 node;
+        /// @brief reserved (0x006)
+        bsl::uint16 reserved;
         /// @brief stores the location of the microkernel's state (0x008)
         state_save_t *mk_state;
         /// @brief stores the location of the root vp state (0x010)
@@ -69,10 +72,17 @@ namespace loader
         void *rpt;
         /// @brief stores the physical address of the MK's RPT for this CPU
         bsl::uint64 rpt_phys;
-        /// @brief stores the location of the microkernel's page pool
-        bsl::span<bsl::byte> page_pool;
-        /// @brief stores the location of the microkernel's huge pool
-        bsl::span<bsl::byte> huge_pool;
+        /// @brief stores the location of the microkernel's page pool per node
+        bsl::array<bsl::span<bsl::byte>, bsl::to_umax(HYPERVISOR_MAX_NUMA_NODES).get()>
+            page_pool;
+        /// @brief stores the segments of the microkernel's huge pool
+        bsl::array<bsl::span<bsl::byte>, bsl::to_umax(HYPERVISOR_MAX_HUGE_POOL_SEGMENTS).get()>
+            huge_pool;
+        /// @brief stores the NUMA node of each of the huge pool's segments
+        bsl::array<bsl::uint16, bsl::to_umax(HYPERVISOR_MAX_HUGE_POOL_SEGMENTS).get()>
+            huge_pool_node;
+        /// @brief stores the ranges the loader donated to the page pool
+        donated_ranges_t const *page_pool_donations;
     };
 }
 
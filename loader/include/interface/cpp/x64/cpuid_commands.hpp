@@ -38,6 +38,18 @@ namespace loader
     constexpr bsl::safe_uint32 CPUID_COMMAND_ECX_REPORT_ON{bsl::to_u32(0xBF000001U)};
     /// @brief defines the value of ECX for the CPUID report off command
     constexpr bsl::safe_uint32 CPUID_COMMAND_ECX_REPORT_OFF{bsl::to_u32(0xBF000002U)};
+    /// @brief defines the value of ECX for the CPUID dump VMExit stats command
+    constexpr bsl::safe_uint32 CPUID_COMMAND_ECX_DUMP_VMEXIT_STATS{bsl::to_u32(0xBF000003U)};
+    /// @brief defines the value of ECX for the CPUID trace start command
+    constexpr bsl::safe_uint32 CPUID_COMMAND_ECX_TRACE_START{bsl::to_u32(0xBF000004U)};
+    /// @brief defines the value of ECX for the CPUID trace stop command
+    constexpr bsl::safe_uint32 CPUID_COMMAND_ECX_TRACE_STOP{bsl::to_u32(0xBF000005U)};
+    /// @brief defines the value of ECX for the CPUID donate pages command
+    constexpr bsl::safe_uint32 CPUID_COMMAND_ECX_DONATE_PAGES{bsl::to_u32(0xBF000006U)};
+    /// @brief defines the value of ECX for the CPUID page pool low command
+    constexpr bsl::safe_uint32 CPUID_COMMAND_ECX_PAGE_POOL_LOW{bsl::to_u32(0xBF000007U)};
+    /// @brief returned by the CPUID page pool low command if no node is low
+    constexpr bsl::safe_uint32 CPUID_COMMAND_PAGE_POOL_NOT_LOW{bsl::to_u32(0xFFFFU)};
 }
 
 #endif
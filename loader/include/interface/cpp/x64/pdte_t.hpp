@@ -52,7 +52,7 @@ namespace loader
         bsl::uint64 a : static_cast<bsl::uint64>(1);
         /// @brief defines the "dirty" field in the page (ignored)
         bsl::uint64 d : static_cast<bsl::uint64>(1);
-        /// @brief defines the "page size" field in the page (must be 0)
+        /// @brief defines the "page size" field in the page
         bsl::uint64 ps : static_cast<bsl::uint64>(1);
         /// @brief defines the "global" field in the page (must be 0)
         bsl::uint64 g : static_cast<bsl::uint64>(1);
@@ -34,11 +34,14 @@
 /**
  * <!-- description -->
  *   @brief This function maps the microkernel's huge pool into the
- *     microkernel's root page tables.
+ *     microkernel's root page tables. Each segment is mapped using 2M
+ *     pages wherever both the virtual and the physical address are 2M
+ *     aligned and there is at least 2M left to map, and using 4k pages
+ *     everywhere else.
  *
  * <!-- inputs/outputs -->
- *   @param huge_pool a pointer to a mutable_span_t that stores the huge pool
- *     being mapped
+ *   @param huge_pool the array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     mutable_span_t that stores the huge pool being mapped
  *   @param rpt the root page table to map the huge pool into
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
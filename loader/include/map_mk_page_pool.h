@@ -46,11 +46,13 @@
  *     address of the next page in the page pool (using the direct map
  *     address). This way, all we need to do is pass virt to the
  *     microkernel, and it will have the HEAD of a linked list of pages
- *     that can be used as a page pool.
+ *     that can be used as a page pool. Each NUMA node's slice of the page
+ *     pool is linked into its own list so that the microkernel can keep
+ *     a free list per node.
  *
  * <!-- inputs/outputs -->
- *   @param page_pool a pointer to a mutable_span_t that stores the page pool
- *     being mapped
+ *   @param page_pool the array of HYPERVISOR_MAX_NUMA_NODES mutable_span_t
+ *     that stores the page pool being mapped
  *   @param rpt the root page table to map the page pool into
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
@@ -33,6 +33,10 @@
 #define PLATFORM_FORWARD ((uint32_t)0U)
 /** @brief execute each CPU in reverse order (i.e., decrementing) */
 #define PLATFORM_REVERSE ((uint32_t)1U)
+/** @brief execute the BSP first, and then all of the APs at the same time */
+#define PLATFORM_PARALLEL_FORWARD ((uint32_t)2U)
+/** @brief execute all of the APs at the same time, and then the BSP last */
+#define PLATFORM_PARALLEL_REVERSE ((uint32_t)3U)
 
 /**
  * <!-- description -->
@@ -68,6 +72,67 @@ void *platform_alloc(uint64_t const size);
  */
 void *platform_alloc_contiguous(uint64_t const size);
 
+/**
+ * <!-- description -->
+ *   @brief Same as platform_alloc(), but the memory is allocated from the
+ *     provided NUMA node when the platform supports it. Use
+ *     platform_free() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *platform_alloc_node(uint64_t const size, uint32_t const node);
+
+/**
+ * <!-- description -->
+ *   @brief Same as platform_alloc_contiguous(), but the memory is allocated
+ *     from the provided NUMA node when the platform supports it. Use
+ *     platform_free_contiguous() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *platform_alloc_contiguous_node(uint64_t const size, uint32_t const node);
+
+/**
+ * <!-- description -->
+ *   @brief This function allocates read/write, physically contiguous
+ *     memory for the microkernel's huge pool from the provided NUMA node
+ *     when the platform supports it. Unlike platform_alloc_contiguous(),
+ *     this function is allowed to return less memory than was asked for,
+ *     in which case the caller is expected to call this function again to
+ *     get the rest as another physically contiguous segment. The number
+ *     of bytes that were actually allocated is always a multiple of
+ *     HYPERVISOR_PAGE_SIZE, is never more than the provided size rounded
+ *     up to HYPERVISOR_PAGE_SIZE, and is returned using the "allocated"
+ *     param. Use platform_free_huge() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ *   @note Memory returned by more than one call to this function that
+ *     happens to be both virtually and physically contiguous may be
+ *     released using a single call to platform_free_huge().
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @param allocated where to return the number of bytes allocated
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *platform_alloc_huge_node(
+    uint64_t const size, uint32_t const node, uint64_t *const allocated);
+
 /**
  * <!-- description -->
  *   @brief This function frees memory previously allocated using the
@@ -96,6 +161,19 @@ void platform_free(void const *const ptr, uint64_t const size);
  */
 void platform_free_contiguous(void const *const ptr, uint64_t const size);
 
+/**
+ * <!-- description -->
+ *   @brief This function frees memory previously allocated using the
+ *     platform_alloc_huge_node() function.
+ *
+ * <!-- inputs/outputs -->
+ *   @param ptr the pointer returned by platform_alloc_huge_node(). If ptr is
+ *     passed a nullptr, it will be ignored. Attempting to free memory
+ *     more than once results in UB.
+ *   @param size the number of bytes that were allocated.
+ */
+void platform_free_huge(void const *const ptr, uint64_t const size);
+
 /**
  * <!-- description -->
  *   @brief Given a virtual address, this function returns the virtual
@@ -176,6 +254,18 @@ int64_t platform_copy_to_user(void *const dst, void const *const src, uint64_t c
  */
 uint32_t platform_num_online_cpus(void);
 
+/**
+ * <!-- description -->
+ *   @brief Returns the NUMA node that the provided CPU belongs to. If the
+ *     platform does not support NUMA, or the node is not less than
+ *     HYPERVISOR_MAX_NUMA_NODES, 0 is returned.
+ *
+ * <!-- inputs/outputs -->
+ *   @param cpu the CPU to query
+ *   @return Returns the NUMA node that the provided CPU belongs to
+ */
+uint32_t platform_cpu_to_node(uint32_t const cpu);
+
 /**
  * @brief The callback signature for platform_on_each_cpu
  */
@@ -188,11 +278,16 @@ typedef int64_t (*platform_per_cpu_func)(uint32_t const);
  *     a non-0 value, even if all callbacks succeed except for one. If an
  *     error occurs, it is possible that this function will continue to
  *     execute the remaining callbacks until all callbacks have been called
- *     (depends on the platform).
+ *     (depends on the platform). Platforms that cannot execute the APs
+ *     at the same time treat PLATFORM_PARALLEL_FORWARD and
+ *     PLATFORM_PARALLEL_REVERSE the same as PLATFORM_FORWARD and
+ *     PLATFORM_REVERSE.
  *
  * <!-- inputs/outputs -->
  *   @param func the function to call on each cpu
- *   @param reverse if set to 1, will execute the func in reverse order
+ *   @param reverse sets the order the CPUs are called (PLATFORM_FORWARD,
+ *     PLATFORM_REVERSE, PLATFORM_PARALLEL_FORWARD or
+ *     PLATFORM_PARALLEL_REVERSE)
  *   @return If each callback returns 0, this function returns 0, otherwise
  *     this function returns a non-0 value
  */
@@ -0,0 +1,47 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PREPARE_VMM_PER_CPU_H
+#define PREPARE_VMM_PER_CPU_H
+
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief This function allocates and maps all of the per-CPU resources
+ *     the microkernel needs to start on the provided CPU, and fills in the
+ *     CPU's mk_args. Once this function succeeds, the CPU is marked as
+ *     prepared, and start_vmm_per_cpu can be used to demote it. Since this
+ *     function adds to the microkernel's root page table, it must not be
+ *     called on more than one CPU at a time.
+ *
+ * <!-- inputs/outputs -->
+ *   @param cpu the id of the cpu to prepare
+ *   @return Returns 0 on success
+ */
+int64_t prepare_vmm_per_cpu(uint32_t const cpu);
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SEND_COMMAND_DONATE_PAGES_H
+#define SEND_COMMAND_DONATE_PAGES_H
+
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Gives the hypervisor a donate_pages_t listing the physical
+ *     address of each page that was mapped into the microkernel's page
+ *     pool, and that should be added to the provided NUMA node's free
+ *     list.
+ *
+ * <!-- inputs/outputs -->
+ *   @param list the physical address of the donate_pages_t
+ *   @param node the NUMA node the pages were allocated from
+ *   @return 0 on success, LOADER_FAILURE on failure.
+ */
+int64_t send_command_donate_pages(uint64_t const list, uint32_t const node);
+
+#endif
@@ -34,7 +34,11 @@
  *   @brief This function contains all of the code that is common between
  *     all archiectures and all platforms for starting the VMM. This function
  *     will call platform and architecture specific functions as needed.
- *     Unlike start_vmm, this function is called on each CPU.
+ *     Unlike start_vmm, this function is called on each CPU, and the CPU
+ *     must have already been prepared using prepare_vmm_per_cpu. Since
+ *     this function only uses the resources that belong to the provided
+ *     CPU, it can be called on all of the APs at the same time, once the
+ *     BSP has been started.
  *
  * <!-- inputs/outputs -->
  *   @param cpu the id of the cpu to start
@@ -27,14 +27,22 @@
  */
 
 #include <debug.h>
+#include <debug_ring_t.h>
+#include <donate_mk_page_pool_if_low.h>
 #include <dump_vmm.h>
 #include <dump_vmm_args_t.h>
+#include <g_mk_debug_ring.h>
 #include <linux/kernel.h>
 #include <linux/miscdevice.h>
+#include <linux/mm.h>
 #include <linux/module.h>
+#include <linux/mutex.h>
 #include <linux/notifier.h>
 #include <linux/reboot.h>
 #include <linux/suspend.h>
+#include <linux/version.h>
+#include <linux/vmalloc.h>
+#include <linux/workqueue.h>
 #include <loader_fini.h>
 #include <loader_init.h>
 #include <loader_platform_interface.h>
@@ -46,6 +54,17 @@
 #include <stop_vmm_args_t.h>
 #include <types.h>
 
+/** @brief defines how often (in ms) the MK's page pool is checked */
+#define PAGE_POOL_POLL_MS 1000
+
+/** @brief serializes the IOCTLs with the page pool poll */
+static DEFINE_MUTEX(g_loader_mutex);
+
+static void page_pool_poll(struct work_struct *work);
+
+/** @brief periodically donates memory to the MK's page pool when it is low */
+static DECLARE_DELAYED_WORK(g_page_pool_poll_work, page_pool_poll);
+
 int64_t
 mark_gdt_writable(uint32_t const cpu)
 {
@@ -168,29 +187,135 @@ static long
 dev_unlocked_ioctl(
     struct file *file, unsigned int cmd, unsigned long ioctl_args)
 {
+    long ret;
+
+    mutex_lock(&g_loader_mutex);
+
     switch (cmd) {
         case LOADER_START_VMM: {
-            return handle_start_vmm((void *)ioctl_args);
+            ret = handle_start_vmm((void *)ioctl_args);
+            break;
         }
         case LOADER_STOP_VMM: {
-            return handle_stop_vmm((void *)ioctl_args);
+            ret = handle_stop_vmm((void *)ioctl_args);
+            break;
         }
         case LOADER_DUMP_VMM: {
-            return handle_dump_vmm((void *)ioctl_args);
+            ret = handle_dump_vmm((void *)ioctl_args);
+            break;
         }
         default: {
             bferror_x64("invalid ioctl cmd", cmd);
-            return -EINVAL;
+            ret = -EINVAL;
+            break;
         }
     };
 
+    mutex_unlock(&g_loader_mutex);
+    return ret;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Asks the microkernel if its page pool is running low, and if
+ *     so, donates more memory to it. This is run from a workqueue so
+ *     that the memory can be allocated from a context that can sleep,
+ *     and it takes the same mutex as the IOCTLs so that the VMM cannot
+ *     be stopped while memory is being donated.
+ *
+ * <!-- inputs/outputs -->
+ *   @param work ignored
+ */
+static void
+page_pool_poll(struct work_struct *work)
+{
+    (void)work;
+
+    mutex_lock(&g_loader_mutex);
+
+    if (donate_mk_page_pool_if_low()) {
+        bferror("donate_mk_page_pool_if_low failed");
+    }
+
+    mutex_unlock(&g_loader_mutex);
+
+    schedule_delayed_work(
+        &g_page_pool_poll_work, msecs_to_jiffies(PAGE_POOL_POLL_MS));
+}
+
+/**
+ * <!-- description -->
+ *   @brief Maps the microkernel's debug ring into the calling process as
+ *     read-only. Unlike LOADER_DUMP_VMM, this does not copy the debug
+ *     ring, which allows a reader to follow the debug ring using its own
+ *     cursor (see debug_ring_t.seq) without having to poll the loader.
+ *
+ * <!-- inputs/outputs -->
+ *   @param file the file being mapped
+ *   @param vma the virtual memory area to map the debug ring into
+ *   @return 0 on success, a negative error code otherwise.
+ */
+static int
+dev_mmap(struct file *file, struct vm_area_struct *vma)
+{
+    unsigned long off;
+    unsigned long size = vma->vm_end - vma->vm_start;
+
+    if (((unsigned long)0) != vma->vm_pgoff) {
+        bferror("the debug ring can only be mapped from offset 0");
+        return -EINVAL;
+    }
+
+    if (size > PAGE_ALIGN(sizeof(struct debug_ring_t))) {
+        bferror_x64("the debug ring is smaller than the requested size", size);
+        return -EINVAL;
+    }
+
+    if (vma->vm_flags & VM_WRITE) {
+        bferror("the debug ring can only be mapped as read-only");
+        return -EPERM;
+    }
+
+    /**
+     * NOTE:
+     * - Since Linux 6.3, vm_flags is read-only and has to be modified
+     *   using the vm_flags_* helpers.
+     */
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 3, 0)
+    vm_flags_clear(vma, VM_MAYWRITE);
+#else
+    vma->vm_flags &= ~VM_MAYWRITE;
+#endif
+
+    /**
+     * NOTE:
+     * - The debug ring is allocated using vmalloc, so it is not physically
+     *   contiguous, and each page needs to be mapped on its own. The debug
+     *   ring is not freed until the driver is unloaded, which cannot
+     *   happen while it is still mapped.
+     */
+
+    for (off = ((unsigned long)0); off < size; off += PAGE_SIZE) {
+        if (remap_pfn_range(
+                vma,
+                vma->vm_start + off,
+                vmalloc_to_pfn(((uint8_t *)g_mk_debug_ring) + off),
+                PAGE_SIZE,
+                vma->vm_page_prot)) {
+            bferror("remap_pfn_range failed");
+            return -EAGAIN;
+        }
+    }
+
     return 0;
 }
 
 static struct file_operations fops = {
     .open = dev_open,
     .release = dev_release,
-    .unlocked_ioctl = dev_unlocked_ioctl};
+    .unlocked_ioctl = dev_unlocked_ioctl,
+    .mmap = dev_mmap};
 
 static struct miscdevice bareflank_dev = {
     .minor = MISC_DYNAMIC_MINOR,
@@ -277,6 +402,9 @@ dev_init(void)
         goto misc_register_failed;
     }
 
+    schedule_delayed_work(
+        &g_page_pool_poll_work, msecs_to_jiffies(PAGE_POOL_POLL_MS));
+
     return 0;
 
     misc_deregister(&bareflank_dev);
@@ -294,6 +422,7 @@ loader_init_failed:
 void
 dev_exit(void)
 {
+    cancel_delayed_work_sync(&g_page_pool_poll_work);
     misc_deregister(&bareflank_dev);
     loader_fini();
     unregister_pm_notifier(&pm_notifier_block);
@@ -27,16 +27,65 @@
  */
 
 #include <asm/io.h>
+#include <constants.h>
 #include <debug.h>
+#include <linux/atomic.h>
 #include <linux/cpu.h>
+#include <linux/gfp.h>
+#include <linux/ktime.h>
 #include <linux/mm.h>
 #include <linux/slab.h>
 #include <linux/smp.h>
 #include <linux/vmalloc.h>
+#include <linux/workqueue.h>
 #include <platform.h>
 #include <types.h>
 #include <work_on_cpu_callback_args.h>
 
+/**
+ * NOTE:
+ * - MAX_ORDER was renamed to MAX_PAGE_ORDER (and made inclusive) in newer
+ *   kernels. MAX_ORDER - 1 is always a valid order on older kernels.
+ */
+
+#if defined(MAX_PAGE_ORDER)
+/** @brief defines the largest order the huge pool allocates at once */
+#define PLATFORM_HUGE_MAX_ORDER MAX_PAGE_ORDER
+#else
+/** @brief defines the largest order the huge pool allocates at once */
+#define PLATFORM_HUGE_MAX_ORDER (MAX_ORDER - 1)
+#endif
+
+/** @brief defines the smallest order the huge pool backs off to (i.e., 2M) */
+#define PLATFORM_HUGE_MIN_ORDER (PMD_SHIFT - PAGE_SHIFT)
+
+/**
+ * @struct parallel_work_args
+ *
+ * <!-- description -->
+ *   @brief Defines the args passed to parallel_work_callback for each AP
+ */
+struct parallel_work_args
+{
+    /** @brief the work that executes parallel_work_callback on the AP */
+    struct work_struct work;
+    /** @brief the function to call on the AP */
+    platform_per_cpu_func func;
+    /** @brief the AP to call func on */
+    uint32_t cpu;
+    /** @brief the return value of func */
+    int64_t ret;
+    /** @brief the time (in ns) that func took to execute */
+    uint64_t ns;
+};
+
+/** @brief stores the args for each AP when executing in parallel */
+static struct parallel_work_args g_parallel_work_args[HYPERVISOR_MAX_PPS];
+/** @brief stores the number of APs that have reached the rendezvous */
+static atomic_t g_parallel_rendezvous;
+/** @brief stores the number of APs that must reach the rendezvous */
+static int g_parallel_rendezvous_total;
+
 /**
  * <!-- description -->
  *   @brief This function allocates read/write virtual memory from the
@@ -105,6 +154,167 @@ platform_alloc_contiguous(uint64_t const size)
     return memset(ret, 0, size);
 }
 
+/**
+ * <!-- description -->
+ *   @brief Same as platform_alloc(), but the memory is allocated from the
+ *     provided NUMA node when the platform supports it. Use
+ *     platform_free() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *
+platform_alloc_node(uint64_t const size, uint32_t const node)
+{
+    void *ret;
+
+    if (0 == size) {
+        bferror("invalid number of bytes (i.e., size)");
+        return ((void *)0);
+    }
+
+    ret = vmalloc_node(size, (int)node);
+    if (((void *)0) == ret) {
+        bferror("vmalloc_node failed");
+        return ((void *)0);
+    }
+
+    return memset(ret, 0, size);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Same as platform_alloc_contiguous(), but the memory is allocated
+ *     from the provided NUMA node when the platform supports it. Use
+ *     platform_free_contiguous() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *
+platform_alloc_contiguous_node(uint64_t const size, uint32_t const node)
+{
+    void *ret;
+
+    if (0 == size) {
+        bferror("invalid number of bytes (i.e., size)");
+        return ((void *)0);
+    }
+
+    ret = kmalloc_node(size, GFP_KERNEL, (int)node);
+    if (((void *)0) == ret) {
+        bferror("kmalloc_node failed");
+        return ((void *)0);
+    }
+
+    return memset(ret, 0, size);
+}
+
+/**
+ * <!-- description -->
+ *   @brief This function allocates read/write, physically contiguous
+ *     memory for the microkernel's huge pool from the provided NUMA node
+ *     when the platform supports it. Unlike platform_alloc_contiguous(),
+ *     this function is allowed to return less memory than was asked for,
+ *     in which case the caller is expected to call this function again to
+ *     get the rest as another physically contiguous segment. The number
+ *     of bytes that were actually allocated is always a multiple of
+ *     HYPERVISOR_PAGE_SIZE, is never more than the provided size rounded
+ *     up to HYPERVISOR_PAGE_SIZE, and is returned using the "allocated"
+ *     param. Use platform_free_huge() to release this memory.
+ *
+ *   @note This function must zero the allocated memory
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to allocate
+ *   @param node the NUMA node to allocate the memory from
+ *   @param allocated where to return the number of bytes allocated
+ *   @return Returns a pointer to the newly allocated memory on success.
+ *     Returns a nullptr on failure.
+ */
+void *
+platform_alloc_huge_node(uint64_t const size, uint32_t const node, uint64_t *const allocated)
+{
+    unsigned int order;
+    unsigned int min_order;
+    uint64_t bytes;
+    uint64_t const wanted = PAGE_ALIGN(size);
+    struct page *pages;
+    gfp_t const flags = GFP_KERNEL | __GFP_ZERO | __GFP_NOWARN | __GFP_NORETRY;
+
+    *allocated = ((uint64_t)0);
+
+    if (0 == size) {
+        bferror("invalid number of bytes (i.e., size)");
+        return ((void *)0);
+    }
+
+    /**
+     * NOTE:
+     * - kmalloc() is limited to a few MB, and fails as soon as the host
+     *   is fragmented enough, so instead, the huge pool is built directly
+     *   from the buddy allocator, starting with the largest block that
+     *   makes sense and backing off one order at a time. Buddy blocks are
+     *   naturally aligned, so every block of 2M or more is a run of 2M
+     *   hugepages, which is what lets the huge pool be mapped into the
+     *   microkernel using 2M pages.
+     * - The back-off stops at 2M. Below that, each block would be its
+     *   own segment, and a fragmented host would use up all of the
+     *   huge pool's segments on 4K blocks, failing the whole VMM start
+     *   instead of just this allocation.
+     * - The block is split into order 0 pages so that any range of it
+     *   (and any physically contiguous range of blocks) can be freed one
+     *   page at a time by platform_free_huge(). get_order() rounds up,
+     *   so any pages past the requested size are freed right away.
+     */
+
+    order = get_order(wanted);
+    if (order > PLATFORM_HUGE_MAX_ORDER) {
+        order = PLATFORM_HUGE_MAX_ORDER;
+    }
+
+    min_order = PLATFORM_HUGE_MIN_ORDER;
+    if (min_order > order) {
+        min_order = order;
+    }
+
+    while (1) {
+        pages = alloc_pages_node((int)node, flags, order);
+        if (((void *)0) != pages) {
+            break;
+        }
+
+        if (min_order == order) {
+            bferror("alloc_pages_node failed");
+            return ((void *)0);
+        }
+
+        --order;
+    }
+
+    split_page(pages, order);
+
+    bytes = ((uint64_t)PAGE_SIZE) << order;
+    if (bytes > wanted) {
+        platform_free_huge(
+            ((uint8_t *)page_address(pages)) + wanted, bytes - wanted);
+        bytes = wanted;
+    }
+
+    *allocated = bytes;
+    return page_address(pages);
+}
+
 /**
  * <!-- description -->
  *   @brief This function frees memory previously allocated using the
@@ -149,6 +359,31 @@ platform_free_contiguous(void const *const ptr, uint64_t const size)
     }
 }
 
+/**
+ * <!-- description -->
+ *   @brief This function frees memory previously allocated using the
+ *     platform_alloc_huge_node() function.
+ *
+ * <!-- inputs/outputs -->
+ *   @param ptr the pointer returned by platform_alloc_huge_node(). If ptr is
+ *     passed a nullptr, it will be ignored. Attempting to free memory
+ *     more than once results in UB.
+ *   @param size the number of bytes that were allocated.
+ */
+void
+platform_free_huge(void const *const ptr, uint64_t const size)
+{
+    uint64_t off;
+
+    if (((void *)0) == ptr) {
+        return;
+    }
+
+    for (off = ((uint64_t)0); off < size; off += HYPERVISOR_PAGE_SIZE) {
+        __free_page(virt_to_page(((uint8_t const *)ptr) + off));
+    }
+}
+
 /**
  * <!-- description -->
  *   @brief Given a virtual address, this function returns the virtual
@@ -303,6 +538,28 @@ platform_num_online_cpus(void)
     return num_online_cpus();
 }
 
+/**
+ * <!-- description -->
+ *   @brief Returns the NUMA node that the provided CPU belongs to. If the
+ *     platform does not support NUMA, or the node is not less than
+ *     HYPERVISOR_MAX_NUMA_NODES, 0 is returned.
+ *
+ * <!-- inputs/outputs -->
+ *   @param cpu the CPU to query
+ *   @return Returns the NUMA node that the provided CPU belongs to
+ */
+uint32_t
+platform_cpu_to_node(uint32_t const cpu)
+{
+    int const node = cpu_to_node((int)cpu);
+
+    if ((node < 0) || (((uint64_t)node) >= HYPERVISOR_MAX_NUMA_NODES)) {
+        return ((uint32_t)0);
+    }
+
+    return ((uint32_t)node);
+}
+
 /**
  * <!-- description -->
  *   @brief This function is called when the user calls platform_on_each_cpu.
@@ -398,6 +655,176 @@ work_on_cpu_callback_failed:
     return LOADER_FAILURE;
 }
 
+/**
+ * <!-- description -->
+ *   @brief Reports how long a callback took to execute on a CPU
+ *
+ * <!-- inputs/outputs -->
+ *   @param cpu the CPU the callback was executed on
+ *   @param ns the time (in ns) that the callback took to execute
+ */
+static void
+report_cpu_latency(uint32_t const cpu, uint64_t const ns)
+{
+    bfdebug_d32("cpu", cpu);
+    bfdebug_d64("cpu latency (ns)", ns);
+}
+
+/**
+ * <!-- description -->
+ *   @brief This function is executed on each AP when the user calls
+ *     platform_on_each_cpu with one of the parallel orders. Each AP
+ *     waits at a rendezvous until all of the APs have arrived, so that
+ *     the callbacks are executed at the same time (and the window during
+ *     which only some of the CPUs have been started is kept small).
+ *
+ * <!-- inputs/outputs -->
+ *   @param work the work that was queued for this AP
+ */
+static void
+parallel_work_callback(struct work_struct *const work)
+{
+    struct parallel_work_args *args =
+        container_of(work, struct parallel_work_args, work);
+
+    u64 start;
+
+    atomic_inc(&g_parallel_rendezvous);
+    while (atomic_read(&g_parallel_rendezvous) < g_parallel_rendezvous_total) {
+        cpu_relax();
+    }
+
+    start = ktime_get_ns();
+    args->ret = args->func(args->cpu);
+    args->ns = ((uint64_t)(ktime_get_ns() - start));
+}
+
+/**
+ * <!-- description -->
+ *   @brief Calls the user provided callback on each AP at the same time.
+ *     The callback is not called on the BSP (i.e., CPU 0). Each AP is
+ *     given its own work item on the high priority workqueue, which
+ *     means that the callback is executed from process context, just
+ *     like work_on_cpu, and all of the work items are flushed before
+ *     this function returns. The latency of each AP is reported.
+ *
+ * <!-- inputs/outputs -->
+ *   @param func the function to call on each AP
+ *   @return If each callback returns 0, this function returns 0, otherwise
+ *     this function returns a non-0 value
+ */
+static int64_t
+platform_on_each_ap_parallel(platform_per_cpu_func const func)
+{
+    uint32_t cpu;
+    int64_t ret = LOADER_SUCCESS;
+    uint32_t const num = platform_num_online_cpus();
+
+    if (((uint64_t)num) > HYPERVISOR_MAX_PPS) {
+        bferror("num online cpus out of range");
+        return LOADER_FAILURE;
+    }
+
+    atomic_set(&g_parallel_rendezvous, 0);
+    g_parallel_rendezvous_total = ((int)num) - 1;
+
+    for (cpu = 1; cpu < num; ++cpu) {
+        struct parallel_work_args *args = &g_parallel_work_args[cpu];
+
+        args->func = func;
+        args->cpu = cpu;
+        args->ret = 0;
+        args->ns = 0;
+
+        INIT_WORK(&args->work, parallel_work_callback);
+        queue_work_on(cpu, system_highpri_wq, &args->work);
+    }
+
+    for (cpu = 1; cpu < num; ++cpu) {
+        struct parallel_work_args *args = &g_parallel_work_args[cpu];
+
+        flush_work(&args->work);
+        report_cpu_latency(cpu, args->ns);
+
+        if (args->ret) {
+            bferror_d32("platform_per_cpu_func failed on cpu", cpu);
+            ret = LOADER_FAILURE;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Calls the user provided callback on the BSP (i.e., CPU 0) and
+ *     reports how long the callback took to execute.
+ *
+ * <!-- inputs/outputs -->
+ *   @param func the function to call on the BSP
+ *   @return If the callback returns 0, this function returns 0, otherwise
+ *     this function returns a non-0 value
+ */
+static int64_t
+platform_on_bsp(platform_per_cpu_func const func)
+{
+    u64 start;
+    struct work_on_cpu_callback_args args = {func, 0, 0, 0};
+
+    start = ktime_get_ns();
+    work_on_cpu(0, work_on_cpu_callback, &args);
+    report_cpu_latency(0, ((uint64_t)(ktime_get_ns() - start)));
+
+    if (args.ret) {
+        bferror("platform_per_cpu_func failed on the bsp");
+        return LOADER_FAILURE;
+    }
+
+    return LOADER_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Calls the user provided callback on the BSP, and then on all
+ *     of the APs at the same time (PLATFORM_PARALLEL_FORWARD), or on all
+ *     of the APs at the same time, and then on the BSP
+ *     (PLATFORM_PARALLEL_REVERSE). If the first step fails, the second
+ *     step is skipped. The total latency is reported.
+ *
+ * <!-- inputs/outputs -->
+ *   @param func the function to call on each cpu
+ *   @param order either PLATFORM_PARALLEL_FORWARD or
+ *     PLATFORM_PARALLEL_REVERSE
+ *   @return If each callback returns 0, this function returns 0, otherwise
+ *     this function returns a non-0 value
+ */
+static int64_t
+platform_on_each_cpu_parallel(platform_per_cpu_func const func, uint32_t const order)
+{
+    int64_t ret;
+    u64 const start = ktime_get_ns();
+
+    get_online_cpus();
+
+    if (PLATFORM_PARALLEL_FORWARD == order) {
+        ret = platform_on_bsp(func);
+        if (!ret) {
+            ret = platform_on_each_ap_parallel(func);
+        }
+    }
+    else {
+        ret = platform_on_each_ap_parallel(func);
+        if (!ret) {
+            ret = platform_on_bsp(func);
+        }
+    }
+
+    put_online_cpus();
+
+    bfdebug_d64("total latency (ns)", ((uint64_t)(ktime_get_ns() - start)));
+    return ret;
+}
+
 /**
  * <!-- description -->
  *   @brief Calls the user provided callback on each CPU. If each callback
@@ -421,9 +848,12 @@ platform_on_each_cpu(platform_per_cpu_func const func, uint32_t const order)
     if (PLATFORM_FORWARD == order) {
         ret = platform_on_each_cpu_forward(func);
     }
-    else {
+    else if (PLATFORM_REVERSE == order) {
         ret = platform_on_each_cpu_reverse(func);
     }
+    else {
+        ret = platform_on_each_cpu_parallel(func, order);
+    }
 
     return ret;
 }
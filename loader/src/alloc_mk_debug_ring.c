@@ -42,7 +42,7 @@
 int64_t
 alloc_mk_debug_ring(struct debug_ring_t **const debug_ring)
 {
-    *debug_ring = (struct debug_ring_t *)platform_alloc(HYPERVISOR_DEBUG_RING_SIZE);
+    *debug_ring = (struct debug_ring_t *)platform_alloc(sizeof(struct debug_ring_t));
     if (((void *)0) == *debug_ring) {
         bferror("platform_alloc failed");
         return LOADER_FAILURE;
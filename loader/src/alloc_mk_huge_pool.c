@@ -26,10 +26,39 @@
 
 #include <constants.h>
 #include <debug.h>
+#include <free_mk_huge_pool.h>
 #include <mutable_span_t.h>
 #include <platform.h>
 #include <types.h>
 
+/**
+ * <!-- description -->
+ *   @brief Returns 1 if the memory pointed to by "next" starts right where
+ *     the provided memory ends, both virtually and physically. Returns 0
+ *     otherwise.
+ *
+ * <!-- inputs/outputs -->
+ *   @param addr the virtual address of the first chunk of memory
+ *   @param size the size in bytes of the first chunk of memory
+ *   @param next the virtual address of the second chunk of memory
+ *   @return Returns 1 if the memory pointed to by "next" starts right where
+ *     the provided memory ends, both virtually and physically. Returns 0
+ *     otherwise.
+ */
+static int
+is_contiguous(uint8_t const *const addr, uint64_t const size, uint8_t const *const next)
+{
+    if (addr + size != next) {
+        return 0;
+    }
+
+    if (platform_virt_to_phys(addr) + size != platform_virt_to_phys(next)) {
+        return 0;
+    }
+
+    return 1;
+}
+
 /**
  * <!-- description -->
  *   @brief Allocates a chunk of memory for the huge pool used by the
@@ -37,31 +66,114 @@
  *     not in bytes. Finally, if the provided size is 0, this function
  *     will allocate a default number of pages.
  *
+ *   @note Each NUMA node with at least one online CPU gets its own
+ *     huge pool of the provided size, allocated from that node. Unlike
+ *     the page pool, the huge pool is not split between the nodes as that
+ *     would reduce the largest physically contiguous allocation the
+ *     microkernel can make.
+ *
+ *   @note The platform is allowed to hand out each node's huge pool as
+ *     more than one physically contiguous segment (e.g., when the host is
+ *     too fragmented to allocate all of it at once). Segments that happen
+ *     to be both virtually and physically contiguous are merged, and the
+ *     NUMA node of each segment is stored in the huge_pool_node array.
+ *
  * <!-- inputs/outputs -->
- *   @param size the total number of pages (not bytes) to allocate
- *   @param huge_pool the mutable_span_t to store the page pool addr/size.
+ *   @param size the total number of pages (not bytes) to allocate per node
+ *   @param huge_pool an array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     mutable_span_t to store the addr/size of each segment.
+ *   @param huge_pool_node an array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     uint32_t to store the NUMA node of each segment.
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
 int64_t
-alloc_mk_huge_pool(uint32_t const size, struct mutable_span_t *const huge_pool)
+alloc_mk_huge_pool(
+    uint32_t const size, struct mutable_span_t *const huge_pool, uint32_t *const huge_pool_node)
 {
+    uint32_t cpu;
+    uint64_t node;
+    uint64_t idx;
+    uint64_t bytes;
+    uint64_t remaining;
+    uint64_t allocated;
+    uint8_t *addr;
+    struct mutable_span_t *prev;
+    uint64_t cpus[HYPERVISOR_MAX_NUMA_NODES] = {0};
+    uint32_t const online_cpus = platform_num_online_cpus();
+
     if (0U == size) {
-        huge_pool->size = HYPERVISOR_MK_HUGE_POOL_SIZE;
+        bytes = HYPERVISOR_MK_HUGE_POOL_SIZE;
     }
     else {
-        huge_pool->size = HYPERVISOR_PAGE_SIZE * (uint64_t)size;
+        bytes = HYPERVISOR_PAGE_SIZE * (uint64_t)size;
+    }
+
+    for (cpu = 0U; cpu < online_cpus; ++cpu) {
+        ++cpus[platform_cpu_to_node(cpu)];
     }
 
-    huge_pool->addr = platform_alloc_contiguous(huge_pool->size);
-    if (((void *)0) == huge_pool->addr) {
-        bferror("platform_alloc failed");
-        goto platform_alloc_failed;
+    idx = ((uint64_t)0);
+    for (node = ((uint64_t)0); node < HYPERVISOR_MAX_NUMA_NODES; ++node) {
+        if (((uint64_t)0) == cpus[node]) {
+            continue;
+        }
+
+        remaining = bytes;
+        while (remaining > ((uint64_t)0)) {
+            addr = (uint8_t *)platform_alloc_huge_node(remaining, (uint32_t)node, &allocated);
+            if (((void *)0) == addr) {
+                bferror("platform_alloc_huge_node failed");
+                goto platform_alloc_huge_node_failed;
+            }
+
+            /**
+             * NOTE:
+             * - The platform should never return more than was asked for,
+             *   but if it does, the excess is given back here instead of
+             *   growing the huge pool past its configured size.
+             */
+
+            if (allocated > remaining) {
+                platform_free_huge(addr + remaining, allocated - remaining);
+                allocated = remaining;
+            }
+
+            remaining -= allocated;
+
+            if (((uint64_t)0) != idx) {
+                prev = &huge_pool[idx - ((uint64_t)1)];
+                if ((uint32_t)node == huge_pool_node[idx - ((uint64_t)1)]) {
+                    if (is_contiguous(prev->addr, prev->size, addr)) {
+                        prev->size += allocated;
+                        continue;
+                    }
+
+                    if (is_contiguous(addr, allocated, prev->addr)) {
+                        prev->addr = addr;
+                        prev->size += allocated;
+                        continue;
+                    }
+                }
+            }
+
+            if (idx >= HYPERVISOR_MAX_HUGE_POOL_SEGMENTS) {
+                bferror("the huge pool has too many segments");
+                platform_free_huge(addr, allocated);
+                goto too_many_segments;
+            }
+
+            huge_pool[idx].addr = addr;
+            huge_pool[idx].size = allocated;
+            huge_pool_node[idx] = (uint32_t)node;
+            ++idx;
+        }
     }
 
     return LOADER_SUCCESS;
 
-platform_alloc_failed:
+too_many_segments:
+platform_alloc_huge_node_failed:
 
-    platform_memset(huge_pool, 0, sizeof(struct mutable_span_t));
+    free_mk_huge_pool(huge_pool);
     return LOADER_FAILURE;
 }
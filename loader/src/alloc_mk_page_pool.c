@@ -26,6 +26,7 @@
 
 #include <constants.h>
 #include <debug.h>
+#include <free_mk_page_pool.h>
 #include <mutable_span_t.h>
 #include <platform.h>
 #include <types.h>
@@ -37,31 +38,63 @@
  *     not in bytes. Finally, if the provided size is 0, this function
  *     will allocate a default number of pages.
  *
+ *   @note The page pool is split into one slice per NUMA node, and each
+ *     slice is allocated from the node that it belongs to. The size of
+ *     each slice is proportional to the number of online CPUs on the
+ *     node, and any remainder is given to the BSP's node. Nodes without
+ *     any online CPUs do not get a slice.
+ *
  * <!-- inputs/outputs -->
  *   @param size the total number of pages (not bytes) to allocate
- *   @param page_pool the mutable_span_t to store the page pool addr/size.
+ *   @param page_pool an array of HYPERVISOR_MAX_NUMA_NODES mutable_span_t
+ *     to store the addr/size of each node's slice of the page pool.
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
 int64_t
 alloc_mk_page_pool(uint32_t const size, struct mutable_span_t *const page_pool)
 {
+    uint32_t cpu;
+    uint64_t node;
+    uint64_t total;
+    uint64_t pages;
+    uint64_t cpus[HYPERVISOR_MAX_NUMA_NODES] = {0};
+    uint32_t const online_cpus = platform_num_online_cpus();
+
     if (0U == size) {
-        page_pool->size = HYPERVISOR_MK_PAGE_POOL_SIZE;
+        total = HYPERVISOR_MK_PAGE_POOL_SIZE / HYPERVISOR_PAGE_SIZE;
     }
     else {
-        page_pool->size = HYPERVISOR_PAGE_SIZE * (uint64_t)size;
+        total = (uint64_t)size;
+    }
+
+    for (cpu = 0U; cpu < online_cpus; ++cpu) {
+        ++cpus[platform_cpu_to_node(cpu)];
     }
 
-    page_pool->addr = platform_alloc(page_pool->size);
-    if (((void *)0) == page_pool->addr) {
-        bferror("platform_alloc failed");
-        goto platform_alloc_failed;
+    pages = total;
+    for (node = ((uint64_t)0); node < HYPERVISOR_MAX_NUMA_NODES; ++node) {
+        page_pool[node].size = ((total * cpus[node]) / online_cpus) * HYPERVISOR_PAGE_SIZE;
+        pages -= page_pool[node].size / HYPERVISOR_PAGE_SIZE;
+    }
+
+    page_pool[platform_cpu_to_node(0U)].size += pages * HYPERVISOR_PAGE_SIZE;
+
+    for (node = ((uint64_t)0); node < HYPERVISOR_MAX_NUMA_NODES; ++node) {
+        if (((uint64_t)0) == page_pool[node].size) {
+            continue;
+        }
+
+        page_pool[node].addr = platform_alloc_node(page_pool[node].size, (uint32_t)node);
+        if (((void *)0) == page_pool[node].addr) {
+            bferror("platform_alloc_node failed");
+            goto platform_alloc_node_failed;
+        }
     }
 
     return LOADER_SUCCESS;
 
-platform_alloc_failed:
+platform_alloc_node_failed:
 
-    platform_memset(page_pool, 0, sizeof(struct mutable_span_t));
+    free_mk_page_pool(page_pool);
     return LOADER_FAILURE;
 }
@@ -0,0 +1,52 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <debug.h>
+#include <donate_pages_t.h>
+#include <platform.h>
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Allocates the donated_ranges_t that the loader uses to tell the
+ *     microkernel which ranges of physical memory it donated to the
+ *     microkernel's page pool.
+ *
+ * <!-- inputs/outputs -->
+ *   @param ranges where to store the newly allocated donated_ranges_t
+ *   @return 0 on success, LOADER_FAILURE on failure.
+ */
+int64_t
+alloc_mk_page_pool_donated_ranges(struct donated_ranges_t **const ranges)
+{
+    *ranges = (struct donated_ranges_t *)platform_alloc(sizeof(struct donated_ranges_t));
+    if (((void *)0) == *ranges) {
+        bferror("platform_alloc failed");
+        return LOADER_FAILURE;
+    }
+
+    return LOADER_SUCCESS;
+}
@@ -0,0 +1,245 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <check_top_level_table.h>
+#include <constants.h>
+#include <debug.h>
+#include <donate_pages_t.h>
+#include <g_mk_page_pool_donated_ranges.h>
+#include <g_mk_page_pool_donations.h>
+#include <g_mk_root_page_table.h>
+#include <g_vmm_status.h>
+#include <map_4k_page_rw.h>
+#include <mutable_span_t.h>
+#include <platform.h>
+#include <send_command_donate_pages.h>
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Donates more memory to the microkernel's page pool while the
+ *     VMM is running. The memory is allocated from the provided NUMA
+ *     node as one or more physically contiguous ranges, and each range
+ *     is mapped into the microkernel's direct map and added to
+ *     g_mk_page_pool_donated_ranges. Each page is then tagged with a
+ *     donated_page_t, and its physical address is added to a
+ *     donate_pages_t, which is then given to the microkernel. The
+ *     microkernel checks the donate_pages_t and each page against the
+ *     donated ranges before it adds the page to the node's free list,
+ *     without having to stop the VMM.
+ *
+ *   @note The microkernel's root page tables share everything below the
+ *     top level with g_mk_root_page_table, which is why the loader can
+ *     map the donated pages itself. A range that would need a new top
+ *     level entry cannot be seen by the microkernel, so it is not
+ *     donated.
+ *
+ *   @note Each range uses one of the HYPERVISOR_MAX_PAGE_POOL_DONATIONS
+ *     entries, and ranges are never smaller than what
+ *     platform_alloc_huge_node() hands out.
+ *
+ *   @note The first page of each batch of DONATE_PAGES_MAX pages is used
+ *     as the donate_pages_t for that batch, so it is not donated.
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the number of bytes to donate. If 0,
+ *     HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE bytes are donated.
+ *   @param node the NUMA node to allocate the donated memory from
+ *   @return 0 on success, LOADER_FAILURE on failure.
+ */
+int64_t
+donate_mk_page_pool(uint64_t const size, uint32_t const node)
+{
+    uint64_t off;
+    uint64_t phys;
+    uint64_t bytes;
+    uint64_t allocated;
+    uint8_t *addr;
+    uint64_t idx = ((uint64_t)0);
+    uint64_t pages = ((uint64_t)0);
+    struct donate_pages_t *list = ((void *)0);
+    struct mutable_span_t *donation = ((void *)0);
+    uint64_t const base_virt = HYPERVISOR_MK_PAGE_POOL_ADDR;
+
+    if (VMM_STATUS_RUNNING != g_vmm_status) {
+        bferror("memory cannot be donated as the vmm is not running");
+        return LOADER_FAILURE;
+    }
+
+    if (((uint64_t)node) >= HYPERVISOR_MAX_NUMA_NODES) {
+        bferror_d32("invalid node", node);
+        return LOADER_FAILURE;
+    }
+
+    if (((uint64_t)0) == size) {
+        bytes = HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE;
+    }
+    else {
+        bytes = size;
+    }
+
+    bytes += HYPERVISOR_PAGE_SIZE - ((uint64_t)1);
+    bytes &= ~(HYPERVISOR_PAGE_SIZE - ((uint64_t)1));
+
+    while (bytes > ((uint64_t)0)) {
+        for (; idx < HYPERVISOR_MAX_PAGE_POOL_DONATIONS; ++idx) {
+            if (((void *)0) == g_mk_page_pool_donations[idx].addr) {
+                break;
+            }
+        }
+
+        if (idx >= HYPERVISOR_MAX_PAGE_POOL_DONATIONS) {
+            bferror("the max number of page pool donations has been reached");
+            break;
+        }
+
+        addr = (uint8_t *)platform_alloc_huge_node(bytes, node, &allocated);
+        if (((void *)0) == addr) {
+            bferror("platform_alloc_huge_node failed");
+            break;
+        }
+
+        if (allocated > bytes) {
+            platform_free_huge(addr + bytes, allocated - bytes);
+            allocated = bytes;
+        }
+
+        bytes -= allocated;
+
+        /**
+         * NOTE:
+         * - A range is physically contiguous and far smaller than what a
+         *   top level entry maps, so if its first and last pages do not
+         *   need a new top level entry, none of its pages do.
+         */
+
+        phys = platform_virt_to_phys(addr);
+        if (((uint64_t)0) == phys) {
+            bferror("platform_virt_to_phys failed");
+            platform_free_huge(addr, allocated);
+            break;
+        }
+
+        if (check_top_level_table(base_virt + phys, g_mk_root_page_table) ||
+            check_top_level_table(
+                base_virt + phys + allocated - HYPERVISOR_PAGE_SIZE, g_mk_root_page_table)) {
+            platform_free_huge(addr, allocated);
+            continue;
+        }
+
+        donation = &g_mk_page_pool_donations[idx];
+        donation->addr = addr;
+        donation->size = allocated;
+
+        /**
+         * NOTE:
+         * - Once a page is mapped, it cannot be unmapped from the microkernel
+         *   while it is running. For this reason, a range is only given back
+         *   to the root OS on error if nothing was mapped yet. Otherwise, it
+         *   is kept until the VMM is stopped, but it is never added to
+         *   g_mk_page_pool_donated_ranges, so the microkernel never reads it.
+         */
+
+        for (off = ((uint64_t)0); off < allocated; off += HYPERVISOR_PAGE_SIZE) {
+            void const *const virt = (void *)(base_virt + phys + off);
+            if (map_4k_page_rw(virt, phys + off, g_mk_root_page_table)) {
+                bferror("map_4k_page_rw failed");
+                break;
+            }
+        }
+
+        if (off < allocated) {
+            if (((uint64_t)0) == off) {
+                platform_free_huge(donation->addr, donation->size);
+                platform_memset(donation, 0, sizeof(struct mutable_span_t));
+            }
+
+            break;
+        }
+
+        /**
+         * NOTE:
+         * - The range is added before any of its pages are given to the
+         *   microkernel. send_command_donate_pages() traps to the
+         *   microkernel, which serializes these writes with the
+         *   microkernel's reads.
+         */
+
+        g_mk_page_pool_donated_ranges->phys[idx] = phys;
+        g_mk_page_pool_donated_ranges->size[idx] = allocated;
+
+        for (off = ((uint64_t)0); off < allocated; off += HYPERVISOR_PAGE_SIZE) {
+            if (((void *)0) == list) {
+                list = ((struct donate_pages_t *)(addr + off));
+                list->tag = DONATE_PAGES_TAG;
+                list->phys = phys + off;
+                list->num = ((uint64_t)0);
+                continue;
+            }
+
+            ((struct donated_page_t *)(addr + off))->tag = DONATE_PAGES_TAG;
+            ((struct donated_page_t *)(addr + off))->phys = phys + off;
+
+            list->pages[list->num] = phys + off;
+            ++list->num;
+
+            if (DONATE_PAGES_MAX == list->num) {
+                if (send_command_donate_pages(list->phys, node)) {
+                    bferror("send_command_donate_pages failed");
+                    return LOADER_FAILURE;
+                }
+
+                pages += list->num;
+                list = ((void *)0);
+            }
+        }
+    }
+
+    if (((void *)0) != list && ((uint64_t)0) != list->num) {
+        if (send_command_donate_pages(list->phys, node)) {
+            bferror("send_command_donate_pages failed");
+            return LOADER_FAILURE;
+        }
+
+        pages += list->num;
+    }
+
+    if (((uint64_t)0) == pages) {
+        bferror("not enough of the donated pages can be seen by the microkernel");
+        return LOADER_FAILURE;
+    }
+
+    bfdebug_d32("page pool donation to node", node);
+    bfdebug_x64(" - bytes", pages * HYPERVISOR_PAGE_SIZE);
+
+    if (((uint64_t)0) != bytes) {
+        bferror_x64("unable to donate all of the requested bytes. remaining", bytes);
+        return LOADER_FAILURE;
+    }
+
+    return LOADER_SUCCESS;
+}
@@ -0,0 +1,73 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <constants.h>
+#include <cpuid_commands.h>
+#include <debug.h>
+#include <donate_mk_page_pool.h>
+#include <g_vmm_status.h>
+#include <send_command_page_pool_low.h>
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Asks the microkernel if any NUMA node's slice of its page
+ *     pool is below the low watermark, and if so, donates
+ *     HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE bytes to that node. This is
+ *     meant to be called periodically while the VMM is running.
+ *
+ * <!-- inputs/outputs -->
+ *   @return 0 on success (including when nothing had to be donated),
+ *     LOADER_FAILURE on failure.
+ */
+int64_t
+donate_mk_page_pool_if_low(void)
+{
+    uint32_t node;
+
+    if (VMM_STATUS_RUNNING != g_vmm_status) {
+        return LOADER_SUCCESS;
+    }
+
+    /**
+     * NOTE:
+     * - An extension that does not support the page pool low command
+     *   leaves EAX untouched, which is never a valid node, so it is
+     *   treated the same as CPUID_COMMAND_PAGE_POOL_NOT_LOW.
+     */
+
+    node = send_command_page_pool_low();
+    if (((uint64_t)node) >= HYPERVISOR_MAX_NUMA_NODES) {
+        return LOADER_SUCCESS;
+    }
+
+    if (donate_mk_page_pool(((uint64_t)0), node)) {
+        bferror("donate_mk_page_pool failed");
+        return LOADER_FAILURE;
+    }
+
+    return LOADER_SUCCESS;
+}
@@ -44,6 +44,7 @@ dump_mk_args(struct mk_args_t *const args, uint32_t const cpu)
 
     bfdebug_d32("mk args on cpu", cpu);
     bfdebug_x16(" - online_pps", args->online_pps);
+    bfdebug_x16(" - node", args->node);
     bfdebug_ptr(" - mk_state", args->mk_state);
     bfdebug_ptr(" - root_vp_state", args->root_vp_state);
     bfdebug_ptr(" - debug_ring", args->debug_ring);
@@ -59,8 +60,21 @@ dump_mk_args(struct mk_args_t *const args, uint32_t const cpu)
 
     bfdebug_ptr(" - rpt", args->rpt);
     bfdebug_x64(" - rpt_phys", args->rpt_phys);
-    bfdebug_ptr(" - page_pool.addr", args->page_pool.addr);
-    bfdebug_x64(" - page_pool.size", args->page_pool.size);
-    bfdebug_ptr(" - huge_pool.addr", args->huge_pool.addr);
-    bfdebug_x64(" - huge_pool.size", args->huge_pool.size);
+
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_NUMA_NODES; ++idx) {
+        if (((void *)0) != args->page_pool[idx].addr) {
+            bfdebug_ptr(" - page_pool.addr", args->page_pool[idx].addr);
+            bfdebug_x64(" - page_pool.size", args->page_pool[idx].size);
+        }
+    }
+
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_HUGE_POOL_SEGMENTS; ++idx) {
+        if (((void *)0) != args->huge_pool[idx].addr) {
+            bfdebug_ptr(" - huge_pool.addr", args->huge_pool[idx].addr);
+            bfdebug_x64(" - huge_pool.size", args->huge_pool[idx].size);
+            bfdebug_x16(" - huge_pool.node", args->huge_pool_node[idx]);
+        }
+    }
+
+    bfdebug_ptr(" - page_pool_donations", args->page_pool_donations);
 }
@@ -45,4 +45,5 @@ dump_mk_debug_ring(struct debug_ring_t *const debug_ring)
     bfdebug_x64(" - size", HYPERVISOR_DEBUG_RING_SIZE);
     bfdebug_x64(" - epos", debug_ring->epos);
     bfdebug_x64(" - spos", debug_ring->spos);
+    bfdebug_x64(" - seq", debug_ring->seq);
 }
@@ -24,6 +24,7 @@
  * SOFTWARE.
  */
 
+#include <constants.h>
 #include <debug.h>
 #include <mutable_span_t.h>
 #include <types.h>
@@ -33,13 +34,22 @@
  *   @brief Outputs the contents of a provided mk huge pool.
  *
  * <!-- inputs/outputs -->
- *   @param huge_pool the mk huge pool to output
+ *   @param huge_pool the array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     segments of the mk huge pool to output
+ *   @param huge_pool_node the NUMA node of each segment
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
 void
-dump_mk_huge_pool(struct mutable_span_t *const huge_pool)
+dump_mk_huge_pool(struct mutable_span_t *const huge_pool, uint32_t const *const huge_pool_node)
 {
-    bfdebug("mk huge pool:");
-    bfdebug_ptr(" - addr", huge_pool->addr);
-    bfdebug_x64(" - size", huge_pool->size);
+    uint64_t idx;
+
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_HUGE_POOL_SEGMENTS; ++idx) {
+        if (((void *)0) != huge_pool[idx].addr) {
+            bfdebug_d32("mk huge pool segment", (uint32_t)idx);
+            bfdebug_d32(" - node", huge_pool_node[idx]);
+            bfdebug_ptr(" - addr", huge_pool[idx].addr);
+            bfdebug_x64(" - size", huge_pool[idx].size);
+        }
+    }
 }
@@ -24,6 +24,7 @@
  * SOFTWARE.
  */
 
+#include <constants.h>
 #include <debug.h>
 #include <mutable_span_t.h>
 #include <types.h>
@@ -33,13 +34,20 @@
  *   @brief Outputs the contents of a provided mk page pool.
  *
  * <!-- inputs/outputs -->
- *   @param page_pool the mk page pool to output
+ *   @param page_pool the array of HYPERVISOR_MAX_NUMA_NODES mk page pools
+ *     to output
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
 void
 dump_mk_page_pool(struct mutable_span_t *const page_pool)
 {
-    bfdebug("mk page pool:");
-    bfdebug_ptr(" - addr", page_pool->addr);
-    bfdebug_x64(" - size", page_pool->size);
+    uint64_t node;
+
+    for (node = ((uint64_t)0); node < HYPERVISOR_MAX_NUMA_NODES; ++node) {
+        if (((void *)0) != page_pool[node].addr) {
+            bfdebug_d32("mk page pool on node", (uint32_t)node);
+            bfdebug_ptr(" - addr", page_pool[node].addr);
+            bfdebug_x64(" - size", page_pool[node].size);
+        }
+    }
 }
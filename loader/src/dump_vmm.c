@@ -26,9 +26,14 @@
 
 #include <constants.h>
 #include <debug.h>
+#include <donate_mk_page_pool.h>
 #include <dump_vmm_args_t.h>
 #include <g_mk_debug_ring.h>
+#include <g_vmm_status.h>
 #include <platform.h>
+#include <send_command_dump_vmexit_stats.h>
+#include <send_command_trace_start.h>
+#include <send_command_trace_stop.h>
 #include <types.h>
 
 /**
@@ -75,6 +80,75 @@ dump_vmm(struct dump_vmm_args_t *const args)
         return LOADER_FAILURE;
     }
 
+    /**
+     * NOTE:
+     * - The VMExit stats live in the microkernel, so the only way to get
+     *   them is to ask the extension to dump them (which places them in
+     *   the debug ring) before the debug ring is copied.
+     */
+
+    if (((uint64_t)0) != args->vmexit_stats) {
+        if (VMM_STATUS_RUNNING == g_vmm_status) {
+            send_command_dump_vmexit_stats();
+        }
+        else {
+            bfdebug("vmexit stats not dumped as the vmm is not running");
+        }
+    }
+
+    /**
+     * NOTE:
+     * - The trace works the same way. The extension enables or disables
+     *   the microkernel's trace for all PPs, so the command only needs
+     *   to be sent on this CPU.
+     * - A stop also dumps the trace of trace_ppid, and only that PP. The
+     *   trace of every PP does not fit in the debug ring, so vmmctl asks
+     *   for each PP in turn, copying the debug ring out in between.
+     */
+
+    if (((uint64_t)0) != args->trace) {
+        if (VMM_STATUS_RUNNING != g_vmm_status) {
+            bferror("the trace cannot be used as the vmm is not running");
+            return LOADER_FAILURE;
+        }
+
+        if (DUMP_VMM_TRACE_START == args->trace) {
+            send_command_trace_start();
+        }
+        else if (DUMP_VMM_TRACE_STOP == args->trace) {
+            if (args->trace_ppid >= HYPERVISOR_MAX_PPS) {
+                bferror_x64("invalid trace ppid", args->trace_ppid);
+                return LOADER_FAILURE;
+            }
+
+            send_command_trace_stop(args->trace_ppid);
+        }
+        else {
+            bferror("unknown trace command");
+            return LOADER_FAILURE;
+        }
+    }
+
+    /**
+     * NOTE:
+     * - Donating memory is done here as well so that vmmctl can grow the
+     *   page pool of a running VMM without needing a new IOCTL. Note that
+     *   donate_mk_page_pool validates the node again, but it is checked
+     *   here first so that the cast to a uint32_t cannot truncate it.
+     */
+
+    if (((uint64_t)0) != args->donate) {
+        if (args->donate_node >= HYPERVISOR_MAX_NUMA_NODES) {
+            bferror_x64("invalid donate node", args->donate_node);
+            return LOADER_FAILURE;
+        }
+
+        if (donate_mk_page_pool(args->donate, (uint32_t)args->donate_node)) {
+            bferror("donate_mk_page_pool failed");
+            return LOADER_FAILURE;
+        }
+    }
+
     ret = platform_memcpy(&args->debug_ring, g_mk_debug_ring, sizeof(struct debug_ring_t));
     if (ret) {
         bferror("platform_memcpy failed");
@@ -38,6 +38,6 @@
 void
 free_mk_debug_ring(struct debug_ring_t **const debug_ring)
 {
-    platform_free(*debug_ring, HYPERVISOR_DEBUG_RING_SIZE);
+    platform_free(*debug_ring, sizeof(struct debug_ring_t));
     *debug_ring = ((void *)0);
 }
@@ -24,6 +24,7 @@
  * SOFTWARE.
  */
 
+#include <constants.h>
 #include <mutable_span_t.h>
 #include <platform.h>
 #include <types.h>
@@ -34,11 +35,17 @@
  *     using the alloc_mk_huge_pool function.
  *
  * <!-- inputs/outputs -->
- *   @param huge_pool the mutable_span_t to free.
+ *   @param huge_pool the array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     mutable_span_t to free.
  */
 void
 free_mk_huge_pool(struct mutable_span_t *const huge_pool)
 {
-    platform_free_contiguous(huge_pool->addr, huge_pool->size);
-    platform_memset(huge_pool, 0, sizeof(struct mutable_span_t));
+    uint64_t idx;
+
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_HUGE_POOL_SEGMENTS; ++idx) {
+        struct mutable_span_t *const segment = &huge_pool[idx];
+        platform_free_huge(segment->addr, segment->size);
+        platform_memset(segment, 0, sizeof(struct mutable_span_t));
+    }
 }
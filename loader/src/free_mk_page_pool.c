@@ -24,6 +24,7 @@
  * SOFTWARE.
  */
 
+#include <constants.h>
 #include <mutable_span_t.h>
 #include <platform.h>
 #include <types.h>
@@ -34,11 +35,17 @@
  *     using the alloc_mk_page_pool function.
  *
  * <!-- inputs/outputs -->
- *   @param page_pool the mutable_span_t to free.
+ *   @param page_pool the array of HYPERVISOR_MAX_NUMA_NODES mutable_span_t
+ *     to free.
  */
 void
 free_mk_page_pool(struct mutable_span_t *const page_pool)
 {
-    platform_free(page_pool->addr, page_pool->size);
-    platform_memset(page_pool, 0, sizeof(struct mutable_span_t));
+    uint64_t node;
+
+    for (node = ((uint64_t)0); node < HYPERVISOR_MAX_NUMA_NODES; ++node) {
+        struct mutable_span_t *const slice = &page_pool[node];
+        platform_free(slice->addr, slice->size);
+        platform_memset(slice, 0, sizeof(struct mutable_span_t));
+    }
 }
@@ -0,0 +1,58 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <constants.h>
+#include <donate_pages_t.h>
+#include <mutable_span_t.h>
+#include <platform.h>
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Releases the memory that was donated to the microkernel's page
+ *     pool using the donate_mk_page_pool function. This can only be done
+ *     once the microkernel has been stopped. The donated ranges are
+ *     cleared as well.
+ *
+ * <!-- inputs/outputs -->
+ *   @param donations the array of HYPERVISOR_MAX_PAGE_POOL_DONATIONS
+ *     mutable_span_t to free.
+ *   @param ranges the donated_ranges_t to clear
+ */
+void
+free_mk_page_pool_donations(
+    struct mutable_span_t *const donations, struct donated_ranges_t *const ranges)
+{
+    uint64_t idx;
+
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_PAGE_POOL_DONATIONS; ++idx) {
+        struct mutable_span_t *const donation = &donations[idx];
+        platform_free_huge(donation->addr, donation->size);
+        platform_memset(donation, 0, sizeof(struct mutable_span_t));
+    }
+
+    platform_memset(ranges, 0, sizeof(struct donated_ranges_t));
+}
@@ -28,5 +28,7 @@
 #include <mutable_span_t.h>
 #include <types.h>
 
-/** @brief stores the huge pool used by the microkernel */
-struct mutable_span_t g_mk_huge_pool = {0};
+/** @brief stores the physically contiguous segments of the MK's huge pool */
+struct mutable_span_t g_mk_huge_pool[HYPERVISOR_MAX_HUGE_POOL_SEGMENTS] = {0};
+/** @brief stores the NUMA node of each of the huge pool's segments */
+uint32_t g_mk_huge_pool_node[HYPERVISOR_MAX_HUGE_POOL_SEGMENTS] = {0};
@@ -28,5 +28,5 @@
 #include <mutable_span_t.h>
 #include <types.h>
 
-/** @brief stores the page pool used by the microkernel */
-struct mutable_span_t g_mk_page_pool = {0};
+/** @brief stores the page pool used by the microkernel (one per NUMA node) */
+struct mutable_span_t g_mk_page_pool[HYPERVISOR_MAX_NUMA_NODES] = {0};
@@ -27,8 +27,10 @@
 #include <debug.h>
 #include <free_mk_code_aliases.h>
 #include <free_mk_debug_ring.h>
+#include <free_mk_page_pool_donated_ranges.h>
 #include <g_mk_code_aliases.h>
 #include <g_mk_debug_ring.h>
+#include <g_mk_page_pool_donated_ranges.h>
 #include <g_vmm_status.h>
 #include <platform.h>
 #include <types.h>
@@ -51,6 +53,7 @@ loader_fini(void)
         return LOADER_FAILURE;
     }
 
+    free_mk_page_pool_donated_ranges(&g_mk_page_pool_donated_ranges);
     free_mk_code_aliases(&g_mk_code_aliases);
     free_mk_debug_ring(&g_mk_debug_ring);
 
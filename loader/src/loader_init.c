@@ -26,13 +26,16 @@
 
 #include <alloc_and_copy_mk_code_aliases.h>
 #include <alloc_mk_debug_ring.h>
+#include <alloc_mk_page_pool_donated_ranges.h>
 #include <debug.h>
 #include <dump_mk_code_aliases.h>
 #include <dump_mk_debug_ring.h>
 #include <free_mk_code_aliases.h>
 #include <free_mk_debug_ring.h>
+#include <free_mk_page_pool_donated_ranges.h>
 #include <g_mk_code_aliases.h>
 #include <g_mk_debug_ring.h>
+#include <g_mk_page_pool_donated_ranges.h>
 #include <g_vmm_status.h>
 #include <platform.h>
 #include <types.h>
@@ -65,6 +68,11 @@ loader_init(void)
         goto alloc_and_copy_mk_code_aliases_failed;
     }
 
+    if (alloc_mk_page_pool_donated_ranges(&g_mk_page_pool_donated_ranges)) {
+        bferror("alloc_mk_page_pool_donated_ranges failed");
+        goto alloc_mk_page_pool_donated_ranges_failed;
+    }
+
 #ifdef DEBUG_LOADER
     dump_mk_debug_ring(g_mk_debug_ring);
     dump_mk_code_aliases(&g_mk_code_aliases);
@@ -72,6 +80,8 @@ loader_init(void)
 
     return LOADER_SUCCESS;
 
+alloc_mk_page_pool_donated_ranges_failed:
+    free_mk_code_aliases(&g_mk_code_aliases);
 alloc_and_copy_mk_code_aliases_failed:
     free_mk_debug_ring(&g_mk_debug_ring);
 alloc_mk_debug_ring_failed:
@@ -47,7 +47,7 @@ map_mk_debug_ring(struct debug_ring_t const *const debug_ring, root_page_table_t
 {
     uint64_t off = ((uint64_t)0);
 
-    for (; off < HYPERVISOR_DEBUG_RING_SIZE; off += HYPERVISOR_PAGE_SIZE) {
+    for (; off < sizeof(struct debug_ring_t); off += HYPERVISOR_PAGE_SIZE) {
         if (map_4k_page_rw(((uint8_t *)debug_ring) + off, ((uint64_t)0), rpt)) {
             bferror("map_4k_page_rw failed");
             return LOADER_FAILURE;
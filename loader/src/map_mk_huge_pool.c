@@ -24,8 +24,10 @@
  * SOFTWARE.
  */
 
+#include <bfelf_elf64_phdr_t.h>
 #include <constants.h>
 #include <debug.h>
+#include <map_2m_page.h>
 #include <map_4k_page_rw.h>
 #include <mutable_span_t.h>
 #include <platform.h>
@@ -34,11 +36,14 @@
 /**
  * <!-- description -->
  *   @brief This function maps the microkernel's huge pool into the
- *     microkernel's root page tables.
+ *     microkernel's root page tables. Each segment is mapped using 2M
+ *     pages wherever both the virtual and the physical address are 2M
+ *     aligned and there is at least 2M left to map, and using 4k pages
+ *     everywhere else.
  *
  * <!-- inputs/outputs -->
- *   @param huge_pool a pointer to a mutable_span_t that stores the huge pool
- *     being mapped
+ *   @param huge_pool the array of HYPERVISOR_MAX_HUGE_POOL_SEGMENTS
+ *     mutable_span_t that stores the huge pool being mapped
  *   @param rpt the root page table to map the huge pool into
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
@@ -46,31 +51,59 @@ int64_t
 map_mk_huge_pool(struct mutable_span_t const *const huge_pool, root_page_table_t *const rpt)
 {
     uint64_t off;
+    uint64_t idx;
+    uint64_t phys;
     uint64_t base_phys;
     uint64_t const base_virt = HYPERVISOR_MK_HUGE_POOL_ADDR;
+    uint64_t const mask_2m = LOADER_2M_PAGE_SIZE - ((uint64_t)1);
+    uint32_t const rw = bfelf_pf_w | bfelf_pf_r;
 
-    base_phys = platform_virt_to_phys(huge_pool->addr);
-    if (((uint64_t)0) == base_phys) {
-        bferror("platform_virt_to_phys failed");
-        return LOADER_FAILURE;
-    }
-
-    for (off = ((uint64_t)0); off < huge_pool->size; off += HYPERVISOR_PAGE_SIZE) {
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_HUGE_POOL_SEGMENTS; ++idx) {
+        struct mutable_span_t const *const segment = &huge_pool[idx];
+        if (((void *)0) == segment->addr) {
+            continue;
+        }
 
-        uint64_t phys = platform_virt_to_phys(huge_pool->addr + off);
-        if (((uint64_t)0) == phys) {
+        base_phys = platform_virt_to_phys(segment->addr);
+        if (((uint64_t)0) == base_phys) {
             bferror("platform_virt_to_phys failed");
             return LOADER_FAILURE;
         }
 
-        if (phys != base_phys + off) {
-            bferror("huge pool is not physically contiguous");
-            return LOADER_FAILURE;
+        for (off = ((uint64_t)0); off < segment->size; off += HYPERVISOR_PAGE_SIZE) {
+            phys = platform_virt_to_phys(segment->addr + off);
+            if (((uint64_t)0) == phys) {
+                bferror("platform_virt_to_phys failed");
+                return LOADER_FAILURE;
+            }
+
+            if (phys != base_phys + off) {
+                bferror("huge pool is not physically contiguous");
+                return LOADER_FAILURE;
+            }
         }
 
-        if (map_4k_page_rw((void *)(base_virt + phys), phys, rpt)) {
-            bferror("map_4k_page_rw failed");
-            return LOADER_FAILURE;
+        off = ((uint64_t)0);
+        while (off < segment->size) {
+            phys = base_phys + off;
+
+            if ((((uint64_t)0) == ((base_virt + phys) & mask_2m)) &&
+                ((segment->size - off) >= LOADER_2M_PAGE_SIZE)) {
+                if (map_2m_page(base_virt + phys, phys, rw, rpt)) {
+                    bferror("map_2m_page failed");
+                    return LOADER_FAILURE;
+                }
+
+                off += LOADER_2M_PAGE_SIZE;
+                continue;
+            }
+
+            if (map_4k_page_rw((void *)(base_virt + phys), phys, rpt)) {
+                bferror("map_4k_page_rw failed");
+                return LOADER_FAILURE;
+            }
+
+            off += HYPERVISOR_PAGE_SIZE;
         }
     }
 
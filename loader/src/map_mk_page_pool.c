@@ -46,11 +46,13 @@
  *     address of the next page in the page pool (using the direct map
  *     address). This way, all we need to do is pass virt to the
  *     microkernel, and it will have the HEAD of a linked list of pages
- *     that can be used as a page pool.
+ *     that can be used as a page pool. Each NUMA node's slice of the page
+ *     pool is linked into its own list so that the microkernel can keep
+ *     a free list per node.
  *
  * <!-- inputs/outputs -->
- *   @param page_pool a pointer to a mutable_span_t that stores the page pool
- *     being mapped
+ *   @param page_pool the array of HYPERVISOR_MAX_NUMA_NODES mutable_span_t
+ *     that stores the page pool being mapped
  *   @param rpt the root page table to map the page pool into
  *   @return 0 on success, LOADER_FAILURE on failure.
  */
@@ -58,27 +60,32 @@ int64_t
 map_mk_page_pool(struct mutable_span_t const *const page_pool, root_page_table_t *const rpt)
 {
     uint64_t off;
-    uint64_t *prev = ((void *)0);
+    uint64_t node;
     uint64_t const base_virt = HYPERVISOR_MK_PAGE_POOL_ADDR;
 
-    for (off = ((uint64_t)0); off < page_pool->size; off += HYPERVISOR_PAGE_SIZE) {
+    for (node = ((uint64_t)0); node < HYPERVISOR_MAX_NUMA_NODES; ++node) {
+        uint64_t *prev = ((void *)0);
+        struct mutable_span_t const *const slice = &page_pool[node];
 
-        uint64_t phys = platform_virt_to_phys(page_pool->addr + off);
-        if (((uint64_t)0) == phys) {
-            bferror("platform_virt_to_phys failed");
-            return LOADER_FAILURE;
-        }
+        for (off = ((uint64_t)0); off < slice->size; off += HYPERVISOR_PAGE_SIZE) {
 
-        if (map_4k_page_rw((void *)(base_virt + phys), phys, rpt)) {
-            bferror("map_4k_page_rw failed");
-            return LOADER_FAILURE;
-        }
+            uint64_t phys = platform_virt_to_phys(slice->addr + off);
+            if (((uint64_t)0) == phys) {
+                bferror("platform_virt_to_phys failed");
+                return LOADER_FAILURE;
+            }
 
-        if (((void *)0) != prev) {
-            prev[0] = base_virt + phys;
-        }
+            if (map_4k_page_rw((void *)(base_virt + phys), phys, rpt)) {
+                bferror("map_4k_page_rw failed");
+                return LOADER_FAILURE;
+            }
 
-        prev = ((uint64_t *)(page_pool->addr + off));
+            if (((void *)0) != prev) {
+                prev[0] = base_virt + phys;
+            }
+
+            prev = ((uint64_t *)(slice->addr + off));
+        }
     }
 
     return LOADER_SUCCESS;
@@ -0,0 +1,241 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <alloc_and_copy_mk_state.h>
+#include <alloc_and_copy_root_vp_state.h>
+#include <alloc_mk_args.h>
+#include <alloc_mk_stack.h>
+#include <check_cpu_configuration.h>
+#include <constants.h>
+#include <debug.h>
+#include <dump_mk_args.h>
+#include <dump_mk_stack.h>
+#include <dump_mk_state.h>
+#include <dump_root_vp_state.h>
+#include <free_mk_args.h>
+#include <free_mk_stack.h>
+#include <free_mk_state.h>
+#include <free_root_vp_state.h>
+#include <g_cpu_status.h>
+#include <g_ext_elf_files.h>
+#include <g_mk_args.h>
+#include <g_mk_debug_ring.h>
+#include <g_mk_elf_file.h>
+#include <g_mk_huge_pool.h>
+#include <g_mk_page_pool.h>
+#include <g_mk_page_pool_donated_ranges.h>
+#include <g_mk_root_page_table.h>
+#include <g_mk_stack.h>
+#include <g_mk_state.h>
+#include <g_root_vp_state.h>
+#include <get_mk_huge_pool_addr.h>
+#include <get_mk_page_pool_addr.h>
+#include <map_mk_args.h>
+#include <map_mk_stack.h>
+#include <map_mk_state.h>
+#include <map_root_vp_state.h>
+#include <platform.h>
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief This function allocates and maps all of the per-CPU resources
+ *     the microkernel needs to start on the provided CPU, and fills in the
+ *     CPU's mk_args. Once this function succeeds, the CPU is marked as
+ *     prepared, and start_vmm_per_cpu can be used to demote it. Since this
+ *     function adds to the microkernel's root page table, it must not be
+ *     called on more than one CPU at a time.
+ *
+ * <!-- inputs/outputs -->
+ *   @param cpu the id of the cpu to prepare
+ *   @return Returns 0 on success
+ */
+int64_t
+prepare_vmm_per_cpu(uint32_t const cpu)
+{
+    int64_t ret;
+    uint64_t idx;
+    uint8_t *addr;
+    uint64_t mk_stack_offs;
+    uint64_t mk_stack_virt;
+
+    if (((uint64_t)cpu) >= HYPERVISOR_MAX_PPS) {
+        bferror("cpu out of range");
+        return LOADER_FAILURE;
+    }
+
+    if (CPU_STATUS_STOPPED != g_cpu_status[cpu]) {
+        bferror("cannot prepare cpu that is already prepared/running/corrupt");
+        return LOADER_FAILURE;
+    }
+
+    if (platform_arch_init()) {
+        bferror("platform_arch_init failed");
+        return LOADER_FAILURE;
+    }
+
+    if (check_cpu_configuration()) {
+        bferror("check_cpu_configuration failed");
+        return LOADER_FAILURE;
+    }
+
+    mk_stack_offs = (HYPERVISOR_MK_STACK_SIZE + HYPERVISOR_PAGE_SIZE) * cpu;
+    mk_stack_virt = (g_mk_stack_virt + mk_stack_offs);
+
+    if (alloc_mk_stack(0U, &g_mk_stack[cpu])) {
+        bferror("alloc_mk_stack failed");
+        goto alloc_mk_stack_failed;
+    }
+
+    ret = alloc_and_copy_mk_state(
+        g_mk_root_page_table, &g_mk_elf_file, &g_mk_stack[cpu], mk_stack_virt, &g_mk_state[cpu]);
+
+    if (ret) {
+        bferror("alloc_and_copy_mk_state failed");
+        goto alloc_and_copy_mk_state_failed;
+    }
+
+    if (alloc_and_copy_root_vp_state(&g_root_vp_state[cpu])) {
+        bferror("alloc_and_copy_root_vp_state failed");
+        goto alloc_and_copy_root_vp_state_failed;
+    }
+
+    if (alloc_mk_args(&g_mk_args[cpu])) {
+        bferror("alloc_mk_args failed");
+        goto alloc_mk_args_failed;
+    }
+
+    if (map_mk_stack(&g_mk_stack[cpu], mk_stack_virt, g_mk_root_page_table)) {
+        bferror("map_mk_stack failed");
+        goto map_mk_stack_failed;
+    }
+
+    if (map_mk_state(g_mk_state[cpu], g_mk_root_page_table)) {
+        bferror("map_mk_state failed");
+        goto map_mk_state_failed;
+    }
+
+    if (map_root_vp_state(g_root_vp_state[cpu], g_mk_root_page_table)) {
+        bferror("map_root_vp_state failed");
+        goto map_root_vp_state_failed;
+    }
+
+    if (map_mk_args(g_mk_args[cpu], g_mk_root_page_table)) {
+        bferror("map_mk_args failed");
+        goto map_mk_args_failed;
+    }
+
+    g_mk_args[cpu]->ppid = ((uint16_t)cpu);
+
+    /**
+         * NOTE:
+         * - We cannot ask for the total number of CPUs on any AP from UEFI, so
+         *   we only do this for the BSP, and then use the BSP value to get the
+         *   total CPU count from that point on.
+         */
+
+    if (((uint64_t)0) == cpu) {
+        g_mk_args[cpu]->online_pps = ((uint16_t)platform_num_online_cpus());
+    }
+    else {
+        g_mk_args[cpu]->online_pps = g_mk_args[0]->online_pps;
+    }
+
+    g_mk_args[cpu]->mk_state = g_mk_state[cpu];
+    g_mk_args[cpu]->root_vp_state = g_root_vp_state[cpu];
+    g_mk_args[cpu]->debug_ring = g_mk_debug_ring;
+    g_mk_args[cpu]->page_pool_donations = g_mk_page_pool_donated_ranges;
+
+    g_mk_args[cpu]->mk_elf_file = g_mk_elf_file;
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_EXTENSIONS; ++idx) {
+        g_mk_args[cpu]->ext_elf_files[idx] = g_ext_elf_files[idx];
+    }
+
+    g_mk_args[cpu]->rpt = g_mk_root_page_table;
+    g_mk_args[cpu]->rpt_phys = platform_virt_to_phys(g_mk_root_page_table);
+
+    g_mk_args[cpu]->node = ((uint16_t)platform_cpu_to_node(cpu));
+
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_NUMA_NODES; ++idx) {
+        if (((void *)0) == g_mk_page_pool[idx].addr) {
+            continue;
+        }
+
+        ret = get_mk_page_pool_addr(&g_mk_page_pool[idx], HYPERVISOR_MK_PAGE_POOL_ADDR, &addr);
+        if (ret) {
+            bferror("get_mk_page_pool_addr failed");
+            goto get_mk_page_pool_addr_failed;
+        }
+
+        g_mk_args[cpu]->page_pool[idx].addr = addr;
+        g_mk_args[cpu]->page_pool[idx].size = g_mk_page_pool[idx].size;
+    }
+
+    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_HUGE_POOL_SEGMENTS; ++idx) {
+        if (((void *)0) == g_mk_huge_pool[idx].addr) {
+            continue;
+        }
+
+        ret = get_mk_huge_pool_addr(&g_mk_huge_pool[idx], HYPERVISOR_MK_HUGE_POOL_ADDR, &addr);
+        if (ret) {
+            bferror("get_mk_huge_pool_addr failed");
+            goto get_mk_huge_pool_addr_failed;
+        }
+
+        g_mk_args[cpu]->huge_pool[idx].addr = addr;
+        g_mk_args[cpu]->huge_pool[idx].size = g_mk_huge_pool[idx].size;
+        g_mk_args[cpu]->huge_pool_node[idx] = ((uint16_t)g_mk_huge_pool_node[idx]);
+    }
+
+#ifdef DEBUG_LOADER
+    dump_mk_stack(&g_mk_stack[cpu], cpu);
+    dump_mk_state(g_mk_state[cpu], cpu);
+    dump_root_vp_state(g_root_vp_state[cpu], cpu);
+    dump_mk_args(g_mk_args[cpu], cpu);
+#endif
+
+    g_cpu_status[cpu] = CPU_STATUS_PREPARED;
+    return LOADER_SUCCESS;
+
+get_mk_huge_pool_addr_failed:
+get_mk_page_pool_addr_failed:
+
+map_mk_args_failed:
+map_root_vp_state_failed:
+map_mk_state_failed:
+map_mk_stack_failed:
+
+    free_mk_args(&g_mk_args[cpu]);
+alloc_mk_args_failed:
+    free_root_vp_state(&g_root_vp_state[cpu]);
+alloc_and_copy_root_vp_state_failed:
+    free_mk_state(&g_mk_state[cpu]);
+alloc_and_copy_mk_state_failed:
+    free_mk_stack(&g_mk_stack[cpu]);
+alloc_mk_stack_failed:
+
+    return LOADER_FAILURE;
+}
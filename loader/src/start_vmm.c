@@ -51,6 +51,7 @@
 #include <g_mk_elf_segments.h>
 #include <g_mk_huge_pool.h>
 #include <g_mk_page_pool.h>
+#include <g_mk_page_pool_donated_ranges.h>
 #include <g_mk_root_page_table.h>
 #include <g_vmm_status.h>
 #include <map_ext_elf_files.h>
@@ -60,7 +61,9 @@
 #include <map_mk_elf_segments.h>
 #include <map_mk_huge_pool.h>
 #include <map_mk_page_pool.h>
+#include <map_mk_page_pool_donated_ranges.h>
 #include <platform.h>
+#include <prepare_vmm_per_cpu.h>
 #include <start_vmm_args_t.h>
 #include <start_vmm_per_cpu.h>
 #include <stop_and_free_the_vmm.h>
@@ -79,8 +82,16 @@ alloc_and_start_the_vmm(struct start_vmm_args_t const *const args)
         return LOADER_FAILURE;
     }
 
-    g_mk_debug_ring->epos = ((uint64_t)0);
-    g_mk_debug_ring->spos = ((uint64_t)0);
+    /**
+     * NOTE:
+     * - The debug ring is emptied, but seq is left alone so that anyone
+     *   following the debug ring (e.g., vmmctl dump --follow) sees a
+     *   single stream across restarts of the VMM. To keep epos in sync
+     *   with seq, the ring restarts where seq left off.
+     */
+
+    g_mk_debug_ring->epos = g_mk_debug_ring->seq % HYPERVISOR_DEBUG_RING_SIZE;
+    g_mk_debug_ring->spos = g_mk_debug_ring->epos;
 
     if (alloc_mk_root_page_table(&g_mk_root_page_table)) {
         bferror("alloc_and_copy_mk_root_page_table failed");
@@ -102,12 +113,12 @@ alloc_and_start_the_vmm(struct start_vmm_args_t const *const args)
         goto alloc_and_copy_mk_elf_segments_failed;
     }
 
-    if (alloc_mk_page_pool(args->num_pages_in_page_pool, &g_mk_page_pool)) {
+    if (alloc_mk_page_pool(args->num_pages_in_page_pool, g_mk_page_pool)) {
         bferror("alloc_mk_page_pool failed");
         goto alloc_mk_page_pool_failed;
     }
 
-    if (alloc_mk_huge_pool(0U, &g_mk_huge_pool)) {
+    if (alloc_mk_huge_pool(0U, g_mk_huge_pool, g_mk_huge_pool_node)) {
         bferror("alloc_mk_huge_pool failed");
         goto alloc_mk_huge_pool_failed;
     }
@@ -117,6 +128,11 @@ alloc_and_start_the_vmm(struct start_vmm_args_t const *const args)
         goto map_mk_debug_ring_failed;
     }
 
+    if (map_mk_page_pool_donated_ranges(g_mk_page_pool_donated_ranges, g_mk_root_page_table)) {
+        bferror("map_mk_page_pool_donated_ranges failed");
+        goto map_mk_page_pool_donated_ranges_failed;
+    }
+
     if (map_mk_code_aliases(&g_mk_code_aliases, g_mk_root_page_table)) {
         bferror("map_mk_code_aliases failed");
         goto map_mk_code_aliases_failed;
@@ -137,12 +153,12 @@ alloc_and_start_the_vmm(struct start_vmm_args_t const *const args)
         goto map_mk_elf_segments_failed;
     }
 
-    if (map_mk_page_pool(&g_mk_page_pool, g_mk_root_page_table)) {
+    if (map_mk_page_pool(g_mk_page_pool, g_mk_root_page_table)) {
         bferror("map_mk_page_pool failed");
         goto map_mk_page_pool_failed;
     }
 
-    if (map_mk_huge_pool(&g_mk_huge_pool, g_mk_root_page_table)) {
+    if (map_mk_huge_pool(g_mk_huge_pool, g_mk_root_page_table)) {
         bferror("map_mk_huge_pool failed");
         goto map_mk_huge_pool_failed;
     }
@@ -152,11 +168,25 @@ alloc_and_start_the_vmm(struct start_vmm_args_t const *const args)
     dump_mk_elf_file(&g_mk_elf_file);
     dump_ext_elf_files(g_ext_elf_files);
     dump_mk_elf_segments(g_mk_elf_segments);
-    dump_mk_page_pool(&g_mk_page_pool);
-    dump_mk_huge_pool(&g_mk_huge_pool);
+    dump_mk_page_pool(g_mk_page_pool);
+    dump_mk_huge_pool(g_mk_huge_pool, g_mk_huge_pool_node);
 #endif
 
-    if (platform_on_each_cpu(start_vmm_per_cpu, PLATFORM_FORWARD)) {
+    /**
+     * NOTE:
+     * - Each CPU is prepared one at a time as this adds to the root page
+     *   table. Once all of the CPUs are prepared, the BSP is started, which
+     *   initializes the microkernel, and then the APs are started at the
+     *   same time (on platforms that support it), which is where most of
+     *   the time is spent on a system with a lot of CPUs.
+     */
+
+    if (platform_on_each_cpu(prepare_vmm_per_cpu, PLATFORM_FORWARD)) {
+        bferror("prepare_vmm_per_cpu failed");
+        goto start_vmm_per_cpu_failed;
+    }
+
+    if (platform_on_each_cpu(start_vmm_per_cpu, PLATFORM_PARALLEL_FORWARD)) {
         bferror("start_vmm_per_cpu failed");
         goto start_vmm_per_cpu_failed;
     }
@@ -165,7 +195,7 @@ alloc_and_start_the_vmm(struct start_vmm_args_t const *const args)
     return LOADER_SUCCESS;
 
 start_vmm_per_cpu_failed:
-    if (platform_on_each_cpu(stop_vmm_per_cpu, PLATFORM_REVERSE)) {
+    if (platform_on_each_cpu(stop_vmm_per_cpu, PLATFORM_PARALLEL_REVERSE)) {
         bferror("stop_vmm_per_cpu failed");
     }
 
@@ -175,11 +205,12 @@ map_mk_elf_segments_failed:
 map_ext_elf_files_failed:
 map_mk_elf_file_failed:
 map_mk_code_aliases_failed:
+map_mk_page_pool_donated_ranges_failed:
 map_mk_debug_ring_failed:
 
-    free_mk_huge_pool(&g_mk_huge_pool);
+    free_mk_huge_pool(g_mk_huge_pool);
 alloc_mk_huge_pool_failed:
-    free_mk_page_pool(&g_mk_page_pool);
+    free_mk_page_pool(g_mk_page_pool);
 alloc_mk_page_pool_failed:
     free_mk_elf_segments(g_mk_elf_segments);
 alloc_and_copy_mk_elf_segments_failed:
@@ -24,39 +24,18 @@
  * SOFTWARE.
  */
 
-#include <alloc_and_copy_mk_state.h>
-#include <alloc_and_copy_root_vp_state.h>
-#include <alloc_mk_args.h>
-#include <alloc_mk_stack.h>
-#include <check_cpu_configuration.h>
 #include <constants.h>
 #include <debug.h>
 #include <demote.h>
-#include <dump_mk_args.h>
-#include <dump_mk_stack.h>
-#include <dump_mk_state.h>
-#include <dump_root_vp_state.h>
 #include <free_mk_args.h>
 #include <free_mk_stack.h>
 #include <free_mk_state.h>
 #include <free_root_vp_state.h>
 #include <g_cpu_status.h>
-#include <g_ext_elf_files.h>
 #include <g_mk_args.h>
-#include <g_mk_debug_ring.h>
-#include <g_mk_elf_file.h>
-#include <g_mk_huge_pool.h>
-#include <g_mk_page_pool.h>
-#include <g_mk_root_page_table.h>
 #include <g_mk_stack.h>
 #include <g_mk_state.h>
 #include <g_root_vp_state.h>
-#include <get_mk_huge_pool_addr.h>
-#include <get_mk_page_pool_addr.h>
-#include <map_mk_args.h>
-#include <map_mk_stack.h>
-#include <map_mk_state.h>
-#include <map_root_vp_state.h>
 #include <platform.h>
 #include <send_command_report_on.h>
 #include <types.h>
@@ -66,7 +45,11 @@
  *   @brief This function contains all of the code that is common between
  *     all archiectures and all platforms for starting the VMM. This function
  *     will call platform and architecture specific functions as needed.
- *     Unlike start_vmm, this function is called on each CPU.
+ *     Unlike start_vmm, this function is called on each CPU, and the CPU
+ *     must have already been prepared using prepare_vmm_per_cpu. Since
+ *     this function only uses the resources that belong to the provided
+ *     CPU, it can be called on all of the APs at the same time, once the
+ *     BSP has been started.
  *
  * <!-- inputs/outputs -->
  *   @param cpu the id of the cpu to start
@@ -75,131 +58,16 @@
 int64_t
 start_vmm_per_cpu(uint32_t const cpu)
 {
-    int64_t ret;
-    uint64_t idx;
-    uint8_t *addr;
-    uint64_t mk_stack_offs;
-    uint64_t mk_stack_virt;
-
     if (((uint64_t)cpu) >= HYPERVISOR_MAX_PPS) {
         bferror("cpu out of range");
         return LOADER_FAILURE;
     }
 
-    if (CPU_STATUS_STOPPED != g_cpu_status[cpu]) {
-        bferror("cannot start cpu that is already running/corrupt");
-        return LOADER_FAILURE;
-    }
-
-    if (platform_arch_init()) {
-        bferror("platform_arch_init failed");
+    if (CPU_STATUS_PREPARED != g_cpu_status[cpu]) {
+        bferror("cannot start cpu that has not been prepared");
         return LOADER_FAILURE;
     }
 
-    if (check_cpu_configuration()) {
-        bferror("check_cpu_configuration failed");
-        return LOADER_FAILURE;
-    }
-
-    mk_stack_offs = (HYPERVISOR_MK_STACK_SIZE + HYPERVISOR_PAGE_SIZE) * cpu;
-    mk_stack_virt = (g_mk_stack_virt + mk_stack_offs);
-
-    if (alloc_mk_stack(0U, &g_mk_stack[cpu])) {
-        bferror("alloc_mk_stack failed");
-        goto alloc_mk_stack_failed;
-    }
-
-    ret = alloc_and_copy_mk_state(
-        g_mk_root_page_table, &g_mk_elf_file, &g_mk_stack[cpu], mk_stack_virt, &g_mk_state[cpu]);
-
-    if (ret) {
-        bferror("alloc_and_copy_mk_state failed");
-        goto alloc_and_copy_mk_state_failed;
-    }
-
-    if (alloc_and_copy_root_vp_state(&g_root_vp_state[cpu])) {
-        bferror("alloc_and_copy_root_vp_state failed");
-        goto alloc_and_copy_root_vp_state_failed;
-    }
-
-    if (alloc_mk_args(&g_mk_args[cpu])) {
-        bferror("alloc_mk_args failed");
-        goto alloc_mk_args_failed;
-    }
-
-    if (map_mk_stack(&g_mk_stack[cpu], mk_stack_virt, g_mk_root_page_table)) {
-        bferror("map_mk_stack failed");
-        goto map_mk_stack_failed;
-    }
-
-    if (map_mk_state(g_mk_state[cpu], g_mk_root_page_table)) {
-        bferror("map_mk_state failed");
-        goto map_mk_state_failed;
-    }
-
-    if (map_root_vp_state(g_root_vp_state[cpu], g_mk_root_page_table)) {
-        bferror("map_root_vp_state failed");
-        goto map_root_vp_state_failed;
-    }
-
-    if (map_mk_args(g_mk_args[cpu], g_mk_root_page_table)) {
-        bferror("map_mk_args failed");
-        goto map_mk_args_failed;
-    }
-
-    g_mk_args[cpu]->ppid = ((uint16_t)cpu);
-
-    /**
-         * NOTE:
-         * - We cannot ask for the total number of CPUs on any AP from UEFI, so
-         *   we only do this for the BSP, and then use the BSP value to get the
-         *   total CPU count from that point on.
-         */
-
-    if (((uint64_t)0) == cpu) {
-        g_mk_args[cpu]->online_pps = ((uint16_t)platform_num_online_cpus());
-    }
-    else {
-        g_mk_args[cpu]->online_pps = g_mk_args[0]->online_pps;
-    }
-
-    g_mk_args[cpu]->mk_state = g_mk_state[cpu];
-    g_mk_args[cpu]->root_vp_state = g_root_vp_state[cpu];
-    g_mk_args[cpu]->debug_ring = g_mk_debug_ring;
-
-    g_mk_args[cpu]->mk_elf_file = g_mk_elf_file;
-    for (idx = ((uint64_t)0); idx < HYPERVISOR_MAX_EXTENSIONS; ++idx) {
-        g_mk_args[cpu]->ext_elf_files[idx] = g_ext_elf_files[idx];
-    }
-
-    g_mk_args[cpu]->rpt = g_mk_root_page_table;
-    g_mk_args[cpu]->rpt_phys = platform_virt_to_phys(g_mk_root_page_table);
-
-    ret = get_mk_page_pool_addr(&g_mk_page_pool, HYPERVISOR_MK_PAGE_POOL_ADDR, &addr);
-    if (ret) {
-        bferror("get_mk_page_pool_addr failed");
-        goto get_mk_page_pool_addr_failed;
-    }
-
-    g_mk_args[cpu]->page_pool.addr = addr;
-    g_mk_args[cpu]->page_pool.size = g_mk_page_pool.size;
-
-    ret = get_mk_huge_pool_addr(&g_mk_huge_pool, HYPERVISOR_MK_HUGE_POOL_ADDR, &addr);
-    if (ret) {
-        bferror("get_mk_huge_pool_addr failed");
-        goto get_mk_huge_pool_addr_failed;
-    }
-
-    g_mk_args[cpu]->huge_pool.addr = addr;
-    g_mk_args[cpu]->huge_pool.size = g_mk_huge_pool.size;
-
-#ifdef DEBUG_LOADER
-    dump_mk_stack(&g_mk_stack[cpu], cpu);
-    dump_mk_state(g_mk_state[cpu], cpu);
-    dump_root_vp_state(g_root_vp_state[cpu], cpu);
-    dump_mk_args(g_mk_args[cpu], cpu);
-#endif
-
     if (demote(g_mk_args[cpu], g_mk_state[cpu], g_root_vp_state[cpu])) {
         platform_dump_vmm();
         bferror("demote failed");
@@ -212,22 +80,11 @@ start_vmm_per_cpu(uint32_t const cpu)
 
 demote_failed:
 
-get_mk_huge_pool_addr_failed:
-get_mk_page_pool_addr_failed:
-
-map_mk_args_failed:
-map_root_vp_state_failed:
-map_mk_state_failed:
-map_mk_stack_failed:
-
     free_mk_args(&g_mk_args[cpu]);
-alloc_mk_args_failed:
     free_root_vp_state(&g_root_vp_state[cpu]);
-alloc_and_copy_root_vp_state_failed:
     free_mk_state(&g_mk_state[cpu]);
-alloc_and_copy_mk_state_failed:
     free_mk_stack(&g_mk_stack[cpu]);
-alloc_mk_stack_failed:
 
+    g_cpu_status[cpu] = CPU_STATUS_STOPPED;
     return LOADER_FAILURE;
 }
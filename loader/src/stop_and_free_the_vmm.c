@@ -30,12 +30,15 @@
 #include <free_mk_elf_segments.h>
 #include <free_mk_huge_pool.h>
 #include <free_mk_page_pool.h>
+#include <free_mk_page_pool_donations.h>
 #include <free_mk_root_page_table.h>
 #include <g_ext_elf_files.h>
 #include <g_mk_elf_file.h>
 #include <g_mk_elf_segments.h>
 #include <g_mk_huge_pool.h>
 #include <g_mk_page_pool.h>
+#include <g_mk_page_pool_donated_ranges.h>
+#include <g_mk_page_pool_donations.h>
 #include <g_mk_root_page_table.h>
 #include <g_vmm_status.h>
 #include <platform.h>
@@ -62,13 +65,14 @@ stop_and_free_the_vmm(void)
         return;
     }
 
-    if (platform_on_each_cpu(stop_vmm_per_cpu, PLATFORM_REVERSE)) {
+    if (platform_on_each_cpu(stop_vmm_per_cpu, PLATFORM_PARALLEL_REVERSE)) {
         bferror("stop_vmm_per_cpu failed");
         goto stop_vmm_per_cpu_failed;
     }
 
-    free_mk_huge_pool(&g_mk_huge_pool);
-    free_mk_page_pool(&g_mk_page_pool);
+    free_mk_huge_pool(g_mk_huge_pool);
+    free_mk_page_pool(g_mk_page_pool);
+    free_mk_page_pool_donations(g_mk_page_pool_donations, g_mk_page_pool_donated_ranges);
     free_mk_elf_segments(g_mk_elf_segments);
     free_ext_elf_files(g_ext_elf_files);
     free_mk_elf_file(&g_mk_elf_file);
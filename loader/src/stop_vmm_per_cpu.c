@@ -67,6 +67,17 @@ stop_vmm_per_cpu(uint32_t const cpu)
         return LOADER_FAILURE;
     }
 
+    /**
+     * NOTE:
+     * - A prepared CPU has all of its resources, but it was never
+     *   demoted (e.g., the BSP failed to start, so the APs were never
+     *   started), so all we need to do is free its resources.
+     */
+
+    if (CPU_STATUS_PREPARED == g_cpu_status[cpu]) {
+        goto free_resources;
+    }
+
     send_command_report_off();
 
     if (send_command_stop()) {
@@ -75,6 +86,7 @@ stop_vmm_per_cpu(uint32_t const cpu)
         return LOADER_FAILURE;
     }
 
+free_resources:
     free_mk_args(&g_mk_args[cpu]);
     free_root_vp_state(&g_root_vp_state[cpu]);
     free_mk_state(&g_mk_state[cpu]);
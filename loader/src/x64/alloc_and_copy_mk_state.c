@@ -34,6 +34,7 @@
 #include <esr_gpf.h>
 #include <esr_nmi.h>
 #include <esr_pf.h>
+#include <intrinsic_cpuid.h>
 #include <intrinsic_rdmsr.h>
 #include <intrinsic_scr0.h>
 #include <intrinsic_scr4.h>
@@ -61,6 +62,19 @@
 /** @brief defines the default value of CR4 bits that must be off */
 // #define DEFAULT_CR4_OFF ((uint64_t)0xFFFFFFFFFF9FFFFF)
 #define DEFAULT_CR4_OFF ((uint64_t)0xFFFFFFFFFFFFFFFF)
+/** @brief defines the PCIDE CR4 field */
+#define CR4_PCIDE (((uint64_t)1) << ((uint64_t)17))
+
+/** @brief defines the CPUID leaf for the max supported leaf */
+#define CPUID_LEAF_MAX ((uint32_t)0x0)
+/** @brief defines the CPUID leaf for feature information */
+#define CPUID_LEAF_FEATURE ((uint32_t)0x1)
+/** @brief define the CPUID feature bit for PCID */
+#define CPUID_FEATURE_ECX_PCID (((uint32_t)1) << ((uint32_t)17))
+/** @brief defines the CPUID leaf for extended feature information */
+#define CPUID_LEAF_EXT_FEATURE ((uint32_t)0x7)
+/** @brief define the CPUID extended feature bit for INVPCID */
+#define CPUID_EXT_FEATURE_EBX_INVPCID (((uint32_t)1) << ((uint32_t)10))
 
 /** @brief defines the MSR_IA32_EFER MSR */
 #define MSR_IA32_EFER ((uint32_t)0xC0000080)
@@ -167,6 +181,51 @@
 /** @brief defines the FMASK MSR used by the microkernel */
 #define MK_MSR_IA32_FMASK ((uint64_t)0xFFFFFFFFFFFBFFFD)
 
+/**
+ * <!-- description -->
+ *   @brief Returns LOADER_SUCCESS if the CPU supports both PCID and
+ *     INVPCID. The microkernel only tags its page tables with PCIDs if
+ *     it can also invalidate them using INVPCID.
+ *
+ * <!-- inputs/outputs -->
+ *   @return Returns LOADER_SUCCESS if PCID and INVPCID are supported,
+ *     LOADER_FAILURE otherwise.
+ */
+static inline int64_t
+check_for_pcid(void)
+{
+    uint32_t eax;
+    uint32_t ebx;
+    uint32_t ecx;
+    uint32_t edx;
+
+    eax = CPUID_LEAF_MAX;
+    ecx = 0U;
+    intrinsic_cpuid(&eax, &ebx, &ecx, &edx);
+
+    if (eax < CPUID_LEAF_EXT_FEATURE) {
+        return LOADER_FAILURE;
+    }
+
+    eax = CPUID_LEAF_FEATURE;
+    ecx = 0U;
+    intrinsic_cpuid(&eax, &ebx, &ecx, &edx);
+
+    if (((uint32_t)0) == (ecx & CPUID_FEATURE_ECX_PCID)) {
+        return LOADER_FAILURE;
+    }
+
+    eax = CPUID_LEAF_EXT_FEATURE;
+    ecx = 0U;
+    intrinsic_cpuid(&eax, &ebx, &ecx, &edx);
+
+    if (((uint32_t)0) == (ebx & CPUID_EXT_FEATURE_EBX_INVPCID)) {
+        return LOADER_FAILURE;
+    }
+
+    return LOADER_SUCCESS;
+}
+
 /**
  * <!-- description -->
  *   @brief The function's main purpose is to set up the state for the
@@ -652,6 +711,21 @@ alloc_and_copy_mk_state(
     (*state)->cr3 = platform_virt_to_phys(rpt);
     (*state)->cr4 = (intrinsic_scr4() | DEFAULT_CR4) & DEFAULT_CR4_OFF;
 
+    /**
+     * NOTE:
+     * - The microkernel tags the extension's direct maps with PCIDs so
+     *   that switching between them does not flush the TLB. The root OS
+     *   might have PCID enabled without INVPCID, in which case we turn it
+     *   off for the microkernel as it needs INVPCID to invalidate them.
+     */
+
+    if (LOADER_SUCCESS == check_for_pcid()) {
+        (*state)->cr4 |= CR4_PCIDE;
+    }
+    else {
+        (*state)->cr4 &= ~CR4_PCIDE;
+    }
+
     if (((uint64_t)0) == (*state)->cr3) {
         bferror("platform_virt_to_phys failed");
         goto platform_virt_to_phys_cr3_failed;
@@ -0,0 +1,57 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <check_top_level_table.h>
+#include <pml4t_t.h>
+#include <pml4to.h>
+#include <root_page_table_t.h>
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Returns 0 if the top level entry of the provided root page
+ *     table that covers the provided virtual address already points to a
+ *     table. Once the microkernel is running, each of its root page
+ *     tables has its own copy of the top level entries, and only the
+ *     tables below the top level are shared with the loader. This means
+ *     that a page can only be mapped into a running microkernel if no new
+ *     top level entry is needed, which is what this function checks.
+ *
+ * <!-- inputs/outputs -->
+ *   @param virt the virtual address to check
+ *   @param rpt the root page table to check
+ *   @return 0 if the top level entry already exists, LOADER_FAILURE
+ *     otherwise.
+ */
+int64_t
+check_top_level_table(uint64_t const virt, root_page_table_t const *const rpt)
+{
+    if (((void *)0) == rpt->tables[pml4to(virt)]) {
+        return LOADER_FAILURE;
+    }
+
+    return LOADER_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <constants.h>
+#include <cpuid_commands.h>
+#include <debug.h>
+#include <intrinsic_cpuid.h>
+#include <types.h>
+
+/**
+ * <!-- description -->
+ *   @brief Gives the hypervisor a donate_pages_t listing the physical
+ *     address of each page that was mapped into the microkernel's page
+ *     pool, and that should be added to the provided NUMA node's free
+ *     list.
+ *
+ *   @note The list is page aligned, so the node is stored in the lower
+ *     12 bits of EDX, with the rest of EDX storing bits 31:12 of the
+ *     list and EBX storing bits 63:32 of the list.
+ *
+ * <!-- inputs/outputs -->
+ *   @param list the physical address of the donate_pages_t
+ *   @param node the NUMA node the pages were allocated from
+ *   @return 0 on success, LOADER_FAILURE on failure.
+ */
+int64_t
+send_command_donate_pages(uint64_t const list, uint32_t const node)
+{
+    uint32_t eax;
+    uint32_t ebx;
+    uint32_t ecx;
+    uint32_t edx;
+
+    if (((uint64_t)0) != (list & (HYPERVISOR_PAGE_SIZE - ((uint64_t)1)))) {
+        bferror_x64("list is not page aligned", list);
+        return LOADER_FAILURE;
+    }
+
+    if (node > ((uint32_t)0xFFFU)) {
+        bferror_d32("node is out of range", node);
+        return LOADER_FAILURE;
+    }
+
+    eax = CPUID_COMMAND_EAX;
+    ebx = ((uint32_t)(list >> ((uint64_t)32)));
+    ecx = CPUID_COMMAND_ECX_DONATE_PAGES;
+    edx = (((uint32_t)list) | node);
+    intrinsic_cpuid(&eax, &ebx, &ecx, &edx);
+
+    if (((uint32_t)0) != eax) {
+        bferror("donate pages cpuid command failed");
+        return LOADER_FAILURE;
+    }
+
+    return LOADER_SUCCESS;
+}
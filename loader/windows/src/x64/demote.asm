@@ -382,16 +382,21 @@ gdt_and_cs_loaded:
     mov rax, [r14 + SS_OFFSET_CR2]
     mov cr2, rax
 
-    mov rax, cr4
-    mov [r15 + SS_OFFSET_CR4], rax
-    mov rax, [r14 + SS_OFFSET_CR4]
-    mov cr4, rax
+    ; Notes:
+    ; - CR3 is loaded before CR4 as the microkernel's CR4 might enable
+    ;   PCID, which can only be done while the PCID in CR3 is 0, and
+    ;   that is only guaranteed for the microkernel's CR3.
 
     mov rax, cr3
     mov [r15 + SS_OFFSET_CR3], rax
     mov rax, [r14 + SS_OFFSET_CR3]
     mov cr3, rax
 
+    mov rax, cr4
+    mov [r15 + SS_OFFSET_CR4], rax
+    mov rax, [r14 + SS_OFFSET_CR4]
+    mov cr4, rax
+
     ; **************************************************************************
     ; Stack
     ; **************************************************************************
@@ -29,19 +29,34 @@
 
 #include <bsl/char_type.hpp>
 #include <bsl/cstr_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
 
 namespace bsl
 {
     /// <!-- description -->
     ///   @brief Outputs a character.
     ///
+    /// <!-- notes -->
+    ///   @note Characters are not sent to the microkernel one at a time.
+    ///     Instead, they are appended to this PP's log buffer in the TLS
+    ///     block, and the log buffer is only flushed to the microkernel
+    ///     when a newline is written, or when the log buffer is full,
+    ///     meaning a line of output costs a single syscall.
+    ///
     /// <!-- inputs/outputs -->
     ///   @param c the character to output
     ///
     inline void
     fputc(bsl::char_type const c) noexcept
     {
-        syscall::bf_debug_op_write_c(c);
+        auto const len{syscall::bf_tls_log_write_c(c)};
+        if (('\n' == c) || (len >= syscall::TLS_LOG_BUF_SIZE)) {
+            syscall::bf_debug_op_flush_log();
+        }
+        else {
+            bsl::touch();
+        }
     }
 
     /// <!-- description -->
@@ -53,7 +68,9 @@ namespace bsl
     inline void
     fputs(bsl::cstr_type const str) noexcept
     {
-        syscall::bf_debug_op_write_str(str);
+        for (bsl::safe_uintmax i{}; str[i.get()] != '\0'; ++i) {
+            bsl::fputc(str[i.get()]);
+        }
     }
 }
 
@@ -48,12 +48,16 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
     hypervisor_target_source(syscall src/x64/bf_callback_op_register_fail_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_callback_op_register_vmexit_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_control_op_exit_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_control_op_trace_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_control_op_wait_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_debug_op_dump_ext_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_debug_op_dump_huge_pool_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_debug_op_dump_page_pool_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_debug_op_dump_trace_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_debug_op_dump_vm_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_debug_op_dump_vmexit_log_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_debug_op_dump_vmexit_stats_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_debug_op_flush_log_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_debug_op_dump_vp_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_debug_op_dump_vps_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_debug_op_out_impl.S ${HEADERS})
@@ -69,8 +73,11 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
     hypervisor_target_source(syscall src/x64/bf_mem_op_alloc_heap_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_mem_op_alloc_huge_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_mem_op_alloc_page_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_mem_op_alloc_pages_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_mem_op_donate_pages_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_mem_op_free_huge_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_mem_op_free_page_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_mem_op_page_pool_low_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_tls_extid_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_tls_online_pps_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_tls_ppid_impl.S ${HEADERS})
@@ -89,6 +96,12 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
     hypervisor_target_source(syscall src/x64/bf_tls_r13_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_tls_r14_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_tls_r15_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_tls_exit_rip_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_tls_exit_instruction_length_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_tls_exit_info1_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_tls_exit_info2_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_tls_exit_int_info_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_tls_log_write_c_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_tls_set_rax_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_tls_set_rbx_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_tls_set_rcx_impl.S ${HEADERS})
@@ -120,6 +133,7 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
     hypervisor_target_source(syscall src/x64/bf_vps_op_destroy_vps_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_init_as_root_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_promote_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_vps_op_read_batch_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_read_reg_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_read8_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_read16_impl.S ${HEADERS})
@@ -127,6 +141,8 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
     hypervisor_target_source(syscall src/x64/bf_vps_op_read64_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_run_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_run_current_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_vps_op_set_exit_policy_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/x64/bf_vps_op_write_batch_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_write_reg_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_write8_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/x64/bf_vps_op_write16_impl.S ${HEADERS})
@@ -139,12 +155,16 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
     hypervisor_target_source(syscall src/arm/aarch64/bf_callback_op_register_fail_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_callback_op_register_vmexit_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_control_op_exit_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_control_op_trace_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_control_op_wait_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_ext_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_huge_pool_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_page_pool_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_trace_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_vm_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_vmexit_log_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_vmexit_stats_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_flush_log_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_vp_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_dump_vps_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_debug_op_out_impl.S ${HEADERS})
@@ -160,8 +180,11 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
     hypervisor_target_source(syscall src/arm/aarch64/bf_mem_op_alloc_heap_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_mem_op_alloc_huge_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_mem_op_alloc_page_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_mem_op_alloc_pages_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_mem_op_donate_pages_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_mem_op_free_huge_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_mem_op_free_page_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_mem_op_page_pool_low_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_extid_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_online_pps_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_ppid_impl.S ${HEADERS})
@@ -180,6 +203,12 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_r13_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_r14_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_r15_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_tls_exit_rip_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_tls_exit_instruction_length_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_tls_exit_info1_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_tls_exit_info2_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_tls_exit_int_info_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_tls_log_write_c_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_set_rax_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_set_rbx_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_tls_set_rcx_impl.S ${HEADERS})
@@ -211,6 +240,7 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_destroy_vps_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_init_as_root_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_promote_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_read_batch_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_read_reg_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_read8_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_read16_impl.S ${HEADERS})
@@ -218,6 +248,8 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "aarch64")
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_read64_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_run_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_run_current_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_set_exit_policy_impl.S ${HEADERS})
+    hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_write_batch_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_write_reg_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_write8_impl.S ${HEADERS})
     hypervisor_target_source(syscall src/arm/aarch64/bf_vps_op_write16_impl.S ${HEADERS})
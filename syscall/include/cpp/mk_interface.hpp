@@ -37,6 +37,7 @@
 #include <bsl/is_void.hpp>
 #include <bsl/likely.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
 #include <bsl/unlikely.hpp>
 
 namespace syscall
@@ -273,6 +274,137 @@ namespace syscall
         failure = static_cast<bsl::uint64>(1)
     };
 
+    // -------------------------------------------------------------------------
+    // VPS Batch Types
+    // -------------------------------------------------------------------------
+
+    /// @brief Defines how a bf_vps_batch_t entry accesses the VPS
+    // IWYU is more important here, and this rule would make this interface
+    // needlessly overcomplicated.
+    // NOLINTNEXTLINE(bsl-user-defined-type-names-match-header-name)
+    enum class bf_vps_batch_type_t : bsl::uint64
+    {
+        /// @brief the index is a bf_reg_t (i.e., bf_vps_op_read_reg)
+        reg = static_cast<bsl::uint64>(0),
+        /// @brief the index is an 8bit field (i.e., bf_vps_op_read8)
+        field8 = static_cast<bsl::uint64>(1),
+        /// @brief the index is a 16bit field (i.e., bf_vps_op_read16)
+        field16 = static_cast<bsl::uint64>(2),
+        /// @brief the index is a 32bit field (i.e., bf_vps_op_read32)
+        field32 = static_cast<bsl::uint64>(3),
+        /// @brief the index is a 64bit field (i.e., bf_vps_op_read64)
+        field64 = static_cast<bsl::uint64>(4)
+    };
+
+    /// @class syscall::bf_vps_batch_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a single entry in the descriptor array given to
+    ///     bf_vps_op_read_batch and bf_vps_op_write_batch. Each entry
+    ///     describes one register or field to read or write.
+    ///
+    // IWYU is more important here, and this rule would make this interface
+    // needlessly overcomplicated.
+    // NOLINTNEXTLINE(bsl-user-defined-type-names-match-header-name)
+    struct bf_vps_batch_t final
+    {
+        /// @brief defines how index should be interpreted
+        bf_vps_batch_type_t type;
+        /// @brief the bf_reg_t or HVE specific index to read/write
+        bf_uint64_t index;
+        /// @brief the value read, or the value to write
+        bf_uint64_t value;
+    };
+
+    /// @brief Defines the max number of entries in a single VPS batch
+    constexpr bsl::safe_uintmax BF_VPS_BATCH_MAX{bsl::to_umax(128U)};
+
+    // -------------------------------------------------------------------------
+    // Exit Policy Types
+    // -------------------------------------------------------------------------
+
+    /// @brief Defines which VMExits a bf_exit_policy_t entry handles
+    // IWYU is more important here, and this rule would make this interface
+    // needlessly overcomplicated.
+    // NOLINTNEXTLINE(bsl-user-defined-type-names-match-header-name)
+    enum class bf_exit_policy_type_t : bsl::uint64
+    {
+        /// @brief CPUID with a leaf (EAX) in [first, last] returns the
+        ///   native result, masked using the entry's clear/set masks
+        cpuid = static_cast<bsl::uint64>(1),
+        /// @brief RDMSR with an MSR (ECX) in [first, last] returns the
+        ///   native value of the MSR
+        rdmsr = static_cast<bsl::uint64>(2),
+        /// @brief a VMExit with an exit reason in [first, last] does
+        ///   nothing other than advance the IP. Every exit reason in the
+        ///   range must be caused by an instruction.
+        advance_ip = static_cast<bsl::uint64>(3)
+    };
+
+    /// @class syscall::bf_exit_policy_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a single entry in the exit policy given to
+    ///     bf_vps_op_set_exit_policy. VMExits that match an entry are
+    ///     handled by the microkernel, which advances the IP and runs
+    ///     the VPS again without calling the extension. For CPUID, each
+    ///     resulting register is computed as (native & ~clear) | set, so
+    ///     an entry with all of its masks set to 0 is a passthrough.
+    ///
+    // IWYU is more important here, and this rule would make this interface
+    // needlessly overcomplicated.
+    // NOLINTNEXTLINE(bsl-user-defined-type-names-match-header-name)
+    struct bf_exit_policy_t final
+    {
+        /// @brief defines which VMExits this entry handles
+        bf_exit_policy_type_t type;
+        /// @brief the first leaf, MSR or exit reason this entry handles
+        bf_uint64_t first;
+        /// @brief the last leaf, MSR or exit reason this entry handles
+        bf_uint64_t last;
+
+        /// @brief the bits to clear in EAX (cpuid only)
+        bf_uint32_t eax_clear;
+        /// @brief the bits to set in EAX (cpuid only)
+        bf_uint32_t eax_set;
+        /// @brief the bits to clear in EBX (cpuid only)
+        bf_uint32_t ebx_clear;
+        /// @brief the bits to set in EBX (cpuid only)
+        bf_uint32_t ebx_set;
+        /// @brief the bits to clear in ECX (cpuid only)
+        bf_uint32_t ecx_clear;
+        /// @brief the bits to set in ECX (cpuid only)
+        bf_uint32_t ecx_set;
+        /// @brief the bits to clear in EDX (cpuid only)
+        bf_uint32_t edx_clear;
+        /// @brief the bits to set in EDX (cpuid only)
+        bf_uint32_t edx_set;
+    };
+
+    /// @brief Defines the max number of entries in a single exit policy
+    constexpr bsl::safe_uintmax BF_EXIT_POLICY_MAX{bsl::to_umax(16U)};
+
+    /// @class syscall::bf_page_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a single entry in the array given to
+    ///     bf_mem_op_alloc_pages. Each entry is filled in with the virtual
+    ///     and physical address of one of the resulting pages.
+    ///
+    // IWYU is more important here, and this rule would make this interface
+    // needlessly overcomplicated.
+    // NOLINTNEXTLINE(bsl-user-defined-type-names-match-header-name)
+    struct bf_page_t final
+    {
+        /// @brief the virtual address of the page
+        bf_ptr_t virt;
+        /// @brief the physical address of the page
+        bf_uint64_t phys;
+    };
+
+    /// @brief Defines the max number of pages in a single bf_mem_op_alloc_pages
+    constexpr bsl::safe_uintmax BF_MEM_OP_ALLOC_PAGES_MAX{bsl::to_umax(256U)};
+
     // -------------------------------------------------------------------------
     // Bootstrap Callback Handler Type
     // -------------------------------------------------------------------------
@@ -611,6 +743,22 @@ namespace syscall
     constexpr bsl::safe_uintmax TLS_OFFSET_R14{bsl::to_umax(0x868U)};
     /// @brief stores the offset for r15
     constexpr bsl::safe_uintmax TLS_OFFSET_R15{bsl::to_umax(0x870U)};
+    /// @brief stores the offset for the guest's rip at the time of the VMExit
+    constexpr bsl::safe_uintmax TLS_OFFSET_EXIT_RIP{bsl::to_umax(0x878U)};
+    /// @brief stores the offset for the VMExit's instruction length
+    constexpr bsl::safe_uintmax TLS_OFFSET_EXIT_INSTRUCTION_LENGTH{bsl::to_umax(0x880U)};
+    /// @brief stores the offset for exit info 1 (Intel: qualification, AMD: EXITINFO1)
+    constexpr bsl::safe_uintmax TLS_OFFSET_EXIT_INFO1{bsl::to_umax(0x888U)};
+    /// @brief stores the offset for exit info 2 (Intel: guest phys addr, AMD: EXITINFO2)
+    constexpr bsl::safe_uintmax TLS_OFFSET_EXIT_INFO2{bsl::to_umax(0x890U)};
+    /// @brief stores the offset for the int info (Intel: int info, AMD: EXITINTINFO)
+    constexpr bsl::safe_uintmax TLS_OFFSET_EXIT_INT_INFO{bsl::to_umax(0x898U)};
+    /// @brief stores the offset of the number of bytes in the log buffer
+    constexpr bsl::safe_uintmax TLS_OFFSET_LOG_LEN{bsl::to_umax(0x8F8U)};
+    /// @brief stores the offset of the log buffer
+    constexpr bsl::safe_uintmax TLS_OFFSET_LOG_BUF{bsl::to_umax(0x900U)};
+    /// @brief stores the total number of bytes the log buffer can hold
+    constexpr bsl::safe_uintmax TLS_LOG_BUF_SIZE{bsl::to_umax(0x6F0U)};
     /// @brief stores the offset of the active extid
     constexpr bsl::safe_uintmax TLS_OFFSET_ACTIVE_EXTID{bsl::to_umax(0xFF0U)};
     /// @brief stores the offset of the active vmid
@@ -864,6 +1012,56 @@ namespace syscall
     ///
     extern "C" void bf_tls_set_r15_impl(bf_uint64_t const val) noexcept;
 
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_tls_exit_rip.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_tls_exit_rip_impl() noexcept -> bf_uint64_t;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_tls_exit_instruction_length.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_tls_exit_instruction_length_impl() noexcept -> bf_uint64_t;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_tls_exit_info1.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_tls_exit_info1_impl() noexcept -> bf_uint64_t;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_tls_exit_info2.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_tls_exit_info2_impl() noexcept -> bf_uint64_t;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_tls_exit_int_info.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_tls_exit_int_info_impl() noexcept -> bf_uint64_t;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_tls_log_write_c.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param c n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_tls_log_write_c_impl(bsl::char_type const c) noexcept
+        -> bf_uint64_t;
+
     /// <!-- description -->
     ///   @brief Implements the ABI for bf_tls_extid.
     ///
@@ -1336,6 +1534,97 @@ namespace syscall
         bf_tls_set_r15_impl(val.get());
     }
 
+    /// <!-- description -->
+    ///   @brief Returns the value of tls.exit_rip, which is set by the
+    ///     microkernel on every VMExit and does not require a syscall.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle reserved for unit testing
+    ///   @return Returns the value of tls.exit_rip
+    ///
+    [[nodiscard]] inline auto
+    bf_tls_exit_rip(bf_handle_t const &handle) noexcept -> bsl::safe_uintmax
+    {
+        bsl::discard(handle);
+        return {bf_tls_exit_rip_impl()};
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the value of tls.exit_instruction_length, which is set by the
+    ///     microkernel on every VMExit and does not require a syscall.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle reserved for unit testing
+    ///   @return Returns the value of tls.exit_instruction_length
+    ///
+    [[nodiscard]] inline auto
+    bf_tls_exit_instruction_length(bf_handle_t const &handle) noexcept -> bsl::safe_uintmax
+    {
+        bsl::discard(handle);
+        return {bf_tls_exit_instruction_length_impl()};
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the value of tls.exit_info1, which is set by the
+    ///     microkernel on every VMExit and does not require a syscall.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle reserved for unit testing
+    ///   @return Returns the value of tls.exit_info1
+    ///
+    [[nodiscard]] inline auto
+    bf_tls_exit_info1(bf_handle_t const &handle) noexcept -> bsl::safe_uintmax
+    {
+        bsl::discard(handle);
+        return {bf_tls_exit_info1_impl()};
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the value of tls.exit_info2, which is set by the
+    ///     microkernel on every VMExit and does not require a syscall.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle reserved for unit testing
+    ///   @return Returns the value of tls.exit_info2
+    ///
+    [[nodiscard]] inline auto
+    bf_tls_exit_info2(bf_handle_t const &handle) noexcept -> bsl::safe_uintmax
+    {
+        bsl::discard(handle);
+        return {bf_tls_exit_info2_impl()};
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the value of tls.exit_int_info, which is set by the
+    ///     microkernel on every VMExit and does not require a syscall.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle reserved for unit testing
+    ///   @return Returns the value of tls.exit_int_info
+    ///
+    [[nodiscard]] inline auto
+    bf_tls_exit_int_info(bf_handle_t const &handle) noexcept -> bsl::safe_uintmax
+    {
+        bsl::discard(handle);
+        return {bf_tls_exit_int_info_impl()};
+    }
+
+    /// <!-- description -->
+    ///   @brief Appends a character to this PP's log buffer in the TLS
+    ///     block. The microkernel does not output anything until
+    ///     bf_debug_op_flush_log is called, and if the log buffer is
+    ///     full, the character is dropped.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param c the character to append to the log buffer
+    ///   @return Returns the number of characters in the log buffer
+    ///
+    [[nodiscard]] inline auto
+    bf_tls_log_write_c(bsl::char_type const c) noexcept -> bsl::safe_uintmax
+    {
+        return {bf_tls_log_write_c_impl(c)};
+    }
+
     /// <!-- description -->
     ///   @brief Returns the value of tls.extid
     ///
@@ -1454,6 +1743,44 @@ namespace syscall
         bf_control_op_wait_impl();
     }
 
+    // -------------------------------------------------------------------------
+    // bf_control_op_trace
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_control_op_trace.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///
+    extern "C" void bf_control_op_trace_impl(    // --
+        bf_uint64_t const reg0_in) noexcept;
+
+    /// @brief Defines the syscall index for bf_control_op_trace
+    constexpr bsl::safe_uint64 BF_CONTROL_OP_TRACE_IDX_VAL{bsl::to_u64(0x0000000000000002U)};
+
+    /// <!-- description -->
+    ///   @brief This syscall tells the microkernel to enable or disable
+    ///     its trace on all PPs. Once enabled, the microkernel records a
+    ///     TSC stamped event for every VMEntry, VMExit, syscall, call into
+    ///     an extension and ESR in a fixed size ring for each PP. The
+    ///     trace is disabled by default, and can be dumped using
+    ///     bf_debug_op_dump_trace.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param enable true to enable the trace, false to disable it
+    ///
+    inline void
+    bf_control_op_trace(bool const enable) noexcept
+    {
+        if (enable) {
+            bf_control_op_trace_impl(bsl::ONE_U64.get());
+        }
+        else {
+            bf_control_op_trace_impl(bsl::ZERO_U64.get());
+        }
+    }
+
     // -------------------------------------------------------------------------
     // bf_handle_op_open_handle
     // -------------------------------------------------------------------------
@@ -1838,6 +2165,96 @@ namespace syscall
         bf_debug_op_dump_huge_pool_impl();
     }
 
+    // -------------------------------------------------------------------------
+    // bf_debug_op_dump_vmexit_stats
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_debug_op_dump_vmexit_stats.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///
+    extern "C" void bf_debug_op_dump_vmexit_stats_impl(    // --
+        bf_uint16_t const reg0_in) noexcept;
+
+    /// @brief Defines the syscall index for bf_debug_op_dump_vmexit_stats
+    constexpr bsl::safe_uint64 BF_DEBUG_OP_DUMP_VMEXIT_STATS_IDX_VAL{
+        bsl::to_u64(0x000000000000000AU)};
+
+    /// <!-- description -->
+    ///   @brief This syscall tells the microkernel to output the VMExit
+    ///     stats. Unlike the VMExit log, the VMExit stats are always
+    ///     enabled, and provide the number of VMExits and the number of
+    ///     TSC cycles spent handling them per exit reason, as well as the
+    ///     split between the microkernel and the extension for a specific
+    ///     physical processor.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param ppid The PPID of the PP to dump the stats from
+    ///
+    inline void
+    bf_debug_op_dump_vmexit_stats(    // --
+        bsl::safe_uint16 const &ppid) noexcept
+    {
+        bf_debug_op_dump_vmexit_stats_impl(ppid.get());
+    }
+
+    // -------------------------------------------------------------------------
+    // bf_debug_op_flush_log
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_debug_op_flush_log.
+    ///
+    extern "C" void bf_debug_op_flush_log_impl() noexcept;
+
+    /// @brief Defines the syscall index for bf_debug_op_flush_log
+    constexpr bsl::safe_uint64 BF_DEBUG_OP_FLUSH_LOG_IDX_VAL{bsl::to_u64(0x000000000000000BU)};
+
+    /// <!-- description -->
+    ///   @brief This syscall tells the microkernel to output the contents
+    ///     of this PP's log buffer (see bf_tls_log_write_c) to the
+    ///     microkernel's console, and then empty the log buffer.
+    ///
+    inline void
+    bf_debug_op_flush_log() noexcept
+    {
+        bf_debug_op_flush_log_impl();
+    }
+
+    // -------------------------------------------------------------------------
+    // bf_debug_op_dump_trace
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_debug_op_dump_trace.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///
+    extern "C" void bf_debug_op_dump_trace_impl(    // --
+        bf_uint16_t const reg0_in) noexcept;
+
+    /// @brief Defines the syscall index for bf_debug_op_dump_trace
+    constexpr bsl::safe_uint64 BF_DEBUG_OP_DUMP_TRACE_IDX_VAL{bsl::to_u64(0x000000000000000CU)};
+
+    /// <!-- description -->
+    ///   @brief This syscall tells the microkernel to output the contents
+    ///     of the trace ring (see bf_control_op_trace) for a specific
+    ///     physical processor, oldest event first, with one event per line.
+    ///     The trace should be disabled before it is dumped.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param ppid The PPID of the PP to dump the trace from
+    ///
+    inline void
+    bf_debug_op_dump_trace(    // --
+        bsl::safe_uint16 const &ppid) noexcept
+    {
+        bf_debug_op_dump_trace_impl(ppid.get());
+    }
+
     // -------------------------------------------------------------------------
     // bf_callback_op_register_bootstrap
     // -------------------------------------------------------------------------
@@ -3186,6 +3603,174 @@ namespace syscall
         return bsl::errc_success;
     }
 
+    // -------------------------------------------------------------------------
+    // bf_vps_op_read_batch
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_vps_op_read_batch.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_vps_op_read_batch_impl(    // --
+        bf_uint64_t const reg0_in,                              // --
+        bf_uint16_t const reg1_in,                              // --
+        bf_vps_batch_t *const reg2_in,                          // --
+        bf_uint64_t const reg3_in) noexcept -> bf_status_t::value_type;
+
+    /// @brief Defines the syscall index for bf_vps_op_read_batch
+    constexpr bsl::safe_uint64 BF_VPS_OP_READ_BATCH_IDX_VAL{bsl::to_u64(0x0000000000000013U)};
+
+    /// <!-- description -->
+    ///   @brief Reads each register or field described by the provided
+    ///     descriptor array from the VPS, storing each result in the value
+    ///     of its descriptor. This is the same as calling bf_vps_op_read_reg
+    ///     or bf_vps_op_readXX once for each descriptor, but only a single
+    ///     syscall is made. The descriptor array must not cross a page
+    ///     boundary (e.g., use a page from bf_mem_op_alloc_page) and cannot
+    ///     contain more than BF_VPS_BATCH_MAX entries. If an entry fails,
+    ///     the entries before it have already been read.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle Set to the result of bf_handle_op_open_handle
+    ///   @param vpsid The VPSID of the VPS to read from
+    ///   @param descs The descriptors defining what to read
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    [[nodiscard]] inline auto
+    bf_vps_op_read_batch(                 // --
+        bf_handle_t const &handle,        // --
+        bsl::safe_uint16 const &vpsid,    // --
+        bsl::span<bf_vps_batch_t> const &descs) noexcept -> bsl::errc_type
+    {
+        bf_status_t const status{bf_vps_op_read_batch_impl(
+            handle.hndl, vpsid.get(), descs.data(), descs.size().get())};
+        if (bsl::unlikely(status != BF_STATUS_SUCCESS)) {
+            return bsl::errc_failure;
+        }
+
+        return bsl::errc_success;
+    }
+
+    // -------------------------------------------------------------------------
+    // bf_vps_op_write_batch
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_vps_op_write_batch.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_vps_op_write_batch_impl(    // --
+        bf_uint64_t const reg0_in,                               // --
+        bf_uint16_t const reg1_in,                               // --
+        bf_vps_batch_t const *const reg2_in,                     // --
+        bf_uint64_t const reg3_in) noexcept -> bf_status_t::value_type;
+
+    /// @brief Defines the syscall index for bf_vps_op_write_batch
+    constexpr bsl::safe_uint64 BF_VPS_OP_WRITE_BATCH_IDX_VAL{bsl::to_u64(0x0000000000000014U)};
+
+    /// <!-- description -->
+    ///   @brief Writes the value of each descriptor in the provided
+    ///     descriptor array to the register or field it describes. This is
+    ///     the same as calling bf_vps_op_write_reg or bf_vps_op_writeXX once
+    ///     for each descriptor, but only a single syscall is made. The
+    ///     descriptor array must not cross a page boundary (e.g., use a page
+    ///     from bf_mem_op_alloc_page) and cannot contain more than
+    ///     BF_VPS_BATCH_MAX entries. If an entry fails, the entries before
+    ///     it have already been written.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle Set to the result of bf_handle_op_open_handle
+    ///   @param vpsid The VPSID of the VPS to write to
+    ///   @param descs The descriptors defining what to write
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    [[nodiscard]] inline auto
+    bf_vps_op_write_batch(                // --
+        bf_handle_t const &handle,        // --
+        bsl::safe_uint16 const &vpsid,    // --
+        bsl::span<bf_vps_batch_t const> const &descs) noexcept -> bsl::errc_type
+    {
+        bf_status_t const status{bf_vps_op_write_batch_impl(
+            handle.hndl, vpsid.get(), descs.data(), descs.size().get())};
+        if (bsl::unlikely(status != BF_STATUS_SUCCESS)) {
+            return bsl::errc_failure;
+        }
+
+        return bsl::errc_success;
+    }
+
+    // -------------------------------------------------------------------------
+    // bf_vps_op_set_exit_policy
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_vps_op_set_exit_policy.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_vps_op_set_exit_policy_impl(    // --
+        bf_uint64_t const reg0_in,                                   // --
+        bf_uint16_t const reg1_in,                                   // --
+        bf_exit_policy_t const *const reg2_in,                       // --
+        bf_uint64_t const reg3_in) noexcept -> bf_status_t::value_type;
+
+    /// @brief Defines the syscall index for bf_vps_op_set_exit_policy
+    constexpr bsl::safe_uint64 BF_VPS_OP_SET_EXIT_POLICY_IDX_VAL{
+        bsl::to_u64(0x0000000000000015U)};
+
+    /// <!-- description -->
+    ///   @brief Replaces the VPS's exit policy with the provided entries.
+    ///     Once set, VMExits that match an entry are handled by the
+    ///     microkernel without calling the extension's VMExit handler.
+    ///     Entries are checked in order and the first match wins. The
+    ///     entries are copied, so they can be freed once this returns.
+    ///     The entries must not cross a page boundary (e.g., use a page
+    ///     from bf_mem_op_alloc_page) and there cannot be more than
+    ///     BF_EXIT_POLICY_MAX of them. An empty span removes the policy.
+    ///     The number of VMExits each entry has handled is shown by
+    ///     bf_debug_op_dump_vps.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle Set to the result of bf_handle_op_open_handle
+    ///   @param vpsid The VPSID of the VPS to set the exit policy for
+    ///   @param entries The entries defining the new exit policy
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    [[nodiscard]] inline auto
+    bf_vps_op_set_exit_policy(            // --
+        bf_handle_t const &handle,        // --
+        bsl::safe_uint16 const &vpsid,    // --
+        bsl::span<bf_exit_policy_t const> const &entries) noexcept -> bsl::errc_type
+    {
+        bf_status_t const status{bf_vps_op_set_exit_policy_impl(
+            handle.hndl, vpsid.get(), entries.data(), entries.size().get())};
+        if (bsl::unlikely(status != BF_STATUS_SUCCESS)) {
+            return bsl::errc_failure;
+        }
+
+        return bsl::errc_success;
+    }
+
     // -------------------------------------------------------------------------
     // bf_intrinsic_op_rdmsr
     // -------------------------------------------------------------------------
@@ -3698,6 +4283,159 @@ namespace syscall
         return bsl::errc_success;
     }
 
+    // -------------------------------------------------------------------------
+    // bf_mem_op_alloc_pages
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_mem_op_alloc_pages.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_mem_op_alloc_pages_impl(    // --
+        bf_uint64_t const reg0_in,                               // --
+        bf_page_t *const reg1_in,                                // --
+        bf_uint64_t const reg2_in) noexcept -> bf_status_t::value_type;
+
+    /// @brief Defines the syscall index for bf_mem_op_alloc_pages
+    constexpr bsl::safe_uint64 BF_MEM_OP_ALLOC_PAGES_IDX_VAL{bsl::to_u64(0x0000000000000005U)};
+
+    /// <!-- description -->
+    ///   @brief bf_mem_op_alloc_pages allocates a page for each entry in
+    ///     the provided array, and maps these pages into the direct map of
+    ///     the VM. This is the same as calling bf_mem_op_alloc_page once for
+    ///     each entry, but only a single syscall is made. The array must not
+    ///     cross a page boundary (e.g., use a page from bf_mem_op_alloc_page)
+    ///     and cannot contain more than BF_MEM_OP_ALLOC_PAGES_MAX entries.
+    ///     If not all of the pages could be allocated, this function returns
+    ///     bsl::errc_failure, and any entry that was not allocated has a
+    ///     virtual address of nullptr. Entries that were allocated are valid
+    ///     and owned by the extension.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle Set to the result of bf_handle_op_open_handle
+    ///   @param pages The array to store the resulting pages in
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    [[nodiscard]] inline auto
+    bf_mem_op_alloc_pages(            // --
+        bf_handle_t const &handle,    // --
+        bsl::span<bf_page_t> const &pages) noexcept -> bsl::errc_type
+    {
+        bf_status_t const status{
+            bf_mem_op_alloc_pages_impl(handle.hndl, pages.data(), pages.size().get())};
+        if (bsl::unlikely(status != BF_STATUS_SUCCESS)) {
+            return bsl::errc_failure;
+        }
+
+        return bsl::errc_success;
+    }
+
+    // -------------------------------------------------------------------------
+    // bf_mem_op_donate_pages
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_mem_op_donate_pages.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_mem_op_donate_pages_impl(    // --
+        bf_uint64_t const reg0_in,                                // --
+        bf_uint64_t const reg1_in,                                // --
+        bf_uint16_t const reg2_in) noexcept -> bf_status_t::value_type;
+
+    /// @brief Defines the syscall index for bf_mem_op_donate_pages
+    constexpr bsl::safe_uint64 BF_MEM_OP_DONATE_PAGES_IDX_VAL{bsl::to_u64(0x0000000000000006U)};
+
+    /// <!-- description -->
+    ///   @brief bf_mem_op_donate_pages adds pages that the root OS has
+    ///     donated to the microkernel's page pool while the hypervisor is
+    ///     running. The pages must already be mapped into the microkernel's
+    ///     direct map and tagged by the loader, which lists the physical
+    ///     address of each page in a single page (see donate_pages_t). The
+    ///     physical address of this list is the value that the loader
+    ///     provides. The extension simply forwards this value, and the
+    ///     microkernel rejects any page that it cannot validate.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle Set to the result of bf_handle_op_open_handle
+    ///   @param list_phys The physical address of the list of donated pages
+    ///   @param node The NUMA node the donated pages were allocated from
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    [[nodiscard]] inline auto
+    bf_mem_op_donate_pages(                    // --
+        bf_handle_t const &handle,             // --
+        bsl::safe_uintmax const &list_phys,    // --
+        bsl::safe_uint16 const &node) noexcept -> bsl::errc_type
+    {
+        bf_status_t const status{
+            bf_mem_op_donate_pages_impl(handle.hndl, list_phys.get(), node.get())};
+        if (bsl::unlikely(status != BF_STATUS_SUCCESS)) {
+            return bsl::errc_failure;
+        }
+
+        return bsl::errc_success;
+    }
+
+    // -------------------------------------------------------------------------
+    // bf_mem_op_page_pool_low
+    // -------------------------------------------------------------------------
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for bf_mem_op_page_pool_low.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg0_out n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto bf_mem_op_page_pool_low_impl(    // --
+        bf_uint64_t const reg0_in,                                 // --
+        bf_uint16_t *const reg0_out) noexcept -> bf_status_t::value_type;
+
+    /// @brief Defines the syscall index for bf_mem_op_page_pool_low
+    constexpr bsl::safe_uint64 BF_MEM_OP_PAGE_POOL_LOW_IDX_VAL{bsl::to_u64(0x0000000000000007U)};
+
+    /// <!-- description -->
+    ///   @brief bf_mem_op_page_pool_low returns the ID of a NUMA node
+    ///     whose slice of the microkernel's page pool has fewer free bytes
+    ///     than HYPERVISOR_MK_PAGE_POOL_LOW_WATERMARK, or BF_INVALID_ID if
+    ///     no node is below the low watermark. This is how the root OS
+    ///     learns that it should donate more pages using
+    ///     bf_mem_op_donate_pages.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param handle Set to the result of bf_handle_op_open_handle
+    ///   @param node The ID of the NUMA node that is low on pages, or
+    ///     BF_INVALID_ID if no node is low on pages
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     otherwise
+    ///
+    [[nodiscard]] inline auto
+    bf_mem_op_page_pool_low(          // --
+        bf_handle_t const &handle,    // --
+        bsl::safe_uint16 &node) noexcept -> bsl::errc_type
+    {
+        bf_status_t const status{bf_mem_op_page_pool_low_impl(handle.hndl, node.data())};
+        if (bsl::unlikely(status != BF_STATUS_SUCCESS)) {
+            return bsl::errc_failure;
+        }
+
+        return bsl::errc_success;
+    }
+
     // -------------------------------------------------------------------------
     // Direct Map
     // -------------------------------------------------------------------------
@@ -27,6 +27,7 @@
 
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <bsl/cstdint.hpp>
@@ -338,6 +339,42 @@ namespace vmmctl
 
             return true;
         }
+
+        /// <!-- description -->
+        ///   @brief Maps memory provided by the device driver into this
+        ///     process as read-only. The memory remains mapped until the
+        ///     process exits.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param size the number of bytes to map
+        ///   @return Returns a pointer to the mapped memory on success,
+        ///     or a nullptr on failure.
+        ///
+        [[nodiscard]] auto
+        map_read_only(bsl::safe_uintmax const &size) const noexcept -> void const *
+        {
+            if (bsl::unlikely(IOCTL_INVALID_HNDL.get() == m_hndl)) {
+                bsl::error() << "failed to map, ioctl not properly initialized\n";
+                return nullptr;
+            }
+
+            if (bsl::unlikely(!size)) {
+                bsl::error() << "invalid size: " << bsl::hex(size) << bsl::endl << bsl::here();
+                return nullptr;
+            }
+
+            void const *const ptr{
+                mmap(nullptr, size.get(), PROT_READ, MAP_SHARED, m_hndl, static_cast<bsl::intmax>(0))};
+
+            // We don't have a choice here
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+            if (bsl::unlikely(MAP_FAILED == ptr)) {
+                bsl::error() << "mmap failed\n";
+                return nullptr;
+            }
+
+            return ptr;
+        }
     };
 }
 
@@ -0,0 +1,729 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef TRACE_JSON_HPP
+#define TRACE_JSON_HPP
+
+#include <debug_ring_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/char_type.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/fmt.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/string_view.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace vmmctl
+{
+    /// @brief defines the TSC frequency (in MHz) used when none is given
+    constexpr bsl::safe_uintmax TRACE_DEFAULT_TSC_MHZ{bsl::to_umax(1000)};
+    /// @brief defines the max number of characters in a trace line
+    constexpr bsl::safe_uintmax TRACE_LINE_SIZE{bsl::to_umax(0x80)};
+    /// @brief defines the max number of tokens in a trace line
+    constexpr bsl::safe_uintmax TRACE_MAX_TOKENS{bsl::to_umax(8)};
+
+    /// @brief defines the number of tokens in a "trace pp" header line
+    constexpr bsl::safe_uintmax TRACE_HDR_TOKENS{bsl::to_umax(5)};
+    /// @brief defines the number of tokens in a trace record line
+    constexpr bsl::safe_uintmax TRACE_RCD_TOKENS{bsl::to_umax(8)};
+
+    /// @brief defines the number of ns in a us
+    constexpr bsl::safe_uintmax TRACE_NS_PER_US{bsl::to_umax(1000)};
+    /// @brief defines the base used to parse the trace's numbers
+    constexpr bsl::safe_uintmax TRACE_BASE16{bsl::to_umax(16)};
+
+    /// @struct vmmctl::trace_slice_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores a slice (i.e., a "complete" event in the Chrome
+    ///     trace format) that has been opened by a record, but that has
+    ///     not yet been closed by a later record on the same PP.
+    ///
+    struct trace_slice_t final
+    {
+        /// @brief stores whether or not this slice is open
+        bool open;
+        /// @brief stores the TSC of the record that opened the slice
+        bsl::safe_uintmax tsc;
+        /// @brief stores the argument of the record that opened the slice
+        bsl::safe_uintmax arg;
+        /// @brief stores the VMID of the record that opened the slice
+        bsl::safe_uintmax vmid;
+        /// @brief stores the VPID of the record that opened the slice
+        bsl::safe_uintmax vpid;
+        /// @brief stores the VPSID of the record that opened the slice
+        bsl::safe_uintmax vpsid;
+    };
+
+    /// @struct vmmctl::trace_pp_state_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the conversion state of a single PP.
+    ///
+    struct trace_pp_state_t final
+    {
+        /// @brief stores the line number (plus one) of the PP's last header
+        bsl::safe_uintmax hdr;
+        /// @brief stores the open "guest" slice (vmentry to vmexit)
+        trace_slice_t guest;
+        /// @brief stores the open "exit" slice (vmexit to vmentry)
+        trace_slice_t exit;
+        /// @brief stores the open "syscall" slice (syscall to syscall_done)
+        trace_slice_t syscall;
+    };
+
+    /// @class vmmctl::trace_json
+    ///
+    /// <!-- description -->
+    ///   @brief Converts the trace that the microkernel writes to the
+    ///     debug ring (see bf_debug_op_dump_trace) into the Chrome trace
+    ///     event format, which can be loaded by chrome://tracing or
+    ///     Perfetto. Each PP is shown as its own thread. Time spent in a
+    ///     guest, time spent handling a VMExit and time spent in a syscall
+    ///     are shown as slices, while extension entries and exceptions
+    ///     are shown as instant events.
+    ///
+    /// <!-- notes -->
+    ///   @note The trace of every PP does not fit in the debug ring, so
+    ///     each PP is dumped and read on its own. The debug ring might
+    ///     also contain older dumps of the same PP. Only the records that
+    ///     follow the last "trace pp" header of a PP are converted, and
+    ///     the number of records is checked against the header, so that
+    ///     a dump that was overwritten is reported instead of converted.
+    ///
+    class trace_json final
+    {
+        /// @brief stores the conversion state of each PP
+        bsl::array<trace_pp_state_t, HYPERVISOR_MAX_PPS> m_pps{};
+        /// @brief stores the current line
+        bsl::array<bsl::char_type, TRACE_LINE_SIZE.get()> m_line{};
+        /// @brief stores the number of characters in the current line
+        bsl::safe_uintmax m_line_size{};
+        /// @brief stores the start of each token in the current line
+        bsl::array<bsl::safe_uintmax, TRACE_MAX_TOKENS.get()> m_tok_pos{};
+        /// @brief stores the size of each token in the current line
+        bsl::array<bsl::safe_uintmax, TRACE_MAX_TOKENS.get()> m_tok_size{};
+        /// @brief stores the number of tokens in the current line
+        bsl::safe_uintmax m_tok_count{};
+        /// @brief stores the TSC that all timestamps are relative to
+        bsl::safe_uintmax m_base{bsl::safe_uintmax::max_value()};
+        /// @brief stores the TSC frequency in MHz
+        bsl::safe_uintmax m_tsc_mhz{TRACE_DEFAULT_TSC_MHZ};
+        /// @brief stores whether or not an event has been output yet
+        bool m_first{true};
+
+        /// <!-- description -->
+        ///   @brief Reads the line that starts at pos from the debug ring
+        ///     and splits it into tokens. Characters that do not fit into
+        ///     the line buffer are dropped, which is fine as trace lines
+        ///     are always smaller than the buffer.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ring the debug ring to read from
+        ///   @param pos the position of the line in the debug ring
+        ///   @param epos the end position of the debug ring
+        ///   @return Returns the position of the next line
+        ///
+        [[nodiscard]] constexpr auto
+        read_line(
+            loader::debug_ring_t const &ring,
+            bsl::safe_uintmax const &pos,
+            bsl::safe_uintmax const &epos) noexcept -> bsl::safe_uintmax
+        {
+            m_line_size = {};
+            m_tok_count = {};
+
+            bool in_tok{};
+            bsl::safe_uintmax i{pos};
+            while (i != epos) {
+                if (!(ring.buf.size() > i)) {
+                    i = {};
+                    continue;
+                }
+
+                bsl::char_type const c{*ring.buf.at_if(i)};
+                ++i;
+
+                if ('\n' == c) {
+                    break;
+                }
+
+                if (!(m_line_size < m_line.size())) {
+                    continue;
+                }
+
+                if (' ' == c) {
+                    in_tok = false;
+                }
+                else if (!in_tok) {
+                    in_tok = true;
+                    if (m_tok_count < m_tok_pos.size()) {
+                        *m_tok_pos.at_if(m_tok_count) = m_line_size;
+                        *m_tok_size.at_if(m_tok_count) = {};
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    ++m_tok_count;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                if (in_tok && (m_tok_count <= m_tok_size.size())) {
+                    ++*m_tok_size.at_if(m_tok_count - bsl::ONE_UMAX);
+                }
+                else {
+                    bsl::touch();
+                }
+
+                *m_line.at_if(m_line_size) = c;
+                ++m_line_size;
+            }
+
+            return i;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the requested token of the current line
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param idx the index of the token to return
+        ///   @return Returns the requested token of the current line
+        ///
+        [[nodiscard]] constexpr auto
+        tok(bsl::safe_uintmax const &idx) const noexcept -> bsl::string_view
+        {
+            return bsl::string_view{m_line.at_if(*m_tok_pos.at_if(idx)), *m_tok_size.at_if(idx)};
+        }
+
+        /// <!-- description -->
+        ///   @brief Parses the requested token of the current line as a
+        ///     hexadecimal number (without a "0x" prefix).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param idx the index of the token to parse
+        ///   @return Returns the parsed number, or
+        ///     bsl::safe_uintmax::zero(true) if the token is not a number.
+        ///
+        [[nodiscard]] constexpr auto
+        hex(bsl::safe_uintmax const &idx) const noexcept -> bsl::safe_uintmax
+        {
+            auto const str{this->tok(idx)};
+            if (bsl::unlikely(str.empty())) {
+                return bsl::safe_uintmax::zero(true);
+            }
+
+            bsl::safe_uintmax val{};
+            for (bsl::safe_uintmax i{}; i < str.size(); ++i) {
+                bsl::char_type const c{*str.at_if(i)};
+                if ((c >= '0') && (c <= '9')) {
+                    val = (val * TRACE_BASE16) + bsl::to_umax(c - '0');
+                }
+                else if ((c >= 'a') && (c <= 'f')) {
+                    val = (val * TRACE_BASE16) + bsl::to_umax((c - 'a') + 10);
+                }
+                else {
+                    return bsl::safe_uintmax::zero(true);
+                }
+            }
+
+            return val;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the PP state of the current line if it is a
+        ///     "trace pp" header, otherwise returns a nullptr.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the PP state of the current line if it is a
+        ///     "trace pp" header, otherwise returns a nullptr.
+        ///
+        [[nodiscard]] constexpr auto
+        hdr_pp() noexcept -> trace_pp_state_t *
+        {
+            if (m_tok_count != TRACE_HDR_TOKENS) {
+                return nullptr;
+            }
+
+            if ((this->tok(bsl::to_umax(0)) != "trace") || (this->tok(bsl::to_umax(1)) != "pp")) {
+                return nullptr;
+            }
+
+            auto const ppid{this->hex(bsl::to_umax(2))};
+            if (bsl::unlikely(!ppid)) {
+                return nullptr;
+            }
+
+            return m_pps.at_if(ppid);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the PP state of the current line if it is a
+        ///     trace record, otherwise returns a nullptr.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the PP state of the current line if it is a
+        ///     trace record, otherwise returns a nullptr.
+        ///
+        [[nodiscard]] constexpr auto
+        any_rcd_pp() noexcept -> trace_pp_state_t *
+        {
+            if (m_tok_count != TRACE_RCD_TOKENS) {
+                return nullptr;
+            }
+
+            if (this->tok(bsl::to_umax(0)) != "trace") {
+                return nullptr;
+            }
+
+            auto const ppid{this->hex(bsl::to_umax(1))};
+            if (bsl::unlikely(!ppid)) {
+                return nullptr;
+            }
+
+            return m_pps.at_if(ppid);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the PP state of the current line if it is a
+        ///     trace record that follows the last "trace pp" header of its
+        ///     PP, otherwise returns a nullptr.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param line the line number of the current line
+        ///   @return Returns the PP state of the current line if it is a
+        ///     trace record that should be converted, otherwise returns
+        ///     a nullptr.
+        ///
+        [[nodiscard]] constexpr auto
+        rcd_pp(bsl::safe_uintmax const &line) noexcept -> trace_pp_state_t *
+        {
+            auto *const pp{this->any_rcd_pp()};
+            if (nullptr == pp) {
+                return nullptr;
+            }
+
+            if (pp->hdr.is_zero() || (line < pp->hdr)) {
+                return nullptr;
+            }
+
+            return pp;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the end position of the provided debug ring
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ring the debug ring to get the end position of
+        ///   @return Returns the end position of the provided debug ring
+        ///
+        [[nodiscard]] static constexpr auto
+        end_of(loader::debug_ring_t const &ring) noexcept -> bsl::safe_uintmax
+        {
+            bsl::safe_uintmax const epos{ring.epos};
+            if (!(ring.buf.size() > epos)) {
+                return {};
+            }
+
+            return epos;
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs the provided TSC as the number of us since
+        ///     m_base, with ns precision.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tsc the TSC to output
+        ///
+        constexpr void
+        print_us(bsl::safe_uintmax const &tsc) const noexcept
+        {
+            constexpr auto tens{bsl::to_umax(10)};
+            constexpr auto hundreds{bsl::to_umax(100)};
+
+            auto const ns{(tsc * TRACE_NS_PER_US) / m_tsc_mhz};
+            auto const frac{ns % TRACE_NS_PER_US};
+
+            bsl::print() << ns / TRACE_NS_PER_US << '.';
+
+            if (frac < hundreds) {
+                bsl::print() << '0';
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (frac < tens) {
+                bsl::print() << '0';
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::print() << frac;
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs the start of an event, including the
+        ///     separator from the previous event.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ph the phase of the event ("X" or "i")
+        ///   @param ppid the ID of the PP the event occurred on
+        ///   @param tsc the TSC of the start of the event
+        ///
+        constexpr void
+        print_event_start(
+            bsl::string_view const &ph,
+            bsl::safe_uintmax const &ppid,
+            bsl::safe_uintmax const &tsc) noexcept
+        {
+            if (m_first) {
+                m_first = false;
+            }
+            else {
+                bsl::print() << ",\n";
+            }
+
+            bsl::print() << "{\"ph\":\"" << ph << "\",\"pid\":0,\"tid\":" << ppid;
+            bsl::print() << ",\"ts\":";
+            this->print_us(tsc - m_base);
+        }
+
+        /// <!-- description -->
+        ///   @brief Closes the provided slice (if it is open) at the
+        ///     provided TSC and outputs it as a complete event.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param name the name of the slice
+        ///   @param ppid the ID of the PP the slice occurred on
+        ///   @param slice the slice to close
+        ///   @param tsc the TSC at which the slice is closed
+        ///
+        constexpr void
+        close_slice(
+            bsl::string_view const &name,
+            bsl::safe_uintmax const &ppid,
+            trace_slice_t &slice,
+            bsl::safe_uintmax const &tsc) noexcept
+        {
+            if (!slice.open) {
+                return;
+            }
+
+            slice.open = false;
+            if (bsl::unlikely(tsc < slice.tsc)) {
+                return;
+            }
+
+            this->print_event_start("X", ppid, slice.tsc);
+            bsl::print() << ",\"dur\":";
+            this->print_us(tsc - slice.tsc);
+
+            bsl::print() << ",\"name\":\"" << name;
+            if (name != "guest") {
+                bsl::print() << " 0x" << bsl::fmt{"x", slice.arg};
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::print() << "\",\"args\":{\"vmid\":" << slice.vmid;
+            bsl::print() << ",\"vpid\":" << slice.vpid;
+            bsl::print() << ",\"vpsid\":" << slice.vpsid << "}}";
+        }
+
+        /// <!-- description -->
+        ///   @brief Opens the provided slice using the current record.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param slice the slice to open
+        ///   @param tsc the TSC of the current record
+        ///
+        constexpr void
+        open_slice(trace_slice_t &slice, bsl::safe_uintmax const &tsc) const noexcept
+        {
+            slice.open = true;
+            slice.tsc = tsc;
+            slice.vmid = this->hex(bsl::to_umax(4));
+            slice.vpid = this->hex(bsl::to_umax(5));
+            slice.vpsid = this->hex(bsl::to_umax(6));
+            slice.arg = this->hex(bsl::to_umax(7));
+        }
+
+        /// <!-- description -->
+        ///   @brief Converts the current record into events.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param pp the PP state of the current record
+        ///
+        constexpr void
+        convert_rcd(trace_pp_state_t &pp) noexcept
+        {
+            auto const ppid{this->hex(bsl::to_umax(1))};
+            auto const tsc{this->hex(bsl::to_umax(2))};
+            auto const event{this->tok(bsl::to_umax(3))};
+
+            if (bsl::unlikely(!tsc)) {
+                return;
+            }
+
+            if (event == "vmentry") {
+                this->close_slice("syscall", ppid, pp.syscall, tsc);
+                this->close_slice("exit", ppid, pp.exit, tsc);
+                this->open_slice(pp.guest, tsc);
+                return;
+            }
+
+            if (event == "vmexit") {
+                this->close_slice("syscall", ppid, pp.syscall, tsc);
+                this->close_slice("guest", ppid, pp.guest, tsc);
+                this->open_slice(pp.exit, tsc);
+                return;
+            }
+
+            if (event == "syscall") {
+                this->close_slice("syscall", ppid, pp.syscall, tsc);
+                this->open_slice(pp.syscall, tsc);
+                return;
+            }
+
+            if (event == "syscall_done") {
+                this->close_slice("syscall", ppid, pp.syscall, tsc);
+                return;
+            }
+
+            if ((event == "ext") || (event == "esr")) {
+                this->print_event_start("i", ppid, tsc);
+                bsl::print() << ",\"s\":\"t\",\"name\":\"" << event;
+                bsl::print() << " 0x" << bsl::fmt{"x", this->hex(bsl::to_umax(7))} << "\"}";
+                return;
+            }
+
+            bsl::touch();
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Finds the trace of the provided PP in the provided
+        ///     debug ring, checks that none of it was overwritten, and
+        ///     records its smallest TSC, which is used as the start of
+        ///     the trace. This must be called for each PP before any of
+        ///     them are converted.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ring the debug ring holding the PP's trace
+        ///   @param ppid the ID of the PP to find the trace of
+        ///   @return Returns bsl::errc_success if the PP's trace was found,
+        ///     bsl::errc_precondition if the debug ring does not contain a
+        ///     trace for the PP, and bsl::errc_failure if the PP's trace
+        ///     was overwritten because the debug ring wrapped.
+        ///
+        [[nodiscard]] constexpr auto
+        scan(loader::debug_ring_t const &ring, bsl::safe_uintmax const &ppid) noexcept
+            -> bsl::errc_type
+        {
+            auto *const pp{m_pps.at_if(ppid)};
+            if (bsl::unlikely(nullptr == pp)) {
+                bsl::error() << "invalid ppid: " << bsl::hex(ppid) << bsl::endl;
+                return bsl::errc_failure;
+            }
+
+            bsl::safe_uintmax const spos{ring.spos};
+            auto const epos{end_of(ring)};
+
+            /// NOTE:
+            /// - The first pass finds the PP's last header, which states
+            ///   how many records follow it.
+            ///
+
+            pp->hdr = {};
+
+            bsl::safe_uintmax expected{};
+            bsl::safe_uintmax line{};
+            for (bsl::safe_uintmax pos{spos}; pos != epos; ++line) {
+                pos = this->read_line(ring, pos, epos);
+
+                if (this->hdr_pp() == pp) {
+                    pp->hdr = line + bsl::ONE_UMAX;
+                    expected = this->hex(bsl::to_umax(3));
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            /// NOTE:
+            /// - The second pass counts the records that follow the header
+            ///   and finds the smallest TSC. Records without a header mean
+            ///   that the header was overwritten.
+            ///
+
+            bsl::safe_uintmax found{};
+            bsl::safe_uintmax orphans{};
+
+            line = {};
+            for (bsl::safe_uintmax pos{spos}; pos != epos; ++line) {
+                pos = this->read_line(ring, pos, epos);
+
+                if (this->any_rcd_pp() != pp) {
+                    continue;
+                }
+
+                if (pp->hdr.is_zero()) {
+                    ++orphans;
+                    continue;
+                }
+
+                if (line < pp->hdr) {
+                    continue;
+                }
+
+                ++found;
+
+                auto const tsc{this->hex(bsl::to_umax(2))};
+                if (!!tsc && (tsc < m_base)) {
+                    m_base = tsc;
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            if (pp->hdr.is_zero()) {
+                if (orphans.is_zero()) {
+                    return bsl::errc_precondition;
+                }
+
+                bsl::error() << "the trace of pp "                          // --
+                             << bsl::hex(ppid)                              // --
+                             << " was overwritten before it was read\n";    // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(found != expected)) {
+                bsl::error() << "the trace of pp "                     // --
+                             << bsl::hex(ppid)                         // --
+                             << " was truncated: only "                // --
+                             << found                                  // --
+                             << " of "                                 // --
+                             << expected                               // --
+                             << " records are in the debug ring\n";    // --
+
+                pp->hdr = {};
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs the start of the Chrome trace event JSON.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tsc_mhz the TSC frequency in MHz used to convert TSC
+        ///     values into time.
+        ///
+        constexpr void
+        begin(bsl::safe_uintmax const &tsc_mhz) noexcept
+        {
+            if (!tsc_mhz.is_zero()) {
+                m_tsc_mhz = tsc_mhz;
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::print() << "{\"traceEvents\":[\n";
+        }
+
+        /// <!-- description -->
+        ///   @brief Converts the trace of the provided PP found in the
+        ///     provided debug ring into the Chrome trace event format, and
+        ///     outputs the result. Slices that are still open at the end
+        ///     of the PP's trace are dropped.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ring the debug ring holding the PP's trace
+        ///   @param ppid the ID of the PP to convert the trace of
+        ///   @return Returns bsl::errc_success on success, and
+        ///     bsl::errc_failure if the PP's trace is missing or was
+        ///     overwritten.
+        ///
+        [[nodiscard]] constexpr auto
+        convert_pp(loader::debug_ring_t const &ring, bsl::safe_uintmax const &ppid) noexcept
+            -> bsl::errc_type
+        {
+            /// NOTE:
+            /// - The PP's trace is scanned again as the debug ring might
+            ///   have changed since it was first scanned. The start of
+            ///   the trace must not move once events have been output.
+            ///
+
+            auto const base{m_base};
+            if (bsl::unlikely(!this->scan(ring, ppid))) {
+                return bsl::errc_failure;
+            }
+
+            m_base = base;
+
+            bsl::safe_uintmax const spos{ring.spos};
+            auto const epos{end_of(ring)};
+
+            bsl::safe_uintmax line{};
+            for (bsl::safe_uintmax pos{spos}; pos != epos; ++line) {
+                pos = this->read_line(ring, pos, epos);
+
+                auto *const pp{this->rcd_pp(line)};
+                if (m_pps.at_if(ppid) == pp) {
+                    this->convert_rcd(*pp);
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Outputs the end of the Chrome trace event JSON.
+        ///
+        constexpr void
+        end() const noexcept
+        {
+            bsl::print() << "\n]}\n";
+        }
+    };
+}
+
+#endif
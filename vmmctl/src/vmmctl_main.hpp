@@ -25,14 +25,18 @@
 #ifndef VMMCTL_MAIN_HPP
 #define VMMCTL_MAIN_HPP
 
+#include <debug_ring_t.hpp>
 #include <dump_vmm_args_t.hpp>
 #include <loader_platform_interface.hpp>
+#include <sleep_ms.hpp>
 #include <start_vmm_args_t.hpp>
 #include <stop_vmm_args_t.hpp>
+#include <trace_json.hpp>
 
 #include <bsl/arguments.hpp>
 #include <bsl/array.hpp>
 #include <bsl/byte.hpp>
+#include <bsl/char_type.hpp>
 #include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
@@ -43,9 +47,17 @@
 #include <bsl/result.hpp>
 #include <bsl/string_view.hpp>
 #include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
 
 namespace vmmctl
 {
+    /// @brief defines the number of characters copied per read while following
+    constexpr bsl::safe_uintmax FOLLOW_CHUNK_SIZE{bsl::to_umax(0x100)};
+    /// @brief defines how long to wait (in ms) when there is nothing to follow
+    constexpr bsl::safe_uintmax FOLLOW_POLL_MS{bsl::to_umax(100)};
+    /// @brief defines the number of bytes in a MB (used by "donate --mb")
+    constexpr bsl::safe_uintmax DONATE_BYTES_PER_MB{bsl::to_umax(0x100000)};
+
     /// @class vmmctl::vmmctl_main
     ///
     /// <!-- description -->
@@ -70,7 +82,7 @@ namespace vmmctl
         /// @brief stores the arguments for stopping the VMM.
         loader::stop_vmm_args_t m_stop_vmm_ctl_args{bsl::ONE_UMAX.get()};
         /// @brief stores the arguments for dumping the VMM.
-        loader::dump_vmm_args_t m_dump_vmm_ctl_args{bsl::ONE_UMAX.get(), {}};
+        loader::dump_vmm_args_t m_dump_vmm_ctl_args{bsl::ONE_UMAX.get(), {}, {}, {}, {}, {}};
 
         /// <!-- description -->
         ///   @brief Displays the help menu for vmmctl
@@ -81,6 +93,11 @@ namespace vmmctl
             bsl::print() << "Usage: vmmctl start microkernel ext1 <ext2> ..." << bsl::endl;
             bsl::print() << "  or:  vmmctl stop" << bsl::endl;
             bsl::print() << "  or:  vmmctl dump" << bsl::endl;
+            bsl::print() << "  or:  vmmctl dump --follow" << bsl::endl;
+            bsl::print() << "  or:  vmmctl stats" << bsl::endl;
+            bsl::print() << "  or:  vmmctl trace start" << bsl::endl;
+            bsl::print() << "  or:  vmmctl trace stop <--tsc-mhz=N>" << bsl::endl;
+            bsl::print() << "  or:  vmmctl donate <--mb=N> <--node=N>" << bsl::endl;
             bsl::print() << bsl::endl;
             bsl::print() << "A utility for managing the Bareflank Hypervisor's VMM";
             bsl::print() << bsl::endl;
@@ -234,6 +251,221 @@ namespace vmmctl
             return bsl::exit_success;
         }
 
+        /// <!-- description -->
+        ///   @brief Starts or stops the VMM's trace given a set of
+        ///     IOCTL_CONCEPT arguments to send to the loader. When the trace
+        ///     is stopped, the trace of each PP is written to the debug
+        ///     ring one PP at a time, which is then converted to the Chrome
+        ///     trace event format and output.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ctl_args the command line arguments provided by the user.
+        ///   @param tsc_mhz the TSC frequency in MHz used to convert TSC
+        ///     values into time.
+        ///   @return Returns bsl::exit_success if the trace was successfully
+        ///     started or stopped, otherwise returns bsl::exit_failure.
+        ///
+        [[nodiscard]] constexpr auto
+        trace_vmm(loader::dump_vmm_args_t *const ctl_args, bsl::safe_uintmax const &tsc_mhz)
+            const noexcept -> bsl::exit_code
+        {
+            IOCTL_CONCEPT ctl{loader::DEVICE_NAME};
+            if (!ctl) {
+                return bsl::exit_failure;
+            }
+
+            ctl_args->trace_ppid = {};
+            if (bsl::exit_success != this->read_write(loader::DUMP_VMM, ctl, ctl_args)) {
+                return bsl::exit_failure;
+            }
+
+            if (loader::DUMP_VMM_TRACE_STOP != ctl_args->trace) {
+                return bsl::exit_success;
+            }
+
+            /// NOTE:
+            /// - The trace of every PP does not fit in the debug ring, so
+            ///   each PP is dumped on its own, and the debug ring is copied
+            ///   out before the next PP is dumped. The first pass checks
+            ///   that each PP's trace is complete and finds the start of
+            ///   the trace, so that nothing is output if any of them was
+            ///   overwritten. The trace is disabled, so the second pass
+            ///   dumps the same records again and converts them.
+            /// - A PP that is not online dumps nothing, which marks the
+            ///   end of the PPs.
+            ///
+
+            trace_json conv{};
+
+            bsl::safe_uintmax pps{};
+            for (; pps < HYPERVISOR_MAX_PPS; ++pps) {
+                if (!pps.is_zero()) {
+                    ctl_args->trace_ppid = pps.get();
+                    if (bsl::exit_success != this->read_write(loader::DUMP_VMM, ctl, ctl_args)) {
+                        return bsl::exit_failure;
+                    }
+                }
+                else {
+                    bsl::touch();
+                }
+
+                auto const ret{conv.scan(ctl_args->debug_ring, pps)};
+                if (bsl::errc_precondition == ret) {
+                    break;
+                }
+
+                if (bsl::unlikely(!ret)) {
+                    bsl::error() << "the debug ring is too small for HYPERVISOR_TRACE_SIZE\n";
+                    return bsl::exit_failure;
+                }
+            }
+
+            if (pps.is_zero()) {
+                bsl::alert() << "no trace found in the debug ring\n";
+                return bsl::exit_success;
+            }
+
+            conv.begin(tsc_mhz);
+            for (bsl::safe_uintmax ppid{}; ppid < pps; ++ppid) {
+                ctl_args->trace_ppid = ppid.get();
+                if (bsl::exit_success != this->read_write(loader::DUMP_VMM, ctl, ctl_args)) {
+                    return bsl::exit_failure;
+                }
+
+                if (bsl::unlikely(!conv.convert_pp(ctl_args->debug_ring, ppid))) {
+                    return bsl::exit_failure;
+                }
+            }
+
+            conv.end();
+            return bsl::exit_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Donates memory to the page pool of a running VMM given a
+        ///     set of IOCTL_CONCEPT arguments to send to the loader. Unlike
+        ///     dump_vmm, the debug ring that is returned is not printed.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ctl_args the command line arguments provided by the user.
+        ///   @return Returns bsl::exit_success if the memory was successfully
+        ///     donated, otherwise returns bsl::exit_failure.
+        ///
+        [[nodiscard]] constexpr auto
+        donate_vmm(loader::dump_vmm_args_t *const ctl_args) const noexcept -> bsl::exit_code
+        {
+            IOCTL_CONCEPT ctl{loader::DEVICE_NAME};
+            if (ctl) {
+                return this->read_write(loader::DUMP_VMM, ctl, ctl_args);
+            }
+
+            return bsl::exit_failure;
+        }
+
+        /// <!-- description -->
+        ///   @brief Maps the VMM's debug ring into this process as read-only
+        ///     and continuously prints anything that is written to it until
+        ///     vmmctl is killed. Unlike dump_vmm, no IOCTL is needed per read
+        ///     and nothing is copied from the loader, so the cost of
+        ///     following is proportional to the amount of new data only.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns bsl::exit_failure if the debug ring could not
+        ///     be mapped. Otherwise this function does not return.
+        ///
+        [[nodiscard]] constexpr auto
+        follow_vmm() const noexcept -> bsl::exit_code
+        {
+            IOCTL_CONCEPT ctl{loader::DEVICE_NAME};
+            if (!ctl) {
+                return bsl::exit_failure;
+            }
+
+            auto const *const ring{static_cast<loader::debug_ring_t const *>(
+                ctl.map_read_only(bsl::size_of<loader::debug_ring_t>()))};
+
+            if (bsl::unlikely(nullptr == ring)) {
+                bsl::error() << "failed to map the debug ring\n";
+                return bsl::exit_failure;
+            }
+
+            constexpr auto size{bsl::to_umax(HYPERVISOR_DEBUG_RING_SIZE)};
+            constexpr auto max_avail{size - bsl::ONE_UMAX};
+
+            /// NOTE:
+            /// - rseq is our own cursor into the (never wrapping) sequence of
+            ///   characters written to the debug ring. We start with whatever
+            ///   is already in the ring, which is what "dump" would print.
+            /// - A character at rseq is only valid while seq - rseq is no
+            ///   more than size - 1. Anything older has been overwritten, in
+            ///   which case we report how much was lost and skip ahead.
+            /// - Each chunk is copied first, and then seq is checked again so
+            ///   that a chunk that was overrun while copying is never printed.
+            ///
+
+            bsl::safe_uintmax seq{__atomic_load_n(&ring->seq, __ATOMIC_ACQUIRE)};
+            bsl::safe_uintmax const epos{ring->epos % size};
+            bsl::safe_uintmax const spos{ring->spos % size};
+
+            bsl::safe_uintmax rseq{seq};
+            bsl::safe_uintmax const used{((epos + size) - spos) % size};
+            if (rseq >= used) {
+                rseq -= used;
+            }
+            else {
+                rseq = {};
+            }
+
+            bsl::array<bsl::char_type, FOLLOW_CHUNK_SIZE.get()> chunk{};
+            while (true) {
+                seq = __atomic_load_n(&ring->seq, __ATOMIC_ACQUIRE);
+
+                if (bsl::unlikely(seq < rseq)) {
+                    bsl::alert() << "debug ring was reset\n";
+                    rseq = {};
+                }
+                else {
+                    bsl::touch();
+                }
+
+                if (seq == rseq) {
+                    sleep_ms(FOLLOW_POLL_MS);
+                    continue;
+                }
+
+                if (bsl::unlikely((seq - rseq) > max_avail)) {
+                    bsl::alert() << "lost " << (seq - rseq) - max_avail << " characters\n";
+                    rseq = seq - max_avail;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                auto len{seq - rseq};
+                if (len > chunk.size()) {
+                    len = chunk.size();
+                }
+                else {
+                    bsl::touch();
+                }
+
+                for (bsl::safe_uintmax i{}; i < len; ++i) {
+                    *chunk.at_if(i) = *ring->buf.at_if((rseq + i) % size);
+                }
+
+                seq = __atomic_load_n(&ring->seq, __ATOMIC_ACQUIRE);
+                if (bsl::unlikely((seq - rseq) > max_avail)) {
+                    continue;
+                }
+
+                for (bsl::safe_uintmax i{}; i < len; ++i) {
+                    bsl::print() << *chunk.at_if(i);
+                }
+
+                rseq += len;
+            }
+        }
+
         /// <!-- description -->
         ///   @brief Maps an ELF file by getting the filename and path from
         ///     the arguments provided by the user, opening the ELF file, and
@@ -429,9 +661,68 @@ namespace vmmctl
             }
 
             if (cmd == "dump") {
+                if (args.get<bool>("--follow")) {
+                    return this->follow_vmm();
+                }
+
+                return this->dump_vmm(&m_dump_vmm_ctl_args);
+            }
+
+            if (cmd == "stats") {
+                m_dump_vmm_ctl_args.vmexit_stats = bsl::ONE_UMAX.get();
                 return this->dump_vmm(&m_dump_vmm_ctl_args);
             }
 
+            if (cmd == "trace") {
+                bsl::string_view const subcmd{args.front<bsl::string_view>()};
+                if (subcmd == "start") {
+                    m_dump_vmm_ctl_args.trace = loader::DUMP_VMM_TRACE_START.get();
+                    return this->trace_vmm(&m_dump_vmm_ctl_args, {});
+                }
+
+                if (subcmd == "stop") {
+                    auto tsc_mhz{args.get<bsl::safe_uintmax>("--tsc-mhz")};
+                    if (!tsc_mhz || tsc_mhz.is_zero()) {
+                        tsc_mhz = TRACE_DEFAULT_TSC_MHZ;
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    m_dump_vmm_ctl_args.trace = loader::DUMP_VMM_TRACE_STOP.get();
+                    return this->trace_vmm(&m_dump_vmm_ctl_args, tsc_mhz);
+                }
+
+                this->process_cmd_output_error(subcmd);
+                return bsl::exit_failure;
+            }
+
+            if (cmd == "donate") {
+                auto const mb{args.get<bsl::safe_uintmax>("--mb")};
+                if (!mb || mb.is_zero()) {
+                    m_dump_vmm_ctl_args.donate = HYPERVISOR_MK_PAGE_POOL_DONATION_SIZE;
+                }
+                else {
+                    auto const bytes{mb * DONATE_BYTES_PER_MB};
+                    if (bsl::unlikely(!bytes)) {
+                        bsl::error() << "invalid donation size: " << mb << " MB\n";
+                        return bsl::exit_failure;
+                    }
+
+                    m_dump_vmm_ctl_args.donate = bytes.get();
+                }
+
+                auto const node{args.get<bsl::safe_uintmax>("--node")};
+                if (!node) {
+                    m_dump_vmm_ctl_args.donate_node = {};
+                }
+                else {
+                    m_dump_vmm_ctl_args.donate_node = node.get();
+                }
+
+                return this->donate_vmm(&m_dump_vmm_ctl_args);
+            }
+
             this->process_cmd_output_error(cmd);
             return bsl::exit_failure;
         }
@@ -41,6 +41,7 @@
 // clang-format on
 
 #include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
 #include <bsl/move.hpp>
 #include <bsl/safe_integral.hpp>
 #include <bsl/swap.hpp>
@@ -433,6 +434,23 @@ namespace vmmctl
 
             return true;
         }
+
+        /// <!-- description -->
+        ///   @brief Maps memory provided by the device driver into this
+        ///     process as read-only. This is not supported on Windows.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param size the number of bytes to map
+        ///   @return Always returns a nullptr.
+        ///
+        [[nodiscard]] auto
+        map_read_only(bsl::safe_uintmax const &size) const noexcept -> void const *
+        {
+            bsl::discard(size);
+
+            bsl::error() << "mapping the debug ring is not supported on Windows\n";
+            return nullptr;
+        }
     };
 }
 
@@ -0,0 +1,60 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef VMMCTL_SLEEP_MS_WINDOWS_HPP
+#define VMMCTL_SLEEP_MS_WINDOWS_HPP
+
+// clang-format off
+
+/// NOTE:
+/// - When using CPP, we need to remove the max/min macros as they are
+///   used by the C++ standard.
+///
+
+#include <Windows.h>
+#undef max
+#undef min
+
+// clang-format on
+
+#include <bsl/safe_integral.hpp>
+
+namespace vmmctl
+{
+    /// <!-- description -->
+    ///   @brief Puts the calling thread to sleep for at least the provided
+    ///     number of milliseconds.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param ms the number of milliseconds to sleep for
+    ///
+    inline void
+    sleep_ms(bsl::safe_uintmax const &ms) noexcept
+    {
+        Sleep(static_cast<DWORD>(ms.get()));
+    }
+}
+
+#endif